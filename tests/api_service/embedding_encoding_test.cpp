@@ -0,0 +1,154 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "api_service/embedding_encoding.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace xllm {
+namespace {
+
+std::vector<float> unpack(const std::string& packed,
+                          size_t dims,
+                          EmbeddingType type) {
+  std::vector<float> values(type == EmbeddingType::kBinary
+                                ? packed_embedding_size(type, dims)
+                                : dims);
+  unpack_embedding_values(packed.data(), dims, type, values.data());
+  return values;
+}
+
+TEST(EmbeddingEncodingTest, ParseEmbeddingType) {
+  EXPECT_EQ(parse_embedding_type(""), EmbeddingType::kFloat);
+  EXPECT_EQ(parse_embedding_type("float"), EmbeddingType::kFloat);
+  EXPECT_EQ(parse_embedding_type("float16"), EmbeddingType::kFloat16);
+  EXPECT_EQ(parse_embedding_type("int8"), EmbeddingType::kInt8);
+  EXPECT_EQ(parse_embedding_type("binary"), EmbeddingType::kBinary);
+  EXPECT_FALSE(parse_embedding_type("uint4").has_value());
+}
+
+TEST(EmbeddingEncodingTest, Float32RoundTrips) {
+  const std::vector<float> values = {0.5f, -1.25f, 3.0f};
+  std::string packed;
+  EXPECT_EQ(pack_embedding(values, 3, EmbeddingType::kFloat, &packed), 1.0f);
+  ASSERT_EQ(packed.size(), 3 * sizeof(float));
+  EXPECT_EQ(unpack(packed, 3, EmbeddingType::kFloat), values);
+}
+
+TEST(EmbeddingEncodingTest, Float16RoundsToNearestEven) {
+  // 1 + 2^-11 is halfway between two halves and rounds to the even one.
+  const std::vector<float> values = {1.0f,  -2.5f, 1.0f + 0x1p-11f,
+                                     1e-7f, 7e4f,  0.333333f,
+                                     -0.0f, 1.5f,  65504.0f};
+  std::string packed;
+  pack_embedding(values, values.size(), EmbeddingType::kFloat16, &packed);
+  ASSERT_EQ(packed.size(), values.size() * 2);
+
+  const std::vector<float> decoded =
+      unpack(packed, values.size(), EmbeddingType::kFloat16);
+  EXPECT_EQ(decoded[0], 1.0f);
+  EXPECT_EQ(decoded[1], -2.5f);
+  EXPECT_EQ(decoded[2], 1.0f);
+  EXPECT_EQ(decoded[3], 0x1p-24f * 2.0f);
+  EXPECT_TRUE(std::isinf(decoded[4]));
+  EXPECT_NEAR(decoded[5], 0.333333f, 1e-4f);
+  EXPECT_TRUE(std::signbit(decoded[6]));
+  EXPECT_EQ(decoded[7], 1.5f);
+  EXPECT_EQ(decoded[8], 65504.0f);
+}
+
+TEST(EmbeddingEncodingTest, Int8ScalesByMaxAbs) {
+  const std::vector<float> values = {0.5f, -1.0f, 0.25f, 0.0f};
+  std::string packed;
+  const float scale =
+      pack_embedding(values, values.size(), EmbeddingType::kInt8, &packed);
+  EXPECT_FLOAT_EQ(scale, 1.0f / 127.0f);
+  const std::vector<float> decoded =
+      unpack(packed, values.size(), EmbeddingType::kInt8);
+  EXPECT_EQ(decoded, std::vector<float>({64.0f, -127.0f, 32.0f, 0.0f}));
+}
+
+TEST(EmbeddingEncodingTest, BinaryPacksSignBitsMsbFirst) {
+  const std::vector<float> values = {
+      1.0f, -1.0f, 0.0f, 2.0f, 0.1f, -0.1f, -3.0f, 5.0f, 1.0f, -1.0f};
+  std::string packed;
+  pack_embedding(values, values.size(), EmbeddingType::kBinary, &packed);
+  ASSERT_EQ(packed.size(), 2u);
+  EXPECT_EQ(static_cast<uint8_t>(packed[0]), 0b10011001);
+  EXPECT_EQ(static_cast<uint8_t>(packed[1]), 0b10000000);
+  EXPECT_EQ(unpack(packed, values.size(), EmbeddingType::kBinary),
+            std::vector<float>({153.0f, 128.0f}));
+}
+
+TEST(EmbeddingEncodingTest, TruncationRenormalizes) {
+  const std::vector<float> values = {3.0f, 4.0f, 12.0f};
+  std::string packed;
+  pack_embedding(values, 2, EmbeddingType::kFloat, &packed);
+  const std::vector<float> decoded = unpack(packed, 2, EmbeddingType::kFloat);
+  EXPECT_FLOAT_EQ(decoded[0], 0.6f);
+  EXPECT_FLOAT_EQ(decoded[1], 0.8f);
+}
+
+TEST(EmbeddingEncodingTest, AppendsToExistingPayload) {
+  std::string payload = "json";
+  pack_embedding({1.0f, 2.0f}, 2, EmbeddingType::kInt8, &payload);
+  ASSERT_EQ(payload.size(), 6u);
+  EXPECT_EQ(payload.substr(0, 4), "json");
+  EXPECT_EQ(static_cast<int8_t>(payload[5]), 127);
+}
+
+TEST(EmbeddingEncodingTest, LegacyFormatsKeepRepeatedFloat) {
+  const std::vector<float> values = {0.5f, -0.25f, 1.0f};
+  for (const std::string format : {"", "float", "base64", "binary"}) {
+    proto::EmbeddingResponseData data;
+    std::string payload;
+    set_embedding_output(
+        values, values.size(), EmbeddingType::kFloat, format, &data, &payload);
+    ASSERT_EQ(data.embedding_size(), 3) << format;
+    EXPECT_FLOAT_EQ(data.embedding(0), 0.5f);
+    EXPECT_FLOAT_EQ(data.embedding(1), -0.25f);
+    EXPECT_FLOAT_EQ(data.embedding(2), 1.0f);
+    EXPECT_TRUE(data.embedding_bytes().empty()) << format;
+    EXPECT_FALSE(data.has_payload_offset()) << format;
+    EXPECT_FALSE(data.has_payload_length()) << format;
+    EXPECT_FALSE(data.has_scale()) << format;
+    EXPECT_TRUE(payload.empty()) << format;
+  }
+}
+
+TEST(EmbeddingEncodingTest, PackedBinaryAppendsToPayload) {
+  std::string payload = "mm";
+  proto::EmbeddingResponseData data;
+  set_embedding_output({1.0f, -2.0f},
+                       2,
+                       EmbeddingType::kInt8,
+                       "packed_binary",
+                       &data,
+                       &payload);
+  EXPECT_EQ(data.embedding_size(), 0);
+  EXPECT_EQ(data.payload_offset(), 2);
+  EXPECT_EQ(data.payload_length(), 2);
+  ASSERT_EQ(payload.size(), 4u);
+  EXPECT_EQ(static_cast<int8_t>(payload[3]), -127);
+  EXPECT_FLOAT_EQ(data.scale(), 2.0f / 127.0f);
+}
+
+}  // namespace
+}  // namespace xllm
@@ -0,0 +1,243 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "c_api/internal/async_request.h"
+
+#include <gtest/gtest.h>
+#include <poll.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api_service/call.h"
+#include "c_api/completion_queue.h"
+#include "c_api/default.h"
+#include "c_api/internal/helper.h"
+
+namespace xllm {
+namespace helper {
+namespace {
+
+bool fd_readable(int fd) {
+  struct pollfd pfd = {fd, POLLIN, 0};
+  return ::poll(&pfd, 1, /*timeout=*/0) == 1 && (pfd.revents & POLLIN) != 0;
+}
+
+XLLM_Response* make_response(const std::string& request_id) {
+  XLLM_Response* response = new XLLM_Response();
+  XLLM_SET_META_STRING_FIELD(response->id, request_id);
+  return response;
+}
+
+// Events of one request as seen by a callback.
+struct RecordedEvents {
+  std::vector<XLLM_EventType> types;
+  std::vector<XLLM_StatusCode> status_codes;
+};
+
+void record_event(const XLLM_Event* event) {
+  auto* recorded = static_cast<RecordedEvents*>(event->user_data);
+  recorded->types.push_back(event->type);
+  recorded->status_codes.push_back(event->response->status_code);
+}
+
+class AsyncRequestTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    queue_ = xllm_completion_queue_create();
+    ASSERT_NE(queue_, nullptr);
+  }
+
+  void TearDown() override { xllm_completion_queue_destroy(queue_); }
+
+  XLLM_AsyncOptions queue_options(bool stream = false) const {
+    XLLM_AsyncOptions options = XLLM_ASYNC_OPTIONS_DEFAULT;
+    options.stream = stream;
+    options.queue = queue_;
+    return options;
+  }
+
+  // Polls without waiting and frees the responses.
+  std::vector<XLLM_Event> drain() {
+    std::vector<XLLM_Event> events(16);
+    const size_t count =
+        xllm_completion_queue_poll(queue_, events.data(), events.size(), 0);
+    events.resize(count);
+    for (XLLM_Event& event : events) {
+      xllm_free_response(event.response);
+      event.response = nullptr;
+    }
+    return events;
+  }
+
+  std::shared_ptr<AsyncRequestRegistry> registry_ =
+      std::make_shared<AsyncRequestRegistry>();
+  XLLM_CompletionQueue* queue_ = nullptr;
+};
+
+TEST_F(AsyncRequestTest, CreateNeedsExactlyOneOfQueueAndCallback) {
+  XLLM_AsyncOptions options = XLLM_ASYNC_OPTIONS_DEFAULT;
+  EXPECT_EQ(registry_->create(0, "neither", options), nullptr);
+
+  options.queue = queue_;
+  options.callback = record_event;
+  EXPECT_EQ(registry_->create(0, "both", options), nullptr);
+
+  options.callback = nullptr;
+  std::shared_ptr<AsyncRequest> queued = registry_->create(0, "queue", options);
+  ASSERT_NE(queued, nullptr);
+  EXPECT_NE(queued->handle(), XLLM_INVALID_REQUEST_HANDLE);
+
+  options.queue = nullptr;
+  options.callback = record_event;
+  std::shared_ptr<AsyncRequest> called =
+      registry_->create(0, "callback", options);
+  ASSERT_NE(called, nullptr);
+  EXPECT_NE(called->handle(), queued->handle());
+}
+
+TEST_F(AsyncRequestTest, FinishedIsDeliveredOnce) {
+  std::shared_ptr<AsyncRequest> request =
+      registry_->create(/*batch_index=*/3, "req", queue_options());
+  ASSERT_NE(request, nullptr);
+  registry_->add(request);
+
+  request->finish(make_response("req"));
+  request->finish(make_response("req"));
+
+  const std::vector<XLLM_Event> events = drain();
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].type, XLLM_EVENT_FINISHED);
+  EXPECT_EQ(events[0].handle, request->handle());
+  EXPECT_EQ(events[0].batch_index, 3u);
+  // finishing unregisters the request.
+  EXPECT_FALSE(registry_->cancel(request->handle()));
+}
+
+TEST_F(AsyncRequestTest, CancelAllFinishesEachRequestOnce) {
+  RecordedEvents recorded;
+  XLLM_AsyncOptions options = XLLM_ASYNC_OPTIONS_DEFAULT;
+  options.callback = record_event;
+  options.user_data = &recorded;
+  std::shared_ptr<AsyncRequest> first = registry_->create(0, "a", options);
+  std::shared_ptr<AsyncRequest> second = registry_->create(1, "b", options);
+  registry_->add(first);
+  registry_->add(second);
+
+  // `first` finishes on its own and leaves the registry before the shutdown.
+  first->finish(make_response("a"));
+  registry_->cancel_all("shutting down");
+  // a late engine output after the shutdown must not finish them again.
+  first->finish(make_response("a"));
+  second->finish(make_response("b"));
+
+  ASSERT_EQ(recorded.types.size(), 2u);
+  EXPECT_EQ(recorded.types[0], XLLM_EVENT_FINISHED);
+  EXPECT_EQ(recorded.types[1], XLLM_EVENT_FINISHED);
+  EXPECT_TRUE(second->cancelled());
+  EXPECT_TRUE(second->call()->is_disconnected());
+  EXPECT_EQ(recorded.status_codes[1], XLLM_StatusCode::kCancelled);
+  EXPECT_FALSE(registry_->cancel(second->handle()));
+}
+
+TEST_F(AsyncRequestTest, CancelMarksRequestDisconnected) {
+  std::shared_ptr<AsyncRequest> request =
+      registry_->create(0, "req", queue_options());
+  registry_->add(request);
+  EXPECT_FALSE(request->call()->is_disconnected());
+
+  EXPECT_TRUE(registry_->cancel(request->handle()));
+  EXPECT_TRUE(request->cancelled());
+  EXPECT_TRUE(request->call()->is_disconnected());
+  EXPECT_FALSE(registry_->cancel(XLLM_INVALID_REQUEST_HANDLE));
+}
+
+TEST_F(AsyncRequestTest, DeltasAfterFinishAreDropped) {
+  std::shared_ptr<AsyncRequest> request =
+      registry_->create(0, "req", queue_options(/*stream=*/true));
+  registry_->add(request);
+
+  request->deliver_delta(make_response("req"));
+  request->finish(make_response("req"));
+  request->deliver_delta(make_response("req"));
+
+  const std::vector<XLLM_Event> events = drain();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].type, XLLM_EVENT_DELTA);
+  EXPECT_EQ(events[1].type, XLLM_EVENT_FINISHED);
+}
+
+TEST_F(AsyncRequestTest, EventFdIsReadableUntilDrained) {
+  const int fd = xllm_completion_queue_fd(queue_);
+  ASSERT_GE(fd, 0);
+  EXPECT_FALSE(fd_readable(fd));
+
+  std::shared_ptr<AsyncRequest> request =
+      registry_->create(0, "req", queue_options(/*stream=*/true));
+  request->deliver_delta(make_response("req"));
+  request->deliver_delta(make_response("req"));
+  EXPECT_TRUE(fd_readable(fd));
+
+  // a partial poll leaves the queue, and the fd, ready.
+  XLLM_Event event;
+  ASSERT_EQ(xllm_completion_queue_poll(queue_, &event, 1, 0), 1u);
+  xllm_free_response(event.response);
+  EXPECT_TRUE(fd_readable(fd));
+
+  ASSERT_EQ(xllm_completion_queue_poll(queue_, &event, 1, 0), 1u);
+  xllm_free_response(event.response);
+  EXPECT_FALSE(fd_readable(fd));
+  EXPECT_EQ(xllm_completion_queue_poll(queue_, &event, 1, 0), 0u);
+}
+
+TEST_F(AsyncRequestTest, CloseFreesQueuedResponses) {
+  std::shared_ptr<CompletionQueueState> state = queue_->state;
+  std::shared_ptr<AsyncRequest> request =
+      registry_->create(0, "req", queue_options(/*stream=*/true));
+  registry_->add(request);
+  request->deliver_delta(make_response("req"));
+
+  // the request keeps the queue state alive; the queued delta is freed by
+  // close() (checked by the leak sanitizer) and later events are dropped.
+  xllm_completion_queue_destroy(queue_);
+  queue_ = nullptr;
+  request->finish(make_response("req"));
+
+  XLLM_Event event = {};
+  EXPECT_EQ(state->poll(&event, 1, 0), 0u);
+  EXPECT_FALSE(state->push(event));
+}
+
+TEST(BatchRequestParamsTest, SuffixesCallerRequestId) {
+  XLLM_RequestParams params = XLLM_LLM_REQUEST_PARAMS_DEFAULT;
+  XLLM_RequestParams storage;
+  EXPECT_EQ(batch_request_params(nullptr, 1, &storage), nullptr);
+  // without a caller id every prompt gets a generated one.
+  EXPECT_EQ(batch_request_params(&params, 1, &storage), &params);
+
+  snprintf(params.request_id, sizeof(params.request_id), "batch");
+  const XLLM_RequestParams* second = batch_request_params(&params, 2, &storage);
+  ASSERT_EQ(second, &storage);
+  EXPECT_STREQ(second->request_id, "batch-2");
+  EXPECT_EQ(second->max_tokens, params.max_tokens);
+  EXPECT_STREQ(params.request_id, "batch");
+}
+
+}  // namespace
+}  // namespace helper
+}  // namespace xllm
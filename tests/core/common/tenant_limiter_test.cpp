@@ -0,0 +1,100 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tenant_limiter.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "core/framework/config/service_config.h"
+
+namespace xllm {
+
+// The limits live in the ServiceConfig singleton; every test sets its own and
+// the fixture puts the previous ones back.
+class TenantLimiterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const ServiceConfig& config = ServiceConfig::get_instance();
+    max_concurrent_requests_ = config.tenant_max_concurrent_requests();
+    max_prompt_tokens_per_second_ =
+        config.tenant_max_prompt_tokens_per_second();
+  }
+
+  void TearDown() override {
+    ServiceConfig::get_instance()
+        .tenant_max_concurrent_requests(max_concurrent_requests_)
+        .tenant_max_prompt_tokens_per_second(max_prompt_tokens_per_second_);
+  }
+
+ private:
+  int32_t max_concurrent_requests_ = 0;
+  int32_t max_prompt_tokens_per_second_ = 0;
+};
+
+TEST_F(TenantLimiterTest, ConcurrencyIsPerTenant) {
+  ServiceConfig::get_instance()
+      .tenant_max_concurrent_requests(1)
+      .tenant_max_prompt_tokens_per_second(0);
+  TenantLimiter limiter;
+
+  EXPECT_FALSE(limiter.is_limited("a", 100));
+  EXPECT_TRUE(limiter.is_limited("a", 100));
+  EXPECT_FALSE(limiter.is_limited("b", 100));
+  EXPECT_EQ(limiter.get_num_concurrent_requests("a"), 1);
+
+  limiter.release("a");
+  EXPECT_EQ(limiter.get_num_concurrent_requests("a"), 0);
+  EXPECT_FALSE(limiter.is_limited("a", 100));
+
+  limiter.release("a");
+  limiter.release("b");
+}
+
+TEST_F(TenantLimiterTest, RequestsWithoutTenantAreNotLimited) {
+  ServiceConfig::get_instance()
+      .tenant_max_concurrent_requests(1)
+      .tenant_max_prompt_tokens_per_second(10);
+  TenantLimiter limiter;
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_FALSE(limiter.is_limited("", 1000));
+  }
+  EXPECT_EQ(limiter.get_num_concurrent_requests(""), 0);
+}
+
+TEST_F(TenantLimiterTest, PromptTokenRate) {
+  ServiceConfig::get_instance()
+      .tenant_max_concurrent_requests(0)
+      .tenant_max_prompt_tokens_per_second(1000);
+  TenantLimiter limiter;
+  const TenantLimiter::Clock::time_point start = TenantLimiter::Clock::now();
+
+  // a prompt above the one second burst is admitted, then paid back.
+  EXPECT_FALSE(limiter.is_limited("a", 1500, start));
+  EXPECT_TRUE(limiter.is_limited("a", 1, start));
+  EXPECT_TRUE(
+      limiter.is_limited("a", 1, start + std::chrono::milliseconds(400)));
+  EXPECT_FALSE(
+      limiter.is_limited("a", 1, start + std::chrono::milliseconds(600)));
+  EXPECT_FALSE(limiter.is_limited("b", 1000, start));
+
+  limiter.release("a");
+  limiter.release("a");
+  limiter.release("b");
+}
+
+}  // namespace xllm
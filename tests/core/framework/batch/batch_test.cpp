@@ -2640,17 +2640,17 @@ TEST(BatchTest, SampleRequestProcessesAllMatchedRawOutputs) {
   EXPECT_EQ(seq.tokens()[prompt_tokens], 101);
   EXPECT_EQ(seq.tokens()[prompt_tokens + 1], 202);
 
-  const auto& logprobs = seq.logprob_state()->get_logprobs();
-  ASSERT_TRUE(logprobs[prompt_tokens].has_value());
-  ASSERT_TRUE(logprobs[prompt_tokens + 1].has_value());
-  EXPECT_FLOAT_EQ(logprobs[prompt_tokens].value(), -0.10f);
-  EXPECT_FLOAT_EQ(logprobs[prompt_tokens + 1].value(), -0.20f);
+  const LogprobState* logprob_state = seq.logprob_state();
+  ASSERT_TRUE(logprob_state->get_logprob(prompt_tokens).has_value());
+  ASSERT_TRUE(logprob_state->get_logprob(prompt_tokens + 1).has_value());
+  EXPECT_FLOAT_EQ(logprob_state->get_logprob(prompt_tokens).value(), -0.10f);
+  EXPECT_FLOAT_EQ(logprob_state->get_logprob(prompt_tokens + 1).value(),
+                  -0.20f);
 
-  const auto& top_tokens = seq.logprob_state()->get_top_tokens();
-  ASSERT_EQ(top_tokens[prompt_tokens].size(), 2);
-  ASSERT_EQ(top_tokens[prompt_tokens + 1].size(), 2);
-  EXPECT_EQ(top_tokens[prompt_tokens][0], 101);
-  EXPECT_EQ(top_tokens[prompt_tokens + 1][0], 202);
+  ASSERT_EQ(logprob_state->get_top_tokens(prompt_tokens).size(), 2);
+  ASSERT_EQ(logprob_state->get_top_tokens(prompt_tokens + 1).size(), 2);
+  EXPECT_EQ(logprob_state->get_top_tokens(prompt_tokens)[0], 101);
+  EXPECT_EQ(logprob_state->get_top_tokens(prompt_tokens + 1)[0], 202);
 }
 
 TEST(BatchTest, SampleRequestDistributesRawOutputsAcrossSequences) {
@@ -2793,9 +2793,9 @@ TEST(BatchTest, SampleRequestFallsBackToEmptyPlaceholderOnPartialRawOutputs) {
   EXPECT_EQ(seq.tokens()[prompt_tokens], 301);
   EXPECT_EQ(seq.tokens()[prompt_tokens + 1], seq.tokens()[0]);
 
-  const auto& logprobs = seq.logprob_state()->get_logprobs();
-  ASSERT_TRUE(logprobs[prompt_tokens].has_value());
-  EXPECT_FALSE(logprobs[prompt_tokens + 1].has_value());
+  const LogprobState* logprob_state = seq.logprob_state();
+  ASSERT_TRUE(logprob_state->get_logprob(prompt_tokens).has_value());
+  EXPECT_FALSE(logprob_state->get_logprob(prompt_tokens + 1).has_value());
 }
 
 TEST(BatchTest, KeepTargetsForOverlapReplacement) {
@@ -0,0 +1,144 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/block/block_extent_allocator.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace xllm {
+namespace {
+
+// number of maximal runs of consecutive ids.
+size_t count_runs(std::vector<int32_t> ids) {
+  std::sort(ids.begin(), ids.end());
+  size_t runs = ids.empty() ? 0 : 1;
+  for (size_t i = 1; i < ids.size(); ++i) {
+    if (ids[i] != ids[i - 1] + 1) {
+      ++runs;
+    }
+  }
+  return runs;
+}
+
+}  // namespace
+
+TEST(BlockExtentAllocatorTest, MergesNeighbouringRunsOnFree) {
+  BlockExtentAllocator allocator(/*num_blocks=*/16);
+  std::vector<int32_t> ids;
+  ASSERT_TRUE(allocator.allocate(/*num_blocks=*/16, /*hint=*/-1, &ids));
+  EXPECT_EQ(allocator.num_free_blocks(), 0u);
+  EXPECT_EQ(allocator.allocate_one(), -1);
+
+  allocator.free(1);
+  allocator.free(3);
+  EXPECT_EQ(allocator.num_extents(), 2u);
+  allocator.free(2);
+  EXPECT_EQ(allocator.num_extents(), 1u);
+  allocator.free(0);
+  EXPECT_EQ(allocator.largest_extent(), 4u);
+  for (int32_t id = 4; id < 16; ++id) {
+    allocator.free(id);
+  }
+  EXPECT_EQ(allocator.num_extents(), 1u);
+  EXPECT_EQ(allocator.largest_extent(), 16u);
+  EXPECT_EQ(allocator.num_free_blocks(), 16u);
+  // the lowest id is handed out first, e.g. for the padding block.
+  EXPECT_EQ(allocator.allocate_one(), 0);
+}
+
+TEST(BlockExtentAllocatorTest, ContinuesFromHint) {
+  BlockExtentAllocator allocator(/*num_blocks=*/32);
+  // new allocations start mid-run, leaving room on both sides to grow.
+  std::vector<int32_t> seq;
+  ASSERT_TRUE(allocator.allocate(/*num_blocks=*/3, /*hint=*/-1, &seq));
+  EXPECT_EQ(seq, (std::vector<int32_t>{16, 17, 18}));
+  ASSERT_TRUE(allocator.allocate(/*num_blocks=*/2, /*hint=*/19, &seq));
+  EXPECT_EQ(seq, (std::vector<int32_t>{16, 17, 18, 19, 20}));
+
+  // a hint inside a free run splits it and continues from there.
+  std::vector<int32_t> grown;
+  ASSERT_TRUE(allocator.allocate(/*num_blocks=*/2, /*hint=*/5, &grown));
+  EXPECT_EQ(grown, (std::vector<int32_t>{5, 6}));
+
+  // a used hint falls back to the middle of the largest run [21, 32).
+  std::vector<int32_t> fallback;
+  ASSERT_TRUE(allocator.allocate(/*num_blocks=*/1, /*hint=*/16, &fallback));
+  EXPECT_EQ(fallback, (std::vector<int32_t>{26}));
+}
+
+TEST(BlockExtentAllocatorTest, UsesBestFitWhenTightAndFailsAtomically) {
+  BlockExtentAllocator allocator(/*num_blocks=*/12);
+  std::vector<int32_t> ids;
+  ASSERT_TRUE(allocator.allocate(/*num_blocks=*/12, /*hint=*/-1, &ids));
+  // free runs [2, 4) and [6, 11).
+  for (int32_t id : {2, 3, 6, 7, 8, 9, 10}) {
+    allocator.free(id);
+  }
+
+  std::vector<int32_t> large;
+  ASSERT_TRUE(allocator.allocate(/*num_blocks=*/3, /*hint=*/-1, &large));
+  EXPECT_EQ(large, (std::vector<int32_t>{6, 7, 8}));
+  std::vector<int32_t> small;
+  ASSERT_TRUE(allocator.allocate(/*num_blocks=*/2, /*hint=*/-1, &small));
+  EXPECT_EQ(small, (std::vector<int32_t>{2, 3}));
+
+  std::vector<int32_t> too_many;
+  EXPECT_FALSE(allocator.allocate(/*num_blocks=*/3, /*hint=*/-1, &too_many));
+  EXPECT_TRUE(too_many.empty());
+  EXPECT_EQ(allocator.num_free_blocks(), 2u);
+  EXPECT_EQ(allocator.allocate_one(), 9);
+}
+
+TEST(BlockExtentAllocatorTest, ChurnKeepsSequencesInFewRuns) {
+  constexpr int32_t kNumBlocks = 4096;
+  BlockExtentAllocator allocator(kNumBlocks);
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<int32_t> size_dist(1, 16);
+
+  // sequences grow one block at a time, interleaved, and finish randomly.
+  std::vector<std::vector<int32_t>> sequences(64);
+  for (int32_t step = 0; step < 20000; ++step) {
+    auto& seq = sequences[gen() % sequences.size()];
+    if (seq.size() >= static_cast<size_t>(size_dist(gen)) * 4) {
+      for (int32_t id : seq) {
+        allocator.free(id);
+      }
+      seq.clear();
+      continue;
+    }
+    const int32_t hint = seq.empty() ? -1 : seq.back() + 1;
+    ASSERT_TRUE(allocator.allocate(/*num_blocks=*/1, hint, &seq));
+  }
+
+  std::set<int32_t> used;
+  size_t num_used = 0;
+  size_t num_runs = 0;
+  for (const auto& seq : sequences) {
+    used.insert(seq.begin(), seq.end());
+    num_used += seq.size();
+    num_runs += count_runs(seq);
+  }
+  EXPECT_EQ(used.size(), num_used) << "an id was handed out twice";
+  EXPECT_EQ(allocator.num_free_blocks(), kNumBlocks - num_used);
+  // growing into the hint keeps nearly every sequence in a single run.
+  EXPECT_LE(num_runs, sequences.size() * 2);
+}
+
+}  // namespace xllm
@@ -858,6 +858,47 @@ TEST(HierarchyBlockManagerPoolTest,
   EXPECT_EQ(HierarchyPoolTestPeer::pending_offload_pair_count(pool), 2u);
 }
 
+TEST(HierarchyBlockManagerPoolTest, RecomputePreemptionSkipsOffload) {
+  HierarchyBlockManagerPool pool(make_flat_kv_options(),
+                                 /*engine=*/nullptr,
+                                 /*dp_size=*/1);
+  std::vector<int32_t> tokens(257, 83);
+  Sequence sequence = make_test_sequence(/*index=*/0, tokens);
+  ASSERT_TRUE(pool.allocate(&sequence, /*num_tokens=*/256));
+  ASSERT_EQ(sequence.host_kv_state().num_blocks(BlockType::KV), 2u);
+  sequence.kv_state().set_kv_cache_tokens_num(256);
+
+  pool.preempt(&sequence, /*swap_out=*/false);
+  EXPECT_EQ(HierarchyPoolTestPeer::pending_offload_pair_count(pool), 0u);
+  EXPECT_FALSE(sequence.kv_state().has_any_blocks());
+  EXPECT_FALSE(sequence.host_kv_state().has_any_blocks());
+}
+
+TEST(HierarchyBlockManagerPoolTest, SwapPreemptionOffloadsEveryComputedBlock) {
+  BlockManagerPool::Options options = make_flat_kv_options();
+  options.host_num_blocks(4);
+  HierarchyBlockManagerPool pool(options, /*engine=*/nullptr, /*dp_size=*/1);
+  BlockManager* host_leaf = HierarchyPoolTestPeer::host_block_managers(pool)
+                                .front()
+                                .at(BlockType::KV)
+                                .leaf.get();
+
+  // Host is full while the sequence runs, so it has no Host mirror.
+  std::vector<Block> held = host_leaf->allocate(3);
+  ASSERT_EQ(held.size(), 3u);
+  std::vector<int32_t> tokens(257, 89);
+  Sequence sequence = make_test_sequence(/*index=*/0, tokens);
+  ASSERT_TRUE(pool.allocate(&sequence, /*num_tokens=*/256));
+  ASSERT_FALSE(sequence.host_kv_state().has_any_blocks());
+  sequence.kv_state().set_kv_cache_tokens_num(256);
+  host_leaf->deallocate(held);
+  held.clear();
+
+  pool.preempt(&sequence, /*swap_out=*/true);
+  EXPECT_EQ(HierarchyPoolTestPeer::pending_offload_pair_count(pool), 2u);
+  EXPECT_FALSE(sequence.kv_state().has_any_blocks());
+}
+
 TEST(HierarchyBlockManagerPoolTest,
      Dsv4ChunkGrowthOffloadsAllCompletedCacheGroups) {
   constexpr size_t kFirstChunkTokens = 16384;
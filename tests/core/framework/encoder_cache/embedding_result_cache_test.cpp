@@ -0,0 +1,118 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/encoder_cache/embedding_result_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <vector>
+
+namespace xllm {
+namespace {
+
+constexpr int64_t kHiddenSize = 4;
+constexpr int64_t kEntryBytes = kHiddenSize * sizeof(float);
+
+EmbeddingResultCache::Result make_result(float value) {
+  EmbeddingResultCache::Result result;
+  result.embedding.assign(kHiddenSize, value);
+  result.usage.num_prompt_tokens = 3;
+  result.usage.num_total_tokens = 3;
+  return result;
+}
+
+XXH3Key key_of(const std::vector<int32_t>& token_ids) {
+  return EmbeddingResultCache::make_key("bge-m3", token_ids);
+}
+
+TEST(EmbeddingResultCacheTest, InsertAndLookup) {
+  EmbeddingResultCache cache(/*max_size=*/kEntryBytes);
+  cache.insert(key_of({1, 2, 3}), make_result(1.0f), cache.epoch());
+
+  std::optional<EmbeddingResultCache::Result> cached =
+      cache.lookup(key_of({1, 2, 3}));
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cached->embedding, std::vector<float>(kHiddenSize, 1.0f));
+  EXPECT_EQ(cached->usage.num_prompt_tokens, 3);
+  EXPECT_EQ(cache.size(), kEntryBytes);
+}
+
+TEST(EmbeddingResultCacheTest, CachesRerankScores) {
+  EmbeddingResultCache cache(/*max_size=*/1024);
+  EmbeddingResultCache::Result result;
+  result.score = 0.75f;
+  result.score_token_id = 9693;
+  result.usage.num_prompt_tokens = 3;
+  cache.insert(key_of({1, 2, 3}), result, cache.epoch());
+
+  std::optional<EmbeddingResultCache::Result> cached =
+      cache.lookup(key_of({1, 2, 3}));
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_TRUE(cached->embedding.empty());
+  ASSERT_TRUE(cached->score.has_value());
+  EXPECT_EQ(cached->score.value(), 0.75f);
+  EXPECT_EQ(cached->score_token_id, 9693);
+  EXPECT_GT(cache.size(), 0);
+
+  // a result with neither an embedding nor a score is not cached.
+  cache.insert(key_of({4}), EmbeddingResultCache::Result(), cache.epoch());
+  EXPECT_FALSE(cache.lookup(key_of({4})).has_value());
+}
+
+TEST(EmbeddingResultCacheTest, KeyIncludesModelAndTokens) {
+  EXPECT_TRUE(key_of({1, 2}) == key_of({1, 2}));
+  EXPECT_FALSE(key_of({1, 2}) == key_of({2, 1}));
+  EXPECT_FALSE(key_of({1, 2}) == key_of({1, 2, 0}));
+  EXPECT_FALSE(key_of({1, 2}) ==
+               EmbeddingResultCache::make_key("e5", {1, 2}));
+}
+
+TEST(EmbeddingResultCacheTest, LruEvictsLeastRecentlyUsed) {
+  EmbeddingResultCache cache(/*max_size=*/kEntryBytes * 2);
+  cache.insert(key_of({0}), make_result(0.0f), cache.epoch());
+  cache.insert(key_of({1}), make_result(1.0f), cache.epoch());
+  ASSERT_TRUE(cache.lookup(key_of({0})).has_value());
+  cache.insert(key_of({2}), make_result(2.0f), cache.epoch());
+
+  EXPECT_TRUE(cache.lookup(key_of({0})).has_value());
+  EXPECT_FALSE(cache.lookup(key_of({1})).has_value());
+  EXPECT_TRUE(cache.lookup(key_of({2})).has_value());
+  EXPECT_EQ(cache.size(), kEntryBytes * 2);
+}
+
+TEST(EmbeddingResultCacheTest, OversizedResultIsNotCached) {
+  EmbeddingResultCache cache(/*max_size=*/kEntryBytes - 1);
+  cache.insert(key_of({1}), make_result(1.0f), cache.epoch());
+
+  EXPECT_FALSE(cache.lookup(key_of({1})).has_value());
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(EmbeddingResultCacheTest, ClearDropsResultsOfThePreviousEpoch) {
+  EmbeddingResultCache cache(/*max_size=*/kEntryBytes * 2);
+  const uint64_t epoch = cache.epoch();
+  cache.insert(key_of({1}), make_result(1.0f), epoch);
+  cache.clear();
+  EXPECT_FALSE(cache.lookup(key_of({1})).has_value());
+
+  // a result that started computing before clear() is stale.
+  cache.insert(key_of({2}), make_result(2.0f), epoch);
+  EXPECT_FALSE(cache.lookup(key_of({2})).has_value());
+  EXPECT_EQ(cache.size(), 0);
+}
+
+}  // namespace
+}  // namespace xllm
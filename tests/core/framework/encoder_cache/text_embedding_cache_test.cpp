@@ -0,0 +1,172 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/encoder_cache/text_embedding_cache.h"
+
+#include <gtest/gtest.h>
+#include <torch/torch.h>
+
+#include <vector>
+
+namespace xllm {
+namespace {
+
+constexpr int64_t kHiddenSize = 4;
+
+// fake encoder: row embedding is filled with the first token id.
+class FakeEncoder {
+ public:
+  explicit FakeEncoder(const std::vector<std::vector<int32_t>>& token_ids)
+      : token_ids_(token_ids) {}
+
+  torch::Tensor operator()(const torch::Tensor& rows) {
+    ++num_calls_;
+    std::vector<torch::Tensor> embeddings;
+    for (int64_t i = 0; i < rows.numel(); ++i) {
+      const int64_t row = rows[i].item<int64_t>();
+      encoded_rows_.push_back(row);
+      const float value = static_cast<float>(token_ids_[row][0]);
+      embeddings.push_back(torch::full({kHiddenSize}, value, torch::kFloat));
+    }
+    return torch::stack(embeddings);
+  }
+
+  int32_t num_calls() const { return num_calls_; }
+  const std::vector<int64_t>& encoded_rows() const { return encoded_rows_; }
+
+ private:
+  const std::vector<std::vector<int32_t>>& token_ids_;
+  int32_t num_calls_ = 0;
+  std::vector<int64_t> encoded_rows_;
+};
+
+torch::Tensor encode(const std::string& encoder_id,
+                     const std::vector<std::vector<int32_t>>& token_ids,
+                     FakeEncoder* encoder,
+                     const torch::Device& device = torch::kCPU) {
+  return TextEmbeddingCache::get_instance().encode(
+      encoder_id, device, token_ids, [encoder](const torch::Tensor& rows) {
+        return (*encoder)(rows);
+      });
+}
+
+torch::Tensor expected(const std::vector<float>& values) {
+  std::vector<torch::Tensor> rows;
+  for (float value : values) {
+    rows.push_back(torch::full({kHiddenSize}, value, torch::kFloat));
+  }
+  return torch::stack(rows);
+}
+
+class TextEmbeddingCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    TextEmbeddingCache::get_instance().init(/*max_size=*/1024 * 1024);
+  }
+
+  void TearDown() override { TextEmbeddingCache::get_instance().init(0); }
+};
+
+TEST_F(TextEmbeddingCacheTest, EncodesOnlyMissingRows) {
+  std::vector<std::vector<int32_t>> first = {{1, 0}, {2, 0}};
+  FakeEncoder first_encoder(first);
+  EXPECT_TRUE(torch::equal(encode("t5", first, &first_encoder),
+                           expected({1.0f, 2.0f})));
+  EXPECT_EQ(first_encoder.encoded_rows(), std::vector<int64_t>({0, 1}));
+
+  std::vector<std::vector<int32_t>> second = {{3, 0}, {2, 0}, {1, 0}};
+  FakeEncoder second_encoder(second);
+  EXPECT_TRUE(torch::equal(encode("t5", second, &second_encoder),
+                           expected({3.0f, 2.0f, 1.0f})));
+  EXPECT_EQ(second_encoder.encoded_rows(), std::vector<int64_t>({0}));
+}
+
+TEST_F(TextEmbeddingCacheTest, AllHitsSkipEncoder) {
+  std::vector<std::vector<int32_t>> token_ids = {{5, 6}};
+  FakeEncoder warmup(token_ids);
+  encode("clip", token_ids, &warmup);
+
+  FakeEncoder encoder(token_ids);
+  EXPECT_TRUE(
+      torch::equal(encode("clip", token_ids, &encoder), expected({5.0f})));
+  EXPECT_EQ(encoder.num_calls(), 0);
+}
+
+TEST_F(TextEmbeddingCacheTest, DuplicateRowsEncodedOnce) {
+  std::vector<std::vector<int32_t>> token_ids = {{7, 0}, {7, 0}, {8, 0}};
+  FakeEncoder encoder(token_ids);
+  EXPECT_TRUE(torch::equal(encode("t5", token_ids, &encoder),
+                           expected({7.0f, 7.0f, 8.0f})));
+  EXPECT_EQ(encoder.encoded_rows(), std::vector<int64_t>({0, 2}));
+}
+
+TEST_F(TextEmbeddingCacheTest, KeyIncludesEncoderAndLength) {
+  std::vector<std::vector<int32_t>> token_ids = {{1, 0}};
+  FakeEncoder warmup(token_ids);
+  encode("t5", token_ids, &warmup);
+
+  FakeEncoder other_encoder(token_ids);
+  encode("umt5", token_ids, &other_encoder);
+  EXPECT_EQ(other_encoder.num_calls(), 1);
+
+  std::vector<std::vector<int32_t>> longer = {{1, 0, 0}};
+  FakeEncoder longer_encoder(longer);
+  encode("t5", longer, &longer_encoder);
+  EXPECT_EQ(longer_encoder.num_calls(), 1);
+}
+
+TEST_F(TextEmbeddingCacheTest, KeyIncludesDevice) {
+  // workers of one process on different devices must not share entries.
+  EXPECT_FALSE(
+      TextEmbeddingCache::make_key("t5", torch::Device("cpu:0"), {1, 0}) ==
+      TextEmbeddingCache::make_key("t5", torch::Device("cpu:1"), {1, 0}));
+
+  std::vector<std::vector<int32_t>> token_ids = {{1, 0}};
+  FakeEncoder warmup(token_ids);
+  encode("t5", token_ids, &warmup, torch::Device("cpu:0"));
+
+  FakeEncoder other_device(token_ids);
+  encode("t5", token_ids, &other_device, torch::Device("cpu:1"));
+  EXPECT_EQ(other_device.num_calls(), 1);
+
+  FakeEncoder same_device(token_ids);
+  encode("t5", token_ids, &same_device, torch::Device("cpu:0"));
+  EXPECT_EQ(same_device.num_calls(), 0);
+}
+
+TEST_F(TextEmbeddingCacheTest, KeyIncludesModelPath) {
+  std::vector<std::vector<int32_t>> token_ids = {{1, 0}};
+  FakeEncoder warmup(token_ids);
+  encode("/models/flux-dev/text_encoder_2", token_ids, &warmup);
+
+  FakeEncoder other_model(token_ids);
+  encode("/models/flux-schnell/text_encoder_2", token_ids, &other_model);
+  EXPECT_EQ(other_model.num_calls(), 1);
+}
+
+TEST_F(TextEmbeddingCacheTest, DisabledCacheAlwaysEncodes) {
+  TextEmbeddingCache::get_instance().init(0);
+  EXPECT_FALSE(TextEmbeddingCache::get_instance().enabled());
+
+  std::vector<std::vector<int32_t>> token_ids = {{4, 0}};
+  FakeEncoder first(token_ids);
+  encode("t5", token_ids, &first);
+  FakeEncoder second(token_ids);
+  encode("t5", token_ids, &second);
+  EXPECT_EQ(second.num_calls(), 1);
+}
+
+}  // namespace
+}  // namespace xllm
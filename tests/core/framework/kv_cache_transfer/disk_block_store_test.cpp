@@ -0,0 +1,235 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/kv_cache_transfer/disk_block_store.h"
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace xllm {
+namespace {
+
+constexpr size_t kKeyBytes = 1000;
+constexpr size_t kValueBytes = 3000;
+
+class DiskBlockStoreTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char dir[] = "/tmp/disk_block_store_test.XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    dir_ = dir;
+  }
+
+  void TearDown() override {
+    std::system(("rm -rf " + dir_).c_str());
+  }
+
+  DiskBlockStore::Options options(size_t capacity,
+                                  const std::string& schema = "v1") const {
+    DiskBlockStore::Options options;
+    options.path(dir_ + "/blocks").record_bytes(kKeyBytes + kValueBytes);
+    options.capacity_records(capacity).schema(schema);
+    return options;
+  }
+
+  std::string dir_;
+};
+
+DiskBlockStore::Key make_key(uint8_t id) {
+  DiskBlockStore::Key key{};
+  key.fill(id);
+  key[0] = static_cast<uint8_t>(id * 31 + 7);
+  return key;
+}
+
+// a block split over a key and a value segment, like a host KV block.
+struct Block {
+  explicit Block(uint8_t fill) : key(kKeyBytes, fill), value(kValueBytes) {
+    for (size_t i = 0; i < value.size(); ++i) {
+      value[i] = static_cast<char>(fill + i);
+    }
+  }
+
+  std::vector<DiskBlockStore::Segment> segments() {
+    return {{key.data(), key.size()}, {value.data(), value.size()}};
+  }
+
+  bool operator==(const Block& other) const {
+    return key == other.key && value == other.value;
+  }
+
+  std::vector<char> key;
+  std::vector<char> value;
+};
+
+}  // namespace
+
+TEST_F(DiskBlockStoreTest, PutThenGetRoundTrips) {
+  DiskBlockStore store(options(/*capacity=*/4));
+  ASSERT_TRUE(store.open());
+  EXPECT_EQ(store.slot_bytes() % 4096, 0u);
+
+  Block written(3);
+  ASSERT_TRUE(store.put(make_key(1), written.segments()));
+  EXPECT_TRUE(store.put(make_key(1), written.segments()));
+  EXPECT_EQ(store.num_records(), 1u);
+
+  Block read(0);
+  ASSERT_TRUE(store.get(make_key(1), read.segments()));
+  EXPECT_TRUE(read == written);
+  EXPECT_FALSE(store.get(make_key(2), read.segments()));
+}
+
+TEST_F(DiskBlockStoreTest, StoresShorterRecords) {
+  DiskBlockStore store(options(/*capacity=*/2));
+  ASSERT_TRUE(store.open());
+  std::vector<char> record(1500, 'r');
+  ASSERT_TRUE(store.put(make_key(1), {{record.data(), record.size()}}));
+
+  Block read(0);
+  size_t payload_bytes = 0;
+  ASSERT_TRUE(store.get(make_key(1), read.segments(), &payload_bytes));
+  EXPECT_EQ(payload_bytes, record.size());
+  EXPECT_EQ(std::vector<char>(read.key.begin(), read.key.end()),
+            std::vector<char>(kKeyBytes, 'r'));
+  EXPECT_EQ(read.value[0], 'r');
+  EXPECT_EQ(read.value[499], 'r');
+
+  // a buffer smaller than the record is a miss, not a partial read.
+  std::vector<char> small(100);
+  EXPECT_FALSE(store.get(make_key(1), {{small.data(), small.size()}}));
+  EXPECT_TRUE(store.contains(make_key(1)));
+}
+
+TEST_F(DiskBlockStoreTest, EvictsLeastRecentlyUsed) {
+  DiskBlockStore store(options(/*capacity=*/3));
+  ASSERT_TRUE(store.open());
+  for (uint8_t id = 1; id <= 3; ++id) {
+    Block block(id);
+    ASSERT_TRUE(store.put(make_key(id), block.segments()));
+  }
+  // touching 1 makes 2 the oldest.
+  Block read(0);
+  ASSERT_TRUE(store.get(make_key(1), read.segments()));
+  Block block(4);
+  ASSERT_TRUE(store.put(make_key(4), block.segments()));
+
+  EXPECT_EQ(store.num_records(), 3u);
+  EXPECT_TRUE(store.contains(make_key(1)));
+  EXPECT_FALSE(store.contains(make_key(2)));
+  EXPECT_TRUE(store.contains(make_key(3)));
+  ASSERT_TRUE(store.get(make_key(4), read.segments()));
+  EXPECT_TRUE(read == block);
+}
+
+TEST_F(DiskBlockStoreTest, ReopenReplaysJournal) {
+  {
+    DiskBlockStore store(options(/*capacity=*/2));
+    ASSERT_TRUE(store.open());
+    for (uint8_t id = 1; id <= 3; ++id) {
+      Block block(id);
+      ASSERT_TRUE(store.put(make_key(id), block.segments()));
+    }
+  }
+
+  DiskBlockStore store(options(/*capacity=*/2));
+  ASSERT_TRUE(store.open());
+  EXPECT_EQ(store.num_records(), 2u);
+  EXPECT_FALSE(store.contains(make_key(1)));
+  Block read(0);
+  ASSERT_TRUE(store.get(make_key(3), read.segments()));
+  EXPECT_TRUE(read == Block(3));
+  // the replayed LRU order evicts 2 before 3.
+  Block block(5);
+  ASSERT_TRUE(store.put(make_key(5), block.segments()));
+  EXPECT_FALSE(store.contains(make_key(2)));
+  EXPECT_TRUE(store.contains(make_key(3)));
+}
+
+TEST_F(DiskBlockStoreTest, SchemaChangeDiscardsRecords) {
+  {
+    DiskBlockStore store(options(/*capacity=*/2, "v1"));
+    ASSERT_TRUE(store.open());
+    Block block(1);
+    ASSERT_TRUE(store.put(make_key(1), block.segments()));
+  }
+  DiskBlockStore store(options(/*capacity=*/2, "v2"));
+  ASSERT_TRUE(store.open());
+  EXPECT_EQ(store.num_records(), 0u);
+  Block read(0);
+  EXPECT_FALSE(store.get(make_key(1), read.segments()));
+}
+
+TEST_F(DiskBlockStoreTest, CorruptSlotIsDropped) {
+  size_t slot_bytes = 0;
+  {
+    DiskBlockStore store(options(/*capacity=*/2));
+    ASSERT_TRUE(store.open());
+    slot_bytes = store.slot_bytes();
+    Block block(1);
+    ASSERT_TRUE(store.put(make_key(1), block.segments()));
+  }
+  // the first record lands in slot 0; tear its trailing header.
+  const int fd = ::open((dir_ + "/blocks").c_str(), O_WRONLY);
+  ASSERT_GE(fd, 0);
+  const std::vector<char> garbage(64, 'x');
+  const off_t trailer = 64 + kKeyBytes + kValueBytes;
+  ASSERT_EQ(::pwrite(fd, garbage.data(), garbage.size(), trailer), 64);
+  ::close(fd);
+  ASSERT_LT(static_cast<size_t>(trailer), slot_bytes);
+
+  DiskBlockStore store(options(/*capacity=*/2));
+  ASSERT_TRUE(store.open());
+  EXPECT_TRUE(store.contains(make_key(1)));
+  Block read(0);
+  EXPECT_FALSE(store.get(make_key(1), read.segments()));
+  EXPECT_FALSE(store.contains(make_key(1)));
+}
+
+TEST_F(DiskBlockStoreTest, ConcurrentPutsAndGets) {
+  DiskBlockStore store(options(/*capacity=*/16));
+  ASSERT_TRUE(store.open());
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(4, 0);
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&store, &mismatches, t]() {
+      for (int i = 0; i < 200; ++i) {
+        const uint8_t id = static_cast<uint8_t>((i * 7 + t) % 40 + 1);
+        Block block(id);
+        store.put(make_key(id), block.segments());
+        Block read(0);
+        if (store.get(make_key(id), read.segments()) && !(read == block)) {
+          ++mismatches[t];
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int mismatch : mismatches) {
+    EXPECT_EQ(mismatch, 0);
+  }
+  EXPECT_LE(store.num_records(), 16u);
+}
+
+}  // namespace xllm
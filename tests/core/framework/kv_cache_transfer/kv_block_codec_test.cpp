@@ -0,0 +1,173 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/kv_cache_transfer/kv_block_codec.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace xllm {
+namespace {
+
+constexpr size_t kHeadDim = 64;
+
+uint16_t to_bf16(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+float from_bf16(uint16_t value) {
+  const uint32_t bits = static_cast<uint32_t>(value) << 16;
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+// a key and a value segment of bf16 values that look like attention
+// activations, plus an opaque segment.
+struct Block {
+  explicit Block(uint32_t seed) : key(16 * kHeadDim), value(16 * kHeadDim) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<float> dist(0.0f, 2.0f);
+    for (size_t i = 0; i < key.size(); ++i) {
+      key[i] = to_bf16(dist(gen));
+      value[i] = to_bf16(dist(gen) * 0.1f);
+    }
+    for (size_t i = 0; i < opaque.size(); ++i) {
+      opaque[i] = static_cast<char>(gen());
+    }
+  }
+
+  static std::vector<KVBlockCodec::SegmentLayout> layout() {
+    const KVBlockCodec::SegmentLayout bf16{KVBlockElementType::kBFloat16,
+                                           /*element_bytes=*/2,
+                                           /*bytes=*/16 * kHeadDim * 2,
+                                           /*group_elements=*/kHeadDim};
+    const KVBlockCodec::SegmentLayout other{KVBlockElementType::kOther,
+                                            /*element_bytes=*/1,
+                                            /*bytes=*/100,
+                                            /*group_elements=*/0};
+    return {bf16, bf16, other};
+  }
+
+  std::vector<const void*> inputs() const {
+    return {key.data(), value.data(), opaque.data()};
+  }
+  std::vector<void*> outputs() {
+    return {key.data(), value.data(), opaque.data()};
+  }
+
+  std::vector<uint16_t> key;
+  std::vector<uint16_t> value;
+  std::vector<char> opaque = std::vector<char>(100);
+};
+
+std::vector<char> encode(const KVBlockCodec& codec, const Block& block) {
+  std::vector<char> encoded(codec.max_encoded_bytes());
+  encoded.resize(codec.encode(block.inputs(), encoded.data()));
+  return encoded;
+}
+
+}  // namespace
+
+TEST(KVBlockCodecTest, ParsesCodecNames) {
+  EXPECT_EQ(parse_kv_block_codec("int8"), KVBlockCodecType::kInt8);
+  EXPECT_EQ(parse_kv_block_codec("lossless"), KVBlockCodecType::kLossless);
+  EXPECT_EQ(parse_kv_block_codec("none"), KVBlockCodecType::kNone);
+  EXPECT_FALSE(parse_kv_block_codec("fp4").has_value());
+  EXPECT_STREQ(kv_block_codec_name(KVBlockCodecType::kLossless), "lossless");
+}
+
+TEST(KVBlockCodecTest, LosslessRoundTripsExactly) {
+  const KVBlockCodec codec(KVBlockCodecType::kLossless, Block::layout());
+  const Block block(1);
+  const std::vector<char> encoded = encode(codec, block);
+  EXPECT_LE(encoded.size(), codec.max_encoded_bytes());
+  // the exponent planes of bf16 compress even when mantissas are noise.
+  EXPECT_LT(encoded.size(), codec.raw_bytes());
+
+  Block decoded(2);
+  ASSERT_TRUE(codec.decode(encoded.data(), encoded.size(), decoded.outputs()));
+  EXPECT_EQ(decoded.key, block.key);
+  EXPECT_EQ(decoded.value, block.value);
+  EXPECT_EQ(decoded.opaque, block.opaque);
+}
+
+TEST(KVBlockCodecTest, Int8HalvesSizeWithinQuantizationError) {
+  const KVBlockCodec codec(KVBlockCodecType::kInt8, Block::layout());
+  const Block block(3);
+  const std::vector<char> encoded = encode(codec, block);
+  EXPECT_EQ(encoded.size(), codec.max_encoded_bytes());
+  EXPECT_LT(encoded.size() * 10, codec.raw_bytes() * 6);
+
+  Block decoded(4);
+  ASSERT_TRUE(codec.decode(encoded.data(), encoded.size(), decoded.outputs()));
+  for (size_t g = 0; g < block.key.size() / kHeadDim; ++g) {
+    float amax = 0.0f;
+    for (size_t i = 0; i < kHeadDim; ++i) {
+      amax = std::max(amax, std::fabs(from_bf16(block.key[g * kHeadDim + i])));
+    }
+    // half a quantization step plus bf16 rounding of the result.
+    const float tolerance = amax / 127.0f * 0.5f + amax / 128.0f;
+    for (size_t i = 0; i < kHeadDim; ++i) {
+      const size_t index = g * kHeadDim + i;
+      EXPECT_NEAR(from_bf16(decoded.key[index]),
+                  from_bf16(block.key[index]),
+                  tolerance)
+          << "element " << index;
+    }
+  }
+  EXPECT_EQ(decoded.opaque, block.opaque);
+}
+
+TEST(KVBlockCodecTest, Int8RoundTripsHalfPrecision) {
+  const std::vector<uint16_t> halves = {
+      0x0000, 0x3c00, 0xbc00, 0x0001, 0x03ff, 0x7bff, 0x3555, 0xc000};
+  const KVBlockCodec codec(KVBlockCodecType::kInt8,
+                           {{KVBlockElementType::kFloat16,
+                             /*element_bytes=*/2,
+                             /*bytes=*/halves.size() * 2,
+                             /*group_elements=*/1}});
+  // one element per group is exact up to the int8 step of 1/127 of itself.
+  std::vector<char> encoded(codec.max_encoded_bytes());
+  encoded.resize(codec.encode({halves.data()}, encoded.data()));
+  std::vector<uint16_t> decoded(halves.size());
+  ASSERT_TRUE(codec.decode(encoded.data(), encoded.size(), {decoded.data()}));
+  EXPECT_EQ(decoded, halves);
+}
+
+TEST(KVBlockCodecTest, RejectsForeignRecords) {
+  const KVBlockCodec lossless(KVBlockCodecType::kLossless, Block::layout());
+  const KVBlockCodec int8(KVBlockCodecType::kInt8, Block::layout());
+  const Block block(5);
+  std::vector<char> encoded = encode(lossless, block);
+
+  Block decoded(6);
+  EXPECT_FALSE(int8.decode(encoded.data(), encoded.size(), decoded.outputs()));
+  EXPECT_FALSE(
+      lossless.decode(encoded.data(), encoded.size() - 1, decoded.outputs()));
+  encoded[encoded.size() / 2] ^= 0x5a;
+  encoded[encoded.size() / 2 + 1] ^= 0x3c;
+  // the frame checksum catches corruption instead of returning wrong bytes.
+  EXPECT_FALSE(
+      lossless.decode(encoded.data(), encoded.size(), decoded.outputs()));
+}
+
+}  // namespace xllm
@@ -0,0 +1,119 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/kv_cache_transfer/local_kv_store_backend.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace xllm {
+namespace {
+
+std::vector<KVStoreSlice> slices_of(std::vector<char>& k,
+                                    std::vector<char>& v) {
+  return {KVStoreSlice{k.data(), k.size()}, KVStoreSlice{v.data(), v.size()}};
+}
+
+TEST(LocalKVStoreBackendTest, PutGetRoundTrip) {
+  LocalKVStoreBackend backend(LocalKVStoreBackend::Options{});
+  std::vector<char> k(16, 'k');
+  std::vector<char> v(32, 'v');
+  EXPECT_EQ(backend.batch_exist({"a", "b"}), std::vector<uint8_t>({0, 0}));
+  EXPECT_EQ(backend.batch_put({"a"}, {slices_of(k, v)}),
+            std::vector<uint8_t>({1}));
+  EXPECT_EQ(backend.batch_exist({"a", "b"}), std::vector<uint8_t>({1, 0}));
+  EXPECT_EQ(backend.used_bytes(), 48u);
+
+  std::vector<char> out_k(16, 0);
+  std::vector<char> out_v(32, 0);
+  EXPECT_EQ(backend.batch_get({"b", "a"}, {{}, slices_of(out_k, out_v)}),
+            std::vector<uint8_t>({0, 1}));
+  EXPECT_EQ(out_k, k);
+  EXPECT_EQ(out_v, v);
+}
+
+TEST(LocalKVStoreBackendTest, GetIntoLargerBuffer) {
+  LocalKVStoreBackend backend(LocalKVStoreBackend::Options{});
+  std::vector<char> record(10, 'r');
+  backend.batch_put({"a"}, {{KVStoreSlice{record.data(), record.size()}}});
+
+  std::vector<char> out(64, 0);
+  EXPECT_EQ(backend.batch_get({"a"}, {{KVStoreSlice{out.data(), out.size()}}}),
+            std::vector<uint8_t>({1}));
+  EXPECT_EQ(std::string(out.data(), 10), std::string(10, 'r'));
+
+  std::vector<char> small(4, 0);
+  EXPECT_EQ(
+      backend.batch_get({"a"}, {{KVStoreSlice{small.data(), small.size()}}}),
+      std::vector<uint8_t>({0}));
+}
+
+TEST(LocalKVStoreBackendTest, EvictsLeastRecentlyUsed) {
+  LocalKVStoreBackend::Options options;
+  options.capacity_bytes(64);
+  LocalKVStoreBackend backend(options);
+  std::vector<char> block(32, 'x');
+  const KVStoreSlice slice{block.data(), block.size()};
+
+  backend.batch_put({"a", "b"}, {{slice}, {slice}});
+  // touch "a" so that "b" is the eviction victim.
+  backend.batch_get({"a"}, {{slice}});
+  backend.batch_put({"c"}, {{slice}});
+  EXPECT_EQ(backend.batch_exist({"a", "b", "c"}),
+            std::vector<uint8_t>({1, 0, 1}));
+  EXPECT_EQ(backend.num_objects(), 2u);
+  EXPECT_EQ(backend.used_bytes(), 64u);
+
+  std::vector<char> huge(128, 'h');
+  EXPECT_EQ(backend.batch_put({"d"}, {{KVStoreSlice{huge.data(), 128}}}),
+            std::vector<uint8_t>({0}));
+}
+
+TEST(LocalKVStoreBackendTest, SimulatesLatencyAndBandwidth) {
+  LocalKVStoreBackend::Options options;
+  // 1 MB at 100 MB/s takes 10 ms on top of the 2 ms round trip.
+  options.bandwidth_bytes_per_second(100e6).latency_us(2000);
+  LocalKVStoreBackend backend(options);
+  std::vector<char> block(1000000, 'x');
+
+  const auto start = std::chrono::steady_clock::now();
+  backend.batch_put({"a"}, {{KVStoreSlice{block.data(), block.size()}}});
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_GE(elapsed, std::chrono::milliseconds(12));
+}
+
+TEST(LocalKVStoreBackendTest, SharedPerOptions) {
+  LocalKVStoreBackend::Options options;
+  options.capacity_bytes(64);
+  std::shared_ptr<LocalKVStoreBackend> first =
+      LocalKVStoreBackend::get_shared(options);
+  std::shared_ptr<LocalKVStoreBackend> second =
+      LocalKVStoreBackend::get_shared(options);
+  EXPECT_EQ(first, second);
+
+  std::vector<char> block(32, 'x');
+  first->batch_put({"a"}, {{KVStoreSlice{block.data(), block.size()}}});
+  EXPECT_EQ(second->batch_exist({"a"}), std::vector<uint8_t>({1}));
+
+  options.capacity_bytes(128);
+  EXPECT_NE(LocalKVStoreBackend::get_shared(options), first);
+}
+
+}  // namespace
+}  // namespace xllm
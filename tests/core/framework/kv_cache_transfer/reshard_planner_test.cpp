@@ -1053,6 +1053,50 @@ TEST(RequestRegionBinderTest, RejectsOutOfRangeNonContiguousResourceIds) {
   EXPECT_TRUE(regions.empty());
 }
 
+ByteRegion make_region(uint64_t buffer_id,
+                       uint64_t local_offset,
+                       uint64_t remote_offset,
+                       uint64_t length) {
+  ByteRegion region;
+  region.local_buffer_id = buffer_id;
+  region.remote_buffer_id = buffer_id;
+  region.local_offset = local_offset;
+  region.remote_offset = remote_offset;
+  region.length = length;
+  return region;
+}
+
+TEST(CoalesceByteRegionsTest, MergesRunsAdjacentOnBothSides) {
+  // blocks 5, 3, 4 -> remote 9, 7, 8 and block 6 -> remote 20.
+  std::vector<ByteRegion> regions = {make_region(0, 500, 900, 100),
+                                     make_region(0, 300, 700, 100),
+                                     make_region(0, 400, 800, 100),
+                                     make_region(0, 600, 2000, 100)};
+  coalesce_byte_regions(&regions);
+
+  ASSERT_EQ(regions.size(), 2u);
+  EXPECT_EQ(regions[0].local_offset, 300u);
+  EXPECT_EQ(regions[0].remote_offset, 700u);
+  EXPECT_EQ(regions[0].length, 300u);
+  EXPECT_EQ(regions[1].local_offset, 600u);
+  EXPECT_EQ(regions[1].remote_offset, 2000u);
+  EXPECT_EQ(regions[1].length, 100u);
+}
+
+TEST(CoalesceByteRegionsTest, KeepsBuffersApart) {
+  std::vector<ByteRegion> regions = {make_region(1, 100, 100, 100),
+                                     make_region(0, 0, 0, 100),
+                                     make_region(1, 0, 0, 100),
+                                     make_region(0, 100, 100, 100)};
+  coalesce_byte_regions(&regions);
+
+  ASSERT_EQ(regions.size(), 2u);
+  EXPECT_EQ(regions[0].local_buffer_id, 0u);
+  EXPECT_EQ(regions[0].length, 200u);
+  EXPECT_EQ(regions[1].local_buffer_id, 1u);
+  EXPECT_EQ(regions[1].length, 200u);
+}
+
 }  // namespace
 
 }  // namespace xllm
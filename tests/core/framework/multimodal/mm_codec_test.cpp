@@ -0,0 +1,121 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/multimodal/mm_codec.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+namespace xllm {
+namespace {
+
+// A marker segment: 0xFF, the marker, the big-endian length and the payload.
+std::string segment(uint8_t marker, const std::string& payload) {
+  const size_t length = payload.size() + 2;
+  std::string bytes = {'\xFF', static_cast<char>(marker)};
+  bytes += static_cast<char>(length >> 8);
+  bytes += static_cast<char>(length & 0xFF);
+  return bytes + payload;
+}
+
+// The SOFn payload: precision, height, width and one component.
+std::string frame_header(uint16_t height, uint16_t width) {
+  std::string payload = {'\x08'};
+  payload += static_cast<char>(height >> 8);
+  payload += static_cast<char>(height & 0xFF);
+  payload += static_cast<char>(width >> 8);
+  payload += static_cast<char>(width & 0xFF);
+  payload += std::string("\x01\x01\x11\x00", 4);
+  return payload;
+}
+
+// A JPEG header up to the first scan, with tables ahead of the frame.
+std::string make_jpeg(uint8_t frame_marker, uint16_t height, uint16_t width) {
+  const std::string jfif("JFIF\0\x01\x01\x00\x00\x01\x00\x01\0\0", 14);
+  return std::string("\xFF\xD8", 2) + segment(0xE0, jfif) +
+         segment(0xDB, std::string(65, '\x01')) +
+         segment(0xC4, std::string(29, '\x00')) +
+         segment(frame_marker, frame_header(height, width)) +
+         segment(0xDA, std::string(8, '\x00')) + std::string(16, '\x55');
+}
+
+TEST(MMCodecTest, ReadsBaselineAndProgressiveFrameSize) {
+  int32_t height = 0;
+  int32_t width = 0;
+  ASSERT_TRUE(read_jpeg_frame_size(make_jpeg(0xC0, 2160, 3840), height, width));
+  EXPECT_EQ(height, 2160);
+  EXPECT_EQ(width, 3840);
+
+  // progressive (SOF2) and extended (SOF1) frames carry the same header.
+  ASSERT_TRUE(read_jpeg_frame_size(make_jpeg(0xC2, 480, 640), height, width));
+  EXPECT_EQ(height, 480);
+  EXPECT_EQ(width, 640);
+  ASSERT_TRUE(read_jpeg_frame_size(make_jpeg(0xC1, 17, 33), height, width));
+  EXPECT_EQ(height, 17);
+  EXPECT_EQ(width, 33);
+}
+
+TEST(MMCodecTest, SkipsFillBytesBeforeMarkers) {
+  const std::string jpeg = make_jpeg(0xC0, 300, 400);
+  // fill bytes may precede any marker.
+  const std::string padded =
+      jpeg.substr(0, 2) + std::string(3, '\xFF') + jpeg.substr(2);
+  int32_t height = 0;
+  int32_t width = 0;
+  ASSERT_TRUE(read_jpeg_frame_size(padded, height, width));
+  EXPECT_EQ(height, 300);
+  EXPECT_EQ(width, 400);
+}
+
+TEST(MMCodecTest, RejectsTruncatedHeaders) {
+  const std::string jpeg = make_jpeg(0xC2, 480, 640);
+  const size_t frame_offset = jpeg.find(std::string("\xFF\xC2", 2));
+  ASSERT_NE(frame_offset, std::string::npos);
+  int32_t height = 0;
+  int32_t width = 0;
+  // every cut before the width bytes of the frame header is rejected.
+  for (size_t size = 0; size < frame_offset + 9; ++size) {
+    EXPECT_FALSE(read_jpeg_frame_size(jpeg.substr(0, size), height, width))
+        << "size=" << size;
+  }
+  EXPECT_TRUE(
+      read_jpeg_frame_size(jpeg.substr(0, frame_offset + 9), height, width));
+}
+
+TEST(MMCodecTest, RejectsOtherFormatsAndMalformedStreams) {
+  int32_t height = 0;
+  int32_t width = 0;
+  EXPECT_FALSE(read_jpeg_frame_size(
+      std::string("\x89PNG\r\n\x1a\n\0\0\0\rIHDR", 16), height, width));
+
+  // a scan before any frame header.
+  const std::string scan_first = std::string("\xFF\xD8", 2) +
+                                 segment(0xDA, std::string(8, '\x00')) +
+                                 segment(0xC0, frame_header(480, 640));
+  EXPECT_FALSE(read_jpeg_frame_size(scan_first, height, width));
+
+  // a zero-sized frame.
+  EXPECT_FALSE(read_jpeg_frame_size(make_jpeg(0xC0, 0, 640), height, width));
+
+  // garbage where a marker should be.
+  std::string garbage = make_jpeg(0xC0, 480, 640);
+  garbage[2] = '\x00';
+  EXPECT_FALSE(read_jpeg_frame_size(garbage, height, width));
+}
+
+}  // namespace
+}  // namespace xllm
@@ -0,0 +1,154 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/prefix_cache/kv_cache_summary.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "framework/prefix_cache/block_hasher.h"
+
+namespace xllm {
+namespace {
+
+XXH3Key make_key(uint64_t low, uint64_t high) {
+  XXH3Key key;
+  std::memcpy(key.data, &low, sizeof(low));
+  std::memcpy(key.data + sizeof(low), &high, sizeof(high));
+  return key;
+}
+
+std::vector<XXH3Key> make_chain(size_t n_blocks, uint64_t seed) {
+  std::vector<XXH3Key> keys;
+  for (size_t i = 0; i < n_blocks; ++i) {
+    keys.push_back(
+        make_key(seed * 1000003 + i * 7919, seed * 31 + i * 104729));
+  }
+  return keys;
+}
+
+KVCacheSummary::Options small_options() {
+  KVCacheSummary::Options options;
+  options.num_counters(4096).num_hashes(3);
+  return options;
+}
+
+TEST(KVCacheSummaryTest, AddRemove) {
+  KVCacheSummary summary(small_options());
+  const std::vector<XXH3Key> keys = make_chain(4, /*seed=*/1);
+
+  summary.add(keys);
+  for (const XXH3Key& key : keys) {
+    EXPECT_TRUE(summary.may_contain(key));
+  }
+
+  summary.remove({keys[3]});
+  EXPECT_FALSE(summary.may_contain(keys[3]));
+  EXPECT_TRUE(summary.may_contain(keys[0]));
+}
+
+TEST(KVCacheSummaryTest, CountsDuplicateInserts) {
+  KVCacheSummary summary(small_options());
+  const XXH3Key key = make_key(42, 43);
+
+  // e.g. the same block cached by two DP ranks.
+  summary.add({key});
+  summary.add({key});
+  summary.remove({key});
+  EXPECT_TRUE(summary.may_contain(key));
+  summary.remove({key});
+  EXPECT_FALSE(summary.may_contain(key));
+}
+
+TEST(KVCacheSummaryTest, EstimateMatchBlocksStopsAtFirstMiss) {
+  KVCacheSummary summary(small_options());
+  const std::vector<XXH3Key> keys = make_chain(8, /*seed=*/2);
+  summary.add({keys[0], keys[1], keys[2], keys[5]});
+
+  EXPECT_EQ(summary.estimate_match_blocks(keys), 3u);
+  EXPECT_EQ(summary.estimate_match_blocks(make_chain(4, /*seed=*/3)), 0u);
+}
+
+TEST(KVCacheSummaryTest, MirrorFollowsDeltas) {
+  KVCacheSummary instance(small_options());
+  KVCacheSummary mirror(small_options());
+  const std::vector<XXH3Key> keys = make_chain(6, /*seed=*/4);
+
+  // the first delta is always a full snapshot.
+  instance.add({keys[0], keys[1]});
+  KVCacheSummary::Delta delta = instance.take_delta();
+  EXPECT_TRUE(delta.full);
+  ASSERT_TRUE(mirror.apply(delta));
+  EXPECT_EQ(mirror.estimate_match_blocks(keys), 2u);
+
+  instance.add({keys[2], keys[3]});
+  instance.remove({keys[1]});
+  delta = instance.take_delta();
+  EXPECT_FALSE(delta.full);
+  EXPECT_LE(delta.indices.size(), 9u);
+  ASSERT_TRUE(mirror.apply(delta));
+  EXPECT_TRUE(mirror.may_contain(keys[3]));
+  EXPECT_FALSE(mirror.may_contain(keys[1]));
+
+  EXPECT_TRUE(instance.take_delta().empty());
+}
+
+TEST(KVCacheSummaryTest, MirrorWaitsForSnapshotAfterLostDelta) {
+  KVCacheSummary instance(small_options());
+  KVCacheSummary mirror(small_options());
+  const std::vector<XXH3Key> keys = make_chain(3, /*seed=*/5);
+
+  ASSERT_TRUE(mirror.apply(instance.take_delta()));
+  instance.add({keys[0]});
+  instance.take_delta();  // lost
+  instance.add({keys[1]});
+  EXPECT_FALSE(mirror.apply(instance.take_delta()));
+  EXPECT_EQ(mirror.estimate_match_blocks(keys), 0u);
+
+  instance.request_full_snapshot();
+  KVCacheSummary::Delta delta = instance.take_delta();
+  EXPECT_TRUE(delta.full);
+  ASSERT_TRUE(mirror.apply(delta));
+  EXPECT_EQ(mirror.estimate_match_blocks(keys), 2u);
+}
+
+TEST(KVCacheSummaryTest, PeriodicFullSnapshot) {
+  KVCacheSummary::Options options = small_options();
+  options.full_snapshot_interval(2);
+  KVCacheSummary summary(options);
+
+  EXPECT_TRUE(summary.take_delta().full);
+  EXPECT_FALSE(summary.take_delta().full);
+  EXPECT_FALSE(summary.take_delta().full);
+  EXPECT_TRUE(summary.take_delta().full);
+}
+
+TEST(KVCacheSummaryTest, EstimateFromTokenIds) {
+  KVCacheSummary summary(small_options());
+  const int32_t block_size = 4;
+  std::vector<int32_t> token_ids = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  std::vector<XXH3Key> keys(2);
+  const Slice<int32_t> tokens(token_ids);
+  xxh3_128bits_hash(nullptr, tokens.slice(0, 4), keys[0].data);
+  xxh3_128bits_hash(keys[0].data, tokens.slice(4, 8), keys[1].data);
+  summary.add({keys[0]});
+
+  EXPECT_EQ(summary.estimate_match_blocks(tokens, block_size), 1u);
+}
+
+}  // namespace
+}  // namespace xllm
@@ -15,8 +15,11 @@ limitations under the License.
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <thread>
 #include <vector>
 
 #include "framework/request/incremental_decoder.h"
@@ -25,12 +28,17 @@ limitations under the License.
 namespace xllm {
 namespace {
 
-Sequence make_decode_ready_sequence(bool enable_schedule_overlap) {
+Sequence make_decode_ready_sequence(
+    bool enable_schedule_overlap,
+    std::shared_ptr<const std::vector<int32_t>> prompt_token_ids =
+        std::make_shared<const std::vector<int32_t>>(
+            std::vector<int32_t>{1, 2, 3}),
+    size_t capacity = 8) {
   static RequestSamplingParam sampling_param;
   static StoppingChecker stopping_checker;
 
   SequenceParams params;
-  params.seq_capacity = 8;
+  params.seq_capacity = capacity;
   params.echo = false;
   params.skip_special_tokens = true;
   params.streaming = false;
@@ -41,14 +49,16 @@ Sequence make_decode_ready_sequence(bool enable_schedule_overlap) {
   params.sampling_param = &sampling_param;
   params.stopping_checker = &stopping_checker;
 
-  std::vector<int32_t> prompt_token_ids = {1, 2, 3};
+  params.logprobs = true;
+  sampling_param.logprobs = true;
+
   IncrementalDecoder decoder(
       /*prompt=*/"prompt",
-      /*num_prompt_tokens=*/prompt_token_ids.size(),
+      /*num_prompt_tokens=*/prompt_token_ids->size(),
       /*echo=*/params.echo,
       /*skip_special_tokens=*/params.skip_special_tokens);
   Sequence sequence(/*index=*/0,
-                    prompt_token_ids,
+                    std::move(prompt_token_ids),
                     /*input_embedding=*/torch::Tensor(),
                     /*mm_data=*/MMData(),
                     decoder,
@@ -109,4 +119,90 @@ TEST(SequenceGeneratedTokensTest, CountsOverlapCommittedTokens) {
   EXPECT_EQ(sequence.generated_tokens_since_latency(), 2u);
 }
 
+TEST(SequenceGeneratedTokensTest, SharedPromptIsCopiedOnFirstWrite) {
+  const auto prompt_token_ids = std::make_shared<const std::vector<int32_t>>(
+      std::vector<int32_t>{1, 2, 3});
+  Sequence first = make_decode_ready_sequence(
+      /*enable_schedule_overlap=*/false, prompt_token_ids);
+  Sequence second = make_decode_ready_sequence(
+      /*enable_schedule_overlap=*/false, prompt_token_ids);
+  EXPECT_EQ(first.tokens().data(), prompt_token_ids->data());
+  EXPECT_EQ(second.tokens().data(), prompt_token_ids->data());
+
+  first.append_token(Token(10));
+  EXPECT_EQ(first.tokens(), (std::vector<int32_t>{1, 2, 3, 10}));
+  EXPECT_EQ(second.tokens(), (std::vector<int32_t>{1, 2, 3}));
+  EXPECT_EQ(second.tokens().data(), prompt_token_ids->data());
+  EXPECT_EQ(*prompt_token_ids, (std::vector<int32_t>{1, 2, 3}));
+
+  second.append_token(Token(20));
+  EXPECT_EQ(second.tokens(), (std::vector<int32_t>{1, 2, 3, 20}));
+  EXPECT_NE(second.tokens().data(), prompt_token_ids->data());
+  // kept alive for streaming responses that may still read the prompt.
+  EXPECT_EQ(prompt_token_ids.use_count(), 3);
+}
+
+TEST(SequenceGeneratedTokensTest, LogprobsCoverGeneratedTokensOnly) {
+  Sequence sequence = make_decode_ready_sequence(
+      /*enable_schedule_overlap=*/false);
+  Token token(10);
+  token.logprob = -0.5f;
+  sequence.append_token(token);
+
+  const LogprobState* logprob_state = sequence.logprob_state();
+  EXPECT_FALSE(logprob_state->get_logprob(0).has_value());
+  ASSERT_TRUE(logprob_state->get_logprob(3).has_value());
+  EXPECT_FLOAT_EQ(logprob_state->get_logprob(3).value(), -0.5f);
+  EXPECT_FALSE(logprob_state->get_logprob(4).has_value());
+  EXPECT_TRUE(logprob_state->get_top_tokens(3).empty());
+}
+
+TEST(SequenceGeneratedTokensTest, StreamingReaderSeesStableBuffers) {
+  // The response threads read tokens and logprobs of a sequence while the
+  // scheduler appends to it; neither buffer may move under the reader.
+  constexpr size_t kNumGenerated = 4096;
+  Sequence sequence = make_decode_ready_sequence(
+      /*enable_schedule_overlap=*/false,
+      std::make_shared<const std::vector<int32_t>>(
+          std::vector<int32_t>{1, 2, 3}),
+      /*capacity=*/3 + kNumGenerated + 1);
+  const size_t num_prompt_tokens = sequence.num_prompt_tokens();
+
+  std::atomic<size_t> num_published(sequence.num_tokens());
+  std::atomic<bool> done(false);
+  size_t num_mismatches = 0;
+  std::thread reader([&]() {
+    while (!done.load(std::memory_order_acquire)) {
+      const size_t size = num_published.load(std::memory_order_acquire);
+      const int32_t* tokens = sequence.tokens().data();
+      const LogprobState* logprob_state = sequence.logprob_state();
+      for (size_t i = 0; i < size; ++i) {
+        const int32_t expected = i < num_prompt_tokens
+                                     ? static_cast<int32_t>(i) + 1
+                                     : static_cast<int32_t>(i) + 100;
+        if (tokens[i] != expected) {
+          ++num_mismatches;
+        }
+        if (i >= num_prompt_tokens &&
+            logprob_state->get_logprob(i) != -static_cast<float>(i)) {
+          ++num_mismatches;
+        }
+      }
+    }
+  });
+
+  for (size_t i = num_prompt_tokens; i < num_prompt_tokens + kNumGenerated;
+       ++i) {
+    Token token(static_cast<int64_t>(i) + 100);
+    token.logprob = -static_cast<float>(i);
+    sequence.append_token(token);
+    num_published.store(sequence.num_tokens(), std::memory_order_release);
+  }
+  done.store(true, std::memory_order_release);
+  reader.join();
+
+  EXPECT_EQ(num_mismatches, 0u);
+  EXPECT_EQ(sequence.num_generated_tokens(), kNumGenerated);
+}
+
 }  // namespace xllm
@@ -56,7 +56,8 @@ class SequenceStopOutputTest : public ::testing::Test {
                   bool include_stop_str_in_output = false,
                   int32_t eos_token = -1,
                   bool skip_special_tokens = false,
-                  bool logprobs = false) {
+                  bool logprobs = false,
+                  bool skip_detokenize = false) {
     stopping_checker_ = StoppingChecker(max_generated_tokens,
                                         /*max_context_len=*/0,
                                         eos_token,
@@ -70,6 +71,7 @@ class SequenceStopOutputTest : public ::testing::Test {
     params.skip_special_tokens = skip_special_tokens;
     params.include_stop_str_in_output = include_stop_str_in_output;
     params.logprobs = logprobs;
+    params.skip_detokenize = skip_detokenize;
     params.streaming = false;
     params.enable_schedule_overlap = false;
     params.rec_type = RecType::kNone;
@@ -127,6 +129,44 @@ TEST_F(SequenceStopOutputTest, NonStreamingExcludesStopTokenFromText) {
   EXPECT_EQ(output.token_ids[1], StopAwareTokenizer::kStopTokenId);
 }
 
+TEST_F(SequenceStopOutputTest, SkipDetokenizeReturnsTokenIdsOnly) {
+  const auto init = [this]() {
+    initialize(/*max_generated_tokens=*/8,
+               /*stop_tokens=*/{StopAwareTokenizer::kStopTokenId},
+               /*stop_sequences=*/{},
+               /*prompt_tokens=*/{'P'},
+               /*include_stop_str_in_output=*/false,
+               /*eos_token=*/-1,
+               /*skip_special_tokens=*/false,
+               /*logprobs=*/false,
+               /*skip_detokenize=*/true);
+  };
+
+  init();
+  append_token('A');
+  append_token('B');
+  append_token(StopAwareTokenizer::kStopTokenId);
+  ASSERT_TRUE(sequence_->finished());
+  SequenceOutput output = sequence_->generate_output(tokenizer_);
+  EXPECT_TRUE(output.text.empty());
+  ASSERT_EQ(output.token_ids.size(), 3);
+  EXPECT_EQ(output.token_ids[0], 'A');
+  EXPECT_EQ(output.token_ids[1], 'B');
+  EXPECT_EQ(output.token_ids[2], StopAwareTokenizer::kStopTokenId);
+
+  // streaming deltas carry only the new token ids.
+  init();
+  for (const int32_t token_id : {'A', 'B'}) {
+    append_token(token_id);
+    auto delta = sequence_->generate_streaming_output(sequence_->num_tokens(),
+                                                      tokenizer_);
+    ASSERT_TRUE(delta.has_value());
+    EXPECT_TRUE(delta->text.empty());
+    ASSERT_EQ(delta->token_ids.size(), 1);
+    EXPECT_EQ(delta->token_ids[0], token_id);
+  }
+}
+
 TEST_F(SequenceStopOutputTest, StreamingDoesNotEmitStopTokenDelta) {
   initialize(/*max_generated_tokens=*/8,
              /*stop_tokens=*/{StopAwareTokenizer::kStopTokenId});
@@ -0,0 +1,170 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "core/framework/sampling/rec_constraint_mask.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace xllm {
+namespace {
+
+constexpr int32_t kVocabSize = 32;
+constexpr float kFillValue = -10000.0f;
+
+std::shared_ptr<RecVocabSnapshot> make_snapshot(
+    const std::vector<RecTokenTriple>& triples) {
+  std::vector<RecVocabRecord> records;
+  for (size_t i = 0; i < triples.size(); ++i) {
+    RecVocabRecord record;
+    record.item_id = static_cast<int64_t>(i);
+    record.tokens = triples[i];
+    records.emplace_back(std::move(record));
+  }
+  return RecVocabSnapshot::build(records, /*has_item_strings=*/false);
+}
+
+std::vector<RecTokenTriple> random_triples(std::mt19937& gen, int32_t count) {
+  // a narrow t0 range keeps prefixes shared so degrees exceed one.
+  std::uniform_int_distribution<int32_t> t0_dist(0, 5);
+  std::uniform_int_distribution<int32_t> token_dist(0, kVocabSize - 1);
+  std::vector<RecTokenTriple> triples;
+  for (int32_t i = 0; i < count; ++i) {
+    triples.push_back({t0_dist(gen), token_dist(gen) % 6, token_dist(gen)});
+  }
+  return triples;
+}
+
+std::vector<int32_t> row_tokens(const torch::Tensor& allowed, int64_t row) {
+  std::vector<int32_t> tokens;
+  for (int64_t j = 0; j < allowed.size(1); ++j) {
+    const int64_t token = allowed[row][j].item<int64_t>();
+    if (token < kVocabSize) {
+      tokens.emplace_back(static_cast<int32_t>(token));
+    }
+  }
+  return tokens;
+}
+
+torch::Tensor to_prefix_tensor(
+    const std::vector<std::vector<int32_t>>& prefixes) {
+  const int64_t step = static_cast<int64_t>(prefixes[0].size());
+  std::vector<int32_t> flat;
+  for (const auto& prefix : prefixes) {
+    flat.insert(flat.end(), prefix.begin(), prefix.end());
+  }
+  return torch::tensor(flat, torch::kInt32)
+      .view({static_cast<int64_t>(prefixes.size()), step});
+}
+
+}  // namespace
+
+TEST(RecConstraintMaskTest, ReferenceMatchesSnapshotLookups) {
+  std::mt19937 gen(7);
+  auto snapshot = make_snapshot(random_triples(gen, /*count=*/200));
+  const RecConstraintTables tables =
+      snapshot->build_constraint_tables(kVocabSize);
+
+  std::vector<std::vector<int32_t>> prefixes = {{}};
+  for (int32_t t0 = 0; t0 < 8; ++t0) {
+    prefixes.push_back({t0});
+    for (int32_t t1 = 0; t1 < 8; ++t1) {
+      prefixes.push_back({t0, t1});
+    }
+  }
+
+  const auto allowed =
+      rec_constraint_allowed_tokens_reference(tables, prefixes);
+  for (size_t i = 0; i < prefixes.size(); ++i) {
+    Slice<int32_t> expected =
+        snapshot->get_next_tokens_by_prefix_tokens(prefixes[i]);
+    EXPECT_EQ(allowed[i],
+              std::vector<int32_t>(expected.begin(), expected.end()))
+        << "prefix index " << i;
+  }
+}
+
+TEST(RecConstraintMaskTest, DeviceTablesMatchReference) {
+  std::mt19937 gen(11);
+  auto snapshot = make_snapshot(random_triples(gen, /*count=*/300));
+  const RecConstraintTables tables =
+      snapshot->build_constraint_tables(kVocabSize);
+  RecConstraintDeviceTables device_tables(tables, torch::kCPU);
+
+  std::uniform_int_distribution<int32_t> token_dist(-2, kVocabSize + 2);
+  for (int32_t step = 1; step < REC_TOKEN_SIZE; ++step) {
+    std::vector<std::vector<int32_t>> prefixes;
+    for (int32_t i = 0; i < 256; ++i) {
+      std::vector<int32_t> prefix;
+      for (int32_t j = 0; j < step; ++j) {
+        // mostly known prefixes, plus unknown and out-of-range tokens.
+        prefix.push_back(i % 4 == 0 ? token_dist(gen) : token_dist(gen) % 6);
+      }
+      prefixes.emplace_back(std::move(prefix));
+    }
+
+    const auto expected =
+        rec_constraint_allowed_tokens_reference(tables, prefixes);
+    const torch::Tensor allowed =
+        device_tables.allowed_tokens(to_prefix_tensor(prefixes));
+    ASSERT_EQ(allowed.size(0), static_cast<int64_t>(prefixes.size()));
+    for (size_t i = 0; i < prefixes.size(); ++i) {
+      EXPECT_EQ(row_tokens(allowed, static_cast<int64_t>(i)), expected[i])
+          << "step " << step << ", prefix index " << i;
+    }
+  }
+}
+
+TEST(RecConstraintMaskTest, BuildMaskAllowsOnlyValidNextTokens) {
+  auto snapshot = make_snapshot({{1, 2, 3}, {1, 2, 4}, {1, 5, 6}, {7, 8, 9}});
+  RecConstraintDeviceTables device_tables(
+      snapshot->build_constraint_tables(kVocabSize), torch::kCPU);
+
+  const torch::Tensor mask = device_tables.build_mask(
+      to_prefix_tensor({{1, 2}, {7, 8}, {1, 8}}), torch::kFloat32, kFillValue);
+  ASSERT_EQ(mask.size(0), 3);
+  ASSERT_EQ(mask.size(1), kVocabSize);
+
+  torch::Tensor expected = torch::full({3, kVocabSize}, kFillValue);
+  expected[0][3] = 0.0f;
+  expected[0][4] = 0.0f;
+  expected[1][9] = 0.0f;
+  // [1, 8] is not a prefix of any item, so every token stays masked.
+  EXPECT_TRUE(torch::equal(mask.contiguous(), expected));
+
+  const torch::Tensor first_step_mask = device_tables.build_mask(
+      to_prefix_tensor({{1}, {7}}), torch::kFloat32, kFillValue);
+  EXPECT_TRUE(torch::equal((first_step_mask == 0).sum(/*dim=*/1),
+                           torch::tensor({2, 1}, torch::kLong)));
+  EXPECT_EQ(first_step_mask[0][5].item<float>(), 0.0f);
+  EXPECT_EQ(first_step_mask[1][8].item<float>(), 0.0f);
+}
+
+TEST(RecConstraintMaskTest, EmptyCatalogMasksEverything) {
+  auto snapshot = make_snapshot({});
+  RecConstraintDeviceTables device_tables(
+      snapshot->build_constraint_tables(kVocabSize), torch::kCPU);
+
+  for (const auto& prefixes : std::vector<std::vector<std::vector<int32_t>>>{
+           {{1}, {2}}, {{1, 2}, {3, 4}}}) {
+    const torch::Tensor mask = device_tables.build_mask(
+        to_prefix_tensor(prefixes), torch::kFloat32, kFillValue);
+    EXPECT_EQ((mask == 0).sum().item<int64_t>(), 0);
+  }
+}
+
+}  // namespace xllm
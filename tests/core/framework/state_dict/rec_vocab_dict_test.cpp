@@ -57,13 +57,25 @@ void write_vocab_file(
   }
 }
 
-std::vector<int32_t> sorted_next_tokens(
-    const std::unordered_set<int32_t>& token_set) {
-  std::vector<int32_t> tokens(token_set.begin(), token_set.end());
-  std::sort(tokens.begin(), tokens.end());
+std::vector<int32_t> sorted_next_tokens(const std::vector<int32_t>& tokens) {
+  EXPECT_TRUE(std::is_sorted(tokens.begin(), tokens.end()));
   return tokens;
 }
 
+std::vector<int64_t> items_by_tokens(const RecVocabDict& vocab_dict,
+                                     const RecTokenTriple& tokens) {
+  std::vector<int64_t> item_ids;
+  vocab_dict.get_items_by_tokens(tokens, &item_ids);
+  return item_ids;
+}
+
+std::vector<int32_t> tokens_by_item(const RecVocabDict& vocab_dict,
+                                    int64_t item_id) {
+  std::vector<int32_t> token_ids;
+  vocab_dict.get_tokens_by_item(item_id, &token_ids);
+  return token_ids;
+}
+
 std::vector<int32_t> prefix1_values_for_token(const RecConstraintTables& tables,
                                               int32_t t0) {
   const int32_t begin = tables.prefix1_offsets[static_cast<size_t>(t0)];
@@ -168,4 +180,181 @@ TEST(RecVocabDictTest, BuildConstraintTablesMatchesLegacyPrefixMap) {
   std::filesystem::remove(vocab_path);
 }
 
+TEST(RecVocabDictTest, CompactLayoutIsEquivalent) {
+  const std::filesystem::path dir(::testing::TempDir());
+  const std::filesystem::path legacy_path = dir / "rec_vocab_legacy.bin";
+  const std::filesystem::path compact_path = dir / "rec_vocab_compact.bin";
+  write_vocab_file(legacy_path,
+                   {
+                       {100, RecTokenTriple{1, 2, 3}},
+                       {101, RecTokenTriple{1, 2, 4}},
+                       {102, RecTokenTriple{7, 8, 9}},
+                       {105, RecTokenTriple{1, 2, 3}},
+                       // a repeated item id keeps its last triple.
+                       {101, RecTokenTriple{7, 8, 10}},
+                   });
+
+  RecVocabDict legacy;
+  ASSERT_TRUE(legacy.initialize(legacy_path.string()));
+  ASSERT_TRUE(legacy.save_compact(compact_path.string()));
+
+  RecVocabDict compact;
+  ASSERT_TRUE(compact.initialize(compact_path.string()));
+
+  for (const RecVocabDict* vocab_dict : {&legacy, &compact}) {
+    EXPECT_EQ(items_by_tokens(*vocab_dict, RecTokenTriple{1, 2, 3}),
+              std::vector<int64_t>({100, 105}));
+    EXPECT_EQ(items_by_tokens(*vocab_dict, RecTokenTriple{7, 8, 10}),
+              std::vector<int64_t>({101}));
+    EXPECT_TRUE(items_by_tokens(*vocab_dict, RecTokenTriple{1, 2, 5}).empty());
+    EXPECT_EQ(tokens_by_item(*vocab_dict, 101),
+              std::vector<int32_t>({7, 8, 10}));
+    EXPECT_EQ(tokens_by_item(*vocab_dict, 102),
+              std::vector<int32_t>({7, 8, 9}));
+    EXPECT_TRUE(tokens_by_item(*vocab_dict, 999).empty());
+
+    std::vector<int32_t> prefix{7, 8};
+    EXPECT_EQ(vocab_dict->get_next_tokens_by_prefix_tokens(
+                  Slice<int32_t>(prefix)),
+              std::vector<int32_t>({9, 10}));
+  }
+
+  const RecConstraintTables legacy_tables =
+      legacy.build_constraint_tables(/*vocab_size=*/16);
+  const RecConstraintTables compact_tables =
+      compact.build_constraint_tables(/*vocab_size=*/16);
+  EXPECT_EQ(legacy_tables.prefix1_offsets, compact_tables.prefix1_offsets);
+  EXPECT_EQ(legacy_tables.prefix1_pair_keys, compact_tables.prefix1_pair_keys);
+  EXPECT_EQ(legacy_tables.prefix2_values, compact_tables.prefix2_values);
+
+  std::filesystem::remove(legacy_path);
+  std::filesystem::remove(compact_path);
+}
+
+TEST(RecVocabDictTest, CompactSnapshotOutlivesInPlaceRewrite) {
+  const std::filesystem::path dir(::testing::TempDir());
+  const std::filesystem::path legacy_path = dir / "rec_vocab_rewrite.bin";
+  const std::filesystem::path compact_path = dir / "rec_vocab_rewrite.xrvd";
+  write_vocab_file(legacy_path, {{100, RecTokenTriple{1, 2, 3}}});
+  RecVocabDict legacy;
+  ASSERT_TRUE(legacy.initialize(legacy_path.string()));
+  ASSERT_TRUE(legacy.save_compact(compact_path.string()));
+
+  RecVocabDict compact;
+  ASSERT_TRUE(compact.initialize(compact_path.string()));
+  // a writer truncating the live file must not break the loaded catalog.
+  std::filesystem::resize_file(compact_path, 0);
+  EXPECT_EQ(items_by_tokens(compact, RecTokenTriple{1, 2, 3}),
+            std::vector<int64_t>({100}));
+  EXPECT_EQ(tokens_by_item(compact, 100), std::vector<int32_t>({1, 2, 3}));
+
+  std::filesystem::remove(legacy_path);
+  std::filesystem::remove(compact_path);
+}
+
+TEST(RecVocabDictTest, ReloadKeepsPinnedSnapshotsValid) {
+  const std::filesystem::path vocab_path =
+      std::filesystem::path(::testing::TempDir()) / "rec_vocab_reload.bin";
+  write_vocab_file(vocab_path, {{100, RecTokenTriple{1, 2, 3}}});
+
+  RecVocabDict vocab_dict;
+  ASSERT_TRUE(vocab_dict.initialize(vocab_path.string()));
+  std::shared_ptr<const RecVocabSnapshot> pinned = vocab_dict.snapshot();
+  const uint64_t old_version = vocab_dict.version();
+
+  write_vocab_file(vocab_path,
+                   {{200, RecTokenTriple{4, 5, 6}},
+                    {201, RecTokenTriple{4, 5, 7}}});
+  ASSERT_TRUE(vocab_dict.reload(vocab_path.string()));
+  EXPECT_GT(vocab_dict.version(), old_version);
+
+  // in-flight readers still see the catalog they started with.
+  std::vector<int64_t> pinned_items;
+  EXPECT_TRUE(pinned->get_items_by_tokens(RecTokenTriple{1, 2, 3},
+                                          &pinned_items));
+  EXPECT_EQ(pinned_items, std::vector<int64_t>({100}));
+  EXPECT_EQ(pinned->version(), old_version);
+
+  EXPECT_TRUE(items_by_tokens(vocab_dict, RecTokenTriple{1, 2, 3}).empty());
+  EXPECT_EQ(items_by_tokens(vocab_dict, RecTokenTriple{4, 5, 7}),
+            std::vector<int64_t>({201}));
+
+  // a broken file leaves the active version in place.
+  {
+    std::ofstream ofs(vocab_path, std::ios::binary | std::ios::trunc);
+    ofs << "XRVD";
+  }
+  const uint64_t active_version = vocab_dict.version();
+  EXPECT_FALSE(vocab_dict.reload(vocab_path.string()));
+  EXPECT_EQ(vocab_dict.version(), active_version);
+  EXPECT_EQ(tokens_by_item(vocab_dict, 200), std::vector<int32_t>({4, 5, 6}));
+
+  std::filesystem::remove(vocab_path);
+}
+
+TEST(RecVocabDictTest, RequestPinsSurviveReloadUntilReleased) {
+  const std::filesystem::path vocab_path =
+      std::filesystem::path(::testing::TempDir()) / "rec_vocab_pins.bin";
+  write_vocab_file(vocab_path, {{100, RecTokenTriple{1, 2, 3}}});
+
+  RecVocabDict vocab_dict;
+  ASSERT_TRUE(vocab_dict.initialize(vocab_path.string()));
+  const std::shared_ptr<const RecVocabSnapshot> old_snapshot =
+      vocab_dict.snapshot();
+  EXPECT_EQ(vocab_dict.pin("req-1", old_snapshot), old_snapshot);
+  EXPECT_EQ(vocab_dict.pinned_snapshot("req-2"), nullptr);
+
+  write_vocab_file(vocab_path, {{200, RecTokenTriple{1, 2, 3}}});
+  ASSERT_TRUE(vocab_dict.reload(vocab_path.string()));
+
+  // the first pin of a request wins.
+  EXPECT_EQ(vocab_dict.pin("req-1", vocab_dict.snapshot()), old_snapshot);
+  std::vector<int64_t> item_ids;
+  ASSERT_TRUE(vocab_dict.pinned_snapshot("req-1")->get_items_by_tokens(
+      RecTokenTriple{1, 2, 3}, &item_ids));
+  EXPECT_EQ(item_ids, std::vector<int64_t>({100}));
+
+  // an empty id is shared by unrelated requests and never pinned.
+  EXPECT_EQ(vocab_dict.pin("", old_snapshot), old_snapshot);
+  EXPECT_EQ(vocab_dict.pinned_snapshot(""), nullptr);
+
+  vocab_dict.release({"req-1"});
+  EXPECT_EQ(vocab_dict.pinned_snapshot("req-1"), nullptr);
+
+  std::filesystem::remove(vocab_path);
+}
+
+TEST(RecVocabDictTest, SnapshotKeepsExtendedItemInfo) {
+  std::vector<RecVocabRecord> records(2);
+  records[0].item_id = 10;
+  records[0].tokens = {3, 1, 2};
+  records[0].did = "did-10";
+  records[0].type = "video";
+  records[1].item_id = 11;
+  records[1].tokens = {3, 1, 2};
+  records[1].did = "did-11";
+
+  std::shared_ptr<RecVocabSnapshot> built =
+      RecVocabSnapshot::build(records, /*has_item_strings=*/true);
+  const std::filesystem::path vocab_path =
+      std::filesystem::path(::testing::TempDir()) / "rec_vocab_extended.bin";
+  ASSERT_TRUE(built->save(vocab_path.string()));
+  std::shared_ptr<RecVocabSnapshot> loaded = RecVocabSnapshot::load(
+      vocab_path.string(), /*extended_item_info=*/false);
+  ASSERT_NE(loaded, nullptr);
+  ASSERT_TRUE(loaded->has_item_strings());
+
+  std::vector<RecItemInfo> item_infos;
+  ASSERT_TRUE(loaded->get_item_infos_by_tokens(RecTokenTriple{3, 1, 2},
+                                               &item_infos));
+  ASSERT_EQ(item_infos.size(), 2);
+  EXPECT_EQ(item_infos[0].item_id, 10);
+  EXPECT_EQ(item_infos[0].did, "did-10");
+  EXPECT_EQ(item_infos[0].type, "video");
+  EXPECT_EQ(item_infos[1].did, "did-11");
+  EXPECT_TRUE(item_infos[1].type.empty());
+
+  std::filesystem::remove(vocab_path);
+}
+
 }  // namespace xllm
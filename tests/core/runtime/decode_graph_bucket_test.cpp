@@ -0,0 +1,130 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "core/runtime/decode_graph_bucket.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace xllm::runtime {
+namespace {
+
+// Exhaustive search over every subset of the sizes in (1, max_bucket) that
+// are not fixed, for small cross-checks of the dynamic program.
+int64_t brute_force_padding(const std::vector<int64_t>& counts,
+                            const std::vector<int64_t>& fixed_buckets,
+                            int32_t max_new_buckets) {
+  std::vector<int64_t> free_sizes;
+  for (int64_t n = 1; n < fixed_buckets.back(); ++n) {
+    if (std::find(fixed_buckets.begin(), fixed_buckets.end(), n) ==
+        fixed_buckets.end()) {
+      free_sizes.push_back(n);
+    }
+  }
+  int64_t best = get_decode_graph_padding(counts, fixed_buckets);
+  for (uint32_t mask = 1; mask < (1u << free_sizes.size()); ++mask) {
+    if (__builtin_popcount(mask) > max_new_buckets) {
+      continue;
+    }
+    std::vector<int64_t> buckets = fixed_buckets;
+    for (size_t i = 0; i < free_sizes.size(); ++i) {
+      if (mask & (1u << i)) {
+        buckets.push_back(free_sizes[i]);
+      }
+    }
+    std::sort(buckets.begin(), buckets.end());
+    best = std::min(best, get_decode_graph_padding(counts, buckets));
+  }
+  return best;
+}
+
+TEST(DecodeGraphBucketTest, DefaultSchedule) {
+  EXPECT_EQ(get_default_decode_graph_token_bucket(1), 1);
+  EXPECT_EQ(get_default_decode_graph_token_bucket(3), 4);
+  EXPECT_EQ(get_default_decode_graph_token_bucket(9), 16);
+  EXPECT_EQ(get_default_decode_graph_token_bucket(17), 32);
+  EXPECT_EQ(get_default_decode_graph_token_buckets(40),
+            (std::vector<int64_t>{1, 2, 4, 8, 16, 32, 48}));
+  EXPECT_EQ(get_decode_graph_token_bucket(17, /*enable_no_padding=*/true), 17);
+}
+
+TEST(DecodeGraphBucketTest, PaddingOfHistogram) {
+  std::vector<int64_t> counts(41, 0);
+  counts[3] = 2;   // 1 row each in bucket 4
+  counts[20] = 1;  // 12 rows in bucket 32
+  counts[40] = 5;  // above the largest bucket, ignored
+  EXPECT_EQ(get_decode_graph_padding(counts, {1, 2, 4, 8, 16, 32}), 14);
+}
+
+TEST(DecodeGraphBucketTest, AddsBucketsAtObservedPeaks) {
+  const std::vector<int64_t> fixed = get_default_decode_graph_token_buckets(64);
+  std::vector<int64_t> counts(65, 0);
+  counts[20] = 100;
+  counts[37] = 50;
+  counts[5] = 1;
+
+  const std::vector<int64_t> buckets =
+      solve_decode_graph_token_buckets(counts, fixed, /*max_new_buckets=*/2);
+  EXPECT_EQ(buckets,
+            (std::vector<int64_t>{1, 2, 4, 8, 16, 20, 32, 37, 48, 64}));
+  EXPECT_EQ(get_decode_graph_padding(counts, buckets), 3);
+
+  EXPECT_EQ(
+      solve_decode_graph_token_buckets(counts, fixed, /*max_new_buckets=*/0),
+      fixed);
+  const std::vector<int64_t> one =
+      solve_decode_graph_token_buckets(counts, fixed, /*max_new_buckets=*/1);
+  EXPECT_EQ(one.size(), fixed.size() + 1);
+  EXPECT_TRUE(std::find(one.begin(), one.end(), 20) != one.end());
+}
+
+TEST(DecodeGraphBucketTest, MatchesBruteForce) {
+  const std::vector<int64_t> fixed = {1, 2, 4, 8, 16};
+  uint64_t state = 12345;
+  for (int32_t round = 0; round < 50; ++round) {
+    std::vector<int64_t> counts(17, 0);
+    for (int64_t n = 1; n <= 16; ++n) {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      counts[n] = (state >> 33) % 4 == 0 ? 0 : (state >> 40) % 100;
+    }
+    for (int32_t max_new = 0; max_new <= 3; ++max_new) {
+      const std::vector<int64_t> buckets =
+          solve_decode_graph_token_buckets(counts, fixed, max_new);
+      EXPECT_LE(buckets.size(), fixed.size() + max_new);
+      EXPECT_EQ(get_decode_graph_padding(counts, buckets),
+                brute_force_padding(counts, fixed, max_new));
+    }
+  }
+}
+
+TEST(DecodeGraphBucketTest, InstallsAdaptiveBuckets) {
+  set_adaptive_decode_graph_token_buckets({1, 2, 4, 8, 12, 16, 20, 32});
+  EXPECT_EQ(get_decode_graph_token_bucket(9, /*enable_no_padding=*/false), 12);
+  EXPECT_EQ(get_decode_graph_token_bucket(17, /*enable_no_padding=*/false),
+            20);
+  EXPECT_EQ(get_decode_graph_token_bucket(40, /*enable_no_padding=*/false),
+            48);
+  EXPECT_EQ(get_decode_graph_token_bucket(9, /*enable_no_padding=*/true), 9);
+
+  set_adaptive_decode_graph_token_buckets({});
+  EXPECT_EQ(get_adaptive_decode_graph_token_buckets(), nullptr);
+  EXPECT_EQ(get_decode_graph_token_bucket(9, /*enable_no_padding=*/false), 16);
+}
+
+}  // namespace
+}  // namespace xllm::runtime
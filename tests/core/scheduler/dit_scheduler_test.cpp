@@ -0,0 +1,238 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "dit_scheduler.h"
+
+#include <gtest/gtest.h>
+#include <torch/torch.h>
+
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "api_service/call.h"
+#include "framework/batch/dit_batch.h"
+#include "framework/request/dit_request.h"
+
+namespace xllm {
+namespace {
+
+class FakeCall final : public Call {
+ public:
+  bool is_disconnected() const override { return disconnected; }
+
+  bool disconnected = false;
+};
+
+std::shared_ptr<DiTRequest> make_request(const std::string& request_id,
+                                         int32_t num_inference_steps,
+                                         int64_t seed,
+                                         Call* call = nullptr) {
+  DiTInputParams input_params;
+  input_params.prompt = "a photo of a cat";
+  DiTGenerationParams generation_params;
+  generation_params.width = 64;
+  generation_params.height = 64;
+  generation_params.num_inference_steps = num_inference_steps;
+  generation_params.seed = seed;
+  generation_params.seed_is_set = true;
+  std::optional<Call*> request_call;
+  if (call != nullptr) {
+    request_call = call;
+  }
+  DiTRequestState state(
+      input_params,
+      generation_params,
+      [](const DiTRequestOutput& output) { return true; },
+      DiTOutputsFunc(),
+      DiTRequestKind::kImage,
+      request_call);
+  return std::make_shared<DiTRequest>(request_id, "", "", state);
+}
+
+// Keeps a step counter per request the way the pipeline keeps its denoising
+// state, and returns one output per request past its last step.
+class FakeStepWorker {
+ public:
+  DiTForwardOutput step(const DiTForwardInput& input) {
+    for (const auto& request_id : input.released_request_ids) {
+      states_.erase(request_id);
+    }
+    for (const auto& request_id : input.joining_request_ids) {
+      EXPECT_EQ(states_.count(request_id), 0u) << request_id;
+      states_[request_id] = 0;
+    }
+    for (const auto& request_id : input.running_request_ids) {
+      EXPECT_EQ(states_.count(request_id), 1u) << request_id;
+    }
+    std::vector<std::string> request_ids = input.joining_request_ids;
+    request_ids.insert(request_ids.end(),
+                       input.running_request_ids.begin(),
+                       input.running_request_ids.end());
+    DiTForwardOutput output;
+    for (const auto& request_id : request_ids) {
+      if (++states_[request_id] ==
+          input.generation_params.num_inference_steps) {
+        output.tensors.emplace_back(torch::zeros({3, 8, 8}));
+        states_.erase(request_id);
+      }
+    }
+    return output;
+  }
+
+  size_t num_states() const { return states_.size(); }
+
+ private:
+  std::unordered_map<std::string, int32_t> states_;
+};
+
+// Drives prepare_dit_step_batch, the batch and the fake worker the way
+// DiTStepBatchScheduler drives the engine.
+class DiTStepBatchTest : public ::testing::Test {
+ protected:
+  // runs one denoising step and returns the ids of the finished requests.
+  std::vector<std::string> step(DiTForwardInput* step_input = nullptr) {
+    DiTBatch batch = prepare_dit_step_batch(
+        max_requests_,
+        [this](std::shared_ptr<DiTRequest>& request) {
+          if (queue_.empty()) {
+            return false;
+          }
+          request = queue_.front();
+          queue_.pop_front();
+          return true;
+        },
+        waiting_,
+        running_);
+    std::vector<std::string> finished_ids;
+    if (batch.empty()) {
+      return finished_ids;
+    }
+    const DiTForwardInput input = batch.prepare_forward_input();
+    batch.process_forward_output(worker_.step(input));
+    for (const auto& request : retire_finished_dit_step_requests(running_)) {
+      finished_ids.emplace_back(request->request_id());
+    }
+    if (step_input != nullptr) {
+      *step_input = input;
+    }
+    return finished_ids;
+  }
+
+  size_t max_requests_ = 4;
+  std::deque<std::shared_ptr<DiTRequest>> queue_;
+  std::deque<std::shared_ptr<DiTRequest>> waiting_;
+  std::vector<std::shared_ptr<DiTRequest>> running_;
+  FakeStepWorker worker_;
+};
+
+TEST_F(DiTStepBatchTest, RequestsJoinAtStepBoundaries) {
+  queue_.emplace_back(make_request("a", /*num_inference_steps=*/3, 1));
+  DiTForwardInput input;
+  EXPECT_TRUE(step(&input).empty());
+  EXPECT_EQ(input.joining_request_ids, std::vector<std::string>{"a"});
+  EXPECT_TRUE(input.running_request_ids.empty());
+
+  // b joins the running batch with its own seed.
+  queue_.emplace_back(make_request("b", /*num_inference_steps=*/3, 2));
+  EXPECT_TRUE(step(&input).empty());
+  EXPECT_EQ(input.joining_request_ids, std::vector<std::string>{"b"});
+  EXPECT_EQ(input.joining_seeds, std::vector<int64_t>{2});
+  EXPECT_EQ(input.running_request_ids, std::vector<std::string>{"a"});
+  EXPECT_EQ(input.batch_size, 2);
+  EXPECT_EQ(running_.size(), 2u);
+}
+
+TEST_F(DiTStepBatchTest, FinishedRequestsLeaveRightAway) {
+  queue_.emplace_back(make_request("a", /*num_inference_steps=*/2, 1));
+  EXPECT_TRUE(step().empty());
+  queue_.emplace_back(make_request("b", /*num_inference_steps=*/2, 2));
+  EXPECT_EQ(step(), std::vector<std::string>{"a"});
+  ASSERT_EQ(running_.size(), 1u);
+  EXPECT_EQ(running_[0]->request_id(), "b");
+  EXPECT_EQ(step(), std::vector<std::string>{"b"});
+  EXPECT_TRUE(running_.empty());
+  EXPECT_EQ(worker_.num_states(), 0u);
+}
+
+TEST_F(DiTStepBatchTest, IncompatibleRequestWaitsForTheBatchToDrain) {
+  max_requests_ = 2;
+  queue_.emplace_back(make_request("a", /*num_inference_steps=*/2, 1));
+  // a different step count does not fit the running batch.
+  queue_.emplace_back(make_request("b", /*num_inference_steps=*/3, 1));
+  queue_.emplace_back(make_request("c", /*num_inference_steps=*/2, 1));
+  DiTForwardInput input;
+  EXPECT_TRUE(step(&input).empty());
+  EXPECT_EQ(input.joining_request_ids, std::vector<std::string>{"a"});
+  ASSERT_EQ(waiting_.size(), 1u);
+  EXPECT_EQ(waiting_.front()->request_id(), "b");
+
+  // c arrived after b and waits behind it.
+  EXPECT_EQ(step(&input), std::vector<std::string>{"a"});
+  EXPECT_TRUE(input.joining_request_ids.empty());
+  EXPECT_EQ(step(&input).size(), 0u);
+  EXPECT_EQ(input.joining_request_ids, std::vector<std::string>{"b"});
+  EXPECT_TRUE(queue_.empty());
+  ASSERT_EQ(waiting_.size(), 1u);
+  EXPECT_EQ(waiting_.front()->request_id(), "c");
+}
+
+TEST_F(DiTStepBatchTest, DisconnectedRequestsReleaseTheirState) {
+  FakeCall call;
+  queue_.emplace_back(make_request("a", /*num_inference_steps=*/4, 1, &call));
+  queue_.emplace_back(make_request("b", /*num_inference_steps=*/4, 2));
+  EXPECT_TRUE(step().empty());
+  EXPECT_EQ(worker_.num_states(), 2u);
+
+  call.disconnected = true;
+  DiTForwardInput input;
+  EXPECT_TRUE(step(&input).empty());
+  EXPECT_EQ(input.released_request_ids, std::vector<std::string>{"a"});
+  EXPECT_EQ(input.running_request_ids, std::vector<std::string>{"b"});
+  ASSERT_EQ(running_.size(), 1u);
+  EXPECT_EQ(worker_.num_states(), 1u);
+
+  EXPECT_TRUE(step().empty());
+  EXPECT_EQ(step(), std::vector<std::string>{"b"});
+  EXPECT_EQ(worker_.num_states(), 0u);
+}
+
+TEST_F(DiTStepBatchTest, ReleaseRunsWhenTheBatchEmpties) {
+  FakeCall call;
+  queue_.emplace_back(make_request("a", /*num_inference_steps=*/4, 1, &call));
+  EXPECT_TRUE(step().empty());
+  call.disconnected = true;
+
+  // the batch carries only the release.
+  DiTBatch batch = prepare_dit_step_batch(
+      max_requests_,
+      [](std::shared_ptr<DiTRequest>& request) { return false; },
+      waiting_,
+      running_);
+  EXPECT_FALSE(batch.empty());
+  EXPECT_EQ(batch.size(), 0u);
+  const DiTForwardInput input = batch.prepare_forward_input();
+  EXPECT_TRUE(input.step_batching());
+  EXPECT_EQ(input.released_request_ids, std::vector<std::string>{"a"});
+  EXPECT_TRUE(worker_.step(input).tensors.empty());
+  EXPECT_TRUE(running_.empty());
+  EXPECT_EQ(worker_.num_states(), 0u);
+}
+
+}  // namespace
+}  // namespace xllm
@@ -0,0 +1,56 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "scheduler/offline_batch_order.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace xllm {
+
+TEST(OfflineBatchOrderTest, GroupsPromptsBySharedBlocks) {
+  // block size 2: prompts 0 and 2 share the block {1, 2}, prompts 1 and 3
+  // the block {5, 6}; their partial tail blocks are not compared.
+  const std::vector<std::vector<int32_t>> prompts = {
+      {1, 2, 9}, {5, 6, 3, 4}, {1, 2, 7}, {5, 6, 3, 4, 8}};
+  const std::vector<size_t> lengths = {10, 10, 10, 10};
+  EXPECT_EQ(prefix_sorted_order(prompts, lengths, /*block_size=*/2),
+            (std::vector<size_t>{0, 2, 1, 3}));
+}
+
+TEST(OfflineBatchOrderTest, ShorterBlockPrefixGoesFirst) {
+  const std::vector<std::vector<int32_t>> prompts = {
+      {1, 2, 3, 4}, {1, 2}, {1, 2, 3, 4, 5, 6}};
+  const std::vector<size_t> lengths = {10, 10, 10};
+  EXPECT_EQ(prefix_sorted_order(prompts, lengths, /*block_size=*/2),
+            (std::vector<size_t>{1, 0, 2}));
+}
+
+TEST(OfflineBatchOrderTest, LongerRequestsFirstWithinEqualBlocks) {
+  // none of the prompts fills a block of 4, so only the expected length and
+  // then the input order decide.
+  const std::vector<std::vector<int32_t>> prompts = {{1}, {2, 3}, {4}, {5}};
+  const std::vector<size_t> lengths = {8, 32, 8, 16};
+  EXPECT_EQ(prefix_sorted_order(prompts, lengths, /*block_size=*/4),
+            (std::vector<size_t>{1, 3, 0, 2}));
+}
+
+TEST(OfflineBatchOrderTest, EmptyBatch) {
+  EXPECT_TRUE(prefix_sorted_order({}, {}, /*block_size=*/16).empty());
+}
+
+}  // namespace xllm
@@ -0,0 +1,79 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "scheduler/profile/time_predictor.h"
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace xllm {
+namespace {
+
+// 2 + 0.01 * x + 1e-6 * x^2 + 2e-7 * x * prefix + 1e-4 * prefix, in ms.
+double prefill_time(int32_t length, int32_t prefix_length) {
+  const double x = length - prefix_length;
+  return 2.0 + 0.01 * x + 1e-6 * x * x + 2e-7 * x * prefix_length +
+         1e-4 * prefix_length;
+}
+
+}  // namespace
+
+TEST(TimePredictorTest, QuadraticRootWithoutPrefixProfile) {
+  TimePredictor predictor(/*if_profile_prefix=*/false, /*is_prefill=*/true);
+  std::vector<std::pair<int32_t, double>> samples;
+  for (int32_t length = 256; length <= 16384; length *= 2) {
+    samples.emplace_back(length, prefill_time(length, 0));
+  }
+  predictor.fit_for_prefill(samples);
+
+  // the largest chunk that fits in 40ms on top of the constant term.
+  const int32_t length = predictor.get_quadratic_root(0, 40.0);
+  EXPECT_NEAR(predictor.predict_time(length, 0, false), 40.0, 0.1);
+  EXPECT_LE(predictor.predict_time(length, 0, false), 40.0);
+  EXPECT_EQ(predictor.get_quadratic_root(0, 0.0), 0);
+}
+
+TEST(TimePredictorTest, QuadraticRootShrinksWithPrefix) {
+  TimePredictor predictor(/*if_profile_prefix=*/true, /*is_prefill=*/true);
+  std::vector<std::tuple<int32_t, int32_t, double>> samples;
+  for (int32_t prefix = 0; prefix <= 65536; prefix += 8192) {
+    for (int32_t chunk = 256; chunk <= 8192; chunk *= 2) {
+      samples.emplace_back(
+          prefix + chunk, prefix, prefill_time(prefix + chunk, prefix));
+    }
+  }
+  predictor.fit_for_prefill(samples);
+
+  const int32_t short_prefix = 1024;
+  const int32_t long_prefix = 65536;
+  const int32_t short_chunk =
+      predictor.get_quadratic_root(short_prefix, 40.0) - short_prefix;
+  const int32_t long_chunk =
+      predictor.get_quadratic_root(long_prefix, 40.0) - long_prefix;
+  EXPECT_GT(short_chunk, long_chunk);
+  EXPECT_GT(long_chunk, 0);
+  EXPECT_NEAR(predictor.predict_time(
+                  long_prefix + long_chunk, long_prefix, false),
+              40.0,
+              0.1);
+
+  // a budget below the prefix term leaves no room for new tokens.
+  EXPECT_EQ(predictor.get_quadratic_root(long_prefix, 1.0), long_prefix);
+}
+
+}  // namespace xllm
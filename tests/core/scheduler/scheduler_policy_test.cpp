@@ -24,9 +24,12 @@ limitations under the License.
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
+#include "async_response_processor.h"
 #include "continuous_scheduler.h"
+#include "core/framework/config/profile_config.h"
 #include "core/framework/config/scheduler_config.h"
 #include "distributed_runtime/engine.h"
 #include "framework/block/block_manager_pool.h"
@@ -185,6 +188,40 @@ class PendingReleaseBlockManagerPool final : public BlockManagerPool {
   int32_t allocate_calls_ = 0;
 };
 
+class SwapPreemptionBlockManagerPool final : public BlockManagerPool {
+ public:
+  SwapPreemptionBlockManagerPool()
+      : BlockManagerPool(make_options(), /*dp_size=*/1) {}
+
+  bool supports_swap_preemption() const override { return true; }
+
+  void preempt(Sequence* /*sequence*/, bool swap_out) override {
+    preempt_swap_outs_.emplace_back(swap_out);
+  }
+
+  using BlockManagerPool::deallocate;
+  void deallocate(Request* /*request*/) override { ++deallocate_calls_; }
+
+  const std::vector<bool>& preempt_swap_outs() const {
+    return preempt_swap_outs_;
+  }
+
+  int32_t deallocate_calls() const { return deallocate_calls_; }
+
+ private:
+  static BlockManagerPool::Options make_options() {
+    BlockManagerPool::Options options;
+    options.num_blocks_ = 16;
+    options.block_size_ = 128;
+    options.max_seqs_per_batch_ = 16;
+    options.enable_prefix_cache_ = true;
+    return options;
+  }
+
+  std::vector<bool> preempt_swap_outs_;
+  int32_t deallocate_calls_ = 0;
+};
+
 class TestUnifiedPolicy final : public UnifiedPolicy {
  public:
   using UnifiedPolicy::UnifiedPolicy;
@@ -193,6 +230,15 @@ class TestUnifiedPolicy final : public UnifiedPolicy {
                                        SchedulerState& state) {
     allocate_shared_blocks_for(sequence, state);
   }
+
+  bool should_swap_out_for_test(Sequence* sequence,
+                                const SchedulerState& state) const {
+    return should_swap_out(sequence, state);
+  }
+
+  void preempt_request_for_test(Request* request, SchedulerState& state) {
+    preempt_request(request, state);
+  }
 };
 
 template <typename T>
@@ -296,6 +342,113 @@ std::vector<std::shared_ptr<Request>> generate_request(
   return requests;
 }
 
+// Requests of 300 prompt tokens with the given time to first token SLOs, 0
+// for none, all from `tenant`.
+std::vector<std::shared_ptr<Request>> generate_slo_requests(
+    const std::vector<int32_t>& ttft_slo_ms,
+    const std::string& tenant = "") {
+  std::vector<std::shared_ptr<Request>> requests =
+      generate_request(std::vector<int32_t>(ttft_slo_ms.size(), 300),
+                       std::vector<int32_t>(ttft_slo_ms.size(), 1),
+                       std::nullopt,
+                       std::nullopt,
+                       /*max_context_len=*/40000);
+  for (size_t i = 0; i < requests.size(); ++i) {
+    SchedulerParam& scheduler_param = requests[i]->state().scheduler_param;
+    if (ttft_slo_ms[i] > 0) {
+      scheduler_param.ttft_slo_ms = ttft_slo_ms[i];
+    }
+    scheduler_param.tenant = tenant;
+    requests[i]->state().output_func = [](const RequestOutput&) {
+      return true;
+    };
+  }
+  return requests;
+}
+
+// SLO admission on arrival against a prefill profile of 1 ms per token, in
+// batches of up to 1024 tokens.
+class SloAdmissionTest : public ::testing::Test {
+ protected:
+  SloAdmissionTest()
+      : enable_slo_admission_(
+            SchedulerConfig::get_instance().enable_slo_admission(),
+            true),
+        profile_engine_(std::make_unique<FakeEngine>(512, 128)),
+        profile_manager_(profile_engine_.get(), make_profile_options()),
+        response_processor_(&tokenizer_,
+                            /*role=*/std::nullopt,
+                            /*enable_service_routing=*/false,
+                            /*disable_log_stats=*/true,
+                            [](std::shared_ptr<Request>) {}) {
+    profile_manager_.train_prefill_time_predictor(
+        std::vector<std::pair<int32_t, double>>{
+            {128, 128.0}, {256, 256.0}, {512, 512.0}, {1024, 1024.0}});
+  }
+
+  // Drains `requests` through `policy` and returns whether each of them
+  // reached `prefill_queue`.
+  std::vector<bool> drain(SchedulerPolicy& policy,
+                          RequestPriorityQueue& prefill_queue,
+                          const std::vector<std::shared_ptr<Request>>& requests,
+                          const ContinuousScheduler::Options& options) {
+    DequeQueue chunk_queue;
+    DequeQueue decode_queue;
+    std::list<std::shared_ptr<Request>> unified_queue;
+    std::vector<std::shared_ptr<Request>> running_requests;
+    std::vector<Sequence*> running_sequences;
+    std::vector<size_t> running_sequence_budgets;
+    bool last_step_prefill = false;
+    SchedulerState state{
+        .prefill_queue = prefill_queue,
+        .chunk_queue = chunk_queue,
+        .decode_queue = decode_queue,
+        .unified_queue = unified_queue,
+        .running_requests = running_requests,
+        .running_sequences = running_sequences,
+        .running_sequences_budgets = running_sequence_budgets,
+        .kv_cache_manager = nullptr,
+        .profile_manager = &profile_manager_,
+        .response_processor = &response_processor_,
+        .last_step_prefill = last_step_prefill,
+        .options = options,
+        .min_speculative_tokens_required = 0,
+        .enable_prefix_cache = true,
+        .has_linear_attention_layers = false,
+    };
+    folly::MPMCQueue<std::shared_ptr<Request>> request_queue(requests.size());
+    for (const auto& request : requests) {
+      EXPECT_TRUE(request_queue.write(request));
+    }
+    policy.drain_request_queue(state, request_queue);
+
+    std::vector<bool> admitted;
+    for (const auto& request : requests) {
+      bool queued = false;
+      for (auto it = prefill_queue.begin(); it != prefill_queue.end(); ++it) {
+        queued = queued || *it == request;
+      }
+      admitted.emplace_back(queued);
+    }
+    return admitted;
+  }
+
+ private:
+  static ProfileManager::Options make_profile_options() {
+    ProfileManager::Options options;
+    options.max_tokens_per_batch(1024)
+        .max_seqs_per_batch(16)
+        .enable_profile_kv_blocks(false);
+    return options;
+  }
+
+  ScopedConfigValue<bool> enable_slo_admission_;
+  FakeTokenizer tokenizer_;
+  std::unique_ptr<FakeEngine> profile_engine_;
+  ProfileManager profile_manager_;
+  AsyncResponseProcessor response_processor_;
+};
+
 // dont not consider speculative decoding.
 void update_requests(std::vector<std::shared_ptr<Request>> requests) {
   for (auto req : requests) {
@@ -585,6 +738,202 @@ TEST(SchedulerPolicyTest, DefersWhileAsyncBlockReleaseIsPending) {
   EXPECT_TRUE(finished.empty());
 }
 
+TEST(SchedulerPolicyTest, SwapPreemptionComparesCopyAndRecomputeCost) {
+  ContinuousScheduler::Options options = create_scheduler_options(
+      /*max_tokens_per_batch=*/16384,
+      /*max_seqs_per_batch=*/16,
+      /*num_speculative_tokens=*/0,
+      /*max_tokens_per_chunk_for_prefill=*/16384,
+      /*dp_size=*/1,
+      /*priority_strategy=*/"multi_slo_and_prio");
+  BatchMode mode{
+      .enable_mix_batch = true,
+      .enable_chunked_prefill = true,
+      .priority_strategy = "multi_slo_and_prio",
+  };
+  SwapPreemptionBlockManagerPool block_manager_pool;
+  auto profile_engine = std::make_unique<FakeEngine>(512, 128);
+  ProfileManager::Options profile_options;
+  profile_options.max_tokens_per_batch(16384)
+      .max_seqs_per_batch(16)
+      .enable_profile_kv_blocks(false);
+  ProfileManager profile_manager(profile_engine.get(), profile_options);
+
+  std::vector<std::shared_ptr<Request>> requests = generate_request(
+      {1024}, {1}, std::nullopt, std::nullopt, /*max_context_len=*/40000);
+  Request* request = requests.front().get();
+  Sequence* sequence = request->sequences().front().get();
+
+  DequeQueue prefill_queue;
+  DequeQueue chunk_queue;
+  DequeQueue decode_queue;
+  std::list<std::shared_ptr<Request>> unified_queue;
+  std::vector<std::shared_ptr<Request>> running_requests;
+  std::vector<Sequence*> running_sequences;
+  std::vector<size_t> running_sequence_budgets;
+  bool last_step_prefill = false;
+  SchedulerState state{
+      .prefill_queue = prefill_queue,
+      .chunk_queue = chunk_queue,
+      .decode_queue = decode_queue,
+      .unified_queue = unified_queue,
+      .running_requests = running_requests,
+      .running_sequences = running_sequences,
+      .running_sequences_budgets = running_sequence_budgets,
+      .kv_cache_manager = &block_manager_pool,
+      .profile_manager = nullptr,
+      .response_processor = nullptr,
+      .last_step_prefill = last_step_prefill,
+      .options = options,
+      .min_speculative_tokens_required = 0,
+      .enable_prefix_cache = true,
+      .has_linear_attention_layers = false,
+  };
+
+  // with the flag off the request is released as before, without preempt().
+  TestUnifiedPolicy recompute_policy(mode, options);
+  sequence->kv_state().set_kv_cache_tokens_num(512);
+  EXPECT_FALSE(recompute_policy.should_swap_out_for_test(sequence, state));
+  recompute_policy.preempt_request_for_test(request, state);
+  EXPECT_EQ(block_manager_pool.deallocate_calls(), 1);
+  EXPECT_TRUE(block_manager_pool.preempt_swap_outs().empty());
+
+  options.enable_swap_preemption(true);
+  TestUnifiedPolicy policy(mode, options);
+
+  // less than a full block has nothing to save.
+  sequence->kv_state().set_kv_cache_tokens_num(127);
+  EXPECT_FALSE(policy.should_swap_out_for_test(sequence, state));
+
+  // without a fitted prefill profile swapping is assumed cheaper.
+  sequence->kv_state().set_kv_cache_tokens_num(512);
+  EXPECT_TRUE(policy.should_swap_out_for_test(sequence, state));
+  state.profile_manager = &profile_manager;
+  ASSERT_FALSE(profile_manager.has_prefill_profile());
+  EXPECT_TRUE(policy.should_swap_out_for_test(sequence, state));
+
+  // a slow prefill makes the PCIe round trip the cheaper option.
+  profile_manager.train_prefill_time_predictor(
+      std::vector<std::pair<int32_t, double>>{
+          {128, 1280.0}, {256, 2560.0}, {512, 5120.0}, {1024, 10240.0}});
+  EXPECT_TRUE(policy.should_swap_out_for_test(sequence, state));
+  policy.preempt_request_for_test(request, state);
+  EXPECT_EQ(block_manager_pool.preempt_swap_outs(), std::vector<bool>{true});
+
+  // a fast prefill is cheaper to redo than to copy out and back.
+  profile_manager.train_prefill_time_predictor(
+      std::vector<std::pair<int32_t, double>>{
+          {128, 0.0001}, {256, 0.0002}, {512, 0.0004}, {1024, 0.0008}});
+  EXPECT_FALSE(policy.should_swap_out_for_test(sequence, state));
+  policy.preempt_request_for_test(request, state);
+  EXPECT_EQ(block_manager_pool.preempt_swap_outs(),
+            (std::vector<bool>{true, false}));
+  EXPECT_EQ(block_manager_pool.deallocate_calls(), 1);
+}
+
+TEST_F(SloAdmissionTest, RejectsRequestsThatMissTheirTtft) {
+  const ContinuousScheduler::Options options = create_scheduler_options(
+      /*max_tokens_per_batch=*/1024,
+      /*max_seqs_per_batch=*/16,
+      /*num_speculative_tokens=*/0,
+      /*max_tokens_per_chunk_for_prefill=*/1024,
+      /*dp_size=*/1);
+  PrefillFirstPolicy policy(BatchMode{}, options);
+  DequeQueue prefill_queue;
+
+  // 300 and 600 ms of prefill meet 700 ms.
+  EXPECT_EQ(
+      drain(policy, prefill_queue, generate_slo_requests({700, 700}), options),
+      (std::vector<bool>{true, true}));
+
+  // 900 ms misses 700 ms and is not counted for the later requests; the
+  // request without an SLO is admitted and counted, so 1200 ms meets
+  // 1250 ms and 1500 ms misses 1450 ms.
+  EXPECT_EQ(drain(policy,
+                  prefill_queue,
+                  generate_slo_requests({700, 0, 1250, 1450}),
+                  options),
+            (std::vector<bool>{false, true, true, false}));
+  EXPECT_EQ(prefill_queue.size(), 4u);
+}
+
+TEST_F(SloAdmissionTest, AdmitsEverythingWhenDisabled) {
+  ScopedConfigValue<bool> enable_slo_admission(
+      SchedulerConfig::get_instance().enable_slo_admission(), false);
+  const ContinuousScheduler::Options options = create_scheduler_options(
+      /*max_tokens_per_batch=*/1024,
+      /*max_seqs_per_batch=*/16,
+      /*num_speculative_tokens=*/0,
+      /*max_tokens_per_chunk_for_prefill=*/1024,
+      /*dp_size=*/1);
+  PrefillFirstPolicy policy(BatchMode{}, options);
+  DequeQueue prefill_queue;
+  EXPECT_EQ(
+      drain(policy, prefill_queue, generate_slo_requests({1, 1}), options),
+      (std::vector<bool>{true, true}));
+}
+
+TEST_F(SloAdmissionTest, FairShareCountsOnlyEarlierStartTimes) {
+  const ContinuousScheduler::Options options = create_scheduler_options(
+      /*max_tokens_per_batch=*/1024,
+      /*max_seqs_per_batch=*/16,
+      /*num_speculative_tokens=*/0,
+      /*max_tokens_per_chunk_for_prefill=*/1024,
+      /*dp_size=*/1,
+      /*priority_strategy=*/"fair");
+  PrefillFirstPolicy policy(BatchMode{.priority_strategy = "fair"}, options);
+  SetQueue prefill_queue(create_comparator("fair", /*is_reversed=*/true));
+
+  // tenant "a" queues requests starting at virtual times 0 and 300.
+  EXPECT_EQ(drain(policy,
+                  prefill_queue,
+                  generate_slo_requests({0, 0}, /*tenant=*/"a"),
+                  options),
+            (std::vector<bool>{true, true}));
+
+  // the first request of "b" starts at 0, behind only 300 tokens of "a",
+  // so 600 ms meets 650 ms.
+  const std::vector<std::shared_ptr<Request>> first_b =
+      generate_slo_requests({650}, "b");
+  // the next request of "a" starts at 600, behind everything: 1200 ms.
+  const std::vector<std::shared_ptr<Request>> third_a =
+      generate_slo_requests({1100}, "a");
+  // the next request of "b" starts at 300, behind both queued requests of
+  // "a" and the first of "b" but not the rejected one: 1200 ms.
+  const std::vector<std::shared_ptr<Request>> second_b =
+      generate_slo_requests({1250}, "b");
+  EXPECT_EQ(drain(policy,
+                  prefill_queue,
+                  {first_b[0], third_a[0], second_b[0]},
+                  options),
+            (std::vector<bool>{true, false, true}));
+}
+
+TEST(RequestPriorityQueueTest, SetQueuePushOrdersByComparator) {
+  SetQueue queue(create_comparator("fair", /*is_reversed=*/true));
+  std::vector<std::shared_ptr<Request>> requests = generate_request(
+      {10, 10, 10}, {1, 1, 1}, std::nullopt, std::nullopt, 1000);
+  requests[0]->set_fair_share_tag(2.0);
+  requests[1]->set_fair_share_tag(1.0);
+  requests[2]->set_fair_share_tag(3.0);
+
+  // neither end is honoured; the comparator places every request.
+  queue.push(requests[0], /*if_back=*/false);
+  queue.push(requests[1], /*if_back=*/true);
+  queue.push(requests[2], /*if_back=*/false);
+  ASSERT_EQ(queue.size(), 3u);
+  EXPECT_EQ(queue.top(), requests[1]);
+  EXPECT_EQ(queue.back(), requests[2]);
+  queue.pop_top();
+  EXPECT_EQ(queue.top(), requests[0]);
+
+  // a request pushed back to the front, e.g. a requeued chunk, returns to
+  // its place.
+  queue.push(requests[1], /*if_back=*/false);
+  EXPECT_EQ(queue.top(), requests[1]);
+  EXPECT_EQ(queue.size(), 3u);
+}
+
 // TEST-2:
 // memory or budget not enough
 TEST(SchedulerPolicyTest, ResourceNotEnough) {
@@ -907,6 +1256,66 @@ TEST(SchedulerPolicyTest, LatencySchedule) {
   EXPECT_EQ(running_sequences_budgets[3], max_tokens_per_chunk_for_prefill);
 }
 
+// Adaptive prefill chunks without latency aware scheduling: every chunk sized
+// from the step-time model must count against the step budget, so later
+// prefills in the same pass get smaller chunks.
+TEST(SchedulerPolicyTest, AdaptiveChunksShareStepLatency) {
+  ScopedConfigValue<bool> adaptive_chunk_guard(
+      ProfileConfig::get_instance().enable_adaptive_prefill_chunk(), true);
+  ScopedConfigValue<bool> mix_batch_guard(
+      SchedulerConfig::get_instance().enable_mix_batch(), true);
+  const int32_t block_num = 100;
+  const int32_t block_size = 4;
+  ContinuousScheduler::Options opt =
+      create_scheduler_options(/*max_tokens_per_batch=*/10000,
+                               /*max_seqs_per_batch=*/256,
+                               /*num_speculative_tokens=*/0,
+                               /*max_tokens_per_chunk_for_prefill=*/64,
+                               /*dp_size=*/1,
+                               "fcfs",
+                               /*enable_profile_kv_blocks=*/false,
+                               /*enable_latency_aware_schedule=*/false,
+                               /*max_global_ttft_ms=*/350,
+                               /*max_global_tpot_ms=*/150);
+  auto engine = std::make_unique<FakeEngine>(block_num, block_size);
+  auto scheduler = std::make_unique<ContinuousScheduler>(engine.get(), opt);
+  ASSERT_NE(scheduler.get(), nullptr);
+
+  // y=0.5x^2+10x, so 10 new tokens take the whole 150ms step.
+  std::vector<std::pair<int32_t, double>> created_profile_data = {
+      {2, 22}, {4, 48}, {6, 78}, {8, 112}};
+  scheduler->get_profile_manager()->train_prefill_time_predictor(
+      created_profile_data);
+
+  // 1. a short request prefills alone and then decodes, which bounds the
+  // step by the TPOT target.
+  auto decode_requests =
+      generate_request({4}, {10}, std::nullopt, std::nullopt, 30000);
+  scheduler->add_request(decode_requests[0]);
+  auto batch = scheduler->prepare_batch_test();
+  ASSERT_EQ(batch.size(), 1);
+  update_requests(scheduler->get_running_requests());
+
+  // 2. two long prompts arrive in the same pass.
+  auto prefill_requests =
+      generate_request({64, 64}, {10, 10}, std::nullopt, std::nullopt, 30000);
+  for (auto& request : prefill_requests) {
+    scheduler->add_request(request);
+  }
+  batch = scheduler->prepare_batch_test();
+  ASSERT_EQ(batch.size(), 1);
+  EXPECT_EQ(batch[0].size(), 3);
+  const auto budgets = scheduler->get_running_sequences_budgets();
+  ASSERT_EQ(budgets.size(), 3u);
+  EXPECT_EQ(budgets[0], 1u);
+  // the first chunk fits 10 tokens, rounded down to whole blocks: 8 tokens
+  // predicted at 112ms.
+  EXPECT_EQ(budgets[1], 8u);
+  // the remaining 38ms fit 3 tokens, less than a block: one block is kept
+  // so that the prompt still makes progress.
+  EXPECT_EQ(budgets[2], 4u);
+}
+
 // TEST: Full-footprint admission gate
 // When chunked prefill is enabled, a new request whose full footprint exceeds
 // the available blocks (total - used) should NOT be admitted.
@@ -0,0 +1,68 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "scheduler/tenant_fair_share.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+
+namespace xllm {
+
+TEST(TenantFairShareTest, ParsesWeights) {
+  TenantFairShare fair_share("a:4,b:0.5");
+  EXPECT_DOUBLE_EQ(fair_share.weight("a"), 4.0);
+  EXPECT_DOUBLE_EQ(fair_share.weight("b"), 0.5);
+  EXPECT_DOUBLE_EQ(fair_share.weight("c"), 1.0);
+  EXPECT_DOUBLE_EQ(fair_share.weight(""), 1.0);
+}
+
+TEST(TenantFairShareTest, BackloggedTenantsShareByWeight) {
+  TenantFairShare fair_share("a:3");
+  // both tenants submit a burst of equal requests at once; serving them in
+  // start time order must give "a" three requests for every one of "b".
+  std::multimap<double, std::string> queue;
+  for (int i = 0; i < 30; ++i) {
+    queue.emplace(fair_share.assign("a", 100), "a");
+    queue.emplace(fair_share.assign("b", 100), "b");
+  }
+  std::map<std::string, int> served;
+  auto it = queue.begin();
+  for (int i = 0; i < 20; ++i, ++it) {
+    ++served[it->second];
+  }
+  EXPECT_EQ(served["a"], 15);
+  EXPECT_EQ(served["b"], 5);
+}
+
+TEST(TenantFairShareTest, IdleTenantDoesNotBankCredit) {
+  TenantFairShare fair_share("");
+  for (int i = 0; i < 10; ++i) {
+    fair_share.assign("a", 100);
+  }
+  // "a" has been served up to its last start time while "b" was idle.
+  fair_share.advance(/*head_tag=*/900, /*queue_empty=*/false);
+  EXPECT_DOUBLE_EQ(fair_share.start_time("b"), 900);
+  EXPECT_DOUBLE_EQ(fair_share.assign("b", 100), 900);
+  EXPECT_DOUBLE_EQ(fair_share.start_time("a"), 1000);
+
+  // with nothing queued every tenant starts after all handed out work.
+  fair_share.advance(/*head_tag=*/0, /*queue_empty=*/true);
+  EXPECT_DOUBLE_EQ(fair_share.virtual_time(), 1000);
+  EXPECT_DOUBLE_EQ(fair_share.start_time("c"), 1000);
+}
+
+}  // namespace xllm
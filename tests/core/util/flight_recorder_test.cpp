@@ -0,0 +1,141 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "core/util/flight_recorder.h"
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace xllm {
+namespace {
+
+nlohmann::json dump_events() {
+  const nlohmann::json trace =
+      nlohmann::json::parse(FlightRecorder::get_instance().dump_chrome_trace());
+  return trace.at("traceEvents");
+}
+
+TEST(FlightRecorderTest, DisabledRecorderRecordsNothing) {
+  FlightRecorder& recorder = FlightRecorder::get_instance();
+  recorder.initialize(/*enabled=*/false, /*capacity=*/16);
+  {
+    FlightRecorderSpan span("step");
+    EXPECT_FALSE(span.active());
+  }
+  recorder.record_request_event("request.arrive", "req-0");
+  EXPECT_TRUE(dump_events().empty());
+}
+
+TEST(FlightRecorderTest, DumpsSpansAndRequestEventsAsChromeTrace) {
+  FlightRecorder& recorder = FlightRecorder::get_instance();
+  recorder.initialize(/*enabled=*/true, /*capacity=*/16);
+  recorder.record_request_event(
+      "request.arrive", "req-\"1\"", {{"prompt_tokens", 12}});
+  {
+    FlightRecorderSpan span("scheduler.step");
+    span.set_arg("num_sequences", 3);
+  }
+
+  const nlohmann::json events = dump_events();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].at("name"), "request.arrive");
+  EXPECT_EQ(events[0].at("ph"), "i");
+  EXPECT_EQ(events[0].at("args").at("request_id"), "req-\"1\"");
+  EXPECT_EQ(events[0].at("args").at("prompt_tokens"), 12);
+  EXPECT_EQ(events[1].at("name"), "scheduler.step");
+  EXPECT_EQ(events[1].at("ph"), "X");
+  EXPECT_GE(events[1].at("dur").get<int64_t>(), 0);
+  EXPECT_EQ(events[1].at("args").at("num_sequences"), 3);
+  EXPECT_LE(events[0].at("ts").get<int64_t>(),
+            events[1].at("ts").get<int64_t>());
+}
+
+TEST(FlightRecorderTest, RingKeepsMostRecentEvents) {
+  FlightRecorder& recorder = FlightRecorder::get_instance();
+  recorder.initialize(/*enabled=*/true, /*capacity=*/5);
+  EXPECT_EQ(recorder.capacity(), 8u);
+  for (int64_t i = 0; i < 20; ++i) {
+    recorder.record_span("step", i, i + 1, {{"index", i}});
+  }
+
+  const nlohmann::json events = dump_events();
+  ASSERT_EQ(events.size(), 8u);
+  for (size_t i = 0; i < events.size(); ++i) {
+    EXPECT_EQ(events[i].at("args").at("index"), static_cast<int64_t>(12 + i));
+  }
+}
+
+TEST(FlightRecorderTest, ConcurrentWritersAndDumps) {
+  FlightRecorder& recorder = FlightRecorder::get_instance();
+  recorder.initialize(/*enabled=*/true, /*capacity=*/64);
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; ++t) {
+    writers.emplace_back([&recorder, t]() {
+      for (int64_t i = 0; i < 2000; ++i) {
+        recorder.record_span("step", i, i + t, {{"writer", t}, {"index", i}});
+      }
+    });
+  }
+  for (int i = 0; i < 20; ++i) {
+    for (const nlohmann::json& event : dump_events()) {
+      // a torn event would mix the duration of one writer with another.
+      EXPECT_EQ(event.at("dur"), event.at("args").at("writer"));
+    }
+  }
+  for (std::thread& writer : writers) {
+    writer.join();
+  }
+  EXPECT_EQ(dump_events().size(), 64u);
+}
+
+TEST(FlightRecorderTest, LappingWritersNeverTearEvents) {
+  FlightRecorder& recorder = FlightRecorder::get_instance();
+  // every writer laps every other one on the single slot.
+  recorder.initialize(/*enabled=*/true, /*capacity=*/1);
+  std::vector<std::thread> writers;
+  for (int64_t t = 1; t <= 8; ++t) {
+    writers.emplace_back([&recorder, t]() {
+      for (int64_t i = 0; i < 20000; ++i) {
+        recorder.record_span(
+            "step", 0, t, {{"a", t}, {"b", t}, {"c", t}, {"d", t}});
+      }
+    });
+  }
+  const auto expect_untorn = [](const nlohmann::json& events) {
+    for (const nlohmann::json& event : events) {
+      const nlohmann::json& args = event.at("args");
+      ASSERT_EQ(args.size(), 4u);
+      for (const char* name : {"a", "b", "c", "d"}) {
+        EXPECT_EQ(args.at(name), event.at("dur"));
+      }
+    }
+  };
+  for (int i = 0; i < 2000; ++i) {
+    expect_untorn(dump_events());
+  }
+  for (std::thread& writer : writers) {
+    writer.join();
+  }
+  const nlohmann::json events = dump_events();
+  EXPECT_EQ(events.size(), 1u);
+  expect_untorn(events);
+}
+
+}  // namespace
+}  // namespace xllm
@@ -0,0 +1,78 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "util/mpsc_batch_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace xllm {
+
+TEST(MpscBatchQueueTest, TakeAllKeepsPushOrder) {
+  MpscBatchQueue<std::unique_ptr<int>> queue;
+  EXPECT_TRUE(queue.empty());
+  for (int i = 0; i < 5; ++i) {
+    queue.push(std::make_unique<int>(i));
+  }
+  EXPECT_FALSE(queue.empty());
+
+  std::vector<std::unique_ptr<int>> values = queue.take_all();
+  ASSERT_EQ(values.size(), 5u);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(*values[i], i);
+  }
+  EXPECT_TRUE(queue.empty());
+  EXPECT_TRUE(queue.take_all().empty());
+}
+
+TEST(MpscBatchQueueTest, ConcurrentProducers) {
+  constexpr int kNumProducers = 8;
+  constexpr int kNumPushes = 10000;
+  MpscBatchQueue<int> queue;
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kNumProducers; ++p) {
+    producers.emplace_back([&queue, p] {
+      for (int i = 0; i < kNumPushes; ++i) {
+        queue.push(p * kNumPushes + i);
+      }
+    });
+  }
+
+  // drain while producing; every producer's items stay in order.
+  std::vector<int> last(kNumProducers, -1);
+  int64_t num_taken = 0;
+  auto drain = [&] {
+    for (int value : queue.take_all()) {
+      const int p = value / kNumPushes;
+      EXPECT_GT(value, last[p]);
+      last[p] = value;
+      ++num_taken;
+    }
+  };
+  while (num_taken < kNumProducers * kNumPushes) {
+    drain();
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  drain();
+  EXPECT_EQ(num_taken, kNumProducers * kNumPushes);
+}
+
+}  // namespace xllm
@@ -0,0 +1,133 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "ngram_index.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace xllm {
+
+TEST(NGramIndexTest, ProposeContinuationOfEarlierOccurrence) {
+  NGramIndex index(/*min_ngram=*/1, /*max_ngram=*/3);
+  std::vector<int32_t> prompt = {1, 2, 3, 4, 5, 6, 7, 2, 3};
+  index.append(std::span<const int32_t>(prompt));
+
+  int32_t match_len = 0;
+  std::vector<int32_t> draft = index.propose(/*max_tokens=*/3, &match_len);
+  EXPECT_EQ(match_len, 2);
+  EXPECT_EQ(draft, (std::vector<int32_t>{4, 5, 6}));
+}
+
+TEST(NGramIndexTest, PreferLongestAndMostRecentMatch) {
+  NGramIndex index(/*min_ngram=*/1, /*max_ngram=*/3);
+  // "9 3" continues with 10 while a bare "3" most recently continues with 20.
+  std::vector<int32_t> prompt = {9, 3, 10, 11, 3, 20, 9, 3};
+  index.append(std::span<const int32_t>(prompt));
+
+  int32_t match_len = 0;
+  std::vector<int32_t> draft = index.propose(/*max_tokens=*/2, &match_len);
+  EXPECT_EQ(match_len, 2);
+  EXPECT_EQ(draft, (std::vector<int32_t>{10, 11}));
+
+  // after appending 7, only the unigram "7" is unseen, so nothing matches.
+  std::vector<int32_t> out = {7};
+  index.append(std::span<const int32_t>(out));
+  EXPECT_TRUE(index.propose(/*max_tokens=*/2, &match_len).empty());
+  EXPECT_EQ(match_len, 0);
+}
+
+TEST(NGramIndexTest, IncrementalAppendMatchesBulkAppend) {
+  std::vector<int32_t> tokens = {5, 6, 7, 8, 5, 6, 7, 1, 5, 6};
+  NGramIndex bulk(/*min_ngram=*/2, /*max_ngram=*/4);
+  bulk.append(std::span<const int32_t>(tokens));
+
+  NGramIndex incremental(/*min_ngram=*/2, /*max_ngram=*/4);
+  for (const int32_t token : tokens) {
+    incremental.append(std::span<const int32_t>(&token, 1));
+  }
+
+  EXPECT_EQ(bulk.propose(/*max_tokens=*/4), incremental.propose(4));
+  // most recent "5 6" (at position 4) continues with 7, 1, 5, 6.
+  EXPECT_EQ(incremental.propose(/*max_tokens=*/4),
+            (std::vector<int32_t>{7, 1, 5, 6}));
+}
+
+TEST(NGramIndexTest, ProposalIsTruncatedAtStreamEnd) {
+  NGramIndex index(/*min_ngram=*/1, /*max_ngram=*/2);
+  std::vector<int32_t> tokens = {4, 4, 4};
+  index.append(std::span<const int32_t>(tokens));
+
+  // "4 4" last continued at position 2, leaving a single token to copy.
+  EXPECT_EQ(index.propose(/*max_tokens=*/5), (std::vector<int32_t>{4}));
+  EXPECT_TRUE(index.propose(/*max_tokens=*/0).empty());
+}
+
+TEST(NGramRequestIndicesTest, MapsRowsThatEndTheirPrefill) {
+  // a middle prefill chunk between two rows that end theirs.
+  EXPECT_EQ(map_request_rows({"a", "b"}, {-1, 7, -1}, /*num_rows=*/3),
+            (std::vector<int32_t>{0, -1, 1}));
+  EXPECT_EQ(map_request_rows({"a", "b"}, {}, /*num_rows=*/2),
+            (std::vector<int32_t>{0, 1}));
+  EXPECT_TRUE(map_request_rows({"a"}, {-1, -1}, /*num_rows=*/2).empty());
+  EXPECT_TRUE(map_request_rows({"a"}, {}, /*num_rows=*/2).empty());
+}
+
+TEST(NGramRequestIndicesTest, ChunkedPrefillSurvivesDecodeOnlyStep) {
+  NGramRequestIndices indices(/*min_ngram=*/1, /*max_ngram=*/3);
+  const std::vector<int32_t> b_prompt = {1, 2, 3, 1, 2};
+  indices.rebuild("b", {}, b_prompt);
+
+  // step 1: the first chunk of "a" carries no request id.
+  const std::vector<int32_t> chunk_1 = {7, 8, 9, 10, 11};
+  EXPECT_EQ(map_request_rows({}, {chunk_1.back()}, /*num_rows=*/1),
+            (std::vector<int32_t>{-1}));
+
+  // step 2: a decode-only step for "b"; nothing is released.
+  EXPECT_EQ(map_request_rows({"b"}, {-1}, /*num_rows=*/1),
+            (std::vector<int32_t>{0}));
+  const int32_t b_token = 3;
+  indices.get_or_create("b").append(std::span<const int32_t>(&b_token, 1));
+  indices.release({});
+
+  // step 3: the last chunk of "a" arrives with the first as its history,
+  // while "b" sits the step out.
+  const std::vector<int32_t> chunk_2 = {12, 7, 8};
+  const NGramIndex& a = indices.rebuild("a", chunk_1, chunk_2);
+  EXPECT_EQ(a.num_tokens(), chunk_1.size() + chunk_2.size());
+  // "7 8" continues from the first chunk.
+  EXPECT_EQ(a.propose(/*max_tokens=*/2), (std::vector<int32_t>{9, 10}));
+
+  const NGramIndex* b = indices.find("b");
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(b->num_tokens(), b_prompt.size() + 1);
+  EXPECT_EQ(b->propose(/*max_tokens=*/2), (std::vector<int32_t>{1, 2}));
+
+  // a preempted request is rebuilt from its full history, not appended to.
+  const std::vector<int32_t> b_history = {1, 2, 3, 1};
+  const std::vector<int32_t> b_input = {2, 3};
+  indices.rebuild("b", b_history, b_input);
+  EXPECT_EQ(indices.find("b")->num_tokens(), 6u);
+
+  // only an explicit release drops an index.
+  indices.release({"a"});
+  EXPECT_EQ(indices.find("a"), nullptr);
+  EXPECT_NE(indices.find("b"), nullptr);
+  EXPECT_EQ(indices.size(), 1u);
+}
+
+}  // namespace xllm
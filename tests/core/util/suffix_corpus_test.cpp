@@ -0,0 +1,150 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "suffix_corpus.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "suffix_decoding_cache.h"
+
+namespace xllm {
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+}  // namespace
+
+TEST(SuffixCorpusTest, BinaryRoundTrip) {
+  const std::string path = temp_path("suffix_corpus_round_trip.bin");
+  SuffixCorpus corpus = {{1, 2, 3}, {}, {7, 8, 9, 10}};
+  ASSERT_TRUE(save_suffix_corpus(path, corpus));
+
+  auto loaded = load_suffix_corpus(path);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(*loaded, corpus);
+  std::remove(path.c_str());
+}
+
+TEST(SuffixCorpusTest, LoadTextCorpus) {
+  const std::string path = temp_path("suffix_corpus_text.txt");
+  {
+    std::ofstream out(path);
+    out << "1 2 3\n\n40 50\t60\n";
+  }
+  auto loaded = load_suffix_corpus(path);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(*loaded, (SuffixCorpus{{1, 2, 3}, {40, 50, 60}}));
+
+  {
+    std::ofstream out(path);
+    out << "1 2 x\n";
+  }
+  EXPECT_FALSE(load_suffix_corpus(path).has_value());
+  std::remove(path.c_str());
+}
+
+TEST(SuffixCorpusTest, MissingOrTruncatedFile) {
+  EXPECT_FALSE(load_suffix_corpus(temp_path("suffix_corpus_missing.bin"))
+                   .has_value());
+
+  const std::string path = temp_path("suffix_corpus_truncated.bin");
+  ASSERT_TRUE(save_suffix_corpus(path, {{1, 2, 3, 4}}));
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+  EXPECT_FALSE(load_suffix_corpus(path).has_value());
+  std::remove(path.c_str());
+}
+
+TEST(SuffixCorpusTest, RejectsCountsLargerThanFile) {
+  const std::string path = temp_path("suffix_corpus_bad_counts.bin");
+  const char magic[4] = {'X', 'S', 'F', 'X'};
+  const uint32_t version = 1;
+  {
+    // a sequence count no file could hold.
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const uint64_t num_sequences = uint64_t{1} << 60;
+    out.write(magic, sizeof(magic));
+    out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    out.write(reinterpret_cast<const char*>(&num_sequences),
+              sizeof(num_sequences));
+  }
+  EXPECT_FALSE(load_suffix_corpus(path).has_value());
+
+  {
+    // one sequence whose token count runs past the end of the file.
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const uint64_t num_sequences = 1;
+    const uint32_t num_tokens = 0xffffffffu;
+    const int32_t token = 7;
+    out.write(magic, sizeof(magic));
+    out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    out.write(reinterpret_cast<const char*>(&num_sequences),
+              sizeof(num_sequences));
+    out.write(reinterpret_cast<const char*>(&num_tokens), sizeof(num_tokens));
+    out.write(reinterpret_cast<const char*>(&token), sizeof(token));
+  }
+  EXPECT_FALSE(load_suffix_corpus(path).has_value());
+  std::remove(path.c_str());
+}
+
+TEST(SuffixCorpusTest, WarmStartGlobalTree) {
+  SuffixDecodingCache cache(/*max_tree_depth=*/32, /*max_cached_requests=*/8);
+  std::vector<int32_t> prompt = {10, 20, 30};
+  std::vector<int32_t> response = {40, 50, 60};
+  cache.start_request("req_a", std::span<const int32_t>(prompt));
+  cache.add_active_response("req_a", std::span<const int32_t>(response));
+  cache.stop_request("req_a");
+
+  SuffixCorpus corpus = cache.export_cached_responses();
+  ASSERT_EQ(corpus, (SuffixCorpus{response}));
+
+  // a fresh cache seeded from the corpus speculates like the original one.
+  SuffixDecodingCache restored(/*max_tree_depth=*/32,
+                               /*max_cached_requests=*/8);
+  for (const auto& tokens : corpus) {
+    restored.add_cached_response(std::span<const int32_t>(tokens));
+  }
+  std::vector<int32_t> p1 = {1, 2};
+  restored.start_request("req_b", std::span<const int32_t>(p1));
+  std::vector<int32_t> ctx = {1, 40};
+  auto draft = restored.speculate("req_b",
+                                  std::span<const int32_t>(ctx),
+                                  /*max_spec_tokens=*/2,
+                                  /*max_spec_factor=*/2.0f,
+                                  /*max_spec_offset=*/1.0f,
+                                  /*min_token_prob=*/0.01f,
+                                  /*use_tree_spec=*/false);
+  EXPECT_EQ(draft.token_ids, (std::vector<int32_t>{50, 60}));
+}
+
+TEST(SuffixCorpusTest, CachedResponsesRespectCapacity) {
+  SuffixDecodingCache cache(/*max_tree_depth=*/16, /*max_cached_requests=*/2);
+  for (int32_t i = 0; i < 4; ++i) {
+    std::vector<int32_t> tokens = {i, i + 1};
+    cache.add_cached_response(std::span<const int32_t>(tokens));
+  }
+  EXPECT_EQ(cache.export_cached_responses(), (SuffixCorpus{{2, 3}, {3, 4}}));
+}
+
+}  // namespace xllm
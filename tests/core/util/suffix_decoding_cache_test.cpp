@@ -18,6 +18,8 @@ limitations under the License.
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace xllm {
@@ -140,4 +142,88 @@ TEST(SuffixDecodingCacheTest, MaxCachedRequestsZeroDisablesGlobalCache) {
   EXPECT_TRUE(cached.empty());
 }
 
+TEST(SuffixDecodingCacheTest, GlobalResponsesAppliedOnFlush) {
+  SuffixDecodingCache cache(/*max_tree_depth=*/32, /*max_cached_requests=*/8);
+
+  std::vector<int32_t> p0 = {10, 20, 30};
+  cache.start_request("req_a", std::span<const int32_t>(p0));
+  std::vector<int32_t> out0 = {40, 50, 60};
+  cache.add_local_response("req_a", std::span<const int32_t>(out0));
+  cache.enqueue_global_response("req_a", std::span<const int32_t>(out0));
+  EXPECT_EQ(cache.num_pending_global_responses(), 1u);
+
+  std::vector<int32_t> p1 = {1, 2};
+  cache.start_request("req_b", std::span<const int32_t>(p1));
+  // starting a request flushes queued responses first.
+  EXPECT_EQ(cache.num_pending_global_responses(), 0u);
+
+  std::vector<int32_t> ctx = {20, 30, 40};
+  auto draft = cache.speculate("req_b",
+                               std::span<const int32_t>(ctx),
+                               /*max_spec_tokens=*/3,
+                               /*max_spec_factor=*/2.0f,
+                               /*max_spec_offset=*/0.0f,
+                               /*min_token_prob=*/0.01f,
+                               /*use_tree_spec=*/false);
+  ASSERT_FALSE(draft.token_ids.empty());
+  EXPECT_EQ(draft.token_ids[0], 50);
+
+  // responses queued for a request that was evicted meanwhile are dropped.
+  cache.enqueue_global_response("req_b", std::span<const int32_t>(out0));
+  cache.evict_cached_response("req_b");
+  cache.flush_global_responses();
+  EXPECT_EQ(cache.num_pending_global_responses(), 0u);
+  EXPECT_FALSE(cache.has_cached_request("req_b"));
+}
+
+TEST(SuffixDecodingCacheTest, ConcurrentSpeculateMatchesSerial) {
+  constexpr int32_t kNumRequests = 32;
+  SuffixDecodingCache cache(/*max_tree_depth=*/32, /*max_cached_requests=*/-1);
+
+  std::vector<std::string> req_ids;
+  std::vector<std::vector<int32_t>> contexts;
+  for (int32_t r = 0; r < kNumRequests; ++r) {
+    req_ids.emplace_back("req_" + std::to_string(r));
+    std::vector<int32_t> prompt;
+    for (int32_t i = 0; i < 64; ++i) {
+      prompt.emplace_back((r * 7 + i * 3) % 50);
+    }
+    cache.start_request(req_ids.back(), std::span<const int32_t>(prompt));
+    cache.add_active_response(req_ids.back(),
+                              std::span<const int32_t>(prompt.data(), 16));
+    contexts.emplace_back(prompt.end() - 8, prompt.end());
+  }
+
+  auto speculate = [&](int32_t r) {
+    return cache
+        .speculate(req_ids[r],
+                   std::span<const int32_t>(contexts[r]),
+                   /*max_spec_tokens=*/8,
+                   /*max_spec_factor=*/2.0f,
+                   /*max_spec_offset=*/0.0f,
+                   /*min_token_prob=*/0.01f,
+                   /*use_tree_spec=*/r % 2 == 0)
+        .token_ids;
+  };
+
+  std::vector<std::vector<int32_t>> serial(kNumRequests);
+  for (int32_t r = 0; r < kNumRequests; ++r) {
+    serial[r] = speculate(r);
+  }
+
+  std::vector<std::vector<int32_t>> parallel(kNumRequests);
+  std::vector<std::thread> threads;
+  for (int32_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int32_t r = t; r < kNumRequests; r += 4) {
+        parallel[r] = speculate(r);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(serial, parallel);
+}
+
 }  // namespace xllm
@@ -0,0 +1,61 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "util/work_signal.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace xllm {
+
+TEST(WorkSignalTest, NotifyBeforeWait) {
+  WorkSignal signal;
+  EXPECT_FALSE(signal.pending());
+  signal.notify();
+  signal.notify();
+  EXPECT_TRUE(signal.pending());
+  EXPECT_TRUE(signal.wait_for(std::chrono::seconds(10)));
+  EXPECT_FALSE(signal.pending());
+  EXPECT_FALSE(signal.wait_for(std::chrono::milliseconds(1)));
+}
+
+TEST(WorkSignalTest, WakesSleepingConsumer) {
+  WorkSignal signal;
+  std::atomic<int> produced{0};
+  std::thread producer([&] {
+    for (int i = 0; i < 1000; ++i) {
+      produced.fetch_add(1);
+      signal.notify();
+      if (i % 100 == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+  });
+
+  // every unit of work is observed without waiting for the long timeout.
+  const auto start = std::chrono::steady_clock::now();
+  int consumed = 0;
+  while (consumed < 1000) {
+    ASSERT_TRUE(signal.wait_for(std::chrono::seconds(10)));
+    consumed = produced.load();
+  }
+  producer.join();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+}  // namespace xllm
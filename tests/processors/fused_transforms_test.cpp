@@ -0,0 +1,247 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "processors/fused_transforms.h"
+
+#include <gtest/gtest.h>
+#include <torch/torch.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "processors/transforms.h"
+
+namespace xllm::transforms {
+namespace {
+
+constexpr int32_t kBilinear = 2;
+constexpr int32_t kBicubic = 3;
+
+// A smooth gradient with some pixel noise, kept away from 0 and 255 so that
+// neither path clips.
+torch::Tensor make_image(int64_t height, int64_t width) {
+  torch::manual_seed(0);
+  const torch::Tensor y = torch::arange(height, torch::kFloat32).view({-1, 1});
+  const torch::Tensor x = torch::arange(width, torch::kFloat32).view({1, -1});
+  std::vector<torch::Tensor> channels;
+  for (int64_t c = 0; c < 3; ++c) {
+    torch::Tensor plane = 128 + 60 * torch::sin(y * (0.05 + 0.02 * c)) +
+                          30 * torch::cos(x * (0.07 + 0.01 * c));
+    plane += torch::randint(-8, 9, {height, width}, torch::kFloat32);
+    channels.emplace_back(plane);
+  }
+  return torch::stack(channels).clamp(16, 239).to(torch::kUInt8);
+}
+
+torch::Tensor image_mean() {
+  return torch::tensor({122.77f, 116.75f, 104.09f});
+}
+
+torch::Tensor image_std() { return torch::tensor({68.50f, 66.63f, 70.32f}); }
+
+// The patch flattening of Qwen2VLImageProcessor, on a normalized (C, H, W)
+// float image.
+torch::Tensor patchify(const torch::Tensor& image, const PatchLayout& layout) {
+  const int64_t channels = image.size(0);
+  const int64_t patch = layout.patch_size;
+  const int64_t merge = layout.merge_size;
+  const int64_t temporal = layout.temporal_patch_size;
+  const int64_t grid_h = image.size(1) / patch;
+  const int64_t grid_w = image.size(2) / patch;
+  return image.unsqueeze(0)
+      .repeat({temporal, 1, 1, 1})
+      .view({temporal,
+             channels,
+             grid_h / merge,
+             merge,
+             patch,
+             grid_w / merge,
+             merge,
+             patch})
+      .permute({2, 5, 3, 6, 1, 0, 4, 7})
+      .reshape({grid_h * grid_w, channels * temporal * patch * patch});
+}
+
+// The float path of the processors: resize, normalize, then patchify.
+torch::Tensor torch_path(const torch::Tensor& image,
+                         int64_t height,
+                         int64_t width,
+                         int32_t resample,
+                         const PatchLayout& layout) {
+  torch::Tensor resized = resize(image.to(torch::kFloat32),
+                                 {height, width},
+                                 resample,
+                                 /*antialias=*/true);
+  return patchify(normalize(resized, image_mean(), image_std()), layout);
+}
+
+torch::Tensor fused_path(const torch::Tensor& image,
+                         int64_t height,
+                         int64_t width,
+                         int32_t resample) {
+  return resize_normalize_patchify(image,
+                                   height,
+                                   width,
+                                   resample,
+                                   image_mean(),
+                                   image_std(),
+                                   PatchLayout());
+}
+
+// PIL's ImagingResample on uint8: a full horizontal pass, then a vertical
+// pass over its rounded result, with 22-bit fixed point weights.
+torch::Tensor pil_resize(const torch::Tensor& image,
+                         int64_t height,
+                         int64_t width,
+                         int32_t resample) {
+  struct Taps {
+    int64_t first;
+    std::vector<int32_t> weights;
+  };
+  const auto filter = [resample](double x) {
+    x = std::abs(x);
+    if (resample == kBilinear) {
+      return x < 1.0 ? 1.0 - x : 0.0;
+    }
+    if (x < 1.0) {
+      return (1.5 * x - 2.5) * x * x + 1.0;
+    }
+    return x < 2.0 ? ((-0.5 * x + 2.5) * x - 4.0) * x + 2.0 : 0.0;
+  };
+  const auto make_taps = [&](int64_t in_size, int64_t out_size) {
+    const double scale = static_cast<double>(in_size) / out_size;
+    const double filter_scale = std::max(scale, 1.0);
+    const double support = (resample == kBicubic ? 2.0 : 1.0) * filter_scale;
+    std::vector<Taps> taps(out_size);
+    for (int64_t i = 0; i < out_size; ++i) {
+      const double center = (i + 0.5) * scale;
+      const int64_t lo = std::max<int64_t>(center - support + 0.5, 0);
+      const int64_t hi = std::min<int64_t>(center + support + 0.5, in_size);
+      std::vector<double> values;
+      double sum = 0.0;
+      for (int64_t j = lo; j < hi; ++j) {
+        values.emplace_back(filter((j - center + 0.5) / filter_scale));
+        sum += values.back();
+      }
+      taps[i].first = lo;
+      for (double value : values) {
+        taps[i].weights.emplace_back(
+            static_cast<int32_t>(std::lround(value / sum * (1 << 22))));
+      }
+    }
+    return taps;
+  };
+  const auto clip = [](int32_t value) {
+    return static_cast<uint8_t>(std::clamp(value >> 22, 0, 255));
+  };
+
+  const int64_t channels = image.size(0);
+  const int64_t in_height = image.size(1);
+  const int64_t in_width = image.size(2);
+  const std::vector<Taps> cols = make_taps(in_width, width);
+  const std::vector<Taps> rows = make_taps(in_height, height);
+  const torch::Tensor src = image.contiguous();
+  torch::Tensor horizontal =
+      torch::empty({channels, in_height, width}, torch::kUInt8);
+  torch::Tensor output = torch::empty({channels, height, width}, torch::kUInt8);
+  const uint8_t* in = src.data_ptr<uint8_t>();
+  uint8_t* mid = horizontal.data_ptr<uint8_t>();
+  uint8_t* out = output.data_ptr<uint8_t>();
+  for (int64_t c = 0; c < channels; ++c) {
+    for (int64_t y = 0; y < in_height; ++y) {
+      const uint8_t* row = in + (c * in_height + y) * in_width;
+      for (int64_t x = 0; x < width; ++x) {
+        int32_t sum = 1 << 21;
+        for (size_t j = 0; j < cols[x].weights.size(); ++j) {
+          sum += cols[x].weights[j] * row[cols[x].first + j];
+        }
+        mid[(c * in_height + y) * width + x] = clip(sum);
+      }
+    }
+    for (int64_t y = 0; y < height; ++y) {
+      for (int64_t x = 0; x < width; ++x) {
+        int32_t sum = 1 << 21;
+        for (size_t j = 0; j < rows[y].weights.size(); ++j) {
+          sum += rows[y].weights[j] *
+                 mid[(c * in_height + rows[y].first + j) * width + x];
+        }
+        out[(c * height + y) * width + x] = clip(sum);
+      }
+    }
+  }
+  return output;
+}
+
+float max_abs_diff(const torch::Tensor& a, const torch::Tensor& b) {
+  return (a - b).abs().max().item<float>();
+}
+
+TEST(FusedTransformsTest, SupportsOnlyUint8BilinearAndBicubic) {
+  const torch::Tensor image = make_image(28, 28);
+  EXPECT_TRUE(supports_fused_preprocess(image, kBilinear));
+  EXPECT_TRUE(supports_fused_preprocess(image, kBicubic));
+  EXPECT_FALSE(supports_fused_preprocess(image, /*resample=*/1));
+  EXPECT_FALSE(supports_fused_preprocess(image.to(torch::kFloat32), kBilinear));
+  EXPECT_FALSE(supports_fused_preprocess(image.unsqueeze(0), kBilinear));
+}
+
+TEST(FusedTransformsTest, MatchesPilUint8Resize) {
+  const PatchLayout layout;
+  const torch::Tensor image = make_image(97, 131);
+  for (int32_t resample : {kBilinear, kBicubic}) {
+    for (const auto& [height, width] :
+         std::vector<std::pair<int64_t, int64_t>>{{56, 84}, {140, 196}}) {
+      const torch::Tensor fused = fused_path(image, height, width, resample);
+      const torch::Tensor resized =
+          pil_resize(image, height, width, resample).to(torch::kFloat32);
+      const torch::Tensor expected =
+          patchify(normalize(resized, image_mean(), image_std()), layout);
+      EXPECT_LE(max_abs_diff(fused, expected), 1e-5f)
+          << "resample=" << resample << " size=" << height << "x" << width;
+    }
+  }
+}
+
+TEST(FusedTransformsTest, StaysCloseToTorchPath) {
+  const PatchLayout layout;
+  const float step = 1.0f / image_std().min().item<float>();
+  const torch::Tensor image = make_image(480, 640);
+  for (const auto& [height, width] :
+       std::vector<std::pair<int64_t, int64_t>>{{224, 308}, {504, 672}}) {
+    // bilinear weights are non-negative, so rounding the intermediate rows
+    // and the output costs at most one uint8 step between them.
+    EXPECT_LE(max_abs_diff(fused_path(image, height, width, kBilinear),
+                           torch_path(image, height, width, kBilinear, layout)),
+              1.001f * step);
+    // the negative bicubic lobes amplify the intermediate rounding a little.
+    EXPECT_LE(max_abs_diff(fused_path(image, height, width, kBicubic),
+                           torch_path(image, height, width, kBicubic, layout)),
+              1.5f * step);
+  }
+}
+
+TEST(FusedTransformsTest, SameSizeKeepsPixels) {
+  const torch::Tensor image = make_image(56, 84);
+  const torch::Tensor expected = patchify(
+      normalize(image.to(torch::kFloat32), image_mean(), image_std()),
+      PatchLayout());
+  EXPECT_LE(max_abs_diff(fused_path(image, 56, 84, kBicubic), expected), 1e-5f);
+}
+
+}  // namespace
+}  // namespace xllm::transforms
@@ -41,6 +41,7 @@ limitations under the License.
 #include "core/framework/config/distributed_config.h"
 #include "core/framework/config/profile_config.h"
 #include "core/util/closure_guard.h"
+#include "core/util/flight_recorder.h"
 #include "embedding.pb.h"
 #include "image_generation.pb.h"
 #include "models.pb.h"
@@ -1430,6 +1431,29 @@ void APIService::StopProfileHttp(::google::protobuf::RpcController* controller,
   // Success: return HTTP 200 with empty body
 }
 
+void APIService::FlightRecorderHttp(
+    ::google::protobuf::RpcController* controller,
+    const proto::HttpRequest* request,
+    proto::HttpResponse* response,
+    ::google::protobuf::Closure* done) {
+  brpc::ClosureGuard done_guard(done);
+  if (!request || !response || !controller) {
+    LOG(ERROR) << "brpc request | response | controller is null";
+    return;
+  }
+
+  auto ctrl = reinterpret_cast<brpc::Controller*>(controller);
+  const FlightRecorder& recorder = FlightRecorder::get_instance();
+  if (!recorder.enabled()) {
+    ctrl->SetFailed(
+        "Flight recorder is disabled. Start the server with "
+        "--enable_flight_recorder=true.");
+    return;
+  }
+  ctrl->http_response().set_content_type("application/json");
+  ctrl->response_attachment().append(recorder.dump_chrome_trace());
+}
+
 void APIService::LinkP2P(::google::protobuf::RpcController* controller,
                          const proto::P2PLinkRequest* request,
                          proto::Status* response,
@@ -200,6 +200,11 @@ class APIService : public proto::XllmAPIService {
                        proto::HttpResponse* response,
                        ::google::protobuf::Closure* done) override;
 
+  void FlightRecorderHttp(::google::protobuf::RpcController* controller,
+                          const proto::HttpRequest* request,
+                          proto::HttpResponse* response,
+                          ::google::protobuf::Closure* done) override;
+
   void LinkP2P(::google::protobuf::RpcController* controller,
                const proto::P2PLinkRequest* request,
                proto::Status* response,
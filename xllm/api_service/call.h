@@ -51,6 +51,9 @@ class Call {
   virtual bool is_disconnected() const = 0;
 
  protected:
+  // for in-process callers without an rpc controller, e.g. the C API.
+  Call() : controller_(nullptr) {}
+
   void init(std::string body_x_request_id, bool is_http_request);
 
  protected:
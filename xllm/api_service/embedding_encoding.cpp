@@ -0,0 +1,294 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "embedding_encoding.h"
+
+#include <glog/logging.h>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace xllm {
+namespace {
+
+// Independent accumulators per lane keep the reductions below free of
+// floating point reassociation, so the compiler vectorizes them as is.
+constexpr size_t kLanes = 8;
+
+float sum_squares(const float* values, size_t size) {
+  float acc[kLanes] = {};
+  size_t i = 0;
+  for (; i + kLanes <= size; i += kLanes) {
+    for (size_t j = 0; j < kLanes; ++j) {
+      acc[j] += values[i + j] * values[i + j];
+    }
+  }
+  for (; i < size; ++i) {
+    acc[0] += values[i] * values[i];
+  }
+  float sum = 0.0f;
+  for (float v : acc) {
+    sum += v;
+  }
+  return sum;
+}
+
+float max_abs(const float* values, size_t size) {
+  float acc[kLanes] = {};
+  size_t i = 0;
+  for (; i + kLanes <= size; i += kLanes) {
+    for (size_t j = 0; j < kLanes; ++j) {
+      const float v = std::fabs(values[i + j]);
+      acc[j] = acc[j] < v ? v : acc[j];
+    }
+  }
+  for (; i < size; ++i) {
+    acc[0] = std::max(acc[0], std::fabs(values[i]));
+  }
+  return *std::max_element(acc, acc + kLanes);
+}
+
+// IEEE binary16 with round to nearest even, as _mm256_cvtps_ph.
+uint16_t float_to_half(float value) {
+  uint32_t x;
+  std::memcpy(&x, &value, sizeof(x));
+  const uint16_t sign = static_cast<uint16_t>((x >> 16) & 0x8000);
+  x &= 0x7fffffff;
+  if (x > 0x7f800000) {
+    return sign | 0x7e00;
+  }
+  if (x >= 0x477ff000) {
+    // inf, or rounds up to it.
+    return sign | 0x7c00;
+  }
+  if (x < 0x38800000) {
+    // below the smallest normal half: scale to units of 2^-24.
+    float magnitude;
+    std::memcpy(&magnitude, &x, sizeof(magnitude));
+    return sign | static_cast<uint16_t>(std::nearbyint(magnitude * 0x1p24f));
+  }
+  // rebias the exponent (127 -> 15) and round the dropped 13 bits.
+  x += 0xc8000fff + ((x >> 13) & 1);
+  return sign | static_cast<uint16_t>(x >> 13);
+}
+
+float half_to_float(uint16_t half) {
+  const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+  const uint32_t exponent = (half >> 10) & 0x1f;
+  const uint32_t mantissa = half & 0x3ff;
+  if (exponent == 0) {
+    const float magnitude = static_cast<float>(mantissa) * 0x1p-24f;
+    return sign != 0 ? -magnitude : magnitude;
+  }
+  const uint32_t bits =
+      sign | (exponent == 0x1f ? 0x7f800000 : (exponent + 112) << 23) |
+      (mantissa << 13);
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+void pack_float16(const float* values, size_t size, char* out) {
+  size_t i = 0;
+#if defined(__F16C__)
+  for (; i + 8 <= size; i += 8) {
+    const __m128i halves =
+        _mm256_cvtps_ph(_mm256_loadu_ps(values + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2), halves);
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  for (; i + 4 <= size; i += 4) {
+    const float16x4_t halves = vcvt_f16_f32(vld1q_f32(values + i));
+    vst1_u16(reinterpret_cast<uint16_t*>(out + i * 2),
+             vreinterpret_u16_f16(halves));
+  }
+#endif
+  for (; i < size; ++i) {
+    const uint16_t half = float_to_half(values[i]);
+    std::memcpy(out + i * 2, &half, sizeof(half));
+  }
+}
+
+float pack_int8(const float* values, size_t size, char* out) {
+  const float scale = max_abs(values, size) / 127.0f;
+  const float inv_scale = scale > 0.0f ? 1.0f / scale : 0.0f;
+  int8_t* dst = reinterpret_cast<int8_t*>(out);
+  for (size_t i = 0; i < size; ++i) {
+    const float q = std::nearbyint(values[i] * inv_scale);
+    dst[i] = static_cast<int8_t>(std::clamp(q, -127.0f, 127.0f));
+  }
+  return scale > 0.0f ? scale : 1.0f;
+}
+
+void pack_binary(const float* values, size_t size, char* out) {
+  uint8_t* dst = reinterpret_cast<uint8_t*>(out);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint8_t byte = 0;
+    for (size_t j = 0; j < 8; ++j) {
+      byte |= static_cast<uint8_t>(values[i + j] > 0.0f) << (7 - j);
+    }
+    dst[i / 8] = byte;
+  }
+  if (i < size) {
+    uint8_t byte = 0;
+    for (size_t j = 0; i + j < size; ++j) {
+      byte |= static_cast<uint8_t>(values[i + j] > 0.0f) << (7 - j);
+    }
+    dst[i / 8] = byte;
+  }
+}
+
+}  // namespace
+
+std::optional<EmbeddingType> parse_embedding_type(const std::string& name) {
+  if (name.empty() || name == "float") {
+    return EmbeddingType::kFloat;
+  }
+  if (name == "float16") {
+    return EmbeddingType::kFloat16;
+  }
+  if (name == "int8") {
+    return EmbeddingType::kInt8;
+  }
+  if (name == "binary") {
+    return EmbeddingType::kBinary;
+  }
+  return std::nullopt;
+}
+
+size_t packed_embedding_size(EmbeddingType type, size_t dims) {
+  switch (type) {
+    case EmbeddingType::kFloat:
+      return dims * sizeof(float);
+    case EmbeddingType::kFloat16:
+      return dims * sizeof(uint16_t);
+    case EmbeddingType::kInt8:
+      return dims;
+    case EmbeddingType::kBinary:
+      return (dims + 7) / 8;
+  }
+  return 0;
+}
+
+float pack_embedding(const std::vector<float>& values,
+                     size_t dims,
+                     EmbeddingType type,
+                     std::string* out) {
+  CHECK_LE(dims, values.size()) << "Embedding has fewer than " << dims
+                                << " dimensions";
+  const float* src = values.data();
+  std::vector<float> truncated;
+  if (dims < values.size()) {
+    truncated.assign(values.begin(), values.begin() + dims);
+    const float norm = std::sqrt(sum_squares(truncated.data(), dims));
+    if (norm > 0.0f) {
+      const float inv_norm = 1.0f / norm;
+      for (float& v : truncated) {
+        v *= inv_norm;
+      }
+    }
+    src = truncated.data();
+  }
+
+  const size_t offset = out->size();
+  out->resize(offset + packed_embedding_size(type, dims));
+  char* dst = out->data() + offset;
+  switch (type) {
+    case EmbeddingType::kFloat:
+      std::memcpy(dst, src, dims * sizeof(float));
+      break;
+    case EmbeddingType::kFloat16:
+      pack_float16(src, dims, dst);
+      break;
+    case EmbeddingType::kInt8:
+      return pack_int8(src, dims, dst);
+    case EmbeddingType::kBinary:
+      pack_binary(src, dims, dst);
+      break;
+  }
+  return 1.0f;
+}
+
+void unpack_embedding_values(const char* data,
+                             size_t dims,
+                             EmbeddingType type,
+                             float* out) {
+  switch (type) {
+    case EmbeddingType::kFloat:
+      std::memcpy(out, data, dims * sizeof(float));
+      break;
+    case EmbeddingType::kFloat16:
+      for (size_t i = 0; i < dims; ++i) {
+        uint16_t half;
+        std::memcpy(&half, data + i * 2, sizeof(half));
+        out[i] = half_to_float(half);
+      }
+      break;
+    case EmbeddingType::kInt8:
+      for (size_t i = 0; i < dims; ++i) {
+        out[i] = static_cast<float>(static_cast<int8_t>(data[i]));
+      }
+      break;
+    case EmbeddingType::kBinary:
+      for (size_t i = 0; i < packed_embedding_size(type, dims); ++i) {
+        out[i] = static_cast<float>(static_cast<uint8_t>(data[i]));
+      }
+      break;
+  }
+}
+
+void set_embedding_output(const std::vector<float>& embedding,
+                          size_t dims,
+                          EmbeddingType type,
+                          const std::string& encoding_format,
+                          proto::EmbeddingResponseData* data,
+                          std::string* binary_payload) {
+  float scale = 1.0f;
+  if (encoding_format == "packed") {
+    scale =
+        pack_embedding(embedding, dims, type, data->mutable_embedding_bytes());
+  } else if (encoding_format == "packed_binary") {
+    const size_t offset = binary_payload->size();
+    scale = pack_embedding(embedding, dims, type, binary_payload);
+    data->set_payload_offset(static_cast<int64_t>(offset));
+    data->set_payload_length(
+        static_cast<int64_t>(binary_payload->size() - offset));
+  } else if (type == EmbeddingType::kFloat && dims == embedding.size()) {
+    data->mutable_embedding()->Add(embedding.data(),
+                                   embedding.data() + embedding.size());
+  } else {
+    std::string packed;
+    scale = pack_embedding(embedding, dims, type, &packed);
+    const size_t num_values = type == EmbeddingType::kBinary
+                                  ? packed_embedding_size(type, dims)
+                                  : dims;
+    auto* values = data->mutable_embedding();
+    values->Resize(static_cast<int>(num_values), 0.0f);
+    unpack_embedding_values(packed.data(), dims, type, values->mutable_data());
+  }
+  if (type == EmbeddingType::kInt8) {
+    data->set_scale(scale);
+  }
+}
+
+}  // namespace xllm
@@ -0,0 +1,74 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "embedding.pb.h"
+
+namespace xllm {
+
+// Element type of the embeddings in an embeddings response.
+enum class EmbeddingType : int8_t {
+  kFloat = 0,
+  kFloat16 = 1,
+  // scalar-quantized with a per-vector scale of max|x| / 127.
+  kInt8 = 2,
+  // one bit per dimension, most significant bit first, set for x > 0.
+  kBinary = 3,
+};
+
+// Parses "float", "float16", "int8" or "binary"; empty means "float".
+std::optional<EmbeddingType> parse_embedding_type(const std::string& name);
+
+// Bytes of a `dims`-dimensional embedding packed as `type`.
+size_t packed_embedding_size(EmbeddingType type, size_t dims);
+
+// Appends the first `dims` values of `values` to `out`, packed as `type` in
+// little-endian order. When `dims` truncates the embedding, the kept values
+// are re-normalized to unit L2 norm first (Matryoshka truncation). Returns
+// the dequantization scale for kInt8, and 1 otherwise.
+float pack_embedding(const std::vector<float>& values,
+                     size_t dims,
+                     EmbeddingType type,
+                     std::string* out);
+
+// Writes the `dims` values of a packed embedding to `out` as floats: the
+// float16 or int8 values, or the packed bytes of a kBinary embedding, in
+// which case `out` receives packed_embedding_size() values.
+void unpack_embedding_values(const char* data,
+                             size_t dims,
+                             EmbeddingType type,
+                             float* out);
+
+// Writes the first `dims` values of `embedding` to `data` as `type`. Only the
+// opt-in formats move the values out of the repeated float field: "packed"
+// packs them into `embedding_bytes`, and "packed_binary" appends them to
+// `binary_payload`, which follows the JSON body, with their byte range in
+// `payload_offset` / `payload_length`. "float", "base64" and "binary" keep
+// the repeated float output existing clients read.
+void set_embedding_output(const std::vector<float>& embedding,
+                          size_t dims,
+                          EmbeddingType type,
+                          const std::string& encoding_format,
+                          proto::EmbeddingResponseData* data,
+                          std::string* binary_payload);
+
+}  // namespace xllm
@@ -19,9 +19,11 @@ limitations under the License.
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 #include "common/instance_name.h"
 #include "distributed_runtime/llm_master.h"
+#include "embedding_encoding.h"
 #include "embedding_output_builder.h"
 #include "framework/config/model_config.h"
 #include "framework/request/request_params.h"
@@ -32,6 +34,25 @@ limitations under the License.
 namespace xllm {
 namespace {
 
+// Rejects output options the response builder can't honor before the
+// request takes a batch slot.
+template <typename EmbeddingCall>
+bool verify_output_options(const std::shared_ptr<EmbeddingCall>& call) {
+  const auto& request = call->request();
+  if (!parse_embedding_type(request.embedding_type()).has_value()) {
+    call->finish_with_error(
+        StatusCode::INVALID_ARGUMENT,
+        "embedding_type must be one of float, float16, int8 or binary");
+    return false;
+  }
+  if (request.has_dimensions() && request.dimensions() <= 0) {
+    call->finish_with_error(StatusCode::INVALID_ARGUMENT,
+                            "dimensions must be positive");
+    return false;
+  }
+  return true;
+}
+
 template <typename EmbeddingCall>
 bool send_result_to_client_brpc(std::shared_ptr<EmbeddingCall> call,
                                 const std::string& request_id,
@@ -45,8 +66,17 @@ bool send_result_to_client_brpc(std::shared_ptr<EmbeddingCall> call,
   response.set_model(model);
 
   response.mutable_data()->Reserve(req_output.outputs.size());
-  std::string encoding_format = call->request().encoding_format();
-  bool use_binary_format = encoding_format == "binary";
+  const auto& request = call->request();
+  std::string encoding_format = request.encoding_format();
+  bool use_binary_format =
+      encoding_format == "binary" || encoding_format == "packed_binary";
+  // validated before the request was scheduled.
+  const EmbeddingType embedding_type =
+      parse_embedding_type(request.embedding_type())
+          .value_or(EmbeddingType::kFloat);
+  if (encoding_format == "packed") {
+    call->set_bytes_to_base64(true);
+  }
   EmbeddingOutputBuilder mm_embeddings_output_builder(use_binary_format, false);
   std::string binary_payload;
   for (const auto& output : req_output.outputs) {
@@ -55,9 +85,22 @@ bool send_result_to_client_brpc(std::shared_ptr<EmbeddingCall> call,
     data->set_index(output.index);
     data->set_object("embedding");
     if (output.embeddings.has_value()) {
-      data->mutable_embedding()->Add(
-          output.embeddings->data(),
-          output.embeddings->data() + output.embeddings->size());
+      const std::vector<float>& embedding = output.embeddings.value();
+      const size_t dims = request.has_dimensions()
+                              ? static_cast<size_t>(request.dimensions())
+                              : embedding.size();
+      if (dims > embedding.size()) {
+        return call->finish_with_error(
+            StatusCode::INVALID_ARGUMENT,
+            "dimensions exceeds the embedding size " +
+                std::to_string(embedding.size()));
+      }
+      set_embedding_output(embedding,
+                           dims,
+                           embedding_type,
+                           encoding_format,
+                           data,
+                           &binary_payload);
     }
     if (output.mm_embeddings.has_value()) {
       call->set_bytes_to_base64(true);
@@ -99,6 +142,9 @@ void EmbeddingServiceImpl::process_async_impl(
     call->finish_with_error(StatusCode::UNKNOWN, "Model not supported");
     return;
   }
+  if (!verify_output_options(call)) {
+    return;
+  }
 
   // create RequestParams for embeddings request
   // set is_embeddings and max_tokens = 1 to control engine step once.
@@ -148,6 +194,9 @@ void MMEmbeddingServiceImpl::process_async_impl(
     call->finish_with_error(StatusCode::UNKNOWN, "Model not supported");
     return;
   }
+  if (!verify_output_options(call)) {
+    return;
+  }
 
   // create RequestParams for embeddings request
   // set is_embeddings and max_tokens = 1 to control engine step once.
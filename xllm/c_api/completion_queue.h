@@ -0,0 +1,94 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLLM_COMPLETION_QUEUE_API_H
+#define XLLM_COMPLETION_QUEUE_API_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "types.h"
+
+/**
+ * @brief Create a completion queue for asynchronous requests
+ *
+ * A completion queue collects the events of any number of asynchronous LLM
+ * and REC requests, so a single thread can drive thousands of in-flight
+ * requests. Events are fetched with xllm_completion_queue_poll(); the queue
+ * also exposes an eventfd that is readable while events are pending, for
+ * integration with epoll/poll based event loops.
+ *
+ * @return Valid XLLM_CompletionQueue* on success; NULL if the eventfd cannot
+ * be created
+ * @see xllm_completion_queue_destroy, XLLM_AsyncOptions
+ */
+XLLM_CAPI_EXPORT XLLM_CompletionQueue* xllm_completion_queue_create(void);
+
+/**
+ * @brief Destroy a completion queue
+ *
+ * Pending events are dropped and their responses freed. Events of requests
+ * still in flight are freed on arrival, so requests do not need to be drained
+ * first. No thread may be polling the queue during this call.
+ *
+ * @param queue Completion queue (NULL = no operation)
+ * @see xllm_completion_queue_create
+ */
+XLLM_CAPI_EXPORT void xllm_completion_queue_destroy(
+    XLLM_CompletionQueue* queue);
+
+/**
+ * @brief Get the eventfd of a completion queue
+ *
+ * The descriptor is readable (level-triggered) while the queue holds events.
+ * Do not read from or close it; call xllm_completion_queue_poll() instead.
+ *
+ * @param queue Valid completion queue
+ * @return File descriptor; -1 if queue is NULL
+ */
+XLLM_CAPI_EXPORT int xllm_completion_queue_fd(
+    const XLLM_CompletionQueue* queue);
+
+/**
+ * @brief Fetch pending events from a completion queue
+ *
+ * Moves up to max_events events into the events array, oldest first. The
+ * caller owns the response of every returned event and frees it with
+ * xllm_llm_free_response() or xllm_rec_free_response().
+ *
+ * @param queue Valid completion queue
+ * @param events Output array with room for max_events events
+ * @param max_events Maximum number of events to return
+ * @param timeout_ms Time to wait for the first event (0 = return immediately,
+ *                   negative = wait indefinitely)
+ *
+ * @return Number of events written to events (0 on timeout)
+ * @note Thread-safe: several threads may poll the same queue
+ */
+XLLM_CAPI_EXPORT size_t xllm_completion_queue_poll(XLLM_CompletionQueue* queue,
+                                                   XLLM_Event* events,
+                                                   size_t max_events,
+                                                   int32_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // XLLM_COMPLETION_QUEUE_API_H
@@ -156,6 +156,12 @@ const XLLM_RequestParams XLLM_REC_REQUEST_PARAMS_DEFAULT = {
     .temperature = 0.0,
     .request_id = ""};
 
+const XLLM_AsyncOptions XLLM_ASYNC_OPTIONS_DEFAULT = {.stream = false,
+                                                     .skip_detokenize = false,
+                                                     .queue = NULL,
+                                                     .callback = NULL,
+                                                     .user_data = NULL};
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,140 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "completion_queue.h"
+#include "default.h"
+#include "llm.h"
+
+std::string model_name = "Qwen3-8B";
+std::string model_path = "/export/home/models/Qwen3-8B";
+
+XLLM_LLM_Handler* service_startup_hook() {
+  XLLM_LLM_Handler* llm_handler = xllm_llm_create();
+
+  XLLM_InitOptions init_options;
+  xllm_llm_init_options_default(&init_options);
+  snprintf(
+      init_options.log_dir, sizeof(init_options.log_dir), "/export/xllm/log");
+
+  bool ret =
+      xllm_llm_initialize(llm_handler, model_path.c_str(), &init_options);
+  if (!ret) {
+    std::cout << "LLM init failed" << std::endl;
+    xllm_llm_destroy(llm_handler);
+    return nullptr;
+  }
+
+  std::cout << "LLM init successfully" << std::endl;
+
+  return llm_handler;
+}
+
+void service_stop_hook(XLLM_LLM_Handler* llm_handler) {
+  xllm_llm_destroy(llm_handler);
+  std::cout << "LLM stop" << std::endl;
+}
+
+int main(int argc, char** argv) {
+  XLLM_LLM_Handler* llm_handler = service_startup_hook();
+  if (nullptr == llm_handler) {
+    return -1;
+  }
+
+  XLLM_CompletionQueue* queue = xllm_completion_queue_create();
+  if (nullptr == queue) {
+    service_stop_hook(llm_handler);
+    return -1;
+  }
+
+  XLLM_RequestParams request_params;
+  xllm_llm_request_params_default(&request_params);
+  request_params.max_tokens = 128;
+
+  // stream every prompt's tokens into the same completion queue.
+  XLLM_AsyncOptions async_options = XLLM_ASYNC_OPTIONS_DEFAULT;
+  async_options.stream = true;
+  async_options.queue = queue;
+
+  std::vector<std::string> texts = {"please briefly introduce XLLM for me",
+                                    "what is continuous batching",
+                                    "write a haiku about GPUs"};
+  std::vector<XLLM_Prompt> prompts(texts.size());
+  for (size_t i = 0; i < texts.size(); ++i) {
+    prompts[i].text = texts[i].c_str();
+  }
+  std::vector<XLLM_RequestHandle> handles(prompts.size());
+  size_t in_flight = xllm_llm_completions_batch_async(llm_handler,
+                                                      model_name.c_str(),
+                                                      prompts.data(),
+                                                      prompts.size(),
+                                                      &request_params,
+                                                      &async_options,
+                                                      handles.data());
+
+  // one epoll loop serves every in-flight request.
+  int epoll_fd = epoll_create1(0);
+  epoll_event watch;
+  memset(&watch, 0, sizeof(watch));
+  watch.events = EPOLLIN;
+  epoll_ctl(epoll_fd, EPOLL_CTL_ADD, xllm_completion_queue_fd(queue), &watch);
+
+  std::vector<std::string> answers(prompts.size());
+  XLLM_Event events[16];
+  while (in_flight > 0) {
+    epoll_event ready;
+    if (epoll_wait(epoll_fd, &ready, 1, 10000) <= 0) {
+      std::cout << "LLM async completions timed out" << std::endl;
+      break;
+    }
+    size_t count = xllm_completion_queue_poll(queue, events, 16, 0);
+    for (size_t i = 0; i < count; ++i) {
+      XLLM_Response* resp = events[i].response;
+      if (resp->status_code != XLLM_StatusCode::kSuccess) {
+        std::cout << "request[" << events[i].batch_index
+                  << "] failed, status code:" << resp->status_code
+                  << ", error info:" << resp->error_info << std::endl;
+      } else {
+        for (size_t j = 0; j < resp->choices.entries_size; ++j) {
+          if (nullptr != resp->choices.entries[j].text) {
+            answers[events[i].batch_index] += resp->choices.entries[j].text;
+          }
+        }
+      }
+      if (events[i].type == XLLM_EVENT_FINISHED) {
+        --in_flight;
+      }
+      xllm_llm_free_response(resp);
+    }
+  }
+  close(epoll_fd);
+
+  for (size_t i = 0; i < answers.size(); ++i) {
+    std::cout << "xllm answer[" << i << "]:" << answers[i] << std::endl;
+  }
+
+  // destroying the handler first finishes any remaining request as cancelled.
+  service_stop_hook(llm_handler);
+  xllm_completion_queue_destroy(queue);
+
+  return 0;
+}
@@ -0,0 +1,274 @@
+/* Copyright 2025-2026 The xLLM Authors.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "async_request.h"
+
+#include <glog/logging.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include "api_service/call.h"
+#include "c_api/completion_queue.h"
+#include "helper.h"
+
+namespace xllm {
+namespace helper {
+namespace {
+
+// reports a cancelled C API request to the scheduler like a closed
+// connection, see Request::update_connection_status().
+class AsyncRequestCall final : public Call {
+ public:
+  explicit AsyncRequestCall(const AsyncRequest* request) : request_(request) {}
+
+  bool is_disconnected() const override { return request_->cancelled(); }
+
+ private:
+  const AsyncRequest* request_;
+};
+
+}  // namespace
+
+CompletionQueueState::CompletionQueueState() {
+  event_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  PLOG_IF(ERROR, event_fd_ < 0) << "Failed to create completion queue eventfd";
+}
+
+CompletionQueueState::~CompletionQueueState() {
+  close();
+  if (event_fd_ >= 0) {
+    ::close(event_fd_);
+  }
+}
+
+bool CompletionQueueState::push(const XLLM_Event& event) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (closed_) {
+    return false;
+  }
+  if (events_.empty() && event_fd_ >= 0) {
+    const uint64_t one = 1;
+    ssize_t ret = ::write(event_fd_, &one, sizeof(one));
+    (void)ret;
+  }
+  events_.push_back(event);
+  cv_.notify_one();
+  return true;
+}
+
+size_t CompletionQueueState::poll(XLLM_Event* events,
+                                  size_t max_events,
+                                  int32_t timeout_ms) {
+  if (events == nullptr || max_events == 0) {
+    return 0;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto ready = [this]() { return closed_ || !events_.empty(); };
+  if (timeout_ms < 0) {
+    cv_.wait(lock, ready);
+  } else if (timeout_ms > 0) {
+    cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready);
+  }
+
+  size_t count = 0;
+  while (count < max_events && !events_.empty()) {
+    events[count++] = events_.front();
+    events_.pop_front();
+  }
+  if (count > 0 && events_.empty() && event_fd_ >= 0) {
+    uint64_t value = 0;
+    ssize_t ret = ::read(event_fd_, &value, sizeof(value));
+    (void)ret;
+  }
+  return count;
+}
+
+void CompletionQueueState::close() {
+  std::deque<XLLM_Event> dropped;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    dropped.swap(events_);
+  }
+  cv_.notify_all();
+  for (XLLM_Event& event : dropped) {
+    xllm_free_response(event.response);
+  }
+}
+
+AsyncRequest::AsyncRequest(XLLM_RequestHandle handle,
+                           uint32_t batch_index,
+                           std::string request_id,
+                           const XLLM_AsyncOptions& options,
+                           std::shared_ptr<CompletionQueueState> queue,
+                           std::weak_ptr<AsyncRequestRegistry> registry)
+    : handle_(handle),
+      batch_index_(batch_index),
+      request_id_(std::move(request_id)),
+      stream_(options.stream),
+      user_data_(options.user_data),
+      callback_(options.callback),
+      queue_(std::move(queue)),
+      registry_(std::move(registry)),
+      call_(std::make_unique<AsyncRequestCall>(this)) {}
+
+AsyncRequest::~AsyncRequest() = default;
+
+void AsyncRequest::deliver_delta(XLLM_Response* response) {
+  if (finished()) {
+    xllm_free_response(response);
+    return;
+  }
+  deliver(XLLM_EVENT_DELTA, response);
+}
+
+void AsyncRequest::finish(XLLM_Response* response) {
+  if (finished_.exchange(true, std::memory_order_acq_rel)) {
+    xllm_free_response(response);
+    return;
+  }
+  deliver(XLLM_EVENT_FINISHED, response);
+  if (auto registry = registry_.lock()) {
+    registry->remove(handle_);
+  }
+}
+
+void AsyncRequest::deliver(XLLM_EventType type, XLLM_Response* response) {
+  XLLM_Event event;
+  event.handle = handle_;
+  event.type = type;
+  event.batch_index = batch_index_;
+  event.user_data = user_data_;
+  event.response = response;
+  if (callback_ != nullptr) {
+    try {
+      callback_(&event);
+    } catch (...) {
+      LOG(ERROR) << "Event callback of request [" << request_id_
+                 << "] threw an exception";
+    }
+    xllm_free_response(response);
+    return;
+  }
+  if (!queue_->push(event)) {
+    xllm_free_response(response);
+  }
+}
+
+std::shared_ptr<AsyncRequest> AsyncRequestRegistry::create(
+    uint32_t batch_index,
+    std::string request_id,
+    const XLLM_AsyncOptions& options) {
+  if ((options.queue == nullptr) == (options.callback == nullptr)) {
+    LOG(ERROR) << "Async request needs exactly one of queue and callback";
+    return nullptr;
+  }
+  std::shared_ptr<CompletionQueueState> queue;
+  if (options.queue != nullptr) {
+    queue = options.queue->state;
+    CHECK(queue != nullptr);
+  }
+  const XLLM_RequestHandle handle =
+      next_handle_.fetch_add(1, std::memory_order_relaxed);
+  return std::make_shared<AsyncRequest>(handle,
+                                        batch_index,
+                                        std::move(request_id),
+                                        options,
+                                        std::move(queue),
+                                        weak_from_this());
+}
+
+void AsyncRequestRegistry::add(const std::shared_ptr<AsyncRequest>& request) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  requests_.emplace(request->handle(), request);
+}
+
+void AsyncRequestRegistry::remove(XLLM_RequestHandle handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  requests_.erase(handle);
+}
+
+bool AsyncRequestRegistry::cancel(XLLM_RequestHandle handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = requests_.find(handle);
+  if (it == requests_.end()) {
+    return false;
+  }
+  it->second->cancel();
+  return true;
+}
+
+void AsyncRequestRegistry::cancel_all(const std::string& reason) {
+  std::unordered_map<XLLM_RequestHandle, std::shared_ptr<AsyncRequest>>
+      requests;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    requests.swap(requests_);
+  }
+  for (auto& [handle, request] : requests) {
+    request->cancel();
+    request->finish(build_cancelled_response(request->request_id(), reason));
+  }
+}
+
+XLLM_Response* build_cancelled_response(const std::string& request_id,
+                                        const std::string& reason) {
+  XLLM_Response* response = new XLLM_Response();
+  CHECK(nullptr != response);
+
+  response->status_code = XLLM_StatusCode::kCancelled;
+  strncpy(response->error_info, reason.c_str(), XLLM_ERROR_INFO_MAX_LEN - 1);
+  response->error_info[XLLM_ERROR_INFO_MAX_LEN - 1] = '\0';
+  XLLM_SET_META_STRING_FIELD(response->id, request_id);
+
+  return response;
+}
+
+}  // namespace helper
+}  // namespace xllm
+
+XLLM_CAPI_EXPORT XLLM_CompletionQueue* xllm_completion_queue_create(void) {
+  auto state = std::make_shared<xllm::helper::CompletionQueueState>();
+  if (!state->valid()) {
+    return nullptr;
+  }
+  XLLM_CompletionQueue* queue = new XLLM_CompletionQueue();
+  CHECK(nullptr != queue);
+  queue->state = std::move(state);
+  return queue;
+}
+
+XLLM_CAPI_EXPORT void xllm_completion_queue_destroy(
+    XLLM_CompletionQueue* queue) {
+  if (!queue) return;
+
+  queue->state->close();
+  delete queue;
+}
+
+XLLM_CAPI_EXPORT int xllm_completion_queue_fd(
+    const XLLM_CompletionQueue* queue) {
+  if (!queue) return -1;
+  return queue->state->fd();
+}
+
+XLLM_CAPI_EXPORT size_t xllm_completion_queue_poll(XLLM_CompletionQueue* queue,
+                                                   XLLM_Event* events,
+                                                   size_t max_events,
+                                                   int32_t timeout_ms) {
+  if (!queue) return 0;
+  return queue->state->poll(events, max_events, timeout_ms);
+}
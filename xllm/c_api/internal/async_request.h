@@ -0,0 +1,174 @@
+/* Copyright 2025-2026 The xLLM Authors.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "c_api/types.h"
+
+namespace xllm {
+
+class Call;
+
+namespace helper {
+
+/**
+ * @brief Event storage behind XLLM_CompletionQueue
+ * @note Shared with the requests delivering into it, so that destroying the
+ * queue does not race with in-flight requests.
+ */
+class CompletionQueueState final {
+ public:
+  CompletionQueueState();
+  ~CompletionQueueState();
+
+  bool valid() const { return event_fd_ >= 0; }
+  int fd() const { return event_fd_; }
+
+  /**
+   * @brief Append an event; returns false if the queue is closed, in which
+   * case the caller keeps ownership of the event response
+   */
+  bool push(const XLLM_Event& event);
+
+  size_t poll(XLLM_Event* events, size_t max_events, int32_t timeout_ms);
+
+  /**
+   * @brief Drop pending events and reject new ones
+   */
+  void close();
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<XLLM_Event> events_;
+  bool closed_ = false;
+  // readable while events_ is not empty
+  int event_fd_ = -1;
+};
+
+class AsyncRequestRegistry;
+
+/**
+ * @brief State of one asynchronous request, shared by its output callback
+ */
+class AsyncRequest final {
+ public:
+  AsyncRequest(XLLM_RequestHandle handle,
+               uint32_t batch_index,
+               std::string request_id,
+               const XLLM_AsyncOptions& options,
+               std::shared_ptr<CompletionQueueState> queue,
+               std::weak_ptr<AsyncRequestRegistry> registry);
+  ~AsyncRequest();
+
+  XLLM_RequestHandle handle() const { return handle_; }
+  const std::string& request_id() const { return request_id_; }
+  bool stream() const { return stream_; }
+
+  bool cancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+  void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+  bool finished() const { return finished_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Call polled by the scheduler, reporting cancellation as a client
+   * disconnect so that requests stop between steps
+   */
+  Call* call() const { return call_.get(); }
+
+  /**
+   * @brief Deliver a streaming delta; takes ownership of response
+   */
+  void deliver_delta(XLLM_Response* response);
+
+  /**
+   * @brief Deliver the final event once and unregister the request; takes
+   * ownership of response
+   */
+  void finish(XLLM_Response* response);
+
+ private:
+  void deliver(XLLM_EventType type, XLLM_Response* response);
+
+  const XLLM_RequestHandle handle_;
+  const uint32_t batch_index_;
+  const std::string request_id_;
+  const bool stream_;
+  void* const user_data_;
+  const XLLM_EventCallback callback_;
+  const std::shared_ptr<CompletionQueueState> queue_;
+  const std::weak_ptr<AsyncRequestRegistry> registry_;
+  std::unique_ptr<Call> call_;
+
+  std::atomic<bool> cancelled_{false};
+  std::atomic<bool> finished_{false};
+};
+
+/**
+ * @brief In-flight asynchronous requests of one LLM/REC handler
+ */
+class AsyncRequestRegistry final
+    : public std::enable_shared_from_this<AsyncRequestRegistry> {
+ public:
+  /**
+   * @brief Create a request with a fresh handle; it is registered by add()
+   * @return nullptr if the options name neither a queue nor a callback
+   */
+  std::shared_ptr<AsyncRequest> create(uint32_t batch_index,
+                                       std::string request_id,
+                                       const XLLM_AsyncOptions& options);
+
+  void add(const std::shared_ptr<AsyncRequest>& request);
+
+  void remove(XLLM_RequestHandle handle);
+
+  /**
+   * @brief Mark a request cancelled; returns false if it is not in flight
+   */
+  bool cancel(XLLM_RequestHandle handle);
+
+  /**
+   * @brief Finish every in-flight request as cancelled, after the engine
+   * delivering their outputs has stopped
+   */
+  void cancel_all(const std::string& reason);
+
+ private:
+  std::atomic<XLLM_RequestHandle> next_handle_{1};
+  std::mutex mutex_;
+  std::unordered_map<XLLM_RequestHandle, std::shared_ptr<AsyncRequest>>
+      requests_;
+};
+
+/**
+ * @brief Build the final response of a cancelled request
+ */
+XLLM_Response* build_cancelled_response(const std::string& request_id,
+                                        const std::string& reason);
+
+}  // namespace helper
+}  // namespace xllm
+
+/**
+ * @brief Opaque handle for a completion queue
+ */
+struct XLLM_CompletionQueue {
+  std::shared_ptr<xllm::helper::CompletionQueueState> state;
+};
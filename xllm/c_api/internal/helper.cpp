@@ -317,6 +317,60 @@ XLLM_Response* build_success_response(const InferenceType& inference_type,
   return response;
 }
 
+namespace {
+
+// hands a request over to the master of the handler; outputs arrive through
+// callback on the master's response threads.
+template <typename HandlerType, typename InputType>
+void dispatch_inference_request(HandlerType* handler,
+                                const InputType& input,
+                                void* extra,
+                                const xllm::RequestParams& xllm_request_params,
+                                std::optional<Call*> call,
+                                OutputCallback callback) {
+  if constexpr (std::is_same_v<HandlerType, XLLM_LLM_Handler>) {
+    if constexpr (std::is_same_v<InputType, std::vector<int>>) {
+      handler->master->handle_request(
+          "", input, xllm_request_params, call, std::move(callback));
+    } else {
+      handler->master->handle_request(input,
+                                      std::nullopt,
+                                      xllm_request_params,
+                                      call,
+                                      std::move(callback));
+    }
+  } else if constexpr (std::is_same_v<HandlerType, XLLM_REC_Handler>) {
+    if constexpr (std::is_same_v<InputType, std::vector<int>>) {
+      if (nullptr != extra) {
+        xllm::MMData* mm_data =
+            dynamic_cast<xllm::MMData*>(static_cast<xllm::MMData*>(extra));
+        CHECK(nullptr != mm_data);
+
+        std::optional<xllm::MMData> opt_mm_data = std::move(*mm_data);
+        handler->master->handle_request(
+            input, opt_mm_data, xllm_request_params, std::move(callback));
+
+      } else {
+        handler->master->handle_request("",
+                                        input,
+                                        std::nullopt,
+                                        xllm_request_params,
+                                        std::move(callback));
+      }
+    } else {
+      handler->master->handle_request(input,
+                                      std::nullopt,
+                                      std::nullopt,
+                                      xllm_request_params,
+                                      std::move(callback));
+    }
+  } else {
+    CHECK(false);
+  }
+}
+
+}  // namespace
+
 template <typename HandlerType, typename InputType>
 XLLM_Response* handle_inference_request(
     HandlerType* handler,
@@ -408,40 +462,12 @@ XLLM_Response* handle_inference_request(
       return false;
     };
 
-    if constexpr (std::is_same_v<HandlerType, XLLM_LLM_Handler>) {
-      handler->master->handle_request(input,
-                                      std::nullopt,
-                                      xllm_request_params,
-                                      std::nullopt,
-                                      on_request_complete);
-    } else if constexpr (std::is_same_v<HandlerType, XLLM_REC_Handler>) {
-      if constexpr (std::is_same_v<InputType, std::vector<int>>) {
-        if (nullptr != extra) {
-          xllm::MMData* mm_data =
-              dynamic_cast<xllm::MMData*>(static_cast<xllm::MMData*>(extra));
-          CHECK(nullptr != mm_data);
-
-          std::optional<xllm::MMData> opt_mm_data = std::move(*mm_data);
-          handler->master->handle_request(
-              input, opt_mm_data, xllm_request_params, on_request_complete);
-
-        } else {
-          handler->master->handle_request("",
-                                          input,
-                                          std::nullopt,
-                                          xllm_request_params,
-                                          on_request_complete);
-        }
-      } else {
-        handler->master->handle_request(input,
-                                        std::nullopt,
-                                        std::nullopt,
-                                        xllm_request_params,
-                                        on_request_complete);
-      }
-    } else {
-      CHECK(false);
-    }
+    dispatch_inference_request(handler,
+                               input,
+                               extra,
+                               xllm_request_params,
+                               std::nullopt,
+                               on_request_complete);
 
     return std::move(future)
         .via(handler->executor.get())
@@ -473,6 +499,159 @@ XLLM_Response* handle_inference_request(
   }
 }
 
+template <typename HandlerType, typename InputType>
+XLLM_RequestHandle submit_inference_request(
+    HandlerType* handler,
+    InferenceType inference_type,
+    const std::string& model_id,
+    const InputType& input,
+    void* extra,
+    uint32_t batch_index,
+    const XLLM_RequestParams* request_params,
+    const XLLM_AsyncOptions& async_options) {
+  CHECK(nullptr != handler);
+  CHECK(nullptr != handler->async_requests);
+
+  std::string request_id;
+  if (nullptr != request_params && strlen(request_params->request_id) > 0) {
+    request_id = request_params->request_id;
+  } else {
+    request_id = generate_request_id();
+  }
+
+  std::shared_ptr<AsyncRequest> request =
+      handler->async_requests->create(batch_index, request_id, async_options);
+  if (nullptr == request) {
+    return XLLM_INVALID_REQUEST_HANDLE;
+  }
+  const XLLM_RequestHandle handle = request->handle();
+
+  if (!handler->initialized) {
+    request->finish(build_error_response(request_id,
+                                         XLLM_StatusCode::kNotInitialized,
+                                         "LLM is not initialized"));
+    return handle;
+  }
+
+  if (std::find(handler->model_ids.begin(),
+                handler->model_ids.end(),
+                model_id) == handler->model_ids.end()) {
+    request->finish(
+        build_error_response(request_id,
+                             XLLM_StatusCode::kModelNotFound,
+                             "Specified model ID not loaded: " + model_id));
+    return handle;
+  }
+
+  xllm::RequestParams xllm_request_params;
+  transfer_request_params(inference_type, request_params, &xllm_request_params);
+  xllm_request_params.request_id = request_id;
+  xllm_request_params.streaming = async_options.stream;
+  xllm_request_params.skip_detokenize = async_options.skip_detokenize;
+  RecPipelineType rec_pipeline_type = RecPipelineType::kLlmRecDefault;
+  std::optional<Call*> call = std::nullopt;
+  if constexpr (std::is_same_v<HandlerType, XLLM_REC_Handler>) {
+    rec_pipeline_type = handler->pipeline_type;
+    if (::xllm::RecConfig::get_instance().enable_output_sku_logprobs() &&
+        is_onerec_pipeline_type(rec_pipeline_type)) {
+      xllm_request_params.logprobs = true;
+    }
+  } else {
+    // lets the scheduler drop a cancelled request between steps.
+    call = request->call();
+  }
+
+  const int64_t created_time = absl::ToUnixSeconds(absl::Now());
+
+  // the callback owns the request state: it lives as long as the engine may
+  // still deliver outputs.
+  auto on_request_output = [request,
+                            model_id,
+                            created_time,
+                            inference_type,
+                            rec_pipeline_type](
+                               const RequestOutput& req_output) -> bool {
+    if (request->finished()) {
+      return false;
+    }
+    const std::string& request_id = request->request_id();
+    try {
+      if (request->cancelled() || req_output.cancelled) {
+        request->finish(
+            build_cancelled_response(request_id, "Request cancelled"));
+        return false;
+      }
+      if (req_output.status.has_value() && !req_output.status.value().ok()) {
+        request->finish(build_error_response(
+            request_id,
+            XLLM_StatusCode::kInternalError,
+            "RequestOutput status is not ok, message: " +
+                req_output.status.value().message()));
+        return false;
+      }
+      if (!request->stream() && !req_output.status.has_value()) {
+        request->finish(
+            build_error_response(request_id,
+                                 XLLM_StatusCode::kInternalError,
+                                 "RequestOutput status has no value"));
+        return false;
+      }
+
+      XLLM_Response* response = build_success_response(inference_type,
+                                                       req_output,
+                                                       rec_pipeline_type,
+                                                       request_id,
+                                                       created_time,
+                                                       model_id);
+      if (!request->stream() || req_output.finished) {
+        request->finish(response);
+      } else {
+        request->deliver_delta(response);
+      }
+      return true;
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Build response failed: " << e.what();
+      request->finish(build_error_response(
+          request_id,
+          XLLM_StatusCode::kInternalError,
+          "Build response failed: " + std::string(e.what())));
+    }
+    return false;
+  };
+
+  handler->async_requests->add(request);
+  try {
+    dispatch_inference_request(handler,
+                               input,
+                               extra,
+                               xllm_request_params,
+                               call,
+                               std::move(on_request_output));
+  } catch (const std::exception& e) {
+    request->finish(build_error_response(
+        request_id,
+        XLLM_StatusCode::kInternalError,
+        "Failed to submit request: " + std::string(e.what())));
+  }
+  return handle;
+}
+
+const XLLM_RequestParams* batch_request_params(
+    const XLLM_RequestParams* request_params,
+    size_t index,
+    XLLM_RequestParams* storage) {
+  if (nullptr == request_params || strlen(request_params->request_id) == 0) {
+    return request_params;
+  }
+  *storage = *request_params;
+  snprintf(storage->request_id,
+           sizeof(storage->request_id),
+           "%s-%zu",
+           request_params->request_id,
+           index);
+  return storage;
+}
+
 void xllm_free_response(XLLM_Response* resp) {
   if (nullptr == resp) {
     return;
@@ -752,5 +931,79 @@ handle_inference_request<XLLM_REC_Handler, std::vector<int>>(
     void* extra,
     uint32_t timeout_ms,
     const XLLM_RequestParams* request_params);
+
+// Async submission instantiations
+
+// 1. LLM text completions
+template XLLM_RequestHandle
+submit_inference_request<XLLM_LLM_Handler, const char*>(
+    XLLM_LLM_Handler* handler,
+    InferenceType inference_type,
+    const std::string& model_id,
+    const char* const& input,
+    void* extra,
+    uint32_t batch_index,
+    const XLLM_RequestParams* request_params,
+    const XLLM_AsyncOptions& async_options);
+
+// 2. LLM token id completions
+template XLLM_RequestHandle
+submit_inference_request<XLLM_LLM_Handler, std::vector<int>>(
+    XLLM_LLM_Handler* handler,
+    InferenceType inference_type,
+    const std::string& model_id,
+    const std::vector<int>& input,
+    void* extra,
+    uint32_t batch_index,
+    const XLLM_RequestParams* request_params,
+    const XLLM_AsyncOptions& async_options);
+
+// 3. LLM chat completions
+template XLLM_RequestHandle
+submit_inference_request<XLLM_LLM_Handler, std::vector<xllm::Message>>(
+    XLLM_LLM_Handler* handler,
+    InferenceType inference_type,
+    const std::string& model_id,
+    const std::vector<xllm::Message>& input,
+    void* extra,
+    uint32_t batch_index,
+    const XLLM_RequestParams* request_params,
+    const XLLM_AsyncOptions& async_options);
+
+// 4. REC completions
+template XLLM_RequestHandle
+submit_inference_request<XLLM_REC_Handler, const char*>(
+    XLLM_REC_Handler* handler,
+    InferenceType inference_type,
+    const std::string& model_id,
+    const char* const& input,
+    void* extra,
+    uint32_t batch_index,
+    const XLLM_RequestParams* request_params,
+    const XLLM_AsyncOptions& async_options);
+
+// 5. REC token id completions
+template XLLM_RequestHandle
+submit_inference_request<XLLM_REC_Handler, std::vector<int>>(
+    XLLM_REC_Handler* handler,
+    InferenceType inference_type,
+    const std::string& model_id,
+    const std::vector<int>& input,
+    void* extra,
+    uint32_t batch_index,
+    const XLLM_RequestParams* request_params,
+    const XLLM_AsyncOptions& async_options);
+
+// 6. REC chat completions
+template XLLM_RequestHandle
+submit_inference_request<XLLM_REC_Handler, std::vector<xllm::Message>>(
+    XLLM_REC_Handler* handler,
+    InferenceType inference_type,
+    const std::string& model_id,
+    const std::vector<xllm::Message>& input,
+    void* extra,
+    uint32_t batch_index,
+    const XLLM_RequestParams* request_params,
+    const XLLM_AsyncOptions& async_options);
 }  // namespace helper
 }  // namespace xllm
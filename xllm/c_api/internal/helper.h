@@ -24,6 +24,7 @@ limitations under the License.
 #include <string>
 #include <vector>
 
+#include "async_request.h"
 #include "c_api/default.h"
 #include "c_api/types.h"
 #include "core/common/instance_name.h"
@@ -48,6 +49,9 @@ struct XLLM_LLM_Handler {
 
   /** Thread pool for asynchronous inference task scheduling */
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor;
+
+  /** In-flight requests submitted through the async API */
+  std::shared_ptr<xllm::helper::AsyncRequestRegistry> async_requests;
 };
 
 /**
@@ -68,6 +72,9 @@ struct XLLM_REC_Handler {
 
   /** Thread pool for asynchronous recommendation task scheduling */
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor;
+
+  /** In-flight requests submitted through the async API */
+  std::shared_ptr<xllm::helper::AsyncRequestRegistry> async_requests;
 };
 
 namespace xllm {
@@ -149,6 +156,33 @@ XLLM_Response* handle_inference_request(
     uint32_t timeout_ms,
     const XLLM_RequestParams* request_params);
 
+/**
+ * @brief Generic asynchronous inference request submission (template
+ * function)
+ * @return Handle of the request, whose events are delivered as described by
+ * async_options; XLLM_INVALID_REQUEST_HANDLE if async_options is invalid
+ */
+template <typename HandlerType, typename InputType>
+XLLM_RequestHandle submit_inference_request(
+    HandlerType* handler,
+    InferenceType inference_type,
+    const std::string& model_id,
+    const InputType& input,
+    void* extra,
+    uint32_t batch_index,
+    const XLLM_RequestParams* request_params,
+    const XLLM_AsyncOptions& async_options);
+
+/**
+ * @brief Request params of the index-th prompt of a batch submission, with
+ * "-<index>" appended to a caller-provided request ID
+ * @return request_params itself if it sets no request ID, else storage
+ */
+const XLLM_RequestParams* batch_request_params(
+    const XLLM_RequestParams* request_params,
+    size_t index,
+    XLLM_RequestParams* storage);
+
 /**
  * @brief Safely free all memory allocated in XLLM_Response
  */
@@ -35,6 +35,8 @@ XLLM_CAPI_EXPORT XLLM_LLM_Handler* xllm_llm_create(void) {
   CHECK(nullptr != handler);
 
   handler->initialized = false;
+  handler->async_requests =
+      std::make_shared<xllm::helper::AsyncRequestRegistry>();
 
   return handler;
 }
@@ -46,6 +48,8 @@ XLLM_CAPI_EXPORT void xllm_llm_destroy(XLLM_LLM_Handler* handler) {
   handler->executor.reset();
   handler->model_ids.clear();
   handler->initialized = false;
+  // the engine is stopped, so no more outputs arrive for these.
+  handler->async_requests->cancel_all("LLM handler destroyed");
 
   delete handler;
 }
@@ -213,6 +217,130 @@ XLLM_CAPI_EXPORT XLLM_Response* xllm_llm_chat_completions(
       request_params);
 }
 
+namespace {
+
+XLLM_RequestHandle submit_completion(XLLM_LLM_Handler* handler,
+                                     const char* model_id,
+                                     const XLLM_Prompt& prompt,
+                                     uint32_t batch_index,
+                                     const XLLM_RequestParams* request_params,
+                                     const XLLM_AsyncOptions& async_options) {
+  if (nullptr != prompt.token_ids && prompt.token_size > 0) {
+    std::vector<int> token_ids(prompt.token_ids,
+                               prompt.token_ids + prompt.token_size);
+    return xllm::helper::submit_inference_request(
+        handler,
+        xllm::helper::InferenceType::LLM_COMPLETIONS,
+        model_id,
+        token_ids,
+        nullptr,
+        batch_index,
+        request_params,
+        async_options);
+  }
+  if (nullptr == prompt.text || *prompt.text == '\0') {
+    return XLLM_INVALID_REQUEST_HANDLE;
+  }
+  return xllm::helper::submit_inference_request(
+      handler,
+      xllm::helper::InferenceType::LLM_COMPLETIONS,
+      model_id,
+      prompt.text,
+      nullptr,
+      batch_index,
+      request_params,
+      async_options);
+}
+
+}  // namespace
+
+XLLM_CAPI_EXPORT XLLM_RequestHandle
+xllm_llm_completions_async(XLLM_LLM_Handler* handler,
+                           const char* model_id,
+                           const XLLM_Prompt* prompt,
+                           const XLLM_RequestParams* request_params,
+                           const XLLM_AsyncOptions* async_options) {
+  if (!handler || !model_id || *model_id == '\0' || !prompt ||
+      !async_options) {
+    return XLLM_INVALID_REQUEST_HANDLE;
+  }
+
+  return submit_completion(handler,
+                           model_id,
+                           *prompt,
+                           /*batch_index=*/0,
+                           request_params,
+                           *async_options);
+}
+
+XLLM_CAPI_EXPORT size_t
+xllm_llm_completions_batch_async(XLLM_LLM_Handler* handler,
+                                 const char* model_id,
+                                 const XLLM_Prompt* prompts,
+                                 size_t prompts_count,
+                                 const XLLM_RequestParams* request_params,
+                                 const XLLM_AsyncOptions* async_options,
+                                 XLLM_RequestHandle* handles) {
+  if (!handler || !model_id || *model_id == '\0' || !prompts ||
+      !async_options) {
+    return 0;
+  }
+
+  size_t submitted = 0;
+  XLLM_RequestParams storage;
+  for (size_t i = 0; i < prompts_count; ++i) {
+    const XLLM_RequestHandle handle = submit_completion(
+        handler,
+        model_id,
+        prompts[i],
+        static_cast<uint32_t>(i),
+        xllm::helper::batch_request_params(request_params, i, &storage),
+        *async_options);
+    if (handle != XLLM_INVALID_REQUEST_HANDLE) {
+      ++submitted;
+    }
+    if (nullptr != handles) {
+      handles[i] = handle;
+    }
+  }
+  return submitted;
+}
+
+XLLM_CAPI_EXPORT XLLM_RequestHandle
+xllm_llm_chat_completions_async(XLLM_LLM_Handler* handler,
+                                const char* model_id,
+                                const XLLM_ChatMessage* messages,
+                                size_t messages_count,
+                                const XLLM_RequestParams* request_params,
+                                const XLLM_AsyncOptions* async_options) {
+  if (!handler || !model_id || *model_id == '\0' || !messages ||
+      messages_count == 0 || !async_options) {
+    return XLLM_INVALID_REQUEST_HANDLE;
+  }
+
+  std::vector<xllm::Message> xllm_messages;
+  xllm_messages.reserve(messages_count);
+  for (size_t i = 0; i < messages_count; i++) {
+    xllm_messages.emplace_back(messages[i].role, messages[i].content);
+  }
+
+  return xllm::helper::submit_inference_request(
+      handler,
+      xllm::helper::InferenceType::LLM_CHAT_COMPLETIONS,
+      model_id,
+      xllm_messages,
+      nullptr,
+      /*batch_index=*/0,
+      request_params,
+      *async_options);
+}
+
+XLLM_CAPI_EXPORT bool xllm_llm_cancel(XLLM_LLM_Handler* handler,
+                                      XLLM_RequestHandle handle) {
+  if (!handler || handle == XLLM_INVALID_REQUEST_HANDLE) return false;
+  return handler->async_requests->cancel(handle);
+}
+
 XLLM_CAPI_EXPORT void xllm_llm_free_response(XLLM_Response* resp) {
   return xllm::helper::xllm_free_response(resp);
 }
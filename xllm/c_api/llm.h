@@ -24,6 +24,7 @@ extern "C" {
 #include <stddef.h>
 #include <stdint.h>
 
+#include "completion_queue.h"
 #include "types.h"
 
 /**
@@ -57,6 +58,9 @@ XLLM_CAPI_EXPORT XLLM_LLM_Handler* xllm_llm_create(void);
  * - Generation cache and temporary buffers
  * - Device resources (contexts, queues)
  *
+ * Asynchronous requests still in flight receive a FINISHED event with
+ * kCancelled.
+ *
  * This function is idempotent—calling with NULL has no effect.
  *
  * @param handler LLM instance handle (NULL = no operation)
@@ -200,6 +204,110 @@ XLLM_CAPI_EXPORT XLLM_Response* xllm_llm_chat_completions(
     uint32_t timeout_ms,
     const XLLM_RequestParams* request_params);
 
+/**
+ * @brief Submit a text or token-id completion without blocking
+ *
+ * Queues the prompt for generation and returns immediately. The request's
+ * events (XLLM_Event) are delivered to the queue or callback named in
+ * async_options: token deltas while generating if async_options->stream is
+ * set, then exactly one XLLM_EVENT_FINISHED event carrying the final status.
+ * No thread is held per request, so one thread can drive thousands of
+ * requests through a completion queue.
+ *
+ * Token-id prompts (prompt->token_ids) skip tokenization; with
+ * async_options->skip_detokenize the output carries token ids only, so no
+ * text round trip happens on either side.
+ *
+ * Errors detected after the handle is allocated (e.g. kNotInitialized,
+ * kModelNotFound) are reported through the FINISHED event.
+ *
+ * @param handler Valid LLM instance handle (must not be NULL)
+ * @param model_id Null-terminated string of the loaded model ID
+ * @param prompt Prompt text or token ids (must not be NULL)
+ * @param request_params Generation parameters (NULL = use defaults)
+ * @param async_options Event delivery options (must not be NULL)
+ *
+ * @return Request handle; XLLM_INVALID_REQUEST_HANDLE if an argument is
+ * invalid, in which case no event is delivered
+ * @see xllm_llm_completions_batch_async, xllm_llm_cancel,
+ * xllm_completion_queue_poll
+ */
+XLLM_CAPI_EXPORT XLLM_RequestHandle
+xllm_llm_completions_async(XLLM_LLM_Handler* handler,
+                           const char* model_id,
+                           const XLLM_Prompt* prompt,
+                           const XLLM_RequestParams* request_params,
+                           const XLLM_AsyncOptions* async_options);
+
+/**
+ * @brief Submit many completions in one call without blocking
+ *
+ * Equivalent to calling xllm_llm_completions_async() for every prompt with
+ * the same parameters. Each event carries the position of its prompt in
+ * batch_index. If request_params->request_id is set, "-<index>" is appended
+ * to it per prompt.
+ *
+ * @param handler Valid LLM instance handle (must not be NULL)
+ * @param model_id Null-terminated string of the loaded model ID
+ * @param prompts Array of prompts_count prompts
+ * @param prompts_count Number of prompts
+ * @param request_params Generation parameters (NULL = use defaults)
+ * @param async_options Event delivery options (must not be NULL)
+ * @param handles Output array receiving prompts_count handles (may be NULL)
+ *
+ * @return Number of submitted requests; a prompt that fails validation gets
+ * XLLM_INVALID_REQUEST_HANDLE and no events
+ * @see xllm_llm_completions_async
+ */
+XLLM_CAPI_EXPORT size_t
+xllm_llm_completions_batch_async(XLLM_LLM_Handler* handler,
+                                 const char* model_id,
+                                 const XLLM_Prompt* prompts,
+                                 size_t prompts_count,
+                                 const XLLM_RequestParams* request_params,
+                                 const XLLM_AsyncOptions* async_options,
+                                 XLLM_RequestHandle* handles);
+
+/**
+ * @brief Submit a chat completion without blocking
+ *
+ * Asynchronous counterpart of xllm_llm_chat_completions(); events are
+ * delivered as described for xllm_llm_completions_async().
+ *
+ * @param handler Valid LLM instance handle (must not be NULL)
+ * @param model_id Null-terminated string of the loaded model ID
+ * @param messages Array of XLLM_ChatMessage structs (conversation history)
+ * @param messages_count Number of messages in the messages array (> 0)
+ * @param request_params Generation parameters (NULL = use defaults)
+ * @param async_options Event delivery options (must not be NULL)
+ *
+ * @return Request handle; XLLM_INVALID_REQUEST_HANDLE if an argument is
+ * invalid
+ * @see xllm_llm_completions_async, xllm_llm_cancel
+ */
+XLLM_CAPI_EXPORT XLLM_RequestHandle
+xllm_llm_chat_completions_async(XLLM_LLM_Handler* handler,
+                                const char* model_id,
+                                const XLLM_ChatMessage* messages,
+                                size_t messages_count,
+                                const XLLM_RequestParams* request_params,
+                                const XLLM_AsyncOptions* async_options);
+
+/**
+ * @brief Cancel an asynchronous request
+ *
+ * The scheduler stops the request before its next step and releases its KV
+ * cache. Its FINISHED event reports kCancelled unless the request completed
+ * first.
+ *
+ * @param handler Valid LLM instance handle
+ * @param handle Handle returned by an async submission
+ * @return true if the request was in flight; false if it already finished or
+ * the handle is unknown
+ */
+XLLM_CAPI_EXPORT bool xllm_llm_cancel(XLLM_LLM_Handler* handler,
+                                      XLLM_RequestHandle handle);
+
 /**
  * @brief Free all dynamically allocated memory in an XLLM_Response
  *
@@ -212,7 +320,7 @@ XLLM_CAPI_EXPORT XLLM_Response* xllm_llm_chat_completions(
  *
  * @note Idempotent: Safe to call multiple times on the same response
  * @warning Mandatory: Must be called after using completions/chat completions
- * responses
+ * responses, and for every event response polled from a completion queue
  * @see xllm_llm_completions, xllm_llm_chat_completions
  */
 XLLM_CAPI_EXPORT void xllm_llm_free_response(XLLM_Response* resp);
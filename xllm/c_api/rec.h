@@ -20,6 +20,7 @@ extern "C" {
 #include <stddef.h>
 #include <stdint.h>
 
+#include "completion_queue.h"
 #include "types.h"
 
 /**
@@ -53,6 +54,8 @@ XLLM_CAPI_EXPORT XLLM_REC_Handler* xllm_rec_create(void);
  * - Generation cache (user behavior sequence, item candidate pool, attention
  * cache)
  * - Device resources (contexts, queues, memory pools for batch inference)
+ * Asynchronous requests still in flight receive a FINISHED event with
+ * kCancelled.
  * This function is idempotent—calling with NULL has no effect.
  * @param handler REC inference instance handle (NULL = no operation)
  * @note Mandatory: Must be called to avoid memory/device resource leaks
@@ -318,12 +321,97 @@ XLLM_CAPI_EXPORT XLLM_Response* xllm_rec_chat_completions(
     uint32_t timeout_ms,
     const XLLM_RequestParams* request_params);
 
+/**
+ * @brief Submit a generative recommendation completion without blocking
+ * Queues a text, token-id or multimodal prompt and returns immediately. Events
+ * are delivered to the queue or callback named in async_options, ending with
+ * exactly one XLLM_EVENT_FINISHED event whose response has the same layout as
+ * the synchronous REC responses (including rec_outputs).
+ * @param handler Valid REC inference instance handle (must not be NULL)
+ * @param model_id Null-terminated string of the loaded REC model ID
+ * @param prompt Prompt text or token ids (must not be NULL)
+ * @param mm_data Multimodal data applied to prompt->token_ids (NULL = none;
+ * requires token ids, see xllm_rec_multimodal_completions)
+ * @param request_params Generation parameters (NULL = use REC defaults)
+ * @param async_options Event delivery options (must not be NULL)
+ * @return Request handle; XLLM_INVALID_REQUEST_HANDLE if an argument is
+ * invalid, in which case no event is delivered
+ * @see xllm_rec_completions_batch_async, xllm_rec_cancel,
+ * xllm_completion_queue_poll
+ */
+XLLM_CAPI_EXPORT XLLM_RequestHandle
+xllm_rec_completions_async(XLLM_REC_Handler* handler,
+                           const char* model_id,
+                           const XLLM_Prompt* prompt,
+                           const XLLM_MM_Data* mm_data,
+                           const XLLM_RequestParams* request_params,
+                           const XLLM_AsyncOptions* async_options);
+
+/**
+ * @brief Submit many generative recommendation completions in one call
+ * Equivalent to calling xllm_rec_completions_async() without mm_data for
+ * every prompt. Each event carries the position of its prompt in batch_index.
+ * If request_params->request_id is set, "-<index>" is appended to it per
+ * prompt.
+ * @param handler Valid REC inference instance handle (must not be NULL)
+ * @param model_id Null-terminated string of the loaded REC model ID
+ * @param prompts Array of prompts_count prompts
+ * @param prompts_count Number of prompts
+ * @param request_params Generation parameters (NULL = use REC defaults)
+ * @param async_options Event delivery options (must not be NULL)
+ * @param handles Output array receiving prompts_count handles (may be NULL)
+ * @return Number of submitted requests; a prompt that fails validation gets
+ * XLLM_INVALID_REQUEST_HANDLE and no events
+ */
+XLLM_CAPI_EXPORT size_t
+xllm_rec_completions_batch_async(XLLM_REC_Handler* handler,
+                                 const char* model_id,
+                                 const XLLM_Prompt* prompts,
+                                 size_t prompts_count,
+                                 const XLLM_RequestParams* request_params,
+                                 const XLLM_AsyncOptions* async_options,
+                                 XLLM_RequestHandle* handles);
+
+/**
+ * @brief Submit a generative recommendation chat completion without blocking
+ * Asynchronous counterpart of xllm_rec_chat_completions(); events are
+ * delivered as described for xllm_rec_completions_async().
+ * @param handler Valid REC inference instance handle (must not be NULL)
+ * @param model_id Null-terminated string of the loaded REC model ID
+ * @param messages Array of XLLM_ChatMessage structs
+ * @param messages_count Number of messages in the messages array (> 0)
+ * @param request_params Generation parameters (NULL = use REC defaults)
+ * @param async_options Event delivery options (must not be NULL)
+ * @return Request handle; XLLM_INVALID_REQUEST_HANDLE if an argument is
+ * invalid
+ */
+XLLM_CAPI_EXPORT XLLM_RequestHandle
+xllm_rec_chat_completions_async(XLLM_REC_Handler* handler,
+                                const char* model_id,
+                                const XLLM_ChatMessage* messages,
+                                size_t messages_count,
+                                const XLLM_RequestParams* request_params,
+                                const XLLM_AsyncOptions* async_options);
+
+/**
+ * @brief Cancel an asynchronous generative recommendation request
+ * REC requests are not interrupted mid-step; their result is discarded and the
+ * FINISHED event reports kCancelled unless the request completed first.
+ * @param handler Valid REC inference instance handle
+ * @param handle Handle returned by an async submission
+ * @return true if the request was in flight; false if it already finished or
+ * the handle is unknown
+ */
+XLLM_CAPI_EXPORT bool xllm_rec_cancel(XLLM_REC_Handler* handler,
+                                      XLLM_RequestHandle handle);
+
 /**
  * @brief Free all dynamically allocated memory in a generative recommendation
  * XLLM_Response Releases all heap memory used by the REC response struct
  * @param resp Pointer to XLLM_Response to free (NULL = no operation)
  * @warning Mandatory: Must be called after using REC completions/chat
- * completions responses
+ * completions responses, and for every event response polled from a
+ * completion queue
  * @see xllm_rec_text_completions, xllm_rec_token_completions,
  * xllm_rec_chat_completions
  */
@@ -14,7 +14,7 @@ TAR_BASE_NAME="xllm"
 LOCAL_INSTALL_DIR="/usr/local"
 LOCAL_TARGET_DIR="${LOCAL_INSTALL_DIR}/xllm"
 
-HEADERS=("${SCRIPT_DIR}/../llm.h" "${SCRIPT_DIR}/../rec.h" "${SCRIPT_DIR}/../default.h" "${SCRIPT_DIR}/../types.h")
+HEADERS=("${SCRIPT_DIR}/../llm.h" "${SCRIPT_DIR}/../rec.h" "${SCRIPT_DIR}/../completion_queue.h" "${SCRIPT_DIR}/../default.h" "${SCRIPT_DIR}/../types.h")
 SO_FILES=(
     "${SCRIPT_DIR}/../../../build/xllm/core/server/libxllm.so"
 )
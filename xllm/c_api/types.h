@@ -284,7 +284,10 @@ typedef enum XLLM_CAPI_EXPORT XLLM_StatusCode {
   kInvalidRequest = 4,
 
   /** Internal system error */
-  kInternalError = 5
+  kInternalError = 5,
+
+  /** Request cancelled before it finished */
+  kCancelled = 6
 } XLLM_StatusCode;
 
 /**
@@ -429,6 +432,106 @@ typedef struct XLLM_CAPI_EXPORT XLLM_Response {
   XLLM_RecOutputs rec_outputs;
 } XLLM_Response;
 
+/**
+ * @brief Handle of an asynchronously submitted request
+ * @note Handles are unique per LLM/REC instance and never reused. 0 is
+ * XLLM_INVALID_REQUEST_HANDLE.
+ */
+typedef uint64_t XLLM_RequestHandle;
+
+#define XLLM_INVALID_REQUEST_HANDLE ((XLLM_RequestHandle)0)
+
+/**
+ * @brief Opaque queue that collects events of asynchronous requests
+ * @see completion_queue.h
+ */
+typedef struct XLLM_CompletionQueue XLLM_CompletionQueue;
+
+/**
+ * @brief Kind of an asynchronous request event
+ */
+typedef enum XLLM_CAPI_EXPORT XLLM_EventType {
+  /** Incremental output of a streaming request (new text and token ids) */
+  XLLM_EVENT_DELTA = 0,
+
+  /** Last event of a request, carrying its final status and usage */
+  XLLM_EVENT_FINISHED = 1
+} XLLM_EventType;
+
+/**
+ * @brief Event delivered for an asynchronous request
+ *
+ * Every request produces zero or more XLLM_EVENT_DELTA events (streaming
+ * requests only) followed by exactly one XLLM_EVENT_FINISHED event. Events of
+ * one request are delivered in order.
+ */
+typedef struct XLLM_CAPI_EXPORT XLLM_Event {
+  /** Handle returned when the request was submitted */
+  XLLM_RequestHandle handle;
+
+  /** Event kind */
+  XLLM_EventType type;
+
+  /** Position of the request in its batch submission (0 for single ones) */
+  uint32_t batch_index;
+
+  /** Opaque pointer passed in XLLM_AsyncOptions::user_data */
+  void* user_data;
+
+  /**
+   * Output of the event. For DELTA events choices hold only the new text and
+   * token ids; for FINISHED events response->status_code is the request
+   * status. Ownership is described in XLLM_AsyncOptions.
+   */
+  XLLM_Response* response;
+} XLLM_Event;
+
+/**
+ * @brief Callback receiving asynchronous request events
+ * @note Runs on an xLLM response thread and must not block. The event and its
+ * response are only valid during the call.
+ */
+typedef void (*XLLM_EventCallback)(const XLLM_Event* event);
+
+/**
+ * @brief Delivery options of an asynchronous request
+ * @note Exactly one of queue and callback must be set.
+ */
+typedef struct XLLM_CAPI_EXPORT XLLM_AsyncOptions {
+  /** Deliver XLLM_EVENT_DELTA events as tokens are generated */
+  bool stream;
+
+  /** Return token ids only; the output text is not detokenized */
+  bool skip_detokenize;
+
+  /**
+   * Queue receiving the events. The caller owns each polled event response
+   * and frees it with xllm_llm_free_response()/xllm_rec_free_response().
+   */
+  XLLM_CompletionQueue* queue;
+
+  /** Callback receiving the events; responses are freed after it returns */
+  XLLM_EventCallback callback;
+
+  /** Opaque pointer copied into every event of the request */
+  void* user_data;
+} XLLM_AsyncOptions;
+
+/**
+ * @brief Prompt of an asynchronous completion, as text or as token ids
+ * @note If token_ids is set the prompt is not tokenized and text is ignored.
+ */
+typedef struct XLLM_CAPI_EXPORT XLLM_Prompt {
+  /** Null-terminated prompt text */
+  const char* text;
+
+  /** Prompt token ids (NULL = use text) */
+  const int32_t* token_ids;
+
+  /** Number of entries in token_ids */
+  size_t token_size;
+} XLLM_Prompt;
+
 /**
  * @brief Enumeration of tensor data types
  */
@@ -97,6 +97,16 @@ DECLARE_int32(speculative_suffix_max_cached_requests);
 
 DECLARE_bool(speculative_suffix_use_tree_spec);
 
+DECLARE_int32(speculative_suffix_num_threads);
+
+DECLARE_string(speculative_suffix_corpus_path);
+
+DECLARE_int32(speculative_suffix_snapshot_interval_s);
+
+DECLARE_int32(speculative_ngram_min);
+
+DECLARE_int32(speculative_ngram_max);
+
 DECLARE_int32(num_request_handling_threads);
 
 DECLARE_int32(num_response_handling_threads);
@@ -157,6 +167,10 @@ DECLARE_bool(enable_graph_double_buffer);
 
 DECLARE_bool(enable_graph_mode_decode_no_padding);
 
+DECLARE_bool(enable_adaptive_decode_graph_buckets);
+
+DECLARE_int32(adaptive_decode_graph_bucket_budget);
+
 DECLARE_bool(enable_prefill_piecewise_graph);
 
 DECLARE_bool(enable_graph_vmm_pool);
@@ -192,6 +206,10 @@ DECLARE_int32(node_rank);
 
 DECLARE_int32(max_concurrent_requests);
 
+DECLARE_int32(tenant_max_concurrent_requests);
+
+DECLARE_int32(tenant_max_prompt_tokens_per_second);
+
 DECLARE_bool(enable_schedule_overlap);
 
 DECLARE_double(prefill_scheduling_memory_usage_threshold);
@@ -210,6 +228,10 @@ DECLARE_bool(enable_service_routing);
 
 DECLARE_double(heart_beat_interval);
 
+DECLARE_bool(enable_kv_cache_summary);
+
+DECLARE_int32(kv_cache_summary_num_counters);
+
 DECLARE_int32(etcd_ttl);
 
 DECLARE_int32(rpc_channel_timeout_ms);
@@ -222,10 +244,16 @@ DECLARE_int32(max_decode_token_per_sequence);
 
 DECLARE_string(priority_strategy);
 
+DECLARE_string(tenant_weights);
+
+DECLARE_bool(enable_slo_admission);
+
 DECLARE_bool(enable_mix_batch);
 
 DECLARE_bool(enable_online_preempt_offline);
 
+DECLARE_bool(enable_swap_preemption);
+
 // --- mix scheduler config ---
 DECLARE_double(aggressive_coeff);
 
@@ -252,14 +280,28 @@ DECLARE_string(store_metadata_server);
 
 DECLARE_string(store_local_hostname);
 
+DECLARE_uint32(store_local_capacity_gb);
+
+DECLARE_double(store_local_bandwidth_gbps);
+
+DECLARE_uint32(store_local_latency_us);
+
 DECLARE_bool(enable_control_h2d_block_num);
 
+DECLARE_string(kv_cache_disk_path);
+
+DECLARE_uint32(kv_cache_disk_capacity_gb);
+
+DECLARE_string(kv_cache_tier_codec);
+
 DECLARE_bool(enable_profile_step_time);
 
 DECLARE_bool(enable_profile_token_budget);
 
 DECLARE_bool(enable_latency_aware_schedule);
 
+DECLARE_bool(enable_adaptive_prefill_chunk);
+
 DECLARE_int32(profile_max_prompt_length);
 
 DECLARE_bool(enable_profile_kv_blocks);
@@ -274,6 +316,10 @@ DECLARE_string(profile_backend);
 
 DECLARE_string(profile_dir);
 
+DECLARE_bool(enable_flight_recorder);
+
+DECLARE_int32(flight_recorder_capacity);
+
 DECLARE_int32(max_global_ttft_ms);
 
 DECLARE_int32(max_global_tpot_ms);
@@ -284,6 +330,8 @@ DECLARE_bool(enable_xtensor);
 
 DECLARE_int64(phy_page_granularity_size);
 
+DECLARE_bool(enable_contiguous_block_allocation);
+
 // --- load config ---
 DECLARE_bool(enable_manual_loader);
 
@@ -320,6 +368,10 @@ DECLARE_int32(request_queue_size);
 
 DECLARE_uint32(rec_worker_max_concurrency);
 
+DECLARE_int32(rec_vocab_reload_interval_s);
+
+DECLARE_bool(enable_rec_device_constraint_mask);
+
 // --- qwen3 reranker config ---
 DECLARE_bool(enable_qwen3_reranker);
 
@@ -388,10 +440,22 @@ DECLARE_string(dit_sparse_attention_version);
 
 DECLARE_int64(dit_sparse_attention_mask_refresh_steps);
 
+DECLARE_bool(dit_step_batching);
+
+DECLARE_int64(dit_text_embedding_cache_size);
+
 DECLARE_bool(dit_laser_attention_enabled);
 
 DECLARE_bool(use_audio_in_video);
 
+DECLARE_int64(image_decode_max_pixels);
+
+DECLARE_double(video_decode_fps);
+
+DECLARE_int64(video_decode_max_pixels);
+
+DECLARE_int32(video_decode_threads);
+
 // --- kernel config ---
 #if defined(USE_NPU)
 DECLARE_bool(enable_customize_mla_kernel);
@@ -428,6 +492,10 @@ DECLARE_int32(health_check_interval_ms);
 
 DECLARE_bool(enable_json_object_output);
 
+DECLARE_int64(embedding_result_cache_size);
+
+DECLARE_bool(enable_offline_batch_mode);
+
 // --- verbose trace logging config ---
 DECLARE_bool(enable_verbose_trace_log);
 
@@ -73,6 +73,10 @@ DEFINE_COUNTER(detokenization_latency_seconds_non_stream,
 // executor metrics
 DEFINE_COUNTER(num_model_execution_total_eager,
                "Total number of model execution");
+DEFINE_COUNTER(decode_graph_token_rows_total,
+               "Total number of token rows of decode graph steps");
+DEFINE_COUNTER(decode_graph_padded_token_rows_total,
+               "Total number of padding token rows of decode graph steps");
 
 DEFINE_COUNTER(mooncake_transfer_completed_total_read,
                "Total number of completed MoonCake READ transfers");
@@ -89,6 +93,15 @@ DEFINE_HISTOGRAM(mooncake_transfer_latency_microseconds_read,
 DEFINE_HISTOGRAM(mooncake_transfer_latency_microseconds_write,
                  "MoonCake WRITE transfer latency in microseconds");
 
+DEFINE_COUNTER(kv_block_codec_raw_bytes_total,
+               "Total raw KV block bytes encoded for the storage tiers");
+DEFINE_COUNTER(kv_block_codec_encoded_bytes_total,
+               "Total encoded KV block bytes written to the storage tiers");
+DEFINE_COUNTER(kv_block_codec_latency_seconds_encode,
+               "Latency of encoding KV blocks in seconds");
+DEFINE_COUNTER(kv_block_codec_latency_seconds_decode,
+               "Latency of decoding KV blocks in seconds");
+
 // worker metrics
 DEFINE_COUNTER(execution_latency_seconds_model,
                "Latency of model execution in seconds");
@@ -97,6 +110,18 @@ DEFINE_COUNTER(execution_latency_seconds_logits_processing,
 DEFINE_COUNTER(execution_latency_seconds_sampling,
                "Latency of sampling in seconds");
 
+DEFINE_COUNTER(dit_text_embedding_cache_hits_total,
+               "DiT text encoder embedding cache hit count");
+DEFINE_COUNTER(dit_text_embedding_cache_misses_total,
+               "DiT text encoder embedding cache miss count");
+
+DEFINE_COUNTER(embedding_result_cache_hits_total,
+               "Embedding result cache hit count");
+DEFINE_COUNTER(embedding_result_cache_misses_total,
+               "Embedding result cache miss count");
+DEFINE_COUNTER(embedding_result_cache_evictions_total,
+               "Embedding result cache eviction count");
+
 DEFINE_COUNTER(json_object_mask_cache_hits_total,
                "JSON object mask cache hit count");
 DEFINE_COUNTER(json_object_mask_cache_misses_total,
@@ -145,6 +170,11 @@ DEFINE_GAUGE(num_online_prefill_preempt_offline_requests,
              "Number of online prefill preempt offline requests in scheduler");
 DEFINE_GAUGE(num_online_decode_preempt_offline_requests,
              "Number of online decode preempt offline requests in scheduler");
+DEFINE_COUNTER(preempted_sequences_total_swap,
+               "Total number of preempted sequences whose KV cache was "
+               "swapped out to host");
+DEFINE_COUNTER(preempted_sequences_total_recompute,
+               "Total number of preempted sequences left to recompute");
 
 DEFINE_GAUGE(num_running_sequences, "Number of running sequences");
 
@@ -194,6 +224,10 @@ DEFINE_COUNTER(server_request_total_ok,
                "Total number of ok request that server processed");
 DEFINE_COUNTER(server_request_total_limit,
                "Total number of limit request that server processed");
+DEFINE_COUNTER(server_request_total_tenant_limit,
+               "Total number of request rejected by per-tenant limits");
+DEFINE_COUNTER(server_request_total_slo_reject,
+               "Total number of request rejected for a predicted SLO miss");
 DEFINE_COUNTER(server_request_total_fail,
                "Total number of fail request that server processed");
 
@@ -160,6 +160,10 @@ DECLARE_HISTOGRAM(prefix_cache_block_matched_num);
 // total number of model execution operations
 DECLARE_COUNTER(num_model_execution_total_eager);
 
+// decode graph padding, as token rows of pure decode steps
+DECLARE_COUNTER(decode_graph_token_rows_total);
+DECLARE_COUNTER(decode_graph_padded_token_rows_total);
+
 // MoonCake KV transfer metrics
 DECLARE_COUNTER(mooncake_transfer_completed_total_read);
 DECLARE_COUNTER(mooncake_transfer_completed_total_write);
@@ -168,12 +172,25 @@ DECLARE_COUNTER(mooncake_transfer_bytes_total_write);
 DECLARE_COUNTER(mooncake_transfer_failed_total);
 DECLARE_HISTOGRAM(mooncake_transfer_latency_microseconds_read);
 DECLARE_HISTOGRAM(mooncake_transfer_latency_microseconds_write);
+DECLARE_COUNTER(kv_block_codec_raw_bytes_total);
+DECLARE_COUNTER(kv_block_codec_encoded_bytes_total);
+DECLARE_COUNTER(kv_block_codec_latency_seconds_encode);
+DECLARE_COUNTER(kv_block_codec_latency_seconds_decode);
 
 // latency of worker execution operations in seconds
 DECLARE_COUNTER(execution_latency_seconds_model);
 DECLARE_COUNTER(execution_latency_seconds_logits_processing);
 DECLARE_COUNTER(execution_latency_seconds_sampling);
 
+// DiT text encoder embedding cache metrics.
+DECLARE_COUNTER(dit_text_embedding_cache_hits_total);
+DECLARE_COUNTER(dit_text_embedding_cache_misses_total);
+
+// Embedding result cache metrics.
+DECLARE_COUNTER(embedding_result_cache_hits_total);
+DECLARE_COUNTER(embedding_result_cache_misses_total);
+DECLARE_COUNTER(embedding_result_cache_evictions_total);
+
 // JSON object constrained-decoding mask metrics.
 DECLARE_COUNTER(json_object_mask_cache_hits_total);
 DECLARE_COUNTER(json_object_mask_cache_misses_total);
@@ -200,6 +217,8 @@ DECLARE_GAUGE(num_offline_decode_preempt_offline_requests);
 DECLARE_GAUGE(num_online_decode_preempt_online_requests);
 DECLARE_GAUGE(num_online_prefill_preempt_offline_requests);
 DECLARE_GAUGE(num_online_decode_preempt_offline_requests);
+DECLARE_COUNTER(preempted_sequences_total_swap);
+DECLARE_COUNTER(preempted_sequences_total_recompute);
 DECLARE_GAUGE(num_running_sequences);
 DECLARE_GAUGE(kv_cache_utilization_perc);
 DECLARE_GAUGE(num_blocks_in_prefix_cache);
@@ -228,6 +247,8 @@ DECLARE_HISTOGRAM(end_2_end_latency_milliseconds);
 DECLARE_COUNTER(server_request_in_total);
 DECLARE_COUNTER(server_request_total_ok);
 DECLARE_COUNTER(server_request_total_limit);
+DECLARE_COUNTER(server_request_total_tenant_limit);
+DECLARE_COUNTER(server_request_total_slo_reject);
 DECLARE_COUNTER(server_request_total_fail);
 
 DECLARE_GAUGE(num_concurrent_requests);
@@ -48,6 +48,14 @@ std::string Options::to_string() const {
      << speculative_suffix_max_cached_requests()
      << ", speculative_suffix_use_tree_spec: "
      << speculative_suffix_use_tree_spec()
+     << ", speculative_suffix_num_threads: "
+     << speculative_suffix_num_threads()
+     << ", speculative_suffix_corpus_path: "
+     << speculative_suffix_corpus_path()
+     << ", speculative_suffix_snapshot_interval_s: "
+     << speculative_suffix_snapshot_interval_s()
+     << ", speculative_ngram_min: " << speculative_ngram_min()
+     << ", speculative_ngram_max: " << speculative_ngram_max()
      << ", enable_mtp_draft_body_tp1: " << enable_mtp_draft_body_tp1()
      << ", enable_adaptive_speculative_decode: "
      << enable_adaptive_speculative_decode()
@@ -83,6 +91,12 @@ std::string Options::to_string() const {
      << ", store_master_server_address: " << store_master_server_address()
      << ", store_metadata_server: " << store_metadata_server()
      << ", store_local_hostname: " << store_local_hostname()
+     << ", store_local_capacity_gb: " << store_local_capacity_gb()
+     << ", store_local_bandwidth_gbps: " << store_local_bandwidth_gbps()
+     << ", store_local_latency_us: " << store_local_latency_us()
+     << ", kv_cache_disk_path: " << kv_cache_disk_path()
+     << ", kv_cache_disk_capacity_gb: " << kv_cache_disk_capacity_gb()
+     << ", kv_cache_tier_codec: " << kv_cache_tier_codec()
      << ", enable_multi_stream_parallel: " << enable_multi_stream_parallel()
      << ", disable_ttft_profiling: " << disable_ttft_profiling()
      << ", enable_forward_interruption: " << enable_forward_interruption()
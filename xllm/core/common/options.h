@@ -94,6 +94,16 @@ class Options {
 
   PROPERTY(bool, speculative_suffix_use_tree_spec) = false;
 
+  PROPERTY(int32_t, speculative_suffix_num_threads) = 4;
+
+  PROPERTY(std::string, speculative_suffix_corpus_path);
+
+  PROPERTY(int32_t, speculative_suffix_snapshot_interval_s) = 0;
+
+  PROPERTY(int32_t, speculative_ngram_min) = 1;
+
+  PROPERTY(int32_t, speculative_ngram_max) = 4;
+
   PROPERTY(bool, enable_mtp_draft_body_tp1) = false;
   PROPERTY(bool, enable_adaptive_speculative_decode) = false;
 
@@ -183,6 +193,8 @@ class Options {
 
   PROPERTY(bool, enable_online_preempt_offline) = true;
 
+  PROPERTY(bool, enable_swap_preemption) = false;
+
   PROPERTY(double, host_blocks_factor) = 0.0;
 
   PROPERTY(bool, enable_kvcache_store) = false;
@@ -195,6 +207,18 @@ class Options {
 
   PROPERTY(std::string, store_local_hostname) = "";
 
+  PROPERTY(uint32_t, store_local_capacity_gb) = 64;
+
+  PROPERTY(double, store_local_bandwidth_gbps) = 0.0;
+
+  PROPERTY(uint32_t, store_local_latency_us) = 0;
+
+  PROPERTY(std::string, kv_cache_disk_path) = "";
+
+  PROPERTY(uint32_t, kv_cache_disk_capacity_gb) = 64;
+
+  PROPERTY(std::string, kv_cache_tier_codec) = "none";
+
   PROPERTY(bool, enable_multi_stream_parallel) = false;
 
   PROPERTY(bool, enable_profile_step_time) = false;
@@ -0,0 +1,118 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tenant_limiter.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "common/metrics.h"
+#include "core/framework/config/service_config.h"
+
+namespace xllm {
+namespace {
+
+// idle tenants are swept once the map grows past this size.
+constexpr size_t kMaxIdleTenants = 4096;
+
+}  // namespace
+
+void TenantLimiter::refill(TenantState& state,
+                           double tokens_per_second,
+                           Clock::time_point now) {
+  if (tokens_per_second > 0 && now > state.last_refill) {
+    const double elapsed =
+        std::chrono::duration<double>(now - state.last_refill).count();
+    state.tokens = std::min(tokens_per_second,
+                            state.tokens + elapsed * tokens_per_second);
+  }
+  state.last_refill = std::max(state.last_refill, now);
+}
+
+bool TenantLimiter::is_idle(TenantState& state,
+                            double tokens_per_second,
+                            Clock::time_point now) {
+  refill(state, tokens_per_second, now);
+  return state.num_concurrent_requests <= 0 &&
+         (tokens_per_second <= 0 || state.tokens >= tokens_per_second);
+}
+
+bool TenantLimiter::is_limited(const std::string& tenant,
+                               int64_t num_prompt_tokens,
+                               Clock::time_point now) {
+  if (tenant.empty()) {
+    return false;
+  }
+  const auto& config = ::xllm::ServiceConfig::get_instance();
+  const int32_t max_requests = config.tenant_max_concurrent_requests();
+  const double tokens_per_second = config.tenant_max_prompt_tokens_per_second();
+  if (max_requests <= 0 && tokens_per_second <= 0) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (tenants_.size() > kMaxIdleTenants) {
+    for (auto it = tenants_.begin(); it != tenants_.end();) {
+      it = is_idle(it->second, tokens_per_second, now) ? tenants_.erase(it)
+                                                       : std::next(it);
+    }
+  }
+  auto [it, inserted] = tenants_.try_emplace(tenant);
+  TenantState& state = it->second;
+  if (inserted) {
+    state.tokens = tokens_per_second;
+    state.last_refill = now;
+  }
+  refill(state, tokens_per_second, now);
+
+  if ((max_requests > 0 && state.num_concurrent_requests >= max_requests) ||
+      (tokens_per_second > 0 && state.tokens <= 0)) {
+    COUNTER_INC(server_request_total_tenant_limit);
+    return true;
+  }
+  ++state.num_concurrent_requests;
+  if (tokens_per_second > 0) {
+    state.tokens -= num_prompt_tokens;
+  }
+  return false;
+}
+
+void TenantLimiter::release(const std::string& tenant) {
+  if (tenant.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tenants_.find(tenant);
+  if (it == tenants_.end()) {
+    return;
+  }
+  --it->second.num_concurrent_requests;
+  // a tenant with nothing in flight and a full bucket has no state to keep.
+  const double tokens_per_second =
+      ::xllm::ServiceConfig::get_instance()
+          .tenant_max_prompt_tokens_per_second();
+  if (is_idle(it->second, tokens_per_second, Clock::now())) {
+    tenants_.erase(it);
+  }
+}
+
+int32_t TenantLimiter::get_num_concurrent_requests(
+    const std::string& tenant) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tenants_.find(tenant);
+  return it == tenants_.end() ? 0 : it->second.num_concurrent_requests;
+}
+
+}  // namespace xllm
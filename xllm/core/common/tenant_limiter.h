@@ -0,0 +1,73 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace xllm {
+
+// Per-tenant admission on top of the global RateLimiter: a concurrent
+// request cap and a token bucket of prompt tokens per second, both read from
+// ServiceConfig. Requests without a tenant are never limited here.
+class TenantLimiter final {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  TenantLimiter() = default;
+
+  ~TenantLimiter() = default;
+
+  // Returns true if `tenant` is over one of its budgets. Otherwise takes a
+  // concurrency slot and charges `num_prompt_tokens`; the caller must call
+  // release() once the request is done.
+  bool is_limited(const std::string& tenant, int64_t num_prompt_tokens) {
+    return is_limited(tenant, num_prompt_tokens, Clock::now());
+  }
+  bool is_limited(const std::string& tenant,
+                  int64_t num_prompt_tokens,
+                  Clock::time_point now);
+
+  void release(const std::string& tenant);
+
+  int32_t get_num_concurrent_requests(const std::string& tenant) const;
+
+ private:
+  struct TenantState {
+    int32_t num_concurrent_requests = 0;
+    // may go negative: a prompt larger than the burst is admitted once the
+    // bucket is positive and paid back by later refills.
+    double tokens = 0.0;
+    Clock::time_point last_refill;
+  };
+
+  static void refill(TenantState& state,
+                     double tokens_per_second,
+                     Clock::time_point now);
+
+  // Refills `state` and returns whether it equals a fresh entry.
+  static bool is_idle(TenantState& state,
+                      double tokens_per_second,
+                      Clock::time_point now);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, TenantState> tenants_;
+};
+
+}  // namespace xllm
@@ -19,6 +19,7 @@ limitations under the License.
 
 #include "comm_channel.h"
 #include "common/health_check_manager.h"
+#include "core/framework/config/execution_config.h"
 #include "core/framework/config/service_config.h"
 #include "distributed_runtime/collective_service.h"
 #include "framework/parallel_state/parallel_args.h"
@@ -261,6 +262,15 @@ void DistManager::setup_multi_node_workers(
 #else
     bool use_spawn_worker = options.enable_offline_inference() && i > 0;
 #endif
+    // decode graph buckets tuned by the scheduler only reach executors in
+    // this process.
+    auto& execution_config = ::xllm::ExecutionConfig::get_instance();
+    if (use_spawn_worker &&
+        execution_config.enable_adaptive_decode_graph_buckets()) {
+      LOG(WARNING) << "Adaptive decode graph buckets are not supported with "
+                      "spawned worker processes; disabling them.";
+      execution_config.enable_adaptive_decode_graph_buckets(false);
+    }
     ParallelArgs parallel_args(
         rank, world_size, dp_size, cp_size, nullptr, ep_size);
 
@@ -28,6 +28,7 @@ limitations under the License.
 
 #include "api_service/call.h"
 #include "common/metrics.h"
+#include "core/framework/config/dit_config.h"
 #include "core/platform/device_name_utils.h"
 #include "dit_engine.h"
 #include "framework/request/dit_request.h"
@@ -45,7 +46,9 @@ DiTMaster::DiTMaster(const Options& options)
 
   DiTScheduler::Options scheduler_options;
   scheduler_options.max_request_per_batch(options.max_requests_per_batch())
-      .disable_log_stats(options.disable_log_stats());
+      .disable_log_stats(options.disable_log_stats())
+      .enable_step_batching(
+          ::xllm::DiTConfig::get_instance().dit_step_batching());
 
   scheduler_ = create_dit_scheduler(engine_.get(), scheduler_options);
   LOG(INFO) << "created dit scheduler in DiTMaster.";
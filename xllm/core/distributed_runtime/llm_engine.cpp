@@ -58,6 +58,7 @@ limitations under the License.
 #include "runtime/worker.h"
 #include "server/xllm_server_registry.h"
 #include "util/env_var.h"
+#include "util/flight_recorder.h"
 #include "util/pretty_print.h"
 #include "util/tensor_helper.h"
 #include "util/utils.h"
@@ -629,6 +630,10 @@ bool LLMEngine::allocate_kv_cache(const KVCacheCapacity& kv_cache_cap) {
   // Logical block_size *= kv_split_size.
   const int32_t kv_split_size_eff =
       ::xllm::ParallelConfig::get_instance().kv_split_size_effective();
+  // the pool only needs to know whether a storage tier sits behind the Host
+  // cache; Mooncake and the local disk tier share the prefetch path.
+  const bool enable_storage_tier =
+      options_.enable_kvcache_store() || !options_.kv_cache_disk_path().empty();
   BlockManagerPool::Options options;
   options.num_blocks(kv_cache_cap.n_blocks())
       .block_size(kv_split_size_eff > 1 ? block_size * kv_split_size_eff
@@ -639,7 +644,7 @@ bool LLMEngine::allocate_kv_cache(const KVCacheCapacity& kv_cache_cap) {
                                ? false
                                : options_.enable_prefix_cache())
       .enable_disagg_pd(options_.enable_disagg_pd())
-      .enable_kvcache_store(options_.enable_kvcache_store())
+      .enable_kvcache_store(enable_storage_tier)
       .enable_xtensor(kv_cache_config.enable_xtensor())
       .num_layers(args_.n_layers())
       .slot_size(kv_cache_cap.slot_size())
@@ -698,7 +703,7 @@ bool LLMEngine::allocate_kv_cache(const KVCacheCapacity& kv_cache_cap) {
         .compress_ratios(std::move(manager_compress_ratios));
   }
 
-  if (options_.enable_kvcache_store()) {
+  if (enable_storage_tier) {
     CHECK_GT(options_.host_blocks_factor(), 1.0)
         << "KV cache Store requires Host cache blocks.";
   }
@@ -1084,11 +1089,19 @@ ForwardOutput LLMEngine::step(std::vector<Batch>& batch) {
     return {};
   }
   Timer timer;
+  FlightRecorderSpan step_span("engine.step");
   DCHECK(dp_size_ == batch.size())
       << "Split DP batch failed with dp_size as " << dp_size_
       << " and actual batch size as " << batch.size() << ".";
 
+  FlightRecorder& recorder = FlightRecorder::get_instance();
+  const int64_t prepare_begin_us =
+      recorder.enabled() ? FlightRecorder::now_us() : 0;
   auto forward_inputs = prepare_inputs(batch);
+  const int64_t forward_begin_us =
+      recorder.enabled() ? FlightRecorder::now_us() : 0;
+  recorder.record_span(
+      "engine.prepare_inputs", prepare_begin_us, forward_begin_us);
   const bool is_graph_warmup = contains_graph_warmup(forward_inputs);
   int64_t dispatched_activation_token = -1;
   if (::xllm::EPLBConfig::get_instance().enable_eplb()) {
@@ -1120,6 +1133,13 @@ ForwardOutput LLMEngine::step(std::vector<Batch>& batch) {
 
   // wait for the all future to complete
   auto results = folly::collectAll(futures).get();
+  if (recorder.enabled()) {
+    recorder.record_span(
+        "engine.forward",
+        forward_begin_us,
+        FlightRecorder::now_us(),
+        {{"workers", static_cast<int64_t>(worker_clients_num_)}});
+  }
 
   DCHECK_EQ(dp_size_, worker_clients_num_ / dp_local_size_);
   // Every worker must have produced a value before EPLB consumes all results
@@ -19,6 +19,7 @@ limitations under the License.
 #include <glog/logging.h>
 #include <pybind11/pybind11.h>
 
+#include <algorithm>
 #include <atomic>
 #include <boost/algorithm/string.hpp>
 #include <csignal>
@@ -29,19 +30,23 @@ limitations under the License.
 
 #include "api_service/call.h"
 #include "common/metrics.h"
+#include "core/framework/config/kv_cache_config.h"
 #include "core/framework/config/model_config.h"
 #include "core/framework/config/service_config.h"
+#include "core/framework/config/speculative_config.h"
 #include "core/framework/sampling/json_object_grammar.h"
 #include "core/platform/device_name_utils.h"
 #include "framework/model/model_args.h"
 #include "framework/request/request.h"
 #include "models/model_registry.h"
 #include "runtime/xservice_client.h"
+#include "scheduler/offline_batch_order.h"
 #include "scheduler/scheduler_factory.h"
 #include "server/xllm_server_registry.h"
 #include "speculative_engine.h"
 #include "util/net.h"
 #include "util/scope_guard.h"
+#include "util/threadpool.h"
 #include "util/timer.h"
 #include "util/utils.h"
 
@@ -50,7 +55,8 @@ namespace {
 
 bool should_use_ssm_engine(const Options& options) {
   return !options.draft_model_path().value_or("").empty() ||
-         (options.speculative_algorithm() == "Suffix" &&
+         (SpeculativeConfig::is_model_free_algorithm(
+              options.speculative_algorithm()) &&
           options.num_speculative_tokens() > 0);
 }
 
@@ -133,6 +139,7 @@ LLMMaster::LLMMaster(const Options& options)
       .disable_log_stats(options_.disable_log_stats())
       .priority_strategy(options_.priority_strategy())
       .enable_online_preempt_offline(options_.enable_online_preempt_offline())
+      .enable_swap_preemption(options_.enable_swap_preemption())
       .enable_profile_step_time(options_.enable_profile_step_time())
       .enable_profile_token_budget(options_.enable_profile_token_budget())
       .enable_latency_aware_schedule(options_.enable_latency_aware_schedule())
@@ -161,6 +168,20 @@ LLMMaster::LLMMaster(const Options& options)
       /*num_threads=*/options_.num_request_handling_threads(),
       /*cpu_binding=*/false,
       /*pool_name=*/"LLMMaster.request");
+
+  const int64_t embedding_cache_size =
+      ServiceConfig::get_instance().embedding_result_cache_size();
+  if (embedding_cache_size > 0) {
+    if (options_.enable_service_routing()) {
+      // routed outputs go back through the xllm service instead of the
+      // request callback, so results can't be recorded or replayed here.
+      LOG(WARNING) << "embedding_result_cache_size is ignored with service "
+                   << "routing enabled.";
+    } else {
+      embedding_result_cache_ = std::make_unique<EmbeddingResultCache>(
+          embedding_cache_size * 1024 * 1024);
+    }
+  }
 }
 
 LLMMaster::~LLMMaster() {
@@ -178,6 +199,12 @@ void LLMMaster::handle_batch_request(std::vector<std::string> prompts,
   CHECK(prompts.size() == sps.size() || sps.size() == 1)
       << "Number of prompts and sampling parameters should be the same";
 
+  if (ServiceConfig::get_instance().enable_offline_batch_mode()) {
+    handle_offline_batch_request(
+        std::move(prompts), std::move(sps), std::move(callback));
+    return;
+  }
+
   const size_t num_requests = prompts.size();
   for (size_t i = 0; i < num_requests; ++i) {
     handle_request(std::move(prompts[i]),
@@ -213,6 +240,70 @@ void LLMMaster::handle_batch_request(
   }
 }
 
+void LLMMaster::handle_offline_batch_request(std::vector<std::string> prompts,
+                                             std::vector<RequestParams> sps,
+                                             BatchOutputCallback callback) {
+  const size_t num_requests = prompts.size();
+  const auto params_of = [&sps](size_t i) -> const RequestParams& {
+    return sps.size() == 1 ? sps[0] : sps[i];
+  };
+
+  // tokenize all prompts up front, split evenly across the request threads.
+  // A prompt that fails to encode keeps no tokens and is encoded again, and
+  // reported, by generate_request().
+  std::vector<std::vector<int32_t>> prompt_tokens(num_requests);
+  std::vector<uint8_t> encoded(num_requests, 0);
+  const size_t num_tasks =
+      std::max<size_t>(std::min(threadpool_->size(), num_requests), 1);
+  TaskGroup tokenize_group(static_cast<int32_t>(num_tasks));
+  for (size_t task = 0; task < num_tasks; ++task) {
+    threadpool_->schedule(tokenize_group.wrap([&, task] {
+      for (size_t i = task; i < num_requests; i += num_tasks) {
+        encoded[i] = tokenizer_->encode(
+            prompts[i], &prompt_tokens[i], params_of(i).add_special_tokens);
+      }
+    }));
+  }
+  tokenize_group.wait();
+
+  std::vector<size_t> expected_lengths(num_requests);
+  for (size_t i = 0; i < num_requests; ++i) {
+    expected_lengths[i] = prompt_tokens[i].size() + params_of(i).max_tokens;
+  }
+  const std::vector<size_t> order =
+      prefix_sorted_order(prompt_tokens,
+                          expected_lengths,
+                          KVCacheConfig::get_instance().block_size());
+
+  // every request goes through the same worker, so the scheduler receives
+  // them in the sorted order. Outputs come back as they finish, tagged with
+  // the index of their prompt.
+  for (const size_t i : order) {
+    std::optional<std::vector<int>> tokens;
+    if (encoded[i]) {
+      tokens = std::move(prompt_tokens[i]);
+    }
+    scheduler_->incr_pending_requests(1);
+    threadpool_->schedule_with_tid(
+        [this,
+         prompt = std::move(prompts[i]),
+         tokens = std::move(tokens),
+         sp = params_of(i),
+         i,
+         callback]() mutable {
+          process_request(std::move(prompt),
+                          std::move(tokens),
+                          std::move(sp),
+                          std::nullopt,
+                          [i, callback](const RequestOutput& output) {
+                            output.log_request_status();
+                            return callback(i, output);
+                          });
+        },
+        /*tid=*/0);
+  }
+}
+
 void LLMMaster::handle_request(std::string prompt,
                                std::optional<std::vector<int>> prompt_tokens,
                                RequestParams sp,
@@ -226,37 +317,57 @@ void LLMMaster::handle_request(std::string prompt,
                          sp = std::move(sp),
                          callback = std::move(callback),
                          call]() mutable {
-    AUTO_COUNTER(request_handling_latency_seconds_completion);
+    process_request(std::move(prompt),
+                    std::move(prompt_token),
+                    std::move(sp),
+                    call,
+                    std::move(callback));
+  });
+}
 
-    // remove the pending request after scheduling
-    SCOPE_GUARD([this] { scheduler_->decr_pending_requests(); });
+void LLMMaster::process_request(std::string prompt,
+                                std::optional<std::vector<int>> prompt_tokens,
+                                RequestParams sp,
+                                std::optional<Call*> call,
+                                OutputCallback callback) {
+  AUTO_COUNTER(request_handling_latency_seconds_completion);
 
-    // Guard the rate-limit slot acquired at the service entry. If we bail
-    // before generate_request has a chance to create the Request, this
-    // releases the slot; otherwise Request itself takes ownership.
-    xllm::ScopeGuard rate_limit_guard(
-        [this] { get_rate_limiter()->decrease_one_request(); });
+  // remove the pending request after scheduling
+  SCOPE_GUARD([this] { scheduler_->decr_pending_requests(); });
 
-    Timer timer;
-    // verify the prompt
-    if (!sp.verify_params(callback)) {
-      return;
-    }
+  // Guard the rate-limit slot acquired at the service entry. If we bail
+  // before generate_request has a chance to create the Request, this
+  // releases the slot; otherwise Request itself takes ownership.
+  xllm::ScopeGuard rate_limit_guard(
+      [this] { get_rate_limiter()->decrease_one_request(); });
 
-    rate_limit_guard.dismiss();
-    auto request = generate_request(
-        std::move(prompt), std::move(prompt_token), sp, call, callback);
-    if (!request) {
-      return;
-    }
+  Timer timer;
+  // verify the prompt
+  if (!sp.verify_params(callback)) {
+    return;
+  }
 
-    if (!scheduler_->add_request(request)) {
-      CALLBACK_WITH_ERROR(StatusCode::RESOURCE_EXHAUSTED,
-                          "No available resources to schedule request",
-                          sp.service_request_id,
-                          sp.source_xservice_addr);
-    }
-  });
+  rate_limit_guard.dismiss();
+  auto request = generate_request(
+      std::move(prompt), std::move(prompt_tokens), sp, call, callback);
+  if (!request) {
+    return;
+  }
+
+  // a cache hit never takes a batch slot; dropping the request releases
+  // its rate-limit slot.
+  if (embedding_result_cache_ != nullptr &&
+      (sp.is_embeddings || sp.is_logprob_rerank) && sp.use_embedding_cache &&
+      sp.n == 1 && handle_embedding_cache(request.get())) {
+    return;
+  }
+
+  if (!scheduler_->add_request(request)) {
+    CALLBACK_WITH_ERROR(StatusCode::RESOURCE_EXHAUSTED,
+                        "No available resources to schedule request",
+                        sp.service_request_id,
+                        sp.source_xservice_addr);
+  }
 }
 
 void LLMMaster::handle_request(std::vector<Message> messages,
@@ -409,6 +520,17 @@ std::shared_ptr<Request> LLMMaster::generate_request(
     return nullptr;
   }
 
+  TenantLimiter* tenant_limiter = get_tenant_limiter();
+  if (tenant_limiter->is_limited(sp.tenant, local_prompt_tokens.size())) {
+    CALLBACK_WITH_ERROR(StatusCode::RESOURCE_EXHAUSTED,
+                        "The tenant has reached its request limit.",
+                        sp.service_request_id,
+                        sp.source_xservice_addr);
+    return nullptr;
+  }
+  xllm::ScopeGuard tenant_limit_guard(
+      [&] { tenant_limiter->release(sp.tenant); });
+
   uint32_t max_tokens = sp.max_tokens;
   if (max_tokens == 0) {
     const uint32_t kDefaultMaxTokens = 5120;
@@ -465,6 +587,7 @@ std::shared_ptr<Request> LLMMaster::generate_request(
   SchedulerParam scheduler_param;
   scheduler_param.offline = sp.offline;
   scheduler_param.priority = sp.priority;
+  scheduler_param.tenant = sp.tenant;
   if (!sp.offline) {
     scheduler_param.ttft_slo_ms = sp.ttft_slo_ms;
     scheduler_param.tpot_slo_ms = sp.tpot_slo_ms;
@@ -555,6 +678,7 @@ std::shared_ptr<Request> LLMMaster::generate_request(
                          sp.decode_address,
                          call);
   req_state.include_stop_str_in_output = sp.include_stop_str_in_output;
+  req_state.skip_detokenize = sp.skip_detokenize;
   if (json_object) {
     std::string grammar_error;
     bool reasoning_enabled = false;
@@ -588,6 +712,7 @@ std::shared_ptr<Request> LLMMaster::generate_request(
   req_state.sample_slots = sp.sample_slots;
 
   rate_limit_guard.dismiss();
+  tenant_limit_guard.dismiss();
   auto request = std::make_shared<Request>(sp.request_id,
                                            sp.x_request_id,
                                            sp.x_request_time,
@@ -595,11 +720,69 @@ std::shared_ptr<Request> LLMMaster::generate_request(
                                            sp.service_request_id,
                                            sp.source_xservice_addr,
                                            get_rate_limiter());
+  request->set_tenant_limiter(tenant_limiter, sp.tenant);
 
   // add one sequence, rest will be added by scheduler
   return request;
 }
 
+bool LLMMaster::handle_embedding_cache(Request* request) {
+  RequestState& state = request->state();
+  const XXH3Key key =
+      EmbeddingResultCache::make_key(options_.model_id(), state.prompt_tokens);
+  const uint64_t epoch = embedding_result_cache_->epoch();
+  std::optional<EmbeddingResultCache::Result> cached =
+      embedding_result_cache_->lookup(key);
+  if (!cached.has_value()) {
+    state.output_func = [cache = embedding_result_cache_.get(),
+                         key,
+                         epoch,
+                         output_func = std::move(state.output_func)](
+                            const RequestOutput& output) {
+      const bool succeeded = output.finished && !output.cancelled &&
+                             output.status.has_value() &&
+                             output.status->ok() && output.usage.has_value();
+      if (succeeded && output.outputs.size() == 1) {
+        const SequenceOutput& seq_output = output.outputs[0];
+        EmbeddingResultCache::Result result;
+        result.usage = output.usage.value();
+        if (seq_output.embeddings.has_value()) {
+          result.embedding = seq_output.embeddings.value();
+        } else if (seq_output.logprobs.has_value() &&
+                   !seq_output.logprobs->empty()) {
+          result.score = seq_output.logprobs->front().logprob;
+          result.score_token_id = seq_output.logprobs->front().token_id;
+        }
+        cache->insert(key, std::move(result), epoch);
+      }
+      return output_func(output);
+    };
+    return false;
+  }
+
+  SequenceOutput seq_output;
+  seq_output.index = 0;
+  if (cached->score.has_value()) {
+    LogProb logprob;
+    logprob.token_id = cached->score_token_id;
+    logprob.logprob = cached->score.value();
+    seq_output.logprobs = std::vector<LogProb>{std::move(logprob)};
+  } else {
+    seq_output.embeddings = std::move(cached->embedding);
+  }
+
+  RequestOutput output;
+  output.request_id = request->request_id();
+  output.service_request_id = request->service_request_id();
+  output.status = Status(StatusCode::OK);
+  output.usage = cached->usage;
+  output.usage->num_cached_tokens = output.usage->num_prompt_tokens;
+  output.outputs.push_back(std::move(seq_output));
+  output.finished = true;
+  state.output_func(output);
+  return true;
+}
+
 std::shared_ptr<Request> LLMMaster::generate_request(
     const std::vector<Message>& messages,
     std::optional<std::vector<int>> prompt_tokens,
@@ -673,11 +856,21 @@ bool LLMMaster::wakeup() {
 bool LLMMaster::wakeup(const WakeupOptions& options) {
   WakeupOptions opts = options;
   opts.master_status = master_status_;
-  return engine_->wakeup(opts);
+  const bool ok = engine_->wakeup(opts);
+  // the weights may have been replaced while asleep.
+  if (ok && embedding_result_cache_ != nullptr) {
+    embedding_result_cache_->clear();
+  }
+  return ok;
 }
 
 bool LLMMaster::update_weights(const std::string& weights_path) {
-  return engine_->update_weights(weights_path);
+  const bool ok = engine_->update_weights(weights_path);
+  // results computed with the old weights must not be served anymore.
+  if (ok && embedding_result_cache_ != nullptr) {
+    embedding_result_cache_->clear();
+  }
+  return ok;
 }
 
 bool LLMMaster::link_p2p(const std::vector<std::string>& remote_addrs) {
@@ -27,6 +27,7 @@ limitations under the License.
 #include "common/options.h"
 #include "common/rate_limiter.h"
 #include "framework/chat_template/chat_template.h"
+#include "framework/encoder_cache/embedding_result_cache.h"
 #include "framework/request/request_output.h"
 #include "framework/request/request_params.h"
 #include "framework/sampling/json_object_grammar.h"
@@ -103,6 +104,20 @@ class LLMMaster : public Master {
   bool is_scheduler_paused() const;
 
  private:
+  // Offline batch mode of handle_batch_request(), see
+  // ServiceConfig::enable_offline_batch_mode.
+  void handle_offline_batch_request(std::vector<std::string> prompts,
+                                    std::vector<RequestParams> sps,
+                                    BatchOutputCallback callback);
+
+  // Verifies, builds and schedules a completion request; runs on a request
+  // handling thread.
+  void process_request(std::string prompt,
+                       std::optional<std::vector<int>> prompt_tokens,
+                       RequestParams sp,
+                       std::optional<Call*> call,
+                       OutputCallback callback);
+
   std::shared_ptr<Request> generate_request(
       std::string prompt,
       std::optional<std::vector<int>> prompt_tokens,
@@ -122,6 +137,11 @@ class LLMMaster : public Master {
       bool reasoning_enabled,
       std::string* error);
 
+  // Answers an embeddings request from the embedding result cache and returns
+  // true on a hit. On a miss, arranges for the finished result to be cached
+  // and returns false.
+  bool handle_embedding_cache(Request* request);
+
  private:
   XServiceClient* xservice_client_ = nullptr;
 
@@ -136,6 +156,10 @@ class LLMMaster : public Master {
   // we don't know if tokenizer is thread safe, so we create one for each thread
   // for now
   std::unique_ptr<Tokenizer> tokenizer_;
+
+  // exact-match cache of embedding results, null when disabled.
+  std::unique_ptr<EmbeddingResultCache> embedding_result_cache_;
+
   std::mutex json_object_grammar_mutex_;
   std::shared_ptr<const JsonObjectGrammar> json_object_grammar_;
   std::shared_ptr<const JsonObjectGrammar> json_reasoning_grammar_;
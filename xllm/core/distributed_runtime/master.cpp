@@ -80,6 +80,12 @@ void apply_runtime_kv_cache_options(const Options& source,
       .store_master_server_address(source.store_master_server_address())
       .store_metadata_server(source.store_metadata_server())
       .store_local_hostname(source.store_local_hostname())
+      .store_local_capacity_gb(source.store_local_capacity_gb())
+      .store_local_bandwidth_gbps(source.store_local_bandwidth_gbps())
+      .store_local_latency_us(source.store_local_latency_us())
+      .kv_cache_disk_path(source.kv_cache_disk_path())
+      .kv_cache_disk_capacity_gb(source.kv_cache_disk_capacity_gb())
+      .kv_cache_tier_codec(source.kv_cache_tier_codec())
       .prefetch_batch_size(source.prefetch_batch_size())
       .prefetch_timeout(source.prefetch_timeout())
       .layers_wise_copy_batchs(source.layers_wise_copy_batchs())
@@ -142,7 +148,8 @@ std::optional<std::string> validate_model_cp(const Options& options,
       return "MLU CP supports only the generate task";
     }
     if (engine_type == EngineType::SSM &&
-        options.speculative_algorithm() != "Suffix") {
+        !SpeculativeConfig::is_model_free_algorithm(
+            options.speculative_algorithm())) {
       return "Current MLU model-side CP does not support MTPWorkerImpl-based "
              "speculative algorithms such as MTP or Eagle3; disable CP, "
              "disable the speculative algorithm, or wait for MLU worker-side "
@@ -182,7 +189,7 @@ std::optional<std::string> validate_model_cp(const Options& options,
             options.speculative_algorithm())) {
       return "Current model-side CP does not support aux-hidden-capture "
              "speculative algorithms (Eagle3/DFlash); disable CP or disable "
-             "the speculative algorithm. MTP and Suffix are supported.";
+             "the speculative algorithm. MTP, Suffix and NGram are supported.";
     }
     // enable_graph is compatible with CP because the two are phase-disjoint:
     // CP only engages on batch_forward_type.no_decode() (both the model-owned
@@ -541,9 +548,13 @@ Master::Master(const Options& options, EngineType type)
     // create a speculative engine if draft model path is provided
     const std::string draft_model_path =
         options_.draft_model_path().value_or("");
-    const bool use_suffix_spec = options_.speculative_algorithm() == "Suffix";
-    CHECK(use_suffix_spec || !draft_model_path.empty())
-        << "draft model path is required unless --speculative_algorithm=Suffix";
+    // Suffix and NGram build drafts from token history on the worker and share
+    // the draft-model-free engine.
+    const bool use_model_free_spec = SpeculativeConfig::is_model_free_algorithm(
+        options_.speculative_algorithm());
+    CHECK(use_model_free_spec || !draft_model_path.empty())
+        << "draft model path is required unless --speculative_algorithm is "
+           "Suffix or NGram";
     // Draft model shares the same devices as the target model.
     const auto& draft_devices = devices;
     LOG(INFO) << "Using draft devices: "
@@ -574,6 +585,14 @@ Master::Master(const Options& options, EngineType type)
             options_.speculative_suffix_max_cached_requests())
         .speculative_suffix_use_tree_spec(
             options_.speculative_suffix_use_tree_spec())
+        .speculative_suffix_num_threads(
+            options_.speculative_suffix_num_threads())
+        .speculative_suffix_corpus_path(
+            options_.speculative_suffix_corpus_path())
+        .speculative_suffix_snapshot_interval_s(
+            options_.speculative_suffix_snapshot_interval_s())
+        .speculative_ngram_min(options_.speculative_ngram_min())
+        .speculative_ngram_max(options_.speculative_ngram_max())
         .enable_adaptive_speculative_decode(
             options_.enable_adaptive_speculative_decode())
         .adaptive_speculative_min_gain(options_.adaptive_speculative_min_gain())
@@ -617,7 +636,7 @@ Master::Master(const Options& options, EngineType type)
         .max_tokens_for_graph_mode(options_.max_tokens_for_graph_mode());
     apply_runtime_kv_cache_options(options_, spec_options);
 
-    if (use_suffix_spec) {
+    if (use_model_free_spec) {
       engine_ = std::make_unique<SuffixSpeculativeEngine>(spec_options);
     } else {
       engine_ = std::make_unique<SpeculativeEngine>(spec_options);
@@ -24,6 +24,7 @@ limitations under the License.
 #include "common/macros.h"
 #include "common/options.h"
 #include "common/rate_limiter.h"
+#include "common/tenant_limiter.h"
 #include "common/types.h"
 #include "engine.h"
 #include "framework/request/request_params.h"
@@ -73,11 +74,14 @@ class Master {
 
   RateLimiter* get_rate_limiter() { return &rate_limiter_; }
 
+  TenantLimiter* get_tenant_limiter() { return &tenant_limiter_; }
+
  protected:
   Options options_;
   EngineType engine_type_ = EngineType::INVALID;
   std::unique_ptr<Engine> engine_;
   RateLimiter rate_limiter_;
+  TenantLimiter tenant_limiter_;
   MasterStatus master_status_{MasterStatus::WAKEUP};
 };
 
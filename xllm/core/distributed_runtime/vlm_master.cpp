@@ -368,6 +368,15 @@ std::shared_ptr<Request> VLMMaster::build_request(
     return nullptr;
   }
 
+  TenantLimiter* tenant_limiter = get_tenant_limiter();
+  if (tenant_limiter->is_limited(sp.tenant, prompt_tokens.size())) {
+    CALLBACK_WITH_ERROR(StatusCode::RESOURCE_EXHAUSTED,
+                        "The tenant has reached its request limit.");
+    return nullptr;
+  }
+  xllm::ScopeGuard tenant_limit_guard(
+      [&] { tenant_limiter->release(sp.tenant); });
+
   uint32_t max_tokens = sp.max_tokens;
   if (max_tokens == 0) {
     const uint32_t kDefaultMaxTokens = 5120;
@@ -445,7 +454,9 @@ std::shared_ptr<Request> VLMMaster::build_request(
                          callback,
                          nullptr);
   req_state.include_stop_str_in_output = sp.include_stop_str_in_output;
+  req_state.scheduler_param.tenant = sp.tenant;
   rate_limit_guard.dismiss();
+  tenant_limit_guard.dismiss();
   auto request = std::make_shared<Request>(sp.request_id,
                                            sp.x_request_id,
                                            sp.x_request_time,
@@ -453,6 +464,7 @@ std::shared_ptr<Request> VLMMaster::build_request(
                                            sp.service_request_id,
                                            sp.source_xservice_addr,
                                            get_rate_limiter());
+  request->set_tenant_limiter(tenant_limiter, sp.tenant);
 
   // add one sequence, rest will be added by scheduler
   return request;
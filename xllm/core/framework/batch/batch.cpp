@@ -201,6 +201,8 @@ ForwardInput Batch::prepare_forward_input(uint32_t num_decoding_tokens,
                             cp_size);
   ForwardInput forward_input =
       builder.build_forward_input(num_decoding_tokens, min_decoding_batch_size);
+  forward_input.input_params.embedding.released_request_ids =
+      released_request_ids_;
   linear_restore_src_blocks_ = builder.take_linear_restore_src_blocks();
   return forward_input;
 }
@@ -239,8 +241,11 @@ ForwardInput Batch::prepare_rec_forward_input(uint32_t num_decoding_tokens,
                                               &args,
                                               batch_forward_type_,
                                               thread_pool);
-  return builder->build_rec_forward_input(num_decoding_tokens,
-                                          min_decoding_batch_size);
+  ForwardInput forward_input = builder->build_rec_forward_input(
+      num_decoding_tokens, min_decoding_batch_size);
+  forward_input.input_params.embedding.released_request_ids =
+      released_request_ids_;
+  return forward_input;
 }
 
 std::vector<Sequence*> Batch::get_sequences() {
@@ -421,6 +426,8 @@ ForwardInput Batch::prepare_forward_input(const ModelArgs& args,
   ForwardInput forward_input =
       builder.build_forward_input(/*num_decoding_tokens=*/0,
                                   /*min_decoding_batch_size=*/0);
+  forward_input.input_params.embedding.released_request_ids =
+      released_request_ids_;
   linear_restore_src_blocks_ = builder.take_linear_restore_src_blocks();
   if (has_partial_finished_beam_group()) {
     // Beam-search kernel assumes fixed beam width per group. When only part of
@@ -842,8 +849,16 @@ void Batch::process_beam_search_output(const RawForwardOutput& raw_output,
       CHECK_LE(src_seq_idx, sequences_.size());
       auto src_seq = sequences_[src_seq_idx];
       src_acc_logprob_vec[i] = src_seq->get_acc_logprob();
-      src_token_ids[i] = std::vector<int32_t>(src_seq->tokens());
-      src_logprobs[i] = src_seq->logprob_state()->get_logprobs();
+      // only the generated suffix is rewritten below, skip the prompt.
+      const Slice<int32_t> generated_tokens = src_seq->get_generated_tokens();
+      src_token_ids[i].assign(generated_tokens.begin(), generated_tokens.end());
+      src_logprobs[i].reserve(generated_tokens.size());
+      for (size_t token_idx = src_seq->num_prompt_tokens();
+           token_idx < src_seq->num_tokens();
+           ++token_idx) {
+        src_logprobs[i].push_back(
+            src_seq->logprob_state()->get_logprob(token_idx));
+      }
       if (restore_json_states) {
         const JsonObjectGrammarState* json_state = src_seq->json_object_state();
         CHECK(json_state != nullptr)
@@ -864,11 +879,12 @@ void Batch::process_beam_search_output(const RawForwardOutput& raw_output,
         return;
       }
 
-      for (size_t token_idx = base_seq->num_prompt_tokens();
+      const size_t num_prompt_tokens = base_seq->num_prompt_tokens();
+      for (size_t token_idx = num_prompt_tokens;
            token_idx < base_seq->num_tokens();
            token_idx++) {
-        Token new_token(src_token_ids[i][token_idx]);
-        new_token.logprob = src_logprobs[i][token_idx];
+        Token new_token(src_token_ids[i][token_idx - num_prompt_tokens]);
+        new_token.logprob = src_logprobs[i][token_idx - num_prompt_tokens];
         base_seq->update_token(token_idx, new_token);
       }
 
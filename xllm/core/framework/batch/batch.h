@@ -21,6 +21,8 @@ limitations under the License.
 #include <torch/torch.h>
 
 #include <limits>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "core/framework/multimodal/mm_data.h"
@@ -63,6 +65,12 @@ class Batch {
     swap_block_transfer_infos_ = std::move(swap_block_transfer_infos);
   }
 
+  // requests finished or cancelled since the previous step, forwarded to the
+  // workers so they can drop per-request state.
+  void set_released_request_ids(std::vector<std::string> request_ids) {
+    released_request_ids_ = std::move(request_ids);
+  }
+
   void set_batch_id() {
     if (batch_id_ == UNINITIALIZED_BATCH_ID) {
       batch_id_ = batch_counter_;
@@ -169,6 +177,7 @@ class Batch {
   std::vector<Sequence*> sequences_;
   std::vector<SequencesGroup*> sequence_groups_;
   std::vector<BlockTransferInfo> swap_block_transfer_infos_;
+  std::vector<std::string> released_request_ids_;
 
   // max number of tokens to process for each sequence
   // default to max value
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "batch_factory.h"
 
+#include "util/flight_recorder.h"
+
 namespace xllm {
 
 namespace {
@@ -34,6 +36,7 @@ std::vector<Batch> BatchFactory::create_batches(
     const std::vector<Sequence*>& running_sequences,
     const std::vector<size_t>& running_sequences_budgets,
     std::vector<std::vector<BlockTransferInfo>>* swap_block_transfer_infos) {
+  FlightRecorderSpan span("batch.build");
   size_t num_prompt_tokens = 0;
   size_t num_generated_tokens = 0;
   std::vector<Batch> batches(dp_size_);
@@ -80,6 +83,9 @@ std::vector<Batch> BatchFactory::create_batches(
 
   COUNTER_ADD(num_processing_tokens_total_prompt, num_prompt_tokens);
   COUNTER_ADD(num_processing_tokens_total_generated, num_generated_tokens);
+  span.set_arg("sequences", static_cast<int64_t>(running_sequences.size()));
+  span.set_arg("prompt_tokens", static_cast<int64_t>(num_prompt_tokens));
+  span.set_arg("generated_tokens", static_cast<int64_t>(num_generated_tokens));
 
   if (running_sequences.size() > 0) {
     HISTOGRAM_OBSERVE(
@@ -34,6 +34,7 @@ limitations under the License.
 #include "core/framework/config/eplb_config.h"
 #include "core/framework/config/scheduler_config.h"
 #include "core/framework/config/service_config.h"
+#include "core/framework/config/speculative_config.h"
 #include "core/framework/multimodal/mm_visitor.h"
 #include "framework/model/model_args.h"
 #include "framework/model/model_input_params.h"
@@ -241,6 +242,10 @@ BatchInputBuilder::BatchInputBuilder(
   if (build_eplb_decode_token_mask_) {
     state_.eplb_decode_token_mask.reserve(reserve_size);
   }
+  const SpeculativeConfig& speculative_config =
+      SpeculativeConfig::get_instance();
+  build_history_tokens_ = speculative_config.num_speculative_tokens() > 0 &&
+                          speculative_config.speculative_algorithm() == "NGram";
   is_graph_warmup_ =
       !sequences_.empty() &&
       std::all_of(sequences_.begin(), sequences_.end(), [](Sequence* sequence) {
@@ -664,6 +669,12 @@ void BatchInputBuilder::process_sequences_multithreaded() {
     state_.request_ids.insert(state_.request_ids.end(),
                               state.request_ids.begin(),
                               state.request_ids.end());
+    state_.history_token_ids.insert(state_.history_token_ids.end(),
+                                    state.history_token_ids.begin(),
+                                    state.history_token_ids.end());
+    state_.history_token_lens.insert(state_.history_token_lens.end(),
+                                     state.history_token_lens.begin(),
+                                     state.history_token_lens.end());
     state_.extra_token_ids.insert(state_.extra_token_ids.end(),
                                   state.extra_token_ids.begin(),
                                   state.extra_token_ids.end());
@@ -853,6 +864,17 @@ void BatchInputBuilder::extract_tokens_and_positions(Sequence* sequence,
     state.extra_token_ids.emplace_back(-1);
     state.embedding_ids.emplace_back(sequence->get_embedding_block_id());
     state.request_ids.emplace_back(sequence->request_id());
+    if (build_history_tokens_) {
+      // decode rows were indexed when their prefill ended.
+      if (sequence->stage() == SequenceStage::DECODE) {
+        state.history_token_lens.emplace_back(-1);
+      } else {
+        state.history_token_ids.insert(state.history_token_ids.end(),
+                                       token_ids.begin(),
+                                       token_ids.begin() + n_kv_cache_tokens);
+        state.history_token_lens.emplace_back(n_kv_cache_tokens);
+      }
+    }
     torch::Tensor mtp_bootstrap = sequence->get_mtp_bootstrap_embedding();
     if (state.batch_forward_type.is_decode() && mtp_bootstrap.defined()) {
       CHECK_LT(n_kv_cache_tokens, seq_len)
@@ -1294,6 +1316,10 @@ ForwardInput BatchInputBuilder::state_to_forward_input() {
         torch::tensor(input_params.embedding.linear_state_ids, torch::kInt);
   }
   input_params.embedding.request_ids = std::move(state_.request_ids);
+  input_params.embedding.history_token_ids =
+      std::move(state_.history_token_ids);
+  input_params.embedding.history_token_lens =
+      std::move(state_.history_token_lens);
   input_params.embedding.extra_token_ids = std::move(state_.extra_token_ids);
   if (!state_.mtp_shifted_token_ids.empty()) {
     // Write both the upstream "root" path (consumed by non-CP MTP code paths
@@ -127,6 +127,8 @@ class BatchInputBuilder {
     std::vector<LinearStateCacheOp> linear_state_cache_ops;
     std::vector<Block> linear_restore_src_blocks;
     std::vector<std::string> request_ids;
+    std::vector<int32_t> history_token_ids;
+    std::vector<int32_t> history_token_lens;
     std::vector<int32_t> extra_token_ids;
     std::vector<int32_t> mtp_shifted_token_ids;
     std::vector<int32_t> eplb_decode_token_mask;
@@ -196,6 +198,8 @@ class BatchInputBuilder {
   uint32_t num_sequences_ = 0;
   bool need_unique_tokens_ = true;
   bool build_eplb_decode_token_mask_ = false;
+  // the NGram drafter indexes the full token history of each request.
+  bool build_history_tokens_ = false;
   bool is_graph_warmup_ = false;
   int32_t cp_size_ = 1;
 
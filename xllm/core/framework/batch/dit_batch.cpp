@@ -20,6 +20,7 @@ limitations under the License.
 #include <glog/logging.h>
 #include <torch/torch.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -47,23 +48,74 @@ bool check_tensors_valid(const std::vector<torch::Tensor>& vec) {
   return true;
 }
 
+// requests of a step-level batch each draw their own initial noise.
+bool same_params_except_seed(xllm::DiTGenerationParams lhs,
+                             const xllm::DiTGenerationParams& rhs) {
+  lhs.seed = rhs.seed;
+  lhs.seed_is_set = rhs.seed_is_set;
+  return lhs == rhs;
+}
+
 }  // namespace
 
 namespace xllm {
 
 DiTForwardInput DiTBatch::prepare_forward_input() {
-  CHECK(!request_vec_.empty());
+  if (step_batching_) {
+    return prepare_step_forward_input();
+  }
+  return prepare_forward_input(request_vec_);
+}
+
+DiTForwardInput DiTBatch::prepare_step_forward_input() {
+  DiTForwardInput input;
+  input.released_request_ids = released_request_ids_;
+  if (request_vec_.empty()) {
+    // only releases the state of cancelled requests.
+    return input;
+  }
+  // joining requests go first, their inputs fill the regular fields.
+  auto running_begin = std::stable_partition(
+      request_vec_.begin(),
+      request_vec_.end(),
+      [](const std::shared_ptr<DiTRequest>& request) {
+        return request->denoise_step() == 0;
+      });
+  std::vector<std::shared_ptr<DiTRequest>> joining_requests(
+      request_vec_.begin(), running_begin);
+
+  if (!joining_requests.empty()) {
+    input = prepare_forward_input(joining_requests);
+    input.released_request_ids = released_request_ids_;
+  } else {
+    input.generation_params = request_vec_[0]->state().generation_params();
+  }
+  input.batch_size = request_vec_.size();
+  for (const auto& request : joining_requests) {
+    input.joining_request_ids.emplace_back(request->request_id());
+    input.joining_seeds.emplace_back(
+        request->state().generation_params().seed);
+  }
+  for (auto it = running_begin; it != request_vec_.end(); ++it) {
+    input.running_request_ids.emplace_back((*it)->request_id());
+  }
+  return input;
+}
+
+DiTForwardInput DiTBatch::prepare_forward_input(
+    const std::vector<std::shared_ptr<DiTRequest>>& requests) {
+  CHECK(!requests.empty());
   if (::xllm::DiTConfig::get_instance().dit_debug_print()) {
-    LOG(INFO) << "DiT batch_size=" << request_vec_.size();
+    LOG(INFO) << "DiT batch_size=" << requests.size();
   }
-  if (request_vec_[0]->state().request_kind() == DiTRequestKind::kText) {
-    CHECK_EQ(request_vec_.size(), 1U)
+  if (requests[0]->state().request_kind() == DiTRequestKind::kText) {
+    CHECK_EQ(requests.size(), 1U)
         << "Cola-DLM text generation supports batch_size=1 only.";
   }
 
   DiTForwardInput input;
-  input.batch_size = request_vec_.size();
-  input.generation_params = request_vec_[0]->state().generation_params();
+  input.batch_size = requests.size();
+  input.generation_params = requests[0]->state().generation_params();
 
   std::vector<torch::Tensor> prompt_embeds;
   std::vector<torch::Tensor> pooled_prompt_embeds;
@@ -78,7 +130,7 @@ DiTForwardInput DiTBatch::prepare_forward_input() {
   std::vector<torch::Tensor> masked_image_latents;
   std::vector<torch::Tensor> last_images;
   std::vector<std::vector<torch::Tensor>> per_request_images;
-  const auto batch_size = request_vec_.size();
+  const auto batch_size = requests.size();
   prompt_embeds.reserve(batch_size);
   pooled_prompt_embeds.reserve(batch_size);
   negative_prompt_embeds.reserve(batch_size);
@@ -95,9 +147,12 @@ DiTForwardInput DiTBatch::prepare_forward_input() {
   size_t images_size = 0;
   bool images_size_valid = true;
   bool images_size_initialized = false;
-  for (const auto& request : request_vec_) {
+  for (const auto& request : requests) {
     const auto& generation_params = request->state().generation_params();
-    CHECK(input.generation_params == generation_params)
+    CHECK(step_batching_
+              ? same_params_except_seed(input.generation_params,
+                                        generation_params)
+              : input.generation_params == generation_params)
         << "DiT generation params must be equal in the same batch";
 
     const auto& input_params = request->state().input_params();
@@ -153,21 +208,21 @@ DiTForwardInput DiTBatch::prepare_forward_input() {
     }
   }
 
-  if (input.prompts.size() != request_vec_.size()) {
+  if (input.prompts.size() != requests.size()) {
     input.prompts.clear();
   }
 
-  if (input.prompts_2.size() != request_vec_.size()) {
+  if (input.prompts_2.size() != requests.size()) {
     input.prompts_2.clear();
   }
 
   const bool has_full_negative_prompts =
-      input.negative_prompts.size() == request_vec_.size();
+      input.negative_prompts.size() == requests.size();
   if (!has_full_negative_prompts) {
     input.negative_prompts.clear();
   }
 
-  if (input.negative_prompts_2.size() != request_vec_.size()) {
+  if (input.negative_prompts_2.size() != requests.size()) {
     input.negative_prompts_2.clear();
   }
 
@@ -178,7 +233,7 @@ DiTForwardInput DiTBatch::prepare_forward_input() {
   if (images_size_valid) {
     images_list.reserve(images_size);
     std::vector<torch::Tensor> vec;
-    vec.reserve(request_vec_.size());
+    vec.reserve(requests.size());
 
     bool all_valid = true;
     for (size_t idx = 0; idx < images_size; ++idx) {
@@ -238,6 +293,19 @@ DiTForwardInput DiTBatch::prepare_forward_input() {
 }
 
 void DiTBatch::process_forward_output(const DiTForwardOutput& output) {
+  if (step_batching_) {
+    // one output per request past its last step, in batch order.
+    size_t output_idx = 0;
+    for (auto& request : request_vec_) {
+      request->advance_denoise_step();
+      if (request->denoise_finished()) {
+        CHECK_LT(output_idx, output.tensors.size());
+        request->handle_forward_output(output.tensors[output_idx++]);
+      }
+    }
+    CHECK_EQ(output_idx, output.tensors.size());
+    return;
+  }
   // Text diffusion models produce text output directly.
   if (!output.text_output.empty()) {
     CHECK(request_vec_.size() == output.text_output.size());
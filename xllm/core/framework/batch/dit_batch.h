@@ -19,6 +19,7 @@ limitations under the License.
 #include <torch/torch.h>
 
 #include <limits>
+#include <string>
 #include <vector>
 
 #include "framework/request/dit_request.h"
@@ -32,8 +33,23 @@ struct DiTBatch {
   void add(const std::shared_ptr<DiTRequest>& request) {
     request_vec_.emplace_back(request);
   }
+  // add a request to run one denoising step under step-level batching; it
+  // joins the batch if it has not run any step yet.
+  void add_step_request(const std::shared_ptr<DiTRequest>& request) {
+    step_batching_ = true;
+    request_vec_.emplace_back(request);
+  }
+  // drop the denoising state of a request that leaves the step batch
+  // before its last step.
+  void release_step_request(const std::string& request_id) {
+    step_batching_ = true;
+    released_request_ids_.emplace_back(request_id);
+  }
   size_t size() const { return request_vec_.size(); }
-  bool empty() const { return request_vec_.empty(); }
+  bool empty() const {
+    return request_vec_.empty() && released_request_ids_.empty();
+  }
+  bool step_batching() const { return step_batching_; }
 
   // prepare forward input
   DiTForwardInput prepare_forward_input();
@@ -41,7 +57,16 @@ struct DiTBatch {
   void process_forward_output(const DiTForwardOutput& output);
 
  private:
+  DiTForwardInput prepare_forward_input(
+      const std::vector<std::shared_ptr<DiTRequest>>& requests);
+
+  DiTForwardInput prepare_step_forward_input();
+
   std::vector<std::shared_ptr<DiTRequest>> request_vec_;
+
+  std::vector<std::string> released_request_ids_;
+
+  bool step_batching_ = false;
 };
 
 }  // namespace xllm
@@ -0,0 +1,154 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/block/block_extent_allocator.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace xllm {
+
+BlockExtentAllocator::BlockExtentAllocator(int32_t num_blocks)
+    : num_blocks_(num_blocks), num_free_blocks_(num_blocks) {
+  CHECK_GT(num_blocks, 0) << "No blocks to allocate";
+  insert_extent(/*start=*/0, /*length=*/num_blocks);
+}
+
+void BlockExtentAllocator::insert_extent(int32_t start, int32_t length) {
+  extents_.emplace(start, length);
+  by_length_.emplace(length, start);
+}
+
+void BlockExtentAllocator::erase_extent(
+    std::map<int32_t, int32_t>::iterator it) {
+  by_length_.erase({it->second, it->first});
+  extents_.erase(it);
+}
+
+void BlockExtentAllocator::take_front(int32_t start,
+                                      size_t max_length,
+                                      std::vector<int32_t>* block_ids) {
+  auto it = extents_.find(start);
+  CHECK(it != extents_.end()) << "block " << start << " does not start a run";
+  const int32_t length = it->second;
+  const int32_t taken =
+      static_cast<int32_t>(std::min<size_t>(max_length, length));
+  erase_extent(it);
+  if (taken < length) {
+    insert_extent(start + taken, length - taken);
+  }
+  for (int32_t id = start; id < start + taken; ++id) {
+    block_ids->emplace_back(id);
+  }
+  num_free_blocks_ -= taken;
+}
+
+bool BlockExtentAllocator::allocate(size_t num_blocks,
+                                    int32_t hint,
+                                    std::vector<int32_t>* block_ids) {
+  CHECK(block_ids != nullptr);
+  if (num_blocks > num_free_blocks_) {
+    return false;
+  }
+  block_ids->reserve(block_ids->size() + num_blocks);
+  size_t remaining = num_blocks;
+
+  if (remaining > 0 && hint >= 0 && hint < num_blocks_) {
+    // find the run containing hint, split it there and continue from hint.
+    auto it = extents_.upper_bound(hint);
+    if (it != extents_.begin()) {
+      --it;
+      const int32_t start = it->first;
+      const int32_t length = it->second;
+      if (hint < start + length) {
+        if (hint > start) {
+          erase_extent(it);
+          insert_extent(start, hint - start);
+          insert_extent(hint, start + length - hint);
+        }
+        const size_t before = block_ids->size();
+        take_front(hint, remaining, block_ids);
+        remaining -= block_ids->size() - before;
+      }
+    }
+  }
+
+  while (remaining > 0) {
+    const size_t before = block_ids->size();
+    const auto largest = std::prev(by_length_.end());
+    const int32_t largest_length = largest->first;
+    if (static_cast<size_t>(largest_length) >= 2 * remaining) {
+      // the block before a maximal free run is in use, typically by a
+      // sequence that is still growing. Start in the middle of the largest
+      // run so both that sequence and this one have room to grow in place.
+      const int32_t start = largest->second;
+      const int32_t middle = start + largest_length / 2;
+      erase_extent(extents_.find(start));
+      insert_extent(start, middle - start);
+      insert_extent(middle, start + largest_length - middle);
+      take_front(middle, remaining, block_ids);
+    } else {
+      // memory is tight: best fit keeps large runs intact for large
+      // requests, or else the largest runs give the fewest pieces.
+      auto fit = by_length_.lower_bound({static_cast<int32_t>(remaining),
+                                         std::numeric_limits<int32_t>::min()});
+      if (fit == by_length_.end()) {
+        fit = largest;
+      }
+      take_front(fit->second, remaining, block_ids);
+    }
+    remaining -= block_ids->size() - before;
+  }
+  return true;
+}
+
+int32_t BlockExtentAllocator::allocate_one() {
+  if (extents_.empty()) {
+    return -1;
+  }
+  // lowest free id, e.g. the padding block 0 right after construction.
+  std::vector<int32_t> block_ids;
+  take_front(extents_.begin()->first, /*max_length=*/1, &block_ids);
+  return block_ids.front();
+}
+
+void BlockExtentAllocator::free(int32_t block_id) {
+  CHECK_GE(block_id, 0);
+  CHECK_LT(block_id, num_blocks_);
+  int32_t start = block_id;
+  int32_t length = 1;
+
+  auto next = extents_.upper_bound(block_id);
+  if (next != extents_.begin()) {
+    auto prev = std::prev(next);
+    CHECK_LE(prev->first + prev->second, block_id)
+        << "block " << block_id << " freed repeatedly";
+    if (prev->first + prev->second == block_id) {
+      start = prev->first;
+      length += prev->second;
+      erase_extent(prev);
+    }
+  }
+  if (next != extents_.end() && next->first == block_id + 1) {
+    length += next->second;
+    erase_extent(next);
+  }
+  insert_extent(start, length);
+  ++num_free_blocks_;
+}
+
+}  // namespace xllm
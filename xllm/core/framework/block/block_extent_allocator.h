@@ -0,0 +1,76 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace xllm {
+
+// Free block ids kept as maximal runs [start, start + length), so neighbours
+// are merged back on free and allocations are served from as few runs as
+// possible. Block ids that are adjacent in the id space are adjacent in every
+// KV cache tensor, so fewer runs mean fewer regions per layer when blocks are
+// pushed, offloaded or stored.
+//
+// Not thread-safe; callers serialize like they do for the LIFO free list.
+class BlockExtentAllocator final {
+ public:
+  // All ids in [0, num_blocks) start free.
+  explicit BlockExtentAllocator(int32_t num_blocks);
+
+  // Appends num_blocks ids to block_ids, ascending within each run. When
+  // hint is a free id (typically one past the last block of a growing
+  // sequence), the allocation continues from it first. The rest starts in
+  // the middle of the largest run while it has room to spare, and comes from
+  // the smallest run that fits once memory is tight. Returns false without
+  // allocating anything if fewer than num_blocks ids are free.
+  bool allocate(size_t num_blocks,
+                int32_t hint,
+                std::vector<int32_t>* block_ids);
+
+  // Lowest free id, or -1 when no id is free.
+  int32_t allocate_one();
+
+  void free(int32_t block_id);
+
+  size_t num_free_blocks() const { return num_free_blocks_; }
+  size_t num_extents() const { return extents_.size(); }
+  size_t largest_extent() const {
+    return by_length_.empty() ? 0 : by_length_.rbegin()->first;
+  }
+
+ private:
+  void insert_extent(int32_t start, int32_t length);
+  void erase_extent(std::map<int32_t, int32_t>::iterator it);
+  // takes up to max_length ids from the front of the run beginning at start.
+  void take_front(int32_t start,
+                  size_t max_length,
+                  std::vector<int32_t>* block_ids);
+
+  int32_t num_blocks_ = 0;
+  size_t num_free_blocks_ = 0;
+  // start -> length
+  std::map<int32_t, int32_t> extents_;
+  // (length, start), for best-fit and largest-first lookups
+  std::set<std::pair<int32_t, int32_t>> by_length_;
+};
+
+}  // namespace xllm
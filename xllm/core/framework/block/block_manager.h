@@ -95,6 +95,10 @@ class BlockManager {
     // future host offload participation -- see
     // leaf_participates_in_prefix_cache in composite_block_manager.cpp.
     PROPERTY(bool, instance_is_decode) = false;
+    // Keep free block ids as contiguous extents and grow sequences into the
+    // ids right after their last block, so KV transfers of a sequence merge
+    // into fewer regions. Flat BlockManagerImpl leaves only.
+    PROPERTY(bool, enable_contiguous_block_allocation) = false;
   };
 
   explicit BlockManager(Options options) : options_(options) {}
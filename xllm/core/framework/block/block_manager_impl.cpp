@@ -18,6 +18,8 @@ limitations under the License.
 
 #include <unordered_set>
 
+#include "core/framework/config/distributed_config.h"
+#include "framework/prefix_cache/kv_cache_summary.h"
 #include "framework/prefix_cache/prefix_cache_factory.h"
 namespace xllm {
 namespace {
@@ -58,16 +60,26 @@ BlockManagerImpl::BlockManagerImpl(const Options& options)
         .block_type(options.block_type());
     prefix_cache_ = create_prefix_cache(prefix_cache_options);
     CHECK(prefix_cache_) << "Failed to create prefix cache!";
+    if (options.block_type() == BlockType::KV &&
+        DistributedConfig::get_instance().enable_kv_cache_summary()) {
+      prefix_cache_->set_summary(&KVCacheSummary::get_instance());
+    }
   }
 
   size_t total_blocks = options_.num_blocks();
+  num_blocks_ = total_blocks;
   block_size_ = options_.block_size();
   num_free_blocks_.store(total_blocks, std::memory_order_relaxed);
   usage_accounted_ids_.assign(total_blocks, 0);
-  free_blocks_.reserve(total_blocks);
-  for (int32_t i = 0; i < total_blocks; ++i) {
-    // push smaller block ids to the back of the vector
-    free_blocks_.push_back(total_blocks - i - 1);
+  if (options_.enable_contiguous_block_allocation()) {
+    extent_allocator_ = std::make_unique<BlockExtentAllocator>(
+        static_cast<int32_t>(total_blocks));
+  } else {
+    free_blocks_.reserve(total_blocks);
+    for (int32_t i = 0; i < total_blocks; ++i) {
+      // push smaller block ids to the back of the vector
+      free_blocks_.push_back(total_blocks - i - 1);
+    }
   }
 
   // reserve block 0 for padding
@@ -76,6 +88,11 @@ BlockManagerImpl::BlockManagerImpl(const Options& options)
 }
 
 std::vector<Block> BlockManagerImpl::allocate(size_t num_blocks) {
+  return allocate_with_hint(num_blocks, /*hint=*/-1);
+}
+
+std::vector<Block> BlockManagerImpl::allocate_with_hint(size_t num_blocks,
+                                                        int32_t hint) {
   if (!has_enough_blocks(num_blocks)) {
     return {};
   }
@@ -83,13 +100,23 @@ std::vector<Block> BlockManagerImpl::allocate(size_t num_blocks) {
   CHECK(num_blocks <= num_free_blocks_) << "Not enough blocks available";
   std::vector<Block> blocks;
   blocks.reserve(num_blocks);
-  for (uint32_t i = 0; i < num_blocks; ++i) {
-    size_t prev_count =
-        num_free_blocks_.fetch_sub(1, std::memory_order_relaxed);
-    const int32_t block_id = free_blocks_[prev_count - 1];
-    CHECK(mark_used(&usage_accounted_ids_, block_id))
-        << "block " << block_id << " usage accounted repeatedly";
-    blocks.emplace_back(block_id, this);
+  if (extent_allocator_ != nullptr) {
+    std::vector<int32_t> block_ids;
+    CHECK(extent_allocator_->allocate(num_blocks, hint, &block_ids))
+        << "Not enough block extents available";
+    num_free_blocks_.fetch_sub(num_blocks, std::memory_order_relaxed);
+    for (const int32_t block_id : block_ids) {
+      CHECK(mark_used(&usage_accounted_ids_, block_id))
+          << "block " << block_id << " usage accounted repeatedly";
+      blocks.emplace_back(block_id, this);
+    }
+  } else {
+    for (uint32_t i = 0; i < num_blocks; ++i) {
+      const int32_t block_id = pop_free_block_id();
+      CHECK(mark_used(&usage_accounted_ids_, block_id))
+          << "block " << block_id << " usage accounted repeatedly";
+      blocks.emplace_back(block_id, this);
+    }
   }
 
   // const auto block_ids = allocate(num_blocks);
@@ -116,6 +143,15 @@ void BlockManagerImpl::deallocate(const Slice<Block>& blocks) {
         std::unordered_set<int32_t> block_id_set;
         block_id_set.insert(block.id());
         std::string error_msg = "Block already released: ";
+        if (extent_allocator_ != nullptr) {
+          // free ids live in the extent allocator, not in free_blocks_.
+          error_msg.append(std::to_string(block.id()))
+              .append(", free blocks in extents: ")
+              .append(std::to_string(extent_allocator_->num_free_blocks()))
+              .append(" in ")
+              .append(std::to_string(extent_allocator_->num_extents()))
+              .append(" runs");
+        }
         for (auto& id : free_blocks_) {
           if (block_id_set.count(id) != 0) {
             error_msg.append(std::to_string(id)).append(" ");
@@ -207,12 +243,21 @@ void BlockManagerImpl::cache(const std::vector<Block>& blocks) {
   }
 }
 
+int32_t BlockManagerImpl::pop_free_block_id() {
+  if (extent_allocator_ != nullptr) {
+    const int32_t block_id = extent_allocator_->allocate_one();
+    CHECK_GE(block_id, 0) << "No more block extents available";
+    num_free_blocks_.fetch_sub(1, std::memory_order_relaxed);
+    return block_id;
+  }
+  size_t prev_count = num_free_blocks_.fetch_sub(1, std::memory_order_relaxed);
+  return free_blocks_[prev_count - 1];
+}
+
 // allocate a block id
 Block BlockManagerImpl::allocate() {
   CHECK(num_free_blocks_ > 0) << "No more blocks available";
-  size_t prev_count = num_free_blocks_.fetch_sub(1, std::memory_order_relaxed);
-  const int32_t block_id = free_blocks_[prev_count - 1];
-  return {block_id, this};
+  return {pop_free_block_id(), this};
 }
 
 // caller should make sure the block_id is valid
@@ -223,6 +268,11 @@ void BlockManagerImpl::free(int32_t block_id) {
       CHECK_GT(num_used_blocks_.load(std::memory_order_relaxed), 0u);
       num_used_blocks_.fetch_sub(1, std::memory_order_relaxed);
     }
+    if (extent_allocator_ != nullptr) {
+      extent_allocator_->free(block_id);
+      num_free_blocks_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
     size_t prev_count =
         num_free_blocks_.fetch_add(1, std::memory_order_relaxed);
     CHECK(prev_count < free_blocks_.size());
@@ -257,7 +307,12 @@ std::optional<std::vector<Block>> BlockManagerImpl::allocate_for_sequence(
     return std::vector<Block>{};
   }
   const size_t num_additional = num_blocks_needed - held;
-  std::vector<Block> blocks = allocate(num_additional);
+  // continue right after the sequence's last block so its ids stay adjacent.
+  int32_t hint = -1;
+  if (held > 0) {
+    hint = kv_state.blocks(block_type()).back().id() + 1;
+  }
+  std::vector<Block> blocks = allocate_with_hint(num_additional, hint);
   if (blocks.size() != num_additional) {
     return std::nullopt;
   }
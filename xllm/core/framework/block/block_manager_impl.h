@@ -16,6 +16,9 @@ limitations under the License.
 
 #pragma once
 
+#include <memory>
+
+#include "block_extent_allocator.h"
 #include "block_manager.h"
 
 namespace xllm {
@@ -25,7 +28,7 @@ class BlockManagerImpl : public BlockManager {
   explicit BlockManagerImpl(const Options& options);
   virtual ~BlockManagerImpl() {
     prefix_cache_.reset();
-    CHECK_EQ(num_free_blocks_, free_blocks_.size() - 1)
+    CHECK_EQ(num_free_blocks_, num_total_blocks())
         << "Not all blocks have been freed";
   };
 
@@ -96,7 +99,7 @@ class BlockManagerImpl : public BlockManager {
   Block allocate() override;
 
   // total blocks num
-  size_t num_total_blocks() const override { return free_blocks_.size() - 1; }
+  size_t num_total_blocks() const override { return num_blocks_ - 1; }
 
  protected:
   // Flip a block's entry in `usage_ids` from 0 to 1. Returns true if the flip
@@ -111,6 +114,13 @@ class BlockManagerImpl : public BlockManager {
   // from the prefix cache
   bool has_enough_blocks(uint32_t num_blocks);
 
+  // allocate num_blocks blocks, continuing from hint when the extent
+  // allocator is enabled and hint is free.
+  std::vector<Block> allocate_with_hint(size_t num_blocks, int32_t hint);
+
+  // pop a free block id, from the extent allocator or the LIFO free list.
+  int32_t pop_free_block_id();
+
  protected:
   // prefix cache
   std::unique_ptr<PrefixCache> prefix_cache_;
@@ -127,9 +137,15 @@ class BlockManagerImpl : public BlockManager {
   // block size
   size_t block_size_ = 0;
 
-  // free block list
+  // total number of blocks, including the padding block
+  size_t num_blocks_ = 0;
+
+  // free block list, used unless enable_contiguous_block_allocation is set
   std::vector<int32_t> free_blocks_;
 
+  // free block extents, used when enable_contiguous_block_allocation is set
+  std::unique_ptr<BlockExtentAllocator> extent_allocator_;
+
   // Whether a block is already counted in num_used_blocks_.
   std::vector<uint8_t> usage_accounted_ids_;
 };
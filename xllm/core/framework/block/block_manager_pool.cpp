@@ -57,7 +57,10 @@ BlockManagerPool::BlockManagerPool(const Options& options, int32_t dp_size)
       .enable_linear_state(options_.enable_linear_state())
       .linear_state_num_slots(options_.linear_state_num_slots())
       .num_speculative_tokens(options_.num_speculative_tokens())
-      .instance_is_decode(options_.instance_is_decode());
+      .instance_is_decode(options_.instance_is_decode())
+      .enable_contiguous_block_allocation(
+          ::xllm::KVCacheConfig::get_instance()
+              .enable_contiguous_block_allocation());
 
   for (int32_t i = 0; i < dp_size; ++i) {
     // The pool always holds a CompositeBlockManager. Its KV leaf is a flat
@@ -366,6 +366,41 @@ void HierarchyBlockManagerPool::deallocate(Sequence* sequence) {
   sequence->reset();
 }
 
+void HierarchyBlockManagerPool::preempt(Sequence* sequence, bool swap_out) {
+  CHECK(sequence != nullptr);
+  const int32_t dp_rank = BlockManagerPool::get_dp_rank(sequence);
+  if (!swap_out) {
+    // Without Host blocks deallocate() has nothing to offload, so a victim
+    // that is cheap to recompute does not take PCIe bandwidth and Host
+    // capacity from the rest of the burst.
+    release_host_match(sequence, dp_rank);
+    deallocate(sequence);
+    return;
+  }
+
+  // The Host mirror grows best-effort during allocate(); complete it over
+  // every computed block so that deallocate() offloads all of them into the
+  // Host prefix cache, where the resumed prefill finds them again.
+  const size_t computed_tokens = sequence->kv_state().kv_cache_tokens_num();
+  KVCacheState& host_state = sequence->host_kv_state();
+  for (auto& [type, entry] : host_block_managers_[dp_rank]) {
+    BlockManager* leaf = entry.leaf.get();
+    std::optional<std::vector<Block>> blocks =
+        leaf->allocate_for_sequence(sequence, host_state, computed_tokens);
+    if (!blocks.has_value()) {
+      VLOG(1) << "[HostCache][Preempt] no Host room to swap out sequence "
+              << sequence->seq_id()
+              << ", type=" << static_cast<int32_t>(type);
+      continue;
+    }
+    if (!blocks->empty()) {
+      host_state.add_blocks(type, *blocks);
+    }
+    leaf->release_out_of_window(sequence, host_state);
+  }
+  deallocate(sequence);
+}
+
 void HierarchyBlockManagerPool::collect_offload_pairs(Sequence* sequence,
                                                       int32_t dp_rank,
                                                       size_t completed_tokens) {
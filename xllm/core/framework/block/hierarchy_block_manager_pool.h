@@ -61,6 +61,11 @@ class HierarchyBlockManagerPool : public BlockManagerPool {
 
   void deallocate(Sequence* sequence) override;
 
+  bool supports_swap_preemption() const override {
+    return options_.enable_prefix_cache();
+  }
+  void preempt(Sequence* sequence, bool swap_out) override;
+
   void transfer_blocks(std::vector<Batch>& batches) override;
   void transfer_blocks() override;
 
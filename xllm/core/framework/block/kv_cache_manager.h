@@ -54,6 +54,14 @@ class KVCacheManager {
   virtual void deallocate(std::vector<Sequence*>& sequences) = 0;
   virtual void deallocate(Sequence* sequence) = 0;
 
+  // Releases the blocks of a preempted sequence. With swap_out, a manager with
+  // a host tier first saves every computed block there, so that resuming
+  // restores them by H2D copies instead of recomputing the prefill.
+  virtual bool supports_swap_preemption() const { return false; }
+  virtual void preempt(Sequence* sequence, bool /*swap_out*/) {
+    deallocate(sequence);
+  }
+
   virtual void allocate_shared(Sequence* sequence) = 0;
   virtual bool supports_host_cache_restore() const { return false; }
   virtual bool has_pending_async_block_release() const { return false; }
@@ -44,6 +44,16 @@ DEFINE_bool(enable_service_routing,
 
 DEFINE_double(heart_beat_interval, 0.5, "Heart beat interval.");
 
+DEFINE_bool(enable_kv_cache_summary,
+            false,
+            "Whether to report cached KV blocks to xllm service as a counting "
+            "Bloom filter delta in each heartbeat.");
+
+DEFINE_int32(kv_cache_summary_num_counters,
+             1048576,
+             "Number of counters of the KV cache summary. Larger summaries "
+             "give fewer false prefix matches.");
+
 DEFINE_int32(etcd_ttl, 3, "Time to live for etcd.");
 
 namespace xllm {
@@ -57,6 +67,8 @@ void DistributedConfig::from_flags() {
   XLLM_CONFIG_ASSIGN_FROM_FLAG(etcd_namespace);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_service_routing);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(heart_beat_interval);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_kv_cache_summary);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(kv_cache_summary_num_counters);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(etcd_ttl);
 }
 
@@ -70,6 +82,8 @@ void DistributedConfig::from_json(const JsonReader& json) {
   XLLM_CONFIG_ASSIGN_FROM_JSON(etcd_namespace);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_service_routing);
   XLLM_CONFIG_ASSIGN_FROM_JSON(heart_beat_interval);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(enable_kv_cache_summary);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(kv_cache_summary_num_counters);
   XLLM_CONFIG_ASSIGN_FROM_JSON(etcd_ttl);
 }
 
@@ -92,6 +106,10 @@ void DistributedConfig::append_config_json(
       config_json, default_config, enable_service_routing);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, heart_beat_interval);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, enable_kv_cache_summary);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, kv_cache_summary_num_counters);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, etcd_ttl);
 }
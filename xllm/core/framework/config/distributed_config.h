@@ -39,16 +39,19 @@ class DistributedConfig final {
   void initialize();
 
   [[nodiscard]] static const OptionCategory& option_category() {
-    static const OptionCategory kOptionCategory = {"DISTRIBUTED OPTIONS",
-                                                   {"master_node_addr",
-                                                    "xtensor_master_node_addr",
-                                                    "nnodes",
-                                                    "node_rank",
-                                                    "etcd_addr",
-                                                    "etcd_namespace",
-                                                    "enable_service_routing",
-                                                    "heart_beat_interval",
-                                                    "etcd_ttl"}};
+    static const OptionCategory kOptionCategory = {
+        "DISTRIBUTED OPTIONS",
+        {"master_node_addr",
+         "xtensor_master_node_addr",
+         "nnodes",
+         "node_rank",
+         "etcd_addr",
+         "etcd_namespace",
+         "enable_service_routing",
+         "heart_beat_interval",
+         "enable_kv_cache_summary",
+         "kv_cache_summary_num_counters",
+         "etcd_ttl"}};
     return kOptionCategory;
   }
 
@@ -68,6 +71,10 @@ class DistributedConfig final {
 
   PROPERTY(double, heart_beat_interval) = 0.5;
 
+  PROPERTY(bool, enable_kv_cache_summary) = false;
+
+  PROPERTY(int32_t, kv_cache_summary_num_counters) = 1048576;
+
   PROPERTY(int32_t, etcd_ttl) = 3;
 };
 
@@ -113,6 +113,18 @@ DEFINE_int64(dit_sparse_attention_mask_refresh_steps,
              "Sparse attention: recompute block sparse mask every N diffusion "
              "steps. 1 = every step (default), higher = reuse mask longer.");
 
+DEFINE_bool(dit_step_batching,
+            false,
+            "Whether to batch DiT requests per denoising step, so that "
+            "requests join and leave the running batch at step boundaries. "
+            "Requires a pipeline with step support (e.g. Flux) and "
+            "dit_cache_policy=None.");
+
+DEFINE_int64(dit_text_embedding_cache_size,
+             0,
+             "Max size (MB) of the text encoder embedding cache shared by "
+             "the DiT requests of a worker. 0 disables the cache.");
+
 DEFINE_int32(
     max_sequence_length,
     0,
@@ -143,6 +155,8 @@ void DiTConfig::from_flags() {
   XLLM_CONFIG_ASSIGN_FROM_FLAG(dit_sparse_attention_sparse_start_step);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(dit_sparse_attention_version);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(dit_sparse_attention_mask_refresh_steps);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(dit_step_batching);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(dit_text_embedding_cache_size);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(max_sequence_length);
 }
 
@@ -169,6 +183,8 @@ void DiTConfig::from_json(const JsonReader& json) {
   XLLM_CONFIG_ASSIGN_FROM_JSON(dit_sparse_attention_sparse_start_step);
   XLLM_CONFIG_ASSIGN_FROM_JSON(dit_sparse_attention_version);
   XLLM_CONFIG_ASSIGN_FROM_JSON(dit_sparse_attention_mask_refresh_steps);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(dit_step_batching);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(dit_text_embedding_cache_size);
   XLLM_CONFIG_ASSIGN_FROM_JSON(max_sequence_length);
 }
 
@@ -218,6 +234,10 @@ void DiTConfig::append_config_json(nlohmann::ordered_json& config_json) const {
       config_json, default_config, dit_sparse_attention_version);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, dit_sparse_attention_mask_refresh_steps);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, dit_step_batching);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, dit_text_embedding_cache_size);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, max_sequence_length);
 }
@@ -63,6 +63,8 @@ class DiTConfig final {
          "dit_sparse_attention_sparse_start_step",
          "dit_sparse_attention_version",
          "dit_sparse_attention_mask_refresh_steps",
+         "dit_step_batching",
+         "dit_text_embedding_cache_size",
          "max_sequence_length"}};
     return kOptionCategory;
   }
@@ -111,6 +113,10 @@ class DiTConfig final {
 
   PROPERTY(int64_t, dit_sparse_attention_mask_refresh_steps) = 1;
 
+  PROPERTY(bool, dit_step_batching) = false;
+
+  PROPERTY(int64_t, dit_text_embedding_cache_size) = 0;
+
   PROPERTY(int32_t, max_sequence_length) = 0;
 };
 
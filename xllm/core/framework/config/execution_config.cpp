@@ -42,6 +42,19 @@ DEFINE_bool(enable_graph_mode_decode_no_padding,
             "padding. If true, graph will be captured with every actual num "
             "tokens, as stride is 1.");
 
+DEFINE_bool(enable_adaptive_decode_graph_buckets,
+            false,
+            "Whether to add decode graph buckets at the batch sizes the "
+            "workload actually runs. Decode batch sizes are recorded, and "
+            "while the scheduler is idle the buckets minimizing padding are "
+            "solved and captured. Ignored with no-padding decode graphs, "
+            "data parallelism, multiple nodes or spawned worker processes.");
+
+DEFINE_int32(adaptive_decode_graph_bucket_budget,
+             8,
+             "Maximum number of decode graphs captured by adaptive bucket "
+             "tuning in addition to the default buckets.");
+
 DEFINE_bool(enable_prefill_piecewise_graph,
             false,
             "Whether to enable piecewise graph execution for prefill phase "
@@ -102,6 +115,8 @@ void ExecutionConfig::from_flags() {
   XLLM_CONFIG_ASSIGN_FROM_FLAG(disable_graph_warmup);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_graph_double_buffer);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_graph_mode_decode_no_padding);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_adaptive_decode_graph_buckets);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(adaptive_decode_graph_bucket_budget);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_prefill_piecewise_graph);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_graph_vmm_pool);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(max_tokens_for_graph_mode);
@@ -119,6 +134,8 @@ void ExecutionConfig::from_json(const JsonReader& json) {
   XLLM_CONFIG_ASSIGN_FROM_JSON(disable_graph_warmup);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_graph_double_buffer);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_graph_mode_decode_no_padding);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(enable_adaptive_decode_graph_buckets);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(adaptive_decode_graph_bucket_budget);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_prefill_piecewise_graph);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_graph_vmm_pool);
   XLLM_CONFIG_ASSIGN_FROM_JSON(max_tokens_for_graph_mode);
@@ -142,6 +159,10 @@ void ExecutionConfig::append_config_json(
       config_json, default_config, enable_graph_double_buffer);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, enable_graph_mode_decode_no_padding);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, enable_adaptive_decode_graph_buckets);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, adaptive_decode_graph_bucket_budget);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, enable_prefill_piecewise_graph);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
@@ -45,6 +45,8 @@ class ExecutionConfig final {
          "disable_graph_warmup",
          "enable_graph_double_buffer",
          "enable_graph_mode_decode_no_padding",
+         "enable_adaptive_decode_graph_buckets",
+         "adaptive_decode_graph_bucket_budget",
          "enable_prefill_piecewise_graph",
          "enable_graph_vmm_pool",
          "max_tokens_for_graph_mode",
@@ -66,6 +68,10 @@ class ExecutionConfig final {
 
   PROPERTY(bool, enable_graph_mode_decode_no_padding) = false;
 
+  PROPERTY(bool, enable_adaptive_decode_graph_buckets) = false;
+
+  PROPERTY(int32_t, adaptive_decode_graph_bucket_budget) = 8;
+
   PROPERTY(bool, enable_prefill_piecewise_graph) = false;
 
   PROPERTY(bool, enable_graph_vmm_pool) = true;
@@ -75,6 +75,12 @@ DEFINE_int64(
     "Granularity size for one physical page in bytes, default 2MB, when enable "
     "continuous kv cache.");
 
+DEFINE_bool(enable_contiguous_block_allocation,
+            false,
+            "Whether to allocate KV cache blocks from contiguous free extents, "
+            "so transfers of a sequence merge adjacent blocks into fewer "
+            "regions.");
+
 namespace xllm {
 
 void KVCacheConfig::from_flags() {
@@ -89,6 +95,7 @@ void KVCacheConfig::from_flags() {
   XLLM_CONFIG_ASSIGN_FROM_FLAG(xxh3_128bits_seed);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_xtensor);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(phy_page_granularity_size);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_contiguous_block_allocation);
 }
 
 void KVCacheConfig::from_json(const JsonReader& json) {
@@ -103,6 +110,7 @@ void KVCacheConfig::from_json(const JsonReader& json) {
   XLLM_CONFIG_ASSIGN_FROM_JSON(xxh3_128bits_seed);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_xtensor);
   XLLM_CONFIG_ASSIGN_FROM_JSON(phy_page_granularity_size);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(enable_contiguous_block_allocation);
 }
 
 void KVCacheConfig::append_config_json(
@@ -130,6 +138,8 @@ void KVCacheConfig::append_config_json(
       config_json, default_config, enable_xtensor);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, phy_page_granularity_size);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, enable_contiguous_block_allocation);
 }
 
 KVCacheConfig& KVCacheConfig::get_instance() {
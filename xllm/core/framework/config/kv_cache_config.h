@@ -52,7 +52,8 @@ class KVCacheConfig final {
          "max_linear_state_cache_slots",
          "xxh3_128bits_seed",
          "enable_xtensor",
-         "phy_page_granularity_size"}};
+         "phy_page_granularity_size",
+         "enable_contiguous_block_allocation"}};
     return kOptionCategory;
   }
 
@@ -77,6 +78,8 @@ class KVCacheConfig final {
   PROPERTY(bool, enable_xtensor) = false;
 
   PROPERTY(int64_t, phy_page_granularity_size) = 2 * 1024 * 1024;
+
+  PROPERTY(bool, enable_contiguous_block_allocation) = false;
 };
 
 }  // namespace xllm
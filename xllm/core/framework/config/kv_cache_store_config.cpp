@@ -38,7 +38,8 @@ DEFINE_bool(enable_kvcache_store, false, "Whether to use kvcache store.");
 
 DEFINE_string(store_protocol,
               "tcp",
-              "KV cache store protocol(e.g. tcp, rdma).");
+              "KV cache store protocol(e.g. tcp, rdma). local keeps the store "
+              "in process, for development and benchmarks.");
 
 DEFINE_string(store_master_server_address,
               "",
@@ -53,10 +54,44 @@ DEFINE_string(store_local_hostname,
               "",
               "The local host name of the kv cache store client.");
 
+DEFINE_uint32(store_local_capacity_gb,
+              64,
+              "Capacity of the in-process store used with "
+              "--store_protocol=local, in GiB, shared by the workers of a "
+              "process. 0 means unbounded.");
+
+DEFINE_double(store_local_bandwidth_gbps,
+              0.0,
+              "Simulated link bandwidth of the in-process store, in Gbit/s, "
+              "shared by the workers of a process. 0 means no transfer "
+              "cost.");
+
+DEFINE_uint32(store_local_latency_us,
+              0,
+              "Simulated round-trip latency of each in-process store batch "
+              "call, in microseconds.");
+
 DEFINE_bool(enable_control_h2d_block_num,
             false,
             "Whether to control h2d copy block num.");
 
+DEFINE_string(kv_cache_disk_path,
+              "",
+              "Directory on a local NVMe/SSD for a KV cache tier behind the "
+              "Host cache. Empty disables the disk tier.");
+
+DEFINE_uint32(kv_cache_disk_capacity_gb,
+              64,
+              "Disk space per worker for the local KV cache disk tier, in "
+              "GiB.");
+
+DEFINE_string(kv_cache_tier_codec,
+              "none",
+              "Encoding of KV blocks in the tiers behind the Host cache: "
+              "none, int8 (lossy, about half size) or lossless (zstd, disk "
+              "tier only). The Host cache keeps raw blocks, so its capacity "
+              "is unchanged.");
+
 namespace xllm {
 
 void KVCacheStoreConfig::from_flags() {
@@ -69,7 +104,13 @@ void KVCacheStoreConfig::from_flags() {
   XLLM_CONFIG_ASSIGN_FROM_FLAG(store_master_server_address);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(store_metadata_server);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(store_local_hostname);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(store_local_capacity_gb);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(store_local_bandwidth_gbps);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(store_local_latency_us);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_control_h2d_block_num);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(kv_cache_disk_path);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(kv_cache_disk_capacity_gb);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(kv_cache_tier_codec);
 }
 
 void KVCacheStoreConfig::from_json(const JsonReader& json) {
@@ -82,7 +123,13 @@ void KVCacheStoreConfig::from_json(const JsonReader& json) {
   XLLM_CONFIG_ASSIGN_FROM_JSON(store_master_server_address);
   XLLM_CONFIG_ASSIGN_FROM_JSON(store_metadata_server);
   XLLM_CONFIG_ASSIGN_FROM_JSON(store_local_hostname);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(store_local_capacity_gb);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(store_local_bandwidth_gbps);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(store_local_latency_us);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_control_h2d_block_num);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(kv_cache_disk_path);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(kv_cache_disk_capacity_gb);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(kv_cache_tier_codec);
 }
 
 void KVCacheStoreConfig::append_config_json(
@@ -106,8 +153,20 @@ void KVCacheStoreConfig::append_config_json(
       config_json, default_config, store_metadata_server);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, store_local_hostname);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, store_local_capacity_gb);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, store_local_bandwidth_gbps);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, store_local_latency_us);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, enable_control_h2d_block_num);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, kv_cache_disk_path);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, kv_cache_disk_capacity_gb);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, kv_cache_tier_codec);
 }
 
 KVCacheStoreConfig& KVCacheStoreConfig::get_instance() {
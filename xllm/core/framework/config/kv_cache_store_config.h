@@ -50,7 +50,13 @@ class KVCacheStoreConfig final {
          "store_master_server_address",
          "store_metadata_server",
          "store_local_hostname",
-         "enable_control_h2d_block_num"}};
+         "store_local_capacity_gb",
+         "store_local_bandwidth_gbps",
+         "store_local_latency_us",
+         "enable_control_h2d_block_num",
+         "kv_cache_disk_path",
+         "kv_cache_disk_capacity_gb",
+         "kv_cache_tier_codec"}};
     return kOptionCategory;
   }
 
@@ -72,7 +78,19 @@ class KVCacheStoreConfig final {
 
   PROPERTY(std::string, store_local_hostname);
 
+  PROPERTY(uint32_t, store_local_capacity_gb) = 64;
+
+  PROPERTY(double, store_local_bandwidth_gbps) = 0.0;
+
+  PROPERTY(uint32_t, store_local_latency_us) = 0;
+
   PROPERTY(bool, enable_control_h2d_block_num) = false;
+
+  PROPERTY(std::string, kv_cache_disk_path);
+
+  PROPERTY(uint32_t, kv_cache_disk_capacity_gb) = 64;
+
+  PROPERTY(std::string, kv_cache_tier_codec) = "none";
 };
 
 }  // namespace xllm
@@ -97,6 +97,29 @@ DEFINE_bool(
     false,
     "Whether to decode both audio and video when the input is a video.");
 
+DEFINE_int64(image_decode_max_pixels,
+             0,
+             "Decode JPEG images at a reduced 1/2, 1/4 or 1/8 scale while "
+             "they keep at least this many pixels. Set it well above the "
+             "vision processor's max_pixels. 0 decodes at full resolution.");
+
+DEFINE_double(video_decode_fps,
+              0.0,
+              "Decode only every n-th video frame such that the kept frames "
+              "run at no less than this rate, seeking past GOPs without a "
+              "kept frame. Set it to the vision processor's sampling fps. "
+              "0 decodes every frame.");
+
+DEFINE_int64(video_decode_max_pixels,
+             0,
+             "Downscale decoded video frames to at most this many pixels "
+             "during the RGB conversion. 0 keeps the coded size.");
+
+DEFINE_int32(video_decode_threads,
+             1,
+             "Number of FFmpeg threads per video decode. 0 lets FFmpeg "
+             "choose.");
+
 // NOTE: This is an experimental flag,
 //       it needs to be removed after the function is stable.
 DEFINE_bool(use_cpp_chat_template,
@@ -137,6 +160,10 @@ void ModelConfig::from_flags() {
   XLLM_CONFIG_ASSIGN_FROM_FLAG(mm_download_headers);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(flashinfer_workspace_buffer_size);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(use_audio_in_video);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(image_decode_max_pixels);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(video_decode_fps);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(video_decode_max_pixels);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(video_decode_threads);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(use_cpp_chat_template);
 }
 
@@ -188,6 +215,10 @@ void ModelConfig::from_json(const JsonReader& json) {
   XLLM_CONFIG_ASSIGN_FROM_JSON(mm_download_headers);
   XLLM_CONFIG_ASSIGN_FROM_JSON(flashinfer_workspace_buffer_size);
   XLLM_CONFIG_ASSIGN_FROM_JSON(use_audio_in_video);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(image_decode_max_pixels);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(video_decode_fps);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(video_decode_max_pixels);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(video_decode_threads);
   XLLM_CONFIG_ASSIGN_FROM_JSON(use_cpp_chat_template);
 }
 
@@ -220,6 +251,14 @@ void ModelConfig::append_config_json(
       config_json, default_config, flashinfer_workspace_buffer_size);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, use_audio_in_video);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, image_decode_max_pixels);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, video_decode_fps);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, video_decode_max_pixels);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, video_decode_threads);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, use_cpp_chat_template);
 }
@@ -66,6 +66,10 @@ class ModelConfig final {
          "mm_download_headers",
          "flashinfer_workspace_buffer_size",
          "use_audio_in_video",
+         "image_decode_max_pixels",
+         "video_decode_fps",
+         "video_decode_max_pixels",
+         "video_decode_threads",
          "use_cpp_chat_template"}};
     return kOptionCategory;
   }
@@ -102,6 +106,14 @@ class ModelConfig final {
 
   PROPERTY(bool, use_audio_in_video) = false;
 
+  PROPERTY(int64_t, image_decode_max_pixels) = 0;
+
+  PROPERTY(double, video_decode_fps) = 0.0;
+
+  PROPERTY(int64_t, video_decode_max_pixels) = 0;
+
+  PROPERTY(int32_t, video_decode_threads) = 1;
+
   PROPERTY(bool, use_cpp_chat_template) = true;
 };
 
@@ -32,6 +32,11 @@ DEFINE_bool(enable_latency_aware_schedule,
             false,
             "use predicted latency for latency aware schedule.");
 
+DEFINE_bool(enable_adaptive_prefill_chunk,
+            false,
+            "Whether to size prefill chunks from the profiled step time so "
+            "that a step fits the remaining latency budget.");
+
 DEFINE_int32(profile_max_prompt_length,
              2048,
              "The max prompt length for profile.");
@@ -77,12 +82,23 @@ DEFINE_string(profile_dir,
               "Directory the 'torch' online profiling backend writes timeline "
               "traces to. Empty means the current working directory.");
 
+DEFINE_bool(enable_flight_recorder,
+            true,
+            "Whether to keep the most recent scheduler steps and request "
+            "events in memory for /flight_recorder.");
+
+DEFINE_int32(flight_recorder_capacity,
+             32768,
+             "Number of events kept by the flight recorder; rounded up to a "
+             "power of two.");
+
 namespace xllm {
 
 void ProfileConfig::from_flags() {
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_profile_step_time);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_profile_token_budget);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_latency_aware_schedule);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_adaptive_prefill_chunk);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(profile_max_prompt_length);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(max_global_ttft_ms);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(max_global_tpot_ms);
@@ -92,12 +108,15 @@ void ProfileConfig::from_flags() {
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_online_profile);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(profile_backend);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(profile_dir);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_flight_recorder);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(flight_recorder_capacity);
 }
 
 void ProfileConfig::from_json(const JsonReader& json) {
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_profile_step_time);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_profile_token_budget);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_latency_aware_schedule);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(enable_adaptive_prefill_chunk);
   XLLM_CONFIG_ASSIGN_FROM_JSON(profile_max_prompt_length);
   XLLM_CONFIG_ASSIGN_FROM_JSON(max_global_ttft_ms);
   XLLM_CONFIG_ASSIGN_FROM_JSON(max_global_tpot_ms);
@@ -107,6 +126,8 @@ void ProfileConfig::from_json(const JsonReader& json) {
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_online_profile);
   XLLM_CONFIG_ASSIGN_FROM_JSON(profile_backend);
   XLLM_CONFIG_ASSIGN_FROM_JSON(profile_dir);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(enable_flight_recorder);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(flight_recorder_capacity);
 }
 
 void ProfileConfig::append_config_json(
@@ -118,6 +139,8 @@ void ProfileConfig::append_config_json(
       config_json, default_config, enable_profile_token_budget);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, enable_latency_aware_schedule);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, enable_adaptive_prefill_chunk);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, profile_max_prompt_length);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
@@ -136,6 +159,10 @@ void ProfileConfig::append_config_json(
       config_json, default_config, profile_backend);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, profile_dir);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, enable_flight_recorder);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, flight_recorder_capacity);
 }
 
 ProfileConfig& ProfileConfig::get_instance() {
@@ -45,6 +45,7 @@ class ProfileConfig final {
         {"enable_profile_step_time",
          "enable_profile_token_budget",
          "enable_latency_aware_schedule",
+         "enable_adaptive_prefill_chunk",
          "profile_max_prompt_length",
          "max_global_ttft_ms",
          "max_global_tpot_ms",
@@ -53,7 +54,9 @@ class ProfileConfig final {
          "enable_forward_interruption",
          "enable_online_profile",
          "profile_backend",
-         "profile_dir"}};
+         "profile_dir",
+         "enable_flight_recorder",
+         "flight_recorder_capacity"}};
     return kOptionCategory;
   }
 
@@ -63,6 +66,10 @@ class ProfileConfig final {
 
   PROPERTY(bool, enable_latency_aware_schedule) = false;
 
+  // Caps each chunked prefill at the length the step time model predicts
+  // still fits the step's latency budget (max_global_tpot_ms with decodes).
+  PROPERTY(bool, enable_adaptive_prefill_chunk) = false;
+
   PROPERTY(int32_t, profile_max_prompt_length) = 2048;
 
   PROPERTY(int32_t, max_global_ttft_ms) = std::numeric_limits<int32_t>::max();
@@ -90,6 +97,12 @@ class ProfileConfig final {
   // Directory the "torch" backend writes timeline traces to. Empty means the
   // current working directory. Mirrors vLLM's torch_profiler_dir.
   PROPERTY(std::string, profile_dir) = "";
+
+  // Always-on ring of recent scheduler steps and request events, served as
+  // Chrome trace JSON on /flight_recorder.
+  PROPERTY(bool, enable_flight_recorder) = true;
+
+  PROPERTY(int32_t, flight_recorder_capacity) = 32768;
 };
 
 }  // namespace xllm
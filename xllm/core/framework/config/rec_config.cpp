@@ -80,6 +80,19 @@ DEFINE_uint32(rec_worker_max_concurrency,
               "Concurrency for rec worker parallel execution. Less than or "
               "equal to 1 means disable concurrent rec worker.");
 
+DEFINE_int32(rec_vocab_reload_interval_s,
+             0,
+             "Interval in seconds to poll the REC vocab file for changes and "
+             "hot-reload the item catalog. A file renamed into place is "
+             "loaded at the next poll, a file rewritten in place once it is "
+             "unchanged for one more interval. 0 means disabled.");
+
+DEFINE_bool(enable_rec_device_constraint_mask,
+            false,
+            "Upload the REC constraint tables to the device once and build "
+            "constrained decoding masks there from batched prefix tokens, "
+            "instead of per-sequence host lookups.");
+
 namespace xllm {
 
 void RecConfig::from_flags() {
@@ -96,6 +109,8 @@ void RecConfig::from_flags() {
   XLLM_CONFIG_ASSIGN_FROM_FLAG(total_conversion_threshold);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(request_queue_size);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(rec_worker_max_concurrency);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(rec_vocab_reload_interval_s);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_rec_device_constraint_mask);
 }
 
 void RecConfig::from_json(const JsonReader& json) {
@@ -112,6 +127,8 @@ void RecConfig::from_json(const JsonReader& json) {
   XLLM_CONFIG_ASSIGN_FROM_JSON(total_conversion_threshold);
   XLLM_CONFIG_ASSIGN_FROM_JSON(request_queue_size);
   XLLM_CONFIG_ASSIGN_FROM_JSON(rec_worker_max_concurrency);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(rec_vocab_reload_interval_s);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(enable_rec_device_constraint_mask);
 }
 
 void RecConfig::append_config_json(nlohmann::ordered_json& config_json) const {
@@ -142,6 +159,10 @@ void RecConfig::append_config_json(nlohmann::ordered_json& config_json) const {
       config_json, default_config, request_queue_size);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, rec_worker_max_concurrency);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, rec_vocab_reload_interval_s);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, enable_rec_device_constraint_mask);
 }
 
 RecConfig& RecConfig::get_instance() {
@@ -52,7 +52,9 @@ class RecConfig final {
          "each_conversion_threshold",
          "total_conversion_threshold",
          "request_queue_size",
-         "rec_worker_max_concurrency"}};
+         "rec_worker_max_concurrency",
+         "rec_vocab_reload_interval_s",
+         "enable_rec_device_constraint_mask"}};
     return kOptionCategory;
   }
 
@@ -81,6 +83,10 @@ class RecConfig final {
   PROPERTY(int32_t, request_queue_size) = 100000;
 
   PROPERTY(uint32_t, rec_worker_max_concurrency) = 1;
+
+  PROPERTY(int32_t, rec_vocab_reload_interval_s) = 0;
+
+  PROPERTY(bool, enable_rec_device_constraint_mask) = false;
 };
 
 }  // namespace xllm
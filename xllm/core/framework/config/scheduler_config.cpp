@@ -56,12 +56,32 @@ DEFINE_int32(
 
 DEFINE_string(priority_strategy,
               "fcfs",
-              "Priority strategy for requests(e.g. fcfs, priority, deadline).");
+              "Priority strategy for requests(e.g. fcfs, priority, deadline, "
+              "fair).");
+
+DEFINE_string(tenant_weights,
+              "",
+              "Weights of the fair priority strategy, as a comma separated "
+              "list of tenant:weight, e.g. \"a:4,b:1\". The tenant is the "
+              "user field of a request; unlisted tenants weigh 1.");
+
+DEFINE_bool(enable_slo_admission,
+            false,
+            "Whether to reject a request on arrival when the predicted "
+            "prefill time of the work queued ahead of it plus its own "
+            "prefill exceeds its ttft_slo_ms. Requires a prefill profile.");
 
 DEFINE_bool(enable_online_preempt_offline,
             true,
             "Whether to enable online preempt offline.");
 
+DEFINE_bool(enable_swap_preemption,
+            false,
+            "Whether a preempted sequence may keep its KV cache by swapping "
+            "it out to the host cache instead of recomputing it on resume. "
+            "Swap is chosen when the predicted copy time is below the "
+            "predicted prefill time. Requires host_blocks_factor > 1.");
+
 DEFINE_double(aggressive_coeff,
               1.0,
               "Aggressive coefficient for MixScheduler urgency judgment.");
@@ -87,8 +107,11 @@ void SchedulerConfig::from_flags() {
   XLLM_CONFIG_ASSIGN_FROM_FLAG(use_zero_evict);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(max_decode_token_per_sequence);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(priority_strategy);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(tenant_weights);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_slo_admission);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_mix_batch);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_online_preempt_offline);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_swap_preemption);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(aggressive_coeff);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(starve_threshold);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_starve_prevent);
@@ -105,8 +128,11 @@ void SchedulerConfig::from_json(const JsonReader& json) {
   XLLM_CONFIG_ASSIGN_FROM_JSON(use_zero_evict);
   XLLM_CONFIG_ASSIGN_FROM_JSON(max_decode_token_per_sequence);
   XLLM_CONFIG_ASSIGN_FROM_JSON(priority_strategy);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(tenant_weights);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(enable_slo_admission);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_mix_batch);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_online_preempt_offline);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(enable_swap_preemption);
   XLLM_CONFIG_ASSIGN_FROM_JSON(aggressive_coeff);
   XLLM_CONFIG_ASSIGN_FROM_JSON(starve_threshold);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_starve_prevent);
@@ -135,10 +161,16 @@ void SchedulerConfig::append_config_json(
       config_json, default_config, max_decode_token_per_sequence);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, priority_strategy);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, tenant_weights);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, enable_slo_admission);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, enable_mix_batch);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, enable_online_preempt_offline);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, enable_swap_preemption);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, aggressive_coeff);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
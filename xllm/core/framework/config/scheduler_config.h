@@ -51,8 +51,11 @@ class SchedulerConfig final {
          "use_zero_evict",
          "max_decode_token_per_sequence",
          "priority_strategy",
+         "tenant_weights",
+         "enable_slo_admission",
          "enable_mix_batch",
          "enable_online_preempt_offline",
+         "enable_swap_preemption",
          "aggressive_coeff",
          "starve_threshold",
          "enable_starve_prevent"}};
@@ -79,10 +82,16 @@ class SchedulerConfig final {
 
   PROPERTY(std::string, priority_strategy) = "fcfs";
 
+  PROPERTY(std::string, tenant_weights) = "";
+
+  PROPERTY(bool, enable_slo_admission) = false;
+
   PROPERTY(bool, enable_mix_batch) = true;
 
   PROPERTY(bool, enable_online_preempt_offline) = true;
 
+  PROPERTY(bool, enable_swap_preemption) = false;
+
   PROPERTY(double, aggressive_coeff) = 1.0;
 
   PROPERTY(double, starve_threshold) = 1.0;
@@ -43,6 +43,17 @@ DEFINE_int32(max_concurrent_requests,
              "Maximum number of concurrent requests the xllm service can "
              "handle. If set to 0, there is no limit.");
 
+DEFINE_int32(tenant_max_concurrent_requests,
+             0,
+             "Maximum number of concurrent requests of one tenant, identified "
+             "by the user field of the request. Requests without a user are "
+             "not limited per tenant. If set to 0, there is no limit.");
+
+DEFINE_int32(tenant_max_prompt_tokens_per_second,
+             0,
+             "Maximum rate of prompt tokens admitted for one tenant, with a "
+             "burst of one second. If set to 0, there is no limit.");
+
 DEFINE_int32(num_request_handling_threads,
              4,
              "Number of threads for handling input requests.");
@@ -61,6 +72,19 @@ DEFINE_bool(enable_json_object_output,
             "disabled, json_object requests are accepted without applying "
             "JSON grammar constraints.");
 
+DEFINE_int64(embedding_result_cache_size,
+             0,
+             "Max size (MB) of the exact-match cache of embedding results. "
+             "Embedding and rerank requests, including Qwen3 reranker "
+             "scores, whose prompt tokens match a cached result are "
+             "answered without being scheduled. 0 disables the cache.");
+
+DEFINE_bool(enable_offline_batch_mode,
+            false,
+            "Tokenize the prompts of an offline batch (LLM.generate) up "
+            "front and admit them ordered by shared prefix blocks and "
+            "expected length to maximize prefix cache reuse.");
+
 DEFINE_bool(enable_verbose_trace_log,
             false,
             "Enable asynchronous verbose request-trace logging to a file. When "
@@ -100,10 +124,14 @@ void ServiceConfig::from_flags() {
   XLLM_CONFIG_ASSIGN_FROM_FLAG(max_reconnect_count);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(num_threads);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(max_concurrent_requests);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(tenant_max_concurrent_requests);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(tenant_max_prompt_tokens_per_second);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(num_request_handling_threads);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(num_response_handling_threads);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(health_check_interval_ms);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_json_object_output);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(embedding_result_cache_size);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_offline_batch_mode);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_verbose_trace_log);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(verbose_trace_log_path);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(verbose_trace_log_max_size_mb);
@@ -119,10 +147,14 @@ void ServiceConfig::from_json(const JsonReader& json) {
   XLLM_CONFIG_ASSIGN_FROM_JSON(max_reconnect_count);
   XLLM_CONFIG_ASSIGN_FROM_JSON(num_threads);
   XLLM_CONFIG_ASSIGN_FROM_JSON(max_concurrent_requests);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(tenant_max_concurrent_requests);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(tenant_max_prompt_tokens_per_second);
   XLLM_CONFIG_ASSIGN_FROM_JSON(num_request_handling_threads);
   XLLM_CONFIG_ASSIGN_FROM_JSON(num_response_handling_threads);
   XLLM_CONFIG_ASSIGN_FROM_JSON(health_check_interval_ms);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_json_object_output);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(embedding_result_cache_size);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(enable_offline_batch_mode);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_verbose_trace_log);
   XLLM_CONFIG_ASSIGN_FROM_JSON(verbose_trace_log_path);
   XLLM_CONFIG_ASSIGN_FROM_JSON(verbose_trace_log_max_size_mb);
@@ -145,6 +177,10 @@ void ServiceConfig::append_config_json(
       config_json, default_config, num_threads);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, max_concurrent_requests);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, tenant_max_concurrent_requests);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, tenant_max_prompt_tokens_per_second);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, num_request_handling_threads);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
@@ -153,6 +189,10 @@ void ServiceConfig::append_config_json(
       config_json, default_config, health_check_interval_ms);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, enable_json_object_output);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, embedding_result_cache_size);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, enable_offline_batch_mode);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, enable_verbose_trace_log);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
@@ -48,10 +48,14 @@ class ServiceConfig final {
          "max_reconnect_count",
          "num_threads",
          "max_concurrent_requests",
+         "tenant_max_concurrent_requests",
+         "tenant_max_prompt_tokens_per_second",
          "num_request_handling_threads",
          "num_response_handling_threads",
          "health_check_interval_ms",
          "enable_json_object_output",
+         "embedding_result_cache_size",
+         "enable_offline_batch_mode",
          "enable_verbose_trace_log",
          "verbose_trace_log_path",
          "verbose_trace_log_max_size_mb",
@@ -73,6 +77,10 @@ class ServiceConfig final {
 
   PROPERTY(int32_t, max_concurrent_requests) = 200;
 
+  PROPERTY(int32_t, tenant_max_concurrent_requests) = 0;
+
+  PROPERTY(int32_t, tenant_max_prompt_tokens_per_second) = 0;
+
   PROPERTY(int32_t, num_request_handling_threads) = 4;
 
   PROPERTY(int32_t, num_response_handling_threads) = 4;
@@ -81,6 +89,10 @@ class ServiceConfig final {
 
   PROPERTY(bool, enable_json_object_output) = true;
 
+  PROPERTY(int64_t, embedding_result_cache_size) = 0;
+
+  PROPERTY(bool, enable_offline_batch_mode) = false;
+
   PROPERTY(bool, enable_verbose_trace_log) = false;
 
   PROPERTY(std::string, verbose_trace_log_path);
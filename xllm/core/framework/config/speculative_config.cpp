@@ -27,7 +27,7 @@ DEFINE_int32(num_speculative_tokens, 0, "Number of speculative tokens.");
 DEFINE_string(speculative_algorithm,
               "MTP",
               "Speculative decoding algorithm. Supported options: MTP, Eagle3, "
-              "Suffix, DFlash, DSpark. Default is MTP.");
+              "Suffix, NGram, DFlash, DSpark. Default is MTP.");
 
 DEFINE_int32(speculative_suffix_cache_max_depth,
              64,
@@ -55,6 +55,35 @@ DEFINE_bool(speculative_suffix_use_tree_spec,
             "Whether to use tree-based suffix speculation instead of path "
             "speculation.");
 
+DEFINE_int32(speculative_suffix_num_threads,
+             4,
+             "Number of worker threads used to build suffix speculation "
+             "drafts for a batch in parallel. 0 runs them on the worker "
+             "thread.");
+
+DEFINE_string(speculative_suffix_corpus_path,
+              "",
+              "Suffix speculation corpus file. If it exists at startup, the "
+              "global suffix tree is seeded from it (binary snapshot, or text "
+              "with one whitespace-separated token id sequence per line). "
+              "Snapshots are written back to this path.");
+
+DEFINE_int32(speculative_suffix_snapshot_interval_s,
+             0,
+             "Interval in seconds between background snapshots of the global "
+             "suffix tree corpus to --speculative_suffix_corpus_path. 0 only "
+             "snapshots at shutdown.");
+
+DEFINE_int32(speculative_ngram_min,
+             1,
+             "Minimum n-gram length matched by NGram (prompt lookup) "
+             "speculative decoding.");
+
+DEFINE_int32(speculative_ngram_max,
+             4,
+             "Maximum n-gram length matched by NGram (prompt lookup) "
+             "speculative decoding. Longer matches are tried first.");
+
 DEFINE_bool(enable_opt_validate_probs,
             false,
             "Whether validate uses selected-only draft_probs [B,S] directly. "
@@ -92,6 +121,11 @@ void SpeculativeConfig::from_flags() {
   XLLM_CONFIG_ASSIGN_FROM_FLAG(speculative_suffix_min_token_prob);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(speculative_suffix_max_cached_requests);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(speculative_suffix_use_tree_spec);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(speculative_suffix_num_threads);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(speculative_suffix_corpus_path);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(speculative_suffix_snapshot_interval_s);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(speculative_ngram_min);
+  XLLM_CONFIG_ASSIGN_FROM_FLAG(speculative_ngram_max);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_opt_validate_probs);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_mtp_draft_body_tp1);
   XLLM_CONFIG_ASSIGN_FROM_FLAG(enable_atb_spec_kernel);
@@ -109,6 +143,11 @@ void SpeculativeConfig::from_json(const JsonReader& json) {
   XLLM_CONFIG_ASSIGN_FROM_JSON(speculative_suffix_min_token_prob);
   XLLM_CONFIG_ASSIGN_FROM_JSON(speculative_suffix_max_cached_requests);
   XLLM_CONFIG_ASSIGN_FROM_JSON(speculative_suffix_use_tree_spec);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(speculative_suffix_num_threads);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(speculative_suffix_corpus_path);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(speculative_suffix_snapshot_interval_s);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(speculative_ngram_min);
+  XLLM_CONFIG_ASSIGN_FROM_JSON(speculative_ngram_max);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_opt_validate_probs);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_mtp_draft_body_tp1);
   XLLM_CONFIG_ASSIGN_FROM_JSON(enable_atb_spec_kernel);
@@ -137,6 +176,16 @@ void SpeculativeConfig::append_config_json(
       config_json, default_config, speculative_suffix_max_cached_requests);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, speculative_suffix_use_tree_spec);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, speculative_suffix_num_threads);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, speculative_suffix_corpus_path);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, speculative_suffix_snapshot_interval_s);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, speculative_ngram_min);
+  APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
+      config_json, default_config, speculative_ngram_max);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
       config_json, default_config, enable_opt_validate_probs);
   APPEND_CONFIG_JSON_VALUE_IF_NOT_DEFAULT(
@@ -47,6 +47,12 @@ class SpeculativeConfig final {
            algorithm == "DSpark";
   }
 
+  // True for the draft-model-free algorithms (Suffix, NGram) that only run the
+  // target model and build drafts on the host from token history.
+  static bool is_model_free_algorithm(std::string_view algorithm) {
+    return algorithm == "Suffix" || algorithm == "NGram";
+  }
+
   static bool is_mtp_algorithm(std::string_view algorithm) {
     return algorithm.size() == 3 &&
            (algorithm[0] == 'M' || algorithm[0] == 'm') &&
@@ -80,6 +86,11 @@ class SpeculativeConfig final {
          "speculative_suffix_min_token_prob",
          "speculative_suffix_max_cached_requests",
          "speculative_suffix_use_tree_spec",
+         "speculative_suffix_num_threads",
+         "speculative_suffix_corpus_path",
+         "speculative_suffix_snapshot_interval_s",
+         "speculative_ngram_min",
+         "speculative_ngram_max",
          "enable_opt_validate_probs",
          "enable_mtp_draft_body_tp1",
          "enable_atb_spec_kernel",
@@ -106,6 +117,16 @@ class SpeculativeConfig final {
 
   PROPERTY(bool, speculative_suffix_use_tree_spec) = false;
 
+  PROPERTY(int32_t, speculative_suffix_num_threads) = 4;
+
+  PROPERTY(std::string, speculative_suffix_corpus_path);
+
+  PROPERTY(int32_t, speculative_suffix_snapshot_interval_s) = 0;
+
+  PROPERTY(int32_t, speculative_ngram_min) = 1;
+
+  PROPERTY(int32_t, speculative_ngram_max) = 4;
+
   PROPERTY(bool, enable_opt_validate_probs) = false;
 
   PROPERTY(bool, enable_mtp_draft_body_tp1) = false;
@@ -0,0 +1,124 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/encoder_cache/embedding_result_cache.h"
+
+#include <glog/logging.h>
+
+#include <utility>
+
+#include "common/metrics.h"
+
+namespace xllm {
+
+EmbeddingResultCache::EmbeddingResultCache(int64_t max_size)
+    : max_size_(max_size) {
+  CHECK_GE(max_size, 0) << "EmbeddingResultCache max_size must be "
+                        << "non-negative";
+}
+
+XXH3Key EmbeddingResultCache::make_key(const std::string& model_id,
+                                       const std::vector<int32_t>& token_ids) {
+  std::string buffer;
+  buffer.reserve(model_id.size() + 1 + token_ids.size() * sizeof(int32_t));
+  buffer.append(model_id);
+  buffer.push_back('\0');
+  buffer.append(reinterpret_cast<const char*>(token_ids.data()),
+                token_ids.size() * sizeof(int32_t));
+  return hash_string(buffer);
+}
+
+std::optional<EmbeddingResultCache::Result> EmbeddingResultCache::lookup(
+    const XXH3Key& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EntryMap::iterator it = entries_.find(key);
+  if (it == entries_.end()) {
+    COUNTER_INC(embedding_result_cache_misses_total);
+    return std::nullopt;
+  }
+
+  COUNTER_INC(embedding_result_cache_hits_total);
+  lru_keys_.splice(lru_keys_.end(), lru_keys_, it->second.lru_it);
+  return it->second.result;
+}
+
+void EmbeddingResultCache::insert(const XXH3Key& key,
+                                  Result result,
+                                  uint64_t epoch) {
+  if (result.embedding.empty() && !result.score.has_value()) {
+    return;
+  }
+  // a score takes a few bytes, so charge its bookkeeping instead to keep the
+  // bound meaningful for rerank-only traffic.
+  const int64_t size =
+      result.embedding.empty()
+          ? static_cast<int64_t>(sizeof(Entry) + sizeof(XXH3Key))
+          : static_cast<int64_t>(result.embedding.size() * sizeof(float));
+  if (size > max_size_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (epoch != epoch_) {
+    return;
+  }
+  EntryMap::iterator it = entries_.find(key);
+  if (it != entries_.end()) {
+    // concurrent misses of the same input computed the same result.
+    lru_keys_.splice(lru_keys_.end(), lru_keys_, it->second.lru_it);
+    return;
+  }
+
+  evict_until_fit(size);
+  lru_keys_.push_back(key);
+  entries_.emplace(
+      key, Entry{std::move(result), size, std::prev(lru_keys_.end())});
+  current_size_ += size;
+}
+
+void EmbeddingResultCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  lru_keys_.clear();
+  current_size_ = 0;
+  ++epoch_;
+}
+
+uint64_t EmbeddingResultCache::epoch() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return epoch_;
+}
+
+int64_t EmbeddingResultCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return current_size_;
+}
+
+void EmbeddingResultCache::erase(EntryMap::iterator it) {
+  current_size_ -= it->second.size;
+  lru_keys_.erase(it->second.lru_it);
+  entries_.erase(it);
+}
+
+void EmbeddingResultCache::evict_until_fit(int64_t size) {
+  while (!lru_keys_.empty() && current_size_ + size > max_size_) {
+    EntryMap::iterator it = entries_.find(lru_keys_.front());
+    CHECK(it != entries_.end());
+    erase(it);
+    COUNTER_INC(embedding_result_cache_evictions_total);
+  }
+}
+
+}  // namespace xllm
@@ -0,0 +1,92 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "framework/request/usage.h"
+#include "util/hash_util.h"
+
+namespace xllm {
+
+// Exact-match cache of finished embedding results, shared by the embedding
+// and rerank requests of a master. Entries are keyed by (model id, prompt
+// token ids) and hold the pooled embedding, or the score of a logprob
+// reranker, with the usage of the request that computed it, so a repeated
+// input is answered without being scheduled. Bounded by bytes with LRU
+// eviction; thread safe.
+class EmbeddingResultCache final {
+ public:
+  struct Result {
+    std::vector<float> embedding;
+    // the Qwen3 reranker scores with the logprob of its single generated
+    // token instead of a pooled embedding.
+    std::optional<float> score;
+    int32_t score_token_id = 0;
+    Usage usage;
+  };
+
+  explicit EmbeddingResultCache(int64_t max_size);
+  ~EmbeddingResultCache() = default;
+
+  std::optional<Result> lookup(const XXH3Key& key);
+
+  // `epoch` is the value of epoch() when the result started computing; a
+  // result that raced with clear() is dropped.
+  void insert(const XXH3Key& key, Result result, uint64_t epoch);
+
+  // Drops all entries, e.g. after a weight update.
+  void clear();
+
+  uint64_t epoch() const;
+
+  // bytes held by the cached embeddings.
+  int64_t size() const;
+
+  static XXH3Key make_key(const std::string& model_id,
+                          const std::vector<int32_t>& token_ids);
+
+ private:
+  using LruList = std::list<XXH3Key>;
+
+  struct Entry {
+    Result result;
+    int64_t size = 0;
+    LruList::iterator lru_it;
+  };
+
+  using EntryMap = std::
+      unordered_map<XXH3Key, Entry, FixedStringKeyHash, FixedStringKeyEqual>;
+
+  void erase(EntryMap::iterator it);
+  void evict_until_fit(int64_t size);
+
+  const int64_t max_size_;
+
+  mutable std::mutex mutex_;
+  uint64_t epoch_ = 0;
+  int64_t current_size_ = 0;
+  LruList lru_keys_;
+  EntryMap entries_;
+};
+
+}  // namespace xllm
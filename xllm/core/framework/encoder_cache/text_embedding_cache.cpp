@@ -0,0 +1,135 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/encoder_cache/text_embedding_cache.h"
+
+#include <glog/logging.h>
+
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+#include "common/metrics.h"
+
+namespace xllm {
+
+TextEmbeddingCache& TextEmbeddingCache::get_instance() {
+  static TextEmbeddingCache cache;
+  return cache;
+}
+
+void TextEmbeddingCache::init(int64_t max_size) {
+  CHECK_GE(max_size, 0) << "TextEmbeddingCache max_size must be non-negative";
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.reset();
+  if (max_size > 0) {
+    cache_ = std::make_unique<EncoderCache>(max_size);
+  }
+}
+
+bool TextEmbeddingCache::enabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cache_ != nullptr;
+}
+
+XXH3Key TextEmbeddingCache::make_key(const std::string& encoder_id,
+                                     const torch::Device& device,
+                                     const std::vector<int32_t>& token_ids) {
+  // the padded length is part of token_ids, so different max lengths of the
+  // same prompt get different keys.
+  const std::string device_str = device.str();
+  std::string buffer;
+  buffer.reserve(encoder_id.size() + device_str.size() + 2 +
+                 token_ids.size() * sizeof(int32_t));
+  buffer.append(encoder_id);
+  buffer.push_back('\0');
+  buffer.append(device_str);
+  buffer.push_back('\0');
+  buffer.append(reinterpret_cast<const char*>(token_ids.data()),
+                token_ids.size() * sizeof(int32_t));
+  return hash_string(buffer);
+}
+
+torch::Tensor TextEmbeddingCache::encode(
+    const std::string& encoder_id,
+    const torch::Device& device,
+    const std::vector<std::vector<int32_t>>& token_ids,
+    const EncodeFn& encode_fn) {
+  const int64_t num_rows = static_cast<int64_t>(token_ids.size());
+  if (!enabled()) {
+    return encode_fn(torch::arange(num_rows, torch::kLong));
+  }
+
+  std::vector<XXH3Key> keys;
+  keys.reserve(num_rows);
+  for (const auto& ids : token_ids) {
+    keys.push_back(make_key(encoder_id, device, ids));
+  }
+
+  // rows[i] is the cached embedding of row i, or undefined on a miss.
+  // Repeated prompts within the call are encoded once.
+  std::vector<torch::Tensor> rows(num_rows);
+  std::vector<int64_t> miss_rows;
+  std::vector<int64_t> miss_slots(num_rows, -1);
+  std::unordered_map<XXH3Key, int64_t, FixedStringKeyHash, FixedStringKeyEqual>
+      miss_slot_by_key;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int64_t i = 0; i < num_rows; ++i) {
+      std::optional<torch::Tensor> cached =
+          cache_ ? cache_->lookup(keys[i]) : std::nullopt;
+      if (cached.has_value()) {
+        rows[i] = cached.value();
+        continue;
+      }
+      auto [it, inserted] = miss_slot_by_key.emplace(
+          keys[i], static_cast<int64_t>(miss_rows.size()));
+      if (inserted) {
+        miss_rows.push_back(i);
+      }
+      miss_slots[i] = it->second;
+    }
+  }
+  COUNTER_ADD(dit_text_embedding_cache_hits_total,
+              num_rows - static_cast<int64_t>(miss_rows.size()));
+  COUNTER_ADD(dit_text_embedding_cache_misses_total, miss_rows.size());
+
+  if (miss_rows.empty()) {
+    return torch::stack(rows);
+  }
+
+  torch::Tensor encoded = encode_fn(torch::tensor(miss_rows, torch::kLong));
+  CHECK_EQ(encoded.size(0), static_cast<int64_t>(miss_rows.size()))
+      << "Text encoder returned a wrong number of embeddings";
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cache_) {
+      for (size_t slot = 0; slot < miss_rows.size(); ++slot) {
+        cache_->insert(keys[miss_rows[slot]], encoded[slot]);
+      }
+    }
+  }
+  if (static_cast<int64_t>(miss_rows.size()) == num_rows) {
+    return encoded;
+  }
+  for (int64_t i = 0; i < num_rows; ++i) {
+    if (miss_slots[i] >= 0) {
+      rows[i] = encoded[miss_slots[i]];
+    }
+  }
+  return torch::stack(rows);
+}
+
+}  // namespace xllm
@@ -0,0 +1,77 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <torch/torch.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "framework/encoder_cache/encoder_cache.h"
+#include "util/hash_util.h"
+
+namespace xllm {
+
+// Process-wide cache of text encoder outputs (T5/CLIP/UMT5) for DiT
+// pipelines. Entries are single prompt rows keyed by (encoder id, device,
+// padded token ids), so a prompt repeated across requests or batches is
+// encoded once per device, and workers on different devices of the same
+// process never see each other's tensors. The encoder id must identify the
+// model weights (e.g. the encoder's component path), not just the encoder
+// architecture. Bounded by bytes with LRU eviction; disabled until init() is
+// called with a positive size.
+class TextEmbeddingCache final {
+ public:
+  // Runs the encoder on the given rows of the caller's input ids and returns
+  // one embedding per row, stacked along dim 0.
+  using EncodeFn = std::function<torch::Tensor(const torch::Tensor& rows)>;
+
+  static TextEmbeddingCache& get_instance();
+
+  // (Re)initializes the cache with max_size bytes, dropping all entries.
+  // 0 disables the cache. Call once per process: every worker of the process
+  // shares the cache.
+  void init(int64_t max_size);
+
+  bool enabled() const;
+
+  // Returns the embeddings of token_ids, stacked along dim 0 in order.
+  // encode_fn is called at most once, with the indices of the rows that miss
+  // the cache. Every row of token_ids must have the same (padded) length, and
+  // encode_fn must return tensors on device.
+  torch::Tensor encode(const std::string& encoder_id,
+                       const torch::Device& device,
+                       const std::vector<std::vector<int32_t>>& token_ids,
+                       const EncodeFn& encode_fn);
+
+  static XXH3Key make_key(const std::string& encoder_id,
+                          const torch::Device& device,
+                          const std::vector<int32_t>& token_ids);
+
+ private:
+  TextEmbeddingCache() = default;
+  TextEmbeddingCache(const TextEmbeddingCache&) = delete;
+  TextEmbeddingCache& operator=(const TextEmbeddingCache&) = delete;
+
+  mutable std::mutex mutex_;
+  std::unique_ptr<EncoderCache> cache_;
+};
+
+}  // namespace xllm
@@ -0,0 +1,618 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/kv_cache_transfer/disk_block_store.h"
+
+#include <fcntl.h>
+#include <glog/logging.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+
+namespace xllm {
+namespace {
+
+constexpr size_t kAlignment = 4096;
+constexpr uint64_t kSlotMagic = 0x31304b4c424b5658ULL;     // "XVKBLK01"
+constexpr uint64_t kJournalMagic = 0x31304c4e524a5658ULL;  // "XVJRNL01"
+constexpr uint64_t kJournalVersion = 2;
+constexpr uint32_t kJournalPut = 1;
+constexpr uint32_t kJournalErase = 2;
+
+// written at both ends of a slot; a torn write leaves them different.
+struct SlotHeader {
+  uint64_t magic;
+  uint64_t generation;
+  uint64_t schema_hash;
+  uint64_t payload_bytes;
+  uint8_t key[16];
+  uint8_t reserved[16];
+};
+static_assert(sizeof(SlotHeader) == 64);
+
+struct JournalHeader {
+  uint64_t magic;
+  uint64_t version;
+  uint64_t schema_hash;
+  uint64_t slot_bytes;
+};
+static_assert(sizeof(JournalHeader) == 32);
+
+struct JournalEntry {
+  uint32_t op;
+  uint32_t slot;
+  uint64_t generation;
+  uint8_t key[16];
+  uint64_t payload_bytes;
+};
+static_assert(sizeof(JournalEntry) == 40);
+
+size_t align_up(size_t value) {
+  return (value + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+// only the used prefix of a slot is transferred, so smaller (compressed)
+// records cost less I/O.
+size_t io_bytes(size_t payload_bytes) {
+  return align_up(2 * sizeof(SlotHeader) + payload_bytes);
+}
+
+// FNV-1a, stable across builds unlike std::hash.
+uint64_t stable_hash(const std::string& value, uint64_t seed) {
+  uint64_t hash = 0xcbf29ce484222325ULL ^ seed;
+  for (const char c : value) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+bool pwrite_full(int fd, const void* data, size_t bytes, off_t offset) {
+  const char* ptr = static_cast<const char*>(data);
+  while (bytes > 0) {
+    const ssize_t written = ::pwrite(fd, ptr, bytes, offset);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    ptr += written;
+    bytes -= static_cast<size_t>(written);
+    offset += written;
+  }
+  return true;
+}
+
+bool pread_full(int fd, void* data, size_t bytes, off_t offset) {
+  char* ptr = static_cast<char*>(data);
+  while (bytes > 0) {
+    const ssize_t read_bytes = ::pread(fd, ptr, bytes, offset);
+    if (read_bytes < 0 && errno == EINTR) {
+      continue;
+    }
+    if (read_bytes <= 0) {
+      return false;
+    }
+    ptr += read_bytes;
+    bytes -= static_cast<size_t>(read_bytes);
+    offset += read_bytes;
+  }
+  return true;
+}
+
+bool write_full(int fd, const void* data, size_t bytes) {
+  const char* ptr = static_cast<const char*>(data);
+  while (bytes > 0) {
+    const ssize_t written = ::write(fd, ptr, bytes);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    ptr += written;
+    bytes -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+}  // namespace
+
+size_t DiskBlockStore::KeyHash::operator()(const Key& key) const {
+  // keys are already uniformly distributed hashes.
+  size_t value = 0;
+  std::memcpy(&value, key.data(), sizeof(value));
+  return value;
+}
+
+size_t DiskBlockStore::slot_bytes_for(size_t record_bytes) {
+  return io_bytes(record_bytes);
+}
+
+DiskBlockStore::DiskBlockStore(const Options& options) : options_(options) {
+  CHECK(!options_.path().empty()) << "DiskBlockStore requires a file path.";
+  CHECK_GT(options_.record_bytes(), 0);
+  CHECK_GT(options_.capacity_records(), 0);
+  CHECK_LE(options_.capacity_records(), std::numeric_limits<uint32_t>::max());
+  slot_bytes_ = slot_bytes_for(options_.record_bytes());
+  schema_hash_ = stable_hash(options_.schema(), options_.record_bytes());
+}
+
+DiskBlockStore::~DiskBlockStore() {
+  if (data_fd_ >= 0) {
+    ::close(data_fd_);
+  }
+  if (journal_fd_ >= 0) {
+    ::close(journal_fd_);
+  }
+  for (void* buffer : buffers_) {
+    std::free(buffer);
+  }
+}
+
+bool DiskBlockStore::open() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK_LT(data_fd_, 0) << "DiskBlockStore is already open.";
+  slots_.assign(options_.capacity_records(), Slot{});
+  if (!open_data_file()) {
+    return false;
+  }
+  if (!replay_journal()) {
+    LOG(WARNING) << "Discarding KV disk cache journal of "
+                 << options_.path();
+    if (!reset_journal()) {
+      return false;
+    }
+  }
+
+  free_slots_.clear();
+  for (uint32_t slot_id = static_cast<uint32_t>(slots_.size()); slot_id > 0;
+       --slot_id) {
+    if (slots_[slot_id - 1].state == SlotState::kFree) {
+      free_slots_.emplace_back(slot_id - 1);
+    }
+  }
+  maybe_compact_journal();
+  LOG(INFO) << "KV disk cache " << options_.path()
+            << " opened: records=" << index_.size() << "/"
+            << options_.capacity_records() << ", slot_bytes=" << slot_bytes_
+            << ", direct_io=" << direct_io_;
+  return true;
+}
+
+bool DiskBlockStore::open_data_file() {
+  const std::string& path = options_.path();
+  if (options_.direct_io()) {
+    data_fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_DIRECT, 0644);
+    if (data_fd_ < 0) {
+      LOG(WARNING) << "O_DIRECT is not supported for " << path
+                   << ", using buffered I/O: " << std::strerror(errno);
+    }
+  }
+  direct_io_ = data_fd_ >= 0;
+  if (data_fd_ < 0) {
+    data_fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  }
+  if (data_fd_ < 0) {
+    LOG(ERROR) << "Failed to open KV disk cache " << path << ": "
+               << std::strerror(errno);
+    return false;
+  }
+
+  const off_t file_bytes =
+      static_cast<off_t>(slot_bytes_ * options_.capacity_records());
+  struct stat st;
+  if (::fstat(data_fd_, &st) == 0 && st.st_size == file_bytes) {
+    return true;
+  }
+  // reserve the extents up front so writes never hit ENOSPC mid-serving.
+  // fallocate fails instead of writing zeros where it is unsupported.
+  if (::fallocate(data_fd_, /*mode=*/0, /*offset=*/0, file_bytes) != 0) {
+    VLOG(1) << "fallocate is not supported for " << path << ": "
+            << std::strerror(errno);
+  }
+  if (::ftruncate(data_fd_, file_bytes) != 0) {
+    LOG(ERROR) << "Failed to size KV disk cache " << path << " to "
+               << file_bytes << " bytes: " << std::strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+bool DiskBlockStore::replay_journal() {
+  const std::string journal_path = options_.path() + ".journal";
+  journal_fd_ = ::open(journal_path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+  if (journal_fd_ < 0) {
+    LOG(ERROR) << "Failed to open " << journal_path << ": "
+               << std::strerror(errno);
+    return false;
+  }
+
+  struct stat st;
+  if (::fstat(journal_fd_, &st) != 0) {
+    return false;
+  }
+  if (st.st_size == 0) {
+    return reset_journal();
+  }
+  JournalHeader header;
+  if (!pread_full(journal_fd_, &header, sizeof(header), /*offset=*/0)) {
+    return false;
+  }
+  if (header.magic != kJournalMagic || header.version != kJournalVersion ||
+      header.schema_hash != schema_hash_ || header.slot_bytes != slot_bytes_) {
+    LOG(WARNING) << "KV disk cache " << options_.path()
+                 << " was written with another layout.";
+    return false;
+  }
+
+  const size_t num_entries =
+      (static_cast<size_t>(st.st_size) - sizeof(header)) /
+      sizeof(JournalEntry);
+  std::vector<JournalEntry> entries(num_entries);
+  if (num_entries > 0 &&
+      !pread_full(journal_fd_,
+                  entries.data(),
+                  num_entries * sizeof(JournalEntry),
+                  sizeof(header))) {
+    return false;
+  }
+  // drop a torn tail entry so later appends stay aligned.
+  const off_t valid_bytes =
+      static_cast<off_t>(sizeof(header) + num_entries * sizeof(JournalEntry));
+  if (st.st_size != valid_bytes && ::ftruncate(journal_fd_, valid_bytes) != 0) {
+    return false;
+  }
+
+  for (const JournalEntry& entry : entries) {
+    if (entry.slot >= slots_.size() ||
+        entry.payload_bytes > options_.record_bytes()) {
+      continue;
+    }
+    Key key;
+    std::memcpy(key.data(), entry.key, key.size());
+    Slot& slot = slots_[entry.slot];
+    if (entry.op == kJournalPut) {
+      if (slot.state == SlotState::kReady) {
+        index_.erase(slot.key);
+      }
+      auto [it, inserted] = index_.try_emplace(key, entry.slot);
+      if (!inserted) {
+        // the key moved to a new slot; the old one is free again.
+        slots_[it->second].state = SlotState::kFree;
+        it->second = entry.slot;
+      }
+      slot.key = key;
+      slot.generation = entry.generation;
+      slot.payload_bytes = entry.payload_bytes;
+      slot.state = SlotState::kReady;
+      next_generation_ = std::max(next_generation_, entry.generation + 1);
+    } else if (entry.op == kJournalErase && slot.state == SlotState::kReady &&
+               slot.key == key) {
+      index_.erase(key);
+      slot.state = SlotState::kFree;
+    }
+  }
+  journal_entries_ = num_entries;
+
+  // there is no access history on disk; newer writes count as more recent.
+  std::map<uint64_t, uint32_t> by_generation;
+  for (const auto& [key, slot_id] : index_) {
+    by_generation.emplace(slots_[slot_id].generation, slot_id);
+  }
+  for (const auto& [generation, slot_id] : by_generation) {
+    lru_.push_front(slot_id);
+    slots_[slot_id].lru_it = lru_.begin();
+  }
+  return true;
+}
+
+bool DiskBlockStore::reset_journal() {
+  index_.clear();
+  lru_.clear();
+  for (Slot& slot : slots_) {
+    slot = Slot{};
+  }
+  if (journal_fd_ >= 0) {
+    ::close(journal_fd_);
+  }
+  const std::string journal_path = options_.path() + ".journal";
+  journal_fd_ =
+      ::open(journal_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_APPEND, 0644);
+  const JournalHeader header{
+      kJournalMagic, kJournalVersion, schema_hash_, slot_bytes_};
+  if (journal_fd_ < 0 || !write_full(journal_fd_, &header, sizeof(header))) {
+    LOG(ERROR) << "Failed to create " << journal_path << ": "
+               << std::strerror(errno);
+    return false;
+  }
+  journal_entries_ = 0;
+  return true;
+}
+
+void DiskBlockStore::append_journal(uint32_t op, uint32_t slot_id) {
+  const Slot& slot = slots_[slot_id];
+  JournalEntry entry{op, slot_id, slot.generation, {}, slot.payload_bytes};
+  std::memcpy(entry.key, slot.key.data(), slot.key.size());
+  // no fsync: slot headers are verified on read, so a lost entry only loses
+  // a cached block after a crash.
+  if (!write_full(journal_fd_, &entry, sizeof(entry))) {
+    LOG(WARNING) << "Failed to append to the KV disk cache journal: "
+                 << std::strerror(errno);
+  }
+  ++journal_entries_;
+}
+
+void DiskBlockStore::maybe_compact_journal() {
+  if (journal_entries_ <= 2 * options_.capacity_records() + 1024) {
+    return;
+  }
+  const std::string journal_path = options_.path() + ".journal";
+  const std::string tmp_path = journal_path + ".tmp";
+  const int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return;
+  }
+  std::vector<char> bytes(sizeof(JournalHeader) +
+                          lru_.size() * sizeof(JournalEntry));
+  const JournalHeader header{
+      kJournalMagic, kJournalVersion, schema_hash_, slot_bytes_};
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  char* out = bytes.data() + sizeof(header);
+  // oldest first, so a replay rebuilds the same LRU order.
+  for (auto it = lru_.rbegin(); it != lru_.rend(); ++it) {
+    const Slot& slot = slots_[*it];
+    JournalEntry entry{
+        kJournalPut, *it, slot.generation, {}, slot.payload_bytes};
+    std::memcpy(entry.key, slot.key.data(), slot.key.size());
+    std::memcpy(out, &entry, sizeof(entry));
+    out += sizeof(entry);
+  }
+  const bool written = write_full(fd, bytes.data(), bytes.size());
+  ::close(fd);
+  if (!written || std::rename(tmp_path.c_str(), journal_path.c_str()) != 0) {
+    LOG(WARNING) << "Failed to compact " << journal_path;
+    ::unlink(tmp_path.c_str());
+    return;
+  }
+  const int journal_fd = ::open(journal_path.c_str(), O_RDWR | O_APPEND);
+  if (journal_fd < 0) {
+    return;
+  }
+  ::close(journal_fd_);
+  journal_fd_ = journal_fd;
+  journal_entries_ = lru_.size();
+}
+
+int64_t DiskBlockStore::acquire_slot() {
+  uint32_t slot_id = 0;
+  if (!free_slots_.empty()) {
+    slot_id = free_slots_.back();
+    free_slots_.pop_back();
+  } else {
+    auto it = std::find_if(lru_.rbegin(), lru_.rend(), [this](uint32_t id) {
+      return slots_[id].pins == 0;
+    });
+    if (it == lru_.rend()) {
+      return -1;
+    }
+    slot_id = *it;
+    append_journal(kJournalErase, slot_id);
+    drop_slot(slot_id);
+  }
+  slots_[slot_id].state = SlotState::kWriting;
+  return slot_id;
+}
+
+void DiskBlockStore::drop_slot(uint32_t slot_id) {
+  Slot& slot = slots_[slot_id];
+  CHECK(slot.state == SlotState::kReady);
+  index_.erase(slot.key);
+  lru_.erase(slot.lru_it);
+  slot.state = SlotState::kRetired;
+}
+
+void DiskBlockStore::release_pin(uint32_t slot_id, bool valid) {
+  Slot& slot = slots_[slot_id];
+  CHECK_GT(slot.pins, 0u);
+  --slot.pins;
+  if (!valid && slot.state == SlotState::kReady) {
+    append_journal(kJournalErase, slot_id);
+    drop_slot(slot_id);
+  }
+  if (slot.pins == 0 && slot.state == SlotState::kRetired) {
+    slot.state = SlotState::kFree;
+    free_slots_.emplace_back(slot_id);
+  }
+}
+
+void* DiskBlockStore::acquire_buffer() {
+  {
+    std::lock_guard<std::mutex> lock(buffer_mutex_);
+    if (!buffers_.empty()) {
+      void* buffer = buffers_.back();
+      buffers_.pop_back();
+      return buffer;
+    }
+  }
+  void* buffer = std::aligned_alloc(kAlignment, slot_bytes_);
+  CHECK(buffer != nullptr) << "Failed to allocate " << slot_bytes_
+                           << " bytes for KV disk cache I/O.";
+  return buffer;
+}
+
+void DiskBlockStore::release_buffer(void* buffer) {
+  std::lock_guard<std::mutex> lock(buffer_mutex_);
+  buffers_.emplace_back(buffer);
+}
+
+bool DiskBlockStore::put(const Key& key,
+                         const std::vector<Segment>& segments) {
+  size_t total_bytes = 0;
+  for (const Segment& segment : segments) {
+    total_bytes += segment.bytes;
+  }
+  CHECK_LE(total_bytes, options_.record_bytes());
+
+  uint32_t slot_id = 0;
+  SlotHeader header{};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (data_fd_ < 0) {
+      return false;
+    }
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      lru_.splice(lru_.begin(), lru_, slots_[it->second].lru_it);
+      return true;
+    }
+    if (writing_.count(key) > 0) {
+      return true;
+    }
+    const int64_t acquired = acquire_slot();
+    if (acquired < 0) {
+      return false;
+    }
+    slot_id = static_cast<uint32_t>(acquired);
+    Slot& slot = slots_[slot_id];
+    slot.key = key;
+    slot.generation = next_generation_++;
+    slot.payload_bytes = total_bytes;
+    writing_.emplace(key, slot_id);
+    header = SlotHeader{
+        kSlotMagic, slot.generation, schema_hash_, total_bytes, {}, {}};
+    std::memcpy(header.key, key.data(), key.size());
+  }
+
+  char* buffer = static_cast<char*>(acquire_buffer());
+  std::memcpy(buffer, &header, sizeof(header));
+  char* out = buffer + sizeof(header);
+  for (const Segment& segment : segments) {
+    std::memcpy(out, segment.data, segment.bytes);
+    out += segment.bytes;
+  }
+  std::memcpy(out, &header, sizeof(header));
+  const off_t offset =
+      static_cast<off_t>(slot_id) * static_cast<off_t>(slot_bytes_);
+  const bool written =
+      pwrite_full(data_fd_, buffer, io_bytes(total_bytes), offset);
+  release_buffer(buffer);
+  if (!written) {
+    LOG(WARNING) << "Failed to write KV disk cache slot " << slot_id << ": "
+                 << std::strerror(errno);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  writing_.erase(key);
+  Slot& slot = slots_[slot_id];
+  if (!written) {
+    slot.state = SlotState::kFree;
+    free_slots_.emplace_back(slot_id);
+    return false;
+  }
+  slot.state = SlotState::kReady;
+  index_[key] = slot_id;
+  lru_.push_front(slot_id);
+  slot.lru_it = lru_.begin();
+  append_journal(kJournalPut, slot_id);
+  maybe_compact_journal();
+  return true;
+}
+
+bool DiskBlockStore::get(const Key& key,
+                         const std::vector<Segment>& segments,
+                         size_t* payload_bytes) {
+  size_t total_bytes = 0;
+  for (const Segment& segment : segments) {
+    total_bytes += segment.bytes;
+  }
+
+  uint32_t slot_id = 0;
+  uint64_t generation = 0;
+  size_t stored_bytes = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return false;
+    }
+    slot_id = it->second;
+    Slot& slot = slots_[slot_id];
+    if (slot.payload_bytes > total_bytes) {
+      return false;
+    }
+    ++slot.pins;
+    generation = slot.generation;
+    stored_bytes = slot.payload_bytes;
+    lru_.splice(lru_.begin(), lru_, slot.lru_it);
+  }
+
+  char* buffer = static_cast<char*>(acquire_buffer());
+  const off_t offset =
+      static_cast<off_t>(slot_id) * static_cast<off_t>(slot_bytes_);
+  bool valid =
+      pread_full(data_fd_, buffer, io_bytes(stored_bytes), offset);
+  if (valid) {
+    SlotHeader header;
+    std::memcpy(&header, buffer, sizeof(header));
+    valid = header.magic == kSlotMagic && header.generation == generation &&
+            header.schema_hash == schema_hash_ &&
+            header.payload_bytes == stored_bytes &&
+            std::memcmp(header.key, key.data(), key.size()) == 0 &&
+            std::memcmp(buffer + sizeof(header) + stored_bytes,
+                        &header,
+                        sizeof(header)) == 0;
+  }
+  if (valid) {
+    const char* in = buffer + sizeof(SlotHeader);
+    size_t remaining = stored_bytes;
+    for (const Segment& segment : segments) {
+      const size_t bytes = std::min(segment.bytes, remaining);
+      std::memcpy(segment.data, in, bytes);
+      in += bytes;
+      remaining -= bytes;
+    }
+    if (payload_bytes != nullptr) {
+      *payload_bytes = stored_bytes;
+    }
+  } else {
+    LOG(WARNING) << "Dropping unreadable KV disk cache slot " << slot_id;
+  }
+  release_buffer(buffer);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  release_pin(slot_id, valid);
+  return valid;
+}
+
+bool DiskBlockStore::contains(const Key& key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return index_.count(key) > 0;
+}
+
+size_t DiskBlockStore::num_records() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return index_.size();
+}
+
+}  // namespace xllm
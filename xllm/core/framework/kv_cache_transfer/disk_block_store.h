@@ -0,0 +1,154 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace xllm {
+
+// KV block records of bounded size in one preallocated file on local
+// NVMe/SSD, keyed by the 16-byte chained prefix hash of the block.
+//
+// Every record occupies a 4 KiB aligned slot sized for the largest record.
+// The record is framed by a header carrying the key, the schema hash, the
+// payload size and a write generation, so torn or stale slots are detected
+// on read and dropped. Only the used prefix of a slot is read or written.
+// An append-only journal next to the data file records which slot holds
+// which key; it is replayed on open, so a restarted instance warm-starts
+// from its own disk cache, and it is compacted once it grows past a few
+// times the capacity. A schema change (model, parallelism, dtype, block
+// layout or codec) discards both files.
+//
+// Slots are evicted in LRU order. Reads pin their slot so it is not reused
+// underneath them, and a slot becomes visible only after its write
+// completed. put/get are thread-safe and block on file I/O; callers run
+// batches on their own thread pool.
+class DiskBlockStore final {
+ public:
+  using Key = std::array<uint8_t, 16>;
+
+  struct Segment {
+    void* data = nullptr;
+    size_t bytes = 0;
+  };
+
+  struct Options {
+    // data file; the journal lives at <path>.journal
+    PROPERTY(std::string, path);
+    // largest payload of one record, e.g. the encoded size of a block
+    PROPERTY(size_t, record_bytes) = 0;
+    PROPERTY(size_t, capacity_records) = 0;
+    // describes the block layout; records written under another schema are
+    // never returned
+    PROPERTY(std::string, schema);
+    // bypass the page cache, falls back to buffered I/O where unsupported
+    PROPERTY(bool, direct_io) = true;
+  };
+
+  explicit DiskBlockStore(const Options& options);
+  ~DiskBlockStore();
+
+  // Opens or creates the files and replays the journal. Returns false if the
+  // files can not be created or sized.
+  bool open();
+
+  // Writes the concatenated segments, at most record_bytes in total, as the
+  // record of key. Returns true if the key is stored afterwards, including
+  // when it already was.
+  bool put(const Key& key, const std::vector<Segment>& segments);
+
+  // Reads the record of key into the segments, filling them in order, and
+  // reports its size in payload_bytes. Returns false on a miss, if the
+  // segments are too small, or if the slot failed verification, in which
+  // case it is dropped.
+  bool get(const Key& key,
+           const std::vector<Segment>& segments,
+           size_t* payload_bytes = nullptr);
+
+  bool contains(const Key& key) const;
+  // on-disk bytes per record: payload, two headers, rounded up to 4 KiB
+  static size_t slot_bytes_for(size_t record_bytes);
+  size_t num_records() const;
+  size_t capacity_records() const { return options_.capacity_records(); }
+  size_t slot_bytes() const { return slot_bytes_; }
+  bool direct_io() const { return direct_io_; }
+
+ private:
+  DiskBlockStore(const DiskBlockStore&) = delete;
+  DiskBlockStore& operator=(const DiskBlockStore&) = delete;
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  enum class SlotState : uint8_t { kFree, kWriting, kReady, kRetired };
+
+  struct Slot {
+    Key key{};
+    uint64_t generation = 0;
+    uint64_t payload_bytes = 0;
+    uint32_t pins = 0;
+    SlotState state = SlotState::kFree;
+    std::list<uint32_t>::iterator lru_it;
+  };
+
+  bool open_data_file();
+  bool replay_journal();
+  bool reset_journal();
+  void append_journal(uint32_t op, uint32_t slot_id);
+  void maybe_compact_journal();
+
+  // Returns a free or evicted slot in kWriting state, or -1 if every
+  // resident slot is pinned. Requires mutex_.
+  int64_t acquire_slot();
+  // Removes a ready slot from the index and LRU list. Requires mutex_.
+  void drop_slot(uint32_t slot_id);
+  void release_pin(uint32_t slot_id, bool valid);
+
+  void* acquire_buffer();
+  void release_buffer(void* buffer);
+
+  Options options_;
+  uint64_t schema_hash_ = 0;
+  size_t slot_bytes_ = 0;
+  int data_fd_ = -1;
+  int journal_fd_ = -1;
+  bool direct_io_ = false;
+
+  mutable std::mutex mutex_;
+  std::vector<Slot> slots_;
+  std::vector<uint32_t> free_slots_;
+  std::unordered_map<Key, uint32_t, KeyHash> index_;
+  std::unordered_map<Key, uint32_t, KeyHash> writing_;
+  // most recently used at the front
+  std::list<uint32_t> lru_;
+  uint64_t next_generation_ = 1;
+  size_t journal_entries_ = 0;
+
+  std::mutex buffer_mutex_;
+  std::vector<void*> buffers_;
+};
+
+}  // namespace xllm
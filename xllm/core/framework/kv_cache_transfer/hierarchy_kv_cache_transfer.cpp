@@ -19,10 +19,13 @@ limitations under the License.
 #include <exception>
 #include <future>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "framework/kv_cache_transfer/kv_block_codec.h"
 #include "framework/kv_cache_transfer/kv_cache_store.h"
+#include "framework/kv_cache_transfer/local_disk_kv_cache_store.h"
 
 namespace xllm {
 namespace {
@@ -271,6 +274,21 @@ HierarchyKVCacheTransfer::HierarchyKVCacheTransfer(
     create_host_cache();
   }
 
+  const std::optional<KVBlockCodecType> parsed_codec =
+      parse_kv_block_codec(options_.kv_cache_tier_codec());
+  CHECK(parsed_codec.has_value())
+      << "Unsupported KV tier codec " << options_.kv_cache_tier_codec();
+  const KVBlockCodecType tier_codec = parsed_codec.value();
+  if (tier_codec != KVBlockCodecType::kNone &&
+      !options_.enable_kvcache_store() &&
+      options_.kv_cache_disk_path().empty()) {
+    // the Host cache keeps raw blocks, the codec only shrinks the disk and
+    // store tiers behind it.
+    LOG(WARNING) << "kv_cache_tier_codec=" << kv_block_codec_name(tier_codec)
+                 << " has no effect without the KV disk cache or the KV "
+                    "cache store; Host cache capacity is unchanged.";
+  }
+
   if (options_.enable_kvcache_store()) {
     CHECK(options_.host_blocks_factor() > 1.0)
         << "Mooncake Store requires Host cache capacity.";
@@ -284,6 +302,11 @@ HierarchyKVCacheTransfer::HierarchyKVCacheTransfer(
     store_config.model_id = options_.store_namespace();
     store_config.tp_rank = options_.tp_rank();
     store_config.tp_size = options_.tp_size();
+    store_config.codec = tier_codec;
+    store_config.local_capacity_bytes = options_.store_local_capacity_bytes();
+    store_config.local_bandwidth_bytes_per_second =
+        options_.store_local_bandwidth_gbps() * 1e9 / 8;
+    store_config.local_latency_us = options_.store_local_latency_us();
     LOG(INFO) << "[Mooncake][StoreEngine] initialize, endpoint="
               << store_local_hostname << ", protocol=" << store_config.protocol
               << ", tp_rank=" << store_config.tp_rank
@@ -295,6 +318,22 @@ HierarchyKVCacheTransfer::HierarchyKVCacheTransfer(
               << store_local_hostname << ", protocol=" << store_config.protocol
               << ", tp_rank=" << store_config.tp_rank;
   }
+
+  if (!options_.kv_cache_disk_path().empty()) {
+    CHECK(options_.host_blocks_factor() > 1.0)
+        << "The KV disk cache requires Host cache capacity.";
+    LocalDiskKVCacheStoreInitConfig disk_config;
+    disk_config.path = options_.kv_cache_disk_path();
+    disk_config.capacity_bytes = options_.kv_cache_disk_capacity_bytes();
+    disk_config.model_id = options_.store_namespace();
+    disk_config.worker_id = options_.store_worker_id();
+    disk_config.tp_rank = options_.tp_rank();
+    disk_config.tp_size = options_.tp_size();
+    disk_config.codec = tier_codec;
+    disk_store_ = std::make_unique<LocalDiskKVCacheStore>();
+    CHECK(disk_store_->init(disk_config, &host_kv_caches_))
+        << "Failed to initialize the KV disk cache at " << disk_config.path;
+  }
 }
 
 HierarchyKVCacheTransfer::~HierarchyKVCacheTransfer() {
@@ -513,9 +552,11 @@ uint32_t HierarchyKVCacheTransfer::transfer_kv_blocks(
     uint64_t /*batch_id*/,
     Slice<BlockTransferInfo>& block_transfer_info) {
   CHECK(!block_transfer_info.empty());
-  CHECK(kv_cache_store_ != nullptr);
+  CHECK(kv_cache_store_ != nullptr || disk_store_ != nullptr);
   if (block_transfer_info[0].transfer_type == TransferType::G2H) {
-    return kv_cache_store_->batch_get(block_transfer_info);
+    const std::vector<uint8_t> hits = prefetch_kv_blocks(block_transfer_info);
+    return static_cast<uint32_t>(
+        std::count(hits.begin(), hits.end(), static_cast<uint8_t>(1)));
   }
   LOG(ERROR) << "Unsupported slice transfer type: "
              << static_cast<uint32_t>(block_transfer_info[0].transfer_type);
@@ -525,19 +566,52 @@ uint32_t HierarchyKVCacheTransfer::transfer_kv_blocks(
 std::vector<uint8_t> HierarchyKVCacheTransfer::prefetch_kv_blocks(
     Slice<BlockTransferInfo>& block_transfer_info) {
   CHECK(!block_transfer_info.empty());
-  if (!options_.enable_kvcache_store() || kv_cache_store_ == nullptr ||
+  if ((kv_cache_store_ == nullptr && disk_store_ == nullptr) ||
       block_transfer_info[0].transfer_type != TransferType::G2H) {
     LOG(ERROR) << "Unsupported prefetch transfer type: "
                << static_cast<uint32_t>(block_transfer_info[0].transfer_type);
     return std::vector<uint8_t>(block_transfer_info.size(), /*value=*/0);
   }
-  std::vector<uint8_t> hits =
-      kv_cache_store_->batch_get_with_status(block_transfer_info);
-  const size_t hit_count =
+  std::vector<uint8_t> hits(block_transfer_info.size(), /*value=*/0);
+  if (disk_store_ != nullptr) {
+    hits = disk_store_->batch_get_with_status(block_transfer_info);
+  }
+  const size_t disk_hit_count =
       std::count(hits.begin(), hits.end(), static_cast<uint8_t>(1));
+  if (kv_cache_store_ == nullptr || disk_hit_count == hits.size()) {
+    VLOG(1) << "[DiskCache][PrefetchGet] type="
+            << static_cast<int32_t>(block_transfer_info[0].block_type)
+            << ", blocks=" << hits.size() << ", hits=" << disk_hit_count;
+    return hits;
+  }
+
+  // disk misses go to Mooncake, and its hits are kept on disk for next time.
+  std::vector<BlockTransferInfo> misses;
+  std::vector<size_t> miss_positions;
+  for (size_t i = 0; i < hits.size(); ++i) {
+    if (hits[i] == 0) {
+      misses.emplace_back(block_transfer_info[i]);
+      miss_positions.emplace_back(i);
+    }
+  }
+  Slice<BlockTransferInfo> miss_slice(misses);
+  const std::vector<uint8_t> store_hits =
+      kv_cache_store_->batch_get_with_status(miss_slice);
+  std::vector<BlockTransferInfo> fetched;
+  for (size_t i = 0; i < store_hits.size(); ++i) {
+    if (store_hits[i] == 1) {
+      hits[miss_positions[i]] = 1;
+      fetched.emplace_back(misses[i]);
+    }
+  }
+  if (disk_store_ != nullptr && !fetched.empty()) {
+    Slice<BlockTransferInfo> fetched_slice(fetched);
+    disk_store_->batch_put(fetched_slice);
+  }
   VLOG(1) << "[Mooncake][PrefetchGet] type="
           << static_cast<int32_t>(block_transfer_info[0].block_type)
-          << ", blocks=" << hits.size() << ", hits=" << hit_count;
+          << ", blocks=" << hits.size() << ", disk_hits=" << disk_hit_count
+          << ", store_hits=" << fetched.size();
   return hits;
 }
 
@@ -556,6 +630,13 @@ uint32_t HierarchyKVCacheTransfer::offload(
     LOG(ERROR) << "Offload to host failed.";
     return 0;
   }
+  if (disk_store_ != nullptr) {
+    // write-through while the host slots still hold these blocks, so host
+    // eviction never has to wait for the disk.
+    const uint32_t disk_put_count = disk_store_->batch_put(slice);
+    VLOG(1) << "[DiskCache][OffloadPut] blocks=" << block_transfer_info.size()
+            << ", success=" << disk_put_count;
+  }
   if (options_.enable_kvcache_store()) {
     CHECK(kv_cache_store_ != nullptr);
     const uint32_t put_count = kv_cache_store_->batch_put(block_transfer_info);
@@ -37,6 +37,7 @@ limitations under the License.
 
 namespace xllm {
 class KVCacheStore;
+class LocalDiskKVCacheStore;
 
 class HierarchyKVCacheTransfer {
  public:
@@ -69,8 +70,17 @@ class HierarchyKVCacheTransfer {
     PROPERTY(std::string, store_master_server_address) = "";
     PROPERTY(std::string, store_metadata_server) = "";
     PROPERTY(std::string, store_local_hostname) = "";
+    // in-process store for store_protocol "local"
+    PROPERTY(uint64_t, store_local_capacity_bytes) = 0;
+    PROPERTY(double, store_local_bandwidth_gbps) = 0.0;
+    PROPERTY(uint32_t, store_local_latency_us) = 0;
     PROPERTY(std::string, store_namespace) = "";
     PROPERTY(uint32_t, store_worker_id) = 0;
+    // local NVMe/SSD tier behind the host cache, disabled when empty
+    PROPERTY(std::string, kv_cache_disk_path) = "";
+    PROPERTY(uint64_t, kv_cache_disk_capacity_bytes) = 0;
+    // encoding of blocks behind the host cache: none, int8 or lossless
+    PROPERTY(std::string, kv_cache_tier_codec) = "none";
   };
 
   HierarchyKVCacheTransfer(const Options& options,
@@ -126,6 +136,7 @@ class HierarchyKVCacheTransfer {
 
   std::unique_ptr<BatchMemcpy> batch_memcpy_;
   std::unique_ptr<KVCacheStore> kv_cache_store_;
+  std::unique_ptr<LocalDiskKVCacheStore> disk_store_;
 
   mutable std::mutex mutex_;
   std::unordered_map<uint64_t, std::shared_ptr<LayerSynchronizer>>
@@ -0,0 +1,62 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/kv_cache_transfer/host_kv_block_codec.h"
+
+#include <glog/logging.h>
+
+#include <utility>
+#include <vector>
+
+namespace xllm {
+namespace {
+
+KVBlockElementType to_element_type(torch::ScalarType scalar_type) {
+  switch (scalar_type) {
+    case torch::kHalf:
+      return KVBlockElementType::kFloat16;
+    case torch::kBFloat16:
+      return KVBlockElementType::kBFloat16;
+    case torch::kFloat:
+      return KVBlockElementType::kFloat32;
+    default:
+      // int8 caches and their scales are already compact.
+      return KVBlockElementType::kOther;
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<KVBlockCodec> make_host_kv_block_codec(
+    KVBlockCodecType type,
+    const BlockTypeTensorMap& tensors) {
+  std::vector<KVBlockCodec::SegmentLayout> layout;
+  layout.reserve(tensors.size());
+  for (const auto& tensor_entry : tensors) {
+    const torch::Tensor& tensor = tensor_entry.second;
+    CHECK(tensor.defined() && tensor.dim() > 0);
+    KVBlockCodec::SegmentLayout segment;
+    segment.element_type = to_element_type(tensor.scalar_type());
+    segment.element_bytes = static_cast<size_t>(tensor.element_size());
+    segment.bytes =
+        static_cast<size_t>(tensor[0].numel()) * segment.element_bytes;
+    segment.group_elements =
+        tensor.dim() > 1 ? static_cast<size_t>(tensor.size(-1)) : 0;
+    layout.push_back(segment);
+  }
+  return std::make_unique<KVBlockCodec>(type, std::move(layout));
+}
+
+}  // namespace xllm
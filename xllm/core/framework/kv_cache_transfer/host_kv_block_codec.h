@@ -0,0 +1,33 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <torch/torch.h>
+
+#include <memory>
+
+#include "framework/kv_cache/kv_cache.h"
+#include "framework/kv_cache_transfer/kv_block_codec.h"
+
+namespace xllm {
+
+// Builds the codec for one host block of a block type: one segment per role
+// slice, in map order, with the head dim as the int8 scale group.
+std::unique_ptr<KVBlockCodec> make_host_kv_block_codec(
+    KVBlockCodecType type,
+    const BlockTypeTensorMap& tensors);
+
+}  // namespace xllm
@@ -0,0 +1,448 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/kv_cache_transfer/kv_block_codec.h"
+
+#include <glog/logging.h>
+#include <zstd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+namespace xllm {
+namespace {
+
+constexpr uint32_t kRecordMagic = 0x4b56424bU;  // "KBVK"
+// zstd's fastest level; KV bytes are mostly noise outside the exponent
+// planes, so higher levels cost time for little gain.
+constexpr int kZstdLevel = 1;
+
+struct RecordHeader {
+  uint32_t magic;
+  uint8_t codec;
+  uint8_t compressed;
+  uint16_t reserved;
+  uint64_t raw_bytes;
+  uint64_t payload_bytes;
+};
+static_assert(sizeof(RecordHeader) == 24);
+
+float half_to_float(uint16_t h) {
+  const uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+  uint32_t exponent = (h >> 10) & 0x1f;
+  uint32_t mantissa = h & 0x3ff;
+  uint32_t bits = 0;
+  if (exponent == 0x1f) {
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  } else if (exponent != 0) {
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  } else if (mantissa != 0) {
+    // subnormal: normalize the mantissa.
+    exponent = 113;
+    while ((mantissa & 0x400) == 0) {
+      mantissa <<= 1;
+      --exponent;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+  } else {
+    bits = sign;
+  }
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+uint16_t float_to_half(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  const uint32_t abs_bits = bits & 0x7fffffff;
+  if (abs_bits >= 0x7f800000) {
+    return sign | (abs_bits > 0x7f800000 ? 0x7e00 : 0x7c00);
+  }
+  if (abs_bits >= 0x477ff000) {
+    // rounds to a value beyond the largest half.
+    return sign | 0x7c00;
+  }
+  if (abs_bits < 0x38800000) {
+    // subnormal or zero: round half to even on the shifted mantissa.
+    const int32_t shift = 126 - static_cast<int32_t>(abs_bits >> 23);
+    if (shift > 24) {
+      return sign;
+    }
+    const uint32_t mantissa = (abs_bits & 0x7fffff) | 0x800000;
+    const uint32_t half_mantissa = mantissa >> shift;
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    uint16_t result = static_cast<uint16_t>(half_mantissa);
+    if (remainder > halfway || (remainder == halfway && (result & 1))) {
+      ++result;
+    }
+    return sign | result;
+  }
+  const uint32_t rounded =
+      abs_bits + 0xfff + ((abs_bits >> 13) & 1) - (112u << 23);
+  return sign | static_cast<uint16_t>(rounded >> 13);
+}
+
+float bf16_to_float(uint16_t h) {
+  const uint32_t bits = static_cast<uint32_t>(h) << 16;
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+uint16_t float_to_bf16(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  if ((bits & 0x7fffffff) > 0x7f800000) {
+    return static_cast<uint16_t>((bits >> 16) | 0x40);
+  }
+  bits += 0x7fff + ((bits >> 16) & 1);
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+float load_element(const char* data, KVBlockElementType type) {
+  uint16_t h;
+  float f;
+  switch (type) {
+    case KVBlockElementType::kFloat16:
+      std::memcpy(&h, data, sizeof(h));
+      return half_to_float(h);
+    case KVBlockElementType::kBFloat16:
+      std::memcpy(&h, data, sizeof(h));
+      return bf16_to_float(h);
+    default:
+      std::memcpy(&f, data, sizeof(f));
+      return f;
+  }
+}
+
+void store_element(float value, KVBlockElementType type, char* data) {
+  uint16_t h;
+  switch (type) {
+    case KVBlockElementType::kFloat16:
+      h = float_to_half(value);
+      std::memcpy(data, &h, sizeof(h));
+      return;
+    case KVBlockElementType::kBFloat16:
+      h = float_to_bf16(value);
+      std::memcpy(data, &h, sizeof(h));
+      return;
+    default:
+      std::memcpy(data, &value, sizeof(value));
+      return;
+  }
+}
+
+bool quantizable(const KVBlockCodec::SegmentLayout& segment) {
+  if (segment.element_type == KVBlockElementType::kOther ||
+      segment.group_elements == 0) {
+    return false;
+  }
+  return segment.bytes % (segment.element_bytes * segment.group_elements) ==
+         0;
+}
+
+size_t int8_bytes(const KVBlockCodec::SegmentLayout& segment) {
+  if (!quantizable(segment)) {
+    return segment.bytes;
+  }
+  const size_t elements = segment.bytes / segment.element_bytes;
+  return elements + elements / segment.group_elements * sizeof(float);
+}
+
+// plane p holds byte p of every element, so the sign and exponent bytes of
+// 16-bit floats end up next to each other where zstd finds the repetition.
+void shuffle_planes(const char* in, size_t bytes, size_t width, char* out) {
+  if (width <= 1 || bytes % width != 0) {
+    std::memcpy(out, in, bytes);
+    return;
+  }
+  const size_t elements = bytes / width;
+  for (size_t p = 0; p < width; ++p) {
+    char* plane = out + p * elements;
+    for (size_t i = 0; i < elements; ++i) {
+      plane[i] = in[i * width + p];
+    }
+  }
+}
+
+void unshuffle_planes(const char* in, size_t bytes, size_t width, char* out) {
+  if (width <= 1 || bytes % width != 0) {
+    std::memcpy(out, in, bytes);
+    return;
+  }
+  const size_t elements = bytes / width;
+  for (size_t p = 0; p < width; ++p) {
+    const char* plane = in + p * elements;
+    for (size_t i = 0; i < elements; ++i) {
+      out[i * width + p] = plane[i];
+    }
+  }
+}
+
+std::vector<char>& thread_scratch(size_t bytes) {
+  thread_local std::vector<char> scratch;
+  if (scratch.size() < bytes) {
+    scratch.resize(bytes);
+  }
+  return scratch;
+}
+
+}  // namespace
+
+std::optional<KVBlockCodecType> parse_kv_block_codec(const std::string& name) {
+  if (name == "none") {
+    return KVBlockCodecType::kNone;
+  }
+  if (name == "int8") {
+    return KVBlockCodecType::kInt8;
+  }
+  if (name == "lossless") {
+    return KVBlockCodecType::kLossless;
+  }
+  return std::nullopt;
+}
+
+const char* kv_block_codec_name(KVBlockCodecType type) {
+  switch (type) {
+    case KVBlockCodecType::kInt8:
+      return "int8";
+    case KVBlockCodecType::kLossless:
+      return "lossless";
+    default:
+      return "none";
+  }
+}
+
+KVBlockCodec::KVBlockCodec(KVBlockCodecType type,
+                           std::vector<SegmentLayout> layout)
+    : type_(type), layout_(std::move(layout)) {
+  CHECK(!layout_.empty()) << "KVBlockCodec requires at least one segment.";
+  size_t payload_bytes = 0;
+  for (const SegmentLayout& segment : layout_) {
+    CHECK_GT(segment.element_bytes, 0u);
+    raw_bytes_ += segment.bytes;
+    payload_bytes += type_ == KVBlockCodecType::kInt8 ? int8_bytes(segment)
+                                                      : segment.bytes;
+  }
+  if (type_ == KVBlockCodecType::kLossless) {
+    payload_bytes = std::max(payload_bytes, ZSTD_compressBound(raw_bytes_));
+  }
+  max_encoded_bytes_ = sizeof(RecordHeader) + payload_bytes;
+}
+
+size_t KVBlockCodec::encode(const std::vector<const void*>& segments,
+                            char* out) const {
+  CHECK_EQ(segments.size(), layout_.size());
+  size_t payload_bytes = 0;
+  bool compressed = false;
+  char* payload = out + sizeof(RecordHeader);
+  switch (type_) {
+    case KVBlockCodecType::kInt8:
+      payload_bytes = encode_int8(segments, payload);
+      break;
+    case KVBlockCodecType::kLossless:
+      payload_bytes = encode_lossless(segments, payload);
+      compressed = payload_bytes != raw_bytes_;
+      break;
+    default:
+      for (size_t i = 0; i < segments.size(); ++i) {
+        std::memcpy(payload + payload_bytes, segments[i], layout_[i].bytes);
+        payload_bytes += layout_[i].bytes;
+      }
+      break;
+  }
+  const RecordHeader header{kRecordMagic,
+                            static_cast<uint8_t>(type_),
+                            static_cast<uint8_t>(compressed),
+                            0,
+                            raw_bytes_,
+                            payload_bytes};
+  std::memcpy(out, &header, sizeof(header));
+  return sizeof(header) + payload_bytes;
+}
+
+size_t KVBlockCodec::encode_int8(const std::vector<const void*>& segments,
+                                 char* out) const {
+  size_t offset = 0;
+  for (size_t s = 0; s < segments.size(); ++s) {
+    const SegmentLayout& segment = layout_[s];
+    const char* in = static_cast<const char*>(segments[s]);
+    if (!quantizable(segment)) {
+      std::memcpy(out + offset, in, segment.bytes);
+      offset += segment.bytes;
+      continue;
+    }
+    const size_t elements = segment.bytes / segment.element_bytes;
+    const size_t groups = elements / segment.group_elements;
+    int8_t* values = reinterpret_cast<int8_t*>(out + offset);
+    char* scales = out + offset + elements;
+    std::vector<float> group(segment.group_elements);
+    for (size_t g = 0; g < groups; ++g) {
+      float amax = 0.0f;
+      for (size_t i = 0; i < segment.group_elements; ++i) {
+        const size_t index = g * segment.group_elements + i;
+        group[i] = load_element(in + index * segment.element_bytes,
+                                segment.element_type);
+        if (std::isfinite(group[i])) {
+          amax = std::max(amax, std::fabs(group[i]));
+        }
+      }
+      const float scale = amax / 127.0f;
+      const float inv_scale = scale > 0.0f ? 1.0f / scale : 0.0f;
+      for (size_t i = 0; i < segment.group_elements; ++i) {
+        const float scaled = std::isfinite(group[i]) ? group[i] * inv_scale : 0;
+        values[g * segment.group_elements + i] = static_cast<int8_t>(
+            std::clamp(std::nearbyint(scaled), -127.0f, 127.0f));
+      }
+      std::memcpy(scales + g * sizeof(float), &scale, sizeof(float));
+    }
+    offset += elements + groups * sizeof(float);
+  }
+  return offset;
+}
+
+size_t KVBlockCodec::encode_lossless(const std::vector<const void*>& segments,
+                                     char* out) const {
+  std::vector<char>& shuffled = thread_scratch(raw_bytes_);
+  size_t offset = 0;
+  for (size_t s = 0; s < segments.size(); ++s) {
+    shuffle_planes(static_cast<const char*>(segments[s]),
+                   layout_[s].bytes,
+                   layout_[s].element_bytes,
+                   shuffled.data() + offset);
+    offset += layout_[s].bytes;
+  }
+  thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(
+      ZSTD_createCCtx(), &ZSTD_freeCCtx);
+  CHECK(context != nullptr) << "Failed to create a zstd context.";
+  ZSTD_CCtx_setParameter(context.get(), ZSTD_c_compressionLevel, kZstdLevel);
+  // the frame checksum turns a corrupt record into a miss on decode.
+  ZSTD_CCtx_setParameter(context.get(), ZSTD_c_checksumFlag, 1);
+  const size_t capacity = max_encoded_bytes_ - sizeof(RecordHeader);
+  const size_t compressed = ZSTD_compress2(
+      context.get(), out, capacity, shuffled.data(), raw_bytes_);
+  if (ZSTD_isError(compressed) || compressed >= raw_bytes_) {
+    // incompressible: keep the planes, which decode the same way.
+    std::memcpy(out, shuffled.data(), raw_bytes_);
+    return raw_bytes_;
+  }
+  return compressed;
+}
+
+bool KVBlockCodec::decode(const char* in,
+                          size_t bytes,
+                          const std::vector<void*>& segments) const {
+  CHECK_EQ(segments.size(), layout_.size());
+  RecordHeader header;
+  if (bytes < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, in, sizeof(header));
+  if (header.magic != kRecordMagic ||
+      header.codec != static_cast<uint8_t>(type_) ||
+      header.raw_bytes != raw_bytes_ ||
+      header.payload_bytes != bytes - sizeof(header)) {
+    return false;
+  }
+  const char* payload = in + sizeof(header);
+  switch (type_) {
+    case KVBlockCodecType::kInt8:
+      return decode_int8(payload, header.payload_bytes, segments);
+    case KVBlockCodecType::kLossless:
+      if (header.compressed == 0) {
+        if (header.payload_bytes != raw_bytes_) {
+          return false;
+        }
+        return decode_lossless(payload, raw_bytes_, segments);
+      } else {
+        std::vector<char>& planes = thread_scratch(raw_bytes_);
+        const size_t decompressed = ZSTD_decompress(
+            planes.data(), raw_bytes_, payload, header.payload_bytes);
+        if (ZSTD_isError(decompressed) || decompressed != raw_bytes_) {
+          return false;
+        }
+        return decode_lossless(planes.data(), raw_bytes_, segments);
+      }
+    default: {
+      if (header.payload_bytes != raw_bytes_) {
+        return false;
+      }
+      size_t offset = 0;
+      for (size_t i = 0; i < segments.size(); ++i) {
+        std::memcpy(segments[i], payload + offset, layout_[i].bytes);
+        offset += layout_[i].bytes;
+      }
+      return true;
+    }
+  }
+}
+
+bool KVBlockCodec::decode_int8(const char* in,
+                               size_t bytes,
+                               const std::vector<void*>& segments) const {
+  if (bytes + sizeof(RecordHeader) != max_encoded_bytes_) {
+    return false;
+  }
+  size_t offset = 0;
+  for (size_t s = 0; s < segments.size(); ++s) {
+    const SegmentLayout& segment = layout_[s];
+    char* out = static_cast<char*>(segments[s]);
+    if (!quantizable(segment)) {
+      std::memcpy(out, in + offset, segment.bytes);
+      offset += segment.bytes;
+      continue;
+    }
+    const size_t elements = segment.bytes / segment.element_bytes;
+    const size_t groups = elements / segment.group_elements;
+    const int8_t* values = reinterpret_cast<const int8_t*>(in + offset);
+    const char* scales = in + offset + elements;
+    for (size_t g = 0; g < groups; ++g) {
+      float scale;
+      std::memcpy(&scale, scales + g * sizeof(float), sizeof(float));
+      for (size_t i = 0; i < segment.group_elements; ++i) {
+        const size_t index = g * segment.group_elements + i;
+        store_element(values[index] * scale,
+                      segment.element_type,
+                      out + index * segment.element_bytes);
+      }
+    }
+    offset += elements + groups * sizeof(float);
+  }
+  return true;
+}
+
+bool KVBlockCodec::decode_lossless(const char* in,
+                                   size_t bytes,
+                                   const std::vector<void*>& segments) const {
+  size_t offset = 0;
+  for (size_t s = 0; s < segments.size(); ++s) {
+    if (offset + layout_[s].bytes > bytes) {
+      return false;
+    }
+    unshuffle_planes(in + offset,
+                     layout_[s].bytes,
+                     layout_[s].element_bytes,
+                     static_cast<char*>(segments[s]));
+    offset += layout_[s].bytes;
+  }
+  return offset == bytes;
+}
+
+}  // namespace xllm
@@ -0,0 +1,97 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace xllm {
+
+enum class KVBlockCodecType : uint8_t {
+  // raw bytes
+  kNone = 0,
+  // lossy: symmetric int8 per group of elements with one fp32 scale per
+  // group, like the int8 KV cache. Fixed size, about half of 16-bit data.
+  kInt8 = 1,
+  // exact: byte planes of every element are grouped, then zstd compressed.
+  // Variable size, never larger than raw plus the header.
+  kLossless = 2,
+};
+
+std::optional<KVBlockCodecType> parse_kv_block_codec(const std::string& name);
+const char* kv_block_codec_name(KVBlockCodecType type);
+
+enum class KVBlockElementType : uint8_t {
+  kFloat16,
+  kBFloat16,
+  kFloat32,
+  // copied as is by the int8 codec
+  kOther,
+};
+
+// Encodes one KV block, given as the per-role host slices that make it up,
+// into a single self-describing record for the tiers behind the host cache.
+// The host cache itself keeps raw blocks, since H2D/D2H copies go straight
+// between its slots and the device. Thread-safe.
+class KVBlockCodec final {
+ public:
+  struct SegmentLayout {
+    KVBlockElementType element_type = KVBlockElementType::kOther;
+    size_t element_bytes = 1;
+    size_t bytes = 0;
+    // elements sharing one int8 scale, typically the head dim
+    size_t group_elements = 0;
+  };
+
+  KVBlockCodec(KVBlockCodecType type, std::vector<SegmentLayout> layout);
+
+  KVBlockCodecType type() const { return type_; }
+  size_t raw_bytes() const { return raw_bytes_; }
+  // Upper bound of encode(); exact for kNone and kInt8.
+  size_t max_encoded_bytes() const { return max_encoded_bytes_; }
+
+  // Encodes the segments, in layout order, into out, which holds at least
+  // max_encoded_bytes(). Returns the encoded size.
+  size_t encode(const std::vector<const void*>& segments, char* out) const;
+
+  // Decodes a record written by encode() under the same layout into the
+  // segments. Returns false if the record is malformed.
+  bool decode(const char* in,
+              size_t bytes,
+              const std::vector<void*>& segments) const;
+
+ private:
+  size_t encode_int8(const std::vector<const void*>& segments,
+                     char* out) const;
+  size_t encode_lossless(const std::vector<const void*>& segments,
+                         char* out) const;
+  bool decode_int8(const char* in,
+                   size_t bytes,
+                   const std::vector<void*>& segments) const;
+  bool decode_lossless(const char* in,
+                       size_t bytes,
+                       const std::vector<void*>& segments) const;
+
+  KVBlockCodecType type_;
+  std::vector<SegmentLayout> layout_;
+  size_t raw_bytes_ = 0;
+  size_t max_encoded_bytes_ = 0;
+};
+
+}  // namespace xllm
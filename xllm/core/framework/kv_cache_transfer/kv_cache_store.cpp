@@ -15,18 +15,25 @@ limitations under the License.
 
 #include "framework/kv_cache_transfer/kv_cache_store.h"
 
-#include <Mooncake/mooncake-store/include/utils.h>
 #include <glog/logging.h>
 
 #include <algorithm>
-#include <cstdlib>
-#include <optional>
-#include <unordered_map>
 #include <utility>
 
+#include "common/metrics.h"
+#include "framework/kv_cache_transfer/host_kv_block_codec.h"
+#include "framework/kv_cache_transfer/local_kv_store_backend.h"
+#include "framework/kv_cache_transfer/mooncake_kv_store_backend.h"
 #include "util/hash_util.h"
+#include "util/timer.h"
 
 namespace xllm {
+namespace {
+
+// blocks encoded or decoded per Mooncake batch when a codec is on.
+constexpr size_t kStagingBlocks = 16;
+
+}  // namespace
 
 bool KVCacheStore::init(const KVCacheStoreInitConfig& config,
                         HostGroupedCaches* host_kv_caches) {
@@ -36,30 +43,29 @@ bool KVCacheStore::init(const KVCacheStoreInitConfig& config,
   config_ = config;
   host_kv_caches_ = host_kv_caches;
 
-  std::optional<std::string> device_names = std::nullopt;
-  if (config_.protocol == "rdma") {
-    const char* configured_devices = std::getenv("DEVICE_NAMES");
-    if (configured_devices != nullptr) {
-      device_names = configured_devices;
-      LOG(INFO) << "Mooncake RDMA device_names: " << device_names.value();
-    } else {
-      LOG(WARNING) << "DEVICE_NAMES is not set; falling back to TCP.";
-      config_.protocol = "tcp";
+  if (config_.protocol == "local") {
+    LocalKVStoreBackend::Options options;
+    options.capacity_bytes(config_.local_capacity_bytes)
+        .bandwidth_bytes_per_second(config_.local_bandwidth_bytes_per_second)
+        .latency_us(config_.local_latency_us);
+    backend_ = LocalKVStoreBackend::get_shared(options);
+  } else {
+    backend_ = MooncakeKVStoreBackend::create(config_.localhost_name,
+                                              config_.metadata_server,
+                                              config_.protocol,
+                                              config_.master_server_address,
+                                              config_.replica_num);
+    if (backend_ == nullptr) {
+      return false;
     }
   }
 
-  auto client = mooncake::Client::Create(config_.localhost_name,
-                                         config_.metadata_server,
-                                         config_.protocol,
-                                         device_names,
-                                         config_.master_server_address);
-  if (!client.has_value()) {
-    LOG(ERROR) << "Failed to create Mooncake Store client for "
-               << config_.localhost_name;
-    return false;
+  if (config_.codec == KVBlockCodecType::kLossless) {
+    // Mooncake objects are read into buffers of a known size, so only the
+    // fixed-size codecs apply; the local disk tier still compresses.
+    LOG(WARNING) << "KVCacheStore keeps raw blocks for the lossless codec.";
+    config_.codec = KVBlockCodecType::kNone;
   }
-  client_ptr_ = client.value();
-  rep_config_.replica_num = config_.replica_num;
 
   std::string cache_schema = "tp=" + std::to_string(config_.tp_size);
   for (const auto& [type, cache] : *host_kv_caches_) {
@@ -92,28 +98,34 @@ bool KVCacheStore::init(const KVCacheStoreInitConfig& config,
         cache_schema.push_back('x');
       }
 
-      if (config_.protocol == "rdma") {
-        void* address = tensor.data_ptr();
-        const size_t bytes = static_cast<size_t>(tensor.numel()) *
-                             static_cast<size_t>(tensor.element_size());
-        auto result =
-            client_ptr_->RegisterLocalMemory(address,
-                                             bytes,
-                                             /*location=*/"cpu:0",
-                                             /*remote_accessible=*/false,
-                                             /*update_metadata=*/false);
-        if (!result.has_value()) {
-          LOG(ERROR) << "Failed to register Mooncake Host tensor: "
-                     << toString(result.error());
-          return false;
-        }
-        registered_addresses_.emplace_back(address);
+      void* address = tensor.data_ptr();
+      const size_t bytes = static_cast<size_t>(tensor.numel()) *
+                           static_cast<size_t>(tensor.element_size());
+      if (!backend_->register_memory(address, bytes)) {
+        return false;
       }
+      registered_addresses_.emplace_back(address);
+    }
+    if (config_.codec != KVBlockCodecType::kNone) {
+      auto codec = make_host_kv_block_codec(config_.codec, tensors);
+      staging_stride_ =
+          std::max(staging_stride_, codec->max_encoded_bytes());
+      codecs_.emplace(type, std::move(codec));
     }
     LOG(INFO) << "KVCacheStore init OK: type=" << static_cast<int32_t>(type)
               << ", host_blocks=" << host_blocks
               << ", slot_bytes=" << slot_bytes
-              << ", protocol=" << config_.protocol;
+              << ", protocol=" << config_.protocol
+              << ", codec=" << kv_block_codec_name(config_.codec);
+  }
+  if (config_.codec != KVBlockCodecType::kNone) {
+    cache_schema.append("|codec=");
+    cache_schema.append(kv_block_codec_name(config_.codec));
+    staging_.resize(staging_stride_ * kStagingBlocks);
+    if (!backend_->register_memory(staging_.data(), staging_.size())) {
+      return false;
+    }
+    registered_addresses_.emplace_back(staging_.data());
   }
   const XXH3Key schema_hash = hash_string(cache_schema);
   cache_schema_hash_.assign(reinterpret_cast<const char*>(schema_hash.data),
@@ -124,16 +136,11 @@ bool KVCacheStore::init(const KVCacheStoreInitConfig& config,
 }
 
 KVCacheStore::~KVCacheStore() {
-  if (client_ptr_ != nullptr) {
+  if (backend_ != nullptr) {
     for (void* address : registered_addresses_) {
-      auto result = client_ptr_->unregisterLocalMemory(
-          address, /*update_metadata=*/false);
-      if (!result.has_value()) {
-        LOG(WARNING) << "Failed to unregister Mooncake Host tensor: "
-                     << toString(result.error());
-      }
+      backend_->unregister_memory(address);
     }
-    client_ptr_.reset();
+    backend_.reset();
   }
 }
 
@@ -166,36 +173,40 @@ uint32_t KVCacheStore::batch_put(
   for (const BlockTransferInfo& block_info : block_transfer_info) {
     all_keys.emplace_back(build_key(block_info));
   }
-  const auto exists = client_ptr_->BatchIsExist(all_keys);
+  const std::vector<uint8_t> exists = backend_->batch_exist(all_keys);
 
   std::vector<std::string> put_keys;
-  std::vector<std::vector<mooncake::Slice>> put_slices;
+  std::vector<size_t> put_positions;
   put_keys.reserve(block_transfer_info.size());
-  put_slices.reserve(block_transfer_info.size());
+  put_positions.reserve(block_transfer_info.size());
   uint32_t success_count = 0;
   for (size_t i = 0; i < block_transfer_info.size(); ++i) {
-    const bool already_exists =
-        i < exists.size() && exists[i].has_value() && exists[i].value();
-    if (already_exists) {
+    if (exists[i] != 0) {
       ++success_count;
       continue;
     }
     put_keys.emplace_back(all_keys[i]);
-    put_slices.emplace_back(
-        generate_mooncake_slices(block_transfer_info[i].block_type,
-                                 block_transfer_info[i].dst_block_id));
+    put_positions.emplace_back(i);
   }
 
   if (put_keys.empty()) {
     return success_count;
   }
-  const auto results = client_ptr_->BatchPut(put_keys, put_slices, rep_config_);
-  for (size_t i = 0; i < put_keys.size() && i < results.size(); ++i) {
-    if (results[i].has_value()) {
-      ++success_count;
-    }
+  if (!codecs_.empty()) {
+    return success_count +
+           batch_put_encoded(block_transfer_info, put_keys, put_positions);
   }
-  return success_count;
+  std::vector<std::vector<KVStoreSlice>> put_slices;
+  put_slices.reserve(put_positions.size());
+  for (size_t position : put_positions) {
+    put_slices.emplace_back(
+        generate_block_slices(block_transfer_info[position].block_type,
+                              block_transfer_info[position].dst_block_id));
+  }
+  const std::vector<uint8_t> results =
+      backend_->batch_put(put_keys, put_slices);
+  return success_count + static_cast<uint32_t>(std::count(
+                             results.begin(), results.end(), uint8_t{1}));
 }
 
 uint32_t KVCacheStore::batch_get(
@@ -218,52 +229,136 @@ std::vector<uint8_t> KVCacheStore::batch_get_with_status(
   for (const BlockTransferInfo& block_info : block_transfer_info) {
     all_keys.emplace_back(build_key(block_info));
   }
-  const auto exists = client_ptr_->BatchIsExist(all_keys);
+  const std::vector<uint8_t> exists = backend_->batch_exist(all_keys);
 
   std::vector<std::string> get_keys;
-  std::unordered_map<std::string, std::vector<mooncake::Slice>> get_slices;
   std::vector<size_t> get_positions;
   get_keys.reserve(block_transfer_info.size());
   get_positions.reserve(block_transfer_info.size());
-  get_slices.reserve(block_transfer_info.size());
   for (size_t i = 0; i < block_transfer_info.size(); ++i) {
-    const bool exists_in_store =
-        i < exists.size() && exists[i].has_value() && exists[i].value();
-    if (!exists_in_store) {
+    if (exists[i] == 0) {
       continue;
     }
     get_positions.emplace_back(i);
     get_keys.emplace_back(all_keys[i]);
-    get_slices.emplace(
-        all_keys[i],
-        generate_mooncake_slices(block_transfer_info[i].block_type,
-                                 block_transfer_info[i].dst_block_id));
   }
 
   if (get_keys.empty()) {
     return statuses;
   }
-  const auto results = client_ptr_->BatchGet(get_keys, get_slices);
-  for (size_t i = 0; i < get_keys.size() && i < results.size(); ++i) {
-    if (results[i].has_value()) {
-      statuses[get_positions[i]] = 1;
-    }
+  if (!codecs_.empty()) {
+    batch_get_encoded(block_transfer_info, get_keys, get_positions, statuses);
+    return statuses;
+  }
+  std::vector<std::vector<KVStoreSlice>> get_slices;
+  get_slices.reserve(get_keys.size());
+  for (size_t position : get_positions) {
+    const BlockTransferInfo& block_info = block_transfer_info[position];
+    get_slices.emplace_back(generate_block_slices(block_info.block_type,
+                                                  block_info.dst_block_id));
+  }
+  const std::vector<uint8_t> results =
+      backend_->batch_get(get_keys, get_slices);
+  for (size_t i = 0; i < get_keys.size(); ++i) {
+    statuses[get_positions[i]] = results[i];
   }
   return statuses;
 }
 
+uint32_t KVCacheStore::batch_put_encoded(
+    const Slice<BlockTransferInfo>& block_transfer_info,
+    const std::vector<std::string>& keys,
+    const std::vector<size_t>& positions) {
+  std::lock_guard<std::mutex> lock(staging_mutex_);
+  uint32_t success_count = 0;
+  for (size_t begin = 0; begin < keys.size(); begin += kStagingBlocks) {
+    const size_t end = std::min(keys.size(), begin + kStagingBlocks);
+    std::vector<std::string> chunk_keys(keys.begin() + begin,
+                                        keys.begin() + end);
+    std::vector<std::vector<KVStoreSlice>> chunk_slices;
+    chunk_slices.reserve(end - begin);
+    Timer timer;
+    for (size_t i = begin; i < end; ++i) {
+      const BlockTransferInfo& block_info = block_transfer_info[positions[i]];
+      const KVBlockCodec& codec = *codecs_.at(block_info.block_type);
+      std::vector<const void*> inputs;
+      for (const KVStoreSlice& slice : generate_block_slices(
+               block_info.block_type, block_info.dst_block_id)) {
+        inputs.push_back(slice.ptr);
+      }
+      char* record = staging_.data() + (i - begin) * staging_stride_;
+      const size_t encoded_bytes = codec.encode(inputs, record);
+      COUNTER_ADD(kv_block_codec_raw_bytes_total, codec.raw_bytes());
+      COUNTER_ADD(kv_block_codec_encoded_bytes_total, encoded_bytes);
+      chunk_slices.push_back({KVStoreSlice{record, encoded_bytes}});
+    }
+    COUNTER_ADD(kv_block_codec_latency_seconds_encode,
+                timer.elapsed_seconds());
+
+    const std::vector<uint8_t> results =
+        backend_->batch_put(chunk_keys, chunk_slices);
+    success_count += static_cast<uint32_t>(
+        std::count(results.begin(), results.end(), uint8_t{1}));
+  }
+  return success_count;
+}
+
+void KVCacheStore::batch_get_encoded(
+    const Slice<BlockTransferInfo>& block_transfer_info,
+    const std::vector<std::string>& keys,
+    const std::vector<size_t>& positions,
+    std::vector<uint8_t>& statuses) {
+  std::lock_guard<std::mutex> lock(staging_mutex_);
+  for (size_t begin = 0; begin < keys.size(); begin += kStagingBlocks) {
+    const size_t end = std::min(keys.size(), begin + kStagingBlocks);
+    std::vector<std::string> chunk_keys(keys.begin() + begin,
+                                        keys.begin() + end);
+    std::vector<std::vector<KVStoreSlice>> get_slices;
+    get_slices.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+      const BlockTransferInfo& block_info = block_transfer_info[positions[i]];
+      char* record = staging_.data() + (i - begin) * staging_stride_;
+      get_slices.push_back({KVStoreSlice{
+          record, codecs_.at(block_info.block_type)->max_encoded_bytes()}});
+    }
+
+    const std::vector<uint8_t> results =
+        backend_->batch_get(chunk_keys, get_slices);
+    Timer timer;
+    for (size_t i = 0; i < chunk_keys.size(); ++i) {
+      if (results[i] == 0) {
+        continue;
+      }
+      const size_t position = positions[begin + i];
+      const BlockTransferInfo& block_info = block_transfer_info[position];
+      const KVBlockCodec& codec = *codecs_.at(block_info.block_type);
+      std::vector<void*> outputs;
+      for (const KVStoreSlice& slice : generate_block_slices(
+               block_info.block_type, block_info.dst_block_id)) {
+        outputs.push_back(slice.ptr);
+      }
+      const char* record = staging_.data() + i * staging_stride_;
+      if (codec.decode(record, codec.max_encoded_bytes(), outputs)) {
+        statuses[position] = 1;
+      } else {
+        LOG(WARNING) << "Dropping undecodable Mooncake KV block.";
+      }
+    }
+    COUNTER_ADD(kv_block_codec_latency_seconds_decode,
+                timer.elapsed_seconds());
+  }
+}
+
 uint32_t KVCacheStore::batch_exist(std::vector<std::string>&& keys) {
   if (!is_initialized_) {
     return 0;
   }
-  const auto exists = client_ptr_->BatchIsExist(keys);
+  const std::vector<uint8_t> exists = backend_->batch_exist(keys);
   return static_cast<uint32_t>(
-      std::count_if(exists.begin(), exists.end(), [](const auto& result) {
-        return result.has_value() && result.value();
-      }));
+      std::count(exists.begin(), exists.end(), uint8_t{1}));
 }
 
-std::vector<mooncake::Slice> KVCacheStore::generate_mooncake_slices(
+std::vector<KVStoreSlice> KVCacheStore::generate_block_slices(
     BlockType type,
     int32_t block_id) const {
   CHECK(host_kv_caches_ != nullptr);
@@ -273,7 +368,7 @@ std::vector<mooncake::Slice> KVCacheStore::generate_mooncake_slices(
   const BlockTypeTensorMap tensors =
       cache_it->second->get_block_type_tensors(type);
 
-  std::vector<mooncake::Slice> slices;
+  std::vector<KVStoreSlice> slices;
   slices.reserve(tensors.size());
   for (const auto& tensor_entry : tensors) {
     const torch::Tensor& tensor = tensor_entry.second;
@@ -282,7 +377,7 @@ std::vector<mooncake::Slice> KVCacheStore::generate_mooncake_slices(
     torch::Tensor block = tensor[block_id];
     CHECK(block.is_contiguous());
     slices.emplace_back(
-        mooncake::Slice{block.data_ptr(),
+        KVStoreSlice{block.data_ptr(),
                         static_cast<size_t>(block.numel()) *
                             static_cast<size_t>(block.element_size())});
   }
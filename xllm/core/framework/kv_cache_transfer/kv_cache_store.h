@@ -15,15 +15,16 @@ limitations under the License.
 
 #pragma once
 
-#include <Mooncake/mooncake-store/include/client_service.h>
-
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "framework/kv_cache/kv_cache.h"
+#include "framework/kv_cache_transfer/kv_block_codec.h"
+#include "framework/kv_cache_transfer/kv_store_backend.h"
 #include "framework/model/model_input_params.h"
 #include "util/slice.h"
 
@@ -40,6 +41,13 @@ struct KVCacheStoreInitConfig {
   int32_t replica_num = 1;
   uint32_t tp_rank = 0;
   uint32_t tp_size = 1;
+  // encoding of the stored objects; only fixed-size codecs apply
+  KVBlockCodecType codec = KVBlockCodecType::kNone;
+  // protocol "local" keeps objects in process instead of in Mooncake, with
+  // the simulated link below; 0 disables a limit.
+  size_t local_capacity_bytes = 0;
+  double local_bandwidth_bytes_per_second = 0.0;
+  int64_t local_latency_us = 0;
 };
 
 class KVCacheStore final {
@@ -74,17 +82,33 @@ class KVCacheStore final {
   KVCacheStore& operator=(const KVCacheStore&) = delete;
 
   std::string build_key(const BlockTransferInfo& block_info) const;
-  std::vector<mooncake::Slice> generate_mooncake_slices(BlockType type,
-                                                        int32_t block_id) const;
+  std::vector<KVStoreSlice> generate_block_slices(BlockType type,
+                                                  int32_t block_id) const;
+
+  // With a codec, blocks move through a staging arena, one chunk of
+  // kStagingBlocks at a time, instead of straight from the host slots.
+  uint32_t batch_put_encoded(
+      const Slice<BlockTransferInfo>& block_transfer_info,
+      const std::vector<std::string>& keys,
+      const std::vector<size_t>& positions);
+  void batch_get_encoded(const Slice<BlockTransferInfo>& block_transfer_info,
+                         const std::vector<std::string>& keys,
+                         const std::vector<size_t>& positions,
+                         std::vector<uint8_t>& statuses);
 
  private:
   bool is_initialized_ = false;
   KVCacheStoreInitConfig config_;
   std::string cache_schema_hash_;
-  mooncake::ReplicateConfig rep_config_;
   HostGroupedCaches* host_kv_caches_ = nullptr;
   std::vector<void*> registered_addresses_;
-  std::shared_ptr<mooncake::Client> client_ptr_;
+  // shared with the other workers of the process for the local protocol.
+  std::shared_ptr<KVStoreBackend> backend_;
+
+  std::map<BlockType, std::unique_ptr<KVBlockCodec>> codecs_;
+  size_t staging_stride_ = 0;
+  std::vector<char> staging_;
+  std::mutex staging_mutex_;
 };
 
 }  // namespace xllm
@@ -0,0 +1,212 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <benchmark/benchmark.h>
+#include <glog/logging.h>
+#include <torch/torch.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "distributed_runtime/engine.h"
+#include "framework/block/hierarchy_block_manager_pool.h"
+#include "framework/kv_cache/kv_cache.h"
+#include "framework/kv_cache_transfer/kv_cache_store.h"
+#include "framework/kv_cache_transfer/prefetch_result.h"
+#include "framework/request/request.h"
+#include "framework/request/stopping_checker.h"
+#include "framework/sampling/sampling_params.h"
+#include "util/slice.h"
+using namespace xllm;
+
+// ============================================================================
+// Storage prefetch admission against the in-process store
+// (--store_protocol=local).
+//
+// Each iteration admits one prompt of `num_blocks` full blocks into a fresh
+// HierarchyBlockManagerPool: the pool probes its Host prefix cache, allocates
+// Host blocks for the misses and asks the engine to prefetch them; the engine
+// reads them from a KVCacheStore in prefetch_batch_size batches, as a TP
+// worker does. The store link is simulated with the bandwidth and latency
+// arguments, so the numbers show how admission scales with block count before
+// a Mooncake cluster is involved.
+// ============================================================================
+
+namespace {
+
+constexpr uint32_t kBlockSize = 128;
+// K and V bytes per block and worker, e.g. 4 layers x 8 heads x 128 dims of
+// bf16 for 128 tokens would be 1 MiB; kept small to bound memory.
+constexpr int64_t kBytesPerTensorBlock = 64 * 1024;
+constexpr uint32_t kPrefetchBatchSize = 16;
+
+// Single TP worker that serves prefetches synchronously from a KVCacheStore.
+// With `seed` it writes the requested Host slots to the store instead, to
+// populate it once before measuring.
+class StorePrefetchEngine final : public Engine {
+ public:
+  explicit StorePrefetchEngine(KVCacheStore* store) : store_(store) {}
+
+  ForwardOutput step(std::vector<Batch>& /*batch*/) override { return {}; }
+
+  void update_last_step_result(std::vector<Batch>& /*batch*/) override {}
+
+  std::vector<int64_t> get_active_activation_memory() const override {
+    return {0};
+  }
+
+  std::shared_ptr<PrefetchResult> prefetch_from_storage(
+      uint32_t /*dp_rank*/,
+      const std::vector<BlockTransferInfo>& block_transfer_info) override {
+    auto result = std::make_shared<PrefetchResult>(
+        /*worker_count=*/1, block_transfer_info.size(), kPrefetchBatchSize);
+    const Slice<BlockTransferInfo> infos(block_transfer_info);
+    for (size_t offset = 0; offset < infos.size();
+         offset += kPrefetchBatchSize) {
+      Slice<BlockTransferInfo> batch = infos.slice(
+          offset, std::min(infos.size(), offset + kPrefetchBatchSize));
+      std::vector<uint8_t> hits;
+      if (seed_) {
+        store_->batch_put(batch);
+        hits.assign(batch.size(), 1);
+      } else {
+        hits = store_->batch_get_with_status(batch);
+      }
+      result->set_batch_result(/*worker_index=*/0, offset, hits);
+    }
+    result->mark_worker_completed(/*worker_index=*/0, /*worker_ok=*/true);
+    return result;
+  }
+
+  void set_seed(bool seed) { seed_ = seed; }
+
+ private:
+  KVCacheStore* store_ = nullptr;
+  bool seed_ = false;
+};
+
+BlockManagerPool::Options make_pool_options(size_t num_blocks) {
+  BlockManagerPool::Options opts;
+  // block id 0 is reserved in every leaf.
+  opts.num_blocks(num_blocks + 1)
+      .host_num_blocks(num_blocks + 1)
+      .block_size(kBlockSize)
+      .enable_prefix_cache(true)
+      .enable_host_offload(true)
+      .enable_kvcache_store(true);
+  return opts;
+}
+
+std::shared_ptr<Request> make_request(
+    const std::vector<int32_t>& prompt_token_ids) {
+  RequestSamplingParam sampling_param;
+  SchedulerParam scheduler_param;
+  StoppingChecker stopping_checker;
+  stopping_checker.set_max_generated_tokens(16);
+  stopping_checker.set_max_context_len(prompt_token_ids.size() + 16);
+  stopping_checker.set_ignore_eos(true);
+
+  RequestState request_state("bench",
+                             prompt_token_ids,
+                             sampling_param,
+                             scheduler_param,
+                             stopping_checker,
+                             prompt_token_ids.size() + 16,
+                             /*n=*/1,
+                             /*best_of=*/1,
+                             /*logprobs=*/false,
+                             /*stream=*/false,
+                             /*echo=*/false,
+                             /*skip_special_tokens=*/true,
+                             /*enable_schedule_overlap=*/false,
+                             /*output_func=*/nullptr,
+                             /*outputs_func=*/nullptr);
+  return std::make_shared<Request>(
+      "request", "x-request", "time", request_state, "service-request");
+}
+
+// Admits one request and returns the number of blocks published to Host.
+size_t admit(HierarchyBlockManagerPool* pool,
+             const std::vector<int32_t>& prompt_token_ids) {
+  std::shared_ptr<Request> request = make_request(prompt_token_ids);
+  pool->prefetch_from_storage(request);
+  CHECK(pool->update_prefetch_result(request, /*timeout=*/0));
+  Sequence* sequence = request->sequences().front().get();
+  const size_t num_blocks = sequence->host_kv_state().num_blocks(BlockType::KV);
+  pool->deallocate(sequence);
+  return num_blocks;
+}
+
+// Args: {num_blocks, bandwidth_gbps, latency_us}.
+void BM_PrefetchFromLocalStore(benchmark::State& state) {
+  const size_t num_blocks = static_cast<size_t>(state.range(0));
+  const double bandwidth_gbps = static_cast<double>(state.range(1));
+  const int64_t latency_us = state.range(2);
+
+  // the store reads into and writes from these Host slots.
+  const int64_t host_blocks = static_cast<int64_t>(num_blocks) + 1;
+  const int64_t elems = kBytesPerTensorBlock / 2;
+  HostGroupedCaches host_caches;
+  host_caches[BlockType::KV] = std::make_unique<KVCache>(
+      KVCacheTensors{torch::ones({host_blocks, elems}, torch::kBFloat16),
+                     torch::ones({host_blocks, elems}, torch::kBFloat16)});
+
+  KVCacheStoreInitConfig config;
+  config.protocol = "local";
+  config.model_id = "kv_cache_store_benchmark";
+  config.local_bandwidth_bytes_per_second = bandwidth_gbps * 1e9 / 8;
+  config.local_latency_us = latency_us;
+  KVCacheStore store;
+  CHECK(store.init(config, &host_caches));
+
+  StorePrefetchEngine engine(&store);
+  const std::vector<int32_t> tokens(num_blocks * kBlockSize + 1, 7);
+  {
+    engine.set_seed(true);
+    HierarchyBlockManagerPool pool(
+        make_pool_options(num_blocks), &engine, /*dp_size=*/1);
+    CHECK_EQ(admit(&pool, tokens), num_blocks);
+    engine.set_seed(false);
+  }
+
+  for (auto _ : state) {
+    // a fresh pool keeps the Host prefix cache cold for every admission.
+    state.PauseTiming();
+    auto pool = std::make_unique<HierarchyBlockManagerPool>(
+        make_pool_options(num_blocks), &engine, /*dp_size=*/1);
+    state.ResumeTiming();
+
+    const size_t published = admit(pool.get(), tokens);
+
+    state.PauseTiming();
+    CHECK_EQ(published, num_blocks);
+    pool.reset();
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() * num_blocks);
+  state.SetBytesProcessed(state.iterations() * num_blocks * 2 *
+                          kBytesPerTensorBlock);
+}
+
+}  // namespace
+
+BENCHMARK(BM_PrefetchFromLocalStore)
+    ->ArgNames({"blocks", "gbps", "latency_us"})
+    ->ArgsProduct({{64, 256, 1024}, {0, 100}, {0, 50}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
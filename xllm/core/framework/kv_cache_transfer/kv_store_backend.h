@@ -0,0 +1,57 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace xllm {
+
+// One contiguous piece of a stored object in caller memory.
+struct KVStoreSlice {
+  void* ptr = nullptr;
+  size_t size = 0;
+};
+
+// Object store behind KVCacheStore. An object is written from and read into
+// a list of slices; the store sees only the concatenated bytes. Batch calls
+// return one status per key, 1 on success.
+class KVStoreBackend {
+ public:
+  virtual ~KVStoreBackend() = default;
+
+  // Make [address, address + bytes) usable as a transfer buffer.
+  virtual bool register_memory(void* /*address*/, size_t /*bytes*/) {
+    return true;
+  }
+  virtual void unregister_memory(void* /*address*/) {}
+
+  virtual std::vector<uint8_t> batch_exist(
+      const std::vector<std::string>& keys) = 0;
+
+  virtual std::vector<uint8_t> batch_put(
+      const std::vector<std::string>& keys,
+      const std::vector<std::vector<KVStoreSlice>>& slices) = 0;
+
+  // Reads each object into its slices, which may be larger than the object.
+  virtual std::vector<uint8_t> batch_get(
+      const std::vector<std::string>& keys,
+      const std::vector<std::vector<KVStoreSlice>>& slices) = 0;
+};
+
+}  // namespace xllm
@@ -0,0 +1,282 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/kv_cache_transfer/local_disk_kv_cache_store.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#include "common/metrics.h"
+#include "framework/kv_cache_transfer/host_kv_block_codec.h"
+#include "util/timer.h"
+
+namespace xllm {
+namespace {
+
+DiskBlockStore::Key to_disk_key(const BlockTransferInfo& block_info) {
+  DiskBlockStore::Key key;
+  static_assert(sizeof(block_info.hash_key) == sizeof(key));
+  std::memcpy(key.data(), block_info.hash_key, key.size());
+  return key;
+}
+
+std::string sanitize_file_name(const std::string& name) {
+  std::string sanitized = name.empty() ? "default" : name;
+  for (char& c : sanitized) {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' &&
+        c != '.') {
+      c = '_';
+    }
+  }
+  return sanitized;
+}
+
+// encode/decode buffer of the calling io thread, reused across blocks.
+std::vector<char>& record_buffer(size_t bytes) {
+  thread_local std::vector<char> buffer;
+  if (buffer.size() < bytes) {
+    buffer.resize(bytes);
+  }
+  return buffer;
+}
+
+}  // namespace
+
+bool LocalDiskKVCacheStore::init(const LocalDiskKVCacheStoreInitConfig& config,
+                                 HostGroupedCaches* host_kv_caches) {
+  CHECK(stores_.empty()) << "LocalDiskKVCacheStore is already initialized.";
+  CHECK(host_kv_caches != nullptr && !host_kv_caches->empty())
+      << "LocalDiskKVCacheStore requires typed Host caches.";
+  CHECK_GT(config.capacity_bytes, 0u);
+  host_kv_caches_ = host_kv_caches;
+
+  std::error_code error;
+  std::filesystem::create_directories(config.path, error);
+  if (error) {
+    LOG(ERROR) << "Failed to create KV disk cache directory " << config.path
+               << ": " << error.message();
+    return false;
+  }
+
+  struct TypeLayout {
+    size_t record_bytes = 0;
+    uint64_t host_bytes = 0;
+    std::string schema;
+    std::unique_ptr<KVBlockCodec> codec;
+  };
+  std::map<BlockType, TypeLayout> layouts;
+  uint64_t total_host_bytes = 0;
+  for (const auto& [type, cache] : *host_kv_caches_) {
+    CHECK(cache != nullptr);
+    const BlockTypeTensorMap tensors = cache->get_block_type_tensors(type);
+    CHECK(!tensors.empty()) << "Host cache has no tensors for BlockType "
+                            << static_cast<int32_t>(type);
+    TypeLayout& layout = layouts[type];
+    layout.schema = config.model_id + "|tp=" + std::to_string(config.tp_size) +
+                    "|rank=" + std::to_string(config.tp_rank) +
+                    "|type=" + std::to_string(static_cast<int32_t>(type));
+    int64_t host_blocks = 0;
+    for (const auto& [role, tensor] : tensors) {
+      CHECK(tensor.defined() && tensor.dim() > 0 && tensor.is_contiguous());
+      host_blocks = tensor.size(0);
+      layout.record_bytes += static_cast<size_t>(tensor[0].numel()) *
+                             static_cast<size_t>(tensor.element_size());
+      layout.schema.append(",role=");
+      layout.schema.append(std::to_string(static_cast<int32_t>(role)));
+      layout.schema.append(",dtype=");
+      layout.schema.append(
+          std::to_string(static_cast<int32_t>(tensor.scalar_type())));
+      layout.schema.append(",shape=");
+      for (int64_t dim = 1; dim < tensor.dim(); ++dim) {
+        layout.schema.append(std::to_string(tensor.size(dim)));
+        layout.schema.push_back('x');
+      }
+    }
+    layout.host_bytes =
+        layout.record_bytes * static_cast<uint64_t>(host_blocks);
+    total_host_bytes += layout.host_bytes;
+    if (config.codec != KVBlockCodecType::kNone) {
+      layout.codec = make_host_kv_block_codec(config.codec, tensors);
+      layout.record_bytes = layout.codec->max_encoded_bytes();
+      layout.schema.append("|codec=");
+      layout.schema.append(kv_block_codec_name(config.codec));
+    }
+  }
+
+  // block types share the disk like they share host memory.
+  for (auto& [type, layout] : layouts) {
+    const long double share =
+        static_cast<long double>(layout.host_bytes) / total_host_bytes;
+    DiskBlockStore::Options options;
+    options
+        .path(config.path + "/" + sanitize_file_name(config.model_id) + "-w" +
+              std::to_string(config.worker_id) + "-t" +
+              std::to_string(static_cast<int32_t>(type)) + ".kvblocks")
+        .record_bytes(layout.record_bytes)
+        .schema(layout.schema);
+    const uint64_t type_bytes =
+        static_cast<uint64_t>(share * config.capacity_bytes);
+    options.capacity_records(std::max<uint64_t>(
+        1, type_bytes / DiskBlockStore::slot_bytes_for(layout.record_bytes)));
+    auto store = std::make_unique<DiskBlockStore>(options);
+    if (!store->open()) {
+      return false;
+    }
+    LOG(INFO) << "LocalDiskKVCacheStore init OK: type="
+              << static_cast<int32_t>(type)
+              << ", capacity_blocks=" << store->capacity_records()
+              << ", resident_blocks=" << store->num_records()
+              << ", direct_io=" << store->direct_io()
+              << ", codec=" << kv_block_codec_name(config.codec);
+    stores_.emplace(type, TypeStore{std::move(store), std::move(layout.codec)});
+  }
+
+  io_threadpool_ = std::make_unique<MPMCThreadPool>(
+      std::max<uint32_t>(1, config.io_threads),
+      /*cpu_binding=*/false,
+      /*fn=*/nullptr,
+      /*ln=*/0,
+      /*pool_name=*/"LocalDiskKVCacheStore.io");
+  return true;
+}
+
+std::vector<DiskBlockStore::Segment> LocalDiskKVCacheStore::host_segments(
+    BlockType type,
+    int32_t block_id) const {
+  const auto cache_it = host_kv_caches_->find(type);
+  CHECK(cache_it != host_kv_caches_->end() && cache_it->second != nullptr)
+      << "Missing Host cache for BlockType " << static_cast<int32_t>(type);
+  const BlockTypeTensorMap tensors =
+      cache_it->second->get_block_type_tensors(type);
+
+  std::vector<DiskBlockStore::Segment> segments;
+  segments.reserve(tensors.size());
+  for (const auto& tensor_entry : tensors) {
+    const torch::Tensor& tensor = tensor_entry.second;
+    CHECK_GE(block_id, 0);
+    CHECK_LT(block_id, tensor.size(0));
+    torch::Tensor block = tensor[block_id];
+    segments.push_back({block.data_ptr(),
+                        static_cast<size_t>(block.numel()) *
+                            static_cast<size_t>(block.element_size())});
+  }
+  return segments;
+}
+
+bool LocalDiskKVCacheStore::put_block(const BlockTransferInfo& block_info) {
+  auto it = stores_.find(block_info.block_type);
+  if (it == stores_.end()) {
+    return false;
+  }
+  const TypeStore& type_store = it->second;
+  std::vector<DiskBlockStore::Segment> segments =
+      host_segments(block_info.block_type, block_info.dst_block_id);
+  if (type_store.codec == nullptr) {
+    return type_store.store->put(to_disk_key(block_info), segments);
+  }
+
+  Timer timer;
+  std::vector<const void*> inputs;
+  inputs.reserve(segments.size());
+  for (const DiskBlockStore::Segment& segment : segments) {
+    inputs.push_back(segment.data);
+  }
+  std::vector<char>& buffer =
+      record_buffer(type_store.codec->max_encoded_bytes());
+  const size_t encoded_bytes =
+      type_store.codec->encode(inputs, buffer.data());
+  COUNTER_ADD(kv_block_codec_latency_seconds_encode, timer.elapsed_seconds());
+  COUNTER_ADD(kv_block_codec_raw_bytes_total, type_store.codec->raw_bytes());
+  COUNTER_ADD(kv_block_codec_encoded_bytes_total, encoded_bytes);
+  return type_store.store->put(to_disk_key(block_info),
+                               {{buffer.data(), encoded_bytes}});
+}
+
+bool LocalDiskKVCacheStore::get_block(const BlockTransferInfo& block_info) {
+  auto it = stores_.find(block_info.block_type);
+  if (it == stores_.end()) {
+    return false;
+  }
+  const TypeStore& type_store = it->second;
+  std::vector<DiskBlockStore::Segment> segments =
+      host_segments(block_info.block_type, block_info.dst_block_id);
+  if (type_store.codec == nullptr) {
+    return type_store.store->get(to_disk_key(block_info), segments);
+  }
+
+  std::vector<char>& buffer =
+      record_buffer(type_store.codec->max_encoded_bytes());
+  size_t encoded_bytes = 0;
+  if (!type_store.store->get(to_disk_key(block_info),
+                             {{buffer.data(), buffer.size()}},
+                             &encoded_bytes)) {
+    return false;
+  }
+  Timer timer;
+  std::vector<void*> outputs;
+  outputs.reserve(segments.size());
+  for (const DiskBlockStore::Segment& segment : segments) {
+    outputs.push_back(segment.data);
+  }
+  const bool decoded =
+      type_store.codec->decode(buffer.data(), encoded_bytes, outputs);
+  COUNTER_ADD(kv_block_codec_latency_seconds_decode, timer.elapsed_seconds());
+  LOG_IF(WARNING, !decoded) << "Dropping undecodable KV disk record of "
+                            << encoded_bytes << " bytes.";
+  return decoded;
+}
+
+uint32_t LocalDiskKVCacheStore::batch_put(
+    Slice<BlockTransferInfo>& block_transfer_info) {
+  if (stores_.empty() || block_transfer_info.empty()) {
+    return 0;
+  }
+  std::atomic<uint32_t> success_count{0};
+  // one slot per block, so each block is a single pwrite.
+  io_threadpool_->parallel_for(
+      block_transfer_info.size(), /*grain=*/1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          if (put_block(block_transfer_info[i])) {
+            success_count.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      });
+  return success_count.load();
+}
+
+std::vector<uint8_t> LocalDiskKVCacheStore::batch_get_with_status(
+    Slice<BlockTransferInfo>& block_transfer_info) {
+  std::vector<uint8_t> statuses(block_transfer_info.size(), /*value=*/0);
+  if (stores_.empty() || block_transfer_info.empty()) {
+    return statuses;
+  }
+  io_threadpool_->parallel_for(
+      block_transfer_info.size(), /*grain=*/1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          if (get_block(block_transfer_info[i])) {
+            statuses[i] = 1;
+          }
+        }
+      });
+  return statuses;
+}
+
+}  // namespace xllm
@@ -0,0 +1,91 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "framework/kv_cache/kv_cache.h"
+#include "framework/kv_cache_transfer/disk_block_store.h"
+#include "framework/kv_cache_transfer/kv_block_codec.h"
+#include "framework/model/model_input_params.h"
+#include "util/slice.h"
+#include "util/threadpool.h"
+
+namespace xllm {
+
+using HostGroupedCaches = std::map<BlockType, std::unique_ptr<KVCache>>;
+
+struct LocalDiskKVCacheStoreInitConfig {
+  // directory for the cache files, shared by all workers of a host
+  std::string path;
+  uint64_t capacity_bytes = 0;
+  std::string model_id;
+  uint32_t worker_id = 0;
+  uint32_t tp_rank = 0;
+  uint32_t tp_size = 1;
+  uint32_t io_threads = 4;
+  // encoding of the records on disk
+  KVBlockCodecType codec = KVBlockCodecType::kNone;
+};
+
+// Local NVMe/SSD tier behind the host KV cache. Blocks are copied between
+// host cache slots and one DiskBlockStore file per block type, using the
+// same per-role host tensor slices as the Mooncake store. With a codec,
+// every block is encoded into a single record, so a slot shrinks to the
+// encoded size and only the encoded bytes hit the disk.
+class LocalDiskKVCacheStore final {
+ public:
+  LocalDiskKVCacheStore() = default;
+  ~LocalDiskKVCacheStore() = default;
+
+  bool init(const LocalDiskKVCacheStoreInitConfig& config,
+            HostGroupedCaches* host_kv_caches);
+
+  // Stores the host blocks at dst_block_id. Returns the number of blocks
+  // stored on disk afterwards.
+  uint32_t batch_put(Slice<BlockTransferInfo>& block_transfer_info);
+
+  // Loads blocks into the host slots at dst_block_id. Returns 1 for every
+  // block that was found on disk.
+  std::vector<uint8_t> batch_get_with_status(
+      Slice<BlockTransferInfo>& block_transfer_info);
+
+ private:
+  LocalDiskKVCacheStore(const LocalDiskKVCacheStore&) = delete;
+  LocalDiskKVCacheStore& operator=(const LocalDiskKVCacheStore&) = delete;
+
+  std::vector<DiskBlockStore::Segment> host_segments(BlockType type,
+                                                     int32_t block_id) const;
+
+  bool put_block(const BlockTransferInfo& block_info);
+  bool get_block(const BlockTransferInfo& block_info);
+
+  struct TypeStore {
+    std::unique_ptr<DiskBlockStore> store;
+    // null when records are stored raw
+    std::unique_ptr<KVBlockCodec> codec;
+  };
+
+  HostGroupedCaches* host_kv_caches_ = nullptr;
+  std::map<BlockType, TypeStore> stores_;
+  std::unique_ptr<MPMCThreadPool> io_threadpool_;
+};
+
+}  // namespace xllm
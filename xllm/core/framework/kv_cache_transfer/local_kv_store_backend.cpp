@@ -0,0 +1,188 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/kv_cache_transfer/local_kv_store_backend.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <thread>
+#include <tuple>
+
+namespace xllm {
+namespace {
+
+size_t total_bytes(const std::vector<KVStoreSlice>& slices) {
+  size_t bytes = 0;
+  for (const KVStoreSlice& slice : slices) {
+    bytes += slice.size;
+  }
+  return bytes;
+}
+
+}  // namespace
+
+std::shared_ptr<LocalKVStoreBackend> LocalKVStoreBackend::get_shared(
+    const Options& options) {
+  using Key = std::tuple<size_t, double, int64_t>;
+  static std::mutex mutex;
+  static std::map<Key, std::weak_ptr<LocalKVStoreBackend>> instances;
+
+  const Key key(options.capacity_bytes(),
+                options.bandwidth_bytes_per_second(),
+                options.latency_us());
+  std::lock_guard<std::mutex> lock(mutex);
+  std::shared_ptr<LocalKVStoreBackend> backend = instances[key].lock();
+  if (backend == nullptr) {
+    backend = std::make_shared<LocalKVStoreBackend>(options);
+    instances[key] = backend;
+  }
+  return backend;
+}
+
+LocalKVStoreBackend::LocalKVStoreBackend(const Options& options)
+    : options_(options), link_free_at_(Clock::now()) {
+  CHECK_GE(options_.bandwidth_bytes_per_second(), 0.0);
+  CHECK_GE(options_.latency_us(), 0);
+}
+
+std::vector<uint8_t> LocalKVStoreBackend::batch_exist(
+    const std::vector<std::string>& keys) {
+  std::vector<uint8_t> statuses(keys.size(), /*value=*/0);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      statuses[i] = objects_.count(keys[i]) > 0 ? 1 : 0;
+    }
+  }
+  simulate_transfer(/*bytes=*/0);
+  return statuses;
+}
+
+std::vector<uint8_t> LocalKVStoreBackend::batch_put(
+    const std::vector<std::string>& keys,
+    const std::vector<std::vector<KVStoreSlice>>& slices) {
+  CHECK_EQ(keys.size(), slices.size());
+  std::vector<uint8_t> statuses(keys.size(), /*value=*/0);
+  size_t moved_bytes = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      const size_t bytes = total_bytes(slices[i]);
+      if (options_.capacity_bytes() > 0 && bytes > options_.capacity_bytes()) {
+        continue;
+      }
+      auto [it, inserted] = objects_.try_emplace(keys[i]);
+      Object& object = it->second;
+      if (inserted) {
+        lru_.push_front(keys[i]);
+      } else {
+        used_bytes_ -= object.data.size();
+        lru_.splice(lru_.begin(), lru_, object.lru_it);
+      }
+      object.lru_it = lru_.begin();
+      object.data.resize(bytes);
+      char* dst = object.data.data();
+      for (const KVStoreSlice& slice : slices[i]) {
+        std::memcpy(dst, slice.ptr, slice.size);
+        dst += slice.size;
+      }
+      used_bytes_ += bytes;
+      moved_bytes += bytes;
+      statuses[i] = 1;
+    }
+    evict_locked();
+  }
+  simulate_transfer(moved_bytes);
+  return statuses;
+}
+
+std::vector<uint8_t> LocalKVStoreBackend::batch_get(
+    const std::vector<std::string>& keys,
+    const std::vector<std::vector<KVStoreSlice>>& slices) {
+  CHECK_EQ(keys.size(), slices.size());
+  std::vector<uint8_t> statuses(keys.size(), /*value=*/0);
+  size_t moved_bytes = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      auto it = objects_.find(keys[i]);
+      if (it == objects_.end()) {
+        continue;
+      }
+      Object& object = it->second;
+      if (object.data.size() > total_bytes(slices[i])) {
+        LOG(WARNING) << "Local KV store object does not fit its slices: "
+                     << object.data.size() << " bytes";
+        continue;
+      }
+      const char* src = object.data.data();
+      size_t remaining = object.data.size();
+      for (const KVStoreSlice& slice : slices[i]) {
+        const size_t bytes = std::min(slice.size, remaining);
+        std::memcpy(slice.ptr, src, bytes);
+        src += bytes;
+        remaining -= bytes;
+      }
+      lru_.splice(lru_.begin(), lru_, object.lru_it);
+      moved_bytes += object.data.size();
+      statuses[i] = 1;
+    }
+  }
+  simulate_transfer(moved_bytes);
+  return statuses;
+}
+
+size_t LocalKVStoreBackend::num_objects() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return objects_.size();
+}
+
+size_t LocalKVStoreBackend::used_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return used_bytes_;
+}
+
+void LocalKVStoreBackend::evict_locked() {
+  if (options_.capacity_bytes() == 0) {
+    return;
+  }
+  while (used_bytes_ > options_.capacity_bytes() && !lru_.empty()) {
+    auto it = objects_.find(lru_.back());
+    CHECK(it != objects_.end());
+    used_bytes_ -= it->second.data.size();
+    objects_.erase(it);
+    lru_.pop_back();
+  }
+}
+
+void LocalKVStoreBackend::simulate_transfer(size_t bytes) {
+  Clock::time_point done = Clock::now();
+  if (options_.bandwidth_bytes_per_second() > 0.0 && bytes > 0) {
+    const std::chrono::duration<double> seconds(
+        bytes / options_.bandwidth_bytes_per_second());
+    const auto transfer_time =
+        std::chrono::duration_cast<Clock::duration>(seconds);
+    std::lock_guard<std::mutex> lock(link_mutex_);
+    link_free_at_ = std::max(link_free_at_, done) + transfer_time;
+    done = link_free_at_;
+  }
+  done += std::chrono::microseconds(options_.latency_us());
+  std::this_thread::sleep_until(done);
+}
+
+}  // namespace xllm
@@ -0,0 +1,99 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/macros.h"
+#include "framework/kv_cache_transfer/kv_store_backend.h"
+
+namespace xllm {
+
+// In-process stand-in for the Mooncake Store (--store_protocol=local), for
+// developing and benchmarking the store path without a master or a transfer
+// engine. Objects live in an LRU map bounded by capacity. Every batch call
+// costs a fixed latency plus its bytes over a link of the given bandwidth;
+// concurrent callers of one instance queue behind each other like workers
+// sharing a NIC. KVCacheStore takes its instance from get_shared(), so the
+// workers of a process share one store and one link; workers in different
+// processes each simulate their own.
+class LocalKVStoreBackend final : public KVStoreBackend {
+ public:
+  struct Options {
+    // 0 means unbounded.
+    PROPERTY(size_t, capacity_bytes) = 0;
+    // 0 means no transfer cost.
+    PROPERTY(double, bandwidth_bytes_per_second) = 0.0;
+    PROPERTY(int64_t, latency_us) = 0;
+  };
+
+  explicit LocalKVStoreBackend(const Options& options);
+
+  // Returns the instance of this process for `options`, creating it on the
+  // first call. It lives as long as a caller holds it.
+  static std::shared_ptr<LocalKVStoreBackend> get_shared(
+      const Options& options);
+
+  LocalKVStoreBackend(const LocalKVStoreBackend&) = delete;
+  LocalKVStoreBackend& operator=(const LocalKVStoreBackend&) = delete;
+
+  std::vector<uint8_t> batch_exist(
+      const std::vector<std::string>& keys) override;
+
+  std::vector<uint8_t> batch_put(
+      const std::vector<std::string>& keys,
+      const std::vector<std::vector<KVStoreSlice>>& slices) override;
+
+  std::vector<uint8_t> batch_get(
+      const std::vector<std::string>& keys,
+      const std::vector<std::vector<KVStoreSlice>>& slices) override;
+
+  size_t num_objects() const;
+  size_t used_bytes() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Object {
+    std::vector<char> data;
+    std::list<std::string>::iterator lru_it;
+  };
+
+  void evict_locked();
+
+  // Blocks the caller for one round trip moving `bytes`.
+  void simulate_transfer(size_t bytes);
+
+  const Options options_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Object> objects_;
+  // most recently used first.
+  std::list<std::string> lru_;
+  size_t used_bytes_ = 0;
+
+  std::mutex link_mutex_;
+  Clock::time_point link_free_at_;
+};
+
+}  // namespace xllm
@@ -0,0 +1,159 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "framework/kv_cache_transfer/mooncake_kv_store_backend.h"
+
+#include <Mooncake/mooncake-store/include/utils.h>
+#include <glog/logging.h>
+
+#include <cstdlib>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace xllm {
+namespace {
+
+std::vector<mooncake::Slice> to_mooncake_slices(
+    const std::vector<KVStoreSlice>& slices) {
+  std::vector<mooncake::Slice> mooncake_slices;
+  mooncake_slices.reserve(slices.size());
+  for (const KVStoreSlice& slice : slices) {
+    mooncake_slices.emplace_back(mooncake::Slice{slice.ptr, slice.size});
+  }
+  return mooncake_slices;
+}
+
+}  // namespace
+
+std::unique_ptr<MooncakeKVStoreBackend> MooncakeKVStoreBackend::create(
+    const std::string& localhost_name,
+    const std::string& metadata_server,
+    const std::string& protocol,
+    const std::string& master_server_address,
+    int32_t replica_num) {
+  std::string effective_protocol = protocol;
+  std::optional<std::string> device_names = std::nullopt;
+  if (effective_protocol == "rdma") {
+    const char* configured_devices = std::getenv("DEVICE_NAMES");
+    if (configured_devices != nullptr) {
+      device_names = configured_devices;
+      LOG(INFO) << "Mooncake RDMA device_names: " << device_names.value();
+    } else {
+      LOG(WARNING) << "DEVICE_NAMES is not set; falling back to TCP.";
+      effective_protocol = "tcp";
+    }
+  }
+
+  auto client = mooncake::Client::Create(localhost_name,
+                                         metadata_server,
+                                         effective_protocol,
+                                         device_names,
+                                         master_server_address);
+  if (!client.has_value()) {
+    LOG(ERROR) << "Failed to create Mooncake Store client for "
+               << localhost_name;
+    return nullptr;
+  }
+  return std::unique_ptr<MooncakeKVStoreBackend>(
+      new MooncakeKVStoreBackend(client.value(),
+                                 /*use_rdma=*/effective_protocol == "rdma",
+                                 replica_num));
+}
+
+MooncakeKVStoreBackend::MooncakeKVStoreBackend(
+    std::shared_ptr<mooncake::Client> client,
+    bool use_rdma,
+    int32_t replica_num)
+    : client_(std::move(client)), use_rdma_(use_rdma) {
+  rep_config_.replica_num = replica_num;
+}
+
+MooncakeKVStoreBackend::~MooncakeKVStoreBackend() { client_.reset(); }
+
+bool MooncakeKVStoreBackend::register_memory(void* address, size_t bytes) {
+  if (!use_rdma_) {
+    return true;
+  }
+  auto result = client_->RegisterLocalMemory(address,
+                                             bytes,
+                                             /*location=*/"cpu:0",
+                                             /*remote_accessible=*/false,
+                                             /*update_metadata=*/false);
+  if (!result.has_value()) {
+    LOG(ERROR) << "Failed to register Mooncake Host memory: "
+               << toString(result.error());
+    return false;
+  }
+  return true;
+}
+
+void MooncakeKVStoreBackend::unregister_memory(void* address) {
+  if (!use_rdma_) {
+    return;
+  }
+  auto result =
+      client_->unregisterLocalMemory(address, /*update_metadata=*/false);
+  if (!result.has_value()) {
+    LOG(WARNING) << "Failed to unregister Mooncake Host memory: "
+                 << toString(result.error());
+  }
+}
+
+std::vector<uint8_t> MooncakeKVStoreBackend::batch_exist(
+    const std::vector<std::string>& keys) {
+  const auto exists = client_->BatchIsExist(keys);
+  std::vector<uint8_t> statuses(keys.size(), /*value=*/0);
+  for (size_t i = 0; i < keys.size() && i < exists.size(); ++i) {
+    statuses[i] = exists[i].has_value() && exists[i].value() ? 1 : 0;
+  }
+  return statuses;
+}
+
+std::vector<uint8_t> MooncakeKVStoreBackend::batch_put(
+    const std::vector<std::string>& keys,
+    const std::vector<std::vector<KVStoreSlice>>& slices) {
+  CHECK_EQ(keys.size(), slices.size());
+  std::vector<std::vector<mooncake::Slice>> put_slices;
+  put_slices.reserve(slices.size());
+  for (const std::vector<KVStoreSlice>& object_slices : slices) {
+    put_slices.emplace_back(to_mooncake_slices(object_slices));
+  }
+  const auto results = client_->BatchPut(keys, put_slices, rep_config_);
+  std::vector<uint8_t> statuses(keys.size(), /*value=*/0);
+  for (size_t i = 0; i < keys.size() && i < results.size(); ++i) {
+    statuses[i] = results[i].has_value() ? 1 : 0;
+  }
+  return statuses;
+}
+
+std::vector<uint8_t> MooncakeKVStoreBackend::batch_get(
+    const std::vector<std::string>& keys,
+    const std::vector<std::vector<KVStoreSlice>>& slices) {
+  CHECK_EQ(keys.size(), slices.size());
+  std::unordered_map<std::string, std::vector<mooncake::Slice>> get_slices;
+  get_slices.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    get_slices.emplace(keys[i], to_mooncake_slices(slices[i]));
+  }
+  const auto results = client_->BatchGet(keys, get_slices);
+  std::vector<uint8_t> statuses(keys.size(), /*value=*/0);
+  for (size_t i = 0; i < keys.size() && i < results.size(); ++i) {
+    statuses[i] = results[i].has_value() ? 1 : 0;
+  }
+  return statuses;
+}
+
+}  // namespace xllm
@@ -0,0 +1,70 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <Mooncake/mooncake-store/include/client_service.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "framework/kv_cache_transfer/kv_store_backend.h"
+
+namespace xllm {
+
+// KVStoreBackend on a Mooncake Store client.
+class MooncakeKVStoreBackend final : public KVStoreBackend {
+ public:
+  // Returns nullptr if the client cannot connect. RDMA falls back to TCP
+  // when DEVICE_NAMES is not set.
+  static std::unique_ptr<MooncakeKVStoreBackend> create(
+      const std::string& localhost_name,
+      const std::string& metadata_server,
+      const std::string& protocol,
+      const std::string& master_server_address,
+      int32_t replica_num);
+
+  ~MooncakeKVStoreBackend() override;
+
+  MooncakeKVStoreBackend(const MooncakeKVStoreBackend&) = delete;
+  MooncakeKVStoreBackend& operator=(const MooncakeKVStoreBackend&) = delete;
+
+  // Only RDMA transfers need registered buffers.
+  bool register_memory(void* address, size_t bytes) override;
+  void unregister_memory(void* address) override;
+
+  std::vector<uint8_t> batch_exist(
+      const std::vector<std::string>& keys) override;
+
+  std::vector<uint8_t> batch_put(
+      const std::vector<std::string>& keys,
+      const std::vector<std::vector<KVStoreSlice>>& slices) override;
+
+  std::vector<uint8_t> batch_get(
+      const std::vector<std::string>& keys,
+      const std::vector<std::vector<KVStoreSlice>>& slices) override;
+
+ private:
+  MooncakeKVStoreBackend(std::shared_ptr<mooncake::Client> client,
+                         bool use_rdma,
+                         int32_t replica_num);
+
+  std::shared_ptr<mooncake::Client> client_;
+  const bool use_rdma_;
+  mooncake::ReplicateConfig rep_config_;
+};
+
+}  // namespace xllm
@@ -942,6 +942,8 @@ bool MooncakeTransferEngine::move_memory_by_global_offsets(
     }
     regions.emplace_back(std::move(region));
   }
+  // adjacent XTensor pages of adjacent blocks move as one region.
+  coalesce_byte_regions(&regions);
   return move_memory_regions(remote_addr, regions, move_opcode);
 }
 
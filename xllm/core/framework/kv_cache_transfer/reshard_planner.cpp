@@ -847,6 +847,44 @@ Status ReshardPlanner::build_outgoing_plan(
   return Status();
 }
 
+void coalesce_byte_regions(std::vector<ByteRegion>* regions) {
+  if (regions == nullptr || regions->size() < 2) {
+    return;
+  }
+  std::sort(regions->begin(),
+            regions->end(),
+            [](const ByteRegion& lhs, const ByteRegion& rhs) {
+              return std::tie(lhs.local_buffer_id,
+                              lhs.remote_buffer_id,
+                              lhs.local_offset,
+                              lhs.remote_offset) <
+                     std::tie(rhs.local_buffer_id,
+                              rhs.remote_buffer_id,
+                              rhs.local_offset,
+                              rhs.remote_offset);
+            });
+
+  size_t merged = 0;
+  for (size_t index = 1; index < regions->size(); ++index) {
+    ByteRegion& previous = (*regions)[merged];
+    const ByteRegion& current = (*regions)[index];
+    const bool adjacent =
+        previous.local_buffer_id == current.local_buffer_id &&
+        previous.remote_buffer_id == current.remote_buffer_id &&
+        !add_overflows(previous.local_offset, previous.length) &&
+        !add_overflows(previous.remote_offset, previous.length) &&
+        previous.local_offset + previous.length == current.local_offset &&
+        previous.remote_offset + previous.length == current.remote_offset &&
+        !add_overflows(previous.length, current.length);
+    if (adjacent) {
+      previous.length += current.length;
+    } else {
+      (*regions)[++merged] = current;
+    }
+  }
+  regions->resize(merged + 1);
+}
+
 Status RequestRegionBinder::bind(const ReshardPlanTemplate& plan,
                                  const std::vector<KVTransferMapping>& mappings,
                                  CacheNamespace cache_namespace,
@@ -32,6 +32,11 @@ struct ByteRegion {
   uint64_t length = 0;
 };
 
+// Sorts regions and merges the ones that are adjacent on both the local and
+// the remote side, so each run of adjacent blocks costs one transfer
+// descriptor instead of one per block.
+void coalesce_byte_regions(std::vector<ByteRegion>* regions);
+
 struct StridedRegionTemplate {
   CacheNamespace cache_namespace = CacheNamespace::MAIN;
   int64_t layer_id = 0;
@@ -17,11 +17,13 @@ limitations under the License.
 #pragma once
 
 #include <c10/core/Device.h>
+#include <glog/logging.h>
 #include <torch/torch.h>
 
 #include <vector>
 
 #include "core/framework/dit_model_loader.h"
+#include "core/framework/model/model_traits.h"
 #include "core/runtime/dit_forward_params.h"
 namespace xllm {
 
@@ -30,6 +32,13 @@ class DiTModel : public torch::nn::Module {
   ~DiTModel() override = default;
 
   virtual DiTForwardOutput forward(const DiTForwardInput& input) = 0;
+  // run one denoising step of a step-level batch, see
+  // DiTForwardInput::joining_request_ids
+  virtual bool supports_step_batching() const { return false; }
+  virtual DiTForwardOutput step(const DiTForwardInput& input) {
+    LOG(FATAL) << "step-level batching is not supported by this DiT model";
+    return {};
+  }
   virtual torch::Device device() const = 0;
   virtual const torch::TensorOptions& options() const = 0;
   virtual void load_model(std::unique_ptr<DiTModelLoader> loader) = 0;
@@ -43,6 +52,16 @@ class DiTModelImpl : public DiTModel {
   DiTForwardOutput forward(const DiTForwardInput& input) override {
     return model_->forward(input);
   }
+  bool supports_step_batching() const override {
+    return detail::has_dit_step<Model>::value;
+  }
+  DiTForwardOutput step(const DiTForwardInput& input) override {
+    if constexpr (detail::has_dit_step<Model>::value) {
+      return model_->step(input);
+    } else {
+      return DiTModel::step(input);
+    }
+  }
   torch::Device device() const override { return options_.device(); }
   const torch::TensorOptions& options() const override { return options_; }
   void load_model(std::unique_ptr<DiTModelLoader> loader) override {
@@ -788,6 +788,17 @@ struct ModelEmbeddingInput {
   // request ids of each sequence, used by suffix decoding request identity
   std::vector<std::string> request_ids;
 
+  // for the NGram drafter: the tokens each request_ids row has before its
+  // input tokens (earlier prefill chunks, prefix cache hits), flattened, with
+  // one length per request_ids row and -1 for decode rows; empty for other
+  // algorithms
+  std::vector<int32_t> history_token_ids;
+  std::vector<int32_t> history_token_lens;
+
+  // requests finished or cancelled since the previous step, whose per-request
+  // worker state can be dropped
+  std::vector<std::string> released_request_ids;
+
   // chunked prefill case of speculative decoding
   // extra token ids for each sequence, and -1 for last chunk
   std::vector<int32_t> extra_token_ids;
@@ -806,6 +817,9 @@ struct ModelEmbeddingInput {
     out.linear_state_ids = linear_state_ids;
     out.linear_state_indices = safe_to(linear_state_indices, device, true);
     out.request_ids = request_ids;
+    out.history_token_ids = history_token_ids;
+    out.history_token_lens = history_token_lens;
+    out.released_request_ids = released_request_ids;
     out.extra_token_ids = extra_token_ids;
     out.mtp_shifted_token_ids = safe_to(mtp_shifted_token_ids, device, true);
     out.mtp_bootstrap_row_idxes = mtp_bootstrap_row_idxes;
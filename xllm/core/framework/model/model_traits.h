@@ -25,6 +25,7 @@ limitations under the License.
 namespace xllm {
 struct ModelInputParams;
 struct ModelGraphMetadataState;
+struct DiTForwardInput;
 class KVCache;
 
 namespace layer {
@@ -289,5 +290,14 @@ struct has_has_dspark_confidence_head<
     std::void_t<decltype(std::declval<T>()->has_dspark_confidence_head())>>
     : std::true_type {};
 
+template <typename T, typename = void>
+struct has_dit_step : std::false_type {};
+
+template <typename T>
+struct has_dit_step<T,
+                    std::void_t<decltype(std::declval<T>()->step(
+                        std::declval<const DiTForwardInput&>()))>>
+    : std::true_type {};
+
 }  // namespace detail
 }  // namespace xllm
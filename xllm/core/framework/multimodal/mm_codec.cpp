@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -131,8 +132,75 @@ void convert_decoded_image_to_rgb(const cv::Mat& image, cv::Mat& rgb_image) {
   }
 }
 
+// Picks the strongest IMREAD_REDUCED_COLOR_* mode that keeps at least
+// `max_pixels` pixels, or IMREAD_UNCHANGED to decode at full resolution.
+int32_t select_image_read_mode(const std::string& raw_data,
+                               int64_t max_pixels) {
+  int32_t height = 0;
+  int32_t width = 0;
+  if (max_pixels <= 0 || !read_jpeg_frame_size(raw_data, height, width)) {
+    return cv::IMREAD_UNCHANGED;
+  }
+  static constexpr std::pair<int32_t, int32_t> kReducedModes[] = {
+      {8, cv::IMREAD_REDUCED_COLOR_8},
+      {4, cv::IMREAD_REDUCED_COLOR_4},
+      {2, cv::IMREAD_REDUCED_COLOR_2}};
+  for (const auto& [factor, mode] : kReducedModes) {
+    const int64_t reduced_pixels =
+        static_cast<int64_t>(height / factor) * (width / factor);
+    if (reduced_pixels >= max_pixels) {
+      // IMREAD_UNCHANGED does not apply EXIF orientation; neither may this.
+      return mode | cv::IMREAD_IGNORE_ORIENTATION;
+    }
+  }
+  return cv::IMREAD_UNCHANGED;
+}
+
 }  // namespace
 
+bool read_jpeg_frame_size(const std::string& data,
+                          int32_t& height,
+                          int32_t& width) {
+  const auto byte_at = [&data](size_t pos) {
+    return static_cast<uint8_t>(data[pos]);
+  };
+  if (data.size() < 4 || byte_at(0) != 0xFF || byte_at(1) != 0xD8) {
+    return false;
+  }
+  size_t pos = 2;
+  while (pos + 4 <= data.size()) {
+    if (byte_at(pos) != 0xFF) {
+      return false;
+    }
+    const uint8_t marker = byte_at(pos + 1);
+    if (marker == 0xFF) {  // fill byte
+      ++pos;
+      continue;
+    }
+    pos += 2;
+    if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {
+      continue;  // markers without a payload
+    }
+    const size_t length = (byte_at(pos) << 8) | byte_at(pos + 1);
+    if (length < 2 || marker == 0xDA) {  // SOS precedes any frame header
+      return false;
+    }
+    const bool is_frame_header = marker >= 0xC0 && marker <= 0xCF &&
+                                 marker != 0xC4 && marker != 0xC8 &&
+                                 marker != 0xCC;
+    if (is_frame_header) {
+      if (pos + 7 > data.size()) {
+        return false;
+      }
+      height = (byte_at(pos + 3) << 8) | byte_at(pos + 4);
+      width = (byte_at(pos + 5) << 8) | byte_at(pos + 6);
+      return height > 0 && width > 0;
+    }
+    pos += length;
+  }
+  return false;
+}
+
 class MemoryMediaReader {
  public:
   MemoryMediaReader(const uint8_t* data, size_t size) {
@@ -212,8 +280,11 @@ class MemoryMediaReader {
       return false;
     }
 
-    if (avcodec_parameters_to_context(codec_ctx_, st->codecpar) < 0 ||
-        avcodec_open2(codec_ctx_, codec, nullptr) < 0) {
+    if (avcodec_parameters_to_context(codec_ctx_, st->codecpar) < 0) {
+      return false;
+    }
+    configure_codec(codec_ctx_);
+    if (avcodec_open2(codec_ctx_, codec, nullptr) < 0) {
       return false;
     }
 
@@ -260,6 +331,9 @@ class MemoryMediaReader {
   // video->RGB tensor, audio->PCM samples
   virtual bool handle_frame(AVFrame* f) = 0;
 
+  // Adjusts the decoder context before it is opened.
+  virtual void configure_codec(AVCodecContext* /*codec_ctx*/) {}
+
  protected:
   AVFormatContext* fmt_ctx_ = nullptr;
   uint8_t* avio_buf_ = nullptr;
@@ -273,8 +347,10 @@ class MemoryMediaReader {
 
 class MemoryVideoReader : public MemoryMediaReader {
  public:
-  MemoryVideoReader(const uint8_t* data, size_t size)
-      : MemoryMediaReader(data, size) {}
+  MemoryVideoReader(const uint8_t* data,
+                    size_t size,
+                    const FFmpegVideoDecoder::Options& options)
+      : MemoryMediaReader(data, size), options_(options) {}
 
   ~MemoryVideoReader() {
     if (sws_ctx_) {
@@ -297,13 +373,18 @@ class MemoryVideoReader : public MemoryMediaReader {
     metadata.fps = (r.num && r.den) ? av_q2d(r) : 0.0;
     metadata.total_num_frames = 0;
     metadata.duration = 0.0;
+
+    // keep every frame_stride_-th frame, at no less than target_fps.
+    if (options_.target_fps > 0.0 && metadata.fps > options_.target_fps) {
+      frame_stride_ = static_cast<int64_t>(metadata.fps / options_.target_fps);
+    }
     return true;
   }
 
   bool read(torch::Tensor& tensor, VideoMetadata& metadata) {
     CHECK(frames_.empty()) << "frames is not cleared before read";
 
-    if (!decode()) {
+    if (!(frame_stride_ > 1 ? decode_sampled(metadata.fps) : decode())) {
       return false;
     }
     if (frames_.empty()) {
@@ -311,6 +392,8 @@ class MemoryVideoReader : public MemoryMediaReader {
     }
 
     tensor = torch::stack(frames_);  // [T,C,H,W]
+    // describe the kept frames, which are evenly spaced in the source.
+    metadata.fps /= static_cast<double>(frame_stride_);
     metadata.total_num_frames = static_cast<int32_t>(frames_.size());
     metadata.duration =
         (metadata.fps > 0.0)
@@ -320,21 +403,31 @@ class MemoryVideoReader : public MemoryMediaReader {
   }
 
   bool handle_frame(AVFrame* f) override {
-    // init colorspace converter once based on first frame
+    int32_t out_width = f->width;
+    int32_t out_height = f->height;
+    const int64_t pixels = static_cast<int64_t>(f->width) * f->height;
+    if (options_.max_pixels > 0 && pixels > options_.max_pixels) {
+      const double scale =
+          std::sqrt(static_cast<double>(options_.max_pixels) / pixels);
+      out_width = std::max(1, static_cast<int32_t>(f->width * scale));
+      out_height = std::max(1, static_cast<int32_t>(f->height * scale));
+    }
+
+    // the converter is rebuilt only if the input or output geometry changes
+    sws_ctx_ = sws_getCachedContext(
+        sws_ctx_,
+        f->width,
+        f->height,
+        static_cast<AVPixelFormat>(f->format),
+        out_width,
+        out_height,
+        AV_PIX_FMT_RGB24,
+        out_width == f->width ? SWS_BILINEAR : SWS_AREA,
+        nullptr,
+        nullptr,
+        nullptr);
     if (!sws_ctx_) {
-      sws_ctx_ = sws_getContext(f->width,
-                                f->height,
-                                static_cast<AVPixelFormat>(f->format),
-                                f->width,
-                                f->height,
-                                AV_PIX_FMT_RGB24,
-                                SWS_BILINEAR,
-                                nullptr,
-                                nullptr,
-                                nullptr);
-      if (!sws_ctx_) {
-        return false;
-      }
+      return false;
     }
 
     // use an FFmpeg-allocated frame so sws_scale writes into a buffer with the
@@ -346,13 +439,13 @@ class MemoryVideoReader : public MemoryMediaReader {
       }
     }
 
-    // (re)allocate the RGB buffer when input changes
-    if (rgb_frame_->width != f->width || rgb_frame_->height != f->height ||
+    // (re)allocate the RGB buffer when the output size changes
+    if (rgb_frame_->width != out_width || rgb_frame_->height != out_height ||
         rgb_frame_->format != AV_PIX_FMT_RGB24 || !rgb_frame_->data[0]) {
       av_frame_unref(rgb_frame_);
       rgb_frame_->format = AV_PIX_FMT_RGB24;
-      rgb_frame_->width = f->width;
-      rgb_frame_->height = f->height;
+      rgb_frame_->width = out_width;
+      rgb_frame_->height = out_height;
       if (av_frame_get_buffer(rgb_frame_, 0) < 0) {
         return false;
       }
@@ -368,13 +461,13 @@ class MemoryVideoReader : public MemoryMediaReader {
                   0,
                   f->height,
                   rgb_frame_->data,
-                  rgb_frame_->linesize) != f->height) {
+                  rgb_frame_->linesize) != out_height) {
       return false;
     }
 
     // build CHW uint8 tensor
-    const int64_t H = f->height;
-    const int64_t W = f->width;
+    const int64_t H = out_height;
+    const int64_t W = out_width;
     const int64_t src_ls = rgb_frame_->linesize[0];
 
     auto rgb = torch::from_blob(rgb_frame_->data[0],
@@ -387,7 +480,126 @@ class MemoryVideoReader : public MemoryMediaReader {
     return true;
   }
 
+ protected:
+  void configure_codec(AVCodecContext* codec_ctx) override {
+    codec_ctx->thread_count = options_.num_threads;
+    if (options_.num_threads != 1) {
+      codec_ctx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+    }
+  }
+
  private:
+  // Decodes only as much of the stream as the kept frames need: frames in
+  // between are decoded without colour conversion, non-reference frames are
+  // skipped while the next kept frame is far ahead, and GOPs that hold no
+  // kept frame are skipped by seeking to the keyframe before the next one.
+  bool decode_sampled(double fps) {
+    CHECK(fmt_ctx_ && codec_ctx_ && pkt_ && frm_) << "ffmpeg init failed";
+    AVStream* st = fmt_ctx_->streams[stream_index_];
+    const double ticks_per_frame = 1.0 / (av_q2d(st->time_base) * fps);
+    const int64_t start_pts =
+        st->start_time != AV_NOPTS_VALUE ? st->start_time : 0;
+    const auto frame_pts = [&](int64_t ordinal) {
+      return start_pts + std::llround(ordinal * ticks_per_frame);
+    };
+    const auto ordinal_of = [&](int64_t pts) {
+      return std::llround((pts - start_pts) / ticks_per_frame);
+    };
+
+    // source ordinal of the next frame to keep, and of the last decoded one
+    int64_t next_keep = 0;
+    int64_t last_ordinal = -1;
+    int64_t last_read_dts = AV_NOPTS_VALUE;
+    // seeks only move forward, so an imprecise seek cannot loop
+    int64_t sought_keyframe = AV_NOPTS_VALUE;
+    // source ordinal of the next demuxed packet. Packets without timestamps
+    // are stamped from it, so that their frames keep their place even when
+    // non-reference frames around them are skipped.
+    int64_t next_packet_ordinal = 0;
+
+    const auto receive_frames = [&]() {
+      while (avcodec_receive_frame(codec_ctx_, frm_) == 0) {
+        const int64_t pts = frm_->best_effort_timestamp;
+        const int64_t ordinal =
+            pts == AV_NOPTS_VALUE ? last_ordinal + 1 : ordinal_of(pts);
+        last_ordinal = ordinal;
+        if (ordinal < next_keep) {
+          continue;
+        }
+        if (!handle_frame(frm_)) {
+          return false;
+        }
+        next_keep = (ordinal / frame_stride_ + 1) * frame_stride_;
+      }
+      return true;
+    };
+
+    while (true) {
+      // jump to the keyframe before the next kept frame once the demuxer is
+      // behind it; everything buffered in the decoder precedes that keyframe.
+      const int64_t keyframe = keyframe_before(st, frame_pts(next_keep));
+      if (keyframe != AV_NOPTS_VALUE && last_read_dts != AV_NOPTS_VALUE &&
+          keyframe > last_read_dts &&
+          (sought_keyframe == AV_NOPTS_VALUE || keyframe > sought_keyframe)) {
+        sought_keyframe = keyframe;
+        if (av_seek_frame(
+                fmt_ctx_, stream_index_, keyframe, AVSEEK_FLAG_BACKWARD) >=
+            0) {
+          avcodec_flush_buffers(codec_ctx_);
+          last_read_dts = AV_NOPTS_VALUE;
+          next_packet_ordinal = ordinal_of(keyframe);
+        }
+      }
+
+      if (av_read_frame(fmt_ctx_, pkt_) < 0) {
+        break;
+      }
+      if (pkt_->stream_index != stream_index_) {
+        av_packet_unref(pkt_);
+        continue;
+      }
+      if (pkt_->dts != AV_NOPTS_VALUE) {
+        last_read_dts = pkt_->dts;
+      }
+      if (pkt_->pts == AV_NOPTS_VALUE && pkt_->dts == AV_NOPTS_VALUE) {
+        pkt_->pts = frame_pts(next_packet_ordinal);
+      }
+      next_packet_ordinal =
+          ordinal_of(pkt_->dts != AV_NOPTS_VALUE ? pkt_->dts : pkt_->pts) + 1;
+      // decoded output lags the packets by the reorder delay plus one frame
+      // per decoding thread; frames within that lag may still be kept.
+      const int64_t reorder_margin = codec_ctx_->has_b_frames +
+                                     std::max(codec_ctx_->thread_count, 1) + 1;
+      codec_ctx_->skip_frame = next_keep - last_ordinal > reorder_margin
+                                   ? AVDISCARD_NONREF
+                                   : AVDISCARD_DEFAULT;
+      const bool sent = avcodec_send_packet(codec_ctx_, pkt_) == 0;
+      av_packet_unref(pkt_);
+      if (sent && !receive_frames()) {
+        return false;
+      }
+    }
+
+    // flush decoder at end of stream
+    codec_ctx_->skip_frame = AVDISCARD_DEFAULT;
+    avcodec_send_packet(codec_ctx_, nullptr);
+    return receive_frames();
+  }
+
+  // Timestamp of the last indexed keyframe at or before `pts`, or
+  // AV_NOPTS_VALUE if the container has no index.
+  static int64_t keyframe_before(AVStream* st, int64_t pts) {
+    const int32_t index =
+        av_index_search_timestamp(st, pts, AVSEEK_FLAG_BACKWARD);
+    if (index < 0) {
+      return AV_NOPTS_VALUE;
+    }
+    const AVIndexEntry* entry = avformat_index_get_entry(st, index);
+    return entry != nullptr ? entry->timestamp : AV_NOPTS_VALUE;
+  }
+
+  const FFmpegVideoDecoder::Options options_;
+  int64_t frame_stride_ = 1;
   SwsContext* sws_ctx_ = nullptr;
   AVFrame* rgb_frame_ = nullptr;
   std::vector<torch::Tensor> frames_;
@@ -548,13 +760,16 @@ class MemoryAudioReader : public MemoryMediaReader {
   std::vector<float> pcm_;
 };
 
-bool OpenCVImageDecoder::decode(const std::string& raw_data, torch::Tensor& t) {
+bool OpenCVImageDecoder::decode(const std::string& raw_data,
+                                torch::Tensor& t,
+                                int64_t max_pixels) {
   cv::Mat buffer(1, raw_data.size(), CV_8UC1, (void*)raw_data.data());
   if (raw_data.empty()) {
     LOG(ERROR) << "opencv image decode got empty data";
     return false;
   }
-  cv::Mat image = cv::imdecode(buffer, cv::IMREAD_UNCHANGED);
+  cv::Mat image =
+      cv::imdecode(buffer, select_image_read_mode(raw_data, max_pixels));
   if (image.empty()) {
     LOG(INFO) << "opencv image decode failed";
     return false;
@@ -614,7 +829,8 @@ bool FFmpegVideoDecoder::decode(const std::string& raw_data,
                                 torch::Tensor& t,
                                 VideoMetadata& metadata) {
   MemoryVideoReader reader(reinterpret_cast<const uint8_t*>(raw_data.data()),
-                           raw_data.size());
+                           raw_data.size(),
+                           options_);
 
   if (!reader.init(metadata) || !reader.read(t, metadata)) {
     LOG(INFO) << "video decode failed";
@@ -24,12 +24,23 @@ limitations under the License.
 
 namespace xllm {
 
+// Reads the frame size from the SOFn marker of a JPEG stream without decoding
+// it. Returns false for other formats and malformed or truncated headers.
+bool read_jpeg_frame_size(const std::string& data,
+                          int32_t& height,
+                          int32_t& width);
+
 class OpenCVImageDecoder {
  public:
   OpenCVImageDecoder() = default;
   ~OpenCVImageDecoder() = default;
 
-  bool decode(const std::string& raw_data, torch::Tensor& t);
+  // With `max_pixels` > 0, a JPEG is decoded at a reduced 1/2, 1/4 or 1/8
+  // scale by libjpeg DCT downscaling, as long as the decoded image still has
+  // at least `max_pixels` pixels.
+  bool decode(const std::string& raw_data,
+              torch::Tensor& t,
+              int64_t max_pixels = 0);
 };
 
 class OpenCVImageEncoder {
@@ -45,12 +56,28 @@ class OpenCVImageEncoder {
 
 class FFmpegVideoDecoder {
  public:
+  struct Options {
+    // Keep only every n-th frame such that the kept frames still run at no
+    // less than this rate, seeking past keyframes that no kept frame needs.
+    // `meta` then describes the kept frames. 0 keeps every frame.
+    double target_fps = 0.0;
+    // Downscale kept frames to at most this many pixels during the colour
+    // conversion, keeping the aspect ratio. 0 keeps the coded size.
+    int64_t max_pixels = 0;
+    // FFmpeg decoding threads; 0 lets FFmpeg choose.
+    int32_t num_threads = 1;
+  };
+
   FFmpegVideoDecoder() = default;
+  explicit FFmpegVideoDecoder(const Options& options) : options_(options) {}
   ~FFmpegVideoDecoder() = default;
 
   bool decode(const std::string& raw_data,
               torch::Tensor& t,
               VideoMetadata& meta);
+
+ private:
+  Options options_;
 };
 
 class FFmpegAudioDecoder {
@@ -145,7 +145,10 @@ MMErrCode ImageHandler::load(const MMContent& content,
 
 MMErrCode ImageHandler::decode(MMInputItem& input) {
   OpenCVImageDecoder decoder;
-  if (!decoder.decode(input.raw_data, input.decode_image)) {
+  if (!decoder.decode(
+          input.raw_data,
+          input.decode_image,
+          ::xllm::ModelConfig::get_instance().image_decode_max_pixels())) {
     return MMErrCode::DECODE_ERR;
   }
   return MMErrCode::SUCCESS;
@@ -192,7 +195,12 @@ MMErrCode VideoHandler::decode(MMInputItem& input) {
     }
   }
 
-  FFmpegVideoDecoder decoder;
+  const ModelConfig& model_config = ::xllm::ModelConfig::get_instance();
+  FFmpegVideoDecoder::Options options;
+  options.target_fps = model_config.video_decode_fps();
+  options.max_pixels = model_config.video_decode_max_pixels();
+  options.num_threads = model_config.video_decode_threads();
+  FFmpegVideoDecoder decoder(options);
   if (!decoder.decode(input.raw_data, input.decode_video, input.video_meta)) {
     return MMErrCode::DECODE_ERR;
   }
@@ -0,0 +1,203 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "kv_cache_summary.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "block_hasher.h"
+#include "core/framework/config/distributed_config.h"
+
+namespace xllm {
+
+KVCacheSummary::KVCacheSummary(const Options& options)
+    : full_snapshot_interval_(options.full_snapshot_interval()),
+      num_counters_(options.num_counters()),
+      num_hashes_(options.num_hashes()),
+      counters_(options.num_counters(), 0),
+      dirty_(options.num_counters(), 0) {
+  CHECK_GT(num_counters_, 0u) << "KVCacheSummary needs at least one counter";
+  CHECK_GT(num_hashes_, 0u) << "KVCacheSummary needs at least one hash";
+}
+
+KVCacheSummary& KVCacheSummary::get_instance() {
+  static KVCacheSummary summary([] {
+    Options options;
+    options.num_counters(static_cast<uint32_t>(
+        DistributedConfig::get_instance().kv_cache_summary_num_counters()));
+    return options;
+  }());
+  return summary;
+}
+
+template <typename Fn>
+void KVCacheSummary::for_each_index(const XXH3Key& block_hash, Fn&& fn) const {
+  // block hashes are already uniform: derive the k indices from its two
+  // halves (Kirsch-Mitzenmacher double hashing).
+  uint64_t h1 = 0;
+  uint64_t h2 = 0;
+  std::memcpy(&h1, block_hash.data, sizeof(h1));
+  std::memcpy(&h2, block_hash.data + sizeof(h1), sizeof(h2));
+  h2 |= 1;
+  for (uint32_t i = 0; i < num_hashes_; ++i) {
+    fn(static_cast<uint32_t>((h1 + i * h2) % num_counters_));
+  }
+}
+
+void KVCacheSummary::mark_dirty(uint32_t index) {
+  if (dirty_[index] == 0) {
+    dirty_[index] = 1;
+    dirty_indices_.push_back(index);
+  }
+}
+
+void KVCacheSummary::add(const std::vector<XXH3Key>& block_hashes) {
+  if (block_hashes.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const XXH3Key& block_hash : block_hashes) {
+    for_each_index(block_hash, [this](uint32_t index) {
+      if (counters_[index] < kMaxCount) {
+        ++counters_[index];
+        mark_dirty(index);
+      }
+    });
+  }
+}
+
+void KVCacheSummary::remove(const std::vector<XXH3Key>& block_hashes) {
+  if (block_hashes.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const XXH3Key& block_hash : block_hashes) {
+    for_each_index(block_hash, [this](uint32_t index) {
+      // a saturated counter no longer knows its count, keep it set.
+      if (counters_[index] > 0 && counters_[index] < kMaxCount) {
+        --counters_[index];
+        mark_dirty(index);
+      }
+    });
+  }
+}
+
+bool KVCacheSummary::may_contain_locked(const XXH3Key& block_hash) const {
+  bool found = true;
+  for_each_index(block_hash, [&](uint32_t index) {
+    found = found && counters_[index] > 0;
+  });
+  return found;
+}
+
+bool KVCacheSummary::may_contain(const XXH3Key& block_hash) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return !stale_ && may_contain_locked(block_hash);
+}
+
+size_t KVCacheSummary::estimate_match_blocks(
+    const Slice<XXH3Key>& block_hashes) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (stale_) {
+    return 0;
+  }
+  size_t n_blocks = 0;
+  while (n_blocks < block_hashes.size() &&
+         may_contain_locked(block_hashes[n_blocks])) {
+    ++n_blocks;
+  }
+  return n_blocks;
+}
+
+size_t KVCacheSummary::estimate_match_blocks(const Slice<int32_t>& token_ids,
+                                             int32_t block_size) const {
+  CHECK_GT(block_size, 0);
+  const size_t n_blocks = token_ids.size() / block_size;
+  std::vector<XXH3Key> block_hashes(n_blocks);
+  for (size_t i = 0; i < n_blocks; ++i) {
+    xxh3_128bits_hash(i == 0 ? nullptr : block_hashes[i - 1].data,
+                      token_ids.slice(i * block_size, (i + 1) * block_size),
+                      block_hashes[i].data);
+  }
+  return estimate_match_blocks(block_hashes);
+}
+
+void KVCacheSummary::request_full_snapshot() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  full_requested_ = true;
+}
+
+KVCacheSummary::Delta KVCacheSummary::take_delta() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Delta delta;
+  delta.sequence = ++sequence_;
+  delta.num_hashes = num_hashes_;
+  // an index costs a few bytes on the wire, a full counter one byte.
+  const bool too_large =
+      dirty_indices_.size() * sizeof(uint32_t) >= counters_.size();
+  const bool interval_due = full_snapshot_interval_ > 0 &&
+                            deltas_since_full_ >= full_snapshot_interval_;
+  if (full_requested_ || too_large || interval_due) {
+    delta.full = true;
+    delta.counters = counters_;
+    full_requested_ = false;
+    deltas_since_full_ = 0;
+  } else {
+    std::sort(dirty_indices_.begin(), dirty_indices_.end());
+    delta.indices = dirty_indices_;
+    delta.counters.reserve(dirty_indices_.size());
+    for (uint32_t index : dirty_indices_) {
+      delta.counters.push_back(counters_[index]);
+    }
+    ++deltas_since_full_;
+  }
+  for (uint32_t index : dirty_indices_) {
+    dirty_[index] = 0;
+  }
+  dirty_indices_.clear();
+  return delta;
+}
+
+bool KVCacheSummary::apply(const Delta& delta) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (delta.full) {
+    CHECK_GT(delta.counters.size(), 0u);
+    CHECK_GT(delta.num_hashes, 0u);
+    counters_ = delta.counters;
+    num_counters_ = static_cast<uint32_t>(counters_.size());
+    num_hashes_ = delta.num_hashes;
+    dirty_.assign(num_counters_, 0);
+    dirty_indices_.clear();
+    sequence_ = delta.sequence;
+    stale_ = false;
+    return true;
+  }
+  if (stale_ || delta.sequence != sequence_ + 1) {
+    stale_ = true;
+    return false;
+  }
+  CHECK_EQ(delta.indices.size(), delta.counters.size());
+  for (size_t i = 0; i < delta.indices.size(); ++i) {
+    CHECK_LT(delta.indices[i], num_counters_);
+    counters_[delta.indices[i]] = delta.counters[i];
+  }
+  sequence_ = delta.sequence;
+  return true;
+}
+
+}  // namespace xllm
@@ -0,0 +1,118 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "common/macros.h"
+#include "util/hash_util.h"
+#include "util/slice.h"
+
+namespace xllm {
+
+// Counting Bloom filter over the chained block hashes held by the prefix
+// caches of an instance. It is reported to the service in heartbeats instead
+// of raw block hash lists, so its size does not grow with the cache: the
+// instance side records add/remove events and ships the changed counters as
+// deltas; a router keeps one mirror per instance, applies the deltas and
+// estimates prefix match lengths locally. Estimates may overshoot by false
+// positives, never undershoot.
+//
+// Thread-safe: prefix caches of several DP ranks update the same summary
+// while the heartbeat thread takes deltas.
+class KVCacheSummary final {
+ public:
+  struct Options {
+    PROPERTY(uint32_t, num_counters) = 1 << 20;
+    PROPERTY(uint32_t, num_hashes) = 3;
+    // take_delta() calls between two full snapshots, so that a mirror that
+    // missed a delta recovers. 0 sends full snapshots only when requested.
+    PROPERTY(uint32_t, full_snapshot_interval) = 120;
+  };
+
+  // Changed counters since the previous delta. A full snapshot carries every
+  // counter in `counters` and no indices; otherwise `indices` is ascending
+  // and counters[i] is the new value of counter indices[i].
+  struct Delta {
+    bool full = false;
+    uint64_t sequence = 0;
+    uint32_t num_hashes = 0;
+    std::vector<uint32_t> indices;
+    std::vector<uint8_t> counters;
+
+    bool empty() const { return !full && indices.empty(); }
+  };
+
+  explicit KVCacheSummary(const Options& options);
+
+  KVCacheSummary(const KVCacheSummary&) = delete;
+  KVCacheSummary& operator=(const KVCacheSummary&) = delete;
+
+  // Summary of this process, sized by --kv_cache_summary_num_counters.
+  static KVCacheSummary& get_instance();
+
+  void add(const std::vector<XXH3Key>& block_hashes);
+  void remove(const std::vector<XXH3Key>& block_hashes);
+
+  bool may_contain(const XXH3Key& block_hash) const;
+
+  // Number of leading blocks of a chained hash sequence that may be cached.
+  size_t estimate_match_blocks(const Slice<XXH3Key>& block_hashes) const;
+
+  // Same, hashing full blocks of token_ids like the text prefix cache.
+  size_t estimate_match_blocks(const Slice<int32_t>& token_ids,
+                               int32_t block_size) const;
+
+  // Instance side: collect the changes since the previous call.
+  Delta take_delta();
+
+  // Make the next take_delta() a full snapshot, e.g. after a lost heartbeat.
+  void request_full_snapshot();
+
+  // Router side: apply a delta taken from the instance summary. Returns false
+  // and ignores it if a delta was missed; estimates then return 0 until the
+  // next full snapshot arrives.
+  bool apply(const Delta& delta);
+
+  uint32_t num_counters() const { return num_counters_; }
+  uint32_t num_hashes() const { return num_hashes_; }
+
+ private:
+  static constexpr uint8_t kMaxCount = UINT8_MAX;
+
+  template <typename Fn>
+  void for_each_index(const XXH3Key& block_hash, Fn&& fn) const;
+
+  bool may_contain_locked(const XXH3Key& block_hash) const;
+  void mark_dirty(uint32_t index);
+
+  const uint32_t full_snapshot_interval_;
+  uint32_t num_counters_;
+  uint32_t num_hashes_;
+
+  mutable std::mutex mutex_;
+  std::vector<uint8_t> counters_;
+  std::vector<uint8_t> dirty_;
+  std::vector<uint32_t> dirty_indices_;
+  uint64_t sequence_ = 0;
+  uint32_t deltas_since_full_ = 0;
+  bool full_requested_ = true;
+  bool stale_ = false;
+};
+
+}  // namespace xllm
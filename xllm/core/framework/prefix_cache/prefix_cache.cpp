@@ -120,6 +120,7 @@ size_t PrefixCache::insert(const Slice<int32_t>& token_ids,
   // truncate the token ids and blocks to boundary
 
   DNodeList node_list;
+  std::vector<XXH3Key> inserted_hashes;
 
   // Fill `token_hash_key` with the chained hash of block `block_idx`, reusing
   // the precomputed hash when it covers all blocks, otherwise computing it.
@@ -169,6 +170,9 @@ size_t PrefixCache::insert(const Slice<int32_t>& token_ids,
       node_list.push_front(new_node);
 
       cached_blocks_.emplace(std::make_pair(token_hash_key, new_node));
+      if (summary_ != nullptr) {
+        inserted_hashes.push_back(token_hash_key);
+      }
 
       num_blocks_++;
     }
@@ -179,6 +183,9 @@ size_t PrefixCache::insert(const Slice<int32_t>& token_ids,
     Node* node = node_list.pop_front();
     lru_lst_.push_back(node);
   }
+  if (summary_ != nullptr) {
+    summary_->add(inserted_hashes);
+  }
 
   return n_tokens;
 }
@@ -191,6 +198,7 @@ size_t PrefixCache::insert(const std::vector<Block>& blocks) {
 size_t PrefixCache::insert(Slice<Block>& blocks) {
   const int64_t now = absl::ToUnixMicros(absl::Now());
   DNodeList node_list;
+  std::vector<XXH3Key> inserted_hashes;
   XXH3Key token_hash_key;
 
   for (size_t i = 0; i < blocks.size(); i++) {
@@ -214,6 +222,9 @@ size_t PrefixCache::insert(Slice<Block>& blocks) {
       node_list.push_front(new_node);
 
       cached_blocks_.emplace(std::make_pair(token_hash_key, new_node));
+      if (summary_ != nullptr) {
+        inserted_hashes.push_back(token_hash_key);
+      }
 
       num_blocks_++;
     }
@@ -223,6 +234,9 @@ size_t PrefixCache::insert(Slice<Block>& blocks) {
     Node* node = node_list.pop_front();
     lru_lst_.push_back(node);
   }
+  if (summary_ != nullptr) {
+    summary_->add(inserted_hashes);
+  }
 
   return blocks.size() * block_size_;
 }
@@ -246,6 +260,7 @@ size_t PrefixCache::evict(size_t n_blocks) {
   }
 
   size_t evict_count = 0;
+  std::vector<XXH3Key> evicted_hashes;
   Node* iter_node = lru_lst_.get_first();
   while (evict_count < n_blocks) {
     if (lru_lst_.is_last(iter_node)) {
@@ -265,11 +280,17 @@ size_t PrefixCache::evict(size_t n_blocks) {
     XXH3Key token_hash_key(del_node->block.get_immutable_hash_value());
 
     cached_blocks_.erase(token_hash_key);
+    if (summary_ != nullptr) {
+      evicted_hashes.push_back(token_hash_key);
+    }
 
     delete del_node;
     ++evict_count;
     --num_blocks_;
   }
+  if (summary_ != nullptr) {
+    summary_->remove(evicted_hashes);
+  }
 
   return evict_count;
 }
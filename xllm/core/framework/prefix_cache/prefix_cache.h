@@ -31,6 +31,7 @@ limitations under the License.
 #include "common/types.h"
 #include "core/framework/multimodal/mm_data.h"
 #include "framework/block/block.h"
+#include "kv_cache_summary.h"
 #include "util/hash_util.h"
 #include "util/slice.h"
 #include "util/threadpool.h"
@@ -67,9 +68,24 @@ class PrefixCache {
 
   virtual ~PrefixCache() {
     exited_.store(true);
+    if (summary_ != nullptr) {
+      std::vector<XXH3Key> block_hashes;
+      block_hashes.reserve(cached_blocks_.size());
+      for (const auto& [block_hash, node] : cached_blocks_) {
+        block_hashes.push_back(block_hash);
+      }
+      summary_->remove(block_hashes);
+    }
     sleep(2);
   };
 
+  // Report inserted and evicted blocks to `summary` (not owned). Set before
+  // the first insert.
+  void set_summary(KVCacheSummary* summary) {
+    CHECK_EQ(num_blocks_, 0) << "set_summary on a non-empty prefix cache";
+    summary_ = summary;
+  }
+
   // Solid-prefix probe: walks the chain per block position, stops on the
   // first miss. Reach in tokens is `returned.size() * block_size_`.
   // When `block_hashes` covers all matchable blocks it is consumed as-is;
@@ -197,6 +213,7 @@ class PrefixCache {
   BlockHasherType hasher_type_;
   size_t num_blocks_ = 0;
   std::atomic_bool exited_{false};
+  KVCacheSummary* summary_ = nullptr;  // not own
 
   std::unordered_map<XXH3Key, Node*, FixedStringKeyHash, FixedStringKeyEqual>
       cached_blocks_;
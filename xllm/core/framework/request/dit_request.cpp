@@ -109,6 +109,11 @@ DiTRequest::DiTRequest(const std::string& request_id,
 
 bool DiTRequest::finished() const { return true; }
 
+bool DiTRequest::is_disconnected() {
+  const std::optional<Call*>& call = state_.call();
+  return call.has_value() && *call != nullptr && (*call)->is_disconnected();
+}
+
 void DiTRequest::log_statistic(double total_latency) {
   LOG(INFO) << "x-request-id: " << x_request_id_ << ", "
             << "x-request-time: " << x_request_time_ << ", "
@@ -43,6 +43,9 @@ class DiTRequest : public RequestBase {
 
   bool finished() const;
 
+  // whether the client of the request has gone away
+  bool is_disconnected();
+
   void handle_forward_output(torch::Tensor output);
 
   void handle_forward_text_output(const std::string& text);
@@ -53,9 +56,19 @@ class DiTRequest : public RequestBase {
 
   DiTRequestState& state() { return state_; }
 
+  // denoising steps run so far under step-level batching
+  int32_t denoise_step() const { return denoise_step_; }
+
+  void advance_denoise_step() { ++denoise_step_; }
+
+  bool denoise_finished() const {
+    return denoise_step_ >= state_.generation_params().num_inference_steps;
+  }
+
  private:
   DiTRequestState state_;
   DiTForwardOutput output_;
+  int32_t denoise_step_ = 0;
 };
 
 }  // namespace xllm
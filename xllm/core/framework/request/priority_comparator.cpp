@@ -222,6 +222,20 @@ bool DecodeUrgencyDensityComparator::operator()(
   }
 }
 
+// per-tenant fair queuing: the smallest virtual start time goes first. ties
+// fall back to created time and then the address, so that a set never takes
+// two requests as equal.
+bool FairShareComparator::operator()(const std::shared_ptr<Request>& a,
+                                     const std::shared_ptr<Request>& b) const {
+  if (a->fair_share_tag() != b->fair_share_tag()) {
+    return a->fair_share_tag() > b->fair_share_tag();
+  }
+  if (a->created_time() != b->created_time()) {
+    return a->created_time() > b->created_time();
+  }
+  return std::less<const Request*>()(b.get(), a.get());
+}
+
 // is_reversed = false for priority_queue comparator (default)
 // is_reversed = true for sorting / ordered-container comparators (e.g. set)
 std::function<bool(const std::shared_ptr<Request>&,
@@ -285,6 +299,12 @@ create_comparator(const std::string& priority_strategy, bool is_reversed) {
       return is_reversed ? DecodeDeadlineComparator()(b, a)
                          : DecodeDeadlineComparator()(a, b);
     };
+  } else if (priority_strategy == "fair") {
+    return [is_reversed](const std::shared_ptr<Request>& a,
+                         const std::shared_ptr<Request>& b) {
+      return is_reversed ? FairShareComparator()(b, a)
+                         : FairShareComparator()(a, b);
+    };
   } else {
     LOG(FATAL) << "Unknown strategy: " << priority_strategy;
     return nullptr;
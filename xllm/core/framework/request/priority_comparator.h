@@ -89,6 +89,11 @@ struct DecodeUrgencyDensityComparator : public PriorityComparator {
                   const std::shared_ptr<Request>& b) const override;
 };
 
+struct FairShareComparator : public PriorityComparator {
+  bool operator()(const std::shared_ptr<Request>& a,
+                  const std::shared_ptr<Request>& b) const override;
+};
+
 std::function<bool(const std::shared_ptr<Request>&,
                    const std::shared_ptr<Request>&)>
 create_comparator(const std::string& priority_strategy, bool reverse = false);
@@ -28,6 +28,7 @@ limitations under the License.
 
 #include "api_service/call.h"
 #include "sequence.h"
+#include "util/flight_recorder.h"
 #include "util/timer.h"
 
 namespace xllm {
@@ -55,6 +56,7 @@ void Request::create_sequences_group() {
   sequence_params.skip_special_tokens = state_.skip_special_tokens;
   sequence_params.include_stop_str_in_output =
       state_.include_stop_str_in_output;
+  sequence_params.skip_detokenize = state_.skip_detokenize;
   sequence_params.echo = state_.echo;
   sequence_params.logprobs = state_.logprobs;
   sequence_params.n = state_.n;
@@ -160,6 +162,14 @@ void Request::set_cancel() {
   }
 }
 
+void Request::set_preempted() {
+  state_.preempted = true;
+  FlightRecorder::get_instance().record_request_event(
+      "request.preempt",
+      request_id(),
+      {{"num_tokens", static_cast<int64_t>(sequences()[0]->num_tokens())}});
+}
+
 void Request::handle_last_token() {
   state_.handle_last_token_done = true;
   for (const auto& seq : sequences()) {
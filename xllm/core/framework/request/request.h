@@ -69,7 +69,7 @@ class Request : public RequestBase {
 
   size_t total_num_blocks();
 
-  void set_preempted() { state_.preempted = true; }
+  void set_preempted();
 
   bool preempted() const { return state_.preempted; }
 
@@ -119,6 +119,7 @@ class Request : public RequestBase {
   const RequestPriority priority() const {
     return state_.scheduler_param.priority;
   }
+  const std::string& tenant() const { return state_.scheduler_param.tenant; }
   // time to last token (end-to-end latency)
   const int32_t ttlt_slo_ms() const {
     return state_.scheduler_param.ttlt_slo_ms;
@@ -148,6 +149,11 @@ class Request : public RequestBase {
   void set_starved(bool starved) { starved_ = starved; }
   bool is_starved() const { return starved_; }
 
+  // virtual start time of the request under the "fair" strategy, assigned
+  // once when the scheduler admits it.
+  void set_fair_share_tag(double tag) { fair_share_tag_ = tag; }
+  double fair_share_tag() const { return fair_share_tag_; }
+
   RequestState& state() { return state_; }
   size_t best_of() const { return state_.best_of; }
   void update_connection_status();
@@ -185,6 +191,8 @@ class Request : public RequestBase {
 
   bool starved_ = false;
 
+  double fair_share_tag_ = 0.0;
+
   size_t num_prefix_cache_tokens_ = 0;
 
   void create_sequences_group();
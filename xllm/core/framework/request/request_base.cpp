@@ -16,6 +16,7 @@ limitations under the License.
 #include "request_base.h"
 
 #include "common/rate_limiter.h"
+#include "common/tenant_limiter.h"
 
 namespace xllm {
 
@@ -43,6 +44,9 @@ RequestBase::~RequestBase() {
   if (rate_limiter_ != nullptr) {
     rate_limiter_->decrease_one_request();
   }
+  if (tenant_limiter_ != nullptr) {
+    tenant_limiter_->release(tenant_);
+  }
 }
 
 }  // namespace xllm
@@ -32,6 +32,7 @@ limitations under the License.
 namespace xllm {
 
 class RateLimiter;
+class TenantLimiter;
 
 class RequestBase {
  public:
@@ -68,6 +69,14 @@ class RequestBase {
 
   const std::string& x_request_time() const { return x_request_time_; }
 
+  // Takes over the slot of `tenant` that TenantLimiter::is_limited() took
+  // for this request; the destructor releases it.
+  void set_tenant_limiter(TenantLimiter* tenant_limiter,
+                          const std::string& tenant) {
+    tenant_limiter_ = tenant_limiter;
+    tenant_ = tenant;
+  }
+
  protected:
   // request create time
   absl::Time created_time_;
@@ -90,6 +99,10 @@ class RequestBase {
   // ScopeGuard on the failure path, or the Request itself on success). The
   // destructor decrements exactly once when non-null.
   RateLimiter* rate_limiter_ = nullptr;
+
+  // Non-owning, same ownership rules as rate_limiter_.
+  TenantLimiter* tenant_limiter_ = nullptr;
+  std::string tenant_;
 };
 
 }  // namespace xllm
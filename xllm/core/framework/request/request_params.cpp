@@ -174,6 +174,7 @@ RequestParams::RequestParams(const proto::CompletionRequest& request,
   if (request.has_source_xservice_addr()) {
     source_xservice_addr = request.source_xservice_addr();
   }
+  tenant = request.user();
   if (request.has_max_tokens()) {
     max_tokens = request.max_tokens();
   }
@@ -376,6 +377,7 @@ void init_from_chat_request(RequestParams& params, const ChatRequest& request) {
   if (request.has_source_xservice_addr()) {
     params.source_xservice_addr = request.source_xservice_addr();
   }
+  params.tenant = request.user();
   if (request.has_max_tokens()) {
     params.max_tokens = request.max_tokens();
   }
@@ -510,6 +512,9 @@ RequestParams::RequestParams(const proto::EmbeddingRequest& request,
   } else {
     add_special_tokens = true;
   }
+  if (request.has_use_cache()) {
+    use_embedding_cache = request.use_cache();
+  }
   x_request_id = x_rid;
   x_request_time = x_rtime;
   is_embeddings = true;
@@ -536,12 +541,16 @@ RequestParams::RequestParams(const proto::RerankRequest& request,
   if (request.has_service_request_id()) {
     service_request_id = request.service_request_id();
   }
+  if (request.has_use_cache()) {
+    use_embedding_cache = request.use_cache();
+  }
   x_request_id = x_rid;
   x_request_time = x_rtime;
   max_tokens = 1;
   streaming = false;
   if (::xllm::ModelConfig::get_instance().enable_qwen3_reranker()) {
     logprobs = true;
+    is_logprob_rerank = true;
   } else {
     is_embeddings = true;
   }
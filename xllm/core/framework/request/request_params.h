@@ -82,6 +82,10 @@ struct RequestParams {
   std::string x_request_id;
   std::string x_request_time;
 
+  // the end user of the request (the OpenAI `user` field), used as the tenant
+  // key of per-tenant admission and fair queuing. empty means no tenant.
+  std::string tenant;
+
   bool streaming = false;
 
   // number of tokens to generate. truncated to model's max context length.
@@ -135,12 +139,24 @@ struct RequestParams {
   // default = false.
   bool include_stop_str_in_output = false;
 
+  // whether to return token ids only and skip detokenizing the output.
+  // default = false.
+  bool skip_detokenize = false;
+
   // whether to ignore the end of sequence token. default = false.
   bool ignore_eos = false;
 
   // whether to get the embeddings of the tokens. used by embeddings model.
   bool is_embeddings = false;
 
+  // whether this is a rerank request scored by the logprob of its single
+  // generated token (Qwen3 reranker). default = false.
+  bool is_logprob_rerank = false;
+
+  // whether an embeddings or rerank request may be answered from, and
+  // stored in, the embedding result cache. default = true.
+  bool use_embedding_cache = true;
+
   // the list of strings to stop generating further tokens.
   std::optional<std::vector<std::string>> stop;
 
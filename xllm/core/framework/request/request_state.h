@@ -53,6 +53,8 @@ struct SchedulerParam {
   int32_t ttlt_priority_weight = 1;
   int32_t priority_weight = 1;
   RequestPriority priority = RequestPriority::NORMAL;
+  // tenant key of fair queuing, empty if the request has none.
+  std::string tenant;
 };
 
 struct RequestState final {
@@ -143,6 +145,8 @@ struct RequestState final {
 
   bool include_stop_str_in_output = false;
 
+  bool skip_detokenize = false;
+
   OutputFunc output_func;
 
   // function to call when batch outputs is generated in disagg pd mode,
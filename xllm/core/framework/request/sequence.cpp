@@ -145,7 +145,9 @@ void Sequence::init_onerec_sequence(
     num_prompt_tokens_ = kDecoderBosTokenCount;
   }
 
+  token_capacity_ = capacity;
   tokens_.resize(capacity);
+  token_ids_.store(&tokens_, std::memory_order_release);
   for (size_t i = 0; i < num_prompt_tokens_; ++i) {
     tokens_[num_tokens_++] = sequence_params_.bos_token_id;
     token_to_count_map_[sequence_params_.bos_token_id]++;
@@ -153,7 +155,7 @@ void Sequence::init_onerec_sequence(
   volatile_num_prompt_tokens_ = num_prompt_tokens_;
   input_embedding_ = std::move(input_embedding);
   cur_generated_token_idx_ = num_prompt_tokens_;
-  logprob_state_ = std::make_unique<LogprobState>(num_prompt_tokens_, capacity);
+  logprob_state_ = make_logprob_state();
 }
 
 void Sequence::generate_onerec_streaming_output(const Slice<int32_t>& ids,
@@ -177,14 +179,9 @@ void Sequence::generate_onerec_output(const Slice<int32_t>& ids,
   output.token_ids = ids.slice(num_prompt_tokens_, size);
   if (::xllm::RecConfig::get_instance().enable_output_sku_logprobs() &&
       logprob_state_ != nullptr) {
-    const auto& token_logprobs = logprob_state_->get_logprobs();
     output.token_ids_logprobs.reserve(output.token_ids.size());
     for (size_t i = num_prompt_tokens_; i < size; ++i) {
-      if (i < token_logprobs.size()) {
-        output.token_ids_logprobs.emplace_back(token_logprobs[i]);
-      } else {
-        output.token_ids_logprobs.emplace_back();
-      }
+      output.token_ids_logprobs.emplace_back(logprob_state_->get_logprob(i));
     }
   }
   const size_t rec_token_size = static_cast<size_t>(REC_TOKEN_SIZE);
@@ -192,12 +189,14 @@ void Sequence::generate_onerec_output(const Slice<int32_t>& ids,
       output.token_ids.size() == rec_token_size) {
     const Slice<int32_t> token_slice{output.token_ids.data(),
                                      output.token_ids.size()};
+    // items are looked up in the catalog version the request's masks were
+    // built from.
+    const auto* rec_tokenizer = dynamic_cast<const RecTokenizer*>(&tokenizer);
     if (::xllm::RecConfig::get_instance().enable_extended_item_info()) {
-      const auto* rec_tokenizer = dynamic_cast<const RecTokenizer*>(&tokenizer);
       if (rec_tokenizer != nullptr) {
         std::vector<RecItemInfo> item_infos;
-        const bool ok =
-            rec_tokenizer->decode_item_infos(token_slice, &item_infos);
+        const bool ok = rec_tokenizer->decode_item_infos(
+            token_slice, sequence_params_.request_id, &item_infos);
         if (ok && !item_infos.empty()) {
           output.item_infos_list = normalize_rec_item_infos(item_infos, index_);
           output.item_ids_list.reserve(output.item_infos_list.size());
@@ -212,8 +211,14 @@ void Sequence::generate_onerec_output(const Slice<int32_t>& ids,
       }
     } else {
       std::vector<int64_t> item_ids;
-      const bool ok = tokenizer.decode(
-          token_slice, sequence_params_.skip_special_tokens, &item_ids);
+      bool ok = false;
+      if (rec_tokenizer != nullptr) {
+        ok = rec_tokenizer->decode(
+            token_slice, sequence_params_.request_id, &item_ids);
+      } else {
+        ok = tokenizer.decode(
+            token_slice, sequence_params_.skip_special_tokens, &item_ids);
+      }
       if (ok && !item_ids.empty()) {
         output.item_ids_list = normalize_rec_item_ids(item_ids, index_);
         if (!output.item_ids_list.empty()) {
@@ -230,6 +235,19 @@ Sequence::Sequence(size_t index,
                    const MMData& mm_data,
                    const IncrementalDecoder& decoder,
                    const SequenceParams& seq_params)
+    : Sequence(index,
+               std::make_shared<const std::vector<int32_t>>(prompt_token_ids),
+               std::move(input_embedding),
+               mm_data,
+               decoder,
+               seq_params) {}
+
+Sequence::Sequence(size_t index,
+                   std::shared_ptr<const std::vector<int32_t>> prompt_token_ids,
+                   torch::Tensor input_embedding,
+                   const MMData& mm_data,
+                   const IncrementalDecoder& decoder,
+                   const SequenceParams& seq_params)
     : index_(index),
       mm_data_(mm_data),
       latest_generate_time_(absl::Now()),
@@ -246,21 +264,21 @@ Sequence::Sequence(size_t index,
     json_object_state_ = sequence_params_.json_object_grammar->initial_state(
         sequence_params_.json_reasoning_enabled);
   }
+  CHECK(prompt_token_ids != nullptr);
   if (is_onerec_model()) {
-    init_onerec_sequence(prompt_token_ids, std::move(input_embedding));
+    init_onerec_sequence(*prompt_token_ids, std::move(input_embedding));
     return;
   }
 
-  CHECK(!prompt_token_ids.empty()) << "empty prompt token ids";
-  auto capacity = sequence_params_.seq_capacity;
-  CHECK_GT(capacity, prompt_token_ids.size()) << "capacity too small";
+  CHECK(!prompt_token_ids->empty()) << "empty prompt token ids";
+  token_capacity_ = sequence_params_.seq_capacity;
+  CHECK_GT(token_capacity_, prompt_token_ids->size()) << "capacity too small";
 
-  num_prompt_tokens_ = prompt_token_ids.size();
+  num_prompt_tokens_ = prompt_token_ids->size();
   volatile_num_prompt_tokens_ = num_prompt_tokens_;
-  tokens_.resize(capacity);
 
   // init logprob state
-  logprob_state_ = std::make_unique<LogprobState>(num_prompt_tokens_, capacity);
+  logprob_state_ = make_logprob_state();
 
   if (sequence_params_.sampling_param->frequency_penalty != 0 ||
       sequence_params_.sampling_param->presence_penalty != 0 ||
@@ -269,14 +287,16 @@ Sequence::Sequence(size_t index,
   }
 
   // add the prompt tokens
-  for (const auto token_id : prompt_token_ids) {
-    tokens_[num_tokens_++] = token_id;
-    if (need_unique_tokens_) {
+  if (need_unique_tokens_) {
+    for (const auto token_id : *prompt_token_ids) {
       token_to_count_map_[token_id] = 0;
     }
   }
   // need one token to padding even dont need token count
-  token_to_count_map_[prompt_token_ids.back()] = 0;
+  token_to_count_map_[prompt_token_ids->back()] = 0;
+  num_tokens_ = num_prompt_tokens_;
+  shared_tokens_ = std::move(prompt_token_ids);
+  token_ids_.store(shared_tokens_.get(), std::memory_order_release);
   input_embedding_ = input_embedding;
   cur_generated_token_idx_ = num_prompt_tokens_;
 }
@@ -297,7 +317,9 @@ Sequence::Sequence(const Sequence& other, size_t index)
       sequence_params_(other.sequence_params_),
       decoder_(other.decoder_),
       stream_output_token_offset_(other.stream_output_token_offset_),
+      shared_tokens_(other.shared_tokens_),
       tokens_(other.tokens_),
+      token_capacity_(other.token_capacity_),
       input_embedding_(other.input_embedding_),
       mm_data_(other.mm_data_),
       mrope_position_delta_(other.mrope_position_delta_),
@@ -325,6 +347,8 @@ Sequence::Sequence(const Sequence& other, size_t index)
       is_pre_scheduled_step_prefill_(other.is_pre_scheduled_step_prefill_),
       updated_since_last_beam_search_(other.updated_since_last_beam_search_),
       termination_flag_(std::make_shared<std::atomic<int32_t>>(INT32_MAX)) {
+  token_ids_.store(other.owns_tokens() ? &tokens_ : shared_tokens_.get(),
+                   std::memory_order_release);
   logprob_state_ = std::make_unique<LogprobState>(*other.logprob_state_);
   // A forked sequence (beam / best_of) shares the prompt KV prefix by
   // ref-counting those blocks, but its linear-state / embedding resource block
@@ -422,7 +446,7 @@ bool Sequence::restore_json_object_state(
 }
 
 void Sequence::append_token(const Token& token) {
-  CHECK_LT(num_tokens_, tokens_.size())
+  CHECK_LT(num_tokens_, token_capacity_)
       << "exceed the token capacity of the sequence";
   CHECK(!finished_ && !error_status().has_value())
       << "cannot append token to a finished sequence";
@@ -448,7 +472,7 @@ void Sequence::append_token(const Token& token) {
   // append the token id and update the token count
   const auto cur_idx = num_tokens_++;
   kv_state_.set_kv_cache_tokens_num(cur_idx);
-  tokens_[cur_idx] = token_id;
+  mutable_tokens()[cur_idx] = token_id;
 
   // skip update in enable_schedule_overlap
   if (sequence_params_.enable_schedule_overlap && token_id < 0) {
@@ -502,16 +526,16 @@ void Sequence::update_last_step_token(const Token& token, size_t token_offset) {
     kv_state_.incr_kv_cache_tokens_num(1);
     num_tokens_++;
     // when enable speculative decoding, fake token id will be covered.
-    tokens_[cur_generated_token_idx_ + 2] =
-        tokens_[cur_generated_token_idx_ + 1];
-    tokens_[cur_generated_token_idx_ + 1] = tokens_[cur_generated_token_idx_];
+    std::vector<int32_t>& tokens = mutable_tokens();
+    tokens[cur_generated_token_idx_ + 2] = tokens[cur_generated_token_idx_ + 1];
+    tokens[cur_generated_token_idx_ + 1] = tokens[cur_generated_token_idx_];
   }
 
   // A real token is committed here (one per call, including the extra accepted
   // MTP token when token_offset > 0); preempted MTP steps returned above.
   ++generated_tokens_since_latency_;
 
-  tokens_[cur_generated_token_idx_] = token_id;
+  mutable_tokens()[cur_generated_token_idx_] = token_id;
   // Overlap/MTP may rewrite tokens at decode positions; drop any cached block
   // hash from this position onward so it is recomputed when next needed.
   invalidate_block_hashes_from(cur_generated_token_idx_);
@@ -535,9 +559,10 @@ void Sequence::update_token(size_t index, const Token& token) {
   // TODO: not record in non-disagg pd mode.
   record_first_token(token);
 
-  const int32_t origin_token_id = tokens_[index];
+  std::vector<int32_t>& tokens = mutable_tokens();
+  const int32_t origin_token_id = tokens[index];
   const int32_t token_id = static_cast<int32_t>(token.id);
-  tokens_[index] = token_id;
+  tokens[index] = token_id;
   // A rewritten token invalidates the cached hash of its block and all
   // subsequent blocks; recompute lazily on the next update_block_hashes().
   invalidate_block_hashes_from(index);
@@ -601,14 +626,14 @@ std::optional<SequenceOutput> Sequence::generate_streaming_output(
   // figure out the valid generated token
   // because there might be fake token -1 if enable_schedule_overlap
   for (auto i = num_tokens_ - 1; i >= 0; --i) {
-    if (tokens_[i] >= 0) {
+    if (token_ids()[i] >= 0) {
       size = i + 1;
       break;
     }
   }
   CHECK_LE(size, num_tokens_);
   AUTO_COUNTER(detokenization_latency_seconds_stream);
-  const auto ids = Slice<int32_t>(tokens_, size);
+  const auto ids = Slice<int32_t>(token_ids(), size);
 
   SequenceOutput output;
   if (is_onerec_model()) {
@@ -616,14 +641,16 @@ std::optional<SequenceOutput> Sequence::generate_streaming_output(
     return output;
   }
 
-  // Hold back a potential multi-token stop suffix. The max with the decoder
-  // offset also keeps delayed streaming callbacks from moving it backwards.
-  const size_t decodable_token_count =
-      std::max(get_decodable_token_count(size), decoder_.output_offset());
-  const auto decodable_ids = ids.slice(0, decodable_token_count);
-
   const size_t token_start = stream_output_token_offset_;
-  auto delta = decoder_.decode(decodable_ids, tokenizer);
+  std::string delta;
+  if (!sequence_params_.skip_detokenize) {
+    // Hold back a potential multi-token stop suffix. The max with the decoder
+    // offset also keeps delayed streaming callbacks from moving it backwards.
+    const size_t decodable_token_count =
+        std::max(get_decodable_token_count(size), decoder_.output_offset());
+    const auto decodable_ids = ids.slice(0, decodable_token_count);
+    delta = decoder_.decode(decodable_ids, tokenizer);
+  }
   // NOTE:
   // There is a incomprehensible logic here: we use a thread pool to handle
   // request callbacks in response handler, which means that the main thread and
@@ -694,13 +721,13 @@ void Sequence::generate_sample_outputs(std::vector<SequenceOutput>& outputs,
     output.index = slots[slot_idx].sample_id;
 
     const size_t token_idx = num_prompt_tokens_ + slot_idx;
-    if (token_idx >= num_tokens_ || tokens_[token_idx] < 0) {
+    if (token_idx >= num_tokens_ || token_ids()[token_idx] < 0) {
       output.finish_reason = kEmptyLogprobsFinishReason;
       outputs.push_back(std::move(output));
       continue;
     }
 
-    output.token_ids.push_back(tokens_[token_idx]);
+    output.token_ids.push_back(token_ids()[token_idx]);
     generate_output_tokens_logprobs(
         token_idx, token_idx + 1, tokenizer, output.logprobs);
     if (!output.logprobs.has_value() || output.logprobs->empty()) {
@@ -776,7 +803,7 @@ SequenceOutput Sequence::generate_output(const Tokenizer& tokenizer) {
   const auto ids = tokens();
   size_t size;
   for (auto i = num_tokens_ - 1; i >= 0; --i) {
-    if (tokens_[i] >= 0) {
+    if (token_ids()[i] >= 0) {
       size = i + 1;
       break;
     }
@@ -812,13 +839,14 @@ SequenceOutput Sequence::generate_output(const Tokenizer& tokenizer) {
   }
   // incrementally decode tokens between [incremental_start,
   // decodable_token_count)
-  std::stringstream ss;
-  for (size_t end = incremental_start; end <= decodable_token_count; ++end) {
-    ss << decoder_.decode(ids.slice(0, end), tokenizer);
+  if (!sequence_params_.skip_detokenize) {
+    std::stringstream ss;
+    for (size_t end = incremental_start; end <= decodable_token_count; ++end) {
+      ss << decoder_.decode(ids.slice(0, end), tokenizer);
+    }
+    output.text = ss.str();
   }
 
-  output.text = ss.str();
-
   const size_t end = size;
   output.token_ids = ids.slice(start, end);
   generate_output_tokens_logprobs(start, end, tokenizer, output.logprobs);
@@ -1051,16 +1079,37 @@ void Sequence::generate_output_tokens_logprobs(
       tokenizer,
       out_logprobs,
       sequence_params_.skip_special_tokens,
-      tokens_);
+      token_ids());
 }
 
 Slice<int32_t> Sequence::get_generated_tokens() const {
   // Return a slice of generated token IDs (excluding prompt tokens)
   if (num_tokens_ > num_prompt_tokens_) {
-    return {tokens_.data() + num_prompt_tokens_,
+    return {token_ids().data() + num_prompt_tokens_,
             num_tokens_ - num_prompt_tokens_};
   }
-  return {tokens_.data(), 0};
+  return {token_ids().data(), 0};
+}
+
+std::vector<int32_t>& Sequence::mutable_tokens() {
+  if (!owns_tokens()) {
+    // copy on write into a buffer of the full capacity, so that it never
+    // moves while streaming responses read it. The shared prompt stays
+    // alive with the sequence for the readers that still hold it.
+    tokens_.resize(token_capacity_);
+    std::copy(shared_tokens_->begin(), shared_tokens_->end(), tokens_.begin());
+    token_ids_.store(&tokens_, std::memory_order_release);
+  }
+  return tokens_;
+}
+
+std::unique_ptr<LogprobState> Sequence::make_logprob_state() const {
+  const RequestSamplingParam* sampling_param = sequence_params_.sampling_param;
+  return std::make_unique<LogprobState>(
+      num_prompt_tokens_,
+      token_capacity_,
+      sampling_param != nullptr && sampling_param->logprobs,
+      sampling_param != nullptr && sampling_param->top_logprobs > 0);
 }
 
 bool Sequence::update_prefetch_result(uint32_t timeout, uint32_t& success_cnt) {
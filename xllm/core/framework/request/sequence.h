@@ -21,6 +21,7 @@ limitations under the License.
 #include <folly/futures/Future.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -79,6 +80,9 @@ struct SequenceParams {
   // default = false.
   bool include_stop_str_in_output = false;
 
+  // whether to return token ids only, without output text. default = false.
+  bool skip_detokenize = false;
+
   // whether to echo the prompt in the output text. default = false.
   bool echo = false;
 
@@ -131,6 +135,19 @@ class Sequence final {
            const IncrementalDecoder& incremental_decoder,
            const SequenceParams& seq_params);
 
+  // Reads the prompt from `prompt_token_ids`, which the sequences of one
+  // request share, and copies it on the first token written to the sequence.
+  // The sharing only lasts while the sequence is queued or prefilling: from
+  // its first decode step on, each sequence holds the prompt plus its own
+  // generated tokens in one contiguous buffer, as tokens() requires.
+  // The buffer must not change while the sequence is alive.
+  Sequence(size_t index,
+           std::shared_ptr<const std::vector<int32_t>> prompt_token_ids,
+           torch::Tensor input_embedding,
+           const MMData& mm_data,
+           const IncrementalDecoder& incremental_decoder,
+           const SequenceParams& seq_params);
+
   Sequence(const Sequence& other);
   Sequence(const Sequence& other, size_t index);
 
@@ -175,15 +192,15 @@ class Sequence final {
   size_t num_generated_tokens() const {
     return num_tokens_ - num_prompt_tokens_;
   }
-  Slice<int32_t> tokens() const { return {tokens_, num_tokens_}; }
+  Slice<int32_t> tokens() const { return {token_ids(), num_tokens_}; }
   // get tokens in kv cache
   Slice<int32_t> cached_tokens() const {
-    return {tokens_, kv_state_.kv_cache_tokens_num()};
+    return {token_ids(), kv_state_.kv_cache_tokens_num()};
   }
 
   // get token ids in host kv cache
   Slice<int32_t> cached_host_tokens() const {
-    return {tokens_, host_kv_state_.kv_cache_tokens_num()};
+    return {token_ids(), host_kv_state_.kv_cache_tokens_num()};
   }
 
   // get the number of tokens need compute
@@ -551,6 +568,21 @@ class Sequence final {
   void init_onerec_sequence(const std::vector<int32_t>& prompt_token_ids,
                             torch::Tensor input_embedding);
 
+  // token ids read by the model inputs and the streaming responses.
+  const std::vector<int32_t>& token_ids() const {
+    return *token_ids_.load(std::memory_order_acquire);
+  }
+
+  bool owns_tokens() const {
+    return token_ids_.load(std::memory_order_acquire) == &tokens_;
+  }
+
+  // Returns the owned token buffer, copying the shared prompt into it first
+  // if the sequence still reads it.
+  std::vector<int32_t>& mutable_tokens();
+
+  std::unique_ptr<LogprobState> make_logprob_state() const;
+
   void generate_onerec_streaming_output(const Slice<int32_t>& ids,
                                         size_t size,
                                         SequenceOutput& output) const;
@@ -605,9 +637,23 @@ class Sequence final {
   // remain present in token_ids and logprobs.
   size_t stream_output_token_offset_ = 0;
 
-  // token ids generated for the sequence
+  // prompt token ids shared with the other sequences of the request. They
+  // are read until the first write to the sequence copies them into
+  // `tokens_`, and kept alive afterwards for in-flight streaming responses.
+  std::shared_ptr<const std::vector<int32_t>> shared_tokens_;
+
+  // token ids of the sequence, sized to `token_capacity_` on the first write
+  // and never reallocated, since streaming responses read them concurrently.
+  // Decoding sequences therefore use prompt + max tokens each, not just the
+  // generated suffix.
   std::vector<int32_t> tokens_;
 
+  // either `shared_tokens_` or `tokens_`.
+  std::atomic<const std::vector<int32_t>*> token_ids_{nullptr};
+
+  // max tokens count in the sequence.
+  size_t token_capacity_ = 0;
+
   torch::Tensor input_embedding_;
 
   MMData mm_data_;
@@ -20,12 +20,46 @@ limitations under the License.
 
 namespace xllm {
 
-LogprobState::LogprobState(int64_t num_prompt_tokens, size_t capacity)
+namespace {
+
+template <typename T>
+const T& get_or_empty(const std::vector<T>& values, int64_t offset) {
+  static const T kEmpty;
+  if (offset < 0 || offset >= static_cast<int64_t>(values.size())) {
+    return kEmpty;
+  }
+  return values[offset];
+}
+
+}  // namespace
+
+LogprobState::LogprobState(int64_t num_prompt_tokens,
+                           size_t capacity,
+                           bool logprobs,
+                           bool top_logprobs)
     : num_prompt_tokens_(num_prompt_tokens), acc_logprob_(0.0) {
   last_acc_token_idx_ = num_prompt_tokens_;
-  logprobs_.resize(capacity);
-  top_tokens_.resize(capacity);
-  top_logprobs_.resize(capacity);
+  const size_t num_generated_slots =
+      capacity > static_cast<size_t>(num_prompt_tokens_)
+          ? capacity - num_prompt_tokens_
+          : 0;
+  if (logprobs) {
+    logprobs_.resize(num_generated_slots);
+  }
+  if (top_logprobs) {
+    top_tokens_.resize(num_generated_slots);
+    top_logprobs_.resize(num_generated_slots);
+  }
+}
+
+const std::vector<float>& LogprobState::get_top_logprobs(size_t index) const {
+  return get_or_empty(top_logprobs_,
+                      static_cast<int64_t>(index) - num_prompt_tokens_);
+}
+
+const std::vector<int64_t>& LogprobState::get_top_tokens(size_t index) const {
+  return get_or_empty(top_tokens_,
+                      static_cast<int64_t>(index) - num_prompt_tokens_);
 }
 
 float LogprobState::get_acc_logprob(int64_t num_tokens) {
@@ -43,9 +77,9 @@ float LogprobState::get_acc_logprob(int64_t num_tokens) {
          "num_prompt_tokens_, "
       << last_acc_token_idx_ << " vs " << num_prompt_tokens_;
 
-  for (size_t i = last_acc_token_idx_; i < num_tokens; ++i) {
-    if (logprobs_[i].has_value()) {
-      acc_logprob_ += logprobs_[i].value();
+  for (int64_t i = last_acc_token_idx_; i < num_tokens; ++i) {
+    if (const std::optional<float> logprob = get_logprob(i)) {
+      acc_logprob_ += logprob.value();
     }
   }
   last_acc_token_idx_ = num_tokens;
@@ -63,11 +97,9 @@ float LogprobState::get_base_logprob(int64_t num_tokens) {
   // Fast path: if accumulation already reaches current sequence length,
   // subtract only the last token logprob to get the base beam score.
   if (last_acc_token_idx_ == num_tokens) {
-    const int64_t last_token_idx = num_tokens - 1;
-    if (last_token_idx >= 0 &&
-        last_token_idx < static_cast<int64_t>(logprobs_.size()) &&
-        logprobs_[last_token_idx].has_value()) {
-      return acc_logprob_ - logprobs_[last_token_idx].value();
+    const std::optional<float> last_logprob = get_logprob(num_tokens - 1);
+    if (last_logprob.has_value()) {
+      return acc_logprob_ - last_logprob.value();
     }
     return acc_logprob_;
   }
@@ -83,8 +115,8 @@ float LogprobState::get_base_logprob(int64_t num_tokens) {
       << last_acc_token_idx_ << " vs " << history_num_tokens;
 
   for (int64_t i = last_acc_token_idx_; i < history_num_tokens; ++i) {
-    if (logprobs_[i].has_value()) {
-      acc_logprob_ += logprobs_[i].value();
+    if (const std::optional<float> logprob = get_logprob(i)) {
+      acc_logprob_ += logprob.value();
     }
   }
   last_acc_token_idx_ = history_num_tokens;
@@ -103,7 +135,8 @@ void LogprobState::generate_output_tokens_logprobs(
   }
 
   for (size_t i = start_idx; i < end_idx; ++i) {
-    if (!logprobs_[i].has_value()) {
+    const std::optional<float> logprob = get_logprob(i);
+    if (!logprob.has_value()) {
       continue;
     }
 
@@ -127,16 +160,16 @@ void LogprobState::generate_output_tokens_logprobs(
     // add token and logprob
     tmp_logprob.token = std::move(token);
     tmp_logprob.token_id = token_id;
-    tmp_logprob.logprob = logprobs_[i].value();
+    tmp_logprob.logprob = logprob.value();
 
     // add top logprobs
-    if (top_tokens_[i].empty()) {
+    const auto& top_tokens = get_top_tokens(i);
+    if (top_tokens.empty()) {
       out_logprobs->emplace_back(std::move(tmp_logprob));
       continue;
     }
 
-    const auto& top_tokens = top_tokens_[i];
-    const auto& top_logprobs = top_logprobs_[i];
+    const auto& top_logprobs = get_top_logprobs(i);
     DCHECK_EQ(top_tokens.size(), top_logprobs.size());
     std::vector<LogProbData> logprobs;
     for (size_t j = 0; j < top_tokens.size(); ++j) {
@@ -165,19 +198,28 @@ void LogprobState::generate_output_tokens_logprobs(
 void LogprobState::update_logprob(size_t index,
                                   const Token& token,
                                   int64_t num_top_tokens) {
-  // CHECK(!logprobs_[index].has_value())
-  //     << "logprob at index " << index << " is already set";
-  logprobs_[index] = token.logprob;
+  // prompt positions carry no logprob.
+  if (static_cast<int64_t>(index) < num_prompt_tokens_) {
+    return;
+  }
+  const size_t offset = index - num_prompt_tokens_;
+  CHECK_LT(offset, logprobs_.size())
+      << "logprob at index " << index << " is out of the sequence capacity";
+  logprobs_[offset] = token.logprob;
 
   if (num_top_tokens > 0 && token.top_tokens.size() > 0) {
     DCHECK_EQ(token.top_tokens.size(), token.top_logprobs.size());
+    CHECK_LT(offset, top_tokens_.size())
+        << "top logprobs at index " << index << " were not requested";
+    std::vector<int64_t>& top_tokens = top_tokens_[offset];
+    std::vector<float>& top_logprobs = top_logprobs_[offset];
     if (token.top_tokens.size() > num_top_tokens) {
-      top_tokens_[index] = token.top_tokens.slice(0, num_top_tokens);
-      top_logprobs_[index] = token.top_logprobs.slice(0, num_top_tokens);
+      top_tokens = token.top_tokens.slice(0, num_top_tokens);
+      top_logprobs = token.top_logprobs.slice(0, num_top_tokens);
     } else {
       DCHECK_EQ(token.top_tokens.size(), num_top_tokens);
-      top_tokens_[index] = token.top_tokens;
-      top_logprobs_[index] = token.top_logprobs;
+      top_tokens = token.top_tokens;
+      top_logprobs = token.top_logprobs;
     }
   }
 }
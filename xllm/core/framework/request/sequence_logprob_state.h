@@ -27,9 +27,17 @@ limitations under the License.
 
 namespace xllm {
 
+// Logprobs of the generated tokens of a sequence. Positions are absolute
+// token indices, but only those from `num_prompt_tokens` to `capacity` are
+// stored, and only when logprobs are requested. The storage is sized once at
+// construction and never moves, since streaming responses read it on the
+// response threads while the scheduler keeps writing new positions.
 class LogprobState {
  public:
-  LogprobState(int64_t num_prompt_tokens, size_t capacity);
+  LogprobState(int64_t num_prompt_tokens,
+               size_t capacity,
+               bool logprobs,
+               bool top_logprobs);
   ~LogprobState() = default;
 
   // for generated tokens
@@ -47,17 +55,18 @@ class LogprobState {
 
   void update_logprob(size_t index, const Token& token, int64_t num_top_tokens);
 
-  const std::vector<std::vector<float>>& get_top_logprobs() const {
-    return top_logprobs_;
+  // the accessors below return an empty value for unset positions.
+  std::optional<float> get_logprob(size_t index) const {
+    const int64_t offset = static_cast<int64_t>(index) - num_prompt_tokens_;
+    if (offset < 0 || offset >= static_cast<int64_t>(logprobs_.size())) {
+      return std::nullopt;
+    }
+    return logprobs_[offset];
   }
 
-  const std::vector<std::vector<int64_t>>& get_top_tokens() const {
-    return top_tokens_;
-  }
+  const std::vector<float>& get_top_logprobs(size_t index) const;
 
-  const std::vector<std::optional<float>>& get_logprobs() const {
-    return logprobs_;
-  }
+  const std::vector<int64_t>& get_top_tokens(size_t index) const;
 
   void set_acc_logprob(float acc_logprob) { acc_logprob_ = acc_logprob; }
 
@@ -67,11 +76,12 @@ class LogprobState {
 
  private:
   int64_t num_prompt_tokens_;
+  // indexed by token index - num_prompt_tokens_.
   std::vector<std::optional<float>> logprobs_;
   // accumulated log probability of the sequence
   float acc_logprob_ = 0.0;
   int64_t last_acc_token_idx_ = -1;
-  // top k log probs
+  // top k log probs, only filled when top logprobs are requested.
   std::vector<std::vector<int64_t>> top_tokens_;
   std::vector<std::vector<float>> top_logprobs_;
 };
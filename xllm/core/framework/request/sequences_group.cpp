@@ -47,8 +47,12 @@ void SequencesGroup::add() {
                              prompt_tokens_.size(),
                              sequence_params_.echo,
                              sequence_params_.skip_special_tokens);
+  // the sequences read the prompt of the request, which outlives them and
+  // every response task holding the request, without owning a copy.
+  std::shared_ptr<const std::vector<int32_t>> prompt_tokens(
+      std::shared_ptr<const std::vector<int32_t>>(), &prompt_tokens_);
   sequences_.emplace_back(std::make_unique<Sequence>(index,
-                                                     prompt_tokens_,
+                                                     std::move(prompt_tokens),
                                                      input_embedding_,
                                                      mm_data_,
                                                      std::move(decoder),
@@ -256,7 +260,7 @@ void SequencesGroup::process_beam_search(bool force_requested_result_size) {
     source_info.suffix_start_idx = seq->num_prompt_tokens();
 
     const auto token_ids = seq->tokens();
-    const auto& log_probs = seq->logprob_state()->get_logprobs();
+    const LogprobState* logprob_state = seq->logprob_state();
     const size_t generated_token_count =
         token_ids.size() - source_info.suffix_start_idx;
     source_info.generated_token_ids.reserve(generated_token_count);
@@ -265,7 +269,8 @@ void SequencesGroup::process_beam_search(bool force_requested_result_size) {
          token_idx < token_ids.size();
          ++token_idx) {
       source_info.generated_token_ids.push_back(token_ids[token_idx]);
-      source_info.generated_logprobs.push_back(log_probs[token_idx]);
+      source_info.generated_logprobs.push_back(
+          logprob_state->get_logprob(token_idx));
     }
     source_info.src_blocks.assign(seq->kv_state().blocks(BlockType::KV).begin(),
                                   seq->kv_state().blocks(BlockType::KV).end());
@@ -312,9 +317,9 @@ void SequencesGroup::process_beam_search(bool force_requested_result_size) {
 
     const int32_t last_token_idx = seq->num_tokens() - 1;
     const auto& top_logprobs =
-        seq->logprob_state()->get_top_logprobs()[last_token_idx];
+        seq->logprob_state()->get_top_logprobs(last_token_idx);
     const auto& top_tokens =
-        seq->logprob_state()->get_top_tokens()[last_token_idx];
+        seq->logprob_state()->get_top_tokens(last_token_idx);
     const size_t candidate_topk = std::min<size_t>(
         topk, std::min(top_logprobs.size(), top_tokens.size()));
     if (candidate_topk == 0) {
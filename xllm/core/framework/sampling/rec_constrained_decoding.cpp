@@ -25,8 +25,10 @@ limitations under the License.
 #include <fstream>
 #include <future>
 #include <mutex>
+#include <string>
 
 #include "common/global_flags.h"
+#include "core/framework/config/rec_config.h"
 #include "framework/state_dict/rec_vocab_dict.h"
 #include "util/slice.h"
 #include "util/tensor_helper.h"
@@ -38,6 +40,8 @@ RecConstrainedDecoding::RecConstrainedDecoding(RecVocabDict* vocab_dict,
                                                torch::Device device,
                                                bool use_gen_threadpool)
     : use_gen_threadpool_(use_gen_threadpool),
+      use_device_tables_(::xllm::RecConfig::get_instance()
+                             .enable_rec_device_constraint_mask()),
       vocab_size_(vocab_size),
       vocab_dict_(vocab_dict),
       device_(device),
@@ -48,56 +52,246 @@ RecConstrainedDecoding::RecConstrainedDecoding(RecVocabDict* vocab_dict,
         /*cpu_binding=*/false,
         /*pool_name=*/"RecConstrainedDecoding.generate_mask");
   }
-
-  build_mask_cache_ = false;
+  refresh_threadpool_ = std::make_unique<ThreadPool>(
+      /*num_threads=*/1,
+      /*cpu_binding=*/false,
+      /*pool_name=*/"RecConstrainedDecoding.refresh_mask_cache");
 }
 
-bool RecConstrainedDecoding::build_mask_cache() {
-  CHECK(vocab_dict_ != nullptr)
-      << "RecVocabDict must be initialized before constrained decoding.";
-  first_token_mask_ = torch::full({vocab_size_}, PRE_MASK_FACTOR, dtype_);
+std::shared_ptr<const RecConstrainedDecoding::MaskCache>
+RecConstrainedDecoding::create_mask_cache(
+    std::shared_ptr<const RecVocabSnapshot> snapshot) const {
+  auto mask_cache = std::make_shared<MaskCache>();
+  auto first_token_mask = torch::full({vocab_size_}, PRE_MASK_FACTOR, dtype_);
 
   std::vector<int32_t> empty_token_ids;
   Slice<int32_t> prefix_token_ids = {empty_token_ids.data(),
                                      empty_token_ids.size()};
+  Slice<int32_t> first_token_ids =
+      snapshot->get_next_tokens_by_prefix_tokens(prefix_token_ids);
+  if (!first_token_ids.empty()) {
+    std::vector<int64_t> indices(first_token_ids.begin(),
+                                 first_token_ids.end());
+    first_token_mask.index_fill_(
+        /*dim=*/0, torch::tensor(indices, torch::kInt64), 0);
+  }
 
-  const std::unordered_set<int32_t>& first_token_ids =
-      vocab_dict_->get_next_tokens_by_prefix_tokens(prefix_token_ids);
-
-  for (auto token_id : first_token_ids) {
-    first_token_mask_[token_id] = 0;
+  mask_cache->first_token_mask = safe_to(first_token_mask, device_, true);
+  if (use_device_tables_) {
+    mask_cache->device_tables = std::make_shared<RecConstraintDeviceTables>(
+        snapshot->build_constraint_tables(vocab_size_), device_);
   }
+  mask_cache->snapshot = std::move(snapshot);
 
-  first_token_mask_ = safe_to(first_token_mask_, device_, true);
+  LOG(INFO) << "Build mask cache for rec vocab version "
+            << mask_cache->snapshot->version()
+            << ", first token ids size:" << first_token_ids.size();
+  return mask_cache;
+}
 
-  build_mask_cache_ = true;
+bool RecConstrainedDecoding::build_mask_cache() {
+  CHECK(vocab_dict_ != nullptr)
+      << "RecVocabDict must be initialized before constrained decoding.";
+  auto snapshot = vocab_dict_->snapshot();
+  CHECK(snapshot != nullptr)
+      << "RecVocabDict must be initialized before constrained decoding.";
+  mask_cache_.store(create_mask_cache(std::move(snapshot)));
+  return true;
+}
 
-  LOG(INFO) << "Build mask cache, first token ids size:"
-            << first_token_ids.size();
+std::shared_ptr<const RecVocabSnapshot> RecConstrainedDecoding::snapshot()
+    const {
+  auto mask_cache = mask_cache_.load();
+  return mask_cache != nullptr ? mask_cache->snapshot : nullptr;
+}
 
-  return true;
+void RecConstrainedDecoding::maybe_refresh_mask_cache(
+    const MaskCache& mask_cache) {
+  if (vocab_dict_->version() == mask_cache.snapshot->version() ||
+      refresh_in_flight_.exchange(true)) {
+    return;
+  }
+  refresh_threadpool_->schedule([this]() {
+    auto snapshot = vocab_dict_->snapshot();
+    mask_cache_.store(create_mask_cache(std::move(snapshot)));
+    refresh_in_flight_.store(false);
+  });
 }
 
 torch::Tensor RecConstrainedDecoding::generate_mask(
     const std::vector<std::vector<int32_t>>& generated_token_list) {
-  if (!build_mask_cache_ || 0 == generated_token_list.size()) {
+  return generate_mask(generated_token_list, /*request_ids=*/{});
+}
+
+torch::Tensor RecConstrainedDecoding::generate_mask(
+    const std::vector<std::vector<int32_t>>& generated_token_list,
+    const std::vector<std::string>& request_ids) {
+  auto mask_cache = mask_cache_.load();
+  if (mask_cache == nullptr || 0 == generated_token_list.size()) {
     return torch::Tensor();
   }
+  maybe_refresh_mask_cache(*mask_cache);
+
+  const std::vector<std::shared_ptr<const MaskCache>> row_mask_caches =
+      pin_mask_caches(generated_token_list, request_ids, mask_cache);
+  const bool single_version =
+      std::all_of(row_mask_caches.begin(),
+                  row_mask_caches.end(),
+                  [&](const auto& row_mask_cache) {
+                    return row_mask_cache == row_mask_caches.front();
+                  });
+  if (single_version) {
+    return build_mask(*row_mask_caches.front(), generated_token_list);
+  }
+
+  // rows of requests that started on different catalog versions.
+  const int64_t sequence_num =
+      static_cast<int64_t>(generated_token_list.size());
+  torch::Tensor mask;
+  std::vector<bool> done(generated_token_list.size(), false);
+  for (size_t row = 0; row < generated_token_list.size(); ++row) {
+    if (done[row]) {
+      continue;
+    }
+    std::vector<int64_t> rows;
+    std::vector<std::vector<int32_t>> version_token_list;
+    for (size_t i = row; i < generated_token_list.size(); ++i) {
+      if (row_mask_caches[i] == row_mask_caches[row]) {
+        done[i] = true;
+        rows.push_back(static_cast<int64_t>(i));
+        version_token_list.push_back(generated_token_list[i]);
+      }
+    }
+    torch::Tensor version_mask =
+        build_mask(*row_mask_caches[row], version_token_list);
+    if (!mask.defined()) {
+      mask = torch::empty({sequence_num, vocab_size_}, version_mask.options());
+    }
+    torch::Tensor row_indices = safe_to(
+        torch::tensor(rows, torch::kInt64), version_mask.device(), true);
+    mask.index_copy_(/*dim=*/0, row_indices, version_mask);
+  }
+  return mask;
+}
+
+std::vector<std::shared_ptr<const RecConstrainedDecoding::MaskCache>>
+RecConstrainedDecoding::pin_mask_caches(
+    const std::vector<std::vector<int32_t>>& generated_token_list,
+    const std::vector<std::string>& request_ids,
+    const std::shared_ptr<const MaskCache>& current) {
+  std::vector<std::shared_ptr<const MaskCache>> row_mask_caches(
+      generated_token_list.size(), current);
+  if (request_ids.size() != generated_token_list.size()) {
+    return row_mask_caches;
+  }
+
+  std::lock_guard<std::mutex> lock(pinned_mutex_);
+  std::vector<const std::string*> finished_request_ids;
+  for (size_t row = 0; row < generated_token_list.size(); ++row) {
+    const std::string& request_id = request_ids[row];
+    if (request_id.empty()) {
+      // rows without an id would all share one pin.
+      LOG_FIRST_N(WARNING, 1) << "Rec request without request id, its masks "
+                                 "follow the current catalog version.";
+      continue;
+    }
+    const size_t step = generated_token_list[row].size();
+    auto it = pinned_mask_caches_.find(request_id);
+    if (it == pinned_mask_caches_.end()) {
+      if (step != 0) {
+        continue;
+      }
+      // the first step of a request pins the current version; the other
+      // rows (beams) of the request in this call find it above.
+      std::shared_ptr<const MaskCache> mask_cache = current;
+      auto snapshot = vocab_dict_->pin(request_id, current->snapshot);
+      if (snapshot != current->snapshot) {
+        // the request is already pinned to another version in this process.
+        mask_cache = create_mask_cache(std::move(snapshot));
+      }
+      it = pinned_mask_caches_.emplace(request_id, std::move(mask_cache)).first;
+    }
+    row_mask_caches[row] = it->second;
+    if (step + 1 >= static_cast<size_t>(REC_TOKEN_SIZE)) {
+      finished_request_ids.push_back(&request_id);
+    }
+  }
+  // masks are no longer needed after the last step; the version stays
+  // pinned in the dictionary for the output path until release().
+  for (const std::string* request_id : finished_request_ids) {
+    pinned_mask_caches_.erase(*request_id);
+  }
+  return row_mask_caches;
+}
+
+void RecConstrainedDecoding::release(
+    const std::vector<std::string>& request_ids) {
+  if (request_ids.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(pinned_mutex_);
+    for (const std::string& request_id : request_ids) {
+      pinned_mask_caches_.erase(request_id);
+    }
+  }
+  if (vocab_dict_ != nullptr) {
+    vocab_dict_->release(request_ids);
+  }
+}
 
+torch::Tensor RecConstrainedDecoding::build_mask(
+    const MaskCache& mask_cache,
+    const std::vector<std::vector<int32_t>>& generated_token_list) {
   size_t token_size = generated_token_list[0].size();
 
   // Generate mask for first token
   if (0 == token_size) {
     size_t sequence_num = generated_token_list.size();
-    auto mask = first_token_mask_.unsqueeze(0);
+    auto mask = mask_cache.first_token_mask.unsqueeze(0);
     return mask.repeat({static_cast<int64_t>(sequence_num), 1});
   }
 
   // Generate mask for non-first token
-  return generate_decode_mask(generated_token_list);
+  if (mask_cache.device_tables != nullptr) {
+    torch::Tensor mask = generate_decode_mask_on_device(
+        *mask_cache.device_tables, generated_token_list);
+    if (mask.defined()) {
+      return mask;
+    }
+  }
+  return generate_decode_mask(*mask_cache.snapshot, generated_token_list);
+}
+
+torch::Tensor RecConstrainedDecoding::generate_decode_mask_on_device(
+    const RecConstraintDeviceTables& device_tables,
+    const std::vector<std::vector<int32_t>>& generated_token_list) {
+  const int64_t sequence_num =
+      static_cast<int64_t>(generated_token_list.size());
+  const int64_t step = static_cast<int64_t>(generated_token_list[0].size());
+  if (step >= REC_TOKEN_SIZE) {
+    return torch::Tensor();
+  }
+
+  // only the [sequence_num, step] prefixes are copied to the device.
+  std::vector<int32_t> prefix_tokens;
+  prefix_tokens.reserve(sequence_num * step);
+  for (const auto& tokens : generated_token_list) {
+    if (static_cast<int64_t>(tokens.size()) != step) {
+      LOG_FIRST_N(WARNING, 1) << "Ragged rec prefixes, fall back to host "
+                                 "constrained decoding masks.";
+      return torch::Tensor();
+    }
+    prefix_tokens.insert(prefix_tokens.end(), tokens.begin(), tokens.end());
+  }
+  torch::Tensor prefix_tensor =
+      torch::tensor(prefix_tokens, torch::kInt32).view({sequence_num, step});
+  prefix_tensor = safe_to(prefix_tensor, device_, true);
+  return device_tables.build_mask(prefix_tensor, dtype_, PRE_MASK_FACTOR);
 }
 
 torch::Tensor RecConstrainedDecoding::generate_decode_mask(
+    const RecVocabSnapshot& snapshot,
     const std::vector<std::vector<int32_t>>& generated_token_list) {
   size_t sequence_num = generated_token_list.size();
   torch::TensorOptions options = torch::dtype(dtype_).device(device_);
@@ -124,8 +318,8 @@ torch::Tensor RecConstrainedDecoding::generate_decode_mask(
     for (size_t token_idx = start_idx; token_idx < end_idx; ++token_idx) {
       Slice<int32_t> tokens_slice(generated_token_list[token_idx]);
 
-      const std::unordered_set<int32_t>& next_token_ids =
-          vocab_dict_->get_next_tokens_by_prefix_tokens(tokens_slice);
+      Slice<int32_t> next_token_ids =
+          snapshot.get_next_tokens_by_prefix_tokens(tokens_slice);
 
       if (next_token_ids.size() > 0) {
         for (int32_t vocab_idx : next_token_ids) {
@@ -17,13 +17,38 @@ limitations under the License.
 #include <torch/torch.h>
 #include <torch/types.h>
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "constrained_decoding.h"
+#include "rec_constraint_mask.h"
 #include "util/threadpool.h"
 
 namespace xllm {
 
 class RecVocabDict;
+class RecVocabSnapshot;
 
+// Masks are built from one pinned RecVocabSnapshot. When the dictionary
+// publishes a new catalog version, the cached masks are rebuilt in the
+// background and swapped in; until then, the previous version keeps serving
+// so a mask never mixes two catalogs.
+//
+// A request keeps the version it started with: given request ids, the
+// version is pinned at the first rec step of a request and kept until
+// release(), so a reload never invalidates the prefix it already chose. The
+// pin is also published to the RecVocabDict, where the output path of the
+// request looks its items up. Rows without a request id use the current
+// version and are not pinned.
+//
+// With enable_rec_device_constraint_mask, the constraint tables of each
+// catalog version are uploaded once and decode masks are built on device from
+// the batched prefix tokens, instead of host-side lookups per sequence.
 class RecConstrainedDecoding : public ConstrainedDecoding {
  public:
   RecConstrainedDecoding(RecVocabDict* vocab_dict,
@@ -38,8 +63,52 @@ class RecConstrainedDecoding : public ConstrainedDecoding {
   torch::Tensor generate_mask(
       const std::vector<std::vector<int32_t>>& generated_token_list) override;
 
+  // Same as above, with the request id of each row of
+  // `generated_token_list` to build its mask from the catalog version the
+  // request started with. Falls back to the current version if the ids do
+  // not line up with the rows.
+  torch::Tensor generate_mask(
+      const std::vector<std::vector<int32_t>>& generated_token_list,
+      const std::vector<std::string>& request_ids);
+
+  // The catalog version the cached masks are built from.
+  std::shared_ptr<const RecVocabSnapshot> snapshot() const;
+
+  // Drops the versions pinned by finished or cancelled requests.
+  void release(const std::vector<std::string>& request_ids);
+
  private:
+  struct MaskCache {
+    std::shared_ptr<const RecVocabSnapshot> snapshot;
+    torch::Tensor first_token_mask;
+    // set in device mask mode only.
+    std::shared_ptr<const RecConstraintDeviceTables> device_tables;
+  };
+
+  std::shared_ptr<const MaskCache> create_mask_cache(
+      std::shared_ptr<const RecVocabSnapshot> snapshot) const;
+
+  // Schedule a rebuild if the dictionary moved past the cached version.
+  void maybe_refresh_mask_cache(const MaskCache& mask_cache);
+
+  // Mask cache of each row, pinning `current` for the rows at their first
+  // step.
+  std::vector<std::shared_ptr<const MaskCache>> pin_mask_caches(
+      const std::vector<std::vector<int32_t>>& generated_token_list,
+      const std::vector<std::string>& request_ids,
+      const std::shared_ptr<const MaskCache>& current);
+
+  torch::Tensor build_mask(
+      const MaskCache& mask_cache,
+      const std::vector<std::vector<int32_t>>& generated_token_list);
+
   torch::Tensor generate_decode_mask(
+      const RecVocabSnapshot& snapshot,
+      const std::vector<std::vector<int32_t>>& generated_token_list);
+
+  // Returns an undefined tensor if the prefixes are ragged.
+  torch::Tensor generate_decode_mask_on_device(
+      const RecConstraintDeviceTables& device_tables,
       const std::vector<std::vector<int32_t>>& generated_token_list);
 
  private:
@@ -47,14 +116,21 @@ class RecConstrainedDecoding : public ConstrainedDecoding {
   constexpr static int GEN_MASK_THREAD_NUM = 16;
 
  private:
-  bool build_mask_cache_;
   bool use_gen_threadpool_;
+  bool use_device_tables_;
   int32_t vocab_size_;
   RecVocabDict* vocab_dict_ = nullptr;
   torch::Device device_;
   torch::ScalarType dtype_;
-  torch::Tensor first_token_mask_;
+  std::atomic<std::shared_ptr<const MaskCache>> mask_cache_;
+  std::atomic<bool> refresh_in_flight_{false};
+  // catalog versions pinned by the requests in flight, by request id.
+  std::mutex pinned_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<const MaskCache>>
+      pinned_mask_caches_;
   std::unique_ptr<ThreadPool> gen_threadpool_;
+  // declared last so pending rebuilds finish before other members go away.
+  std::unique_ptr<ThreadPool> refresh_threadpool_;
 };
 
 }  // namespace xllm
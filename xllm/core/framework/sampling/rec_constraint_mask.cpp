@@ -0,0 +1,173 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "rec_constraint_mask.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+
+namespace xllm {
+namespace {
+
+torch::Tensor to_device_long(const std::vector<int32_t>& values,
+                             const torch::Device& device) {
+  torch::Tensor tensor =
+      torch::tensor(values, torch::dtype(torch::kInt32)).to(torch::kLong);
+  return tensor.to(device);
+}
+
+torch::Tensor to_device_long(const std::vector<int64_t>& values,
+                             const torch::Device& device) {
+  return torch::tensor(values, torch::dtype(torch::kLong)).to(device);
+}
+
+}  // namespace
+
+RecConstraintDeviceTables::RecConstraintDeviceTables(
+    const RecConstraintTables& tables,
+    const torch::Device& device)
+    : device_(device),
+      vocab_size_(tables.vocab_size),
+      max_prefix1_degree_(tables.max_prefix1_degree),
+      max_prefix2_degree_(tables.max_prefix2_degree) {
+  CHECK_GT(tables.vocab_size, 0);
+  CHECK_EQ(tables.prefix1_offsets.size(),
+           static_cast<size_t>(tables.vocab_size) + 1);
+  CHECK_EQ(tables.prefix1_pair_keys.size(), tables.prefix1_values.size());
+  CHECK_EQ(tables.prefix2_value_offsets.size(),
+           tables.prefix1_values.size() + 1);
+
+  prefix1_offsets_ = to_device_long(tables.prefix1_offsets, device_);
+  prefix1_values_ = to_device_long(tables.prefix1_values, device_);
+  prefix1_pair_keys_ = to_device_long(tables.prefix1_pair_keys, device_);
+  prefix2_value_offsets_ =
+      to_device_long(tables.prefix2_value_offsets, device_);
+  prefix2_values_ = to_device_long(tables.prefix2_values, device_);
+}
+
+torch::Tensor RecConstraintDeviceTables::allowed_tokens(
+    const torch::Tensor& prefix_tokens) const {
+  CHECK_EQ(prefix_tokens.dim(), 2)
+      << "prefix_tokens must be [num_seqs, step], dim=" << prefix_tokens.dim();
+  const int64_t num_seqs = prefix_tokens.size(0);
+  const int64_t step = prefix_tokens.size(1);
+  CHECK(step >= 1 && step < REC_TOKEN_SIZE)
+      << "Unsupported rec constraint prefix length " << step;
+
+  const auto long_options = torch::dtype(torch::kLong).device(device_);
+  const torch::Tensor prefix = prefix_tokens.to(long_options);
+  const torch::Tensor t0 = prefix.select(/*dim=*/1, /*index=*/0);
+  torch::Tensor valid = (t0 >= 0) & (t0 < vocab_size_);
+  const torch::Tensor t0_index = t0.clamp(0, vocab_size_ - 1);
+
+  torch::Tensor begin;
+  torch::Tensor end;
+  torch::Tensor values;
+  int64_t max_degree = 0;
+  if (step == 1) {
+    begin = prefix1_offsets_.index_select(/*dim=*/0, t0_index);
+    end = prefix1_offsets_.index_select(/*dim=*/0, t0_index + 1);
+    values = prefix1_values_;
+    max_degree = max_prefix1_degree_;
+  } else {
+    const int64_t num_pairs = prefix1_pair_keys_.numel();
+    if (num_pairs == 0) {
+      return torch::full({num_seqs, 0}, vocab_size_, long_options);
+    }
+    const torch::Tensor t1 = prefix.select(/*dim=*/1, /*index=*/1);
+    valid = valid & (t1 >= 0) & (t1 < vocab_size_);
+    // pair keys are globally sorted, so (t0, t1) is found by binary search.
+    const torch::Tensor keys = t0 * vocab_size_ + t1;
+    const torch::Tensor pair_index =
+        torch::searchsorted(prefix1_pair_keys_, keys).clamp_max(num_pairs - 1);
+    valid = valid &
+            (prefix1_pair_keys_.index_select(/*dim=*/0, pair_index) == keys);
+    begin = prefix2_value_offsets_.index_select(/*dim=*/0, pair_index);
+    end = prefix2_value_offsets_.index_select(/*dim=*/0, pair_index + 1);
+    values = prefix2_values_;
+    max_degree = max_prefix2_degree_;
+  }
+
+  if (max_degree == 0 || values.numel() == 0) {
+    return torch::full({num_seqs, 0}, vocab_size_, long_options);
+  }
+  end = torch::where(valid, end, begin);
+
+  // row i reads values[begin[i] : end[i]], padded to max_degree.
+  const torch::Tensor positions =
+      begin.unsqueeze(1) + torch::arange(max_degree, long_options).unsqueeze(0);
+  const torch::Tensor in_range = positions < end.unsqueeze(1);
+  torch::Tensor tokens =
+      values
+          .index_select(/*dim=*/0,
+                        positions.clamp_max(values.numel() - 1).view({-1}))
+          .view({num_seqs, max_degree});
+  return tokens.masked_fill_(in_range.logical_not(), vocab_size_);
+}
+
+torch::Tensor RecConstraintDeviceTables::build_mask(
+    const torch::Tensor& prefix_tokens,
+    torch::ScalarType dtype,
+    float fill_value) const {
+  const torch::Tensor allowed = allowed_tokens(prefix_tokens);
+  // the extra column absorbs the padding entries of allowed.
+  torch::Tensor mask = torch::full({allowed.size(0), vocab_size_ + 1},
+                                   fill_value,
+                                   torch::dtype(dtype).device(device_));
+  if (allowed.size(1) > 0) {
+    mask.scatter_(/*dim=*/1, allowed, 0);
+  }
+  return mask.narrow(/*dim=*/1, /*start=*/0, /*length=*/vocab_size_);
+}
+
+std::vector<std::vector<int32_t>> rec_constraint_allowed_tokens_reference(
+    const RecConstraintTables& tables,
+    const std::vector<std::vector<int32_t>>& prefixes) {
+  std::vector<std::vector<int32_t>> allowed(prefixes.size());
+  for (size_t i = 0; i < prefixes.size(); ++i) {
+    const std::vector<int32_t>& prefix = prefixes[i];
+    CHECK_LT(prefix.size(), REC_TOKEN_SIZE);
+    if (prefix.empty()) {
+      allowed[i] = tables.first_token_ids;
+      continue;
+    }
+
+    const int32_t t0 = prefix[0];
+    if (t0 < 0 || t0 >= tables.vocab_size) {
+      continue;
+    }
+    const int32_t prefix1_begin = tables.prefix1_offsets[t0];
+    const int32_t prefix1_end = tables.prefix1_offsets[t0 + 1];
+    if (prefix.size() == 1) {
+      allowed[i].assign(tables.prefix1_values.begin() + prefix1_begin,
+                        tables.prefix1_values.begin() + prefix1_end);
+      continue;
+    }
+
+    for (int32_t j = prefix1_begin; j < prefix1_end; ++j) {
+      if (tables.prefix1_values[j] != prefix[1]) {
+        continue;
+      }
+      allowed[i].assign(
+          tables.prefix2_values.begin() + tables.prefix2_value_offsets[j],
+          tables.prefix2_values.begin() + tables.prefix2_value_offsets[j + 1]);
+      break;
+    }
+  }
+  return allowed;
+}
+
+}  // namespace xllm
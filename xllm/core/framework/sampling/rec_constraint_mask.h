@@ -0,0 +1,72 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <torch/torch.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "framework/state_dict/rec_vocab_snapshot.h"
+
+namespace xllm {
+
+// RecConstraintTables uploaded once to a device, so constrained decoding masks
+// are built there from batched prefix tokens instead of being materialized on
+// the host as a dense [num_seqs, vocab_size] tensor per step. Only the prefix
+// tokens ([num_seqs, step] int64) cross the host/device boundary.
+//
+// Works on any torch device; on CPU it doubles as the executable reference for
+// the device path.
+class RecConstraintDeviceTables final {
+ public:
+  RecConstraintDeviceTables(const RecConstraintTables& tables,
+                            const torch::Device& device);
+
+  // Allowed next tokens for every prefix row, as [num_seqs, max_degree] int64
+  // padded with vocab_size(). prefix_tokens is [num_seqs, step] with
+  // 1 <= step < REC_TOKEN_SIZE; unknown prefixes yield an all-padding row.
+  torch::Tensor allowed_tokens(const torch::Tensor& prefix_tokens) const;
+
+  // Dense additive mask: 0 for allowed tokens, fill_value elsewhere.
+  torch::Tensor build_mask(const torch::Tensor& prefix_tokens,
+                           torch::ScalarType dtype,
+                           float fill_value) const;
+
+  int32_t vocab_size() const { return vocab_size_; }
+  const torch::Device& device() const { return device_; }
+
+ private:
+  torch::Device device_;
+  int32_t vocab_size_ = 0;
+  int64_t max_prefix1_degree_ = 0;
+  int64_t max_prefix2_degree_ = 0;
+
+  // all index tensors are int64 so they feed index_select directly.
+  torch::Tensor prefix1_offsets_;
+  torch::Tensor prefix1_values_;
+  torch::Tensor prefix1_pair_keys_;
+  torch::Tensor prefix2_value_offsets_;
+  torch::Tensor prefix2_values_;
+};
+
+// Plain CPU walk over the CSR tables, the reference the tensor path is tested
+// against. Returns the sorted allowed tokens after each prefix.
+std::vector<std::vector<int32_t>> rec_constraint_allowed_tokens_reference(
+    const RecConstraintTables& tables,
+    const std::vector<std::vector<int32_t>>& prefixes);
+
+}  // namespace xllm
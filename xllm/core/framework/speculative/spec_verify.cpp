@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "core/framework/speculative/spec_verify.h"
 
+#include <glog/logging.h>
+
 #include <memory>
 
 #include "framework/sampling/rejection_sampler.h"
@@ -52,4 +54,37 @@ SampleOutput run_rejection_sampling(const SamplerPolicy& policy,
   return sample_output;
 }
 
+SampleOutput run_greedy_verification(const torch::Tensor& draft_token_ids,
+                                     const torch::Tensor& draft_probs,
+                                     const ForwardOutput& target_output,
+                                     int32_t num_val_tokens,
+                                     bool enable_fused_kernel) {
+  const int32_t batch_size =
+      static_cast<int32_t>(draft_token_ids.size(/*dim=*/0));
+  const int32_t vocab_size =
+      static_cast<int32_t>(target_output.logits.size(/*dim=*/-1));
+  CHECK_EQ(target_output.logits.size(/*dim=*/0),
+           static_cast<int64_t>(batch_size) * num_val_tokens)
+      << "greedy validate logits shape mismatch";
+
+  using ISlice = torch::indexing::Slice;
+  auto target_logits =
+      target_output.logits.view({batch_size, num_val_tokens, vocab_size});
+  // Use target greedy token as the bonus token, consistent with greedy verify.
+  auto bonus_token_ids =
+      target_logits.index({ISlice(), num_val_tokens - 1, ISlice()})
+          .argmax(/*dim=*/-1, /*keepdim=*/true);
+
+  auto greedy_do_sample = torch::zeros({batch_size}, torch::kBool);
+  return run_rejection_sampling({.do_sample = greedy_do_sample,
+                                 .all_random_sample = false,
+                                 .all_greedy_sample = true},
+                                draft_token_ids,
+                                draft_probs,
+                                target_logits,
+                                target_output,
+                                bonus_token_ids,
+                                enable_fused_kernel);
+}
+
 }  // namespace xllm::spec_verify
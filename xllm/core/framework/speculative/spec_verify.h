@@ -43,6 +43,15 @@ SampleOutput run_rejection_sampling(const SamplerPolicy& policy,
                                     const torch::Tensor& bonus_token_ids,
                                     bool enable_fused_kernel);
 
+// Greedy accept for the draft-model-free workers (Suffix, NGram). Target
+// logits are viewed as [batch, num_val_tokens, vocab] and the bonus token is
+// the target argmax at the last position, regardless of sampling params.
+SampleOutput run_greedy_verification(const torch::Tensor& draft_token_ids,
+                                     const torch::Tensor& draft_probs,
+                                     const ForwardOutput& target_output,
+                                     int32_t num_val_tokens,
+                                     bool enable_fused_kernel);
+
 }  // namespace spec_verify
 
 }  // namespace xllm
@@ -1,10 +1,14 @@
 #include "rec_vocab_dict.h"
 
-#include <algorithm>
-#include <array>
-#include <filesystem>
-#include <fstream>
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
 
 #include "common/global_flags.h"
 #include "core/framework/config/rec_config.h"
@@ -12,352 +16,199 @@
 
 namespace xllm {
 namespace {
-constexpr uint32_t kMaxExtendedFieldBytes = 1U << 20;
 
-bool rec_token_triple_less(const RecTokenTriple& lhs,
-                           const RecTokenTriple& rhs) {
-  if (lhs[0] != rhs[0]) {
-    return lhs[0] < rhs[0];
+struct VocabFileStamp {
+  dev_t device = 0;
+  ino_t inode = 0;
+  off_t size = 0;
+  int64_t mtime_ns = 0;
+
+  bool same_file(const VocabFileStamp& other) const {
+    return device == other.device && inode == other.inode;
   }
-  if (lhs[1] != rhs[1]) {
-    return lhs[1] < rhs[1];
+
+  bool operator==(const VocabFileStamp& other) const {
+    return same_file(other) && size == other.size &&
+           mtime_ns == other.mtime_ns;
   }
-  return lhs[2] < rhs[2];
-}
+};
 
-void check_token_id(int32_t token_id, int32_t vocab_size, const char* name) {
-  CHECK_GE(token_id, 0) << "Invalid OneRec " << name
-                        << " token id: " << token_id;
-  CHECK_LT(token_id, vocab_size)
-      << "OneRec " << name << " token id " << token_id << " exceeds vocab_size "
-      << vocab_size;
+std::optional<VocabFileStamp> get_file_stamp(const std::string& vocab_file) {
+  struct stat sb;
+  if (stat(vocab_file.c_str(), &sb) != 0) {
+    return std::nullopt;
+  }
+  VocabFileStamp stamp;
+  stamp.device = sb.st_dev;
+  stamp.inode = sb.st_ino;
+  stamp.size = sb.st_size;
+  stamp.mtime_ns =
+      static_cast<int64_t>(sb.st_mtim.tv_sec) * 1000000000 + sb.st_mtim.tv_nsec;
+  return stamp;
 }
 
 }  // namespace
 
-bool RecVocabDict::initialize(const std::string& vocab_file) {
-  if (initialized_) {
-    return true;
+RecVocabDict::~RecVocabDict() {
+  {
+    std::lock_guard<std::mutex> lock(watch_mutex_);
+    stop_watch_ = true;
   }
+  watch_cv_.notify_all();
+  if (watch_thread_.joinable()) {
+    watch_thread_.join();
+  }
+}
 
-  Timer timer;
-
-  if (vocab_file.empty()) {
-    LOG(ERROR) << "Content data file is empty, file: " << vocab_file;
-    return false;
+bool RecVocabDict::initialize(const std::string& vocab_file) {
+  if (snapshot() != nullptr) {
+    return true;
   }
-  if (!std::filesystem::exists(vocab_file)) {
-    LOG(ERROR) << "Fail to find content data file: " << vocab_file;
+  if (!reload(vocab_file)) {
     return false;
   }
-  std::ifstream ifs(vocab_file.data(), std::ios::binary | std::ios::ate);
-  if (!ifs.is_open()) {
-    LOG(ERROR) << "Fail to load content data file: " << vocab_file;
-    return false;
+
+  const int32_t interval_s =
+      ::xllm::RecConfig::get_instance().rec_vocab_reload_interval_s();
+  if (interval_s > 0) {
+    watch_thread_ = std::thread([this, vocab_file, interval_s]() {
+      watch_loop(vocab_file, interval_s);
+    });
   }
+  return true;
+}
+
+bool RecVocabDict::reload(const std::string& vocab_file) {
+  std::lock_guard<std::mutex> lock(reload_mutex_);
+  Timer timer;
 
-  const std::streamoff file_end = ifs.tellg();
-  if (file_end < 0) {
-    LOG(ERROR) << "Failed to read content data file size: " << vocab_file;
+  std::shared_ptr<RecVocabSnapshot> snapshot = RecVocabSnapshot::load(
+      vocab_file,
+      ::xllm::RecConfig::get_instance().enable_extended_item_info());
+  if (snapshot == nullptr) {
     return false;
   }
-  const size_t file_size = static_cast<size_t>(file_end);
-  ifs.seekg(0, std::ios::beg);
+  publish(std::move(snapshot));
 
-  const size_t itemid_size = sizeof(int64_t);
-  const size_t tokens_size = REC_TOKEN_SIZE * sizeof(int32_t);
-  const size_t min_line_size = itemid_size + tokens_size;
-  const size_t estimated_lines =
-      (file_size + min_line_size - 1) / min_line_size;
+  const auto active = this->snapshot();
+  LOG(INFO) << "Loaded rec vocab version " << active->version() << " from "
+            << vocab_file
+            << ", records: " << active->num_records()
+            << ", items: " << active->num_items()
+            << ", token triples: " << active->num_triples()
+            << ", bytes: " << active->size_bytes()
+            << ", cost: " << timer.elapsed_seconds() << " seconds";
+  return true;
+}
 
-  item_to_tokens_map_.reserve(estimated_lines);
-  tokens_to_item_infos_map_.reserve(estimated_lines / 2);
-  prefix_tokens_to_next_tokens_map_.reserve(estimated_lines / 4);
-  auto clear_partial_state = [this]() {
-    item_to_tokens_map_.clear();
-    tokens_to_item_infos_map_.clear();
-    prefix_tokens_to_next_tokens_map_.clear();
-  };
-  auto fail_with_error = [&](const std::string& message) {
-    LOG(ERROR) << message;
-    clear_partial_state();
-    return false;
-  };
-  auto get_remaining_bytes = [&ifs, file_size]() -> size_t {
-    const std::streamoff current_pos = ifs.tellg();
-    if (current_pos < 0) {
-      return 0;
-    }
-    const size_t current_offset = static_cast<size_t>(current_pos);
-    return current_offset <= file_size ? file_size - current_offset : 0;
-  };
-  auto validate_extended_field_length = [&](uint32_t field_length,
-                                            const char* field_name) {
-    if (field_length > kMaxExtendedFieldBytes) {
-      return fail_with_error(std::string("Field length for ") + field_name +
-                             " exceeds limit in " + vocab_file);
-    }
-    if (static_cast<size_t>(field_length) > get_remaining_bytes()) {
-      return fail_with_error(std::string("Field length for ") + field_name +
-                             " exceeds remaining bytes in " + vocab_file);
-    }
-    return true;
-  };
+void RecVocabDict::publish(std::shared_ptr<RecVocabSnapshot> snapshot) {
+  snapshot->set_version(next_version_++);
+  snapshot_.store(std::move(snapshot), std::memory_order_release);
+}
 
-  int64_t item_id = 0;
-  RecTokenTriple tokens;
+bool RecVocabDict::save_compact(const std::string& vocab_file) const {
+  return checked_snapshot()->save(vocab_file);
+}
 
-  if (!::xllm::RecConfig::get_instance().enable_extended_item_info()) {
-    const size_t line_size = tokens_size + itemid_size;
-    while (ifs.read(reinterpret_cast<char*>(&item_id), itemid_size) &&
-           ifs.read(reinterpret_cast<char*>(tokens.data()), tokens_size)) {
-      if (::xllm::RecConfig::get_instance().enable_constrained_decoding()) {
-        for (int32_t i = 0; i < tokens.size(); ++i) {
-          std::vector<int32_t> prefix_tokens;
-          for (int32_t j = 0; j < i; ++j) {
-            prefix_tokens.emplace_back(tokens[j]);
-          }
-          prefix_tokens_to_next_tokens_map_[prefix_tokens].insert(tokens[i]);
-        }
-      }
+uint64_t RecVocabDict::version() const {
+  const auto active = snapshot();
+  return active != nullptr ? active->version() : 0;
+}
 
-      item_to_tokens_map_[item_id] = tokens;
-      RecItemInfo item_info;
-      item_info.item_id = item_id;
-      tokens_to_item_infos_map_[tokens].emplace_back(std::move(item_info));
+void RecVocabDict::watch_loop(std::string vocab_file, int32_t interval_s) {
+  std::optional<VocabFileStamp> last_stamp = get_file_stamp(vocab_file);
+  // a change seen on the previous poll, not loaded yet.
+  std::optional<VocabFileStamp> pending_stamp;
+  const auto interval = std::chrono::seconds(interval_s);
+  auto stopped = [this]() { return stop_watch_; };
+  std::unique_lock<std::mutex> lock(watch_mutex_);
+  while (!watch_cv_.wait_for(lock, interval, stopped)) {
+    std::optional<VocabFileStamp> stamp = get_file_stamp(vocab_file);
+    if (!stamp.has_value() || stamp == last_stamp) {
+      pending_stamp.reset();
+      continue;
     }
-
-    if (ifs.gcount() != 0 &&
-        ifs.gcount() != static_cast<std::streamsize>(tokens_size)) {
-      return fail_with_error("Possibly containing incomplete lines : " +
-                             vocab_file);
+    // A file renamed into place is complete. A file rewritten in place is
+    // only loaded once its stamp holds across two polls, so that a writer
+    // still appending to it is not published half-written.
+    const bool renamed =
+        !last_stamp.has_value() || !stamp->same_file(*last_stamp);
+    if (!renamed && stamp != pending_stamp) {
+      pending_stamp = stamp;
+      continue;
     }
-  } else {
-    while (ifs.read(reinterpret_cast<char*>(&item_id), itemid_size)) {
-      uint32_t did_length = 0;
-      if (!ifs.read(reinterpret_cast<char*>(&did_length), sizeof(uint32_t))) {
-        return fail_with_error("Failed to read did length from " + vocab_file);
-      }
-      if (!validate_extended_field_length(did_length, "did")) {
-        return false;
-      }
-
-      std::string did;
-      if (did_length > 0) {
-        did.resize(did_length);
-        if (!ifs.read(did.data(), did_length)) {
-          return fail_with_error("Failed to read did string from " +
-                                 vocab_file);
-        }
-      }
-
-      uint32_t type_length = 0;
-      if (!ifs.read(reinterpret_cast<char*>(&type_length), sizeof(uint32_t))) {
-        return fail_with_error("Failed to read type length from " + vocab_file);
-      }
-      if (!validate_extended_field_length(type_length, "type")) {
-        return false;
-      }
-
-      std::string type;
-      if (type_length > 0) {
-        type.resize(type_length);
-        if (!ifs.read(type.data(), type_length)) {
-          return fail_with_error("Failed to read type string from " +
-                                 vocab_file);
-        }
-      }
-
-      if (!ifs.read(reinterpret_cast<char*>(tokens.data()), tokens_size)) {
-        return fail_with_error("Failed to read token ids from " + vocab_file);
-      }
-
-      if (::xllm::RecConfig::get_instance().enable_constrained_decoding()) {
-        for (int32_t i = 0; i < tokens.size(); ++i) {
-          std::vector<int32_t> prefix_tokens;
-          for (int32_t j = 0; j < i; ++j) {
-            prefix_tokens.emplace_back(tokens[j]);
-          }
-          prefix_tokens_to_next_tokens_map_[prefix_tokens].insert(tokens[i]);
-        }
-      }
-
-      item_to_tokens_map_[item_id] = tokens;
-      RecItemInfo item_info;
-      item_info.item_id = item_id;
-      item_info.did = std::move(did);
-      item_info.type = std::move(type);
-      tokens_to_item_infos_map_[tokens].emplace_back(std::move(item_info));
+    lock.unlock();
+    const bool reloaded = reload(vocab_file);
+    lock.lock();
+    pending_stamp.reset();
+    if (reloaded) {
+      last_stamp = stamp;
+    } else {
+      LOG(WARNING) << "Failed to reload rec vocab from " << vocab_file
+                   << ", keep version " << version();
     }
+  }
+}
 
-    if (ifs.gcount() > 0 || (!ifs.eof() && ifs.fail())) {
-      return fail_with_error("Failed while reading " + vocab_file);
-    }
+std::shared_ptr<const RecVocabSnapshot> RecVocabDict::pin(
+    const std::string& request_id,
+    std::shared_ptr<const RecVocabSnapshot> snapshot) {
+  if (request_id.empty()) {
+    return snapshot;
   }
+  std::lock_guard<std::mutex> lock(pins_mutex_);
+  return pins_.try_emplace(request_id, std::move(snapshot)).first->second;
+}
 
-  initialized_ = true;
-  LOG(INFO) << "Total line size:" << estimated_lines
-            << ",parse tokens to item id map size: "
-            << tokens_to_item_infos_map_.size()
-            << ", parse item to tokens map size:" << item_to_tokens_map_.size()
-            << ", parse prefix tokens to next tokens map size:"
-            << prefix_tokens_to_next_tokens_map_.size()
-            << ", cost: " << timer.elapsed_seconds() << " seconds";
+std::shared_ptr<const RecVocabSnapshot> RecVocabDict::pinned_snapshot(
+    const std::string& request_id) const {
+  std::lock_guard<std::mutex> lock(pins_mutex_);
+  auto it = pins_.find(request_id);
+  return it != pins_.end() ? it->second : nullptr;
+}
 
-  return true;
+void RecVocabDict::release(const std::vector<std::string>& request_ids) {
+  std::lock_guard<std::mutex> lock(pins_mutex_);
+  for (const std::string& request_id : request_ids) {
+    pins_.erase(request_id);
+  }
+}
+
+std::shared_ptr<const RecVocabSnapshot> RecVocabDict::checked_snapshot()
+    const {
+  auto active = snapshot();
+  CHECK(active != nullptr) << "RecVocabDict is not initialized";
+  return active;
 }
 
 bool RecVocabDict::get_items_by_tokens(const RecTokenTriple& rec_token_triple,
                                        std::vector<int64_t>* item_ids) const {
-  CHECK_EQ(initialized_, true);
-  CHECK_NE(item_ids, nullptr);
-
-  std::vector<RecItemInfo> item_infos;
-  if (!get_item_infos_by_tokens(rec_token_triple, &item_infos)) {
-    return false;
-  }
-
-  item_ids->reserve(item_ids->size() + item_infos.size());
-  for (const auto& item_info : item_infos) {
-    item_ids->emplace_back(item_info.item_id);
-  }
-  return true;
+  return checked_snapshot()->get_items_by_tokens(rec_token_triple, item_ids);
 }
 
 bool RecVocabDict::get_item_infos_by_tokens(
     const RecTokenTriple& rec_token_triple,
     std::vector<RecItemInfo>* item_infos) const {
-  CHECK_EQ(initialized_, true);
-  CHECK_NE(item_infos, nullptr);
-
-  auto iter = tokens_to_item_infos_map_.find(rec_token_triple);
-  if (iter == tokens_to_item_infos_map_.end()) {
-    return false;
-  }
-
-  std::copy(iter->second.begin(),
-            iter->second.end(),
-            std::back_inserter(*item_infos));
-  return true;
+  return checked_snapshot()->get_item_infos_by_tokens(rec_token_triple,
+                                                      item_infos);
 }
 
 bool RecVocabDict::get_tokens_by_item(int64_t item_id,
                                       std::vector<int32_t>* token_ids) const {
-  CHECK_EQ(initialized_, true);
-  CHECK_NE(token_ids, nullptr);
-
-  auto iter = item_to_tokens_map_.find(item_id);
-  if (iter == item_to_tokens_map_.end()) {
-    return false;
-  }
-
-  std::copy(
-      iter->second.begin(), iter->second.end(), std::back_inserter(*token_ids));
-
-  return true;
+  return checked_snapshot()->get_tokens_by_item(item_id, token_ids);
 }
 
-const std::unordered_set<int32_t>&
-RecVocabDict::get_next_tokens_by_prefix_tokens(
+std::vector<int32_t> RecVocabDict::get_next_tokens_by_prefix_tokens(
     const Slice<int32_t>& prefix_token_ids) const {
-  CHECK_EQ(initialized_, true);
-  CHECK_LT(prefix_token_ids.size(), REC_TOKEN_SIZE);
-
-  std::vector<int32_t> prefix_tokens_ids_vec = prefix_token_ids;
-  auto iter = prefix_tokens_to_next_tokens_map_.find(prefix_tokens_ids_vec);
-  if (iter == prefix_tokens_to_next_tokens_map_.end()) {
-    static std::unordered_set<int32_t> empty_set;
-    return empty_set;
-  }
-
-  return iter->second;
+  const auto active = checked_snapshot();
+  Slice<int32_t> next_tokens =
+      active->get_next_tokens_by_prefix_tokens(prefix_token_ids);
+  return std::vector<int32_t>(next_tokens.begin(), next_tokens.end());
 }
 
 RecConstraintTables RecVocabDict::build_constraint_tables(
     int32_t vocab_size) const {
-  CHECK_EQ(initialized_, true);
-  CHECK_GT(vocab_size, 0);
-
-  RecConstraintTables tables;
-  tables.vocab_size = vocab_size;
-  tables.prefix1_offsets.assign(static_cast<size_t>(vocab_size) + 1, 0);
-  tables.prefix2_value_offsets.emplace_back(0);
-
-  if (tokens_to_item_infos_map_.empty()) {
-    return tables;
-  }
-
-  std::vector<RecTokenTriple> triples;
-  triples.reserve(tokens_to_item_infos_map_.size());
-  for (const auto& entry : tokens_to_item_infos_map_) {
-    const RecTokenTriple& tokens = entry.first;
-    check_token_id(tokens[0], vocab_size, "t0");
-    check_token_id(tokens[1], vocab_size, "t1");
-    check_token_id(tokens[2], vocab_size, "t2");
-    triples.emplace_back(tokens);
-  }
-
-  std::sort(triples.begin(), triples.end(), rec_token_triple_less);
-
-  int32_t previous_t0 = -1;
-  for (const RecTokenTriple& tokens : triples) {
-    if (tokens[0] != previous_t0) {
-      tables.first_token_ids.emplace_back(tokens[0]);
-      previous_t0 = tokens[0];
-    }
-  }
-  tables.max_first_degree = static_cast<int32_t>(tables.first_token_ids.size());
-
-  tables.prefix1_values.reserve(triples.size());
-  tables.prefix1_pair_keys.reserve(triples.size());
-  tables.prefix2_values.reserve(triples.size());
-  tables.prefix2_value_offsets.reserve(triples.size() + 1);
-
-  size_t triple_idx = 0;
-  for (int32_t t0 = 0; t0 < vocab_size; ++t0) {
-    const int32_t prefix1_begin =
-        static_cast<int32_t>(tables.prefix1_values.size());
-    tables.prefix1_offsets[static_cast<size_t>(t0)] = prefix1_begin;
-
-    while (triple_idx < triples.size() && triples[triple_idx][0] == t0) {
-      const int32_t t1 = triples[triple_idx][1];
-      tables.prefix1_values.emplace_back(t1);
-      tables.prefix1_pair_keys.emplace_back(
-          static_cast<int64_t>(t0) * static_cast<int64_t>(vocab_size) +
-          static_cast<int64_t>(t1));
-
-      const int32_t prefix2_begin =
-          static_cast<int32_t>(tables.prefix2_values.size());
-      int32_t previous_t2 = -1;
-      while (triple_idx < triples.size() && triples[triple_idx][0] == t0 &&
-             triples[triple_idx][1] == t1) {
-        const int32_t t2 = triples[triple_idx][2];
-        if (t2 != previous_t2) {
-          tables.prefix2_values.emplace_back(t2);
-          previous_t2 = t2;
-        }
-        ++triple_idx;
-      }
-
-      const int32_t prefix2_end =
-          static_cast<int32_t>(tables.prefix2_values.size());
-      tables.max_prefix2_degree =
-          std::max(tables.max_prefix2_degree, prefix2_end - prefix2_begin);
-      tables.prefix2_value_offsets.emplace_back(prefix2_end);
-    }
-
-    const int32_t prefix1_end =
-        static_cast<int32_t>(tables.prefix1_values.size());
-    tables.prefix1_offsets[static_cast<size_t>(t0) + 1] = prefix1_end;
-    tables.max_prefix1_degree =
-        std::max(tables.max_prefix1_degree, prefix1_end - prefix1_begin);
-  }
-
-  CHECK_EQ(triple_idx, triples.size());
-  CHECK_EQ(tables.prefix1_pair_keys.size(), tables.prefix1_values.size());
-  CHECK_EQ(tables.prefix2_value_offsets.size(),
-           tables.prefix1_values.size() + 1);
-  return tables;
+  return checked_snapshot()->build_constraint_tables(vocab_size);
 }
 
 }  // namespace xllm
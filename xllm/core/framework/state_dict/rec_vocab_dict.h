@@ -16,65 +16,79 @@ limitations under the License.
 
 #pragma once
 
-#include <boost/functional/hash.hpp>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
-#include <optional>
-#include <set>
+#include <filesystem>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "common/macros.h"
 #include "common/types.h"
+#include "rec_vocab_snapshot.h"
 #include "util/slice.h"
 
 namespace xllm {
 
-struct RecConstraintTables {
-  std::vector<int32_t> first_token_ids;
-
-  // prefix1_values[prefix1_offsets[t0]:prefix1_offsets[t0 + 1]] contains
-  // valid t1 tokens after prefix [t0].
-  std::vector<int32_t> prefix1_offsets;
-  std::vector<int32_t> prefix1_values;
-  // Globally sorted keys aligned with prefix1_values and prefix2_value_offsets.
-  // key = int64_t(t0) * vocab_size + int64_t(t1).
-  std::vector<int64_t> prefix1_pair_keys;
-
-  // prefix2_value_offsets[i:i + 1] is aligned with prefix1_values[i].
-  // It contains valid t2 tokens after prefix [t0, prefix1_values[i]].
-  std::vector<int32_t> prefix2_value_offsets;
-  std::vector<int32_t> prefix2_values;
-
-  int32_t vocab_size = 0;
-  int32_t max_first_degree = 0;
-  int32_t max_prefix1_degree = 0;
-  int32_t max_prefix2_degree = 0;
-};
-
 // A vocab dictionary in generative recommendation scenarios, used for mapping
-// token IDs and item IDs, currently updated with the model version, and
-// real-time updates are not supported.
+// token IDs and item IDs.
+//
+// The catalog is an immutable RecVocabSnapshot published through an atomic
+// shared_ptr: readers never block, and a reload swaps in a new version while
+// requests holding the old snapshot keep using it until they release it.
 class RecVocabDict final {
  public:
   RecVocabDict() = default;
 
-  ~RecVocabDict() {
-    initialized_ = false;
-    item_to_tokens_map_.clear();
-    tokens_to_item_infos_map_.clear();
-    prefix_tokens_to_next_tokens_map_.clear();
-  }
+  ~RecVocabDict();
 
   /**
-   * @brief Initialize instance, parse vocab file
+   * @brief Initialize instance, parse vocab file. Both the legacy record
+   * format and the compact layout written by save_compact() are accepted.
+   * If rec_vocab_reload_interval_s is positive, the file is watched and
+   * reloaded when it changes.
    * @param vocab_file vocab file, need full path
    * @return true represents successful initialization, false represents failed
    * initialization
    */
   bool initialize(const std::string& vocab_file);
 
+  /**
+   * @brief Load a new catalog version and publish it atomically. On failure
+   * the current version stays active.
+   */
+  bool reload(const std::string& vocab_file);
+
+  // Write the active catalog in the compact, memory-mappable layout.
+  bool save_compact(const std::string& vocab_file) const;
+
+  // The active catalog. Hold on to it to keep lookups consistent across
+  // several calls, e.g. while building a batch of masks.
+  std::shared_ptr<const RecVocabSnapshot> snapshot() const {
+    return snapshot_.load(std::memory_order_acquire);
+  }
+
+  // Version of the active catalog, bumped by every successful reload.
+  uint64_t version() const;
+
+  // Catalog versions pinned by the requests in flight, so that the items of
+  // a request are looked up in the version its masks were built from. The
+  // first pin of a request wins and is returned. An empty request id can't
+  // be told apart from other requests and is never pinned.
+  std::shared_ptr<const RecVocabSnapshot> pin(
+      const std::string& request_id,
+      std::shared_ptr<const RecVocabSnapshot> snapshot);
+
+  // The version pinned by request_id, or nullptr if it holds none.
+  std::shared_ptr<const RecVocabSnapshot> pinned_snapshot(
+      const std::string& request_id) const;
+
+  void release(const std::vector<std::string>& request_ids);
+
   /**
    * @brief Get the corresponding item ID list through a token ID triplet
    * @param token_ids, a token ID triplet, so token_ids size must be three
@@ -107,34 +121,37 @@ class RecVocabDict final {
    * three
    * @attention if prefix_token_ids size is zero, will return all first token of
    * the token triplets
-   * @return  next token id list
+   * @return  sorted next token id list, copied out of the active catalog. Use
+   * snapshot() for zero-copy access on hot paths.
    */
-  const std::unordered_set<int32_t>& get_next_tokens_by_prefix_tokens(
+  std::vector<int32_t> get_next_tokens_by_prefix_tokens(
       const Slice<int32_t>& prefix_token_ids) const;
 
   RecConstraintTables build_constraint_tables(int32_t vocab_size) const;
 
  private:
-  // Check if initialization has been successful
-  bool initialized_ = false;
-
-  // Convert token to item map, key: token id triplet, value: item info list,
-  // there is a token id triplet corresponding to multiple items, and
-  // boost::hash<RecTokenTriple> will generate ordered triplet hash value.
-  std::unordered_map<RecTokenTriple,
-                     std::vector<RecItemInfo>,
-                     boost::hash<RecTokenTriple>>
-      tokens_to_item_infos_map_;
-
-  // Convert item to tokens map, key: item id, value: token triplet, there is a
-  // item id corresponding to a token id triplet
-  std::unordered_map<int64_t, RecTokenTriple> item_to_tokens_map_;
-
-  // Convert prifix tokens to next tokens map, key: prefix token id list, value:
-  // next token id list
-  std::unordered_map<std::vector<int32_t>,
-                     std::unordered_set<int32_t>,
-                     boost::hash<std::vector<int32_t>>>
-      prefix_tokens_to_next_tokens_map_;
+  std::shared_ptr<const RecVocabSnapshot> checked_snapshot() const;
+
+  void publish(std::shared_ptr<RecVocabSnapshot> snapshot);
+
+  // Poll the vocab file and reload it after it is renamed into place, or
+  // after an in-place change has held for two polls.
+  void watch_loop(std::string vocab_file, int32_t interval_s);
+
+ private:
+  std::atomic<std::shared_ptr<const RecVocabSnapshot>> snapshot_;
+
+  // serializes loaders, readers never take it.
+  std::mutex reload_mutex_;
+  uint64_t next_version_ = 1;
+
+  mutable std::mutex pins_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<const RecVocabSnapshot>>
+      pins_;
+
+  std::mutex watch_mutex_;
+  std::condition_variable watch_cv_;
+  bool stop_watch_ = false;
+  std::thread watch_thread_;
 };
 }  // namespace xllm
@@ -0,0 +1,698 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "rec_vocab_snapshot.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+namespace xllm {
+namespace {
+
+constexpr uint32_t kMaxExtendedFieldBytes = 1U << 20;
+
+constexpr char kCompactMagic[4] = {'X', 'R', 'V', 'D'};
+constexpr uint32_t kCompactVersion = 1;
+constexpr uint32_t kFlagItemStrings = 1U << 0;
+
+struct CompactHeader {
+  char magic[4];
+  uint32_t format_version;
+  uint32_t flags;
+  uint32_t reserved;
+  uint64_t num_records;
+  uint64_t num_triples;
+  uint64_t num_items;
+  uint64_t num_first_tokens;
+  uint64_t num_prefix1;
+  uint64_t string_blob_bytes;
+};
+static_assert(sizeof(CompactHeader) == 64);
+
+// byte offsets of every section, derived from the header counts.
+struct CompactLayout {
+  size_t triples = 0;
+  size_t triple_record_offsets = 0;
+  size_t record_item_ids = 0;
+  size_t record_string_offsets = 0;
+  size_t string_blob = 0;
+  size_t item_ids = 0;
+  size_t item_triple_index = 0;
+  size_t first_token_ids = 0;
+  size_t first_prefix1_offsets = 0;
+  size_t prefix1_values = 0;
+  size_t prefix1_prefix2_offsets = 0;
+  size_t prefix2_values = 0;
+  size_t total = 0;
+};
+
+size_t align8(size_t value) { return (value + 7) & ~static_cast<size_t>(7); }
+
+CompactLayout compute_layout(const CompactHeader& header) {
+  CompactLayout layout;
+  size_t offset = sizeof(CompactHeader);
+  auto place = [&offset](size_t* section, size_t bytes) {
+    *section = offset;
+    offset = align8(offset + bytes);
+  };
+  const bool has_strings = (header.flags & kFlagItemStrings) != 0;
+  place(&layout.triples,
+        header.num_triples * REC_TOKEN_SIZE * sizeof(int32_t));
+  place(&layout.triple_record_offsets,
+        (header.num_triples + 1) * sizeof(uint64_t));
+  place(&layout.record_item_ids, header.num_records * sizeof(int64_t));
+  place(&layout.record_string_offsets,
+        has_strings ? (2 * header.num_records + 1) * sizeof(uint64_t) : 0);
+  place(&layout.string_blob, has_strings ? header.string_blob_bytes : 0);
+  place(&layout.item_ids, header.num_items * sizeof(int64_t));
+  place(&layout.item_triple_index, header.num_items * sizeof(uint32_t));
+  place(&layout.first_token_ids, header.num_first_tokens * sizeof(int32_t));
+  place(&layout.first_prefix1_offsets,
+        (header.num_first_tokens + 1) * sizeof(uint32_t));
+  place(&layout.prefix1_values, header.num_prefix1 * sizeof(int32_t));
+  place(&layout.prefix1_prefix2_offsets,
+        (header.num_prefix1 + 1) * sizeof(uint32_t));
+  place(&layout.prefix2_values, header.num_triples * sizeof(int32_t));
+  layout.total = offset;
+  return layout;
+}
+
+template <typename T>
+std::span<const T> section(const char* data, size_t offset, size_t count) {
+  return std::span<const T>(reinterpret_cast<const T*>(data + offset), count);
+}
+
+template <typename T>
+void copy_section(char* data, size_t offset, const std::vector<T>& values) {
+  if (!values.empty()) {
+    std::memcpy(data + offset, values.data(), values.size() * sizeof(T));
+  }
+}
+
+// offsets must start at 0, never decrease and end at end_value.
+template <typename T>
+bool valid_offsets(std::span<const T> offsets, uint64_t end_value) {
+  if (offsets.empty() || offsets.front() != 0 || offsets.back() != end_value) {
+    return false;
+  }
+  return std::is_sorted(offsets.begin(), offsets.end());
+}
+
+bool triple_less(const RecTokenTriple& lhs, const RecTokenTriple& rhs) {
+  if (lhs[0] != rhs[0]) {
+    return lhs[0] < rhs[0];
+  }
+  if (lhs[1] != rhs[1]) {
+    return lhs[1] < rhs[1];
+  }
+  return lhs[2] < rhs[2];
+}
+
+void check_token_id(int32_t token_id, int32_t vocab_size, const char* name) {
+  CHECK_GE(token_id, 0) << "Invalid OneRec " << name
+                        << " token id: " << token_id;
+  CHECK_LT(token_id, vocab_size)
+      << "OneRec " << name << " token id " << token_id << " exceeds vocab_size "
+      << vocab_size;
+}
+
+bool parse_legacy_vocab_file(const std::string& vocab_file,
+                             bool extended_item_info,
+                             std::vector<RecVocabRecord>* records) {
+  std::ifstream ifs(vocab_file.data(), std::ios::binary | std::ios::ate);
+  if (!ifs.is_open()) {
+    LOG(ERROR) << "Fail to load content data file: " << vocab_file;
+    return false;
+  }
+
+  const std::streamoff file_end = ifs.tellg();
+  if (file_end < 0) {
+    LOG(ERROR) << "Failed to read content data file size: " << vocab_file;
+    return false;
+  }
+  const size_t file_size = static_cast<size_t>(file_end);
+  ifs.seekg(0, std::ios::beg);
+
+  const size_t itemid_size = sizeof(int64_t);
+  const size_t tokens_size = REC_TOKEN_SIZE * sizeof(int32_t);
+  records->reserve(file_size / (itemid_size + tokens_size));
+
+  auto fail_with_error = [&](const std::string& message) {
+    LOG(ERROR) << message;
+    records->clear();
+    return false;
+  };
+  auto get_remaining_bytes = [&ifs, file_size]() -> size_t {
+    const std::streamoff current_pos = ifs.tellg();
+    if (current_pos < 0) {
+      return 0;
+    }
+    const size_t current_offset = static_cast<size_t>(current_pos);
+    return current_offset <= file_size ? file_size - current_offset : 0;
+  };
+  auto read_extended_field = [&](const char* field_name, std::string* value) {
+    uint32_t field_length = 0;
+    if (!ifs.read(reinterpret_cast<char*>(&field_length), sizeof(uint32_t))) {
+      return fail_with_error(std::string("Failed to read ") + field_name +
+                             " length from " + vocab_file);
+    }
+    if (field_length > kMaxExtendedFieldBytes) {
+      return fail_with_error(std::string("Field length for ") + field_name +
+                             " exceeds limit in " + vocab_file);
+    }
+    if (static_cast<size_t>(field_length) > get_remaining_bytes()) {
+      return fail_with_error(std::string("Field length for ") + field_name +
+                             " exceeds remaining bytes in " + vocab_file);
+    }
+    value->resize(field_length);
+    if (field_length > 0 && !ifs.read(value->data(), field_length)) {
+      return fail_with_error(std::string("Failed to read ") + field_name +
+                             " string from " + vocab_file);
+    }
+    return true;
+  };
+
+  RecVocabRecord record;
+  if (!extended_item_info) {
+    while (ifs.read(reinterpret_cast<char*>(&record.item_id), itemid_size) &&
+           ifs.read(reinterpret_cast<char*>(record.tokens.data()),
+                    tokens_size)) {
+      records->emplace_back(record);
+    }
+
+    if (ifs.gcount() != 0 &&
+        ifs.gcount() != static_cast<std::streamsize>(tokens_size)) {
+      return fail_with_error("Possibly containing incomplete lines : " +
+                             vocab_file);
+    }
+  } else {
+    while (ifs.read(reinterpret_cast<char*>(&record.item_id), itemid_size)) {
+      if (!read_extended_field("did", &record.did) ||
+          !read_extended_field("type", &record.type)) {
+        return false;
+      }
+      if (!ifs.read(reinterpret_cast<char*>(record.tokens.data()),
+                    tokens_size)) {
+        return fail_with_error("Failed to read token ids from " + vocab_file);
+      }
+      records->emplace_back(record);
+    }
+
+    if (ifs.gcount() > 0 || (!ifs.eof() && ifs.fail())) {
+      return fail_with_error("Failed while reading " + vocab_file);
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+std::shared_ptr<RecVocabSnapshot> RecVocabSnapshot::build(
+    const std::vector<RecVocabRecord>& records,
+    bool has_item_strings) {
+  CHECK_LT(records.size(), std::numeric_limits<uint32_t>::max())
+      << "Too many rec vocab records: " << records.size();
+
+  // group records by triple, keeping file order within a triple.
+  std::vector<uint32_t> by_triple(records.size());
+  std::iota(by_triple.begin(), by_triple.end(), 0);
+  std::stable_sort(
+      by_triple.begin(), by_triple.end(), [&records](uint32_t a, uint32_t b) {
+        return triple_less(records[a].tokens, records[b].tokens);
+      });
+
+  std::vector<int32_t> triples;
+  std::vector<uint64_t> triple_record_offsets = {0};
+  std::vector<int64_t> record_item_ids;
+  std::vector<uint64_t> record_string_offsets;
+  std::string string_blob;
+  std::vector<uint32_t> record_triple(records.size());
+  record_item_ids.reserve(records.size());
+  if (has_item_strings) {
+    record_string_offsets.reserve(2 * records.size() + 1);
+    record_string_offsets.emplace_back(0);
+  }
+  for (size_t i = 0; i < by_triple.size(); ++i) {
+    const RecVocabRecord& record = records[by_triple[i]];
+    if (i == 0 || records[by_triple[i - 1]].tokens != record.tokens) {
+      if (i > 0) {
+        triple_record_offsets.emplace_back(record_item_ids.size());
+      }
+      triples.insert(triples.end(), record.tokens.begin(), record.tokens.end());
+    }
+    record_triple[by_triple[i]] =
+        static_cast<uint32_t>(triples.size() / REC_TOKEN_SIZE - 1);
+    record_item_ids.emplace_back(record.item_id);
+    if (has_item_strings) {
+      string_blob += record.did;
+      record_string_offsets.emplace_back(string_blob.size());
+      string_blob += record.type;
+      record_string_offsets.emplace_back(string_blob.size());
+    }
+  }
+  const size_t num_triples = triples.size() / REC_TOKEN_SIZE;
+  if (num_triples > 0) {
+    triple_record_offsets.emplace_back(record_item_ids.size());
+  }
+
+  // a repeated item id keeps the triple of its last record.
+  std::vector<uint32_t> by_item(records.size());
+  std::iota(by_item.begin(), by_item.end(), 0);
+  std::stable_sort(
+      by_item.begin(), by_item.end(), [&records](uint32_t a, uint32_t b) {
+        return records[a].item_id < records[b].item_id;
+      });
+  std::vector<int64_t> item_ids;
+  std::vector<uint32_t> item_triple_index;
+  for (size_t i = 0; i < by_item.size(); ++i) {
+    const bool last_of_item =
+        i + 1 == by_item.size() ||
+        records[by_item[i + 1]].item_id != records[by_item[i]].item_id;
+    if (last_of_item) {
+      item_ids.emplace_back(records[by_item[i]].item_id);
+      item_triple_index.emplace_back(record_triple[by_item[i]]);
+    }
+  }
+
+  // prefix tree over the sorted unique triples.
+  std::vector<int32_t> first_token_ids;
+  std::vector<uint32_t> first_prefix1_offsets = {0};
+  std::vector<int32_t> prefix1_values;
+  std::vector<uint32_t> prefix1_prefix2_offsets = {0};
+  std::vector<int32_t> prefix2_values;
+  prefix2_values.reserve(num_triples);
+  for (size_t i = 0; i < num_triples; ++i) {
+    const int32_t* tokens = triples.data() + i * REC_TOKEN_SIZE;
+    const bool new_t0 = i == 0 || tokens[0] != tokens[-REC_TOKEN_SIZE];
+    const bool new_t1 = new_t0 || tokens[1] != tokens[1 - REC_TOKEN_SIZE];
+    if (new_t1 && i > 0) {
+      prefix1_prefix2_offsets.emplace_back(prefix2_values.size());
+    }
+    if (new_t0) {
+      if (i > 0) {
+        first_prefix1_offsets.emplace_back(prefix1_values.size());
+      }
+      first_token_ids.emplace_back(tokens[0]);
+    }
+    if (new_t1) {
+      prefix1_values.emplace_back(tokens[1]);
+    }
+    prefix2_values.emplace_back(tokens[2]);
+  }
+  if (num_triples > 0) {
+    prefix1_prefix2_offsets.emplace_back(prefix2_values.size());
+    first_prefix1_offsets.emplace_back(prefix1_values.size());
+  }
+
+  CompactHeader header;
+  std::memcpy(header.magic, kCompactMagic, sizeof(kCompactMagic));
+  header.format_version = kCompactVersion;
+  header.flags = has_item_strings ? kFlagItemStrings : 0;
+  header.reserved = 0;
+  header.num_records = record_item_ids.size();
+  header.num_triples = num_triples;
+  header.num_items = item_ids.size();
+  header.num_first_tokens = first_token_ids.size();
+  header.num_prefix1 = prefix1_values.size();
+  header.string_blob_bytes = string_blob.size();
+  const CompactLayout layout = compute_layout(header);
+
+  auto snapshot = std::shared_ptr<RecVocabSnapshot>(new RecVocabSnapshot());
+  snapshot->owned_.assign(layout.total / sizeof(uint64_t), 0);
+  char* data = reinterpret_cast<char*>(snapshot->owned_.data());
+  std::memcpy(data, &header, sizeof(header));
+  copy_section(data, layout.triples, triples);
+  copy_section(data, layout.triple_record_offsets, triple_record_offsets);
+  copy_section(data, layout.record_item_ids, record_item_ids);
+  copy_section(data, layout.record_string_offsets, record_string_offsets);
+  if (!string_blob.empty()) {
+    std::memcpy(
+        data + layout.string_blob, string_blob.data(), string_blob.size());
+  }
+  copy_section(data, layout.item_ids, item_ids);
+  copy_section(data, layout.item_triple_index, item_triple_index);
+  copy_section(data, layout.first_token_ids, first_token_ids);
+  copy_section(data, layout.first_prefix1_offsets, first_prefix1_offsets);
+  copy_section(data, layout.prefix1_values, prefix1_values);
+  copy_section(data, layout.prefix1_prefix2_offsets, prefix1_prefix2_offsets);
+  copy_section(data, layout.prefix2_values, prefix2_values);
+
+  snapshot->data_ = data;
+  snapshot->data_size_ = layout.total;
+  CHECK(snapshot->bind_sections(/*validate=*/false));
+  return snapshot;
+}
+
+std::shared_ptr<RecVocabSnapshot> RecVocabSnapshot::load(
+    const std::string& vocab_file,
+    bool extended_item_info) {
+  if (vocab_file.empty()) {
+    LOG(ERROR) << "Content data file is empty, file: " << vocab_file;
+    return nullptr;
+  }
+  if (!std::filesystem::exists(vocab_file)) {
+    LOG(ERROR) << "Fail to find content data file: " << vocab_file;
+    return nullptr;
+  }
+
+  if (!is_compact_file(vocab_file)) {
+    std::vector<RecVocabRecord> records;
+    if (!parse_legacy_vocab_file(vocab_file, extended_item_info, &records)) {
+      return nullptr;
+    }
+    return build(records, extended_item_info);
+  }
+
+  // read into memory rather than mapped: a mapping of the live file would
+  // fault if the file were truncated or rewritten in place.
+  std::ifstream ifs(vocab_file, std::ios::binary | std::ios::ate);
+  if (!ifs.is_open()) {
+    LOG(ERROR) << "Fail to open compact vocab file: " << vocab_file;
+    return nullptr;
+  }
+  const std::streamoff file_size = ifs.tellg();
+  if (file_size < 0) {
+    LOG(ERROR) << "Failed to get file size for compact vocab file: "
+               << vocab_file;
+    return nullptr;
+  }
+
+  auto snapshot = std::shared_ptr<RecVocabSnapshot>(new RecVocabSnapshot());
+  snapshot->owned_.assign(
+      (static_cast<size_t>(file_size) + sizeof(uint64_t) - 1) /
+          sizeof(uint64_t),
+      0);
+  ifs.seekg(0);
+  if (!ifs.read(reinterpret_cast<char*>(snapshot->owned_.data()),
+                static_cast<std::streamsize>(file_size))) {
+    LOG(ERROR) << "Failed to read compact vocab file: " << vocab_file;
+    return nullptr;
+  }
+  snapshot->data_ = reinterpret_cast<const char*>(snapshot->owned_.data());
+  snapshot->data_size_ = static_cast<size_t>(file_size);
+  if (!snapshot->bind_sections(/*validate=*/true)) {
+    LOG(ERROR) << "Corrupted compact vocab file: " << vocab_file;
+    return nullptr;
+  }
+  return snapshot;
+}
+
+bool RecVocabSnapshot::is_compact_file(const std::string& vocab_file) {
+  std::ifstream ifs(vocab_file, std::ios::binary);
+  char magic[sizeof(kCompactMagic)] = {};
+  return ifs.read(magic, sizeof(magic)) &&
+         std::memcmp(magic, kCompactMagic, sizeof(kCompactMagic)) == 0;
+}
+
+bool RecVocabSnapshot::save(const std::string& vocab_file) const {
+  const std::string tmp_file = vocab_file + ".tmp";
+  {
+    std::ofstream ofs(tmp_file, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+      LOG(ERROR) << "Failed to open compact vocab file for writing: "
+                 << tmp_file;
+      return false;
+    }
+    ofs.write(data_, static_cast<std::streamsize>(data_size_));
+    ofs.flush();
+    if (!ofs) {
+      LOG(ERROR) << "Failed to write compact vocab file: " << tmp_file;
+      std::remove(tmp_file.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp_file.c_str(), vocab_file.c_str()) != 0) {
+    LOG(ERROR) << "Failed to rename " << tmp_file << " to " << vocab_file
+               << ": " << std::strerror(errno);
+    std::remove(tmp_file.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool RecVocabSnapshot::bind_sections(bool validate) {
+  if (data_size_ < sizeof(CompactHeader)) {
+    return false;
+  }
+  CompactHeader header;
+  std::memcpy(&header, data_, sizeof(header));
+  if (std::memcmp(header.magic, kCompactMagic, sizeof(kCompactMagic)) != 0 ||
+      header.format_version != kCompactVersion) {
+    return false;
+  }
+  // reject counts whose section sizes could overflow the layout math.
+  constexpr uint64_t kMaxCount = uint64_t{1} << 40;
+  if (header.num_records > kMaxCount || header.num_triples > kMaxCount ||
+      header.num_items > kMaxCount || header.num_first_tokens > kMaxCount ||
+      header.num_prefix1 > kMaxCount || header.string_blob_bytes > kMaxCount) {
+    return false;
+  }
+  const CompactLayout layout = compute_layout(header);
+  if (layout.total > data_size_) {
+    return false;
+  }
+
+  const bool has_strings = (header.flags & kFlagItemStrings) != 0;
+  triples_ = section<int32_t>(
+      data_, layout.triples, header.num_triples * REC_TOKEN_SIZE);
+  triple_record_offsets_ = section<uint64_t>(
+      data_, layout.triple_record_offsets, header.num_triples + 1);
+  record_item_ids_ =
+      section<int64_t>(data_, layout.record_item_ids, header.num_records);
+  record_string_offsets_ =
+      section<uint64_t>(data_,
+                        layout.record_string_offsets,
+                        has_strings ? 2 * header.num_records + 1 : 0);
+  string_blob_ = section<char>(
+      data_, layout.string_blob, has_strings ? header.string_blob_bytes : 0);
+  item_ids_ = section<int64_t>(data_, layout.item_ids, header.num_items);
+  item_triple_index_ =
+      section<uint32_t>(data_, layout.item_triple_index, header.num_items);
+  first_token_ids_ = section<int32_t>(
+      data_, layout.first_token_ids, header.num_first_tokens);
+  first_prefix1_offsets_ = section<uint32_t>(
+      data_, layout.first_prefix1_offsets, header.num_first_tokens + 1);
+  prefix1_values_ =
+      section<int32_t>(data_, layout.prefix1_values, header.num_prefix1);
+  prefix1_prefix2_offsets_ = section<uint32_t>(
+      data_, layout.prefix1_prefix2_offsets, header.num_prefix1 + 1);
+  prefix2_values_ =
+      section<int32_t>(data_, layout.prefix2_values, header.num_triples);
+
+  if (!validate) {
+    return true;
+  }
+  // only offsets and indices are checked, they are what bounds every read.
+  if (!valid_offsets(triple_record_offsets_, header.num_records) ||
+      !valid_offsets(first_prefix1_offsets_, header.num_prefix1) ||
+      !valid_offsets(prefix1_prefix2_offsets_, header.num_triples)) {
+    return false;
+  }
+  if (has_strings &&
+      !valid_offsets(record_string_offsets_, header.string_blob_bytes)) {
+    return false;
+  }
+  return std::all_of(item_triple_index_.begin(),
+                     item_triple_index_.end(),
+                     [&header](uint32_t index) {
+                       return index < header.num_triples;
+                     });
+}
+
+int64_t RecVocabSnapshot::find_triple(
+    const RecTokenTriple& rec_token_triple) const {
+  size_t lo = 0;
+  size_t hi = num_triples();
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    RecTokenTriple probe;
+    std::copy_n(
+        triples_.begin() + mid * REC_TOKEN_SIZE, REC_TOKEN_SIZE, probe.begin());
+    if (triple_less(probe, rec_token_triple)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  if (lo == num_triples() ||
+      !std::equal(rec_token_triple.begin(),
+                  rec_token_triple.end(),
+                  triples_.begin() + lo * REC_TOKEN_SIZE)) {
+    return -1;
+  }
+  return static_cast<int64_t>(lo);
+}
+
+std::string_view RecVocabSnapshot::record_string(size_t index) const {
+  const uint64_t begin = record_string_offsets_[index];
+  const uint64_t end = record_string_offsets_[index + 1];
+  return std::string_view(string_blob_.data() + begin, end - begin);
+}
+
+bool RecVocabSnapshot::get_items_by_tokens(
+    const RecTokenTriple& rec_token_triple,
+    std::vector<int64_t>* item_ids) const {
+  CHECK_NE(item_ids, nullptr);
+  const int64_t triple = find_triple(rec_token_triple);
+  if (triple < 0) {
+    return false;
+  }
+  const uint64_t begin = triple_record_offsets_[triple];
+  const uint64_t end = triple_record_offsets_[triple + 1];
+  item_ids->insert(item_ids->end(),
+                   record_item_ids_.begin() + begin,
+                   record_item_ids_.begin() + end);
+  return true;
+}
+
+bool RecVocabSnapshot::get_item_infos_by_tokens(
+    const RecTokenTriple& rec_token_triple,
+    std::vector<RecItemInfo>* item_infos) const {
+  CHECK_NE(item_infos, nullptr);
+  const int64_t triple = find_triple(rec_token_triple);
+  if (triple < 0) {
+    return false;
+  }
+  const uint64_t begin = triple_record_offsets_[triple];
+  const uint64_t end = triple_record_offsets_[triple + 1];
+  item_infos->reserve(item_infos->size() + (end - begin));
+  for (uint64_t record = begin; record < end; ++record) {
+    RecItemInfo item_info;
+    item_info.item_id = record_item_ids_[record];
+    if (has_item_strings()) {
+      item_info.did = std::string(record_string(2 * record));
+      item_info.type = std::string(record_string(2 * record + 1));
+    }
+    item_infos->emplace_back(std::move(item_info));
+  }
+  return true;
+}
+
+bool RecVocabSnapshot::get_tokens_by_item(
+    int64_t item_id,
+    std::vector<int32_t>* token_ids) const {
+  CHECK_NE(token_ids, nullptr);
+  auto it = std::lower_bound(item_ids_.begin(), item_ids_.end(), item_id);
+  if (it == item_ids_.end() || *it != item_id) {
+    return false;
+  }
+  const size_t triple = item_triple_index_[it - item_ids_.begin()];
+  auto tokens = triples_.begin() + triple * REC_TOKEN_SIZE;
+  token_ids->insert(token_ids->end(), tokens, tokens + REC_TOKEN_SIZE);
+  return true;
+}
+
+Slice<int32_t> RecVocabSnapshot::get_next_tokens_by_prefix_tokens(
+    const Slice<int32_t>& prefix_token_ids) const {
+  CHECK_LT(prefix_token_ids.size(), REC_TOKEN_SIZE);
+
+  if (prefix_token_ids.empty()) {
+    return {first_token_ids_.data(), first_token_ids_.size()};
+  }
+
+  auto first = std::lower_bound(
+      first_token_ids_.begin(), first_token_ids_.end(), prefix_token_ids[0]);
+  if (first == first_token_ids_.end() || *first != prefix_token_ids[0]) {
+    return {};
+  }
+  const size_t first_idx = first - first_token_ids_.begin();
+  const uint32_t prefix1_begin = first_prefix1_offsets_[first_idx];
+  const uint32_t prefix1_end = first_prefix1_offsets_[first_idx + 1];
+  if (prefix_token_ids.size() == 1) {
+    return {prefix1_values_.data() + prefix1_begin,
+            prefix1_end - prefix1_begin};
+  }
+
+  auto prefix1_first = prefix1_values_.begin() + prefix1_begin;
+  auto prefix1_last = prefix1_values_.begin() + prefix1_end;
+  auto second =
+      std::lower_bound(prefix1_first, prefix1_last, prefix_token_ids[1]);
+  if (second == prefix1_last || *second != prefix_token_ids[1]) {
+    return {};
+  }
+  const size_t prefix1_idx = second - prefix1_values_.begin();
+  const uint32_t prefix2_begin = prefix1_prefix2_offsets_[prefix1_idx];
+  const uint32_t prefix2_end = prefix1_prefix2_offsets_[prefix1_idx + 1];
+  return {prefix2_values_.data() + prefix2_begin, prefix2_end - prefix2_begin};
+}
+
+RecConstraintTables RecVocabSnapshot::build_constraint_tables(
+    int32_t vocab_size) const {
+  CHECK_GT(vocab_size, 0);
+  CHECK_LT(num_triples(),
+           static_cast<size_t>(std::numeric_limits<int32_t>::max()));
+
+  RecConstraintTables tables;
+  tables.vocab_size = vocab_size;
+  tables.prefix1_offsets.assign(static_cast<size_t>(vocab_size) + 1, 0);
+  tables.first_token_ids.assign(first_token_ids_.begin(),
+                                first_token_ids_.end());
+  tables.max_first_degree = static_cast<int32_t>(first_token_ids_.size());
+  tables.prefix1_values.assign(prefix1_values_.begin(), prefix1_values_.end());
+  tables.prefix2_value_offsets.assign(prefix1_prefix2_offsets_.begin(),
+                                      prefix1_prefix2_offsets_.end());
+  tables.prefix2_values.assign(prefix2_values_.begin(), prefix2_values_.end());
+  tables.prefix1_pair_keys.reserve(prefix1_values_.size());
+
+  for (const int32_t t2 : prefix2_values_) {
+    check_token_id(t2, vocab_size, "t2");
+  }
+  for (size_t i = 0; i < first_token_ids_.size(); ++i) {
+    const int32_t t0 = first_token_ids_[i];
+    check_token_id(t0, vocab_size, "t0");
+    const uint32_t prefix1_begin = first_prefix1_offsets_[i];
+    const uint32_t prefix1_end = first_prefix1_offsets_[i + 1];
+    tables.max_prefix1_degree = std::max<int32_t>(
+        tables.max_prefix1_degree, prefix1_end - prefix1_begin);
+    for (uint32_t j = prefix1_begin; j < prefix1_end; ++j) {
+      const int32_t t1 = prefix1_values_[j];
+      check_token_id(t1, vocab_size, "t1");
+      tables.prefix1_pair_keys.emplace_back(
+          static_cast<int64_t>(t0) * static_cast<int64_t>(vocab_size) +
+          static_cast<int64_t>(t1));
+      tables.max_prefix2_degree = std::max<int32_t>(
+          tables.max_prefix2_degree,
+          prefix1_prefix2_offsets_[j + 1] - prefix1_prefix2_offsets_[j]);
+    }
+  }
+
+  // expand the sparse first-token index into a dense per-t0 offset table.
+  size_t first_idx = 0;
+  int32_t offset = 0;
+  for (int32_t t0 = 0; t0 < vocab_size; ++t0) {
+    tables.prefix1_offsets[static_cast<size_t>(t0)] = offset;
+    if (first_idx < first_token_ids_.size() &&
+        first_token_ids_[first_idx] == t0) {
+      offset = static_cast<int32_t>(first_prefix1_offsets_[first_idx + 1]);
+      ++first_idx;
+    }
+  }
+  tables.prefix1_offsets[static_cast<size_t>(vocab_size)] = offset;
+
+  CHECK_EQ(tables.prefix1_pair_keys.size(), tables.prefix1_values.size());
+  CHECK_EQ(tables.prefix2_value_offsets.size(),
+           tables.prefix1_values.size() + 1);
+  return tables;
+}
+
+}  // namespace xllm
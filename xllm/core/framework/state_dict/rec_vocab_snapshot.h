@@ -0,0 +1,156 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/types.h"
+#include "util/slice.h"
+
+namespace xllm {
+
+struct RecConstraintTables {
+  std::vector<int32_t> first_token_ids;
+
+  // prefix1_values[prefix1_offsets[t0]:prefix1_offsets[t0 + 1]] contains
+  // valid t1 tokens after prefix [t0].
+  std::vector<int32_t> prefix1_offsets;
+  std::vector<int32_t> prefix1_values;
+  // Globally sorted keys aligned with prefix1_values and prefix2_value_offsets.
+  // key = int64_t(t0) * vocab_size + int64_t(t1).
+  std::vector<int64_t> prefix1_pair_keys;
+
+  // prefix2_value_offsets[i:i + 1] is aligned with prefix1_values[i].
+  // It contains valid t2 tokens after prefix [t0, prefix1_values[i]].
+  std::vector<int32_t> prefix2_value_offsets;
+  std::vector<int32_t> prefix2_values;
+
+  int32_t vocab_size = 0;
+  int32_t max_first_degree = 0;
+  int32_t max_prefix1_degree = 0;
+  int32_t max_prefix2_degree = 0;
+};
+
+// One record of the legacy vocab file.
+struct RecVocabRecord {
+  int64_t item_id = 0;
+  RecTokenTriple tokens = {0, 0, 0};
+  std::string did;
+  std::string type;
+};
+
+// An immutable version of the rec item catalog.
+//
+// All tables live in a single buffer with a sorted, CSR-style layout, so a
+// compact vocab file is read in one go without parsing, and lookups are
+// binary searches over flat arrays:
+//   header | triples | triple_record_offsets | record_item_ids |
+//   [record_string_offsets | string_blob] | item_ids | item_triple_index |
+//   first_token_ids | first_prefix1_offsets | prefix1_values |
+//   prefix1_prefix2_offsets | prefix2_values
+// Every section starts at an 8-byte boundary. Records sharing a token triple
+// keep their order in the source file, and a repeated item id keeps its last
+// triple, matching the legacy hash-map loader.
+class RecVocabSnapshot final {
+ public:
+  ~RecVocabSnapshot() = default;
+
+  DISALLOW_COPY_AND_ASSIGN(RecVocabSnapshot);
+
+  // Build from parsed records, e.g. a legacy vocab file.
+  static std::shared_ptr<RecVocabSnapshot> build(
+      const std::vector<RecVocabRecord>& records,
+      bool has_item_strings);
+
+  // Load a vocab file. Compact files are read as-is after their offsets are
+  // validated, legacy files are parsed and converted. Returns nullptr on
+  // failure.
+  static std::shared_ptr<RecVocabSnapshot> load(const std::string& vocab_file,
+                                                bool extended_item_info);
+
+  // Returns true if the file starts with the compact layout magic.
+  static bool is_compact_file(const std::string& vocab_file);
+
+  // Write the compact layout, atomically replacing vocab_file.
+  bool save(const std::string& vocab_file) const;
+
+  // Item ids mapped to the token triple, in file order.
+  bool get_items_by_tokens(const RecTokenTriple& rec_token_triple,
+                           std::vector<int64_t>* item_ids) const;
+
+  bool get_item_infos_by_tokens(const RecTokenTriple& rec_token_triple,
+                                std::vector<RecItemInfo>* item_infos) const;
+
+  bool get_tokens_by_item(int64_t item_id,
+                          std::vector<int32_t>* token_ids) const;
+
+  // Sorted valid next tokens after prefix_token_ids (size < REC_TOKEN_SIZE).
+  // The slice points into this snapshot and lives as long as it does.
+  Slice<int32_t> get_next_tokens_by_prefix_tokens(
+      const Slice<int32_t>& prefix_token_ids) const;
+
+  RecConstraintTables build_constraint_tables(int32_t vocab_size) const;
+
+  // Monotonic catalog version assigned by RecVocabDict when published.
+  uint64_t version() const { return version_; }
+  void set_version(uint64_t version) { version_ = version; }
+
+  size_t num_records() const { return record_item_ids_.size(); }
+  size_t num_items() const { return item_ids_.size(); }
+  size_t num_triples() const { return triples_.size() / REC_TOKEN_SIZE; }
+  bool has_item_strings() const { return !record_string_offsets_.empty(); }
+  size_t size_bytes() const { return data_size_; }
+
+ private:
+  RecVocabSnapshot() = default;
+
+  // Point the section views at data_, validating bounds when untrusted.
+  bool bind_sections(bool validate);
+
+  // Index of the triple in triples_, or -1.
+  int64_t find_triple(const RecTokenTriple& rec_token_triple) const;
+
+  std::string_view record_string(size_t index) const;
+
+ private:
+  uint64_t version_ = 0;
+
+  // backs data_, 8-byte aligned for the sections.
+  std::vector<uint64_t> owned_;
+  const char* data_ = nullptr;
+  size_t data_size_ = 0;
+
+  std::span<const int32_t> triples_;
+  std::span<const uint64_t> triple_record_offsets_;
+  std::span<const int64_t> record_item_ids_;
+  std::span<const uint64_t> record_string_offsets_;
+  std::span<const char> string_blob_;
+  std::span<const int64_t> item_ids_;
+  std::span<const uint32_t> item_triple_index_;
+  std::span<const int32_t> first_token_ids_;
+  std::span<const uint32_t> first_prefix1_offsets_;
+  std::span<const int32_t> prefix1_values_;
+  std::span<const uint32_t> prefix1_prefix2_offsets_;
+  std::span<const int32_t> prefix2_values_;
+};
+
+}  // namespace xllm
@@ -60,6 +60,44 @@ bool RecTokenizer::decode_item_infos(
       ->get_item_infos_by_tokens(rec_token_triple, item_infos);
 }
 
+bool RecTokenizer::decode(const Slice<int32_t>& token_ids,
+                          const std::string& request_id,
+                          std::vector<int64_t>* item_ids) const {
+  CHECK_EQ(token_ids.size(), REC_TOKEN_SIZE);
+
+  RecTokenTriple rec_token_triple;
+  std::copy(token_ids.begin(), token_ids.end(), rec_token_triple.begin());
+
+  return snapshot_for(request_id)->get_items_by_tokens(rec_token_triple,
+                                                       item_ids);
+}
+
+bool RecTokenizer::decode_item_infos(
+    const Slice<int32_t>& token_ids,
+    const std::string& request_id,
+    std::vector<RecItemInfo>* item_infos) const {
+  CHECK_EQ(token_ids.size(), REC_TOKEN_SIZE);
+
+  RecTokenTriple rec_token_triple;
+  std::copy(token_ids.begin(), token_ids.end(), rec_token_triple.begin());
+
+  return snapshot_for(request_id)->get_item_infos_by_tokens(rec_token_triple,
+                                                            item_infos);
+}
+
+std::shared_ptr<const RecVocabSnapshot> RecTokenizer::snapshot_for(
+    const std::string& request_id) const {
+  const RecVocabDict* vocab_dict =
+      VersionSingleton<RecVocabDict>::GetInstance(model_version_);
+  std::shared_ptr<const RecVocabSnapshot> snapshot =
+      request_id.empty() ? nullptr : vocab_dict->pinned_snapshot(request_id);
+  if (snapshot == nullptr) {
+    snapshot = vocab_dict->snapshot();
+  }
+  CHECK(snapshot != nullptr) << "RecVocabDict is not initialized";
+  return snapshot;
+}
+
 size_t RecTokenizer::vocab_size() const {
   // currently, there is no voice size set in the tokenizer configuration. The
   // voice size can be obtained from the model args
@@ -30,6 +30,8 @@ limitations under the License.
 
 namespace xllm {
 
+class RecVocabSnapshot;
+
 class RecTokenizer : public Tokenizer {
  public:
   RecTokenizer(const std::string_view& dir_path, const TokenizerArgs& args);
@@ -45,11 +47,25 @@ class RecTokenizer : public Tokenizer {
   bool decode_item_infos(const Slice<int32_t>& token_ids,
                          std::vector<RecItemInfo>* item_infos) const;
 
+  // Same as decode() and decode_item_infos(), looked up in the catalog
+  // version pinned by request_id, i.e. the one its constrained decoding
+  // masks were built from, or in the active version if it holds no pin.
+  bool decode(const Slice<int32_t>& token_ids,
+              const std::string& request_id,
+              std::vector<int64_t>* item_ids) const;
+
+  bool decode_item_infos(const Slice<int32_t>& token_ids,
+                         const std::string& request_id,
+                         std::vector<RecItemInfo>* item_infos) const;
+
   size_t vocab_size() const override;
 
   std::unique_ptr<Tokenizer> clone() const override;
 
  private:
+  std::shared_ptr<const RecVocabSnapshot> snapshot_for(
+      const std::string& request_id) const;
+
   TokenizerArgs args_;
 
   std::string dir_path_;
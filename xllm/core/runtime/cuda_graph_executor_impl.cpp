@@ -40,6 +40,7 @@ limitations under the License.
 #include "core/platform/shared_vmm_allocator.h"
 #include "core/platform/stream.h"
 #include "core/platform/vmm_torch_allocator.h"
+#include "core/runtime/decode_graph_bucket.h"
 #include "core/util/rec_model_utils.h"
 #include "core/util/utils.h"
 #include "kernels/cuda/global_capture_instance.h"
@@ -105,24 +106,13 @@ bool is_cuda_contiguous_int32_tensor(const torch::Tensor& tensor) {
 
 int64_t get_graph_bucket_num_tokens(int64_t num_tokens, bool is_prefill) {
   // no_padding only works for decode, prefill requires padding for graph reuse
-  if (::xllm::ExecutionConfig::get_instance()
-          .enable_graph_mode_decode_no_padding() &&
-      !is_prefill) {
-    return num_tokens;
-  }
-  if (num_tokens <= 1) {
-    return 1;
-  }
-  if (num_tokens <= 2) {
-    return 2;
-  }
-  if (num_tokens <= 4) {
-    return 4;
-  }
-  if (num_tokens <= 8) {
-    return 8;
+  if (is_prefill) {
+    return runtime::get_default_decode_graph_token_bucket(num_tokens);
   }
-  return ((num_tokens + 15) / 16) * 16;
+  return runtime::get_decode_graph_token_bucket(
+      num_tokens,
+      ::xllm::ExecutionConfig::get_instance()
+          .enable_graph_mode_decode_no_padding());
 }
 
 }  // namespace
@@ -27,6 +27,7 @@ limitations under the License.
 #include "core/framework/config/scheduler_config.h"
 #include "core/layers/common/attention_metadata.h"
 #include "core/layers/common/attention_metadata_builder.h"
+#include "core/runtime/decode_graph_bucket.h"
 #include "core/util/rec_model_utils.h"
 #include "core/util/utils.h"
 #include "kernels/dcu/attention_runner.h"
@@ -843,29 +844,10 @@ ForwardInput DcuGraphExecutorImpl::prepare_inputs(Batch& batch) {
 
 uint32_t DcuGraphExecutorImpl::get_bucket_num_tokens(
     uint32_t num_tokens) const {
-  if (::xllm::ExecutionConfig::get_instance()
-          .enable_graph_mode_decode_no_padding()) {
-    return num_tokens;
-  }
-
-  if (num_tokens <= 1) {
-    return 1;
-  }
-
-  if (num_tokens <= 2) {
-    return 2;
-  }
-
-  if (num_tokens <= 4) {
-    return 4;
-  }
-
-  if (num_tokens <= 8) {
-    return 8;
-  }
-
-  constexpr uint32_t kGraphStep = 16;
-  return ((num_tokens + kGraphStep - 1) / kGraphStep) * kGraphStep;
+  return static_cast<uint32_t>(runtime::get_decode_graph_token_bucket(
+      num_tokens,
+      ::xllm::ExecutionConfig::get_instance()
+          .enable_graph_mode_decode_no_padding()));
 }
 
 uint32_t DcuGraphExecutorImpl::get_graph_max_seq_len(
@@ -15,11 +15,23 @@ limitations under the License.
 
 #include "runtime/decode_graph_bucket.h"
 
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
 namespace xllm::runtime {
 namespace {
 
 constexpr int64_t kGraphTokenStep = 16;
 
+std::atomic<std::shared_ptr<const std::vector<int64_t>>>&
+adaptive_decode_graph_token_buckets() {
+  static std::atomic<std::shared_ptr<const std::vector<int64_t>>> buckets;
+  return buckets;
+}
+
 }  // namespace
 
 int64_t get_decode_graph_token_bucket(int64_t num_tokens,
@@ -27,6 +39,18 @@ int64_t get_decode_graph_token_bucket(int64_t num_tokens,
   if (enable_no_padding) {
     return num_tokens;
   }
+  const std::shared_ptr<const std::vector<int64_t>> buckets =
+      adaptive_decode_graph_token_buckets().load(std::memory_order_acquire);
+  if (buckets != nullptr) {
+    auto it = std::lower_bound(buckets->begin(), buckets->end(), num_tokens);
+    if (it != buckets->end()) {
+      return *it;
+    }
+  }
+  return get_default_decode_graph_token_bucket(num_tokens);
+}
+
+int64_t get_default_decode_graph_token_bucket(int64_t num_tokens) {
   if (num_tokens <= 1) {
     return 1;
   }
@@ -44,4 +68,149 @@ int64_t get_decode_graph_token_bucket(int64_t num_tokens,
          kGraphTokenStep;
 }
 
+std::vector<int64_t> get_default_decode_graph_token_buckets(
+    int64_t max_num_tokens) {
+  const int64_t max_bucket =
+      get_default_decode_graph_token_bucket(max_num_tokens);
+  std::vector<int64_t> buckets;
+  for (int64_t bucket = 1; bucket <= max_bucket;
+       bucket = get_default_decode_graph_token_bucket(bucket + 1)) {
+    buckets.push_back(bucket);
+  }
+  return buckets;
+}
+
+void set_adaptive_decode_graph_token_buckets(std::vector<int64_t> buckets) {
+  if (buckets.empty()) {
+    adaptive_decode_graph_token_buckets().store(nullptr,
+                                                std::memory_order_release);
+    return;
+  }
+  CHECK(std::is_sorted(buckets.begin(), buckets.end()));
+  for (int64_t bucket :
+       get_default_decode_graph_token_buckets(buckets.back())) {
+    CHECK(std::binary_search(buckets.begin(), buckets.end(), bucket))
+        << "Adaptive decode graph buckets miss default bucket " << bucket;
+  }
+  adaptive_decode_graph_token_buckets().store(
+      std::make_shared<const std::vector<int64_t>>(std::move(buckets)),
+      std::memory_order_release);
+}
+
+std::shared_ptr<const std::vector<int64_t>>
+get_adaptive_decode_graph_token_buckets() {
+  return adaptive_decode_graph_token_buckets().load(std::memory_order_acquire);
+}
+
+int64_t get_decode_graph_padding(const std::vector<int64_t>& counts,
+                                 const std::vector<int64_t>& buckets) {
+  int64_t padding = 0;
+  auto bucket = buckets.begin();
+  for (int64_t n = 1; n < static_cast<int64_t>(counts.size()); ++n) {
+    while (bucket != buckets.end() && *bucket < n) {
+      ++bucket;
+    }
+    if (bucket == buckets.end()) {
+      break;
+    }
+    padding += counts[n] * (*bucket - n);
+  }
+  return padding;
+}
+
+std::vector<int64_t> solve_decode_graph_token_buckets(
+    const std::vector<int64_t>& counts,
+    const std::vector<int64_t>& fixed_buckets,
+    int32_t max_new_buckets) {
+  CHECK(!fixed_buckets.empty());
+  CHECK(std::is_sorted(fixed_buckets.begin(), fixed_buckets.end()));
+  CHECK_GE(max_new_buckets, 0);
+  const int64_t max_bucket = fixed_buckets.back();
+
+  // Only observed sizes can be optimal bucket boundaries: moving a bucket
+  // down to the largest size it serves never adds padding.
+  std::vector<int64_t> candidates = fixed_buckets;
+  const int64_t max_observed =
+      std::min<int64_t>(static_cast<int64_t>(counts.size()) - 1, max_bucket);
+  for (int64_t n = 1; n <= max_observed; ++n) {
+    if (counts[n] > 0) {
+      candidates.push_back(n);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                   candidates.end());
+
+  // prefix sums of steps and token rows, so the padding of the sizes in
+  // (lo, hi] all served by bucket hi is hi * steps - rows.
+  std::vector<int64_t> steps(max_bucket + 1, 0);
+  std::vector<int64_t> rows(max_bucket + 1, 0);
+  for (int64_t n = 1; n <= max_bucket; ++n) {
+    const int64_t count = n <= max_observed ? counts[n] : 0;
+    steps[n] = steps[n - 1] + count;
+    rows[n] = rows[n - 1] + count * n;
+  }
+  const auto padding = [&](int64_t lo, int64_t hi) {
+    return hi * (steps[hi] - steps[lo]) - (rows[hi] - rows[lo]);
+  };
+
+  // best[j][k]: least padding of the sizes up to candidates[j] when
+  // candidates[j] is a bucket and k new buckets are used so far. Fixed
+  // buckets are always kept, so the previous bucket of j is never below the
+  // last fixed candidate before j; -1 stands for the empty prefix.
+  constexpr int64_t kInf = std::numeric_limits<int64_t>::max();
+  const int32_t num_candidates = static_cast<int32_t>(candidates.size());
+  const int32_t num_k = max_new_buckets + 1;
+  std::vector<int64_t> best(num_candidates * num_k, kInf);
+  std::vector<int32_t> parent(num_candidates * num_k, -1);
+  int32_t last_fixed = -1;
+  for (int32_t j = 0; j < num_candidates; ++j) {
+    const int64_t bucket = candidates[j];
+    const bool is_new = !std::binary_search(
+        fixed_buckets.begin(), fixed_buckets.end(), bucket);
+    for (int32_t k = is_new ? 1 : 0; k < num_k; ++k) {
+      const int32_t prev_k = is_new ? k - 1 : k;
+      for (int32_t i = last_fixed; i < j; ++i) {
+        int64_t prev = kInf;
+        if (i < 0) {
+          prev = prev_k == 0 ? 0 : kInf;
+        } else {
+          prev = best[i * num_k + prev_k];
+        }
+        if (prev == kInf) {
+          continue;
+        }
+        const int64_t cost = prev + padding(i < 0 ? 0 : candidates[i], bucket);
+        if (cost < best[j * num_k + k]) {
+          best[j * num_k + k] = cost;
+          parent[j * num_k + k] = i;
+        }
+      }
+    }
+    if (!is_new) {
+      last_fixed = j;
+    }
+  }
+
+  const int32_t last = num_candidates - 1;
+  int32_t best_k = 0;
+  for (int32_t k = 1; k < num_k; ++k) {
+    if (best[last * num_k + k] < best[last * num_k + best_k]) {
+      best_k = k;
+    }
+  }
+  std::vector<int64_t> buckets;
+  for (int32_t j = last, k = best_k; j >= 0;) {
+    buckets.push_back(candidates[j]);
+    const int32_t i = parent[j * num_k + k];
+    if (!std::binary_search(
+            fixed_buckets.begin(), fixed_buckets.end(), candidates[j])) {
+      --k;
+    }
+    j = i;
+  }
+  std::reverse(buckets.begin(), buckets.end());
+  return buckets;
+}
+
 }  // namespace xllm::runtime
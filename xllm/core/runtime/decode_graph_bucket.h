@@ -16,6 +16,8 @@ limitations under the License.
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 namespace xllm::runtime {
 
@@ -31,7 +33,44 @@ struct DecodeGraphExecutionShape {
 
 // Returns the padded token-row bucket shared by decode graph executors. When
 // no-padding mode is enabled each exact token count is its own graph shape.
+// Otherwise the smallest installed adaptive bucket that fits is used, falling
+// back to get_default_decode_graph_token_bucket().
 int64_t get_decode_graph_token_bucket(int64_t num_tokens,
                                       bool enable_no_padding);
 
+// The fixed bucket schedule: 1, 2, 4, 8, then multiples of 16.
+int64_t get_default_decode_graph_token_bucket(int64_t num_tokens);
+
+// Buckets of the fixed schedule up to and including
+// get_default_decode_graph_token_bucket(max_num_tokens).
+std::vector<int64_t> get_default_decode_graph_token_buckets(
+    int64_t max_num_tokens);
+
+// Installs process-wide decode buckets, sorted ascending. The set must contain
+// every default bucket up to its largest entry, so a token count never maps to
+// a bucket larger than its default one and graph buffers sized with the
+// default schedule stay large enough. All executors of the process read the
+// same set; install it only while no decode step is in flight. An empty set
+// restores the default schedule.
+void set_adaptive_decode_graph_token_buckets(std::vector<int64_t> buckets);
+
+std::shared_ptr<const std::vector<int64_t>>
+get_adaptive_decode_graph_token_buckets();
+
+// Token rows wasted by padding when counts[n] decode steps of n rows run with
+// `buckets`. Counts above the largest bucket are ignored.
+int64_t get_decode_graph_padding(const std::vector<int64_t>& counts,
+                                 const std::vector<int64_t>& buckets);
+
+// Chooses up to `max_new_buckets` buckets in addition to `fixed_buckets` that
+// minimize get_decode_graph_padding() for the histogram `counts`, where
+// counts[n] is the number of decode steps with n token rows. `fixed_buckets`
+// are already captured, so they are always kept, and their largest entry
+// bounds the covered range. Solved exactly by dynamic programming over the
+// observed sizes. Returns the sorted union of both sets.
+std::vector<int64_t> solve_decode_graph_token_buckets(
+    const std::vector<int64_t>& counts,
+    const std::vector<int64_t>& fixed_buckets,
+    int32_t max_new_buckets);
+
 }  // namespace xllm::runtime
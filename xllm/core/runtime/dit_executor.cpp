@@ -29,6 +29,9 @@ DiTForwardInput DiTExecutor::prepare_inputs(DiTBatch& batch) {
 }
 
 DiTForwardOutput DiTExecutor::forward(const DiTForwardInput& input) {
+  if (input.step_batching()) {
+    return model_->step(input);
+  }
   return model_->forward(input);
 }
 
@@ -276,6 +276,26 @@ struct DiTForwardInput {
 
   // generation params
   DiTGenerationParams generation_params;
+
+  // Step-level batching (dit_step_batching): every request in the batch is
+  // advanced by one denoising step. Joining requests start at this step and
+  // carry their inputs in the fields above, in order; running requests resume
+  // from the denoising state kept by the worker.
+  std::vector<std::string> joining_request_ids;
+
+  std::vector<std::string> running_request_ids;
+
+  // seed of every joining request, as requests may not share one
+  std::vector<int64_t> joining_seeds;
+
+  // requests that left the batch before their last step, e.g. on cancel;
+  // the worker drops their denoising state.
+  std::vector<std::string> released_request_ids;
+
+  bool step_batching() const {
+    return !joining_request_ids.empty() || !running_request_ids.empty() ||
+           !released_request_ids.empty();
+  }
 };
 
 // dit related forward output params
@@ -285,7 +305,8 @@ struct DiTForwardOutput {
       torch::save(tensors[0], prefix + "dit_images_cpp.pt");
     }
   }
-  // generated tensor (for image/audio models)
+  // generated tensor (for image/audio models). With step-level batching, one
+  // tensor per request finishing at this step, in batch order.
   std::vector<torch::Tensor> tensors;
   // generated text (for text diffusion models like Cola-DLM)
   std::vector<std::string> text_output;
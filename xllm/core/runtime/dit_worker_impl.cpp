@@ -22,6 +22,7 @@ limitations under the License.
 #include <torch/torch.h>
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <utility>
 
@@ -33,6 +34,7 @@ limitations under the License.
 #include "core/framework/dit_model_loader.h"
 #include "core/platform/device.h"
 #include "framework/dit_cache/dit_cache.h"
+#include "framework/encoder_cache/text_embedding_cache.h"
 #include "framework/state_dict/state_dict.h"
 #include "models/model_registry.h"
 #include "util/threadpool.h"
@@ -132,12 +134,27 @@ bool DiTWorkerImpl::init_model(const std::string& model_weights_path,
 
   dit_model_ = create_dit_model(dit_context_);
   CHECK(dit_model_ != nullptr) << "Failed to create model.";
+  if (::xllm::DiTConfig::get_instance().dit_step_batching()) {
+    CHECK(dit_model_->supports_step_batching())
+        << "dit_step_batching is not supported by model_type: " << model_type;
+    // the cache policies key their state on a single running step index.
+    CHECK(cache_config.selected_policy == PolicyType::None)
+        << "dit_step_batching requires --dit_cache_policy=None";
+  }
   dit_model_->load_model(std::move(loader));
 
   dit_model_executor_ =
       std::make_unique<DiTExecutor>(dit_model_.get(), options_);
 
   DiTCache::get_instance().init(cache_config, parallel_args_);
+  // the text embedding cache is shared by every worker of the process, so a
+  // worker must not wipe entries inserted by the others.
+  static std::once_flag text_embedding_cache_once;
+  std::call_once(text_embedding_cache_once, []() {
+    TextEmbeddingCache::get_instance().init(
+        ::xllm::DiTConfig::get_instance().dit_text_embedding_cache_size() *
+        1024 * 1024);
+  });
 
   return true;
 }
@@ -392,6 +392,11 @@ inline size_t get_dit_forward_input_size(const DiTForwardInput& input) {
   // Generation params
   size += get_dit_generation_params_size(input.generation_params);
 
+  size += get_string_vector_size(input.joining_request_ids);
+  size += get_string_vector_size(input.running_request_ids);
+  size += get_vector_size(input.joining_seeds);
+  size += get_string_vector_size(input.released_request_ids);
+
   return size;
 }
 
@@ -1128,6 +1133,11 @@ inline void write_dit_forward_input(char*& buffer,
   write_string(buffer, input.audio_prompt_text);
 
   write_dit_generation_params(buffer, input.generation_params);
+
+  write_string_vector(buffer, input.joining_request_ids);
+  write_string_vector(buffer, input.running_request_ids);
+  write_vector(buffer, input.joining_seeds);
+  write_string_vector(buffer, input.released_request_ids);
 }
 
 inline void write_dit_forward_input(RawInputSerializeContext& context,
@@ -1154,6 +1164,11 @@ inline void write_dit_forward_input(RawInputSerializeContext& context,
   write_string(context.descriptor, input.audio_prompt_text);
 
   write_dit_generation_params(context, input.generation_params);
+
+  write_string_vector(context.descriptor, input.joining_request_ids);
+  write_string_vector(context.descriptor, input.running_request_ids);
+  write_vector(context.descriptor, input.joining_seeds);
+  write_string_vector(context.descriptor, input.released_request_ids);
 }
 
 inline void write_dit_forward_output(char*& buffer,
@@ -2162,6 +2177,11 @@ inline void read_dit_forward_input(const char*& buffer,
   read_string(buffer, input.audio_prompt_text);
 
   read_dit_generation_params(buffer, input.generation_params);
+
+  read_string_vector(buffer, input.joining_request_ids);
+  read_string_vector(buffer, input.running_request_ids);
+  read_vector(buffer, input.joining_seeds);
+  read_string_vector(buffer, input.released_request_ids);
   if (stabilize_host_tensors) {
     stabilize_dit_forward_input_tensors(input);
   }
@@ -2228,6 +2248,11 @@ inline void read_dit_forward_input(ReadContext& context,
   read_string(context, input.audio_prompt_text);
 
   read_dit_generation_params(context, input.generation_params);
+
+  read_string_vector(context, input.joining_request_ids);
+  read_string_vector(context, input.running_request_ids);
+  read_vector(context, input.joining_seeds);
+  read_string_vector(context, input.released_request_ids);
   if (stabilize_host_tensors) {
     stabilize_dit_forward_input_tensors(input);
   }
@@ -2465,6 +2490,9 @@ inline void deserialize_forward_input_payload(
             .to(device, /*non_blocking=*/true);
   }
   read_string_vector(context, input_params.embedding.request_ids);
+  read_vector(context, input_params.embedding.history_token_ids);
+  read_vector(context, input_params.embedding.history_token_lens);
+  read_string_vector(context, input_params.embedding.released_request_ids);
   read_vector(context, input_params.embedding.extra_token_ids);
   // Keep upstream's root mtp_shifted_token_ids serialization (consumed by
   // non-CP MTP paths + minimax / qwen3-next models). The CP path additionally
@@ -2916,6 +2944,10 @@ inline void serialize_forward_input_sections(
   write_vector(context.descriptor, input_params.embedding.linear_state_ids);
   write_linear_state_cache_ops(context, input_params.linear_state_cache_ops);
   write_string_vector(context.descriptor, input_params.embedding.request_ids);
+  write_vector(context.descriptor, input_params.embedding.history_token_ids);
+  write_vector(context.descriptor, input_params.embedding.history_token_lens);
+  write_string_vector(context.descriptor,
+                      input_params.embedding.released_request_ids);
   write_vector(context.descriptor, input_params.embedding.extra_token_ids);
   // Mirror the read_* layout: write root + embedding mtp paths so the
   // deserializer sees both fields. Order MUST match the read_* sequence.
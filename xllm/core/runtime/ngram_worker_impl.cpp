@@ -0,0 +1,309 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "ngram_worker_impl.h"
+
+#include <algorithm>
+
+#include "common/metrics.h"
+#include "core/framework/eplb/eplb_utils.h"
+#include "core/framework/speculative/spec_verify.h"
+#include "util/slice.h"
+#include "util/timer.h"
+#include "util/utils.h"
+
+namespace xllm {
+
+namespace {
+runtime::Options NGramTargetOptions(const runtime::Options& options) {
+  auto opts = options;
+  opts.enable_schedule_overlap(false);
+  return opts;
+}
+}  // namespace
+
+NGramWorkerImpl::NGramWorkerImpl(const ParallelArgs& parallel_args,
+                                 const torch::Device& device,
+                                 const runtime::Options& options)
+    : SpeculativeWorkerImpl(parallel_args,
+                            device,
+                            options,
+                            NGramTargetOptions(options)),
+      ngram_indices_(options.speculative_ngram_min(),
+                     options.speculative_ngram_max()) {
+  CHECK_GT(options_.speculative_ngram_min(), 0)
+      << "speculative_ngram_min must be positive";
+  CHECK_GE(options_.speculative_ngram_max(), options_.speculative_ngram_min())
+      << "speculative_ngram_max must be >= speculative_ngram_min";
+}
+
+std::optional<ForwardOutput> NGramWorkerImpl::step_empty(
+    const ForwardInput& input) {
+  ngram_indices_.release(input.input_params.embedding.released_request_ids);
+  if (!input.input_params.meta.batch_forward_type.is_decode()) {
+    auto output = impl_->step(input);
+    output->sample_output.embeddings = torch::Tensor();
+    return output;
+  } else {
+    ForwardInput new_input = input;
+    for (auto& it : new_input.input_params.parallel.dp_global_token_nums) {
+      it *= options_.num_speculative_tokens() + 1;
+    }
+    new_input.input_params.expert.eplb_decode_token_mask =
+        eplb::expand_decode_token_mask(
+            new_input.input_params.expert.eplb_decode_token_mask,
+            options_.num_speculative_tokens() + 1);
+
+    auto future = impl_->step_async(new_input);
+    ForwardOutput output = std::move(future).get().value();
+    output.sample_output.embeddings = torch::Tensor();
+    return output;
+  }
+}
+
+std::optional<ForwardOutput> NGramWorkerImpl::step_prefill(
+    const ForwardInput& input) {
+  Timer timer;
+  auto future = impl_->step_async(input);
+  ForwardOutput output = std::move(future).get().value();
+  COUNTER_ADD(speculative_execution_latency_seconds_target,
+              timer.elapsed_seconds());
+
+  const auto& input_params = input.input_params;
+  const int32_t num_sequences = input_params.meta.num_sequences;
+  const auto& embedding = input_params.embedding;
+  ngram_indices_.release(embedding.released_request_ids);
+  // a prefill instance hands its requests to a decode instance, which builds
+  // its own indices.
+  const bool prefill_instance =
+      options_.enable_disagg_pd() &&
+      options_.instance_role() == InstanceRole::PREFILL;
+  // only rows that end their prefill carry a request id; earlier chunks are
+  // indexed through the history of the last one.
+  const std::vector<int32_t> rows =
+      prefill_instance ? std::vector<int32_t>()
+                       : map_request_rows(embedding.request_ids,
+                                          embedding.extra_token_ids,
+                                          num_sequences);
+
+  if (!rows.empty()) {
+    const bool has_history = embedding.history_token_lens.size() ==
+                             embedding.request_ids.size();
+    std::vector<size_t> history_offsets;
+    if (has_history) {
+      history_offsets.reserve(embedding.history_token_lens.size());
+      size_t offset = 0;
+      for (const int32_t len : embedding.history_token_lens) {
+        history_offsets.emplace_back(offset);
+        offset += std::max(len, 0);
+      }
+      CHECK_EQ(offset, embedding.history_token_ids.size());
+    }
+
+    const torch::Tensor& token_ids = input.token_ids_host;
+    Slice<int32_t> tokens_ids_slice = {token_ids.data_ptr<int32_t>(),
+                                       static_cast<size_t>(token_ids.numel())};
+
+    int32_t start_idx = 0;
+    for (int32_t seq_id = 0; seq_id < num_sequences; ++seq_id) {
+      int32_t q_len = input_params.get_q_seq_len(seq_id);
+      Slice<int32_t> seq_tokens =
+          tokens_ids_slice.slice(start_idx, start_idx + q_len);
+      start_idx += q_len;
+
+      const int32_t row = rows[seq_id];
+      if (row < 0 || embedding.request_ids[row].empty()) {
+        continue;
+      }
+      const std::string& req_id = embedding.request_ids[row];
+      if (!has_history) {
+        ngram_indices_.get_or_create(req_id).append(seq_tokens);
+        continue;
+      }
+      const int32_t history_len = embedding.history_token_lens[row];
+      // decode rows of a mixed batch keep their index.
+      if (history_len < 0) {
+        continue;
+      }
+      ngram_indices_.rebuild(
+          req_id,
+          std::span<const int32_t>(
+              embedding.history_token_ids.data() + history_offsets[row],
+              history_len),
+          seq_tokens);
+    }
+
+    torch::Tensor next_tokens =
+        safe_to(output.sample_output.next_tokens, torch::kCPU);
+    // next tokens come one per row, or one per row that ends its prefill.
+    if (next_tokens.defined() &&
+        (next_tokens.numel() == static_cast<int64_t>(num_sequences) ||
+         next_tokens.numel() ==
+             static_cast<int64_t>(embedding.request_ids.size()))) {
+      const bool per_row =
+          next_tokens.numel() == static_cast<int64_t>(num_sequences);
+      next_tokens = next_tokens.view({-1}).to(torch::kInt);
+      Slice<int32_t> next_tokens_slice = {
+          next_tokens.data_ptr<int32_t>(),
+          static_cast<size_t>(next_tokens.numel())};
+      for (int32_t seq_id = 0; seq_id < num_sequences; ++seq_id) {
+        const int32_t row = rows[seq_id];
+        if (row < 0 || embedding.request_ids[row].empty()) {
+          continue;
+        }
+        int32_t token = next_tokens_slice[per_row ? seq_id : row];
+        if (token < 0) {
+          continue;
+        }
+        ngram_indices_.get_or_create(embedding.request_ids[row])
+            .append(std::span<const int32_t>(&token, 1));
+      }
+    }
+  }
+
+  output.sample_output.embeddings = torch::Tensor();
+  if (!enable_schedule_overlap() && !driver_ && !dp_driver_) {
+    return std::nullopt;
+  }
+  return output;
+}
+
+std::optional<ForwardOutput> NGramWorkerImpl::step_decode(
+    const ForwardInput& input) {
+  const int32_t num_speculative_tokens = options_.num_speculative_tokens();
+  const int32_t num_sequences = input.input_params.meta.num_sequences;
+  const int32_t num_val_tokens = num_speculative_tokens + 1;
+  const auto& request_ids = input.input_params.embedding.request_ids;
+  const bool has_request_ids =
+      request_ids.size() == static_cast<size_t>(num_sequences);
+  ngram_indices_.release(input.input_params.embedding.released_request_ids);
+
+  const torch::Tensor& input_token_ids = input.token_ids_host;
+  Slice<int32_t> input_tokens_slice = {
+      input_token_ids.data_ptr<int32_t>(),
+      static_cast<size_t>(input_token_ids.numel())};
+
+  Timer timer;
+
+  // sequences without a match repeat the last token, which the target
+  // rejects at the first position.
+  std::vector<int32_t> draft_tokens_flat;
+  draft_tokens_flat.reserve(num_sequences * num_speculative_tokens);
+  int64_t num_hits = 0;
+  for (int32_t seq_id = 0; seq_id < num_sequences; ++seq_id) {
+    const int32_t fallback_token = input_tokens_slice[seq_id];
+    draft_tokens_flat.insert(
+        draft_tokens_flat.end(), num_speculative_tokens, fallback_token);
+    if (!has_request_ids || request_ids[seq_id].empty()) {
+      continue;
+    }
+
+    NGramIndex& index = ngram_indices_.get_or_create(request_ids[seq_id]);
+    if (index.num_tokens() == 0) {
+      index.append(std::span<const int32_t>(&fallback_token, 1));
+    }
+    std::vector<int32_t> draft = index.propose(num_speculative_tokens);
+    num_hits += draft.empty() ? 0 : 1;
+    std::copy(draft.begin(),
+              draft.end(),
+              draft_tokens_flat.begin() + seq_id * num_speculative_tokens);
+  }
+  VLOG(3) << "[ngram-draft] num_sequences=" << num_sequences
+          << " num_hits=" << num_hits;
+
+  ForwardInput validate_input;
+  prepare_validate_inputs(input, validate_input);
+  validate_input.skip_sampling_for_logits_only = true;
+
+  auto& validate_token_ids = validate_input.token_ids;
+  for (int32_t i = 0; i < num_speculative_tokens; ++i) {
+    std::vector<int32_t> draft_col;
+    draft_col.reserve(num_sequences);
+    for (int32_t seq_id = 0; seq_id < num_sequences; ++seq_id) {
+      draft_col.emplace_back(
+          draft_tokens_flat[seq_id * num_speculative_tokens + i]);
+    }
+    auto draft_col_tensor =
+        torch::tensor(draft_col, validate_token_ids.options());
+    auto mask = (validate_token_ids == -1 * (i + 1));
+    validate_token_ids.masked_scatter_(mask, draft_col_tensor);
+  }
+
+  COUNTER_ADD(speculative_execution_latency_seconds_draft,
+              timer.elapsed_seconds());
+
+  timer.reset();
+  auto future = impl_->step_async(validate_input);
+  ForwardOutput target_output = std::move(future).get().value();
+  COUNTER_ADD(speculative_execution_latency_seconds_target,
+              timer.elapsed_seconds());
+
+  torch::Tensor draft_token_ids =
+      torch::tensor(draft_tokens_flat,
+                    torch::TensorOptions().dtype(torch::kLong))
+          .view({num_sequences, num_speculative_tokens})
+          .to(target_output.logits.device());
+  // Greedy-only validation ignores draft_probs values, see SuffixWorkerImpl.
+  auto draft_probs = torch::empty({num_sequences, num_speculative_tokens, 1},
+                                  torch::TensorOptions()
+                                      .dtype(torch::kFloat32)
+                                      .device(target_output.logits.device()));
+
+  timer.reset();
+  // Prompt lookup drafts carry no probabilities, validate greedily.
+  SampleOutput val_output =
+      spec_verify::run_greedy_verification(draft_token_ids,
+                                           draft_probs,
+                                           target_output,
+                                           num_val_tokens,
+                                           enable_fused_kernel_);
+  COUNTER_ADD(speculative_execution_latency_seconds_validation,
+              timer.elapsed_seconds());
+
+  if (has_request_ids) {
+    torch::Tensor accepted_tokens =
+        safe_to(val_output.next_tokens, torch::kCPU).to(torch::kInt);
+    accepted_tokens = accepted_tokens.view({num_sequences, num_val_tokens});
+    Slice<int32_t> accepted_tokens_slice = {
+        accepted_tokens.data_ptr<int32_t>(),
+        static_cast<size_t>(accepted_tokens.numel())};
+
+    for (int32_t seq_id = 0; seq_id < num_sequences; ++seq_id) {
+      const std::string& req_id = request_ids[seq_id];
+      if (req_id.empty()) {
+        continue;
+      }
+      Slice<int32_t> row = accepted_tokens_slice.slice(
+          seq_id * num_val_tokens, (seq_id + 1) * num_val_tokens);
+      size_t num_accepted = 0;
+      while (num_accepted < row.size() && row[num_accepted] >= 0) {
+        ++num_accepted;
+      }
+      if (num_accepted > 0) {
+        ngram_indices_.get_or_create(req_id).append(
+            std::span<const int32_t>(row.data(), num_accepted));
+      }
+    }
+  }
+
+  if (!enable_schedule_overlap() && !driver_ && !dp_driver_) {
+    return std::nullopt;
+  }
+  val_output.embeddings = torch::Tensor();
+  target_output.sample_output = val_output;
+  return target_output;
+}
+
+}  // namespace xllm
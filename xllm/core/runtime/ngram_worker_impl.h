@@ -0,0 +1,45 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include "runtime/speculative_worker_impl.h"
+#include "util/ngram_index.h"
+
+namespace xllm {
+
+// Prompt-lookup (n-gram) speculative decoding worker.
+// Drafts are copied from the request's own prompt and output by matching the
+// trailing n-gram against an incrementally maintained per-request index, so
+// no draft model or global cache is involved. An index is built from the full
+// token history when the request's prefill ends and dropped when the
+// scheduler releases the request.
+class NGramWorkerImpl : public SpeculativeWorkerImpl {
+ public:
+  NGramWorkerImpl(const ParallelArgs& parallel_args,
+                  const torch::Device& device,
+                  const runtime::Options& options);
+
+  ~NGramWorkerImpl() override = default;
+
+ protected:
+  std::optional<ForwardOutput> step_prefill(const ForwardInput& input) override;
+  std::optional<ForwardOutput> step_decode(const ForwardInput& inputs) override;
+  std::optional<ForwardOutput> step_empty(const ForwardInput& inputs) override;
+
+ private:
+  NGramRequestIndices ngram_indices_;
+};
+}  // namespace xllm
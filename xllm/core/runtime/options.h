@@ -86,6 +86,16 @@ struct Options {
 
   PROPERTY(bool, speculative_suffix_use_tree_spec) = false;
 
+  PROPERTY(int32_t, speculative_suffix_num_threads) = 4;
+
+  PROPERTY(std::string, speculative_suffix_corpus_path);
+
+  PROPERTY(int32_t, speculative_suffix_snapshot_interval_s) = 0;
+
+  PROPERTY(int32_t, speculative_ngram_min) = 1;
+
+  PROPERTY(int32_t, speculative_ngram_max) = 4;
+
   PROPERTY(bool, enable_adaptive_speculative_decode) = false;
 
   PROPERTY(double, adaptive_speculative_min_gain) = 0.0;
@@ -217,6 +227,26 @@ struct Options {
   //  value used if port is not included)
   PROPERTY(std::string, store_local_hostname) = "";
 
+  // in-process store used with store_protocol "local": capacity in GiB
+  // (0 unbounded), simulated bandwidth in Gbit/s (0 unlimited) and latency
+  // per batch call.
+  PROPERTY(uint32_t, store_local_capacity_gb) = 64;
+
+  PROPERTY(double, store_local_bandwidth_gbps) = 0.0;
+
+  PROPERTY(uint32_t, store_local_latency_us) = 0;
+
+  // local NVMe/SSD directory for a KV cache tier behind the host cache,
+  // disabled when empty.
+  PROPERTY(std::string, kv_cache_disk_path) = "";
+
+  // disk space per worker for the local KV cache tier, in GiB.
+  PROPERTY(uint32_t, kv_cache_disk_capacity_gb) = 64;
+
+  // encoding of KV blocks in the disk and store tiers: none, int8 or
+  // lossless.
+  PROPERTY(std::string, kv_cache_tier_codec) = "none";
+
   // Prefetch from kvcache store copy batch size
   PROPERTY(uint32_t, prefetch_batch_size) = 2;
 
@@ -430,6 +430,15 @@ bool dit_forward_input_to_proto(const DiTForwardInput& dit_inputs,
     return false;
   }
 
+  ADD_VECTOR_TO_PROTO(pb_dit_inputs->mutable_joining_request_ids(),
+                      dit_inputs.joining_request_ids);
+  ADD_VECTOR_TO_PROTO(pb_dit_inputs->mutable_running_request_ids(),
+                      dit_inputs.running_request_ids);
+  ADD_VECTOR_TO_PROTO(pb_dit_inputs->mutable_joining_seeds(),
+                      dit_inputs.joining_seeds);
+  ADD_VECTOR_TO_PROTO(pb_dit_inputs->mutable_released_request_ids(),
+                      dit_inputs.released_request_ids);
+
   return true;
 }
 
@@ -575,6 +584,18 @@ bool proto_to_dit_forward_input(const proto::DiTForwardInput& pb_dit_inputs,
     dit_inputs.audio_prompt_text = pb_dit_inputs.audio_prompt_text();
   }
 
+  dit_inputs.joining_request_ids.assign(
+      pb_dit_inputs.joining_request_ids().begin(),
+      pb_dit_inputs.joining_request_ids().end());
+  dit_inputs.running_request_ids.assign(
+      pb_dit_inputs.running_request_ids().begin(),
+      pb_dit_inputs.running_request_ids().end());
+  dit_inputs.joining_seeds.assign(pb_dit_inputs.joining_seeds().begin(),
+                                  pb_dit_inputs.joining_seeds().end());
+  dit_inputs.released_request_ids.assign(
+      pb_dit_inputs.released_request_ids().begin(),
+      pb_dit_inputs.released_request_ids().end());
+
   return true;
 }
 
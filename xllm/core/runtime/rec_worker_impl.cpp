@@ -688,7 +688,8 @@ void RecWorkerImpl::OneRecWorkPipeline::prepare_work_before_execute(
 
 folly::SemiFuture<torch::Tensor>
 RecWorkerImpl::OneRecWorkPipeline::prepare_filter_mask_async(
-    const std::vector<std::vector<int32_t>>& generated_tokens) {
+    const std::vector<std::vector<int32_t>>& generated_tokens,
+    const std::vector<std::string>& request_ids) {
   folly::Promise<torch::Tensor> promise;
   auto future = promise.getSemiFuture();
 
@@ -699,10 +700,14 @@ RecWorkerImpl::OneRecWorkPipeline::prepare_filter_mask_async(
   }
 
   filter_mask_threadpool_->schedule(
-      [this, generated_tokens, promise = std::move(promise)]() mutable {
+      [this,
+       generated_tokens,
+       request_ids,
+       promise = std::move(promise)]() mutable {
         try {
           auto filter_mask =
-              constrained_decoding_->generate_mask(generated_tokens);
+              constrained_decoding_->generate_mask(generated_tokens,
+                                                   request_ids);
           promise.setValue(filter_mask);
         } catch (const std::exception& e) {
           const int32_t batch = static_cast<int32_t>(generated_tokens.size());
@@ -756,12 +761,18 @@ std::optional<ForwardOutput> RecWorkerImpl::OneRecWorkPipeline::step(
                                       runtime_.worker.kv_caches_,
                                       mutable_input.input_params);
   };
+  if (constrained_decoding_ != nullptr) {
+    constrained_decoding_->release(
+        mutable_input.input_params.embedding.released_request_ids);
+  }
   std::optional<folly::SemiFuture<torch::Tensor>> filter_mask_future;
   if ((runtime_.worker.driver_ || runtime_.worker.dp_driver_) &&
       ::xllm::RecConfig::get_instance().enable_constrained_decoding() &&
       constrained_decoding_ != nullptr &&
       sampling_params.selected_token_idxes.defined()) {
-    filter_mask_future = prepare_filter_mask_async(rec_params.generated_tokens);
+    filter_mask_future = prepare_filter_mask_async(
+        rec_params.generated_tokens,
+        mutable_input.input_params.embedding.request_ids);
   }
 
   torch::Tensor hidden_states;
@@ -897,10 +908,6 @@ RecWorkerImpl::OneRecXAttentionWorkPipeline::OneRecXAttentionWorkPipeline(
 
   const int32_t vocab_size =
       static_cast<int32_t>(runtime_.context->get_model_args().vocab_size());
-#if defined(USE_NPU)
-  initialize_constraint_device_tensors(
-      vocab_dict->build_constraint_tables(vocab_size));
-#endif
   constrained_decoding_ =
       std::make_unique<RecConstrainedDecoding>(vocab_dict,
                                                vocab_size,
@@ -910,6 +917,29 @@ RecWorkerImpl::OneRecXAttentionWorkPipeline::OneRecXAttentionWorkPipeline(
   CHECK(constrained_decoding_->build_mask_cache())
       << "Failed to build OneRec xattention constrained decoding cache, "
       << "vocab_size=" << vocab_size;
+  refresh_constraint_device_tensors();
+}
+
+void RecWorkerImpl::OneRecXAttentionWorkPipeline::
+    refresh_constraint_device_tensors() {
+#if defined(USE_NPU)
+  if (constrained_decoding_ == nullptr) {
+    return;
+  }
+  // follow the catalog version of the host masks, which is swapped in by
+  // RecConstrainedDecoding once its background rebuild finishes.
+  auto snapshot = constrained_decoding_->snapshot();
+  if (snapshot == nullptr ||
+      (constraint_device_tensors_.initialized &&
+       constraint_device_tensors_.vocab_version == snapshot->version())) {
+    return;
+  }
+  const int32_t vocab_size =
+      static_cast<int32_t>(runtime_.context->get_model_args().vocab_size());
+  initialize_constraint_device_tensors(
+      snapshot->build_constraint_tables(vocab_size));
+  constraint_device_tensors_.vocab_version = snapshot->version();
+#endif
 }
 
 void RecWorkerImpl::OneRecXAttentionWorkPipeline::
@@ -1316,7 +1346,8 @@ void RecWorkerImpl::OneRecXAttentionWorkPipeline::prepare_work_before_execute(
 
 folly::SemiFuture<torch::Tensor>
 RecWorkerImpl::OneRecXAttentionWorkPipeline::prepare_filter_mask_async(
-    const std::vector<std::vector<int32_t>>& generated_tokens) {
+    const std::vector<std::vector<int32_t>>& generated_tokens,
+    const std::vector<std::string>& request_ids) {
   folly::Promise<torch::Tensor> promise;
   auto future = promise.getSemiFuture();
 
@@ -1327,10 +1358,14 @@ RecWorkerImpl::OneRecXAttentionWorkPipeline::prepare_filter_mask_async(
   }
 
   filter_mask_threadpool_->schedule(
-      [this, generated_tokens, promise = std::move(promise)]() mutable {
+      [this,
+       generated_tokens,
+       request_ids,
+       promise = std::move(promise)]() mutable {
         try {
           auto filter_mask =
-              constrained_decoding_->generate_mask(generated_tokens);
+              constrained_decoding_->generate_mask(generated_tokens,
+                                                   request_ids);
           promise.setValue(filter_mask);
         } catch (const std::exception& e) {
           const int32_t batch = static_cast<int32_t>(generated_tokens.size());
@@ -1358,6 +1393,7 @@ std::optional<ForwardOutput> RecWorkerImpl::OneRecXAttentionWorkPipeline::step(
     const ForwardInput& input) {
   Timer timer;
   runtime_.worker.device_.set_device();
+  refresh_constraint_device_tensors();
   const bool trace_stage_timing = enable_onerec_xattention_stage_timing();
   auto log_stage_timing =
       [&](const char* stage_name, int32_t round, Timer& stage_timer) {
@@ -1374,6 +1410,10 @@ std::optional<ForwardOutput> RecWorkerImpl::OneRecXAttentionWorkPipeline::step(
   ForwardInput mutable_input = input;
   CHECK(mutable_input.input_params.onerec_xattention_params() != nullptr)
       << "OneRec xattention pipeline requires onerec_xattention_params.";
+  if (constrained_decoding_ != nullptr) {
+    constrained_decoding_->release(
+        mutable_input.input_params.embedding.released_request_ids);
+  }
 
   struct RoundResult {
     torch::Tensor logits;
@@ -1444,8 +1484,9 @@ std::optional<ForwardOutput> RecWorkerImpl::OneRecXAttentionWorkPipeline::step(
         constrained_decoding_ != nullptr &&
         sampling_params.selected_token_idxes.defined() &&
         !use_device_constraints) {
-      filter_mask_future =
-          prepare_filter_mask_async(round_params->generated_tokens);
+      filter_mask_future = prepare_filter_mask_async(
+          round_params->generated_tokens,
+          mutable_input.input_params.embedding.request_ids);
     }
 
     torch::Tensor selected_token_idxes_for_logits;
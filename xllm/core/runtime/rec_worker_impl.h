@@ -21,6 +21,7 @@ limitations under the License.
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "runtime/llm_worker_impl.h"
@@ -131,7 +132,8 @@ class RecWorkerImpl : public LLMWorkerImpl {
 
    private:
     folly::SemiFuture<torch::Tensor> prepare_filter_mask_async(
-        const std::vector<std::vector<int32_t>>& generated_tokens);
+        const std::vector<std::vector<int32_t>>& generated_tokens,
+        const std::vector<std::string>& request_ids);
 
     std::unique_ptr<RecSampler> rec_sampler_;
     std::unique_ptr<RecConstrainedDecoding> constrained_decoding_;
@@ -159,15 +161,20 @@ class RecWorkerImpl : public LLMWorkerImpl {
       torch::Tensor prefix2_values;
       int64_t max_prefix1_degree = 0;
       int64_t max_prefix2_degree = 0;
+      uint64_t vocab_version = 0;
       bool initialized = false;
     };
 
     folly::SemiFuture<torch::Tensor> prepare_filter_mask_async(
-        const std::vector<std::vector<int32_t>>& generated_tokens);
+        const std::vector<std::vector<int32_t>>& generated_tokens,
+        const std::vector<std::string>& request_ids);
 
     void initialize_constraint_device_tensors(
         const RecConstraintTables& tables);
 
+    // Re-upload the device tables when the catalog version changed.
+    void refresh_constraint_device_tensors();
+
     bool can_use_device_constraints(const SamplingParameters& sampling_params,
                                     int32_t current_step,
                                     int32_t beam_width) const;
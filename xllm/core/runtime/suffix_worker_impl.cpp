@@ -22,6 +22,7 @@ limitations under the License.
 #include "core/framework/speculative/spec_verify.h"
 #include "framework/sampling/sampling_params.h"
 #include "util/slice.h"
+#include "util/suffix_corpus.h"
 #include "util/timer.h"
 #include "util/utils.h"
 
@@ -75,6 +76,84 @@ SuffixWorkerImpl::SuffixWorkerImpl(const ParallelArgs& parallel_args,
   suffix_cache_ = std::make_unique<SuffixDecodingCache>(
       options_.speculative_suffix_cache_max_depth(),
       options_.speculative_suffix_max_cached_requests());
+  if (options_.speculative_suffix_num_threads() > 0) {
+    suffix_threadpool_ = std::make_unique<MPMCThreadPool>(
+        static_cast<size_t>(options_.speculative_suffix_num_threads()));
+  }
+  if (!options_.speculative_suffix_corpus_path().empty()) {
+    load_corpus();
+    if (driver_ && options_.speculative_suffix_snapshot_interval_s() > 0) {
+      snapshot_threadpool_ = std::make_unique<ThreadPool>(
+          1, /*cpu_binding=*/false, "suffix_snapshot");
+    }
+  }
+  last_snapshot_time_ = std::chrono::steady_clock::now();
+}
+
+SuffixWorkerImpl::~SuffixWorkerImpl() {
+  // drain the background writer before the final snapshot replaces its file.
+  snapshot_threadpool_.reset();
+  const std::string& path = options_.speculative_suffix_corpus_path();
+  if (driver_ && !path.empty()) {
+    suffix_cache_->flush_global_responses();
+    SuffixCorpus corpus = suffix_cache_->export_cached_responses();
+    if (save_suffix_corpus(path, corpus)) {
+      LOG(INFO) << "Saved " << corpus.size()
+                << " suffix corpus sequences to " << path;
+    }
+  }
+}
+
+void SuffixWorkerImpl::load_corpus() {
+  const std::string& path = options_.speculative_suffix_corpus_path();
+  std::optional<SuffixCorpus> corpus = load_suffix_corpus(path);
+  if (!corpus.has_value()) {
+    LOG(INFO) << "No usable suffix corpus at " << path << ", starting cold";
+    return;
+  }
+  for (const auto& tokens : corpus.value()) {
+    suffix_cache_->add_cached_response(std::span<const int32_t>(tokens));
+  }
+  LOG(INFO) << "Loaded " << corpus->size() << " suffix corpus sequences from "
+            << path;
+}
+
+void SuffixWorkerImpl::maybe_snapshot_corpus() {
+  if (snapshot_threadpool_ == nullptr) {
+    return;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  const auto interval =
+      std::chrono::seconds(options_.speculative_suffix_snapshot_interval_s());
+  if (now - last_snapshot_time_ < interval ||
+      snapshot_in_flight_.exchange(true)) {
+    return;
+  }
+  last_snapshot_time_ = now;
+
+  // copy on the worker thread, the cache is not safe to read concurrently
+  // with step updates; only the file write is offloaded.
+  SuffixCorpus corpus = suffix_cache_->export_cached_responses();
+  snapshot_threadpool_->schedule(
+      [this,
+       corpus = std::move(corpus),
+       path = options_.speculative_suffix_corpus_path()]() {
+        if (save_suffix_corpus(path, corpus)) {
+          VLOG(1) << "Saved " << corpus.size()
+                  << " suffix corpus sequences to " << path;
+        }
+        snapshot_in_flight_.store(false);
+      });
+}
+
+void SuffixWorkerImpl::parallel_for_sequences(
+    size_t total,
+    const std::function<void(size_t, size_t)>& body) {
+  if (suffix_threadpool_ == nullptr) {
+    body(0, total);
+    return;
+  }
+  suffix_threadpool_->parallel_for(total, kSequencesPerTask, body);
 }
 
 std::optional<ForwardOutput> SuffixWorkerImpl::step_empty(
@@ -216,6 +295,9 @@ std::optional<ForwardOutput> SuffixWorkerImpl::step_decode(
   std::vector<int32_t> draft_tokens_flat;
   draft_tokens_flat.reserve(num_sequences * num_speculative_tokens);
   std::vector<std::string> req_ids(num_sequences);
+  // Resolve per-sequence state serially so that the parallel phases below
+  // only read the request maps and touch their own local trees.
+  std::vector<std::vector<int32_t>*> histories(num_sequences, nullptr);
 
   for (int32_t seq_id = 0; seq_id < num_sequences; ++seq_id) {
     int32_t fallback_token = input_tokens_slice[seq_id];
@@ -223,8 +305,7 @@ std::optional<ForwardOutput> SuffixWorkerImpl::step_decode(
       draft_tokens_flat.emplace_back(fallback_token);
     }
 
-    if (suffix_cache_ == nullptr ||
-        request_ids.size() != static_cast<size_t>(num_sequences)) {
+    if (!has_request_ids) {
       continue;
     }
 
@@ -251,23 +332,32 @@ std::optional<ForwardOutput> SuffixWorkerImpl::step_decode(
           std::span<const int32_t>(&fallback_token, 1),
           static_cast<size_t>(suffix_cache_->max_tree_depth()));
     }
+    histories[seq_id] = &history;
+  }
 
-    SuffixDecodingDraft draft = suffix_cache_->speculate(
-        req_id,
-        std::span<const int32_t>(history.data(), history.size()),
-        /*max_spec_tokens=*/num_speculative_tokens,
-        options_.speculative_suffix_max_spec_factor(),
-        options_.speculative_suffix_max_spec_offset(),
-        options_.speculative_suffix_min_token_prob(),
-        options_.speculative_suffix_use_tree_spec());
-
-    const int32_t fill_count =
-        std::min<int32_t>(num_speculative_tokens, draft.token_ids.size());
-    for (int32_t i = 0; i < fill_count; ++i) {
-      draft_tokens_flat[seq_id * num_speculative_tokens + i] =
-          draft.token_ids[i];
+  // speculate() only reads the local and global trees.
+  parallel_for_sequences(num_sequences, [&](size_t begin, size_t end) {
+    for (size_t seq_id = begin; seq_id < end; ++seq_id) {
+      const std::vector<int32_t>* history = histories[seq_id];
+      if (history == nullptr) {
+        continue;
+      }
+      SuffixDecodingDraft draft = suffix_cache_->speculate(
+          req_ids[seq_id],
+          std::span<const int32_t>(history->data(), history->size()),
+          /*max_spec_tokens=*/num_speculative_tokens,
+          options_.speculative_suffix_max_spec_factor(),
+          options_.speculative_suffix_max_spec_offset(),
+          options_.speculative_suffix_min_token_prob(),
+          options_.speculative_suffix_use_tree_spec());
+
+      const int32_t fill_count =
+          std::min<int32_t>(num_speculative_tokens, draft.token_ids.size());
+      std::copy(draft.token_ids.begin(),
+                draft.token_ids.begin() + fill_count,
+                draft_tokens_flat.begin() + seq_id * num_speculative_tokens);
     }
-  }
+  });
 
   ForwardInput validate_input;
   prepare_validate_inputs(input, validate_input);
@@ -292,6 +382,12 @@ std::optional<ForwardOutput> SuffixWorkerImpl::step_decode(
 
   timer.reset();
   auto future = impl_->step_async(validate_input);
+  if (suffix_cache_ != nullptr) {
+    // Apply the previous step's responses to the global tree while the
+    // target model runs. Drafts of this step already used the local trees,
+    // which are always up to date.
+    suffix_cache_->flush_global_responses();
+  }
   ForwardOutput target_output = std::move(future).get().value();
   COUNTER_ADD(speculative_execution_latency_seconds_target,
               timer.elapsed_seconds());
@@ -316,8 +412,7 @@ std::optional<ForwardOutput> SuffixWorkerImpl::step_decode(
   COUNTER_ADD(speculative_execution_latency_seconds_validation,
               timer.elapsed_seconds());
 
-  if (suffix_cache_ != nullptr &&
-      request_ids.size() == static_cast<size_t>(num_sequences)) {
+  if (has_request_ids) {
     torch::Tensor accepted_tokens =
         safe_to(val_output.next_tokens, torch::kCPU).to(torch::kInt);
     accepted_tokens = accepted_tokens.view({num_sequences, num_val_tokens});
@@ -325,13 +420,14 @@ std::optional<ForwardOutput> SuffixWorkerImpl::step_decode(
         accepted_tokens.data_ptr<int32_t>(),
         static_cast<size_t>(accepted_tokens.numel())};
 
+    std::vector<std::vector<int32_t>> accepted_per_seq(num_sequences);
     for (int32_t seq_id = 0; seq_id < num_sequences; ++seq_id) {
       const std::string& req_id = req_ids[seq_id];
       if (req_id.empty()) {
         continue;
       }
 
-      std::vector<int32_t> accepted;
+      std::vector<int32_t>& accepted = accepted_per_seq[seq_id];
       accepted.reserve(num_val_tokens);
       int32_t first_reject_idx = -1;
       std::vector<int32_t> row_tokens;
@@ -364,17 +460,50 @@ std::optional<ForwardOutput> SuffixWorkerImpl::step_decode(
                 << summarize_int32_span(std::span<const int32_t>(
                        row_tokens.data(), row_tokens.size()));
       }
+    }
 
+    // Sequences of one request share its local tree and history, so they are
+    // updated in order by a single task.
+    std::vector<std::vector<int32_t>> seq_groups;
+    std::unordered_map<std::string, size_t> group_index;
+    for (int32_t seq_id = 0; seq_id < num_sequences; ++seq_id) {
+      if (accepted_per_seq[seq_id].empty()) {
+        continue;
+      }
+      auto [it, inserted] =
+          group_index.try_emplace(req_ids[seq_id], seq_groups.size());
+      if (inserted) {
+        seq_groups.emplace_back();
+      }
+      seq_groups[it->second].emplace_back(seq_id);
+    }
+
+    parallel_for_sequences(seq_groups.size(), [&](size_t begin, size_t end) {
+      for (size_t group_id = begin; group_id < end; ++group_id) {
+        for (const int32_t seq_id : seq_groups[group_id]) {
+          const std::vector<int32_t>& accepted = accepted_per_seq[seq_id];
+          suffix_cache_->add_local_response(
+              req_ids[seq_id],
+              std::span<const int32_t>(accepted.data(), accepted.size()));
+          append_tokens_with_limit(
+              *histories[seq_id],
+              std::span<const int32_t>(accepted.data(), accepted.size()),
+              static_cast<size_t>(suffix_cache_->max_tree_depth()));
+        }
+      }
+    });
+
+    // The global tree is updated in one batch during the next target step.
+    for (int32_t seq_id = 0; seq_id < num_sequences; ++seq_id) {
+      const std::vector<int32_t>& accepted = accepted_per_seq[seq_id];
       if (!accepted.empty()) {
-        suffix_cache_->add_active_response(
-            req_id, std::span<const int32_t>(accepted.data(), accepted.size()));
-        append_tokens_with_limit(
-            suffix_recent_tokens_[req_id],
-            std::span<const int32_t>(accepted.data(), accepted.size()),
-            static_cast<size_t>(suffix_cache_->max_tree_depth()));
+        suffix_cache_->enqueue_global_response(
+            req_ids[seq_id],
+            std::span<const int32_t>(accepted.data(), accepted.size()));
       }
     }
   }
+  maybe_snapshot_corpus();
 
   if (!enable_schedule_overlap() && !driver_ && !dp_driver_) {
     return std::nullopt;
@@ -390,35 +519,14 @@ SampleOutput SuffixWorkerImpl::validate(
     const torch::Tensor& draft_probs,
     const ForwardOutput& target_output) {
   (void)sampling_params;
-  const int32_t num_val_tokens = options_.num_speculative_tokens() + 1;
-  const int32_t batch_size =
-      static_cast<int32_t>(draft_token_ids.size(/*dim=*/0));
-  const int32_t vocab_size =
-      static_cast<int32_t>(target_output.logits.size(/*dim=*/-1));
-  CHECK_EQ(target_output.logits.size(/*dim=*/0),
-           static_cast<int64_t>(batch_size) * num_val_tokens)
-      << "suffix validate logits shape mismatch";
-
-  using ISlice = torch::indexing::Slice;
-  auto target_logits =
-      target_output.logits.view({batch_size, num_val_tokens, vocab_size});
-  // Use target greedy token as the bonus token, consistent with greedy verify.
-  auto bonus_token_ids =
-      target_logits.index({ISlice(), num_val_tokens - 1, ISlice()})
-          .argmax(/*dim=*/-1, /*keepdim=*/true);
-
   // Suffix decoding always uses greedy sampling for validation,
   // regardless of the user's sampling parameters.
-  auto greedy_do_sample = torch::zeros({batch_size}, torch::kBool);
-  return spec_verify::run_rejection_sampling({.do_sample = greedy_do_sample,
-                                              .all_random_sample = false,
-                                              .all_greedy_sample = true},
-                                             draft_token_ids,
-                                             draft_probs,
-                                             target_logits,
-                                             target_output,
-                                             bonus_token_ids,
-                                             enable_fused_kernel_);
+  return spec_verify::run_greedy_verification(
+      draft_token_ids,
+      draft_probs,
+      target_output,
+      /*num_val_tokens=*/options_.num_speculative_tokens() + 1,
+      enable_fused_kernel_);
 }
 
 }  // namespace xllm
@@ -15,25 +15,32 @@ limitations under the License.
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "runtime/speculative_worker_impl.h"
 #include "util/suffix_decoding_cache.h"
+#include "util/threadpool.h"
 
 namespace xllm {
 
 // Suffix-based speculative decoding worker.
 // Uses a suffix tree cache to generate draft tokens from previously seen
-// patterns, without requiring a separate draft model.
+// patterns, without requiring a separate draft model. Per-sequence drafts and
+// local-tree updates run on a thread pool, and global-tree updates are
+// deferred so they overlap with the next target forward. The global tree can
+// be warm-started from, and periodically snapshotted to, a corpus file.
 class SuffixWorkerImpl : public SpeculativeWorkerImpl {
  public:
   SuffixWorkerImpl(const ParallelArgs& parallel_args,
                    const torch::Device& device,
                    const runtime::Options& options);
 
-  ~SuffixWorkerImpl() override = default;
+  ~SuffixWorkerImpl() override;
 
  protected:
   std::optional<ForwardOutput> step_prefill(const ForwardInput& input) override;
@@ -41,14 +48,34 @@ class SuffixWorkerImpl : public SpeculativeWorkerImpl {
   std::optional<ForwardOutput> step_empty(const ForwardInput& inputs) override;
 
  private:
+  // Run body over [0, total) on suffix_threadpool_, or inline without one.
+  void parallel_for_sequences(size_t total,
+                              const std::function<void(size_t, size_t)>& body);
+
   SampleOutput validate(const SamplingParameters& sampling_params,
                         const torch::Tensor& draft_token_ids,
                         const torch::Tensor& draft_probs,
                         const ForwardOutput& target_output);
 
+  // Seed the global tree from speculative_suffix_corpus_path, on every rank
+  // so that all TP ranks draft identically.
+  void load_corpus();
+
+  // Write the global tree corpus in the background once the snapshot
+  // interval has elapsed. Only the driver writes.
+  void maybe_snapshot_corpus();
+
  private:
+  static constexpr size_t kSequencesPerTask = 16;
+
   std::unique_ptr<SuffixDecodingCache> suffix_cache_;
+  std::unique_ptr<MPMCThreadPool> suffix_threadpool_;
   std::unordered_map<std::string, std::vector<int32_t>> suffix_recent_tokens_;
   std::unordered_set<std::string> suffix_active_decode_req_ids_;
+
+  // single writer thread, so at most one snapshot is in flight.
+  std::unique_ptr<ThreadPool> snapshot_threadpool_;
+  std::atomic<bool> snapshot_in_flight_{false};
+  std::chrono::steady_clock::time_point last_snapshot_time_;
 };
 }  // namespace xllm
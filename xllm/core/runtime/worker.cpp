@@ -39,6 +39,7 @@ limitations under the License.
 #include "runtime/llm_worker_impl.h"
 #include "runtime/mm_embed_vlm_worker_impl.h"
 #include "runtime/mtp_worker_impl.h"
+#include "runtime/ngram_worker_impl.h"
 #include "runtime/rec_worker_impl.h"
 #include "runtime/suffix_worker_impl.h"
 #include "runtime/vlm_worker_impl.h"
@@ -60,6 +61,8 @@ Worker::Worker(const ParallelArgs& parallel_args,
       impl_ = new DSparkWorkerImpl(parallel_args, device, options);
     } else if (algorithm == "Suffix") {
       impl_ = new SuffixWorkerImpl(parallel_args, device, options);
+    } else if (algorithm == "NGram") {
+      impl_ = new NGramWorkerImpl(parallel_args, device, options);
     } else if (SpeculativeConfig::is_mtp_algorithm(algorithm)) {
       impl_ = new MTPWorkerImpl(parallel_args, device, options);
     } else {
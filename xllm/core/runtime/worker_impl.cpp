@@ -2318,6 +2318,10 @@ void WorkerImpl::init_hierarchy_kv_cache_transfer(
     CHECK_GT(options_.host_blocks_factor(), 1.0)
         << "KV cache Store requires Host cache blocks.";
   }
+  if (!options_.kv_cache_disk_path().empty()) {
+    CHECK_GT(options_.host_blocks_factor(), 1.0)
+        << "The KV disk cache requires Host cache blocks.";
+  }
   if (options_.host_blocks_factor() > 1.0) {
     CHECK(!kv_caches_.empty()) << "kv_caches is not initialized.";
     CHECK(hierarchy_kv_cache_transfer_ == nullptr)
@@ -2349,8 +2353,16 @@ void WorkerImpl::init_hierarchy_kv_cache_transfer(
         .store_master_server_address(options_.store_master_server_address())
         .store_metadata_server(options_.store_metadata_server())
         .store_local_hostname(options_.store_local_hostname())
+        .store_local_capacity_bytes(
+            static_cast<uint64_t>(options_.store_local_capacity_gb()) << 30)
+        .store_local_bandwidth_gbps(options_.store_local_bandwidth_gbps())
+        .store_local_latency_us(options_.store_local_latency_us())
         .store_namespace(options_.model_id())
-        .store_worker_id(worker_id);
+        .store_worker_id(worker_id)
+        .kv_cache_disk_path(options_.kv_cache_disk_path())
+        .kv_cache_disk_capacity_bytes(
+            static_cast<uint64_t>(options_.kv_cache_disk_capacity_gb()) << 30)
+        .kv_cache_tier_codec(options_.kv_cache_tier_codec());
     hierarchy_kv_cache_transfer_ =
         std::make_unique<HierarchyKVCacheTransfer>(transfer_options,
                                                    device_,
@@ -26,6 +26,7 @@ limitations under the License.
 
 #include "core/framework/config/distributed_config.h"
 #include "core/framework/config/service_config.h"
+#include "framework/prefix_cache/kv_cache_summary.h"
 #include "util/env_var.h"
 #include "util/hash_util.h"
 #include "util/net.h"
@@ -70,6 +71,24 @@ bool check_instance_name(const std::string& name) {
   return true;
 }
 
+void to_proto(const KVCacheSummary::Delta& delta,
+              uint32_t num_counters,
+              xllm_service::proto::KvCacheSummary* summary) {
+  summary->set_sequence(delta.sequence);
+  summary->set_num_counters(num_counters);
+  summary->set_num_hashes(delta.num_hashes);
+  summary->set_full(delta.full);
+  uint32_t prev_index = 0;
+  summary->mutable_index_gaps()->Reserve(delta.indices.size());
+  for (uint32_t index : delta.indices) {
+    summary->add_index_gaps(index - prev_index);
+    prev_index = index;
+  }
+  summary->set_counters(
+      reinterpret_cast<const char*>(delta.counters.data()),
+      delta.counters.size());
+}
+
 }  // namespace
 
 bool XServiceClient::init(const std::string& etcd_addr,
@@ -396,23 +415,38 @@ void XServiceClient::heartbeat() {
       }
     }
 
-    xllm_service::proto::Status resp;
-    std::string master_addr;
-    if (!with_master_stub(
-            [&](xllm_service::proto::XllmRpcService_Stub* master_stub) {
-              master_stub->Heartbeat(&cntl, &req, &resp, nullptr);
-            },
-            &master_addr)) {
-      continue;
+    // cached blocks as a counting Bloom filter delta, see KVCacheSummary.
+    const bool report_summary =
+        ::xllm::DistributedConfig::get_instance().enable_kv_cache_summary();
+    if (report_summary) {
+      KVCacheSummary& summary = KVCacheSummary::get_instance();
+      const KVCacheSummary::Delta delta = summary.take_delta();
+      to_proto(delta,
+               summary.num_counters(),
+               req.mutable_cache_event()->mutable_summary());
     }
 
-    if (cntl.Failed()) {
+    xllm_service::proto::Status resp;
+    std::string master_addr;
+    bool sent = with_master_stub(
+        [&](xllm_service::proto::XllmRpcService_Stub* master_stub) {
+          master_stub->Heartbeat(&cntl, &req, &resp, nullptr);
+        },
+        &master_addr);
+
+    if (sent && cntl.Failed()) {
+      sent = false;
       LOG(ERROR) << "Failed to send heartbeat to master xservice "
                  << master_addr << ", error msg is: " << cntl.ErrorText();
-    } else if (!resp.ok()) {
+    } else if (sent && !resp.ok()) {
+      sent = false;
       LOG(ERROR) << "Failed to send heartbeat to master xservice "
                  << master_addr;
     }
+    // the lost delta is unrecoverable, resync the service with a snapshot.
+    if (report_summary && !sent) {
+      KVCacheSummary::get_instance().request_full_snapshot();
+    }
   }
 }
 
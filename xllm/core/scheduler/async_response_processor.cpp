@@ -29,8 +29,22 @@ limitations under the License.
 #include "framework/request/sequence.h"
 #include "util/blocking_counter.h"
 #include "util/env_var.h"
+#include "util/flight_recorder.h"
 
 namespace xllm {
+namespace {
+
+void record_request_finish(Request& request, double latency_seconds) {
+  FlightRecorder::get_instance().record_request_event(
+      "request.finish",
+      request.request_id(),
+      {{"latency_ms", static_cast<int64_t>(latency_seconds * 1000.0)},
+       {"generated_tokens",
+        static_cast<int64_t>(request.sequences()[0]->num_generated_tokens())},
+       {"cancelled", request.cancelled() ? 1 : 0}});
+}
+
+}  // namespace
 
 AsyncResponseProcessor::AsyncResponseProcessor(
     const Tokenizer* tokenizer,
@@ -111,6 +125,7 @@ void AsyncResponseProcessor::process_completed_request(
                       static_cast<int64_t>(end_2_end_latency_seconds * 1000.0));
     RequestOutput req_output =
         request->generate_output(*tokenizer_, &generate_output_threadpool_);
+    record_request_finish(*request, end_2_end_latency_seconds);
     if (!disable_log_stats_) {
       if (req_output.status.has_value() && !req_output.status->ok()) {
         request->log_error_statistic(req_output.status.value());
@@ -148,6 +163,7 @@ void AsyncResponseProcessor::batch_process_completed_requests(
           end_2_end_latency_milliseconds,
           static_cast<int64_t>(end_2_end_latency_seconds * 1000.0));
       *request_output = std::move(request->generate_output(*tokenizer_));
+      record_request_finish(*request, end_2_end_latency_seconds);
       if (!disable_log_stats_) {
         if (request_output->status.has_value() &&
             !request_output->status->ok()) {
@@ -184,6 +200,8 @@ void AsyncResponseProcessor::batch_process_completed_requests(
 // process non-stream requests
 void AsyncResponseProcessor::process_completed_requests(
     std::vector<std::shared_ptr<Request>>& requests) {
+  FlightRecorderSpan span("response.completed");
+  span.set_arg("requests", static_cast<int64_t>(requests.size()));
   if (!enable_batch_response_) {
     for (size_t i = 0; i < requests.size(); ++i) {
       process_completed_request(std::move(requests[i]));
@@ -364,6 +382,8 @@ void AsyncResponseProcessor::batch_process_stream_requests(
 // process stream requests
 void AsyncResponseProcessor::process_stream_requests(
     std::vector<std::shared_ptr<Request>>& requests) {
+  FlightRecorderSpan span("response.stream");
+  span.set_arg("requests", static_cast<int64_t>(requests.size()));
   if (!enable_batch_response_) {
     for (auto& req : requests) {
       process_stream_request(req);
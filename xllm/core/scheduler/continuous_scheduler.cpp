@@ -32,6 +32,7 @@ limitations under the License.
 #include <vector>
 
 #include "common/metrics.h"
+#include "core/framework/config/execution_config.h"
 #include "core/framework/config/kv_cache_config.h"
 #include "core/framework/config/parallel_config.h"
 #include "core/framework/config/rec_config.h"
@@ -42,23 +43,24 @@ limitations under the License.
 #include "framework/request/priority_comparator.h"
 #include "framework/request/request.h"
 #include "framework/request/sequence.h"
+#include "platform/platform.h"
 #include "scheduler/request_priority_queue.h"
 #include "scheduler/scheduler_policy.h"
+#include "util/flight_recorder.h"
 #include "util/timer.h"
 #include "util/utils.h"
 
 namespace xllm {
 
 void CancelRequestQueue::submit(std::shared_ptr<Request> request) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  requests_.emplace_back(std::move(request));
+  requests_.push(std::move(request));
 }
 
 std::vector<std::shared_ptr<Request>> CancelRequestQueue::take_all() {
-  std::vector<std::shared_ptr<Request>> requests;
-  std::lock_guard<std::mutex> lock(mutex_);
-  requests.swap(requests_);
-  return requests;
+  if (requests_.empty()) {
+    return {};
+  }
+  return requests_.take_all();
 }
 
 BatchMode resolve_batch_mode(const ContinuousScheduler::Options& options) {
@@ -130,6 +132,25 @@ ContinuousScheduler::ContinuousScheduler(Engine* engine, const Options& options)
   profile_manager_ =
       std::make_unique<ProfileManager>(engine, profile_manager_options);
 
+  const auto& execution_config = ::xllm::ExecutionConfig::get_instance();
+  if (execution_config.enable_adaptive_decode_graph_buckets()) {
+    // the buckets are installed per process and need every executor to use
+    // the shared padded decode schedule.
+    if (execution_config.enable_graph() &&
+        !execution_config.enable_graph_mode_decode_no_padding() &&
+        !Platform::is_npu() && options_.dp_size() == 1 &&
+        options_.nnodes() == 1) {
+      decode_graph_bucket_tuner_ = std::make_unique<DecodeGraphBucketTuner>(
+          engine_->decode_graph_execution_shape().num_decoding_tokens,
+          options_.max_seqs_per_batch(),
+          execution_config.adaptive_decode_graph_bucket_budget());
+    } else {
+      LOG(WARNING) << "Adaptive decode graph buckets need padded graph "
+                      "decode on a single node without data parallelism; "
+                      "ignoring enable_adaptive_decode_graph_buckets.";
+    }
+  }
+
   // Construct the scheduling policy from the resolved BatchMode.
   policy_ = create_scheduler_policy(batch_mode_, options_);
 
@@ -180,14 +201,19 @@ bool ContinuousScheduler::add_request(std::shared_ptr<Request>& request) {
   CHECK(request != nullptr);
   CHECK(!request->sequences().empty());
 
-  {
-    std::lock_guard<std::mutex> lock(prefetch_admission_mutex_);
-    if (request_queue_.size() + prefetch_admission_slots_ >=
-        prefetch_admission_limit_) {
-      return false;
-    }
-    ++prefetch_admission_slots_;
+  // the bound is approximate under racing producers, just like
+  // request_queue_.size() is.
+  const size_t num_slots =
+      prefetch_admission_slots_.fetch_add(1, std::memory_order_relaxed);
+  if (request_queue_.size() + num_slots >= prefetch_admission_limit_) {
+    prefetch_admission_slots_.fetch_sub(1, std::memory_order_relaxed);
+    return false;
   }
+  FlightRecorder::get_instance().record_request_event(
+      "request.arrive",
+      request->request_id(),
+      {{"prompt_tokens",
+        static_cast<int64_t>(request->sequences()[0]->num_prompt_tokens())}});
 
   kv_cache_manager_->prefetch_from_storage(request);
   if (kv_cache_manager_->update_prefetch_result(request,
@@ -217,18 +243,26 @@ bool ContinuousScheduler::add_request(std::shared_ptr<Request>& request) {
 
 bool ContinuousScheduler::enqueue_ready_request(
     std::shared_ptr<Request> request) {
-  return request_queue_.write(std::move(request));
+  return write_request_queue(std::move(request));
+}
+
+bool ContinuousScheduler::write_request_queue(
+    std::shared_ptr<Request> request) {
+  if (!request_queue_.write(std::move(request))) {
+    return false;
+  }
+  work_signal_.notify();
+  return true;
 }
 
 size_t ContinuousScheduler::num_prefetch_pending_requests() const {
-  std::lock_guard<std::mutex> lock(prefetch_admission_mutex_);
-  return prefetch_admission_slots_;
+  return prefetch_admission_slots_.load(std::memory_order_relaxed);
 }
 
 void ContinuousScheduler::release_prefetch_admission_slot() {
-  std::lock_guard<std::mutex> lock(prefetch_admission_mutex_);
-  CHECK_GT(prefetch_admission_slots_, 0u);
-  --prefetch_admission_slots_;
+  const size_t num_slots =
+      prefetch_admission_slots_.fetch_sub(1, std::memory_order_relaxed);
+  CHECK_GT(num_slots, 0u);
 }
 
 void ContinuousScheduler::drain_prefetched_requests() {
@@ -276,6 +310,13 @@ void ContinuousScheduler::create_queues(const Options& options) {
     prefill_queue_ = std::make_unique<DequeQueue>();
     chunk_queue_ = std::make_unique<DequeQueue>();
     decode_queue_ = std::make_unique<DequeQueue>();
+  } else if (options.priority_strategy() == "fair") {
+    // an ordered set rather than a heap, so that SLO admission can walk the
+    // requests queued ahead of a new one.
+    auto cmp = create_comparator(options.priority_strategy(), true);
+    prefill_queue_ = std::make_unique<SetQueue>(cmp);
+    chunk_queue_ = std::make_unique<SetQueue>(cmp);
+    decode_queue_ = std::make_unique<SetQueue>(cmp);
   } else {
     auto prefill_cmp = create_comparator(options.priority_strategy(), false);
     auto decode_cmp = create_comparator(options.priority_strategy(), true);
@@ -297,8 +338,38 @@ void ContinuousScheduler::clear_mtp_bootstrap(Request* request) {
   sequence->clear_mtp_bootstrap_embedding();
 }
 
+bool ContinuousScheduler::tracks_released_requests() const {
+  return options_.num_speculative_tokens() > 0;
+}
+
+void ContinuousScheduler::queue_released_requests(
+    const std::vector<std::shared_ptr<Request>>& requests) {
+  if (!tracks_released_requests()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(released_request_ids_mutex_);
+  for (const std::shared_ptr<Request>& request : requests) {
+    released_request_ids_.emplace_back(request->request_id());
+  }
+}
+
+void ContinuousScheduler::attach_released_requests(
+    std::vector<Batch>& batches) {
+  std::lock_guard<std::mutex> lock(released_request_ids_mutex_);
+  if (released_request_ids_.empty()) {
+    return;
+  }
+  // a request lives on one dp rank, the others ignore its id.
+  for (Batch& batch : batches) {
+    batch.set_released_request_ids(released_request_ids_);
+  }
+  released_request_ids_.clear();
+}
+
 std::vector<Batch> ContinuousScheduler::prepare_batch() {
   Timer timer;
+  FlightRecorder& recorder = FlightRecorder::get_instance();
+  const int64_t begin_us = recorder.enabled() ? FlightRecorder::now_us() : 0;
   drain_prefetched_requests();
   auto state = make_state();
 
@@ -321,6 +392,7 @@ std::vector<Batch> ContinuousScheduler::prepare_batch() {
 
   // Finalize
   if (!finished.empty()) {
+    queue_released_requests(finished);
     response_processor_->process_completed_requests(finished);
   }
 
@@ -335,13 +407,43 @@ std::vector<Batch> ContinuousScheduler::prepare_batch() {
       batches.begin(), batches.end(), [](const Batch& b) { return b.empty(); });
   if (!is_batches_empty) {
     COUNTER_ADD(scheduling_latency_seconds, timer.elapsed_seconds());
+    attach_released_requests(batches);
     kv_cache_manager_->transfer_blocks(batches);
   } else {
     kv_cache_manager_->transfer_blocks();
   }
 
+  if (!is_batches_empty && decode_graph_bucket_tuner_ != nullptr &&
+      std::none_of(running_sequences_.begin(),
+                   running_sequences_.end(),
+                   [](const Sequence* sequence) {
+                     return sequence->is_prefill_stage();
+                   })) {
+    decode_graph_bucket_tuner_->record(
+        static_cast<int64_t>(running_sequences_.size()));
+  }
+
   policy_->report_metrics(
       state, timer.elapsed_seconds(), budget.num_preempted_requests);
+  // idle polls are not recorded, so the ring only holds real steps.
+  if (!is_batches_empty && recorder.enabled()) {
+    int64_t num_prefill_sequences = 0;
+    int64_t num_prefix_cache_tokens = 0;
+    for (const Sequence* sequence : running_sequences_) {
+      if (sequence->is_prefill_stage()) {
+        ++num_prefill_sequences;
+        num_prefix_cache_tokens += sequence->num_prefix_cache_tokens();
+      }
+    }
+    recorder.record_span(
+        "scheduler.schedule",
+        begin_us,
+        FlightRecorder::now_us(),
+        {{"running_requests", static_cast<int64_t>(running_requests_.size())},
+         {"prefill_sequences", num_prefill_sequences},
+         {"prefix_cache_tokens", num_prefix_cache_tokens},
+         {"preempted", static_cast<int64_t>(budget.num_preempted_requests)}});
+  }
   return batches;
 }
 
@@ -385,14 +487,20 @@ std::vector<Batch> ContinuousScheduler::schedule_request(
     }
 
     const auto now = absl::Now();
-    if (now > deadline) {
+    if (now > deadline ||
+        pause_state_.load(std::memory_order_acquire) != PauseState::RUNNING) {
       break;
     }
-    // wait for new requests to arrive
-    constexpr uint64_t kStepSleepTimeMs = 1;
-    const auto time_to_sleep =
-        std::min(absl::Milliseconds(kStepSleepTimeMs), deadline - now);
-    absl::SleepFor(time_to_sleep);
+    // wait for new requests to arrive. writes to request_queue_ wake the
+    // loop up at once; requests waiting on a storage prefetch have no wakeup
+    // and are still polled every millisecond.
+    constexpr uint64_t kPrefetchPollTimeMs = 1;
+    absl::Duration time_to_wait = deadline - now;
+    if (num_prefetch_pending_requests() > 0) {
+      time_to_wait =
+          std::min(absl::Milliseconds(kPrefetchPollTimeMs), time_to_wait);
+    }
+    work_signal_.wait_for(absl::ToChronoNanoseconds(time_to_wait));
   }
   // return an empty batch
   return batch;
@@ -443,9 +551,12 @@ void ContinuousScheduler::step(const absl::Duration& timeout) {
           return one_batch.empty();
         });
     if (all_empty) {
+      retune_decode_graph_buckets();
       return;
     }
 
+    FlightRecorderSpan span("scheduler.step");
+    span.set_arg("sequences", static_cast<int64_t>(running_sequences_.size()));
     if (!options_.enable_pd_ooc()) {
       engine_->step(batch);
     } else {
@@ -472,9 +583,13 @@ void ContinuousScheduler::step_with_schedule_overlap(
         return one_batch.empty();
       });
   if (cur_batch_all_empty && last_batch_all_empty) {
+    retune_decode_graph_buckets();
     return;
   }
 
+  FlightRecorderSpan span("scheduler.step");
+  span.set_arg("sequences", static_cast<int64_t>(running_sequences_.size()));
+
   if (!cur_batch_all_empty) {
     engine_->step(batch);
   }
@@ -490,6 +605,18 @@ void ContinuousScheduler::step_with_schedule_overlap(
   is_first_step_ = false;
 }
 
+void ContinuousScheduler::retune_decode_graph_buckets() {
+  if (decode_graph_bucket_tuner_ == nullptr) {
+    return;
+  }
+  // only called with no step in flight, so every executor sees the new
+  // buckets from the same step on.
+  const std::vector<int64_t> added = decode_graph_bucket_tuner_->retune();
+  if (!added.empty()) {
+    profile_manager_->warmup_decode_graph_buckets(added);
+  }
+}
+
 void ContinuousScheduler::generate() {
   bool batch_empty = false;
   while (num_pending_requests() > 0 || !batch_empty ||
@@ -839,6 +966,8 @@ void ContinuousScheduler::pause(PauseMode mode) {
     LOG(WARNING) << "Scheduler already paused or pausing";
     return;
   }
+  // let an idle step() return to complete the pause.
+  work_signal_.notify();
 
   LOG(INFO) << "Scheduler pause requested (mode=" << mode_str
             << "). Running requests: " << running_requests_.size();
@@ -38,8 +38,11 @@ limitations under the License.
 #include "framework/request/sequence.h"
 #include "runtime/xservice_client.h"
 #include "scheduler.h"
+#include "scheduler/decode_graph_bucket_tuner.h"
 #include "scheduler/profile/profile_manager.h"
 #include "scheduler/request_priority_queue.h"
+#include "util/mpsc_batch_queue.h"
+#include "util/work_signal.h"
 
 namespace xllm {
 class Engine;
@@ -68,17 +71,19 @@ struct BatchMode {
   // "multi_slo_and_prio": multi-priority multi-SLO aware scheduling (ProSched)
   // "priority": static priority weight
   // "deadline": earliest-deadline-first
+  // "fair": weighted fair queuing across tenants
   std::string priority_strategy = "fcfs";
 };
 
+// Cancellations from the response threads, applied by the scheduler loop once
+// per step. Lock-free on both sides.
 class CancelRequestQueue final {
  public:
   void submit(std::shared_ptr<Request> request);
   std::vector<std::shared_ptr<Request>> take_all();
 
  private:
-  std::mutex mutex_;
-  std::vector<std::shared_ptr<Request>> requests_;
+  MpscBatchQueue<std::shared_ptr<Request>> requests_;
 };
 
 class ContinuousScheduler : public Scheduler {
@@ -138,8 +143,11 @@ class ContinuousScheduler : public Scheduler {
 
     // TODO: think if distinguish prefill and decode priority strategy
     PROPERTY(std::string,
-             priority_strategy) = "fcfs";  // priority, deadline, fcfs
+             priority_strategy) = "fcfs";  // priority, deadline, fcfs, fair
     PROPERTY(bool, enable_online_preempt_offline) = true;
+    // preempted sequences swap their KV cache out to the host cache when
+    // that is predicted to be cheaper than recomputing it.
+    PROPERTY(bool, enable_swap_preemption) = false;
 
     PROPERTY(bool, enable_profile_step_time) = false;
     // use predicted latency for latency aware schedule
@@ -286,9 +294,20 @@ class ContinuousScheduler : public Scheduler {
 
  protected:
   void clear_mtp_bootstrap(Request* request);
+  // Speculative workers keep per-request state (n-gram indices) that lives
+  // until the scheduler releases the request. The ids of finished requests
+  // are queued here and handed to the next non-empty step's batches.
+  void queue_released_requests(
+      const std::vector<std::shared_ptr<Request>>& requests);
+  void attach_released_requests(std::vector<Batch>& batches);
+  // Whether the workers keep per-request state to be released.
+  virtual bool tracks_released_requests() const;
   void drain_prefetched_requests();
   void release_prefetch_admission_slot();
   virtual bool enqueue_ready_request(std::shared_ptr<Request> request);
+  // Writes to request_queue_ and wakes up an idle scheduler loop. Every
+  // producer of request_queue_ goes through here.
+  bool write_request_queue(std::shared_ptr<Request> request);
 
   static int64_t microseconds_to_milliseconds(int64_t microseconds);
   // i.e. round(latency / num_tokens). num_tokens must be > 0.
@@ -313,11 +332,16 @@ class ContinuousScheduler : public Scheduler {
   // owns the requests and manages their lifetimes.
   folly::MPMCQueue<std::shared_ptr<Request>> request_queue_;
 
+  // notified on every write to request_queue_ and on pause(), so that an
+  // idle step() blocks instead of polling.
+  WorkSignal work_signal_;
+
   // Requests waiting for Mooncake prefetch completion. This is an admission
   // barrier only; SchedulerPolicy never sees these requests.
   mutable std::mutex prefetch_admission_mutex_;
   std::deque<std::shared_ptr<Request>> prefetch_admission_queue_;
-  size_t prefetch_admission_slots_ = 0;
+  // reserved without the mutex, so the hot add_request() path is lock-free.
+  std::atomic<size_t> prefetch_admission_slots_{0};
   size_t prefetch_admission_limit_ = 0;
 
   // a batch of requests in running state, sorted by priority from high to low.
@@ -341,6 +365,9 @@ class ContinuousScheduler : public Scheduler {
 
   std::unique_ptr<ProfileManager> profile_manager_;
 
+  // set when enable_adaptive_decode_graph_buckets applies to this instance.
+  std::unique_ptr<DecodeGraphBucketTuner> decode_graph_bucket_tuner_;
+
   bool enable_prefix_cache_ = false;
   bool has_linear_attention_layers_ = false;
   bool enable_in_batch_prefix_cache_ = false;
@@ -387,6 +414,10 @@ class ContinuousScheduler : public Scheduler {
   std::vector<Sequence*> last_running_sequences_;
   bool is_first_step_ = true;
 
+  // ids of finished requests not yet handed to the workers
+  std::mutex released_request_ids_mutex_;
+  std::vector<std::string> released_request_ids_;
+
   // Pause state (atomic for thread-safe access)
   std::atomic<PauseState> pause_state_{PauseState::RUNNING};
   // How to handle in-flight requests for the current pause. Only read while
@@ -412,6 +443,9 @@ class ContinuousScheduler : public Scheduler {
 
   void step_with_schedule_overlap(const absl::Duration& timeout);
 
+  // Refits the decode graph buckets while the scheduler is idle.
+  void retune_decode_graph_buckets();
+
   void step_with_pd_ooc(std::vector<Batch>& batch);
 
   void refresh_sequences_from_requests(
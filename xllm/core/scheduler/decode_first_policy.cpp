@@ -18,6 +18,7 @@ limitations under the License.
 #include <cstdint>
 #include <limits>
 
+#include "core/framework/config/profile_config.h"
 #include "scheduler/scheduler_policy.h"
 #include "util/utils.h"
 
@@ -82,8 +83,16 @@ void DecodeFirstPolicy::schedule(
         &state.prefill_queue, state, budget, finished, reserved_full_footprint);
   }
 
-  // Step 3: redistribute remaining budget to prefill sequences.
-  if (budget.remaining_token_budget > 0 &&
+  // Step 3: redistribute remaining budget to prefill sequences. Chunks sized
+  // from the step-time model already fill the step; without latency aware
+  // scheduling, growing them here would overrun it.
+  const bool chunks_sized_by_latency =
+      ProfileConfig::get_instance().enable_adaptive_prefill_chunk() &&
+      !options_.enable_latency_aware_schedule() &&
+      budget.latency_budget < std::numeric_limits<int32_t>::max() &&
+      state.profile_manager != nullptr &&
+      state.profile_manager->has_prefill_profile();
+  if (budget.remaining_token_budget > 0 && !chunks_sized_by_latency &&
       budget.latency_budget > budget.estimate_latency) {
     std::vector<Sequence*> prefill_stage_sequences;
     for (size_t i = 0; i < state.running_sequences.size(); ++i) {
@@ -0,0 +1,98 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "scheduler/decode_graph_bucket_tuner.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <iterator>
+
+#include "common/metrics.h"
+#include "runtime/decode_graph_bucket.h"
+
+namespace xllm {
+namespace {
+
+// decode steps recorded before a solve is worth its capture cost.
+constexpr int64_t kMinStepsPerSolve = 4096;
+// new buckets are only captured when they remove this much of the padding.
+constexpr double kMinPaddingReduction = 0.1;
+
+}  // namespace
+
+DecodeGraphBucketTuner::DecodeGraphBucketTuner(int64_t num_decoding_tokens,
+                                               int64_t max_num_sequences,
+                                               int32_t budget)
+    : num_decoding_tokens_(num_decoding_tokens),
+      remaining_budget_(std::max(budget, 0)) {
+  CHECK_GT(num_decoding_tokens, 0);
+  CHECK_GT(max_num_sequences, 0);
+  buckets_ = runtime::get_default_decode_graph_token_buckets(
+      max_num_sequences * num_decoding_tokens);
+  counts_.assign(buckets_.back() + 1, 0);
+}
+
+void DecodeGraphBucketTuner::record(int64_t num_sequences) {
+  const int64_t num_tokens = num_sequences * num_decoding_tokens_;
+  if (num_tokens <= 0 || num_tokens >= static_cast<int64_t>(counts_.size())) {
+    return;
+  }
+  ++counts_[num_tokens];
+  ++num_recorded_steps_;
+  COUNTER_ADD(decode_graph_token_rows_total, num_tokens);
+  COUNTER_ADD(decode_graph_padded_token_rows_total,
+              runtime::get_decode_graph_token_bucket(
+                  num_tokens, /*enable_no_padding=*/false) -
+                  num_tokens);
+}
+
+std::vector<int64_t> DecodeGraphBucketTuner::retune() {
+  if (remaining_budget_ == 0 || num_recorded_steps_ < kMinStepsPerSolve) {
+    return {};
+  }
+  const std::vector<int64_t> buckets =
+      runtime::solve_decode_graph_token_buckets(
+          counts_, buckets_, remaining_budget_);
+  const int64_t padding = runtime::get_decode_graph_padding(counts_, buckets_);
+  const int64_t tuned_padding =
+      runtime::get_decode_graph_padding(counts_, buckets);
+
+  // halve the histogram so it follows a shifting workload.
+  for (int64_t& count : counts_) {
+    count /= 2;
+  }
+  num_recorded_steps_ = 0;
+  if (padding == 0 ||
+      padding - tuned_padding < kMinPaddingReduction * padding) {
+    return {};
+  }
+
+  std::vector<int64_t> added;
+  std::set_difference(buckets.begin(),
+                      buckets.end(),
+                      buckets_.begin(),
+                      buckets_.end(),
+                      std::back_inserter(added));
+  remaining_budget_ -= static_cast<int32_t>(added.size());
+  buckets_ = buckets;
+  runtime::set_adaptive_decode_graph_token_buckets(buckets_);
+  LOG(INFO) << "Adaptive decode graph buckets: added " << added.size()
+            << ", expected padding rows " << padding << " -> "
+            << tuned_padding << ", remaining budget " << remaining_budget_;
+  return added;
+}
+
+}  // namespace xllm
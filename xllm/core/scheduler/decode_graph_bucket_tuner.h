@@ -0,0 +1,60 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace xllm {
+
+// Fits the process-wide decode graph buckets to the decode batch sizes the
+// workload actually runs. The scheduler records every pure decode step, and
+// while it is idle retune() solves the buckets with the least padding for the
+// recorded histogram. Captured graphs are never released, so the budget caps
+// the total number of buckets added over the lifetime of the process.
+class DecodeGraphBucketTuner final {
+ public:
+  // `num_decoding_tokens` token rows run per sequence in a decode step, and
+  // at most `max_num_sequences` sequences run in one. `budget` is the number
+  // of graphs that may be captured in addition to the default buckets.
+  DecodeGraphBucketTuner(int64_t num_decoding_tokens,
+                         int64_t max_num_sequences,
+                         int32_t budget);
+
+  // Records a decode step of `num_sequences` sequences.
+  void record(int64_t num_sequences);
+
+  // Solves new buckets once enough steps were recorded since the last solve,
+  // and installs them if they cut padding by a meaningful fraction. Returns
+  // the newly added buckets for the caller to capture, or an empty vector.
+  // Must be called while no decode step is in flight.
+  std::vector<int64_t> retune();
+
+ private:
+  const int64_t num_decoding_tokens_;
+
+  // counts_[n]: decode steps with n token rows, decayed on every solve.
+  std::vector<int64_t> counts_;
+
+  int64_t num_recorded_steps_ = 0;
+
+  // the installed buckets: the default ones plus every bucket added so far.
+  std::vector<int64_t> buckets_;
+
+  int32_t remaining_budget_ = 0;
+};
+
+}  // namespace xllm
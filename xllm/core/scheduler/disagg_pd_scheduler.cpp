@@ -605,7 +605,7 @@ void DisaggPDScheduler::dispatch_requests() {
         }
 
         // Push to request_queue_; it will be executed by the engine.
-        request_queue_.write(requests[i]);
+        write_request_queue(requests[i]);
       }
     }
     VLOG(1) << "Prefill Decode allocation request_id="
@@ -1024,7 +1024,7 @@ bool DisaggPDScheduler::decode_recv_first_generation(
   }
 
   Timer enqueue_timer;
-  if (!request_queue_.write(request)) {
+  if (!write_request_queue(request)) {
     LOG(ERROR) << "Failed to enqueue decode request, request_id: " << req_id;
     kv_cache_manager_->deallocate(request.get());
     return false;
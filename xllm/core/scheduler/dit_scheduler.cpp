@@ -20,8 +20,10 @@ limitations under the License.
 #include <folly/MPMCQueue.h>
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
+#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -91,12 +93,21 @@ int32_t true_cfg_condition_type(const std::shared_ptr<DiTRequest>& request) {
   return 3;
 }
 
+// requests advanced step by step draw their own initial noise, so they may
+// differ in seed.
 bool is_compatible_dit_batch_request(
     const std::shared_ptr<DiTRequest>& batch_request,
-    const std::shared_ptr<DiTRequest>& candidate_request) {
+    const std::shared_ptr<DiTRequest>& candidate_request,
+    bool allow_distinct_seeds = false) {
   const auto& batch_state = batch_request->state();
   const auto& candidate_state = candidate_request->state();
-  if (candidate_state.generation_params() != batch_state.generation_params()) {
+  DiTGenerationParams candidate_params = candidate_state.generation_params();
+  if (allow_distinct_seeds) {
+    candidate_params.seed = batch_state.generation_params().seed;
+    candidate_params.seed_is_set =
+        batch_state.generation_params().seed_is_set;
+  }
+  if (candidate_params != batch_state.generation_params()) {
     return false;
   }
   if (true_cfg_condition_type(candidate_request) !=
@@ -263,4 +274,103 @@ void DiTDynamicBatchScheduler::process_batch_output() {
   running_requests_.clear();
 }
 
+DiTStepBatchScheduler::DiTStepBatchScheduler(Engine* engine,
+                                             const Options& options)
+    : DiTDynamicBatchScheduler(engine, options) {}
+
+void DiTStepBatchScheduler::step(const absl::Duration& timeout) {
+  std::vector<DiTBatch> batches = schedule_request(timeout);
+  bool all_empty =
+      std::all_of(batches.begin(), batches.end(), [](const DiTBatch& batch) {
+        return batch.empty();
+      });
+  if (all_empty) {
+    return;
+  }
+
+  engine_->step(batches);
+
+  // finished requests leave, the others continue at the next step.
+  for (auto& request : retire_finished_dit_step_requests(running_requests_)) {
+    response_handler_->process_completed_request(std::move(request));
+  }
+}
+
+std::vector<DiTBatch> DiTStepBatchScheduler::prepare_batch() {
+  DiTBatch batch = prepare_dit_step_batch(
+      static_cast<size_t>(options_.max_request_per_batch()),
+      [this](std::shared_ptr<DiTRequest>& request) {
+        return request_queue_.read(request);
+      },
+      deferred_requests_,
+      running_requests_);
+
+  GAUGE_SET(num_pending_requests,
+            pending_requests_.load(std::memory_order_relaxed));
+  GAUGE_SET(num_running_requests, running_requests_.size());
+  GAUGE_SET(num_waiting_requests,
+            request_queue_.size() + deferred_requests_.size());
+
+  return {batch};
+}
+
+DiTBatch prepare_dit_step_batch(
+    size_t max_requests,
+    const std::function<bool(std::shared_ptr<DiTRequest>&)>& read_request,
+    std::deque<std::shared_ptr<DiTRequest>>& waiting,
+    std::vector<std::shared_ptr<DiTRequest>>& running) {
+  DiTBatch batch;
+  auto disconnected_begin = std::stable_partition(
+      running.begin(),
+      running.end(),
+      [](const std::shared_ptr<DiTRequest>& request) {
+        return !request->is_disconnected();
+      });
+  for (auto it = disconnected_begin; it != running.end(); ++it) {
+    LOG(INFO) << "DiT request " << (*it)->request_id()
+              << " is cancelled at denoising step " << (*it)->denoise_step();
+    batch.release_step_request((*it)->request_id());
+  }
+  running.erase(disconnected_begin, running.end());
+
+  while (running.size() < max_requests) {
+    std::shared_ptr<DiTRequest> request;
+    if (!waiting.empty()) {
+      request = waiting.front();
+    } else if (read_request(request)) {
+      waiting.emplace_back(request);
+    } else {
+      break;
+    }
+    if (!running.empty() &&
+        !is_compatible_dit_batch_request(running.front(),
+                                         request,
+                                         /*allow_distinct_seeds=*/true)) {
+      break;
+    }
+    waiting.pop_front();
+    running.emplace_back(std::move(request));
+  }
+
+  for (const auto& request : running) {
+    batch.add_step_request(request);
+  }
+  return batch;
+}
+
+std::vector<std::shared_ptr<DiTRequest>> retire_finished_dit_step_requests(
+    std::vector<std::shared_ptr<DiTRequest>>& running) {
+  auto finished_begin = std::stable_partition(
+      running.begin(),
+      running.end(),
+      [](const std::shared_ptr<DiTRequest>& request) {
+        return !request->denoise_finished();
+      });
+  std::vector<std::shared_ptr<DiTRequest>> finished(
+      std::make_move_iterator(finished_begin),
+      std::make_move_iterator(running.end()));
+  running.erase(finished_begin, running.end());
+  return finished;
+}
+
 }  // namespace xllm
@@ -20,6 +20,7 @@ limitations under the License.
 #include <folly/futures/Future.h>
 
 #include <deque>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <queue>
@@ -64,6 +65,8 @@ class DiTScheduler : public SchedulerBase {
     // the request per batch
     PROPERTY(int32_t, max_request_per_batch) = 4;
     PROPERTY(bool, disable_log_stats) = false;
+    // batch requests per denoising step, see DiTStepBatchScheduler
+    PROPERTY(bool, enable_step_batching) = false;
   };
 
   ~DiTScheduler() override = default;
@@ -128,11 +131,46 @@ class DiTDynamicBatchScheduler : public DiTScheduler {
   // build a batch of requests from the priority queue
   virtual std::vector<DiTBatch> prepare_batch();
 
- private:
   std::vector<DiTBatch> schedule_request(const absl::Duration& timeout);
 
+ private:
   // process the batch output
   void process_batch_output();
 };
 
+// Iteration-level scheduling for DiT: each engine step advances the running
+// batch by one denoising step. Compatible requests (same resolution, step
+// count and conditioning layout) join at step boundaries and finished
+// requests leave right away, so a new request waits for one step rather than
+// for a whole generation.
+//
+// Running requests whose client disconnected leave the batch at the next step
+// boundary and the workers drop their denoising state.
+class DiTStepBatchScheduler final : public DiTDynamicBatchScheduler {
+ public:
+  DiTStepBatchScheduler(Engine* engine, const Options& options);
+  ~DiTStepBatchScheduler() override = default;
+
+  void step(const absl::Duration& timeout) override;
+
+ protected:
+  std::vector<DiTBatch> prepare_batch() override;
+};
+
+// Builds the batch of the next denoising step for DiTStepBatchScheduler.
+// Disconnected requests leave `running` and are released in the batch. Then
+// waiting requests, from `waiting` first and `read_request` next, are
+// admitted in arrival order while they fit and match the running batch; an
+// incompatible request waits at the head of `waiting` until the batch drains.
+DiTBatch prepare_dit_step_batch(
+    size_t max_requests,
+    const std::function<bool(std::shared_ptr<DiTRequest>&)>& read_request,
+    std::deque<std::shared_ptr<DiTRequest>>& waiting,
+    std::vector<std::shared_ptr<DiTRequest>>& running);
+
+// Removes the requests past their last denoising step from `running` and
+// returns them in order.
+std::vector<std::shared_ptr<DiTRequest>> retire_finished_dit_step_requests(
+    std::vector<std::shared_ptr<DiTRequest>>& running);
+
 }  // namespace xllm
@@ -177,6 +177,10 @@ void FixedStepsScheduler::handle_prefill_requests(
   }
 }
 
+bool FixedStepsScheduler::tracks_released_requests() const {
+  return ::xllm::RecConfig::get_instance().enable_constrained_decoding();
+}
+
 std::vector<Batch> FixedStepsScheduler::prepare_batch() {
   Timer timer;
   drain_prefetched_requests();
@@ -262,6 +266,7 @@ std::vector<Batch> FixedStepsScheduler::prepare_batch() {
   //     remaining_token_budget, remaining_seq_budget, num_preempted_requests);
 
   if (!finished_requests.empty()) {
+    queue_released_requests(finished_requests);
     response_processor_->process_completed_requests(finished_requests);
   }
 
@@ -284,6 +289,7 @@ std::vector<Batch> FixedStepsScheduler::prepare_batch() {
   if (!batches[0].empty()) {
     // only update the scheduling latency when there are requests to process
     COUNTER_ADD(scheduling_latency_seconds, timer.elapsed_seconds());
+    attach_released_requests(batches);
     kv_cache_manager_->transfer_blocks(batches);
   } else {
     kv_cache_manager_->transfer_blocks();
@@ -381,6 +387,7 @@ void FixedStepsScheduler::step(const absl::Duration& timeout) {
 
       // Process finished requests
       if (!finished_requests.empty()) {
+        queue_released_requests(finished_requests);
         response_processor_->process_completed_requests(finished_requests);
       }
 
@@ -118,6 +118,9 @@ class FixedStepsScheduler final : public ContinuousScheduler {
   // build a batch of requests from the priority queue
   std::vector<Batch> prepare_batch() override;
 
+  // constrained decoding pins a catalog version per request.
+  bool tracks_released_requests() const override;
+
   void handle_prefill_requests(
       size_t& remaining_token_budget,
       size_t& remaining_seq_budget,
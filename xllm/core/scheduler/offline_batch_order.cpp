@@ -0,0 +1,54 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "scheduler/offline_batch_order.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace xllm {
+
+std::vector<size_t> prefix_sorted_order(
+    const std::vector<std::vector<int32_t>>& prompt_tokens,
+    const std::vector<size_t>& expected_lengths,
+    int32_t block_size) {
+  CHECK_EQ(prompt_tokens.size(), expected_lengths.size());
+  CHECK_GT(block_size, 0);
+  const size_t block = static_cast<size_t>(block_size);
+
+  std::vector<size_t> order(prompt_tokens.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    const std::vector<int32_t>& lhs_tokens = prompt_tokens[lhs];
+    const std::vector<int32_t>& rhs_tokens = prompt_tokens[rhs];
+    const auto lhs_end = lhs_tokens.begin() + lhs_tokens.size() / block * block;
+    const auto rhs_end = rhs_tokens.begin() + rhs_tokens.size() / block * block;
+    const auto [lhs_it, rhs_it] =
+        std::mismatch(lhs_tokens.begin(), lhs_end, rhs_tokens.begin(), rhs_end);
+    if (lhs_it != lhs_end && rhs_it != rhs_end) {
+      return *lhs_it < *rhs_it;
+    }
+    if (lhs_it != lhs_end || rhs_it != rhs_end) {
+      // one is a block prefix of the other, the shorter goes first.
+      return lhs_it == lhs_end;
+    }
+    return expected_lengths[lhs] > expected_lengths[rhs];
+  });
+  return order;
+}
+
+}  // namespace xllm
@@ -0,0 +1,38 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace xllm {
+
+// Admission order of an offline batch, as indices into `prompt_tokens`.
+//
+// Prompts are sorted by the tokens of their full KV blocks, the unit the
+// prefix cache shares, so prompts with common leading blocks are admitted
+// back to back while those blocks are still cached. Prompts whose full
+// blocks are equal go longest `expected_lengths` (prompt plus max generated
+// tokens) first, so the short ones fill the memory left over rather than
+// being preempted by a long one admitted late. Remaining ties keep their
+// input order.
+std::vector<size_t> prefix_sorted_order(
+    const std::vector<std::vector<int32_t>>& prompt_tokens,
+    const std::vector<size_t>& expected_lengths,
+    int32_t block_size);
+
+}  // namespace xllm
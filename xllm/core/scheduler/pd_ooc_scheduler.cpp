@@ -384,7 +384,7 @@ std::vector<Batch> PDOOCScheduler::prepare_batch() {
   }
 
   for (auto& req : deferred_reqs) {
-    request_queue_.write(req);
+    write_request_queue(req);
   }
   deferred_reqs.clear();
 
@@ -552,6 +552,7 @@ std::vector<Batch> PDOOCScheduler::prepare_batch() {
                            num_online_decode_preempt_offline_requests +
                            num_online_prefill_preempt_offline_requests;
   if (!finished_requests.empty()) {
+    queue_released_requests(finished_requests);
     response_processor_->process_completed_requests(finished_requests);
   }
 
@@ -567,6 +568,7 @@ std::vector<Batch> PDOOCScheduler::prepare_batch() {
   if (!is_batches_empty) {
     // only update the scheduling latency when there are requests to process
     COUNTER_ADD(scheduling_latency_seconds, timer.elapsed_seconds());
+    attach_released_requests(batches);
     kv_cache_manager_->transfer_blocks(batches);
   } else {
     kv_cache_manager_->transfer_blocks();
@@ -1412,7 +1414,7 @@ void PDOOCScheduler::dispatch_requests() {
     if (request->offline()) {
       // Handle offline requests locally. No need to dispatch them to decoding
       // instances.
-      request_queue_.write(request);
+      write_request_queue(request);
       continue;
     }
 
@@ -1526,7 +1528,7 @@ void PDOOCScheduler::dispatch_requests() {
         }
 
         // push to request_queue_, and will be executed by engine.
-        request_queue_.write(requests[i]);
+        write_request_queue(requests[i]);
         VLOG(1) << "Put a request into request_queue_";
       }
     }
@@ -1821,7 +1823,7 @@ bool PDOOCScheduler::decode_recv_multi_generations(
     }
   }
 
-  request_queue_.write(request);
+  write_request_queue(request);
   return true;
 }
 
@@ -1323,4 +1323,34 @@ void ProfileManager::warmup_decode_for_graph() {
             << ", decode_total_latency=" << decode_total_latency << " ms";
 }
 
+void ProfileManager::warmup_decode_graph_buckets(
+    const std::vector<int64_t>& token_buckets) {
+  const int64_t num_decoding_tokens =
+      decode_graph_warmup_plan_.execution_shape.num_decoding_tokens;
+  CHECK_GT(num_decoding_tokens, 0);
+  const int32_t max_context_len =
+      engine_->model_args().max_position_embeddings();
+  const int32_t decode_seq_len = std::min(16, max_context_len);
+
+  // largest first, for the same graph mempool reuse as the startup warmup.
+  for (auto it = token_buckets.rbegin(); it != token_buckets.rend(); ++it) {
+    const int32_t sequence_batch_size =
+        static_cast<int32_t>(*it / num_decoding_tokens);
+    if (sequence_batch_size == 0) {
+      continue;
+    }
+    if (measure_graph_decode_capacity(sequence_batch_size, decode_seq_len) <
+        sequence_batch_size) {
+      LOG(INFO) << "Skip decode graph warmup of token_bucket=" << *it
+                << ", not enough free blocks";
+      continue;
+    }
+    std::vector<int32_t> total_length_vec(sequence_batch_size, decode_seq_len);
+    const double latency = run_graph_decode_request(total_length_vec);
+    LOG(INFO) << "Decode graph warmup: token_bucket=" << *it
+              << ", sequence_batch=" << sequence_batch_size
+              << ", latency=" << latency << " ms";
+  }
+}
+
 }  // namespace xllm
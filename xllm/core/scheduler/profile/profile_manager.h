@@ -123,12 +123,22 @@ class ProfileManager {
 
   double get_constant_overhead();
 
+  // True once the prefill time predictor has been fitted.
+  bool has_prefill_profile() const {
+    return prefill_time_predictor_ && prefill_time_predictor_->is_trained();
+  }
+
   int32_t get_quadratic_root(Sequence* sequence, double budget);
 
   std::vector<double> get_coefficients(bool is_prefill = true);
 
   void profile_step_time(bool if_dump_to_file);
 
+  // Captures the decode graphs of token buckets added at runtime, e.g. by
+  // DecodeGraphBucketTuner. Buckets whose batch does not fit in the free KV
+  // cache are skipped and left to be captured by a real batch.
+  void warmup_decode_graph_buckets(const std::vector<int64_t>& token_buckets);
+
  private:
   void dump_step_time_profile_to_file(
       const std::vector<std::pair<int32_t, double>>& time_profiling_data,
@@ -17,7 +17,9 @@ limitations under the License.
 
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <tuple>
 #include <vector>
 
@@ -226,29 +228,35 @@ double TimePredictor::get_constant_overhead() {
 int32_t TimePredictor::get_quadratic_root(int32_t prefix_length,
                                           double budget) {
   CHECK(is_prefill_) << "This function is only for prefill.";
+  // time(x) = a * x^2 + b * x + c for x new tokens after the prefix, without
+  // the constant term, see predict_time().
   double a = 0.0, b = 0.0, c = 0.0;
   if (if_profile_prefix_) {
     a = coefficients_(1);
     b = coefficients_(2) + coefficients_(3) * prefix_length;
     c = coefficients_(4) * prefix_length - budget;
   } else {
-    a = coefficients_(1);
-    b = coefficients_(2);
+    a = coefficients_(2);
+    b = coefficients_(1);
     c = -budget;
   }
-  double discriminant = b * b - 4 * a * c;
-  if (discriminant < 0) {
-    LOG(ERROR) << "No real roots exist for the given budget: " << budget;
-    return prefix_length;  // No real roots exist
-  } else {
-    double root = (-b + std::sqrt(discriminant)) / (2 * a);
-    if (root >= 0) {
-      return static_cast<int32_t>(root) + prefix_length;
-    } else {
-      LOG(ERROR) << "roots are negative for the given budget: " << budget;
-      return prefix_length;  // Both roots are negative
+  double root = -1.0;
+  if (a > 0) {
+    const double discriminant = b * b - 4 * a * c;
+    if (discriminant >= 0) {
+      root = (-b + std::sqrt(discriminant)) / (2 * a);
     }
+  } else if (b > 0) {
+    // a linear fit, the quadratic term was clamped to 0.
+    root = -c / b;
+  }
+  if (root < 0) {
+    // the budget does not even cover the prefix term.
+    VLOG(1) << "No non-negative root for the given budget: " << budget;
+    return prefix_length;
   }
+  const double max_root = std::numeric_limits<int32_t>::max() - prefix_length;
+  return static_cast<int32_t>(std::min(root, max_root)) + prefix_length;
 }
 
 void TimePredictor::fit_for_prefill(
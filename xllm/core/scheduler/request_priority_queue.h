@@ -93,6 +93,7 @@ class RequestPriorityQueue {
   virtual ~RequestPriorityQueue() = default;
   virtual bool supports_sort() const { return false; }
   virtual void sort(const Comparator&) {}
+  virtual bool supports_iteration() const { return true; }
 
   virtual Iterator begin() const = 0;
   virtual Iterator end() const = 0;
@@ -131,6 +132,7 @@ class HeapQueue final : public RequestPriorityQueue {
   }
   bool supports_sort() const override { return false; }
   void sort(const Comparator&) override { NOT_IMPLEMENTED(); }
+  bool supports_iteration() const override { return false; }
 
   Iterator begin() const override {
     NOT_IMPLEMENTED();
@@ -166,9 +168,9 @@ class SetQueue final : public RequestPriorityQueue {
 
   void push(std::shared_ptr<Request> req) override { queue_.insert(req); }
   void push(std::shared_ptr<Request> req, bool if_back) override {
-    UNUSED_PARAMETER(req);
+    // The comparator decides the position.
     UNUSED_PARAMETER(if_back);
-    NOT_IMPLEMENTED();
+    queue_.insert(req);
   }
   void pop_top() override { queue_.erase(queue_.begin()); }
   void pop_back() override { queue_.erase(std::prev(queue_.end())); }
@@ -63,6 +63,9 @@ std::unique_ptr<ContinuousScheduler> create_continuous_scheduler(
 std::unique_ptr<DiTScheduler> create_dit_scheduler(
     Engine* engine,
     DiTScheduler::Options options) {
+  if (options.enable_step_batching()) {
+    return std::make_unique<DiTStepBatchScheduler>(engine, options);
+  }
   return std::make_unique<DiTDynamicBatchScheduler>(engine, options);
 }
 
@@ -18,14 +18,20 @@ limitations under the License.
 #include <glog/logging.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <iterator>
 #include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
 
 #include "async_response_processor.h"
 #include "common/metrics.h"
 #include "core/framework/config/kv_cache_config.h"
 #include "core/framework/config/kv_cache_store_config.h"
 #include "core/framework/config/parallel_config.h"
+#include "core/framework/config/profile_config.h"
 #include "core/framework/config/scheduler_config.h"
 #include "framework/batch/batch_factory.h"
 #include "framework/request/priority_comparator.h"
@@ -95,9 +101,87 @@ size_t get_sequence_free_blocks_for_rank(KVCacheManager* kv_cache_manager,
 // Construction
 // =============================================================================
 
+namespace {
+
+// prompt tokens of `request` that still have to be prefilled.
+int64_t num_prefill_tokens(Request* request) {
+  Sequence* sequence = request->sequences()[0].get();
+  const size_t num_cached = sequence->kv_state().kv_cache_tokens_num();
+  return sequence->num_tokens() > num_cached
+             ? static_cast<int64_t>(sequence->num_tokens() - num_cached)
+             : 0;
+}
+
+// Prefill tokens queued ahead of the requests admitted by one
+// drain_request_queue call. The queue is walked once and every admitted
+// request adds to the total. Under fair share only the requests with an
+// earlier or equal start tag are ahead; the queued ones are found by binary
+// search and only the requests admitted by this call are scanned.
+class PrefillTokensAhead final {
+ public:
+  PrefillTokensAhead(const RequestPriorityQueue& queue, bool by_fair_share_tag)
+      : by_fair_share_tag_(by_fair_share_tag) {
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+      std::shared_ptr<Request> queued = *it;
+      const int64_t num_tokens = num_prefill_tokens(queued.get());
+      total_ += num_tokens;
+      if (by_fair_share_tag_) {
+        queued_.emplace_back(queued->fair_share_tag(), num_tokens);
+      }
+    }
+    std::sort(queued_.begin(), queued_.end());
+    // running sums, so that an entry holds the tokens up to and including it.
+    for (size_t i = 1; i < queued_.size(); ++i) {
+      queued_[i].second += queued_[i - 1].second;
+    }
+  }
+
+  int64_t ahead_of(double fair_share_tag) const {
+    if (!by_fair_share_tag_) {
+      return total_;
+    }
+    auto it = std::upper_bound(
+        queued_.begin(),
+        queued_.end(),
+        fair_share_tag,
+        [](double tag, const std::pair<double, int64_t>& entry) {
+          return tag < entry.first;
+        });
+    int64_t num_tokens = it == queued_.begin() ? 0 : std::prev(it)->second;
+    for (const auto& [tag, tokens] : admitted_) {
+      if (tag <= fair_share_tag) {
+        num_tokens += tokens;
+      }
+    }
+    return num_tokens;
+  }
+
+  void add(double fair_share_tag, int64_t num_tokens) {
+    total_ += num_tokens;
+    if (by_fair_share_tag_) {
+      admitted_.emplace_back(fair_share_tag, num_tokens);
+    }
+  }
+
+ private:
+  const bool by_fair_share_tag_;
+  int64_t total_ = 0;
+  // (start tag, running token sum) of the queued requests, by tag
+  std::vector<std::pair<double, int64_t>> queued_;
+  // (start tag, tokens) of the requests admitted since
+  std::vector<std::pair<double, int64_t>> admitted_;
+};
+
+}  // namespace
+
 SchedulerPolicy::SchedulerPolicy(const BatchMode& mode,
                                  const ContinuousScheduler::Options& options)
-    : batch_mode_(mode), options_(options) {}
+    : batch_mode_(mode), options_(options) {
+  if (batch_mode_.priority_strategy == "fair") {
+    fair_share_ = std::make_unique<TenantFairShare>(
+        ::xllm::SchedulerConfig::get_instance().tenant_weights());
+  }
+}
 
 void SchedulerPolicy::adjust_latency_budget_and_reorder(
     RequestPriorityQueue* /*first_queue*/,
@@ -113,6 +197,20 @@ void SchedulerPolicy::adjust_latency_budget_and_reorder(
 void SchedulerPolicy::drain_request_queue(
     SchedulerState& state,
     folly::MPMCQueue<std::shared_ptr<Request>>& request_queue) {
+  if (fair_share_ != nullptr) {
+    fair_share_->advance(state.prefill_queue.empty()
+                             ? 0.0
+                             : state.prefill_queue.top()->fair_share_tag(),
+                         state.prefill_queue.empty());
+  }
+
+  // prefill work queued ahead of new requests; a heap cannot be walked, so
+  // only the request itself is counted there.
+  const bool count_tokens_ahead =
+      SchedulerConfig::get_instance().enable_slo_admission() &&
+      state.prefill_queue.supports_iteration();
+  std::optional<PrefillTokensAhead> tokens_ahead;
+
   std::shared_ptr<Request> request;
   while (request_queue.read(request)) {
     CHECK(request);
@@ -125,6 +223,30 @@ void SchedulerPolicy::drain_request_queue(
     }
 
     if (request->sequences()[0]->kv_state().kv_cache_tokens_num() == 0) {
+      const int64_t num_tokens = num_prefill_tokens(request.get());
+      if (fair_share_ != nullptr) {
+        request->set_fair_share_tag(
+            fair_share_->start_time(request->tenant()));
+      }
+
+      int64_t num_tokens_ahead = 0;
+      if (count_tokens_ahead) {
+        if (!tokens_ahead.has_value()) {
+          tokens_ahead.emplace(state.prefill_queue,
+                               /*by_fair_share_tag=*/fair_share_ != nullptr);
+        }
+        num_tokens_ahead = tokens_ahead->ahead_of(request->fair_share_tag());
+      }
+      if (reject_by_slo(request, num_tokens_ahead, state)) {
+        continue;
+      }
+      if (tokens_ahead.has_value()) {
+        tokens_ahead->add(request->fair_share_tag(), num_tokens);
+      }
+
+      if (fair_share_ != nullptr) {
+        fair_share_->assign(request->tenant(), num_tokens);
+      }
       // New request goes to waiting queue (back = FIFO from MPMC).
       state.prefill_queue.push(request, /*if_back=*/true);
     } else {
@@ -134,6 +256,52 @@ void SchedulerPolicy::drain_request_queue(
   }
 }
 
+bool SchedulerPolicy::reject_by_slo(const std::shared_ptr<Request>& request,
+                                    int64_t num_tokens_ahead,
+                                    SchedulerState& state) {
+  if (!SchedulerConfig::get_instance().enable_slo_admission() ||
+      request->ttft_slo_ms() == std::numeric_limits<int32_t>::max() ||
+      !state.profile_manager->has_prefill_profile()) {
+    return false;
+  }
+
+  // the queued prefill tokens run in batches of max_tokens_per_batch; decode
+  // steps interleaved with them are not counted, so this is a lower bound.
+  const int64_t max_tokens = std::max(options_.max_tokens_per_batch(), 1);
+  const int64_t num_tokens =
+      num_tokens_ahead + num_prefill_tokens(request.get());
+  const int64_t num_full_batches = num_tokens / max_tokens;
+  double predicted_ms = request->elapsed_seconds() * 1000.0;
+  if (num_full_batches > 0) {
+    predicted_ms += num_full_batches *
+                    state.profile_manager->predict_step_time(
+                        static_cast<int32_t>(max_tokens),
+                        /*prefix_length=*/0,
+                        /*if_need_add_constant_term=*/true,
+                        /*force_use_prefill_predictor=*/true);
+  }
+  if (num_tokens % max_tokens > 0) {
+    predicted_ms += state.profile_manager->predict_step_time(
+        static_cast<int32_t>(num_tokens % max_tokens),
+        /*prefix_length=*/0,
+        /*if_need_add_constant_term=*/true,
+        /*force_use_prefill_predictor=*/true);
+  }
+  if (predicted_ms <= request->ttft_slo_ms()) {
+    return false;
+  }
+
+  VLOG(1) << "Rejecting request " << request->request_id()
+          << ": predicted ttft " << predicted_ms << "ms exceeds the slo of "
+          << request->ttft_slo_ms() << "ms";
+  COUNTER_INC(server_request_total_slo_reject);
+  state.response_processor->process_failed_request(
+      request,
+      {StatusCode::RESOURCE_EXHAUSTED,
+       "The request cannot meet its time to first token SLO."});
+  return true;
+}
+
 std::vector<std::shared_ptr<Request>> SchedulerPolicy::collect_finished(
     SchedulerState& state) {
   std::vector<std::shared_ptr<Request>> finished_requests;
@@ -181,6 +349,16 @@ void SchedulerPolicy::schedule_prefill_from_queue(
   bool budget_exhausted = false;
   bool blocks_exhausted = false;
 
+  // without latency aware scheduling the budget does not account for the
+  // sequences already in the batch, so predict them once here and add the
+  // predicted time of every chunk sized below.
+  const bool adaptive_chunk =
+      ProfileConfig::get_instance().enable_adaptive_prefill_chunk();
+  double untracked_latency = 0;
+  if (adaptive_chunk && !options_.enable_latency_aware_schedule()) {
+    untracked_latency = predict_running_latency(state);
+  }
+
   while (!queue->empty() && budget.remaining_seq_budget > 0 &&
          budget.remaining_token_budget > 0 &&
          budget.latency_budget > budget.estimate_latency) {
@@ -240,10 +418,19 @@ void SchedulerPolicy::schedule_prefill_from_queue(
         continue;
       }
 
+      // an unset TPOT/TTFT target leaves the step time unbounded.
+      const double remaining_latency =
+          budget.latency_budget < std::numeric_limits<int32_t>::max()
+              ? budget.latency_budget - budget.estimate_latency -
+                    allocated_estimate_latency - untracked_latency
+              : std::numeric_limits<double>::infinity();
+      double chunk_latency = 0;
       size_t num_tokens = compute_prefill_tokens(
           prefill_sequence.get(),
           budget.remaining_token_budget - allocated_tokens,
-          state);
+          remaining_latency,
+          state,
+          &chunk_latency);
 
       if (budget.remaining_token_budget < allocated_tokens + num_tokens ||
           budget.remaining_seq_budget < allocated_seqs + 1) {
@@ -286,6 +473,9 @@ void SchedulerPolicy::schedule_prefill_from_queue(
       allocated_tokens += actual_tokens;
       allocated_seqs += 1;
       allocated_estimate_latency += seq_estimate_latency;
+      if (!options_.enable_latency_aware_schedule()) {
+        untracked_latency += chunk_latency;
+      }
     }
 
     if (!can_schedule) {
@@ -325,7 +515,10 @@ void SchedulerPolicy::schedule_prefill_from_queue(
 
 size_t SchedulerPolicy::compute_prefill_tokens(Sequence* seq,
                                                size_t remaining_budget,
-                                               const SchedulerState& state) {
+                                               double remaining_latency,
+                                               const SchedulerState& state,
+                                               double* chunk_latency) {
+  *chunk_latency = 0;
   if (!batch_mode_.enable_chunked_prefill) {
     // Full prefill: compute all remaining tokens.
     return seq->num_need_compute_tokens();
@@ -338,8 +531,30 @@ size_t SchedulerPolicy::compute_prefill_tokens(Sequence* seq,
   size_t assume_max = std::min(max_tokens_per_chunk, remaining_budget);
   num_tokens = std::min(assume_max, num_tokens);
 
-  // CP-aware chunk alignment.
   const size_t kv_cache_tokens_num = seq->kv_state().kv_cache_tokens_num();
+  const size_t block_size =
+      static_cast<size_t>(state.kv_cache_manager->block_size());
+
+  // Latency-aware chunk size: the longest chunk the prefill time model
+  // predicts to fit the rest of the step, in whole blocks. At least one
+  // block is kept so that a long prompt still makes progress.
+  const bool sized_by_latency =
+      ProfileConfig::get_instance().enable_adaptive_prefill_chunk() &&
+      std::isfinite(remaining_latency) &&
+      state.profile_manager->has_prefill_profile();
+  if (sized_by_latency) {
+    const int32_t fit_length =
+        state.profile_manager->get_quadratic_root(seq, remaining_latency);
+    size_t max_fit_tokens =
+        static_cast<size_t>(fit_length) > kv_cache_tokens_num
+            ? static_cast<size_t>(fit_length) - kv_cache_tokens_num
+            : 0;
+    max_fit_tokens = std::max(max_fit_tokens / block_size * block_size,
+                              block_size);
+    num_tokens = std::min(num_tokens, max_fit_tokens);
+  }
+
+  // CP-aware chunk alignment.
   const size_t remaining_in_seq = seq->num_tokens() > kv_cache_tokens_num
                                       ? seq->num_tokens() - kv_cache_tokens_num
                                       : 0;
@@ -350,9 +565,33 @@ size_t SchedulerPolicy::compute_prefill_tokens(Sequence* seq,
                                            state.kv_cache_manager->block_size(),
                                            remaining_in_seq);
 
+  if (sized_by_latency && num_tokens > 0) {
+    *chunk_latency = state.profile_manager->predict_step_time(
+        static_cast<int32_t>(kv_cache_tokens_num + num_tokens),
+        static_cast<int32_t>(kv_cache_tokens_num),
+        /*if_need_add_constant_term=*/false);
+  }
   return num_tokens;
 }
 
+double SchedulerPolicy::predict_running_latency(
+    const SchedulerState& state) const {
+  double latency = 0;
+  for (size_t i = 0; i < state.running_sequences.size(); ++i) {
+    if (state.running_sequences_budgets[i] == 0) {
+      continue;
+    }
+    Sequence* seq = state.running_sequences[i];
+    const size_t kv_cache_tokens_num = seq->kv_state().kv_cache_tokens_num();
+    latency += state.profile_manager->predict_step_time(
+        static_cast<int32_t>(kv_cache_tokens_num +
+                             state.running_sequences_budgets[i]),
+        static_cast<int32_t>(kv_cache_tokens_num),
+        /*if_need_add_constant_term=*/false);
+  }
+  return latency;
+}
+
 bool SchedulerPolicy::allocate_for_prefill(Sequence* seq,
                                            size_t token_budget,
                                            size_t* actual_tokens,
@@ -653,7 +892,7 @@ void SchedulerPolicy::schedule_decode_from_queue(RequestPriorityQueue* queue,
     if (!has_enough_blocks && !state.chunk_queue.empty()) {
       std::shared_ptr<Request> request_to_preempt = state.chunk_queue.back();
       ++budget.num_preempted_requests;
-      state.kv_cache_manager->deallocate(request_to_preempt.get());
+      preempt_request(request_to_preempt.get(), state);
       state.chunk_queue.pop_back();
       request_to_preempt->set_preempted();
       state.prefill_queue.push(request_to_preempt);
@@ -663,7 +902,7 @@ void SchedulerPolicy::schedule_decode_from_queue(RequestPriorityQueue* queue,
       std::shared_ptr<Request> request_to_preempt = queue->back();
       if (request_to_preempt.get() != request.get()) {
         ++budget.num_preempted_requests;
-        state.kv_cache_manager->deallocate(request_to_preempt.get());
+        preempt_request(request_to_preempt.get(), state);
         queue->pop_back();
         request_to_preempt->set_preempted();
         state.prefill_queue.push(request_to_preempt);
@@ -835,6 +1074,51 @@ void SchedulerPolicy::cache_in_batch_prefix(
   }
 }
 
+void SchedulerPolicy::preempt_request(Request* request,
+                                      SchedulerState& state) {
+  if (!options_.enable_swap_preemption()) {
+    state.kv_cache_manager->deallocate(request);
+    return;
+  }
+  for (auto& sequence : request->sequences()) {
+    const bool swap_out = should_swap_out(sequence.get(), state);
+    state.kv_cache_manager->preempt(sequence.get(), swap_out);
+    if (swap_out) {
+      COUNTER_ADD(preempted_sequences_total_swap, 1);
+    } else {
+      COUNTER_ADD(preempted_sequences_total_recompute, 1);
+    }
+  }
+}
+
+bool SchedulerPolicy::should_swap_out(Sequence* sequence,
+                                      const SchedulerState& state) const {
+  if (!options_.enable_swap_preemption() ||
+      !state.kv_cache_manager->supports_swap_preemption()) {
+    return false;
+  }
+  const size_t block_size = state.kv_cache_manager->block_size();
+  const size_t num_blocks =
+      sequence->kv_state().kv_cache_tokens_num() / block_size;
+  if (num_blocks == 0) {
+    return false;
+  }
+  if (state.profile_manager == nullptr ||
+      !state.profile_manager->has_prefill_profile()) {
+    return true;
+  }
+  // the blocks cross PCIe twice: out now and back in when resumed.
+  const double swap_time =
+      2 * state.profile_manager->predict_copy_blocks_time(
+              num_blocks, /*if_need_add_constant_term=*/false);
+  const double recompute_time = state.profile_manager->predict_step_time(
+      static_cast<int32_t>(num_blocks * block_size),
+      /*prefix_length=*/0,
+      /*if_need_add_constant_term=*/false,
+      /*force_use_prefill_predictor=*/true);
+  return swap_time < recompute_time;
+}
+
 void SchedulerPolicy::clear_mtp_bootstrap(Request* request,
                                           const SchedulerState& state) {
   if (!state.options.enable_disagg_pd() ||
@@ -29,6 +29,7 @@ limitations under the License.
 #include "scheduler/continuous_scheduler.h"
 #include "scheduler/profile/profile_manager.h"
 #include "scheduler/request_priority_queue.h"
+#include "scheduler/tenant_fair_share.h"
 
 namespace xllm {
 
@@ -150,9 +151,17 @@ class SchedulerPolicy {
       ScheduleBudget& budget,
       std::vector<std::shared_ptr<Request>>& finished,
       size_t& reserved_full_footprint);
+  // `remaining_latency` is the predicted time (ms) still free in this step;
+  // with enable_adaptive_prefill_chunk it caps the chunk length, and
+  // `chunk_latency` receives the predicted time of the returned chunk (0 when
+  // the chunk was not sized from the time model).
   size_t compute_prefill_tokens(Sequence* seq,
                                 size_t remaining_budget,
-                                const SchedulerState& state);
+                                double remaining_latency,
+                                const SchedulerState& state,
+                                double* chunk_latency);
+  // Predicted time (ms) of the sequences already in the batch.
+  double predict_running_latency(const SchedulerState& state) const;
   bool allocate_for_prefill(Sequence* seq,
                             size_t token_budget,
                             size_t* actual_tokens,
@@ -183,6 +192,10 @@ class SchedulerPolicy {
       size_t allocated_seqs,
       double allocated_estimate_latency,
       bool budget_exhausted);
+  // Releases the KV blocks of a request being preempted, swapping them out to
+  // the host tier when should_swap_out() prefers that over recomputation.
+  void preempt_request(Request* request, SchedulerState& state);
+  bool should_swap_out(Sequence* sequence, const SchedulerState& state) const;
 
   // ===== Helpers =====
   void cache_in_batch_prefix(const std::vector<Sequence*>& sequences,
@@ -190,8 +203,19 @@ class SchedulerPolicy {
                              SchedulerState& state);
   void clear_mtp_bootstrap(Request* request, const SchedulerState& state);
 
+  // ===== Admission =====
+  // Fails `request` and returns true if enable_slo_admission is on and its
+  // prefill, queued behind `num_tokens_ahead` prefill tokens, is predicted
+  // to finish past its ttft_slo_ms.
+  bool reject_by_slo(const std::shared_ptr<Request>& request,
+                     int64_t num_tokens_ahead,
+                     SchedulerState& state);
+
   BatchMode batch_mode_;
   const ContinuousScheduler::Options& options_;
+
+  // Virtual start times of the "fair" strategy; nullptr for the others.
+  std::unique_ptr<TenantFairShare> fair_share_;
 };
 
 // =============================================================================
@@ -0,0 +1,81 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tenant_fair_share.h"
+
+#include <absl/strings/numbers.h>
+#include <absl/strings/str_split.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace xllm {
+namespace {
+
+// finish times at or below the virtual time are swept once the map grows
+// past this size.
+constexpr size_t kMaxFinishTimes = 4096;
+
+}  // namespace
+
+TenantFairShare::TenantFairShare(const std::string& weights) {
+  if (weights.empty()) {
+    return;
+  }
+  const std::vector<std::string> entries = absl::StrSplit(weights, ',');
+  for (const auto& entry : entries) {
+    const std::vector<std::string> parts = absl::StrSplit(entry, ':');
+    CHECK(parts.size() == 2 && !parts[0].empty())
+        << "Invalid tenant weight: " << entry;
+    double weight = 0.0;
+    CHECK(absl::SimpleAtod(parts[1], &weight) && weight > 0)
+        << "Invalid tenant weight: " << entry;
+    weights_[parts[0]] = weight;
+  }
+}
+
+double TenantFairShare::weight(const std::string& tenant) const {
+  auto it = weights_.find(tenant);
+  return it == weights_.end() ? 1.0 : it->second;
+}
+
+double TenantFairShare::start_time(const std::string& tenant) const {
+  auto it = finish_times_.find(tenant);
+  return it == finish_times_.end() ? virtual_time_
+                                   : std::max(virtual_time_, it->second);
+}
+
+double TenantFairShare::assign(const std::string& tenant, double cost) {
+  if (finish_times_.size() > kMaxFinishTimes) {
+    for (auto it = finish_times_.begin(); it != finish_times_.end();) {
+      it = it->second <= virtual_time_ ? finish_times_.erase(it)
+                                       : std::next(it);
+    }
+  }
+  double& finish_time = finish_times_[tenant];
+  const double start_time = std::max(virtual_time_, finish_time);
+  finish_time = start_time + std::max(cost, 1.0) / weight(tenant);
+  max_finish_time_ = std::max(max_finish_time_, finish_time);
+  return start_time;
+}
+
+void TenantFairShare::advance(double head_tag, bool queue_empty) {
+  virtual_time_ =
+      std::max(virtual_time_, queue_empty ? max_finish_time_ : head_tag);
+}
+
+}  // namespace xllm
@@ -0,0 +1,64 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace xllm {
+
+// Start-time fair queuing of prefill work across tenants. A request gets the
+// virtual start time max(V, finish time of its tenant's previous request),
+// and pushes its tenant's finish time forward by cost / weight. Admitting
+// requests in start time order splits prefill throughput between backlogged
+// tenants in proportion to their weights, while a tenant that was idle starts
+// at the current virtual time V instead of cashing in saved-up credit.
+class TenantFairShare final {
+ public:
+  // `weights` is a "tenant:weight,tenant:weight" list; tenants not in the
+  // list, including requests without a tenant, weigh 1.
+  explicit TenantFairShare(const std::string& weights);
+
+  // Virtual start time the next request of `tenant` would get.
+  double start_time(const std::string& tenant) const;
+
+  // Charges a request of `tenant` costing `cost` and returns its virtual
+  // start time.
+  double assign(const std::string& tenant, double cost);
+
+  // Moves the virtual time to the start time of the queue head; called with
+  // `queue_empty` when nothing is waiting, which catches V up with all the
+  // work handed out so far.
+  void advance(double head_tag, bool queue_empty);
+
+  double weight(const std::string& tenant) const;
+
+  double virtual_time() const { return virtual_time_; }
+
+ private:
+  std::unordered_map<std::string, double> weights_;
+
+  // finish time of the last request of each tenant; an entry at or below the
+  // virtual time has no effect and is pruned.
+  std::unordered_map<std::string, double> finish_times_;
+
+  double virtual_time_ = 0.0;
+
+  double max_finish_time_ = 0.0;
+};
+
+}  // namespace xllm
@@ -313,7 +313,7 @@ void UnifiedPolicy::schedule_from_unified_queue(
                 .kv_cache_tokens_num() != 0) {
           ++budget.num_preempted_requests;
           clear_mtp_bootstrap(request_to_preempt.get(), state);
-          state.kv_cache_manager->deallocate(request_to_preempt.get());
+          preempt_request(request_to_preempt.get(), state);
           auto prev = preempt_iterator;
           preempt_iterator--;
           unified.erase(prev);
@@ -0,0 +1,199 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "core/util/flight_recorder.h"
+
+#include <glog/logging.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <nlohmann/json.hpp>
+#include <vector>
+
+namespace xllm {
+namespace {
+
+uint32_t current_tid() {
+  static std::atomic<uint32_t> next_tid{1};
+  thread_local const uint32_t tid =
+      next_tid.fetch_add(1, std::memory_order_relaxed);
+  return tid;
+}
+
+size_t round_up_to_power_of_two(size_t value) {
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+}  // namespace
+
+FlightRecorder& FlightRecorder::get_instance() {
+  static FlightRecorder instance;
+  return instance;
+}
+
+void FlightRecorder::initialize(bool enabled, size_t capacity) {
+  if (!enabled || capacity == 0) {
+    enabled_.store(false, std::memory_order_relaxed);
+    LOG(INFO) << "Flight recorder is disabled.";
+    return;
+  }
+  capacity_ = round_up_to_power_of_two(capacity);
+  slots_ = std::make_unique<Slot[]>(capacity_);
+  next_ticket_.store(0, std::memory_order_relaxed);
+  enabled_.store(true, std::memory_order_release);
+  LOG(INFO) << "Flight recorder enabled with " << capacity_ << " events ("
+            << capacity_ * sizeof(Slot) / 1024 << " KiB).";
+}
+
+int64_t FlightRecorder::now_us() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void FlightRecorder::record_span(const char* name,
+                                 int64_t begin_us,
+                                 int64_t end_us,
+                                 const Arg* args,
+                                 size_t num_args) {
+  if (!enabled()) {
+    return;
+  }
+  Event event;
+  event.name = name;
+  event.phase = 'X';
+  event.ts_us = begin_us;
+  event.dur_us = std::max<int64_t>(0, end_us - begin_us);
+  event.num_args = static_cast<uint8_t>(std::min(num_args, kMaxArgs));
+  std::copy(args, args + event.num_args, event.args);
+  record(event);
+}
+
+void FlightRecorder::record_request_event(const char* name,
+                                          std::string_view request_id,
+                                          std::initializer_list<Arg> args) {
+  if (!enabled()) {
+    return;
+  }
+  Event event;
+  event.name = name;
+  event.phase = 'i';
+  event.ts_us = now_us();
+  event.num_args = static_cast<uint8_t>(std::min(args.size(), kMaxArgs));
+  std::copy(args.begin(), args.begin() + event.num_args, event.args);
+  const size_t id_bytes =
+      std::min(request_id.size(), kMaxRequestIdBytes - 1);
+  std::memcpy(event.request_id, request_id.data(), id_bytes);
+  record(event);
+}
+
+void FlightRecorder::record(const Event& event_in) {
+  Event event = event_in;
+  event.tid = current_tid();
+  uint64_t words[kEventWords] = {};
+  std::memcpy(words, &event, sizeof(event));
+
+  const uint64_t ticket =
+      next_ticket_.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = slots_[ticket & (capacity_ - 1)];
+  // Claim the slot from its last published event. A writer that lapped the
+  // ring onto a slot still being written, or onto a newer event, drops its
+  // event instead of interleaving its words with the other writer's.
+  uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  do {
+    if ((sequence & 1) != 0 || sequence > 2 * ticket) {
+      return;
+    }
+  } while (!slot.sequence.compare_exchange_weak(
+      sequence, 2 * ticket + 1, std::memory_order_relaxed));
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < kEventWords; ++i) {
+    slot.words[i].store(words[i], std::memory_order_relaxed);
+  }
+  slot.sequence.store(2 * ticket + 2, std::memory_order_release);
+}
+
+std::string FlightRecorder::dump_chrome_trace() const {
+  std::vector<std::pair<uint64_t, Event>> events;
+  if (enabled()) {
+    events.reserve(capacity_);
+    for (size_t i = 0; i < capacity_; ++i) {
+      const Slot& slot = slots_[i];
+      const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+      if (before == 0 || (before & 1) != 0) {
+        continue;
+      }
+      uint64_t words[kEventWords];
+      for (size_t w = 0; w < kEventWords; ++w) {
+        words[w] = slot.words[w].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != before) {
+        continue;
+      }
+      Event event;
+      std::memcpy(&event, words, sizeof(event));
+      events.emplace_back(before / 2 - 1, event);
+    }
+  }
+  std::sort(events.begin(), events.end(), [](const auto& a, const auto& b) {
+    return a.first < b.first;
+  });
+
+  const int64_t pid = static_cast<int64_t>(::getpid());
+  nlohmann::json trace_events = nlohmann::json::array();
+  for (const auto& [ticket, event] : events) {
+    nlohmann::json entry = {{"name", event.name},
+                            {"cat", "xllm"},
+                            {"ph", std::string(1, event.phase)},
+                            {"ts", event.ts_us},
+                            {"pid", pid},
+                            {"tid", event.tid}};
+    if (event.phase == 'X') {
+      entry["dur"] = event.dur_us;
+    } else {
+      // thread-scoped instant event
+      entry["s"] = "t";
+    }
+    nlohmann::json args = nlohmann::json::object();
+    if (event.request_id[0] != '\0') {
+      args["request_id"] = std::string(event.request_id);
+    }
+    for (size_t i = 0; i < event.num_args; ++i) {
+      args[event.args[i].name] = event.args[i].value;
+    }
+    entry["args"] = std::move(args);
+    trace_events.push_back(std::move(entry));
+  }
+  nlohmann::json trace = {{"traceEvents", std::move(trace_events)},
+                          {"displayTimeUnit", "ms"}};
+  // request ids come from clients; never fail the dump on bad UTF-8.
+  return trace.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+FlightRecorderSpan::~FlightRecorderSpan() {
+  if (active()) {
+    FlightRecorder::get_instance().record_span(
+        name_, begin_us_, FlightRecorder::now_us(), args_, num_args_);
+  }
+}
+
+}  // namespace xllm
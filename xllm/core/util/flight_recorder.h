@@ -0,0 +1,152 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace xllm {
+
+// Always-on flight recorder for scheduler steps and request lifecycles.
+//
+// Events go into a fixed-size ring that overwrites the oldest entries, so the
+// recorder always holds the most recent window of activity and never
+// allocates after initialize(). Recording takes a ticket with one atomic
+// fetch_add, claims the ticket's slot with a CAS on its sequence number and
+// publishes it through that sequence number (a seqlock), so writers never
+// block each other and dump() never blocks writers. A writer that laps the
+// ring onto a slot another writer still holds drops its event, and a slot
+// that is being rewritten while it is dumped is skipped. When disabled, the
+// only cost is one relaxed atomic load.
+//
+// dump_chrome_trace() renders the window as Chrome trace JSON, which both
+// chrome://tracing and ui.perfetto.dev open directly.
+class FlightRecorder final {
+ public:
+  static constexpr size_t kMaxArgs = 4;
+  static constexpr size_t kMaxRequestIdBytes = 48;
+
+  // Names must be string literals or otherwise outlive the recorder.
+  struct Arg {
+    const char* name = nullptr;
+    int64_t value = 0;
+  };
+
+  static FlightRecorder& get_instance();
+
+  FlightRecorder(const FlightRecorder&) = delete;
+  FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+  // Must be called before any thread records. capacity is rounded up to a
+  // power of two.
+  void initialize(bool enabled, size_t capacity);
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+  size_t capacity() const { return capacity_; }
+
+  // Records a complete event spanning [begin_us, end_us] from now_us().
+  void record_span(const char* name,
+                   int64_t begin_us,
+                   int64_t end_us,
+                   std::initializer_list<Arg> args = {}) {
+    record_span(name, begin_us, end_us, args.begin(), args.size());
+  }
+  void record_span(const char* name,
+                   int64_t begin_us,
+                   int64_t end_us,
+                   const Arg* args,
+                   size_t num_args);
+
+  // Records an instant event tagged with a request id, truncated to
+  // kMaxRequestIdBytes - 1 bytes.
+  void record_request_event(const char* name,
+                            std::string_view request_id,
+                            std::initializer_list<Arg> args = {});
+
+  // Chrome trace JSON of the events currently in the ring, oldest first.
+  std::string dump_chrome_trace() const;
+
+  static int64_t now_us();
+
+ private:
+  FlightRecorder() = default;
+
+  // Plain copy of one event. Slots store it as relaxed atomic words so that
+  // a concurrent dump is a benign race rather than undefined behavior.
+  struct Event {
+    const char* name = nullptr;
+    int64_t ts_us = 0;
+    int64_t dur_us = 0;
+    uint32_t tid = 0;
+    char phase = 0;
+    uint8_t num_args = 0;
+    Arg args[kMaxArgs];
+    char request_id[kMaxRequestIdBytes] = {};
+  };
+  static constexpr size_t kEventWords =
+      (sizeof(Event) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  struct Slot {
+    // 2 * ticket + 1 while written, 2 * ticket + 2 once published.
+    std::atomic<uint64_t> sequence{0};
+    std::array<std::atomic<uint64_t>, kEventWords> words;
+  };
+
+  void record(const Event& event);
+
+  std::atomic<bool> enabled_{false};
+  size_t capacity_ = 0;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> next_ticket_{0};
+};
+
+// Records the lifetime of a scope as a complete event. Arguments can be
+// attached until the scope ends.
+class FlightRecorderSpan final {
+ public:
+  explicit FlightRecorderSpan(const char* name)
+      : name_(name),
+        begin_us_(FlightRecorder::get_instance().enabled()
+                      ? FlightRecorder::now_us()
+                      : -1) {}
+
+  ~FlightRecorderSpan();
+
+  FlightRecorderSpan(const FlightRecorderSpan&) = delete;
+  FlightRecorderSpan& operator=(const FlightRecorderSpan&) = delete;
+
+  bool active() const { return begin_us_ >= 0; }
+
+  void set_arg(const char* name, int64_t value) {
+    if (num_args_ < FlightRecorder::kMaxArgs) {
+      args_[num_args_++] = {name, value};
+    }
+  }
+
+ private:
+  const char* name_;
+  int64_t begin_us_;
+  size_t num_args_ = 0;
+  FlightRecorder::Arg args_[FlightRecorder::kMaxArgs];
+};
+
+}  // namespace xllm
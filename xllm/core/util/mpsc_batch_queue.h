@@ -0,0 +1,83 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace xllm {
+
+// Lock-free multi-producer single-consumer queue that is drained as a whole.
+// push() is one compare-and-swap on a linked stack; take_all() detaches the
+// stack with a single exchange and returns the items in push order. As the
+// consumer never pops single nodes, there is no ABA problem.
+template <typename T>
+class MpscBatchQueue final {
+ public:
+  MpscBatchQueue() = default;
+
+  ~MpscBatchQueue() { delete_nodes(head_.exchange(nullptr)); }
+
+  MpscBatchQueue(const MpscBatchQueue&) = delete;
+  MpscBatchQueue& operator=(const MpscBatchQueue&) = delete;
+
+  // Safe to call from any number of threads.
+  void push(T value) {
+    Node* node =
+        new Node{std::move(value), head_.load(std::memory_order_relaxed)};
+    while (!head_.compare_exchange_weak(node->next,
+                                        node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+  }
+
+  // Returns everything pushed so far, oldest first. Single consumer only.
+  std::vector<T> take_all() {
+    Node* head = head_.exchange(nullptr, std::memory_order_acquire);
+    std::vector<T> values;
+    for (Node* node = head; node != nullptr; node = node->next) {
+      values.emplace_back(std::move(node->value));
+    }
+    delete_nodes(head);
+    std::reverse(values.begin(), values.end());
+    return values;
+  }
+
+  bool empty() const {
+    return head_.load(std::memory_order_relaxed) == nullptr;
+  }
+
+ private:
+  struct Node {
+    T value;
+    Node* next;
+  };
+
+  static void delete_nodes(Node* node) {
+    while (node != nullptr) {
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  std::atomic<Node*> head_{nullptr};
+};
+
+}  // namespace xllm
@@ -0,0 +1,162 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "ngram_index.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+
+namespace xllm {
+
+NGramIndex::NGramIndex(int32_t min_ngram, int32_t max_ngram)
+    : min_ngram_(min_ngram), max_ngram_(max_ngram) {
+  CHECK_GT(min_ngram_, 0) << "min_ngram must be positive";
+  CHECK_GE(max_ngram_, min_ngram_) << "max_ngram must be >= min_ngram";
+  tables_.resize(max_ngram_ - min_ngram_ + 1);
+}
+
+uint64_t NGramIndex::hash_ngram(size_t start, int32_t n) const {
+  uint64_t hash = 0x9e3779b97f4a7c15ULL * static_cast<uint64_t>(n);
+  for (int32_t i = 0; i < n; ++i) {
+    const uint64_t token = static_cast<uint32_t>(tokens_[start + i]);
+    hash ^= token + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+bool NGramIndex::ngram_equals(size_t lhs_start,
+                              size_t rhs_start,
+                              int32_t n) const {
+  return std::equal(tokens_.begin() + lhs_start,
+                    tokens_.begin() + lhs_start + n,
+                    tokens_.begin() + rhs_start);
+}
+
+void NGramIndex::append(std::span<const int32_t> token_ids) {
+  tokens_.reserve(tokens_.size() + token_ids.size());
+  for (const int32_t token : token_ids) {
+    tokens_.emplace_back(token);
+    // the n-gram ending right before the new token now has a continuation.
+    const size_t next_pos = tokens_.size() - 1;
+    for (int32_t n = min_ngram_; n <= max_ngram_; ++n) {
+      if (next_pos < static_cast<size_t>(n)) {
+        break;
+      }
+      tables_[n - min_ngram_][hash_ngram(next_pos - n, n)] =
+          static_cast<int32_t>(next_pos);
+    }
+  }
+}
+
+std::vector<int32_t> NGramIndex::propose(int32_t max_tokens,
+                                         int32_t* match_len) const {
+  if (match_len != nullptr) {
+    *match_len = 0;
+  }
+  if (max_tokens <= 0) {
+    return {};
+  }
+
+  const size_t num_tokens = tokens_.size();
+  for (int32_t n = max_ngram_; n >= min_ngram_; --n) {
+    // need the trailing n-gram plus at least one earlier token.
+    if (num_tokens <= static_cast<size_t>(n)) {
+      continue;
+    }
+    const size_t suffix_start = num_tokens - n;
+    const auto& table = tables_[n - min_ngram_];
+    auto it = table.find(hash_ngram(suffix_start, n));
+    if (it == table.end()) {
+      continue;
+    }
+    const size_t next_pos = static_cast<size_t>(it->second);
+    if (!ngram_equals(next_pos - n, suffix_start, n)) {
+      // hash collision, fall back to a shorter n-gram.
+      continue;
+    }
+    const size_t end =
+        std::min(num_tokens, next_pos + static_cast<size_t>(max_tokens));
+    if (match_len != nullptr) {
+      *match_len = n;
+    }
+    return std::vector<int32_t>(tokens_.begin() + next_pos,
+                                tokens_.begin() + end);
+  }
+  return {};
+}
+
+NGramRequestIndices::NGramRequestIndices(int32_t min_ngram, int32_t max_ngram)
+    : min_ngram_(min_ngram), max_ngram_(max_ngram) {}
+
+NGramIndex& NGramRequestIndices::rebuild(
+    const std::string& req_id,
+    std::span<const int32_t> history,
+    std::span<const int32_t> input_tokens) {
+  indices_.erase(req_id);
+  NGramIndex& index = get_or_create(req_id);
+  index.append(history);
+  index.append(input_tokens);
+  return index;
+}
+
+NGramIndex& NGramRequestIndices::get_or_create(const std::string& req_id) {
+  auto it = indices_.find(req_id);
+  if (it == indices_.end()) {
+    it = indices_.emplace(req_id, NGramIndex(min_ngram_, max_ngram_)).first;
+  }
+  return it->second;
+}
+
+const NGramIndex* NGramRequestIndices::find(const std::string& req_id) const {
+  auto it = indices_.find(req_id);
+  return it == indices_.end() ? nullptr : &it->second;
+}
+
+void NGramRequestIndices::release(const std::vector<std::string>& request_ids) {
+  for (const auto& req_id : request_ids) {
+    indices_.erase(req_id);
+  }
+}
+
+std::vector<int32_t> map_request_rows(
+    const std::vector<std::string>& request_ids,
+    const std::vector<int32_t>& extra_token_ids,
+    int32_t num_rows) {
+  std::vector<int32_t> rows;
+  if (request_ids.size() == static_cast<size_t>(num_rows)) {
+    rows.resize(num_rows);
+    for (int32_t row = 0; row < num_rows; ++row) {
+      rows[row] = row;
+    }
+    return rows;
+  }
+  if (extra_token_ids.size() != static_cast<size_t>(num_rows)) {
+    return rows;
+  }
+  rows.assign(num_rows, -1);
+  int32_t next = 0;
+  for (int32_t row = 0; row < num_rows; ++row) {
+    if (extra_token_ids[row] == -1) {
+      rows[row] = next++;
+    }
+  }
+  if (next != static_cast<int32_t>(request_ids.size())) {
+    rows.clear();
+  }
+  return rows;
+}
+
+}  // namespace xllm
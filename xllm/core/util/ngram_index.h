@@ -0,0 +1,109 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace xllm {
+
+// Incremental n-gram index over the token stream of one request (prompt plus
+// generated output), used for prompt-lookup speculative decoding.
+//
+// For every n in [min_ngram, max_ngram] the index maps the hash of an n-gram
+// to the position right after its most recent occurrence. An n-gram is only
+// indexed once its continuation token exists, so the trailing n-gram of the
+// stream never matches itself. Appending a token costs O(max_ngram^2) hash
+// work regardless of the stream length.
+class NGramIndex {
+ public:
+  NGramIndex(int32_t min_ngram, int32_t max_ngram);
+
+  int32_t min_ngram() const { return min_ngram_; }
+
+  int32_t max_ngram() const { return max_ngram_; }
+
+  size_t num_tokens() const { return tokens_.size(); }
+
+  const std::vector<int32_t>& tokens() const { return tokens_; }
+
+  void append(std::span<const int32_t> token_ids);
+
+  // Propose up to max_tokens draft tokens by matching the longest trailing
+  // n-gram against its most recent earlier occurrence. Returns an empty vector
+  // on miss. match_len, when provided, receives the matched n-gram length.
+  std::vector<int32_t> propose(int32_t max_tokens,
+                               int32_t* match_len = nullptr) const;
+
+ private:
+  uint64_t hash_ngram(size_t start, int32_t n) const;
+
+  bool ngram_equals(size_t lhs_start, size_t rhs_start, int32_t n) const;
+
+ private:
+  int32_t min_ngram_;
+  int32_t max_ngram_;
+
+  std::vector<int32_t> tokens_;
+
+  // indexed by n - min_ngram_; value is the continuation position.
+  std::vector<std::unordered_map<uint64_t, int32_t>> tables_;
+};
+
+// The per-request n-gram indices of a worker. An index lives until the
+// scheduler releases its request, so a request that sits out a step (a
+// chunked prefill in progress, a preemption, a decode step it was not
+// scheduled for) keeps it.
+class NGramRequestIndices {
+ public:
+  NGramRequestIndices(int32_t min_ngram, int32_t max_ngram);
+
+  // Rebuilds the index of a request whose prefill ends in this step from its
+  // full token history: the tokens before this step's input (earlier chunks,
+  // prefix cache hits, output generated before a preemption) followed by the
+  // input tokens.
+  NGramIndex& rebuild(const std::string& req_id,
+                      std::span<const int32_t> history,
+                      std::span<const int32_t> input_tokens);
+
+  NGramIndex& get_or_create(const std::string& req_id);
+
+  const NGramIndex* find(const std::string& req_id) const;
+
+  void release(const std::vector<std::string>& request_ids);
+
+  size_t size() const { return indices_.size(); }
+
+ private:
+  int32_t min_ngram_;
+  int32_t max_ngram_;
+
+  std::unordered_map<std::string, NGramIndex> indices_;
+};
+
+// Maps each of the num_rows rows of a forward input to its position in
+// request_ids, or -1. request_ids only holds the rows that end their prefill
+// in the step and the decode rows, which are the rows whose extra_token_ids
+// entry is -1. Returns an empty vector when the rows can't be mapped.
+std::vector<int32_t> map_request_rows(
+    const std::vector<std::string>& request_ids,
+    const std::vector<int32_t>& extra_token_ids,
+    int32_t num_rows);
+
+}  // namespace xllm
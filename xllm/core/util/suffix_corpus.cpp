@@ -0,0 +1,187 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "suffix_corpus.h"
+
+#include <glog/logging.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace xllm {
+
+namespace {
+
+constexpr char kMagic[4] = {'X', 'S', 'F', 'X'};
+constexpr uint32_t kVersion = 1;
+
+template <typename T>
+void write_pod(std::ofstream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool read_pod(std::ifstream& in, T& value) {
+  in.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return static_cast<bool>(in);
+}
+
+// Returns the number of bytes between the read position and the end of `in`.
+uint64_t remaining_bytes(std::ifstream& in) {
+  const std::streampos pos = in.tellg();
+  in.seekg(0, std::ios::end);
+  const std::streampos end = in.tellg();
+  in.seekg(pos);
+  return end > pos ? static_cast<uint64_t>(end - pos) : 0;
+}
+
+std::optional<SuffixCorpus> load_binary_corpus(std::ifstream& in,
+                                               const std::string& path) {
+  uint32_t version = 0;
+  uint64_t num_sequences = 0;
+  if (!read_pod(in, version) || !read_pod(in, num_sequences)) {
+    LOG(ERROR) << "Truncated suffix corpus header: " << path;
+    return std::nullopt;
+  }
+  if (version != kVersion) {
+    LOG(ERROR) << "Unsupported suffix corpus version " << version << ": "
+               << path;
+    return std::nullopt;
+  }
+
+  // the counts in the file are bounded by its size before anything is
+  // allocated from them, so a corrupt header can't request a huge buffer.
+  uint64_t remaining = remaining_bytes(in);
+  if (num_sequences > remaining / sizeof(uint32_t)) {
+    LOG(ERROR) << "Suffix corpus header claims " << num_sequences
+               << " sequences, more than the file holds: " << path;
+    return std::nullopt;
+  }
+
+  SuffixCorpus corpus;
+  corpus.reserve(num_sequences);
+  for (uint64_t i = 0; i < num_sequences; ++i) {
+    uint32_t num_tokens = 0;
+    if (!read_pod(in, num_tokens)) {
+      LOG(ERROR) << "Truncated suffix corpus at sequence " << i << ": "
+                 << path;
+      return std::nullopt;
+    }
+    remaining -= sizeof(uint32_t);
+    if (num_tokens > remaining / sizeof(int32_t)) {
+      LOG(ERROR) << "Truncated suffix corpus at sequence " << i << ": "
+                 << path;
+      return std::nullopt;
+    }
+    remaining -= static_cast<uint64_t>(num_tokens) * sizeof(int32_t);
+    std::vector<int32_t> tokens(num_tokens);
+    in.read(reinterpret_cast<char*>(tokens.data()),
+            static_cast<std::streamsize>(num_tokens * sizeof(int32_t)));
+    if (!in) {
+      LOG(ERROR) << "Truncated suffix corpus at sequence " << i << ": "
+                 << path;
+      return std::nullopt;
+    }
+    corpus.emplace_back(std::move(tokens));
+  }
+  return corpus;
+}
+
+std::optional<SuffixCorpus> load_text_corpus(std::ifstream& in,
+                                             const std::string& path) {
+  SuffixCorpus corpus;
+  std::string line;
+  int64_t line_no = 0;
+  while (std::getline(in, line)) {
+    ++line_no;
+    std::istringstream stream(line);
+    std::vector<int32_t> tokens;
+    int64_t token = 0;
+    while (stream >> token) {
+      if (token < 0 || token > std::numeric_limits<int32_t>::max()) {
+        LOG(ERROR) << "Invalid token id " << token << " at line " << line_no
+                   << ": " << path;
+        return std::nullopt;
+      }
+      tokens.emplace_back(static_cast<int32_t>(token));
+    }
+    if (!stream.eof()) {
+      LOG(ERROR) << "Malformed suffix corpus line " << line_no << ": "
+                 << path;
+      return std::nullopt;
+    }
+    if (!tokens.empty()) {
+      corpus.emplace_back(std::move(tokens));
+    }
+  }
+  return corpus;
+}
+
+}  // namespace
+
+bool save_suffix_corpus(const std::string& path, const SuffixCorpus& corpus) {
+  const std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      LOG(ERROR) << "Failed to open suffix corpus for writing: " << tmp_path;
+      return false;
+    }
+    out.write(kMagic, sizeof(kMagic));
+    write_pod(out, kVersion);
+    write_pod(out, static_cast<uint64_t>(corpus.size()));
+    for (const auto& tokens : corpus) {
+      write_pod(out, static_cast<uint32_t>(tokens.size()));
+      out.write(reinterpret_cast<const char*>(tokens.data()),
+                static_cast<std::streamsize>(tokens.size() * sizeof(int32_t)));
+    }
+    out.flush();
+    if (!out) {
+      LOG(ERROR) << "Failed to write suffix corpus: " << tmp_path;
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    LOG(ERROR) << "Failed to rename suffix corpus " << tmp_path << " to "
+               << path << ": " << std::strerror(errno);
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+std::optional<SuffixCorpus> load_suffix_corpus(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return std::nullopt;
+  }
+
+  char magic[sizeof(kMagic)] = {};
+  in.read(magic, sizeof(magic));
+  if (in && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0) {
+    return load_binary_corpus(in, path);
+  }
+
+  in.clear();
+  in.seekg(0);
+  return load_text_corpus(in, path);
+}
+
+}  // namespace xllm
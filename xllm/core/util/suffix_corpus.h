@@ -0,0 +1,48 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace xllm {
+
+// On-disk token corpus used to warm-start the global suffix-decoding tree.
+//
+// Binary layout (little endian):
+//   char[4]  magic "XSFX"
+//   uint32   version
+//   uint64   num_sequences
+//   repeated num_sequences times:
+//     uint32 num_tokens
+//     int32  tokens[num_tokens]
+//
+// Storing the token corpus instead of the tree keeps the file compact and
+// independent of the tree depth; the tree is rebuilt on load.
+//
+// A plain-text corpus of historical outputs is accepted too: one sequence per
+// line with whitespace-separated token ids. Blank lines are skipped.
+using SuffixCorpus = std::vector<std::vector<int32_t>>;
+
+// Atomically replaces path (write to a temporary file, then rename).
+bool save_suffix_corpus(const std::string& path, const SuffixCorpus& corpus);
+
+// Returns std::nullopt if the file is missing or malformed.
+std::optional<SuffixCorpus> load_suffix_corpus(const std::string& path);
+
+}  // namespace xllm
@@ -0,0 +1,159 @@
+/* Copyright 2025-2026 The xLLM Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "suffix_decoding_cache.h"
+#include "threadpool.h"
+
+using namespace xllm;
+
+// ============================================================================
+// Per-step suffix speculation cost of SuffixWorkerImpl::step_decode.
+//
+// state.range(0) = batch size (active requests)
+// state.range(1) = suffix tree depth, also the speculation context length
+// state.range(2) = speculation threads (0 = serial on the calling thread)
+//
+// The global tree is warmed with cached responses drawn from a small vocab so
+// that matches are frequent, as with agent traffic that repeats tool calls.
+// ============================================================================
+
+namespace {
+
+constexpr int32_t kVocabSize = 512;
+constexpr int32_t kPromptLen = 1024;
+constexpr int32_t kNumCachedResponses = 512;
+constexpr int32_t kResponseLen = 256;
+constexpr int32_t kNumSpecTokens = 5;
+
+std::vector<int32_t> random_tokens(std::mt19937& gen, int32_t len) {
+  std::uniform_int_distribution<int32_t> dist(0, kVocabSize - 1);
+  std::vector<int32_t> tokens(len);
+  for (auto& token : tokens) {
+    token = dist(gen);
+  }
+  return tokens;
+}
+
+struct SuffixBenchState {
+  std::unique_ptr<SuffixDecodingCache> cache;
+  std::vector<std::string> req_ids;
+  std::vector<std::vector<int32_t>> contexts;
+};
+
+SuffixBenchState make_state(int32_t batch_size, int32_t depth) {
+  std::mt19937 gen(12345);
+  SuffixBenchState state;
+  state.cache = std::make_unique<SuffixDecodingCache>(depth, -1);
+
+  for (int32_t i = 0; i < kNumCachedResponses; ++i) {
+    const std::string req_id = "cached_" + std::to_string(i);
+    std::vector<int32_t> prompt = random_tokens(gen, 16);
+    std::vector<int32_t> response = random_tokens(gen, kResponseLen);
+    state.cache->start_request(req_id, std::span<const int32_t>(prompt));
+    state.cache->add_active_response(req_id,
+                                     std::span<const int32_t>(response));
+    state.cache->stop_request(req_id);
+  }
+
+  for (int32_t i = 0; i < batch_size; ++i) {
+    state.req_ids.emplace_back("active_" + std::to_string(i));
+    std::vector<int32_t> prompt = random_tokens(gen, kPromptLen);
+    state.cache->start_request(state.req_ids.back(),
+                               std::span<const int32_t>(prompt));
+    state.contexts.emplace_back(prompt.end() - depth, prompt.end());
+  }
+  return state;
+}
+
+}  // namespace
+
+static void BM_SuffixBatchSpeculate(benchmark::State& state) {
+  const int32_t batch_size = static_cast<int32_t>(state.range(0));
+  const int32_t depth = static_cast<int32_t>(state.range(1));
+  const int32_t num_threads = static_cast<int32_t>(state.range(2));
+
+  SuffixBenchState bench = make_state(batch_size, depth);
+  std::unique_ptr<MPMCThreadPool> pool;
+  if (num_threads > 0) {
+    pool = std::make_unique<MPMCThreadPool>(static_cast<size_t>(num_threads));
+  }
+  std::vector<int32_t> drafts(batch_size * kNumSpecTokens);
+
+  auto body = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      SuffixDecodingDraft draft = bench.cache->speculate(
+          bench.req_ids[i],
+          std::span<const int32_t>(bench.contexts[i]),
+          kNumSpecTokens,
+          /*max_spec_factor=*/1.0f,
+          /*max_spec_offset=*/0.0f,
+          /*min_token_prob=*/0.1f,
+          /*use_tree_spec=*/false);
+      for (size_t j = 0; j < draft.token_ids.size(); ++j) {
+        drafts[i * kNumSpecTokens + j] = draft.token_ids[j];
+      }
+    }
+  };
+
+  for (auto _ : state) {
+    if (pool != nullptr) {
+      pool->parallel_for(batch_size, /*grain=*/16, body);
+    } else {
+      body(0, batch_size);
+    }
+    benchmark::DoNotOptimize(drafts.data());
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK(BM_SuffixBatchSpeculate)
+    ->ArgNames({"batch", "depth", "threads"})
+    ->ArgsProduct({{64, 256}, {32, 64}, {0, 4, 8}})
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->UseRealTime();
+
+// Cost of the deferred global-tree update applied while the target runs.
+static void BM_SuffixFlushGlobalResponses(benchmark::State& state) {
+  const int32_t batch_size = static_cast<int32_t>(state.range(0));
+  const int32_t depth = static_cast<int32_t>(state.range(1));
+
+  SuffixBenchState bench = make_state(batch_size, depth);
+  std::mt19937 gen(54321);
+  std::vector<int32_t> accepted = random_tokens(gen, kNumSpecTokens + 1);
+
+  for (auto _ : state) {
+    for (const auto& req_id : bench.req_ids) {
+      bench.cache->enqueue_global_response(
+          req_id, std::span<const int32_t>(accepted));
+    }
+    bench.cache->flush_global_responses();
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK(BM_SuffixFlushGlobalResponses)
+    ->ArgNames({"batch", "depth"})
+    ->ArgsProduct({{64, 256}, {32, 64}})
+    ->Unit(benchmark::TimeUnit::kMicrosecond);
+
+BENCHMARK_MAIN();
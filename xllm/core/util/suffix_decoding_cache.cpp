@@ -16,6 +16,7 @@ limitations under the License.
 #include "suffix_decoding_cache.h"
 
 #include <algorithm>
+#include <mutex>
 #include <stdexcept>
 
 namespace xllm {
@@ -80,6 +81,9 @@ void SuffixDecodingCache::start_request(
     throw std::invalid_argument("Request '" + req_id + "' is already active");
   }
 
+  // keep global-tree order when this request evicts or reuses a seq id.
+  flush_global_responses();
+
   auto tree = std::make_unique<SuffixTree>(max_tree_depth_);
   tree->extend(/*seq_id=*/0, prompt_token_ids);
   local_trees_.emplace(req_id, std::move(tree));
@@ -113,17 +117,45 @@ void SuffixDecodingCache::add_active_prompt(
 void SuffixDecodingCache::add_active_response(
     const std::string& req_id,
     std::span<const int32_t> token_ids) {
+  add_local_response(req_id, token_ids);
+  enqueue_global_response(req_id, token_ids);
+  flush_global_responses();
+}
+
+void SuffixDecodingCache::add_local_response(
+    const std::string& req_id,
+    std::span<const int32_t> token_ids) {
   SuffixTree* local_tree = find_local_tree(req_id);
   if (local_tree == nullptr) {
     throw std::invalid_argument("Request '" + req_id + "' is not active");
   }
 
   local_tree->extend(/*seq_id=*/0, token_ids);
+}
 
-  auto it = req_to_seq_id_.find(req_id);
-  if (it != req_to_seq_id_.end()) {
-    global_tree_.extend(it->second, token_ids);
+void SuffixDecodingCache::enqueue_global_response(
+    const std::string& req_id,
+    std::span<const int32_t> token_ids) {
+  if (token_ids.empty() || !has_cached_request(req_id)) {
+    return;
+  }
+  pending_global_responses_.emplace_back(
+      req_id, std::vector<int32_t>(token_ids.begin(), token_ids.end()));
+}
+
+void SuffixDecodingCache::flush_global_responses() {
+  if (pending_global_responses_.empty()) {
+    return;
+  }
+  std::unique_lock<std::shared_mutex> lock(global_tree_mutex_);
+  for (const auto& [req_id, token_ids] : pending_global_responses_) {
+    // the request may have been evicted since it was queued.
+    auto it = req_to_seq_id_.find(req_id);
+    if (it != req_to_seq_id_.end()) {
+      global_tree_.extend(it->second, token_ids);
+    }
   }
+  pending_global_responses_.clear();
 }
 
 void SuffixDecodingCache::evict_cached_response(const std::string& req_id) {
@@ -135,7 +167,10 @@ void SuffixDecodingCache::evict_cached_response(const std::string& req_id) {
   int32_t seq_id = it->second;
   req_to_seq_id_.erase(it);
   seq_to_req_id_.erase(seq_id);
-  global_tree_.remove(seq_id);
+  {
+    std::unique_lock<std::shared_mutex> lock(global_tree_mutex_);
+    global_tree_.remove(seq_id);
+  }
 
   if (!cache_order_.empty()) {
     auto pos = std::find(cache_order_.begin(), cache_order_.end(), req_id);
@@ -145,6 +180,42 @@ void SuffixDecodingCache::evict_cached_response(const std::string& req_id) {
   }
 }
 
+void SuffixDecodingCache::add_cached_response(
+    std::span<const int32_t> token_ids) {
+  if (max_cached_requests_ == 0 || token_ids.empty()) {
+    return;
+  }
+  flush_global_responses();
+
+  // corpus entries are never active, so they only need a unique cache key.
+  std::string req_id;
+  do {
+    req_id = "__suffix_corpus_" + std::to_string(next_corpus_id_++);
+  } while (has_cached_request(req_id));
+
+  const int32_t seq_id = generate_seq_id(req_id);
+  std::unique_lock<std::shared_mutex> lock(global_tree_mutex_);
+  global_tree_.extend(seq_id, token_ids);
+}
+
+std::vector<std::vector<int32_t>>
+SuffixDecodingCache::export_cached_responses() const {
+  std::vector<std::vector<int32_t>> responses;
+  responses.reserve(cache_order_.size());
+  std::shared_lock<std::shared_mutex> lock(global_tree_mutex_);
+  for (const auto& req_id : cache_order_) {
+    auto it = req_to_seq_id_.find(req_id);
+    if (it == req_to_seq_id_.end()) {
+      continue;
+    }
+    std::span<const int32_t> tokens = global_tree_.sequence(it->second);
+    if (!tokens.empty()) {
+      responses.emplace_back(tokens.begin(), tokens.end());
+    }
+  }
+  return responses;
+}
+
 SuffixDecodingDraft SuffixDecodingCache::speculate(
     const std::string& req_id,
     std::span<const int32_t> context,
@@ -152,8 +223,8 @@ SuffixDecodingDraft SuffixDecodingCache::speculate(
     float max_spec_factor,
     float max_spec_offset,
     float min_token_prob,
-    bool use_tree_spec) {
-  SuffixTree* local_tree = find_local_tree(req_id);
+    bool use_tree_spec) const {
+  const SuffixTree* local_tree = find_local_tree(req_id);
   if (local_tree == nullptr) {
     throw std::invalid_argument("Request '" + req_id + "' is not active");
   }
@@ -171,12 +242,16 @@ SuffixDecodingDraft SuffixDecodingCache::speculate(
                                             min_token_prob,
                                             use_tree_spec);
 
-  Draft draft_global = global_tree_.speculate(context,
-                                              max_tokens,
-                                              max_spec_factor,
-                                              max_spec_offset,
-                                              min_token_prob,
-                                              use_tree_spec);
+  Draft draft_global;
+  {
+    std::shared_lock<std::shared_mutex> lock(global_tree_mutex_);
+    draft_global = global_tree_.speculate(context,
+                                          max_tokens,
+                                          max_spec_factor,
+                                          max_spec_offset,
+                                          min_token_prob,
+                                          use_tree_spec);
+  }
 
   return SuffixDecodingDraft::from_native(
       draft_local.score >= draft_global.score ? draft_local : draft_global);
@@ -204,7 +279,10 @@ int32_t SuffixDecodingCache::generate_seq_id(const std::string& req_id) {
     const std::string old_req_id = seq_it->second;
     req_to_seq_id_.erase(old_req_id);
     seq_to_req_id_.erase(seq_id);
-    global_tree_.remove(seq_id);
+    {
+      std::unique_lock<std::shared_mutex> lock(global_tree_mutex_);
+      global_tree_.remove(seq_id);
+    }
 
     auto pos = std::find(cache_order_.begin(), cache_order_.end(), old_req_id);
     if (pos != cache_order_.end()) {
@@ -22,9 +22,11 @@ limitations under the License.
 #include <cstdint>
 #include <deque>
 #include <optional>
+#include <shared_mutex>
 #include <span>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "suffix_tree.h"
@@ -41,6 +43,13 @@ struct SuffixDecodingDraft {
   static SuffixDecodingDraft from_native(const Draft& draft);
 };
 
+// Thread-safety: start/stop/evict and the global-response queue must be
+// driven from a single thread. Between those calls, speculate() and
+// add_local_response() may run concurrently for distinct requests: each
+// request owns its local tree, and the global tree is only read under a
+// shared lock. Global-tree writes take the exclusive lock, so responses can be
+// queued with enqueue_global_response() and applied in one batch (e.g. while
+// the target model runs) by flush_global_responses().
 class SuffixDecodingCache {
  public:
   SuffixDecodingCache(int32_t max_tree_depth = 64,
@@ -69,11 +78,36 @@ class SuffixDecodingCache {
   void add_active_prompt(const std::string& req_id,
                          std::span<const int32_t> token_ids);
 
+  // Append response tokens to both the local and the global tree.
   void add_active_response(const std::string& req_id,
                            std::span<const int32_t> token_ids);
 
+  // Append response tokens to the local tree only. Safe to call concurrently
+  // for distinct active requests.
+  void add_local_response(const std::string& req_id,
+                          std::span<const int32_t> token_ids);
+
+  // Queue response tokens for the global tree; applied on the next flush.
+  void enqueue_global_response(const std::string& req_id,
+                               std::span<const int32_t> token_ids);
+
+  void flush_global_responses();
+
+  size_t num_pending_global_responses() const {
+    return pending_global_responses_.size();
+  }
+
   void evict_cached_response(const std::string& req_id);
 
+  // Seed the global tree with a response that has no active request, e.g.
+  // from a persisted corpus. Subject to max_cached_requests eviction like any
+  // other cached response.
+  void add_cached_response(std::span<const int32_t> token_ids);
+
+  // Copy the cached responses of the global tree, oldest first. Feeding them
+  // back through add_cached_response() rebuilds an equivalent global tree.
+  std::vector<std::vector<int32_t>> export_cached_responses() const;
+
   SuffixDecodingDraft speculate(
       const std::string& req_id,
       std::span<const int32_t> context,
@@ -81,7 +115,7 @@ class SuffixDecodingCache {
       float max_spec_factor = 1.0f,
       float max_spec_offset = 0.0f,
       float min_token_prob = 0.1f,
-      bool use_tree_spec = false);
+      bool use_tree_spec = false) const;
 
  private:
   int32_t generate_seq_id(const std::string& req_id);
@@ -97,11 +131,16 @@ class SuffixDecodingCache {
   int32_t max_cached_requests_;
 
   SuffixTree global_tree_;
+  // readers: speculate(); writers: global extend/remove.
+  mutable std::shared_mutex global_tree_mutex_;
+  std::vector<std::pair<std::string, std::vector<int32_t>>>
+      pending_global_responses_;
   std::unordered_map<std::string, std::unique_ptr<SuffixTree>> local_trees_;
 
   std::unordered_map<std::string, int32_t> req_to_seq_id_;
   Int32Map<std::string> seq_to_req_id_;
   int32_t next_seq_id_ = 0;
+  int64_t next_corpus_id_ = 0;
 
   std::deque<std::string> cache_order_;
 };
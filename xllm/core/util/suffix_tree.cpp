@@ -604,7 +604,7 @@ Draft SuffixTree::speculate(std::span<const int32_t> context,
                             float max_spec_factor,
                             float max_spec_offset,
                             float min_token_prob,
-                            bool use_tree_spec) {
+                            bool use_tree_spec) const {
   Draft best_draft;
   for (int32_t match_len = 1; match_len < static_cast<int32_t>(context.size());
        match_len++) {
@@ -809,7 +809,7 @@ std::string SuffixTree::check_node_integrity(Node* node) {
 }
 
 std::pair<Node*, int32_t> SuffixTree::match_context(
-    std::span<const int32_t> context) {
+    std::span<const int32_t> context) const {
   Node* node = root_.get();
   int32_t idx = 0;
   const int32_t* ref_data = nullptr;
@@ -821,7 +821,7 @@ std::pair<Node*, int32_t> SuffixTree::match_context(
       }
       node = it->second.get();
       // Keep a pointer directly to the reference data for efficiency.
-      ref_data = seqs_[node->ref_seq].data() + node->ref_idx;
+      ref_data = this->ref_data(node);
       idx = 0;
     }
     assert(idx < node->length);
@@ -836,10 +836,10 @@ std::pair<Node*, int32_t> SuffixTree::match_context(
 Draft SuffixTree::speculate_path(Node* node,
                                  int32_t idx,
                                  int32_t max_spec_tokens,
-                                 float min_token_prob) {
+                                 float min_token_prob) const {
   Draft ret;
   float prob = 1.0f;
-  const int32_t* ref_data = seqs_[node->ref_seq].data() + node->ref_idx;
+  const int32_t* ref_data = this->ref_data(node);
   while (ret.token_ids.size() < static_cast<size_t>(max_spec_tokens) &&
          prob >= min_token_prob) {
     if (idx < node->length) {
@@ -858,7 +858,7 @@ Draft SuffixTree::speculate_path(Node* node,
       prob *= static_cast<float>(count) / node->count;
       node = child;
       // Keep a pointer directly to the reference data for efficiency.
-      ref_data = seqs_[node->ref_seq].data() + node->ref_idx;
+      ref_data = this->ref_data(node);
       idx = 0;
     }
   }
@@ -887,7 +887,7 @@ struct HeapItemCmp {
 Draft SuffixTree::speculate_tree(Node* node,
                                  int32_t idx,
                                  int32_t max_spec_tokens,
-                                 float min_token_prob) {
+                                 float min_token_prob) const {
   Draft ret;
   std::priority_queue<HeapItem, std::vector<HeapItem>, HeapItemCmp> queue;
   queue.emplace(1.0, node, idx, -1);
@@ -896,7 +896,7 @@ Draft SuffixTree::speculate_tree(Node* node,
     HeapItem it = queue.top();
     queue.pop();
     if (it.idx < it.node->length) {
-      int32_t token = seqs_[it.node->ref_seq][it.node->ref_idx + it.idx];
+      int32_t token = ref_data(it.node)[it.idx];
       ret.token_ids.push_back(token);
       ret.parents.push_back(it.parent);
       ret.probs.push_back(it.prob);
@@ -132,6 +132,15 @@ class SuffixTree {
 
   int32_t num_seqs() const { return static_cast<int32_t>(seqs_.size()); }
 
+  // Tokens of the sequence with id seq_id, empty if it does not exist.
+  std::span<const int32_t> sequence(int32_t seq_id) const {
+    auto it = seqs_.find(seq_id);
+    if (it == seqs_.end()) {
+      return {};
+    }
+    return std::span<const int32_t>(it->second);
+  }
+
   // Append a new element to the sequence with id seq_id.
   void append(int32_t seq_id, int32_t token);
 
@@ -141,13 +150,14 @@ class SuffixTree {
   // Remove the sequence with id seq_id.
   void remove(int32_t seq_id);
 
-  // Given a context, speculate the next tokens using the suffix tree.
+  // Given a context, speculate the next tokens using the suffix tree. Does not
+  // modify the tree, so concurrent calls are safe as long as no writer runs.
   Draft speculate(std::span<const int32_t> context,
                   int32_t max_spec_tokens,
                   float max_spec_factor,
                   float max_spec_offset,
                   float min_token_prob,
-                  bool use_tree_spec);
+                  bool use_tree_spec) const;
 
   // Check the integrity of the suffix tree, return empty string if ok,
   // otherwise return an error message.
@@ -173,17 +183,23 @@ class SuffixTree {
   // most max_depth_ iterations before being removed.
   Int32Map<std::deque<Node*>> active_nodes_;
 
-  std::pair<Node*, int32_t> match_context(std::span<const int32_t> context);
+  std::pair<Node*, int32_t> match_context(
+      std::span<const int32_t> context) const;
 
   Draft speculate_path(Node* node,
                        int32_t idx,
                        int32_t max_spec_tokens,
-                       float min_token_prob);
+                       float min_token_prob) const;
 
   Draft speculate_tree(Node* node,
                        int32_t idx,
                        int32_t max_spec_tokens,
-                       float min_token_prob);
+                       float min_token_prob) const;
+
+  // Token data referenced by node, read without touching seqs_ layout.
+  const int32_t* ref_data(const Node* node) const {
+    return seqs_.find(node->ref_seq)->second.data() + node->ref_idx;
+  }
 
   std::string check_node_integrity(Node* node);
 };
@@ -0,0 +1,74 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace xllm {
+
+// Wakes a single consumer thread when producers hand it new work. notify()
+// is one atomic exchange unless the consumer is asleep in wait_for(); only
+// then does it take the mutex to signal the condition variable. A notify()
+// is never lost: it either lands before wait_for() checks the pending flag or
+// finds the consumer marked as sleeping.
+class WorkSignal final {
+ public:
+  WorkSignal() = default;
+
+  ~WorkSignal() = default;
+
+  // Safe to call from any number of threads.
+  void notify() {
+    if (pending_.exchange(true)) {
+      return;
+    }
+    if (sleeping_.load()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cond_var_.notify_one();
+    }
+  }
+
+  // Whether work was signaled since the last consume; a cheap poll.
+  bool pending() const { return pending_.load(std::memory_order_relaxed); }
+
+  // Waits until notified or `timeout` expires and clears the signal. Returns
+  // true if work was signaled. Single consumer only.
+  bool wait_for(std::chrono::nanoseconds timeout) {
+    if (pending_.exchange(false)) {
+      return true;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    sleeping_.store(true);
+    const bool notified =
+        cond_var_.wait_for(lock, timeout, [this] { return pending_.load(); });
+    sleeping_.store(false);
+    // an exchange rather than a store, so that the caller also sees the work
+    // of a notify() that raced with the wakeup.
+    pending_.exchange(false);
+    return notified;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_var_;
+  std::atomic<bool> pending_{false};
+  std::atomic<bool> sleeping_{false};
+};
+
+}  // namespace xllm
@@ -14,8 +14,13 @@ limitations under the License.
 ==============================================================================*/
 
 #pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "models/dit/pipelines/pipeline_flux_base.h"
 #include "models/dit/transformers/transformer_flux.h"
+#include "util/scope_guard.h"
 // pipeline_flux compatible with huggingface weights
 // ref to:
 // https://github.com/huggingface/diffusers/blob/main/src/diffusers/pipelines/flux/pipeline_flux.py
@@ -120,9 +125,153 @@ class FluxPipelineImpl : public FluxPipelineBaseImpl {
     return out;
   }
 
+  // Step-level batching: advance every request of the batch by one denoising
+  // step. Joining requests are encoded and get their latents first; then all
+  // requests share one transformer forward with per-request timesteps, and
+  // the requests past their last step are decoded and returned. Requests
+  // released by the scheduler, and all requests of a failed step, drop their
+  // state.
+  DiTForwardOutput step(const DiTForwardInput& input) {
+    torch::NoGradGuard no_grad;
+    for (const auto& request_id : input.released_request_ids) {
+      denoise_states_.erase(request_id);
+    }
+    std::vector<std::string> request_ids = input.joining_request_ids;
+    request_ids.insert(request_ids.end(),
+                       input.running_request_ids.begin(),
+                       input.running_request_ids.end());
+    if (request_ids.empty()) {
+      return {};
+    }
+    // a failed step leaves no state behind for the requests of the batch.
+    ScopeGuard release_on_error([&] {
+      for (const auto& request_id : request_ids) {
+        denoise_states_.erase(request_id);
+      }
+    });
+
+    CHECK_EQ(input.joining_seeds.size(), input.joining_request_ids.size());
+    for (size_t idx = 0; idx < input.joining_request_ids.size(); ++idx) {
+      begin_denoise(input, idx);
+    }
+
+    std::vector<DenoiseState*> states;
+    states.reserve(request_ids.size());
+    for (const auto& request_id : request_ids) {
+      auto it = denoise_states_.find(request_id);
+      CHECK(it != denoise_states_.end())
+          << "No denoising state for request " << request_id;
+      states.emplace_back(&it->second);
+    }
+    const DenoiseState& first = *states.front();
+
+    std::vector<torch::Tensor> latents;
+    std::vector<torch::Tensor> prompt_embeds;
+    std::vector<torch::Tensor> pooled_prompt_embeds;
+    std::vector<torch::Tensor> negative_prompt_embeds;
+    std::vector<torch::Tensor> negative_pooled_prompt_embeds;
+    std::vector<torch::Tensor> timesteps;
+    std::vector<torch::Tensor> guidances;
+    std::vector<int64_t> rows;
+    for (const DenoiseState* state : states) {
+      CHECK_EQ(state->do_true_cfg, first.do_true_cfg)
+          << "DiT step batch mixes true cfg and non true cfg requests";
+      const int64_t num_rows = state->latents.size(0);
+      rows.emplace_back(num_rows);
+      latents.emplace_back(state->latents);
+      prompt_embeds.emplace_back(state->prompt_embeds);
+      pooled_prompt_embeds.emplace_back(state->pooled_prompt_embeds);
+      if (state->do_true_cfg) {
+        negative_prompt_embeds.emplace_back(state->negative_prompt_embeds);
+        negative_pooled_prompt_embeds.emplace_back(
+            state->negative_pooled_prompt_embeds);
+      }
+      const float t = state->timesteps[state->step].item<float>();
+      timesteps.emplace_back(
+          torch::full({num_rows}, t / 1000.0f, state->latents.options()));
+      guidances.emplace_back(
+          torch::full({num_rows},
+                      state->guidance_scale,
+                      torch::dtype(torch::kFloat32).device(options_.device())));
+    }
+
+    torch::Tensor batch_latents = torch::cat(latents);
+    torch::Tensor timestep = torch::cat(timesteps);
+    torch::Tensor guidance;
+    if (transformer_->guidance_embeds()) {
+      guidance = torch::cat(guidances);
+    }
+    // requests in a step batch share the resolution and text length.
+    torch::Tensor noise_pred =
+        transformer_->forward(batch_latents,
+                              torch::cat(prompt_embeds),
+                              torch::cat(pooled_prompt_embeds),
+                              timestep,
+                              first.image_rotary_emb,
+                              guidance,
+                              /*step_idx=*/0);
+    if (first.do_true_cfg) {
+      torch::Tensor negative_noise_pred =
+          transformer_->forward(batch_latents,
+                                torch::cat(negative_prompt_embeds),
+                                torch::cat(negative_pooled_prompt_embeds),
+                                timestep,
+                                first.image_rotary_emb,
+                                guidance,
+                                /*step_idx=*/0);
+      noise_pred = noise_pred +
+                   (noise_pred - negative_noise_pred) * first.true_cfg_scale;
+    }
+
+    std::vector<torch::Tensor> noise_preds = noise_pred.split_with_sizes(rows);
+    std::vector<torch::Tensor> finished_latents;
+    std::vector<int64_t> finished_rows;
+    for (size_t idx = 0; idx < states.size(); ++idx) {
+      DenoiseState& state = *states[idx];
+      scheduler_->set_state(state.scheduler_state);
+      state.latents = scheduler_
+                          ->step(noise_preds[idx],
+                                 state.timesteps[state.step],
+                                 state.latents)
+                          .detach();
+      state.scheduler_state = scheduler_->state();
+      ++state.step;
+      if (state.step == state.timesteps.numel()) {
+        finished_latents.emplace_back(state.latents);
+        finished_rows.emplace_back(rows[idx]);
+      }
+    }
+
+    DiTForwardOutput out;
+    if (finished_latents.empty()) {
+      release_on_error.dismiss();
+      return out;
+    }
+    torch::Tensor unpacked_latents =
+        unpack_latents(torch::cat(finished_latents),
+                       first.height,
+                       first.width,
+                       vae_scale_factor_);
+    unpacked_latents =
+        (unpacked_latents / vae_scaling_factor_) + vae_shift_factor_;
+    unpacked_latents = unpacked_latents.to(options_.dtype());
+    torch::Tensor image = vae_->decode(unpacked_latents);
+    image = vae_image_processor_->postprocess(image);
+    out.tensors = image.split_with_sizes(finished_rows);
+
+    for (size_t idx = 0; idx < states.size(); ++idx) {
+      if (states[idx]->step == states[idx]->timesteps.numel()) {
+        denoise_states_.erase(request_ids[idx]);
+      }
+    }
+    release_on_error.dismiss();
+    return out;
+  }
+
   void load_model(std::unique_ptr<DiTModelLoader> loader) {
     LOG(INFO) << "FluxPipeline loading model from" << loader->model_root_path();
     std::string model_path = loader->model_root_path();
+    model_path_ = model_path;
     auto transformer_loader = loader->take_component_loader("transformer");
     auto vae_loader = loader->take_component_loader("vae");
     auto t5_loader = loader->take_component_loader("text_encoder_2");
@@ -172,6 +321,128 @@ class FluxPipelineImpl : public FluxPipelineBaseImpl {
     return {packed_latents, latent_image_ids};
   }
 
+  // denoising progress of one request in a step-level batch
+  struct DenoiseState {
+    torch::Tensor latents;
+    torch::Tensor prompt_embeds;
+    torch::Tensor pooled_prompt_embeds;
+    torch::Tensor negative_prompt_embeds;
+    torch::Tensor negative_pooled_prompt_embeds;
+    torch::Tensor image_rotary_emb;
+    // host copy of the schedule, read once per step
+    torch::Tensor timesteps;
+    FlowMatchEulerDiscreteSchedulerImpl::State scheduler_state;
+    int64_t step = 0;
+    int64_t height = 0;
+    int64_t width = 0;
+    float guidance_scale = 3.5f;
+    float true_cfg_scale = 1.0f;
+    bool do_true_cfg = false;
+  };
+
+  // create the denoising state of the idx-th joining request of input.
+  void begin_denoise(const DiTForwardInput& input, size_t idx) {
+    const DiTGenerationParams& generation_params = input.generation_params;
+    const int64_t num_images_per_prompt =
+        generation_params.num_images_per_prompt;
+    auto request_strings = [idx](const std::vector<std::string>& values)
+        -> std::optional<std::vector<std::string>> {
+      if (values.empty()) {
+        return std::nullopt;
+      }
+      return std::vector<std::string>{values[idx]};
+    };
+    auto request_tensor =
+        [idx](const torch::Tensor& tensor) -> std::optional<torch::Tensor> {
+      if (!tensor.defined()) {
+        return std::nullopt;
+      }
+      return tensor.narrow(0, static_cast<int64_t>(idx), 1);
+    };
+    std::optional<std::vector<std::string>> negative_prompt =
+        request_strings(input.negative_prompts);
+    std::optional<torch::Tensor> negative_prompt_embeds =
+        request_tensor(input.negative_prompt_embeds);
+    std::optional<torch::Tensor> negative_pooled_prompt_embeds =
+        request_tensor(input.negative_pooled_prompt_embeds);
+
+    DenoiseState state;
+    state.height = generation_params.height;
+    state.width = generation_params.width;
+    state.guidance_scale = generation_params.guidance_scale;
+    state.true_cfg_scale = generation_params.true_cfg_scale;
+    const bool has_neg_prompt = negative_prompt.has_value() ||
+                                (negative_prompt_embeds.has_value() &&
+                                 negative_pooled_prompt_embeds.has_value());
+    state.do_true_cfg = (state.true_cfg_scale > 1.0f) && has_neg_prompt;
+
+    torch::Tensor text_ids;
+    std::tie(state.prompt_embeds, state.pooled_prompt_embeds, text_ids) =
+        encode_prompt(request_strings(input.prompts),
+                      request_strings(input.prompts_2),
+                      request_tensor(input.prompt_embeds),
+                      request_tensor(input.pooled_prompt_embeds),
+                      num_images_per_prompt,
+                      generation_params.max_sequence_length);
+    if (state.do_true_cfg) {
+      torch::Tensor negative_text_ids;
+      std::tie(state.negative_prompt_embeds,
+               state.negative_pooled_prompt_embeds,
+               negative_text_ids) =
+          encode_prompt(negative_prompt,
+                        request_strings(input.negative_prompts_2),
+                        negative_prompt_embeds,
+                        negative_pooled_prompt_embeds,
+                        num_images_per_prompt,
+                        generation_params.max_sequence_length);
+    }
+
+    const int64_t seed = input.joining_seeds[idx];
+    const int64_t num_channels_latents = transformer_->in_channels() / 4;
+    torch::Tensor latent_image_ids;
+    std::tie(state.latents, latent_image_ids) =
+        prepare_latents(num_images_per_prompt,
+                        num_channels_latents,
+                        state.height,
+                        state.width,
+                        seed > 0 ? seed : 42,
+                        request_tensor(input.latents));
+
+    const int64_t num_inference_steps = generation_params.num_inference_steps;
+    std::vector<float> new_sigmas;
+    for (int64_t i = 0; i < num_inference_steps; ++i) {
+      new_sigmas.push_back(1.0f - static_cast<float>(i) /
+                                      (num_inference_steps - 1) *
+                                      (1.0f - 1.0f / num_inference_steps));
+    }
+    float mu = calculate_shift(state.latents.size(1),
+                               scheduler_->base_image_seq_len(),
+                               scheduler_->max_image_seq_len(),
+                               scheduler_->base_shift(),
+                               scheduler_->max_shift());
+    torch::Tensor timesteps = retrieve_timesteps(scheduler_,
+                                                 num_inference_steps,
+                                                 options_.device(),
+                                                 new_sigmas,
+                                                 mu)
+                                  .first;
+    // the scheduler retires the request after num_inference_steps steps.
+    CHECK_EQ(timesteps.numel(), num_inference_steps);
+    scheduler_->set_begin_index(0);
+    state.scheduler_state = scheduler_->state();
+    state.timesteps = timesteps.to(torch::kCPU);
+
+    auto [rot_emb1, rot_emb2] =
+        pos_embed_->forward_cache(text_ids,
+                                  latent_image_ids,
+                                  state.height / (vae_scale_factor_ * 2),
+                                  state.width / (vae_scale_factor_ * 2));
+    state.image_rotary_emb =
+        torch::stack({rot_emb1, rot_emb2}, 0).to(options_.dtype());
+
+    denoise_states_[input.joining_request_ids[idx]] = std::move(state);
+  }
+
   torch::Tensor forward_impl(
       std::optional<std::vector<std::string>> prompt = std::nullopt,
       std::optional<std::vector<std::string>> prompt_2 = std::nullopt,
@@ -332,6 +603,8 @@ class FluxPipelineImpl : public FluxPipelineBaseImpl {
   float vae_scaling_factor_;
   float vae_shift_factor_;
   FluxPosEmbed pos_embed_{nullptr};
+  // step-level batching state, keyed by request id
+  std::unordered_map<std::string, DenoiseState> denoise_states_;
 };
 TORCH_MODULE(FluxPipeline);
 
@@ -25,6 +25,7 @@ limitations under the License.
 #include <string>
 
 #include "core/framework/dit_model_loader.h"
+#include "core/framework/encoder_cache/text_embedding_cache.h"
 #include "core/framework/model_context.h"
 #include "core/framework/request/dit_request_state.h"
 #include "core/framework/state_dict/state_dict.h"
@@ -166,8 +167,15 @@ class FluxPipelineBaseImpl : public torch::nn::Module {
         torch::tensor(text_input_ids_flat, torch::dtype(torch::kLong))
             .view({batch_size, max_sequence_length})
             .to(options_.device());
-    torch::Tensor prompt_embeds = t5_->forward(input_ids);
-    prompt_embeds = prompt_embeds.to(options_);
+    torch::Tensor prompt_embeds = TextEmbeddingCache::get_instance().encode(
+        model_path_ + "/text_encoder_2",
+        options_.device(),
+        text_input_ids,
+        [&](const torch::Tensor& rows) {
+          return t5_
+              ->forward(input_ids.index_select(0, rows.to(input_ids.device())))
+              .to(options_);
+        });
     int64_t seq_len = prompt_embeds.size(1);
     prompt_embeds = prompt_embeds.repeat({1, num_images_per_prompt, 1});
     prompt_embeds =
@@ -196,9 +204,15 @@ class FluxPipelineBaseImpl : public torch::nn::Module {
         torch::tensor(text_input_ids_flat, torch::dtype(torch::kLong))
             .view({batch_size, tokenizer_max_length_})
             .to(options_.device());
-    auto encoder_output = clip_text_model_->forward(input_ids);
-    torch::Tensor prompt_embeds = encoder_output;
-    prompt_embeds = prompt_embeds.to(options_);
+    torch::Tensor prompt_embeds = TextEmbeddingCache::get_instance().encode(
+        model_path_ + "/text_encoder",
+        options_.device(),
+        text_input_ids,
+        [&](const torch::Tensor& rows) {
+          return clip_text_model_
+              ->forward(input_ids.index_select(0, rows.to(input_ids.device())))
+              .to(options_);
+        });
     prompt_embeds = prompt_embeds.repeat({1, num_images_per_prompt});
     prompt_embeds =
         prompt_embeds.view({batch_size * num_images_per_prompt, -1});
@@ -297,6 +311,8 @@ class FluxPipelineBaseImpl : public torch::nn::Module {
   torch::TensorOptions options_;
   int tokenizer_max_length_;
   int vae_scale_factor_;
+  // identifies the loaded weights in the text embedding cache.
+  std::string model_path_;
 };
 
 }  // namespace xllm
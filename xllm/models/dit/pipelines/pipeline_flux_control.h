@@ -105,6 +105,7 @@ class FluxControlPipelineImpl : public FluxPipelineBaseImpl {
     LOG(INFO) << "FluxControlPipeline loading model from"
               << loader->model_root_path();
     std::string model_path = loader->model_root_path();
+    model_path_ = model_path;
     auto transformer_loader = loader->take_component_loader("transformer");
     auto vae_loader = loader->take_component_loader("vae");
     auto t5_loader = loader->take_component_loader("text_encoder_2");
@@ -24,6 +24,7 @@ limitations under the License.
 #include "core/framework/config/load_config.h"
 #include "core/framework/config/parallel_config.h"
 #include "core/framework/dit_model_loader.h"
+#include "core/framework/encoder_cache/text_embedding_cache.h"
 #include "core/framework/model_context.h"
 #include "core/framework/request/dit_request_state.h"
 #include "core/framework/state_dict/state_dict.h"
@@ -161,6 +162,7 @@ class WanImageToVideoPipelineImpl : public torch::nn::Module,
   void load_model(std::unique_ptr<DiTModelLoader> loader) {
     LOG(INFO) << "Wan2_2I2VPipeline loading model from"
               << loader->model_root_path();
+    model_path_ = loader->model_root_path();
     auto transformer_loader = loader->take_component_loader("transformer");
     auto transformer_2_loader = loader->take_component_loader("transformer_2");
     auto vae_loader = loader->take_component_loader("vae");
@@ -331,9 +333,17 @@ class WanImageToVideoPipelineImpl : public torch::nn::Module,
     torch::Tensor attention_mask =
         (1.0 - (input_ids > 0).to(options_.dtype()).unsqueeze(1).unsqueeze(2)) *
         (std::numeric_limits<float>::lowest());
-    torch::Tensor prompt_embeds = umt5_->forward(input_ids, attention_mask);
-
-    prompt_embeds = prompt_embeds.to(options_);
+    torch::Tensor prompt_embeds = TextEmbeddingCache::get_instance().encode(
+        model_path_ + "/text_encoder",
+        options_.device(),
+        text_input_ids,
+        [&](const torch::Tensor& rows) {
+          torch::Tensor index = rows.to(input_ids.device());
+          return umt5_
+              ->forward(input_ids.index_select(0, index),
+                        attention_mask.index_select(0, index))
+              .to(options_);
+        });
 
     auto seq_lens = (input_ids > 0).sum(1).to(torch::kLong);
 
@@ -745,6 +755,8 @@ class WanImageToVideoPipelineImpl : public torch::nn::Module,
   torch::TensorOptions options_;
   const ParallelArgs parallel_args_;
   xllm::dit::SparseAttnConfig sparse_attn_config_;
+  // identifies the loaded weights in the text embedding cache.
+  std::string model_path_;
 };
 TORCH_MODULE(WanImageToVideoPipeline);
 
@@ -34,6 +34,16 @@ limitations under the License.
 namespace xllm {
 class FlowMatchEulerDiscreteSchedulerImpl : public xllm::dit::Scheduler {
  public:
+  // Timestep schedule and progress of one request. Step-level batching keeps
+  // one per request and swaps it in around step(), so requests at different
+  // steps share this scheduler.
+  struct State {
+    torch::Tensor timesteps;
+    torch::Tensor sigmas;
+    std::optional<int> step_index;
+    std::optional<int> begin_index;
+  };
+
   // raw_sigmas ends the sigma ramp at 1/N rather than sigma_min_, the schedule
   // distilled Wan2.2 weights need. It defaults to false so every existing
   // caller keeps the standard schedule; only the Wan2.2 I2V distill path
@@ -283,6 +293,17 @@ class FlowMatchEulerDiscreteSchedulerImpl : public xllm::dit::Scheduler {
     return prev_sample;
   }
 
+  State state() const {
+    return {timesteps_, sigmas_, step_index_, begin_index_};
+  }
+
+  void set_state(const State& state) {
+    timesteps_ = state.timesteps;
+    sigmas_ = state.sigmas;
+    step_index_ = state.step_index;
+    begin_index_ = state.begin_index;
+  }
+
   std::optional<int> step_index() const { return step_index_; }
   std::optional<int> begin_index() const { return begin_index_; }
   const torch::Tensor& timesteps() const override { return timesteps_; }
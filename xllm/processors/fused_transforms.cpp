@@ -0,0 +1,285 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "processors/fused_transforms.h"
+
+#include <ATen/Parallel.h>
+#include <glog/logging.h>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace xllm::transforms {
+namespace {
+
+// Fixed point precision of the filter weights, as in PIL: a uint8 sample
+// times a weight sum of up to ~1.25 stays within int32.
+constexpr int32_t kPrecisionBits = 32 - 8 - 2;
+constexpr int32_t kRoundingBias = 1 << (kPrecisionBits - 1);
+// Output rows per parallel task. A task resamples the input rows these read
+// once and reuses its scratch rows across channels.
+constexpr int64_t kRowGrain = 16;
+
+double bilinear_filter(double x) {
+  x = std::abs(x);
+  return x < 1.0 ? 1.0 - x : 0.0;
+}
+
+// Keys cubic with a = -0.5, the kernel of PIL and torch antialias bicubic.
+double bicubic_filter(double x) {
+  constexpr double a = -0.5;
+  x = std::abs(x);
+  if (x < 1.0) {
+    return ((a + 2.0) * x - (a + 3.0)) * x * x + 1.0;
+  }
+  if (x < 2.0) {
+    return (((x - 5.0) * x + 8.0) * x - 4.0) * a;
+  }
+  return 0.0;
+}
+
+// Filter taps of one axis. Output i reads `count[i]` inputs from `first[i]`
+// with the weights at `weights[i * max_taps]`.
+struct AxisFilter {
+  int64_t max_taps = 0;
+  std::vector<int64_t> first;
+  std::vector<int64_t> count;
+  std::vector<int32_t> weights;
+};
+
+// Antialiased weights as computed by PIL's precompute_coeffs(): when
+// downscaling, the filter support widens with the scale factor.
+AxisFilter make_axis_filter(int64_t in_size,
+                            int64_t out_size,
+                            int32_t resample) {
+  const bool bicubic = resample == 3;
+  const double scale = static_cast<double>(in_size) / out_size;
+  const double filter_scale = std::max(scale, 1.0);
+  const double support = (bicubic ? 2.0 : 1.0) * filter_scale;
+
+  AxisFilter filter;
+  filter.max_taps = static_cast<int64_t>(std::ceil(support)) * 2 + 1;
+  filter.first.resize(out_size);
+  filter.count.resize(out_size);
+  filter.weights.assign(out_size * filter.max_taps, 0);
+
+  std::vector<double> taps(filter.max_taps);
+  for (int64_t i = 0; i < out_size; ++i) {
+    const double center = (i + 0.5) * scale;
+    const int64_t lo =
+        std::max<int64_t>(static_cast<int64_t>(center - support + 0.5), 0);
+    const int64_t hi = std::min<int64_t>(
+        static_cast<int64_t>(center + support + 0.5), in_size);
+    const int64_t count = std::min(hi - lo, filter.max_taps);
+    double sum = 0.0;
+    for (int64_t j = 0; j < count; ++j) {
+      const double x = (j + lo - center + 0.5) / filter_scale;
+      taps[j] = bicubic ? bicubic_filter(x) : bilinear_filter(x);
+      sum += taps[j];
+    }
+    int32_t* weights = filter.weights.data() + i * filter.max_taps;
+    for (int64_t j = 0; j < count && sum != 0.0; ++j) {
+      weights[j] = static_cast<int32_t>(
+          std::lround(taps[j] / sum * (1 << kPrecisionBits)));
+    }
+    filter.first[i] = lo;
+    filter.count[i] = count;
+  }
+  return filter;
+}
+
+inline uint8_t clip8(int32_t value) {
+  return static_cast<uint8_t>(
+      std::clamp(value >> kPrecisionBits, int32_t{0}, int32_t{255}));
+}
+
+// acc[x] += weight * src[x], the inner loop of the vertical pass.
+void accumulate_row(int32_t* acc,
+                    const uint8_t* src,
+                    int32_t weight,
+                    int64_t size) {
+  int64_t x = 0;
+#if defined(__AVX512F__)
+  const __m512i w16 = _mm512_set1_epi32(weight);
+  for (; x + 16 <= size; x += 16) {
+    const __m512i pixels = _mm512_cvtepu8_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x)));
+    const __m512i sum = _mm512_add_epi32(_mm512_loadu_si512(acc + x),
+                                         _mm512_mullo_epi32(pixels, w16));
+    _mm512_storeu_si512(acc + x, sum);
+  }
+#endif
+#if defined(__AVX2__)
+  const __m256i w8 = _mm256_set1_epi32(weight);
+  for (; x + 8 <= size; x += 8) {
+    const __m256i pixels = _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + x)));
+    __m256i* dst = reinterpret_cast<__m256i*>(acc + x);
+    _mm256_storeu_si256(dst,
+                        _mm256_add_epi32(_mm256_loadu_si256(dst),
+                                         _mm256_mullo_epi32(pixels, w8)));
+  }
+#elif defined(__ARM_NEON)
+  for (; x + 8 <= size; x += 8) {
+    const uint16x8_t pixels = vmovl_u8(vld1_u8(src + x));
+    const int32x4_t lo = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(pixels)));
+    const int32x4_t hi =
+        vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(pixels)));
+    vst1q_s32(acc + x, vmlaq_n_s32(vld1q_s32(acc + x), lo, weight));
+    vst1q_s32(acc + x + 4, vmlaq_n_s32(vld1q_s32(acc + x + 4), hi, weight));
+  }
+#endif
+  for (; x < size; ++x) {
+    acc[x] += weight * src[x];
+  }
+}
+
+}  // namespace
+
+bool supports_fused_preprocess(const torch::Tensor& image, int32_t resample) {
+  return image.dim() == 3 && image.scalar_type() == torch::kUInt8 &&
+         image.device().is_cpu() && (resample == 2 || resample == 3);
+}
+
+torch::Tensor resize_normalize_patchify(const torch::Tensor& image,
+                                        int64_t height,
+                                        int64_t width,
+                                        int32_t resample,
+                                        const torch::Tensor& mean,
+                                        const torch::Tensor& std,
+                                        const PatchLayout& layout) {
+  CHECK(supports_fused_preprocess(image, resample))
+      << "Fused preprocessing needs a uint8 (C, H, W) CPU image and "
+      << "bilinear or bicubic resampling.";
+  const int64_t patch = layout.patch_size;
+  const int64_t merge = layout.merge_size;
+  const int64_t temporal = layout.temporal_patch_size;
+  CHECK(patch > 0 && merge > 0 && temporal > 0);
+  CHECK(height > 0 && width > 0 && height % (patch * merge) == 0 &&
+        width % (patch * merge) == 0)
+      << "Resized size " << height << "x" << width
+      << " is not a multiple of the merged patch size " << patch * merge;
+
+  const torch::Tensor src = image.contiguous();
+  const int64_t channels = src.size(0);
+  const int64_t in_height = src.size(1);
+  const int64_t in_width = src.size(2);
+  const torch::Tensor mean_values = mean.to(torch::kFloat32).contiguous();
+  const torch::Tensor std_values = std.to(torch::kFloat32).contiguous();
+  CHECK_EQ(mean_values.numel(), channels);
+  CHECK_EQ(std_values.numel(), channels);
+
+  // (v - mean) / std of every uint8 value, per channel.
+  std::vector<std::array<float, 256>> lut(channels);
+  for (int64_t c = 0; c < channels; ++c) {
+    const float m = mean_values.data_ptr<float>()[c];
+    const float s = std_values.data_ptr<float>()[c];
+    for (int32_t v = 0; v < 256; ++v) {
+      lut[c][v] = (static_cast<float>(v) - m) / s;
+    }
+  }
+
+  const AxisFilter rows = make_axis_filter(in_height, height, resample);
+  const AxisFilter cols = make_axis_filter(in_width, width, resample);
+
+  // A pixel (y, x) of channel c and temporal slot t lands in patch
+  // row_base[y] + col_base[x] at feature (c * T + t) * P * P.
+  const int64_t grid_h = height / patch;
+  const int64_t grid_w = width / patch;
+  const int64_t feature_dim = channels * temporal * patch * patch;
+  const int64_t plane = patch * patch;
+  std::vector<int64_t> col_base(width);
+  for (int64_t x = 0; x < width; ++x) {
+    const int64_t gw = x / patch;
+    col_base[x] = ((gw / merge) * merge * merge + gw % merge) * feature_dim +
+                  x % patch;
+  }
+  const auto row_base = [&](int64_t y) {
+    const int64_t gh = y / patch;
+    return ((gh / merge) * (grid_w / merge) * merge * merge +
+            (gh % merge) * merge) *
+               feature_dim +
+           (y % patch) * patch;
+  };
+
+  torch::Tensor output =
+      torch::empty({grid_h * grid_w, feature_dim}, torch::kFloat32);
+  float* out = output.data_ptr<float>();
+  const uint8_t* in = src.data_ptr<uint8_t>();
+
+  // The passes run in PIL's order, horizontal then vertical, each rounding
+  // to uint8, so that the result matches the PIL resize bit for bit. A task
+  // resamples the input rows its output rows read once per channel.
+  at::parallel_for(0, height, kRowGrain, [&](int64_t begin, int64_t end) {
+    const int64_t first_row = rows.first[begin];
+    int64_t last_row = first_row;
+    for (int64_t y = begin; y < end; ++y) {
+      last_row = std::max(last_row, rows.first[y] + rows.count[y]);
+    }
+    std::vector<uint8_t> resampled((last_row - first_row) * width);
+    std::vector<int32_t> acc(width);
+    for (int64_t c = 0; c < channels; ++c) {
+      // horizontal pass over the input rows of this task.
+      const uint8_t* channel = in + c * in_height * in_width;
+      for (int64_t r = first_row; r < last_row; ++r) {
+        const uint8_t* src_row = channel + r * in_width;
+        uint8_t* dst_row = resampled.data() + (r - first_row) * width;
+        for (int64_t x = 0; x < width; ++x) {
+          const uint8_t* taps = src_row + cols.first[x];
+          const int32_t* weights = cols.weights.data() + x * cols.max_taps;
+          int32_t sum = kRoundingBias;
+          for (int64_t j = 0; j < cols.count[x]; ++j) {
+            sum += weights[j] * taps[j];
+          }
+          dst_row[x] = clip8(sum);
+        }
+      }
+
+      // vertical pass over contiguous resampled rows, normalized and
+      // scattered into the patches.
+      const std::array<float, 256>& values = lut[c];
+      for (int64_t y = begin; y < end; ++y) {
+        const int32_t* row_weights = rows.weights.data() + y * rows.max_taps;
+        std::fill(acc.begin(), acc.end(), kRoundingBias);
+        for (int64_t j = 0; j < rows.count[y]; ++j) {
+          accumulate_row(
+              acc.data(),
+              resampled.data() + (rows.first[y] + j - first_row) * width,
+              row_weights[j],
+              width);
+        }
+        float* out_channel = out + row_base(y) + c * temporal * plane;
+        for (int64_t x = 0; x < width; ++x) {
+          const float value = values[clip8(acc[x])];
+          float* dst = out_channel + col_base[x];
+          for (int64_t t = 0; t < temporal; ++t) {
+            dst[t * plane] = value;
+          }
+        }
+      }
+    }
+  });
+  return output;
+}
+
+}  // namespace xllm::transforms
@@ -0,0 +1,52 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#pragma once
+
+#include <torch/torch.h>
+
+#include <cstdint>
+
+namespace xllm::transforms {
+
+// Patch flattening of the Qwen2-VL family: (T, C, H, W) frames become
+// [grid_t * grid_h * grid_w, C * T * P * P] rows, ordered by merge window.
+struct PatchLayout {
+  int64_t patch_size = 14;
+  int64_t merge_size = 2;
+  int64_t temporal_patch_size = 2;
+};
+
+// Whether resize_normalize_patchify() handles `image` with `resample`: a
+// uint8 (C, H, W) CPU image with bilinear (2) or bicubic (3) filtering.
+bool supports_fused_preprocess(const torch::Tensor& image, int32_t resample);
+
+// Single pass equivalent of resize(), normalize() and patch flattening of one
+// image, repeated over the temporal patch. The antialiased resize runs on
+// uint8 with PIL's fixed point filter weights and pass order, so it matches
+// PIL's uint8 resize; normalization is a per-channel lookup table, and every
+// output row is written straight into its patches.
+// `height` and `width` must be multiples of patch_size * merge_size, and
+// `mean` / `std` are in the 0-255 pixel scale. Returns a float32 tensor of
+// [grid_h * grid_w, C * T * P * P].
+torch::Tensor resize_normalize_patchify(const torch::Tensor& image,
+                                        int64_t height,
+                                        int64_t width,
+                                        int32_t resample,
+                                        const torch::Tensor& mean,
+                                        const torch::Tensor& std,
+                                        const PatchLayout& layout);
+
+}  // namespace xllm::transforms
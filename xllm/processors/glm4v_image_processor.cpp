@@ -15,6 +15,9 @@ limitations under the License.
 
 #include "processors/glm4v_image_processor.h"
 
+#include <algorithm>
+
+#include "processors/fused_transforms.h"
 #include "processors/transforms.h"
 
 namespace xllm {
@@ -113,6 +116,15 @@ bool Glm4VImageProcessor::process_image(
     const std::vector<torch::Tensor>& images,
     std::vector<torch::Tensor>& pixel_values,
     std::vector<torch::Tensor>& thw) const {
+  const bool fused =
+      do_resize_ && do_normalize_ && !do_rescale_ &&
+      std::all_of(images.begin(), images.end(), [this](const auto& image) {
+        return transforms::supports_fused_preprocess(image, resample_);
+      });
+  if (fused) {
+    return process_image_fused(images, pixel_values, thw);
+  }
+
   torch::Tensor batch_images = torch::stack(images);
   const auto shape = batch_images.sizes();
   const int64_t batch_size = shape[0];
@@ -181,6 +193,45 @@ bool Glm4VImageProcessor::process_image(
   return true;
 }
 
+bool Glm4VImageProcessor::process_image_fused(
+    const std::vector<torch::Tensor>& images,
+    std::vector<torch::Tensor>& pixel_values,
+    std::vector<torch::Tensor>& thw) const {
+  transforms::PatchLayout layout;
+  layout.patch_size = patch_size_;
+  layout.merge_size = merge_size_;
+  layout.temporal_patch_size = temporal_patch_size_;
+
+  pixel_values.clear();
+  thw.clear();
+  for (const torch::Tensor& image : images) {
+    auto size = smart_resize(temporal_patch_size_,
+                             static_cast<int32_t>(image.size(1)),
+                             static_cast<int32_t>(image.size(2)),
+                             temporal_patch_size_,
+                             patch_size_ * merge_size_,
+                             min_pixels_,
+                             max_pixels_);
+    if (!size) {
+      return false;
+    }
+    const auto [resized_height, resized_width] = *size;
+    pixel_values.emplace_back(
+        transforms::resize_normalize_patchify(image,
+                                              resized_height,
+                                              resized_width,
+                                              resample_,
+                                              image_mean_,
+                                              image_std_,
+                                              layout));
+    thw.emplace_back(torch::tensor({int64_t{1},
+                                    int64_t{resized_height / patch_size_},
+                                    int64_t{resized_width / patch_size_}})
+                         .reshape({1, 3}));
+  }
+  return true;
+}
+
 bool Glm4VImageProcessor::process(const std::vector<torch::Tensor>& images,
                                   std::vector<MMDataItem>& output_items) const {
   std::vector<torch::Tensor> pixel_values;
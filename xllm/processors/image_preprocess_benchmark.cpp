@@ -0,0 +1,88 @@
+/* Copyright 2026 The xLLM Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://github.com/xLLM-AI/xllm/blob/main/LICENSE
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <benchmark/benchmark.h>
+#include <glog/logging.h>
+#include <torch/torch.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "core/framework/model/model_args.h"
+#include "processors/qwen2_vl_image_processor.h"
+
+using namespace xllm;
+
+// ============================================================================
+// Qwen2-VL image preprocessing throughput.
+//
+// state.range(0), state.range(1) = decoded image height and width
+// state.range(2) = 1 for the fused uint8 kernel, 0 for the float path of
+//                  transforms::resize / normalize and the patch permute
+//
+// The float path is what a non-uint8 input takes; both produce the same
+// [patches, C * T * P * P] pixel_values for the default 1M max_pixels.
+// ============================================================================
+
+namespace {
+
+ModelArgs make_qwen2_vl_args() {
+  ModelArgs args;
+  args.mm_image_normalize_mean({0.48145466, 0.4578275, 0.40821073});
+  args.mm_image_normalize_std({0.26862954, 0.26130258, 0.27577711});
+  args.mm_image_min_pixels(56 * 56);
+  args.mm_image_max_pixels(14 * 14 * 4 * 1280);
+  args.mm_image_patch_size(14);
+  args.mm_image_temporal_patch_size(2);
+  args.mm_image_merge_size(2);
+  return args;
+}
+
+void BM_Qwen2VLImagePreprocess(benchmark::State& state) {
+  const int64_t height = state.range(0);
+  const int64_t width = state.range(1);
+  const bool fused = state.range(2) != 0;
+
+  const Qwen2VLImageProcessor processor(make_qwen2_vl_args());
+  torch::Tensor image =
+      torch::randint(0, 256, {3, height, width}, torch::kUInt8);
+  if (!fused) {
+    image = image.to(torch::kFloat32);
+  }
+  const std::vector<torch::Tensor> images = {image};
+
+  for (auto _ : state) {
+    std::vector<torch::Tensor> pixel_values;
+    std::vector<torch::Tensor> thw;
+    CHECK(processor.process_image(images, pixel_values, thw));
+    benchmark::DoNotOptimize(pixel_values.front().data_ptr<float>());
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * 3 * height * width);
+}
+
+}  // namespace
+
+BENCHMARK(BM_Qwen2VLImagePreprocess)
+    ->ArgNames({"height", "width", "fused"})
+    ->Args({480, 640, 0})
+    ->Args({480, 640, 1})
+    ->Args({1080, 1920, 0})
+    ->Args({1080, 1920, 1})
+    ->Args({2160, 3840, 0})
+    ->Args({2160, 3840, 1})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
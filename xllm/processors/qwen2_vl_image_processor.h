@@ -37,6 +37,11 @@ class Qwen2VLImageProcessor final : public ImageProcessor {
                      std::vector<torch::Tensor>& thw) const;
 
  private:
+  // resize, normalize and patchify in one pass over each uint8 image.
+  bool process_image_fused(const std::vector<torch::Tensor>& images,
+                           std::vector<torch::Tensor>& pixel_values,
+                           std::vector<torch::Tensor>& thw) const;
+
   bool do_convert_rgb_ = true;
   bool do_normalize_ = true;
   bool do_rescale_ = true;
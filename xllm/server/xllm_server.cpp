@@ -54,6 +54,7 @@ constexpr const char* kApiServiceRoutes =
     "wakeup => WakeupHttp,"
     "start_profile => StartProfileHttp,"
     "stop_profile => StopProfileHttp,"
+    "flight_recorder => FlightRecorderHttp,"
     "pause => PauseHttp,"
     "resume => ResumeHttp,"
     "link_p2p => LinkP2PHttp,"
@@ -24,6 +24,7 @@ namespace py = pybind11;
 #include <acl/acl.h>
 #endif
 
+#include <algorithm>
 #include <csignal>
 #include <filesystem>
 #include <memory>
@@ -57,10 +58,12 @@ namespace py = pybind11;
 #include "core/framework/config/scheduler_config.h"
 #include "core/framework/config/service_config.h"
 #include "core/framework/config/speculative_config.h"
+#include "core/framework/kv_cache_transfer/kv_block_codec.h"
 #include "core/framework/xtensor/global_xtensor.h"
 #include "core/framework/xtensor/options.h"
 #include "core/framework/xtensor/xtensor_allocator.h"
 #include "core/platform/device_name_utils.h"
+#include "core/util/flight_recorder.h"
 #include "core/util/net.h"
 #include "core/util/utils.h"
 #include "core/util/verbose_trace_logger.h"
@@ -121,6 +124,20 @@ Options create_options(const std::string& instance_name, bool is_local) {
         << "KV cache Store requires --host_blocks_factor > 1 so Host cache "
            "blocks can serve as transfer destinations.";
   }
+  if (!kv_cache_store_config.kv_cache_disk_path().empty()) {
+    CHECK(kv_cache_config.enable_prefix_cache())
+        << "The KV disk cache requires --enable_prefix_cache=true.";
+    CHECK_GT(kv_cache_store_config.host_blocks_factor(), 1.0)
+        << "The KV disk cache requires --host_blocks_factor > 1 so Host "
+           "cache blocks can stage disk reads and writes.";
+    CHECK_GT(kv_cache_store_config.kv_cache_disk_capacity_gb(), 0u)
+        << "The KV disk cache requires --kv_cache_disk_capacity_gb > 0.";
+  }
+  CHECK(parse_kv_block_codec(kv_cache_store_config.kv_cache_tier_codec())
+            .has_value())
+      << "Unsupported --kv_cache_tier_codec="
+      << kv_cache_store_config.kv_cache_tier_codec()
+      << "; expected none, int8 or lossless.";
 
 #if !defined(USE_NPU)
   CHECK(!speculative_config.enable_mtp_draft_body_tp1())
@@ -168,6 +185,14 @@ Options create_options(const std::string& instance_name, bool is_local) {
           speculative_config.speculative_suffix_max_cached_requests())
       .speculative_suffix_use_tree_spec(
           speculative_config.speculative_suffix_use_tree_spec())
+      .speculative_suffix_num_threads(
+          speculative_config.speculative_suffix_num_threads())
+      .speculative_suffix_corpus_path(
+          speculative_config.speculative_suffix_corpus_path())
+      .speculative_suffix_snapshot_interval_s(
+          speculative_config.speculative_suffix_snapshot_interval_s())
+      .speculative_ngram_min(speculative_config.speculative_ngram_min())
+      .speculative_ngram_max(speculative_config.speculative_ngram_max())
       .enable_mtp_draft_body_tp1(speculative_config.enable_mtp_draft_body_tp1())
       .enable_adaptive_speculative_decode(
           speculative_config.enable_adaptive_speculative_decode())
@@ -213,6 +238,7 @@ Options create_options(const std::string& instance_name, bool is_local) {
       .priority_strategy(scheduler_config.priority_strategy())
       .enable_online_preempt_offline(
           scheduler_config.enable_online_preempt_offline())
+      .enable_swap_preemption(scheduler_config.enable_swap_preemption())
       .host_blocks_factor(kv_cache_store_config.host_blocks_factor())
       .enable_kvcache_store(kv_cache_store_config.enable_kvcache_store())
       .prefetch_timeout(kv_cache_store_config.prefetch_timeout())
@@ -223,6 +249,14 @@ Options create_options(const std::string& instance_name, bool is_local) {
           kv_cache_store_config.store_master_server_address())
       .store_metadata_server(kv_cache_store_config.store_metadata_server())
       .store_local_hostname(kv_cache_store_config.store_local_hostname())
+      .store_local_capacity_gb(kv_cache_store_config.store_local_capacity_gb())
+      .store_local_bandwidth_gbps(
+          kv_cache_store_config.store_local_bandwidth_gbps())
+      .store_local_latency_us(kv_cache_store_config.store_local_latency_us())
+      .kv_cache_disk_path(kv_cache_store_config.kv_cache_disk_path())
+      .kv_cache_disk_capacity_gb(
+          kv_cache_store_config.kv_cache_disk_capacity_gb())
+      .kv_cache_tier_codec(kv_cache_store_config.kv_cache_tier_codec())
       .enable_multi_stream_parallel(
           parallel_config.enable_multi_stream_parallel())
       .enable_profile_step_time(profile_config.enable_profile_step_time())
@@ -610,6 +644,11 @@ int main(int argc, char** argv) {
       verbose_trace_log_path,
       service_config.verbose_trace_log_max_size_mb(),
       service_config.verbose_trace_log_max_files());
+  const ProfileConfig& profile_config = ProfileConfig::get_instance();
+  FlightRecorder::get_instance().initialize(
+      profile_config.enable_flight_recorder(),
+      static_cast<size_t>(
+          std::max<int32_t>(profile_config.flight_recorder_capacity(), 0)));
 
   // Check if model path is provided
   if (::xllm::ModelConfig::get_instance().model().empty()) {